@@ -527,6 +527,12 @@ static struct slm_at_cmd {
 #endif
 };
 
+/* Indexes of slm_at_cmd_list sorted by command string, for the binary search of commands.
+ * The list itself keeps the grouping by feature, which is also the order of AT#XCLAC.
+ */
+static uint8_t slm_at_cmd_index[ARRAY_SIZE(slm_at_cmd_list)];
+BUILD_ASSERT(ARRAY_SIZE(slm_at_cmd_list) <= UINT8_MAX + 1, "Too many SLM AT commands");
+
 /* Handles AT#XCLAC command. */
 int handle_at_clac(enum at_cmd_type cmd_type)
 {
@@ -544,41 +550,83 @@ int handle_at_clac(enum at_cmd_type cmd_type)
 	return ret;
 }
 
-int slm_at_parse(const char *cmd_str, size_t cmd_name_len)
+/* Compares a command name, which is not null-terminated, to a command string of the list. */
+static int cmd_name_cmp(const char *cmd_name, size_t cmd_name_len, const char *string)
 {
-	int ret = UNKNOWN_AT_COMMAND_RET;
-	int total = ARRAY_SIZE(slm_at_cmd_list);
+	int ret = strncmp(cmd_name, string, cmd_name_len);
 
-	for (int i = 0; i < total; i++) {
-		const struct slm_at_cmd *const at_cmd = &slm_at_cmd_list[i];
+	/* The name is a prefix of the string, so it sorts first. */
+	if (ret == 0 && string[cmd_name_len] != '\0') {
+		ret = -1;
+	}
 
-		/* For the match to happen the AT command names must be identical,
-		 * which requires both names to have the same characters and the same length.
-		 */
-		if (!(!strncmp(cmd_str, at_cmd->string, cmd_name_len)
-		      && at_cmd->string[cmd_name_len] == '\0')) {
-			continue;
-		}
+	return ret;
+}
 
-		const enum at_cmd_type type = at_parser_cmd_type_get(cmd_str);
+/* Sorts the command index by command string. The list is small and sorted only once. */
+static void cmd_index_sort(void)
+{
+	for (size_t i = 0; i < ARRAY_SIZE(slm_at_cmd_index); i++) {
+		const uint8_t index = i;
+		size_t j = i;
+
+		while (j > 0 && strcmp(slm_at_cmd_list[slm_at_cmd_index[j - 1]].string,
+				       slm_at_cmd_list[index].string) > 0) {
+			slm_at_cmd_index[j] = slm_at_cmd_index[j - 1];
+			j--;
+		}
+		slm_at_cmd_index[j] = index;
+	}
+}
 
-		at_params_list_clear(&slm_at_param_list);
-		ret = at_parser_params_from_str(cmd_str, NULL, &slm_at_param_list);
-		if (ret) {
-			LOG_ERR("Failed to parse AT command %d", ret);
-			return -EINVAL;
+static const struct slm_at_cmd *cmd_find(const char *cmd_name, size_t cmd_name_len)
+{
+	size_t low = 0;
+	size_t high = ARRAY_SIZE(slm_at_cmd_index);
+
+	while (low < high) {
+		const size_t mid = low + (high - low) / 2;
+		const struct slm_at_cmd *const at_cmd = &slm_at_cmd_list[slm_at_cmd_index[mid]];
+		const int cmp = cmd_name_cmp(cmd_name, cmd_name_len, at_cmd->string);
+
+		if (cmp == 0) {
+			return at_cmd;
+		} else if (cmp < 0) {
+			high = mid;
+		} else {
+			low = mid + 1;
 		}
-		ret = at_cmd->handler(type);
-		break;
 	}
 
-	return ret;
+	return NULL;
+}
+
+int slm_at_parse(const char *cmd_str, size_t cmd_name_len)
+{
+	int ret;
+	const struct slm_at_cmd *const at_cmd = cmd_find(cmd_str, cmd_name_len);
+
+	if (!at_cmd) {
+		return UNKNOWN_AT_COMMAND_RET;
+	}
+
+	const enum at_cmd_type type = at_parser_cmd_type_get(cmd_str);
+
+	at_params_list_clear(&slm_at_param_list);
+	ret = at_parser_params_from_str(cmd_str, NULL, &slm_at_param_list);
+	if (ret) {
+		LOG_ERR("Failed to parse AT command %d", ret);
+		return -EINVAL;
+	}
+
+	return at_cmd->handler(type);
 }
 
 int slm_at_init(void)
 {
 	int err;
 
+	cmd_index_sort();
 	k_work_init_delayable(&slm_work.sleep_work, go_sleep_wk);
 
 	err = slm_at_tcp_proxy_init();
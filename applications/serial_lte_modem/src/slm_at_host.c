@@ -287,20 +287,27 @@ static size_t raw_rx_handler(const uint8_t *buf, const size_t len)
  * <separator>: +, %, #
  * <body>: alphanumeric char only, size > 0
  * <parameters>: arbitrary, size > 0
+ *
+ * The command name, AT<separator><body>, is converted to upper case in the same pass.
+ * Returns the length of the command name, or -EINVAL if the grammar is invalid.
  */
-static int cmd_grammar_check(const char *cmd, size_t length)
+static int cmd_grammar_check(char *cmd, size_t length)
 {
+	const char *const start = cmd;
 	const char *body;
+	int name_len;
 
 	/* check AT (if not, no check) */
 	if (length < 2 || toupper((int)cmd[0]) != 'A' || toupper((int)cmd[1]) != 'T') {
 		return -EINVAL;
 	}
+	cmd[0] = 'A';
+	cmd[1] = 'T';
 
 	/* check AT<NULL> */
 	cmd += 2;
 	if (*cmd == '\0') {
-		return 0;
+		return cmd - start;
 	}
 
 	/* check AT<separator> */
@@ -316,6 +323,7 @@ static int cmd_grammar_check(const char *cmd, size_t length)
 		if (!isalpha((int)*cmd) && !isdigit((int)*cmd)) {
 			break;
 		}
+		*cmd = toupper((int)*cmd);
 		cmd++;
 	}
 
@@ -323,10 +331,11 @@ static int cmd_grammar_check(const char *cmd, size_t length)
 	if (cmd == body) {
 		return -EINVAL;
 	}
+	name_len = cmd - start;
 
 	/* check AT<separator><body><NULL> */
 	if (*cmd == '\0') {
-		return 0;
+		return name_len;
 	}
 
 	/* check AT<separator><body>= or check AT<separator><body>? */
@@ -338,7 +347,7 @@ static int cmd_grammar_check(const char *cmd, size_t length)
 	if (*cmd == '?') {
 		cmd += 1;
 		if (*cmd == '\0') {
-			return 0;
+			return name_len;
 		} else {
 			return -EINVAL;
 		}
@@ -347,21 +356,21 @@ static int cmd_grammar_check(const char *cmd, size_t length)
 	/* check AT<separator><body>=<NULL> */
 	cmd += 1;
 	if (*cmd == '\0') {
-		return 0;
+		return name_len;
 	}
 
 	/* check AT<separator><body>=?<NULL> */
 	if (*cmd == '?') {
 		cmd += 1;
 		if (*cmd == '\0') {
-			return 0;
+			return name_len;
 		} else {
 			return -EINVAL;
 		}
 	}
 
 	/* no need to check AT<separator><body>=<parameters><NULL> */
-	return 0;
+	return name_len;
 }
 
 static char *strrstr(const char *str1, const char *str2)
@@ -430,18 +439,6 @@ static void format_final_result(char *buf, size_t buf_len, size_t buf_max_len)
 	}
 }
 
-static size_t cmd_name_toupper(char *cmd, size_t cmd_len)
-{
-	size_t i;
-
-	/* Set/test command names are delimited by '=', read by '?'. */
-	for (i = 0; i != cmd_len && cmd[i] != '=' && cmd[i] != '?'; ++i) {
-
-		cmd[i] = toupper(cmd[i]);
-	}
-	return i;
-}
-
 static void restore_at_backend(void)
 {
 	const int err = at_backend.start();
@@ -545,14 +542,14 @@ static void cmd_send(uint8_t *buf, size_t cmd_length, size_t buf_size)
 		offset++;
 	}
 
-	if (cmd_grammar_check(at_cmd, cmd_length) != 0) {
+	const int cmd_name_len = cmd_grammar_check(at_cmd, cmd_length);
+
+	if (cmd_name_len < 0) {
 		LOG_ERR("AT command syntax invalid: %s", at_cmd);
 		rsp_send_error();
 		return;
 	}
 
-	const size_t cmd_name_len = cmd_name_toupper(at_cmd, cmd_length);
-
 	err = slm_at_parse(at_cmd, cmd_name_len);
 	if (err == 0) {
 		rsp_send_ok();
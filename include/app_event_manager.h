@@ -175,7 +175,29 @@ static inline bool app_event_get_type_flag(const struct event_type *et,
  *                         You should use APP_EVENT_FLAGS_CREATE to define them.
  */
 #define APP_EVENT_TYPE_DEFINE(ename, log_fn, ev_info_struct, app_event_type_flags) \
-	_APP_EVENT_TYPE_DEFINE(ename, log_fn, ev_info_struct, app_event_type_flags)
+	_APP_EVENT_TYPE_DEFINE(ename, log_fn, ev_info_struct, app_event_type_flags, 0)
+
+
+/** @brief Define an event type processed in the given lane.
+ *
+ * This macro works like @ref APP_EVENT_TYPE_DEFINE, but the events of the
+ * defined type are processed in the given lane instead of lane 0.
+ * Every lane has its own event queue. Lane 0 is processed by the system
+ * workqueue and every other lane by its own workqueue, with the priority
+ * growing with the lane number.
+ * Events submitted to different lanes are not processed in the order of
+ * submission.
+ *
+ * @param ename     	   Name of the event.
+ * @param log_fn  	   Function to stringify an event of this type.
+ * @param ev_info_struct   Data structure describing the event type.
+ * @param app_event_type_flags Event type flags.
+ *                         You should use APP_EVENT_FLAGS_CREATE to define them.
+ * @param lane             Lane number, lower than
+ *                         @kconfig{CONFIG_APP_EVENT_MANAGER_LANES}.
+ */
+#define APP_EVENT_TYPE_DEFINE_LANE(ename, log_fn, ev_info_struct, app_event_type_flags, lane) \
+	_APP_EVENT_TYPE_DEFINE(ename, log_fn, ev_info_struct, app_event_type_flags, lane)
 
 
 /** @brief Verify if an event ID is valid.
@@ -384,6 +406,8 @@ int app_event_manager_init(void);
  *
  * The behavior of this function depends on the actual implementation.
  * The default implementation of this function is same as k_malloc.
+ * If @kconfig{CONFIG_APP_EVENT_MANAGER_EVENT_SLABS} is enabled, the default
+ * implementation first tries @ref app_event_manager_slab_alloc.
  * It is annotated as weak and can be overridden by user.
  *
  * @param size  Amount of memory requested (in bytes).
@@ -396,6 +420,8 @@ void *app_event_manager_alloc(size_t size);
  *
  * The behavior of this function depends on the actual implementation.
  * The default implementation of this function is same as k_free.
+ * If @kconfig{CONFIG_APP_EVENT_MANAGER_EVENT_SLABS} is enabled, the default
+ * implementation first tries @ref app_event_manager_slab_free.
  * It is annotated as weak and can be overridden by user.
  *
  * @param addr  Pointer to previously allocated memory.
@@ -403,6 +429,38 @@ void *app_event_manager_alloc(size_t size);
 void app_event_manager_free(void *addr);
 
 
+/** @brief Allocate event from the event memory slabs.
+ *
+ * The function takes a block from the slab with the smallest blocks that still
+ * fit the requested size and have a free block. The slabs of all event types
+ * are checked, so the time taken grows with the number of event types. It
+ * never waits and can be used from any context. A custom
+ * @ref app_event_manager_alloc implementation can use it and decide on its own
+ * what to do when no block is available.
+ *
+ * @note
+ * For this function to be available the
+ * @kconfig{CONFIG_APP_EVENT_MANAGER_EVENT_SLABS} option needs to be enabled.
+ *
+ * @param size  Amount of memory requested (in bytes).
+ * @retval Address of the allocated block if successful, otherwise NULL.
+ **/
+void *app_event_manager_slab_alloc(size_t size);
+
+
+/** @brief Free event if it was allocated from the event memory slabs.
+ *
+ * @note
+ * For this function to be available the
+ * @kconfig{CONFIG_APP_EVENT_MANAGER_EVENT_SLABS} option needs to be enabled.
+ *
+ * @param addr  Pointer to previously allocated memory.
+ * @retval true If the memory belonged to one of the event slabs and was freed.
+ * @retval false If the memory was not allocated from the event slabs.
+ **/
+bool app_event_manager_slab_free(void *addr);
+
+
 /** @brief Log event.
  *
  * This helper macro simplifies event logging.
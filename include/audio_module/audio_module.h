@@ -189,7 +189,8 @@ struct audio_module_functions {
 	 * @param audio_data_tx  [out]     Pointer to the output audio data or NULL for an output
 	 *                                 module.
 	 *
-	 * @return 0 if successful, error otherwise.
+	 * @return 0 if successful, -ENODATA if an input module in a graph has no audio
+	 *         data for this frame, error otherwise.
 	 */
 	int (*data_process)(struct audio_module_handle_private *handle,
 			    struct audio_data const *const audio_data_rx,
@@ -238,6 +239,8 @@ struct audio_module_thread_configuration {
 	size_t data_size;
 };
 
+struct audio_module_graph;
+
 /**
  * @brief Module's generic set-up structure.
  */
@@ -247,6 +250,13 @@ struct audio_module_parameters {
 
 	/* The module's thread setting. */
 	struct audio_module_thread_configuration thread;
+
+#if defined(CONFIG_AUDIO_MODULE_GRAPH)
+	/* The graph to run the module in, or NULL for the module to run in its own thread.
+	 * When set, the stack, priority and data slab in the thread setting are not used.
+	 */
+	struct audio_module_graph *graph;
+#endif /* CONFIG_AUDIO_MODULE_GRAPH */
 };
 
 /**
@@ -291,6 +301,11 @@ struct audio_module_handle {
 
 	/* Private context for the module. */
 	struct audio_module_context *context;
+
+#if defined(CONFIG_AUDIO_MODULE_GRAPH)
+	/* The graph the module runs in, NULL if the module has its own thread. */
+	struct audio_module_graph *graph;
+#endif /* CONFIG_AUDIO_MODULE_GRAPH */
 };
 
 /**
@@ -307,6 +322,89 @@ struct audio_module_message {
 	audio_module_response_cb response_cb;
 };
 
+#if defined(CONFIG_AUDIO_MODULE_GRAPH)
+/**
+ * @brief Size reserved at the start of each block in a graph's data slab.
+ */
+#define AUDIO_MODULE_GRAPH_BLOCK_HEADER_SIZE (8)
+
+/**
+ * @brief Block size for a graph's data slab that holds audio data of up to data_size bytes.
+ */
+#define AUDIO_MODULE_GRAPH_BLOCK_SIZE(data_size)                                                   \
+	ROUND_UP((data_size) + AUDIO_MODULE_GRAPH_BLOCK_HEADER_SIZE, 8)
+
+/**
+ * @brief Graph set-up structure.
+ */
+struct audio_module_graph_parameters {
+	/* Scheduler thread stack. */
+	k_thread_stack_t *stack;
+
+	/* Scheduler thread stack size. */
+	size_t stack_size;
+
+	/* Scheduler thread priority. */
+	int priority;
+
+	/* A pointer to the audio data buffer slab shared by all modules in the graph. The block
+	 * size must be at least AUDIO_MODULE_GRAPH_BLOCK_SIZE() of the largest module data size.
+	 */
+	struct k_mem_slab *data_slab;
+};
+
+/**
+ * @brief Private structure describing a module's place in a started graph.
+ */
+struct audio_module_graph_node {
+	/* The module's handle. */
+	struct audio_module_handle *handle;
+
+	/* Position of the upstream module in the graph order, -1 for a source module. */
+	int8_t upstream;
+
+	/* The module's output audio data for the current frame. */
+	struct audio_data output;
+
+	/* Flag to indicate that output holds a block from the data slab. */
+	bool output_valid;
+};
+
+/**
+ * @brief Private graph structure.
+ *
+ * @note A graph runs all of its modules from one scheduler thread. Each frame, every source
+ *       module (a module with no upstream module in the graph) is run, followed by the other
+ *       modules in topological order. The audio data is passed by reference between the
+ *       modules and is taken from the graph's shared data slab.
+ */
+struct audio_module_graph {
+	/* The graph's set-up. */
+	struct audio_module_graph_parameters parameters;
+
+	/* Modules opened in the graph. */
+	struct audio_module_handle *modules[CONFIG_AUDIO_MODULE_GRAPH_MODULES_MAX];
+
+	/* Number of modules opened in the graph. */
+	uint8_t module_count;
+
+	/* The modules in topological order, valid while the graph is running. */
+	struct audio_module_graph_node nodes[CONFIG_AUDIO_MODULE_GRAPH_MODULES_MAX];
+
+	/* Flag to indicate that the scheduler thread is running. */
+	bool running;
+
+	/* Semaphore to wake the scheduler thread when it has no running source module. */
+	struct k_sem wake_sem;
+
+	/* Thread ID. */
+	k_tid_t thread_id;
+
+	/* Thread data. */
+	struct k_thread thread_data;
+};
+#endif /* CONFIG_AUDIO_MODULE_GRAPH */
+
 /**
  * @brief Open an audio module.
  *
@@ -491,6 +589,44 @@ int audio_module_state_get(struct audio_module_handle const *const handle,
  */
 int audio_module_number_channels_calculate(uint32_t locations, int8_t *number_channels);
 
+#if defined(CONFIG_AUDIO_MODULE_GRAPH)
+/**
+ * @brief Initialize an audio module graph.
+ *
+ * @note Modules are added to the graph by setting the graph in their parameters when calling
+ *       audio_module_open().
+ *
+ * @param graph       [out]  Pointer to the graph.
+ * @param parameters  [in]   Pointer to the graph set-up parameters.
+ *
+ * @return 0 if successful, error otherwise.
+ */
+int audio_module_graph_init(struct audio_module_graph *graph,
+			    struct audio_module_graph_parameters const *const parameters);
+
+/**
+ * @brief Start the scheduler thread of an audio module graph.
+ *
+ * @note The connections between the modules are read when the graph starts, so modules cannot
+ *       be opened, closed, connected or disconnected in a running graph. The modules are
+ *       started and stopped individually with audio_module_start() and audio_module_stop().
+ *
+ * @param graph  [in/out]  Pointer to the graph.
+ *
+ * @return 0 if successful, error otherwise.
+ */
+int audio_module_graph_start(struct audio_module_graph *graph);
+
+/**
+ * @brief Stop the scheduler thread of an audio module graph.
+ *
+ * @param graph  [in/out]  Pointer to the graph.
+ *
+ * @return 0 if successful, error otherwise.
+ */
+int audio_module_graph_stop(struct audio_module_graph *graph);
+#endif /* CONFIG_AUDIO_MODULE_GRAPH */
+
 #ifdef __cplusplus
 }
 #endif
@@ -283,6 +283,10 @@ const struct bt_gatt_dm_attr *bt_gatt_dm_desc_next(
  * service instances may be discovered.
  * Call @ref bt_gatt_dm_continue to discover the next service instance.
  *
+ * If @kconfig{CONFIG_BT_GATT_DM_CACHE} is enabled and the peer is bonded,
+ * the attributes stored on a previous discovery are used if the GATT
+ * Database Hash of the peer did not change.
+ *
  * @retval 0 If the operation was successful.
  *           Otherwise, a (negative) error code is returned.
  */
@@ -31,6 +31,26 @@ struct data_fifo_msgq {
 	size_t size;
 };
 
+#if defined(CONFIG_DATA_FIFO_SPSC)
+/* Single-producer/single-consumer ring state. All indices run modulo
+ * 2 * elements_max so that a full ring can be told apart from an empty one.
+ * Each index is written by one side only:
+ *  alloc_idx, lock_idx: producer.
+ *  get_idx, free_idx: consumer.
+ */
+struct data_fifo_spsc {
+	size_t *sizes;
+	atomic_t alloc_idx;
+	atomic_t lock_idx;
+	atomic_t get_idx;
+	atomic_t free_idx;
+	atomic_t vacant_waiting;
+	atomic_t filled_waiting;
+	struct k_sem vacant_sem;
+	struct k_sem filled_sem;
+};
+#endif /* CONFIG_DATA_FIFO_SPSC */
+
 struct data_fifo {
 	char *msgq_buffer;
 	char *slab_buffer;
@@ -39,6 +59,10 @@ struct data_fifo {
 	uint32_t elements_max;
 	size_t block_size_max;
 	bool initialized;
+#if defined(CONFIG_DATA_FIFO_SPSC)
+	bool spsc;
+	struct data_fifo_spsc ring;
+#endif /* CONFIG_DATA_FIFO_SPSC */
 };
 
 #define DATA_FIFO_DEFINE(name, elements_max_in, block_size_max_in)                                 \
@@ -52,6 +76,34 @@ struct data_fifo {
 				  .elements_max = elements_max_in,                                 \
 				  .initialized = false }
 
+#if defined(CONFIG_DATA_FIFO_SPSC)
+/**
+ * @brief Define a single-producer/single-consumer data_fifo.
+ *
+ * Same API as a FIFO created with DATA_FIFO_DEFINE, but blocks are handed
+ * between the producer and the consumer in place through atomic ring
+ * indices. No kernel lock is taken and no descriptor is copied unless one of
+ * the sides has to wait for the other.
+ *
+ * Restrictions compared to DATA_FIFO_DEFINE:
+ *  - Only one context may allocate/lock blocks and only one context may
+ *    get/free blocks.
+ *  - Blocks must be locked in the order they were allocated, and freed in
+ *    the order they were retrieved. The producer may free its most recently
+ *    allocated block if it has not been locked yet.
+ */
+#define DATA_FIFO_SPSC_DEFINE(name, elements_max_in, block_size_max_in)                            \
+	size_t _sizes_##name[(elements_max_in)] = { 0 };                                           \
+	char __aligned(WB_UP(1))                                                                   \
+		_slab_buffer_##name[(elements_max_in) * (block_size_max_in)] = { 0 };              \
+	struct data_fifo name = { .slab_buffer = _slab_buffer_##name,                              \
+				  .block_size_max = block_size_max_in,                             \
+				  .elements_max = elements_max_in,                                 \
+				  .initialized = false,                                            \
+				  .spsc = true,                                                    \
+				  .ring = { .sizes = _sizes_##name } }
+#endif /* CONFIG_DATA_FIFO_SPSC */
+
 /**
  * @brief Get pointer to the first vacant block in slab.
  *
@@ -68,6 +120,8 @@ struct data_fifo {
  *	or K_FOREVER to wait as long as necessary.
  *
  * @retval 0		Memory allocated.
+ * @retval -ENOMEM	No vacant block (SPSC FIFO, K_NO_WAIT).
+ * @retval -EAGAIN	Timed out waiting for a vacant block (SPSC FIFO).
  * @retval value	Return values from k_mem_slab_alloc.
  */
 int data_fifo_pointer_first_vacant_get(struct data_fifo *data_fifo, void **data,
@@ -91,7 +145,8 @@ int data_fifo_pointer_first_vacant_get(struct data_fifo *data_fifo, void **data,
  * @retval -EINVAL	The supplied size is zero.
  * @retval -ESPIPE	A generic return value if an error occurs in k_msg_put.
  *			Since data has already been added to the slab, there
- *			must be space in the message queue.
+ *			must be space in the message queue. For an SPSC FIFO,
+ *			the block is not the oldest unlocked allocation.
  */
 int data_fifo_block_lock(struct data_fifo *data_fifo, void **data, size_t size);
 
@@ -111,6 +166,8 @@ int data_fifo_block_lock(struct data_fifo *data_fifo, void **data, size_t size);
  *	or K_FOREVER to wait as long as necessary.
  *
  * @retval 0		Memory pointer retrieved.
+ * @retval -ENOMSG	No filled block (SPSC FIFO, K_NO_WAIT).
+ * @retval -EAGAIN	Timed out waiting for a filled block (SPSC FIFO).
  * @retval value	Return values from k_msgq_get.
  */
 int data_fifo_pointer_last_filled_get(struct data_fifo *data_fifo, void **data, size_t *size,
@@ -0,0 +1,225 @@
+/*
+ * Copyright (c) 2024 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#ifndef __PERF_COUNTER_H
+#define __PERF_COUNTER_H
+
+#include <zephyr/kernel.h>
+#include <zephyr/sys/atomic.h>
+#include <zephyr/sys/iterable_sections.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @defgroup perf_counter Performance counters
+ * @brief Registry of named counters, histograms and gauges.
+ *
+ * Counters are placed in an iterable section, so that they can be defined in
+ * any module and listed from one place. Recording a value only uses atomic
+ * operations, which makes it safe from any context, including interrupts.
+ *
+ * If @kconfig{CONFIG_PERF_COUNTER} is disabled, the recording macros compile
+ * out and the modules can be instrumented unconditionally.
+ *
+ * @{
+ */
+
+/** @brief Type of a performance counter. */
+enum perf_counter_type {
+	/** Number of events and sum of their values, for example received bytes. */
+	PERF_COUNTER_TYPE_COUNTER,
+	/** Distribution of values in power of two buckets, for example latencies. */
+	PERF_COUNTER_TYPE_HISTOGRAM,
+	/** Value read on demand from the module that owns it. */
+	PERF_COUNTER_TYPE_GAUGE,
+};
+
+/** @brief Performance counter.
+ *
+ * Use @ref PERF_COUNTER_DEFINE, @ref PERF_HISTOGRAM_DEFINE or
+ * @ref PERF_GAUGE_DEFINE to define it.
+ */
+struct perf_counter {
+	/** Name of the counter. */
+	const char *name;
+	/** Unit of the recorded values. */
+	const char *unit;
+	/** Type of the counter. */
+	enum perf_counter_type type;
+	/** Number of recorded values. */
+	atomic_t count;
+	/** Sum of the recorded values. Wraps around on overflow. */
+	atomic_t sum;
+	/** Largest recorded value. */
+	atomic_t max;
+	/** Histogram buckets, or NULL. */
+	atomic_t *buckets;
+	/** Function that returns the value of a gauge, or NULL. */
+	uint32_t (*get)(void);
+	/** Uptime of the last reset in milliseconds. */
+	uint32_t reset_time;
+#if defined(CONFIG_PERF_COUNTER_NRF_PROFILER)
+	/** Identifier of the nrf_profiler event type. */
+	uint16_t profiler_id;
+#endif
+};
+
+#if defined(CONFIG_PERF_COUNTER)
+
+/** @cond INTERNAL_HIDDEN */
+#define _PERF_COUNTER_DEFINE(_name, _unit, _type, _buckets, _get)		\
+	STRUCT_SECTION_ITERABLE(perf_counter, _name) = {			\
+		.name = #_name,							\
+		.unit = _unit,							\
+		.type = _type,							\
+		.buckets = _buckets,						\
+		.get = _get,							\
+	}
+/** @endcond */
+
+/** @brief Define a counter.
+ *
+ * @param _name Name of the counter. It is used as the variable name.
+ * @param _unit Unit of the counted values as a string.
+ */
+#define PERF_COUNTER_DEFINE(_name, _unit) \
+	_PERF_COUNTER_DEFINE(_name, _unit, PERF_COUNTER_TYPE_COUNTER, NULL, NULL)
+
+/** @brief Define a histogram.
+ *
+ * The histogram has @kconfig{CONFIG_PERF_COUNTER_HISTOGRAM_BUCKETS} buckets.
+ * Bucket 0 holds the value 0 and bucket n holds the values from 2^(n-1) to
+ * 2^n - 1. The last bucket also holds all larger values.
+ *
+ * @param _name Name of the histogram. It is used as the variable name.
+ * @param _unit Unit of the recorded values as a string.
+ */
+#define PERF_HISTOGRAM_DEFINE(_name, _unit)						\
+	static atomic_t _CONCAT(_name, _buckets)[CONFIG_PERF_COUNTER_HISTOGRAM_BUCKETS]; \
+	_PERF_COUNTER_DEFINE(_name, _unit, PERF_COUNTER_TYPE_HISTOGRAM,		\
+			     _CONCAT(_name, _buckets), NULL)
+
+/** @brief Define a gauge.
+ *
+ * @param _name Name of the gauge. It is used as the variable name.
+ * @param _unit Unit of the value as a string.
+ * @param _get Function that returns the value. It is called from the thread
+ *             that reads the counters.
+ */
+#define PERF_GAUGE_DEFINE(_name, _unit, _get) \
+	_PERF_COUNTER_DEFINE(_name, _unit, PERF_COUNTER_TYPE_GAUGE, NULL, _get)
+
+/** @brief Add a value to a counter.
+ *
+ * @param _name Name of the counter.
+ * @param _val Value to add.
+ */
+#define PERF_COUNTER_ADD(_name, _val) perf_counter_add(&_name, (_val))
+
+/** @brief Increment a counter by one. */
+#define PERF_COUNTER_INC(_name) PERF_COUNTER_ADD(_name, 1)
+
+/** @brief Record a value in a histogram.
+ *
+ * @param _name Name of the histogram.
+ * @param _val Value to record.
+ */
+#define PERF_HISTOGRAM_RECORD(_name, _val) perf_histogram_record(&_name, (_val))
+
+/** @brief Get a timestamp for @ref PERF_HISTOGRAM_RECORD_SINCE.
+ *
+ * Evaluates to 0 if @kconfig{CONFIG_PERF_COUNTER} is disabled.
+ */
+#define PERF_TIMESTAMP() k_cycle_get_32()
+
+/** @brief Record the time elapsed since a timestamp in microseconds.
+ *
+ * @param _name Name of the histogram.
+ * @param _start Timestamp returned by @ref PERF_TIMESTAMP.
+ */
+#define PERF_HISTOGRAM_RECORD_SINCE(_name, _start) \
+	PERF_HISTOGRAM_RECORD(_name, k_cyc_to_us_floor32(k_cycle_get_32() - (_start)))
+
+#else
+
+#define PERF_COUNTER_DEFINE(_name, _unit) extern struct perf_counter _name
+#define PERF_HISTOGRAM_DEFINE(_name, _unit) extern struct perf_counter _name
+#define PERF_GAUGE_DEFINE(_name, _unit, _get) extern struct perf_counter _name
+#define PERF_COUNTER_ADD(_name, _val) ARG_UNUSED(_val)
+#define PERF_COUNTER_INC(_name)
+#define PERF_HISTOGRAM_RECORD(_name, _val) ARG_UNUSED(_val)
+#define PERF_TIMESTAMP() 0
+#define PERF_HISTOGRAM_RECORD_SINCE(_name, _start) ARG_UNUSED(_start)
+
+#endif /* CONFIG_PERF_COUNTER */
+
+/** @brief Add a value to a counter.
+ *
+ * @param counter Counter.
+ * @param val Value to add.
+ */
+static inline void perf_counter_add(struct perf_counter *counter, uint32_t val)
+{
+	atomic_inc(&counter->count);
+	atomic_add(&counter->sum, (atomic_val_t)val);
+}
+
+/** @brief Record a value in a histogram.
+ *
+ * @param hist Histogram.
+ * @param val Value to record.
+ */
+void perf_histogram_record(struct perf_counter *hist, uint32_t val);
+
+/** @brief Get the value of a counter.
+ *
+ * @param counter Counter.
+ *
+ * @return Sum of the values of a counter, the average value of a histogram or
+ *         the current value of a gauge.
+ */
+uint32_t perf_counter_value_get(struct perf_counter *counter);
+
+/** @brief Get a percentile of a histogram.
+ *
+ * The result is the upper bound of the bucket that holds the percentile, but
+ * never more than the largest recorded value.
+ *
+ * @param hist Histogram.
+ * @param percent Percentile, from 0 to 100.
+ *
+ * @return Value of the percentile, or 0 if no value is recorded.
+ */
+uint32_t perf_histogram_percentile_get(struct perf_counter *hist, uint8_t percent);
+
+/** @brief Find a counter by its name.
+ *
+ * @param name Name of the counter.
+ *
+ * @return Counter, or NULL if not found.
+ */
+struct perf_counter *perf_counter_find(const char *name);
+
+/** @brief Reset a counter.
+ *
+ * A value recorded at the same time may be partially lost.
+ *
+ * @param counter Counter.
+ */
+void perf_counter_reset(struct perf_counter *counter);
+
+/** @brief Reset all counters. */
+void perf_counter_reset_all(void);
+
+/** @} */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __PERF_COUNTER_H */
@@ -148,6 +148,24 @@ struct dm_request {
 	uint32_t extra_window_time_us;
 };
 
+/** @brief Ranging statistics. */
+struct dm_stats {
+	/** Time over which the statistics were collected, in milliseconds. */
+	uint32_t period_ms;
+	/** Number of successful rangings. */
+	uint32_t ranging_cnt;
+	/** Number of failed rangings. */
+	uint32_t ranging_fail_cnt;
+	/** Number of rangings dropped, because no timeslot was available at their start time. */
+	uint32_t missed_cnt;
+	/** Number of timeslots used for ranging. */
+	uint32_t timeslot_cnt;
+	/** Successful rangings per second. */
+	float ranging_rate;
+	/** Share of the timeslot time used by the ranging windows, in percent. */
+	uint8_t timeslot_utilization;
+};
+
 /** @brief Initialize the DM.
  *
  *  Initialize the DM by specifying a list of supported operations.
@@ -170,6 +188,22 @@ int dm_init(struct dm_init_param *init_param);
  */
 int dm_request_add(struct dm_request *req);
 
+/** @brief Get the ranging statistics.
+ *
+ *  The statistics are collected since the initialization of the DM, or since
+ *  they were last reset.
+ *
+ *  @note The statistics are only available where the ranging is executed. With
+ *        @kconfig{CONFIG_DM_MODULE_RPC_CLIENT}, this function is not supported.
+ *
+ *  @param[out] stats Ranging statistics.
+ *  @param[in] reset Restart the collection of the statistics.
+ *
+ *  @retval 0 if the operation was successful.
+ *          Otherwise, a (negative) error code is returned.
+ */
+int dm_stats_get(struct dm_stats *stats, bool reset);
+
 #ifdef __cplusplus
 }
 #endif
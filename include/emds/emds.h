@@ -23,6 +23,19 @@
 extern "C" {
 #endif
 
+/**
+ * @struct emds_entry_state
+ *
+ * Internal state of an entry, used to detect changes to the entry data when
+ * @kconfig{CONFIG_EMDS_INCREMENTAL_STORE} is enabled.
+ */
+struct emds_entry_state {
+	/** Hash of the data stored in flash. */
+	uint32_t hash;
+	/** The data is stored in flash, and is still valid. */
+	bool stored;
+};
+
 /**
  * @struct emds_entry
  *
@@ -35,6 +48,10 @@ struct emds_entry {
 	uint8_t *data;
 	/** Length of data that will be stored. */
 	size_t len;
+#if defined(CONFIG_EMDS_INCREMENTAL_STORE)
+	/** Internal state, set by @ref EMDS_STATIC_ENTRY_DEFINE or @ref emds_entry_add. */
+	struct emds_entry_state *state;
+#endif
 };
 
 /**
@@ -46,6 +63,10 @@ struct emds_entry {
 struct emds_dynamic_entry {
 	struct emds_entry entry;
 	sys_snode_t node;
+#if defined(CONFIG_EMDS_INCREMENTAL_STORE)
+	/** Internal state. */
+	struct emds_entry_state state;
+#endif
 };
 
 /**
@@ -59,12 +80,23 @@ struct emds_dynamic_entry {
  *
  * This creates a variable _name prepended by emds_.
  */
+#if defined(CONFIG_EMDS_INCREMENTAL_STORE)
 #define EMDS_STATIC_ENTRY_DEFINE(_name, _id, _data, _len)                      \
+	static struct emds_entry_state emds_state_##_name;                     \
 	static const STRUCT_SECTION_ITERABLE(emds_entry, emds_##_name) = {     \
 		.id = _id,                                                     \
 		.data = (uint8_t *)_data,                                      \
 		.len = _len,                                                   \
+		.state = &emds_state_##_name,                                  \
 	}
+#else
+#define EMDS_STATIC_ENTRY_DEFINE(_name, _id, _data, _len)                      \
+	static const STRUCT_SECTION_ITERABLE(emds_entry, emds_##_name) = {     \
+		.id = _id,                                                     \
+		.data = (uint8_t *)_data,                                      \
+		.len = _len,                                                   \
+	}
+#endif
 
 /**
  * @typedef emds_store_cb_t
@@ -184,6 +216,20 @@ int emds_prepare(void);
  */
 uint32_t emds_store_time_get(void);
 
+/**
+ * @brief Estimate the time needed to store the data that changed.
+ *
+ * Estimate how much time it takes to store the dynamic and static data that
+ * changed since @ref emds_prepare was called. Unlike @ref emds_store_time_get,
+ * which gives the worst case, this only accounts for the entries that
+ * @ref emds_store would write if it was called now. Without
+ * @kconfig{CONFIG_EMDS_INCREMENTAL_STORE}, all entries are written, and this
+ * gives the same time as @ref emds_store_time_get.
+ *
+ * @return Time needed to store the changed data (in microseconds).
+ */
+uint32_t emds_dirty_store_time_get(void);
+
 /**
  * @brief Calculate the size needed to store the registered data.
  *
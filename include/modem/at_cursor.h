@@ -0,0 +1,185 @@
+/*
+ * Copyright (c) 2024 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#ifndef AT_CURSOR_H__
+#define AT_CURSOR_H__
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <zephyr/types.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @file at_cursor.h
+ *
+ * @defgroup at_cursor AT response cursor
+ * @ingroup at_cmd_parser
+ * @{
+ * @brief Parser that reads AT responses one parameter at a time, in place.
+ *
+ * Unlike @ref at_parser_params_from_str, the cursor does not copy any parameter.
+ * Each call to @ref at_cursor_next returns a token pointing into the parsed string,
+ * and numbers are only decoded when one of the token getters is called.
+ * The parsed string must therefore remain valid for as long as the tokens are used.
+ *
+ * As with @ref at_parser_params_from_str, the first token of a line is the
+ * notification or command prefix, so the parameter indexes are the same with both parsers.
+ */
+
+/** Token types. */
+enum at_cursor_token_type {
+	/** Empty parameter, for example the second parameter in "1,,3". */
+	AT_CURSOR_TOKEN_TYPE_EMPTY,
+	/** Notification, response or command prefix, for example "+CEREG" or "AT%XSYSTEMMODE". */
+	AT_CURSOR_TOKEN_TYPE_PREFIX,
+	/** Parameter starting with a digit or a sign. */
+	AT_CURSOR_TOKEN_TYPE_NUMBER,
+	/** Quoted string without the quotes, or any other unquoted text up to the next separator. */
+	AT_CURSOR_TOKEN_TYPE_STRING,
+	/** Array without the parentheses. */
+	AT_CURSOR_TOKEN_TYPE_ARRAY,
+};
+
+/** Token pointing into the parsed string. */
+struct at_cursor_token {
+	/** First character of the token. The token is not null-terminated. */
+	const char *start;
+	/** Length of the token. */
+	size_t len;
+	/** Token type. */
+	enum at_cursor_token_type type;
+};
+
+/** Cursor state. The members are private. */
+struct at_cursor {
+	const char *ptr;
+	uint8_t state;
+};
+
+/**
+ * @brief Initialize a cursor at the beginning of a string.
+ *
+ * @param[out] cursor Cursor to initialize.
+ * @param[in]  str    Null-terminated AT response, notification or command.
+ *
+ * @retval 0 If the operation was successful.
+ * @retval -EINVAL One or more of the supplied parameters are invalid.
+ */
+int at_cursor_init(struct at_cursor *cursor, const char *str);
+
+/**
+ * @brief Get the next token in the current line.
+ *
+ * @param[in,out] cursor Cursor.
+ * @param[out]    token  Token.
+ *
+ * @retval 0 If the operation was successful.
+ * @retval -ENODATA There are no more tokens in the current line.
+ * @retval -EINVAL One or more of the supplied parameters are invalid.
+ * @retval -EBADMSG A quoted string or an array is not terminated.
+ */
+int at_cursor_next(struct at_cursor *cursor, struct at_cursor_token *token);
+
+/**
+ * @brief Move the cursor to the beginning of the next line.
+ *
+ * Any tokens left in the current line are skipped.
+ * A line with a final result code, such as "OK" or "+CME ERROR: 10", ends the response.
+ *
+ * @param[in,out] cursor Cursor.
+ *
+ * @retval 0 If the operation was successful.
+ * @retval -ENODATA There are no more lines in the response.
+ * @retval -EINVAL One or more of the supplied parameters are invalid.
+ */
+int at_cursor_line_next(struct at_cursor *cursor);
+
+/**
+ * @brief Decode a token as a signed 64-bit integer number.
+ *
+ * @param[in]  token Token.
+ * @param[out] value Decoded value.
+ *
+ * @retval 0 If the operation was successful.
+ * @retval -EINVAL The token is not a decimal number.
+ * @retval -ERANGE The number does not fit in the type.
+ */
+int at_cursor_token_int64_get(const struct at_cursor_token *token, int64_t *value);
+
+/**
+ * @brief Decode a token as an integer number.
+ *
+ * @param[in]  token Token.
+ * @param[out] value Decoded value.
+ *
+ * @retval 0 If the operation was successful.
+ * @retval -EINVAL The token is not a decimal number.
+ * @retval -ERANGE The number does not fit in the type.
+ */
+int at_cursor_token_int_get(const struct at_cursor_token *token, int32_t *value);
+
+/**
+ * @brief Decode a token as an unsigned integer number.
+ *
+ * @param[in]  token Token.
+ * @param[out] value Decoded value.
+ *
+ * @retval 0 If the operation was successful.
+ * @retval -EINVAL The token is not a decimal number.
+ * @retval -ERANGE The number does not fit in the type.
+ */
+int at_cursor_token_unsigned_int_get(const struct at_cursor_token *token, uint32_t *value);
+
+/**
+ * @brief Copy a token into a null-terminated string.
+ *
+ * @param[in]     token Token.
+ * @param[out]    str   Buffer to copy the string into.
+ * @param[in,out] len   Size of @p str, returns the length of the copied string
+ *                      without the null terminator.
+ *
+ * @retval 0 If the operation was successful.
+ * @retval -EINVAL One or more of the supplied parameters are invalid.
+ * @retval -ENOMEM @p str is too small for the token and the null terminator.
+ */
+int at_cursor_token_string_get(const struct at_cursor_token *token, char *str, size_t *len);
+
+/**
+ * @brief Decode the elements of an array token.
+ *
+ * @param[in]     token Token of type @ref AT_CURSOR_TOKEN_TYPE_ARRAY.
+ * @param[out]    array Buffer to decode the elements into.
+ * @param[in,out] len   Number of elements that fit in @p array, returns the number of
+ *                      decoded elements.
+ *
+ * @retval 0 If the operation was successful.
+ * @retval -EINVAL The token is not an array of decimal numbers.
+ * @retval -ERANGE An element does not fit in the type.
+ * @retval -ENOMEM @p array is too small for all elements.
+ */
+int at_cursor_token_array_get(const struct at_cursor_token *token, uint32_t *array,
+			      size_t *len);
+
+/**
+ * @brief Check whether a token is equal to a string.
+ *
+ * @param[in] token Token.
+ * @param[in] str   Null-terminated string.
+ *
+ * @return true if the token is equal to @p str, otherwise false.
+ */
+bool at_cursor_token_equal(const struct at_cursor_token *token, const char *str);
+
+/** @} */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* AT_CURSOR_H__ */
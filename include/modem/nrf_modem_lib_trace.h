@@ -116,6 +116,19 @@ int nrf_modem_lib_trace_clear(void);
 uint32_t nrf_modem_lib_trace_backend_bitrate_get(void);
 #endif /* defined(CONFIG_NRF_MODEM_LIB_TRACE_BACKEND_BITRATE) || defined(__DOXYGEN__) */
 
+#if defined(CONFIG_NRF_MODEM_LIB_TRACE_COMPRESSION) || defined(__DOXYGEN__)
+/** @brief Get the number of trace bytes that went through the compression.
+ *
+ * The ratio between the two counters gives the compression ratio achieved on the traces.
+ * The counters start when the application starts, and only count the trace data that has
+ * been written to the trace backend.
+ *
+ * @param[out] bytes_in  Number of trace bytes received from the modem and compressed.
+ * @param[out] bytes_out Number of bytes written to the trace backend, headers included.
+ */
+void nrf_modem_lib_trace_compression_stats_get(size_t *bytes_in, size_t *bytes_out);
+#endif /* defined(CONFIG_NRF_MODEM_LIB_TRACE_COMPRESSION) || defined(__DOXYGEN__) */
+
 /** @} */
 
 #ifdef __cplusplus
@@ -189,6 +189,16 @@ struct download_client {
 		bool connection_close;
 		/** Is using ranged query. */
 		bool ranged;
+		/** Number of requests whose response is not fully received. */
+		uint8_t requested;
+		/** Offset of the first byte of the next range to request. */
+		size_t next_range;
+		/** Number of payload bytes left in the current response. */
+		size_t body_left;
+		/** Number of bytes received after the current response,
+		 *  which belong to the next pipelined response.
+		 */
+		size_t carry;
 	} http;
 
 	struct {
@@ -197,6 +207,33 @@ struct download_client {
 
 		/** CoAP pending object. */
 		struct coap_pending pending;
+
+#if defined(CONFIG_DOWNLOAD_CLIENT_COAP_WINDOW_SIZE) && \
+	(CONFIG_DOWNLOAD_CLIENT_COAP_WINDOW_SIZE > 1)
+		/** Number of the next block to request. */
+		size_t next_block;
+		/** Blocks requested in parallel,
+		 *  indexed by block number modulo the window size.
+		 */
+		struct download_client_coap_block {
+			/** CoAP pending object, the timeout is zero when not requested. */
+			struct coap_pending pending;
+			/** Token of the request. */
+			uint8_t token[COAP_TOKEN_MAX_LEN];
+			/** Block number. */
+			size_t num;
+			/** Length of the received payload. */
+			uint16_t len;
+			/** The block has been received, but not delivered yet. */
+			bool received;
+			/** The block is the last one of the file. */
+			bool last;
+			/** The request timed out and must be sent again. */
+			bool resend;
+			/** Payload of a block received out of order. */
+			uint8_t data[1 << (CONFIG_DOWNLOAD_CLIENT_COAP_BLOCK_SIZE + 4)];
+		} window[CONFIG_DOWNLOAD_CLIENT_COAP_WINDOW_SIZE];
+#endif
 	} coap;
 
 	/** Internal thread ID. */
@@ -64,6 +64,20 @@ typedef void (*mqtt_helper_on_connack_t)(enum mqtt_conn_return_code return_code,
 typedef void (*mqtt_helper_on_disconnect_t)(int result);
 typedef void (*mqtt_helper_on_publish_t)(struct mqtt_helper_buf topic_buf,
 					 struct mqtt_helper_buf payload_buf);
+
+/** @brief Handler for a part of the payload of an incoming PUBLISH message.
+ *	   If set, it is called instead of the on_publish handler, once for every
+ *	   CONFIG_MQTT_HELPER_PAYLOAD_BUFFER_LEN bytes of payload, so that payloads of any
+ *	   size can be received. It is called once with an empty chunk for an empty payload.
+ *
+ *  @param topic_buf Topic of the message.
+ *  @param chunk_buf Part of the payload. Only valid until the handler returns.
+ *  @param offset Offset of the chunk in the payload.
+ *  @param total_len Length of the whole payload.
+ */
+typedef void (*mqtt_helper_on_publish_chunk_t)(struct mqtt_helper_buf topic_buf,
+					       struct mqtt_helper_buf chunk_buf,
+					       size_t offset, size_t total_len);
 typedef void (*mqtt_helper_on_puback_t)(uint16_t message_id, int result);
 typedef void (*mqtt_helper_on_suback_t)(uint16_t message_id, int result);
 typedef void (*mqtt_helper_on_pingresp_t)(void);
@@ -79,6 +93,7 @@ struct mqtt_helper_cfg {
 		mqtt_helper_on_suback_t on_suback;
 		mqtt_helper_on_pingresp_t on_pingresp;
 		mqtt_helper_on_error_t on_error;
+		mqtt_helper_on_publish_chunk_t on_publish_chunk;
 	} cb;
 };
 
@@ -124,13 +139,26 @@ int mqtt_helper_disconnect(void);
 int mqtt_helper_subscribe(struct mqtt_subscription_list *sub_list);
 
 /** @brief Publish an MQTT message.
+ *
+ *  The payload is sent from the buffer of the caller, it is not copied.
+ *  If CONFIG_MQTT_HELPER_PUBLISH_WINDOW is not 0, QoS 1 messages are tracked until their
+ *  PUBACK is received. Their message ID must then be unique among the messages in flight,
+ *  and should be taken from mqtt_helper_msg_id_get().
  *
  *  @retval 0 if successful.
  *  @retval -EOPNOTSUPP if operation is not supported in the current state.
+ *  @retval -EAGAIN if the maximum number of QoS 1 messages is in flight.
+ *  @retval -EALREADY if a QoS 1 message with the same ID is in flight.
  *  @return Otherwise a negative error code.
  */
 int mqtt_helper_publish(const struct mqtt_publish_param *param);
 
+/** @brief Get a message ID for a publication or subscription.
+ *
+ *  @return A non-zero message ID that is not used by a QoS 1 message in flight.
+ */
+uint16_t mqtt_helper_msg_id_get(void);
+
 /** @brief Deinitialize library. Must be called when all MQTT operations are done to
  *	   release resources and allow for a new client. The client must be in a disconnected state.
  *
@@ -194,6 +194,83 @@ int nrf_cloud_coap_json_message_send(const char *message, bool bulk, bool confir
  */
 int nrf_cloud_coap_location_send(const struct nrf_cloud_gnss_data * const gnss, bool confirmable);
 
+/**
+ * @brief Store sensor data in the message queue, to be sent to nRF Cloud later.
+ *
+ *  The data is kept in flash until it is sent, also when the device is offline.
+ *  Queued messages are sent in batches, in a single CoAP request each, when
+ *  @kconfig{CONFIG_NRF_CLOUD_COAP_QUEUE_FLUSH_COUNT} messages are queued,
+ *  when the oldest one is @kconfig{CONFIG_NRF_CLOUD_COAP_QUEUE_FLUSH_AGE} seconds old,
+ *  when the device connects to nRF Cloud and when the LTE radio becomes active.
+ *  If the queue is full, the oldest messages are dropped.
+ *  Requires @kconfig{CONFIG_NRF_CLOUD_COAP_QUEUE}.
+ *
+ * @param[in]     app_id The app_id identifying the type of data. See the values in
+ *                       nrf_cloud_defs.h that begin with  NRF_CLOUD_JSON_APPID_.
+ *                       You may also use custom names.
+ * @param[in]     value  Sensor reading.
+ * @param[in]     ts_ms  Timestamp the data was measured, or NRF_CLOUD_NO_TIMESTAMP
+ *                       to use the current time.
+ *
+ * @retval 0 If successful.
+ * @retval -ENODATA The current time is not known.
+ * @retval -EPERM The queue is not initialized, see nrf_cloud_coap_init().
+ *          Otherwise, a (negative) error code is returned.
+ */
+int nrf_cloud_coap_sensor_queue(const char *app_id, double value, int64_t ts_ms);
+
+/**
+ * @brief Store a message in the message queue, to be sent to nRF Cloud later.
+ *
+ *  See nrf_cloud_coap_sensor_queue() for when the queued messages are sent.
+ *
+ * @param[in]     app_id  The app_id identifying the type of data. See the values in
+ *                        nrf_cloud_defs.h that begin with  NRF_CLOUD_JSON_APPID_.
+ *                        You may also use custom names.
+ * @param[in]     message The string to send.
+ * @param[in]     ts_ms   Timestamp the data was measured, or NRF_CLOUD_NO_TIMESTAMP
+ *                        to use the current time.
+ *
+ * @retval 0 If successful.
+ * @retval -EMSGSIZE The encoded message does not fit in a batch.
+ *          Otherwise, a (negative) error code is returned.
+ */
+int nrf_cloud_coap_message_queue(const char *app_id, const char *message, int64_t ts_ms);
+
+/**
+ * @brief Store the device location in the message queue, to be sent to nRF Cloud later.
+ *
+ *  Only @ref NRF_CLOUD_GNSS_TYPE_PVT is supported.
+ *  See nrf_cloud_coap_sensor_queue() for when the queued messages are sent.
+ *
+ * @param[in]     gnss A pointer to an @ref nrf_cloud_gnss_data struct indicating the device
+ *                     location, usually as determined by the GNSS unit.
+ *
+ * @retval 0 If successful.
+ *          Otherwise, a (negative) error code is returned.
+ */
+int nrf_cloud_coap_location_queue(const struct nrf_cloud_gnss_data * const gnss);
+
+/**
+ * @brief Send all the queued messages to nRF Cloud now.
+ *
+ *  The messages are sent in batches, as confirmable CoAP messages. A batch is
+ *  removed from the queue once nRF Cloud has acknowledged it.
+ *
+ * @retval 0 If successful.
+ * @retval -EACCES Not connected to nRF Cloud.
+ *          Otherwise, a (negative) error code or a positive CoAP result code is returned,
+ *          and the messages that were not sent are kept in the queue.
+ */
+int nrf_cloud_coap_queue_flush(void);
+
+/**
+ * @brief Get the number of messages in the queue.
+ *
+ * @return Number of messages that are not sent yet.
+ */
+size_t nrf_cloud_coap_queue_count(void);
+
 /**
  * @brief Request device location from nRF Cloud.
  *
@@ -143,6 +143,26 @@ struct rest_client_resp_context {
 	int used_socket_is_alive;
 };
 
+/**
+ * @brief Statistics of the connection cache.
+ */
+struct rest_client_conn_cache_stats {
+	/** Requests sent on a cached connection, without a new handshake. */
+	uint32_t reused;
+
+	/** Requests that could use the cache but needed a new connection. */
+	uint32_t connected;
+
+	/** Cached connections that the server had closed. */
+	uint32_t stale;
+
+	/** Cached connections closed after being idle for too long. */
+	uint32_t expired;
+
+	/** Cached connections closed to make room for another one. */
+	uint32_t evicted;
+};
+
 /**
  * @brief REST client request.
  *
@@ -168,6 +188,23 @@ int rest_client_request(struct rest_client_req_context *req_ctx,
  */
 void rest_client_request_defaults_set(struct rest_client_req_context *req_ctx);
 
+/**
+ * @brief Close the connections in the cache.
+ *
+ * @details For example before the network connection is lost, or to release the sockets.
+ *          Requires @kconfig{CONFIG_REST_CLIENT_CONN_CACHE}.
+ */
+void rest_client_conn_cache_flush(void);
+
+/**
+ * @brief Get the statistics of the connection cache.
+ *
+ * @details Requires @kconfig{CONFIG_REST_CLIENT_CONN_CACHE}.
+ *
+ * @param[out] stats Statistics since the boot.
+ */
+void rest_client_conn_cache_stats_get(struct rest_client_conn_cache_stats *stats);
+
 #ifdef __cplusplus
 }
 #endif
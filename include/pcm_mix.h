@@ -21,6 +21,12 @@
  * @{
  */
 
+/** Number of fractional bits in the gain passed to pcm_mix_ext. */
+#define PCM_MIX_GAIN_SHIFT 8
+
+/** Gain of 1.0 (0 dB) for pcm_mix_ext. Gain is unsigned Q8.8. */
+#define PCM_MIX_GAIN_UNITY (1 << PCM_MIX_GAIN_SHIFT)
+
 enum pcm_mix_mode {
 	B_STEREO_INTO_A_STEREO,
 	B_MONO_INTO_A_MONO,
@@ -52,6 +58,34 @@ enum pcm_mix_mode {
 int pcm_mix(void *const pcm_a, size_t size_a, void const *const pcm_b, size_t size_b,
 	    enum pcm_mix_mode mix_mode);
 
+/**
+ * @brief Mixes two buffers of PCM data, applying a gain to buffer B.
+ *
+ * @note Uses saturating addition. On cores with the DSP extension, two 16-bit
+ * samples are processed per instruction.
+ * Supports signed 16-bit samples, signed 24-bit samples right-aligned in a
+ * 32-bit carrier, and signed 32-bit samples. Both buffers must use the same format.
+ * To mix several streams with individual gains, clear buffer A and mix each
+ * stream into it with its own gain.
+ *
+ * @param pcm_a         [in/out] Pointer to the PCM data buffer A.
+ * @param size_a        [in]     Size of the PCM data buffer A (in bytes).
+ * @param pcm_b         [in]     Pointer to the PCM data buffer B.
+ * @param size_b        [in]     Size of the PCM data buffer B (in bytes).
+ * @param pcm_bit_depth [in]     Bit depth of the PCM samples (16, 24, or 32).
+ * @param gain_b        [in]     Gain applied to buffer B, unsigned Q8.8.
+ *				 Use PCM_MIX_GAIN_UNITY for no change.
+ * @param mix_mode      [in]     Mixing mode according to pcm_mix_mode.
+ *
+ * @retval 0            Success. Result stored in pcm_a.
+ * @retval -EINVAL      pcm_a is NULL, size_a = 0 or invalid bit depth.
+ * @retval -EPERM       Either size_b < size_a (for stereo to stereo, mono to mono)
+ *			or size_a/2 < size_b (for mono to stereo mix).
+ * @retval -ESRCH       Invalid mixing mode.
+ */
+int pcm_mix_ext(void *const pcm_a, size_t size_a, void const *const pcm_b, size_t size_b,
+		uint8_t pcm_bit_depth, uint16_t gain_b, enum pcm_mix_mode mix_mode);
+
 /**
  * @}
  */
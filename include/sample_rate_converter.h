@@ -39,7 +39,11 @@
 
 /** Filter types supported by the sample rate converter */
 enum sample_rate_converter_filter {
-	SAMPLE_RATE_FILTER_TEST = 1
+	SAMPLE_RATE_FILTER_TEST = 1,
+	/* Windowed-sinc polyphase filter bank supporting fractional conversion ratios.
+	 * Requires CONFIG_SAMPLE_RATE_CONVERTER_POLYPHASE.
+	 */
+	SAMPLE_RATE_FILTER_POLYPHASE = 2,
 };
 
 /**
@@ -77,6 +81,44 @@ struct buf_ctx {
 	size_t bytes_in_buf;
 };
 
+#ifdef CONFIG_SAMPLE_RATE_CONVERTER_POLYPHASE
+/** Number of coefficients in the polyphase phase table. */
+#define SAMPLE_RATE_CONVERTER_POLYPHASE_COEFFS_SIZE                                                \
+	(CONFIG_SAMPLE_RATE_CONVERTER_POLYPHASE_PHASES_MAX *                                       \
+	 CONFIG_SAMPLE_RATE_CONVERTER_POLYPHASE_TAPS)
+
+/** Number of samples in the polyphase delay line: filter history plus one full block. */
+#define SAMPLE_RATE_CONVERTER_POLYPHASE_DELAY_LINE_SIZE                                            \
+	(CONFIG_SAMPLE_RATE_CONVERTER_POLYPHASE_TAPS - 1 +                                         \
+	 CONFIG_SAMPLE_RATE_CONVERTER_BLOCK_SIZE_MAX)
+
+/** State for the fractional-ratio polyphase conversion */
+struct sample_rate_converter_polyphase {
+	/* Interpolation (L) and decimation (M) factors of the reduced conversion ratio L/M. */
+	uint16_t interpolation;
+	uint16_t decimation;
+
+	/* Sub-filter to use for the next output sample. */
+	uint16_t phase;
+
+	/* Number of samples at the start of the next input block that precede the next output
+	 * sample. Only non-zero when downsampling.
+	 */
+	uint16_t input_skip;
+
+	/* Phase table, TAPS coefficients per sub-filter stored in reverse order, and the delay
+	 * line holding the filter history between process calls.
+	 */
+#ifdef CONFIG_SAMPLE_RATE_CONVERTER_BIT_DEPTH_16
+	q15_t coeffs_15[SAMPLE_RATE_CONVERTER_POLYPHASE_COEFFS_SIZE];
+	q15_t delay_line_15[SAMPLE_RATE_CONVERTER_POLYPHASE_DELAY_LINE_SIZE];
+#elif CONFIG_SAMPLE_RATE_CONVERTER_BIT_DEPTH_32
+	q31_t coeffs_31[SAMPLE_RATE_CONVERTER_POLYPHASE_COEFFS_SIZE];
+	q31_t delay_line_31[SAMPLE_RATE_CONVERTER_POLYPHASE_DELAY_LINE_SIZE];
+#endif
+};
+#endif /* CONFIG_SAMPLE_RATE_CONVERTER_POLYPHASE */
+
 /** Context for the sample rate conversion */
 struct sample_rate_converter_ctx {
 	/* Input and output sample rate to be used for the conversion. */
@@ -84,7 +126,8 @@ struct sample_rate_converter_ctx {
 	uint32_t sample_rate_output;
 
 	/* The ratio for the current conversion. When the conversion is upsampling the ratio is
-	 * positive and negative when downsampling.
+	 * positive and negative when downsampling. Zero for the polyphase filter, which uses
+	 * the fractional ratio stored in the polyphase state.
 	 */
 	int conversion_ratio;
 
@@ -117,6 +160,11 @@ struct sample_rate_converter_ctx {
 #elif CONFIG_SAMPLE_RATE_CONVERTER_BIT_DEPTH_32
 	q31_t state_buf_31[SAMPLE_RATE_CONVERTER_STATE_BUFFER_SIZE];
 #endif
+
+#ifdef CONFIG_SAMPLE_RATE_CONVERTER_POLYPHASE
+	/* State for the polyphase filter. Used instead of the buffers above. */
+	struct sample_rate_converter_polyphase polyphase;
+#endif
 };
 
 /**
@@ -145,6 +193,12 @@ int sample_rate_converter_open(struct sample_rate_converter_ctx *ctx);
  *		based on the conversion ratio, the module will buffer both input and output bytes
  *		when needed to meet this criteria.
  *
+ *		With SAMPLE_RATE_FILTER_POLYPHASE, no input or output bytes are buffered. The
+ *		number of output samples then varies by one between calls for fractional ratios,
+ *		for example 44.1 kHz to 48 kHz gives 480 output samples for every 441 input
+ *		samples on average. The output buffer must hold
+ *		ceil(input samples * output rate / input rate) samples.
+ *
  * @param[in,out]	ctx			Pointer to the sample rate conversion context.
  * @param[in]		filter			Filter type to be used for the conversion.
  * @param[in]		input			Pointer to samples to process.
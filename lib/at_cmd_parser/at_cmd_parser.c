@@ -80,26 +80,6 @@ static inline bool check_response_for_forced_string(const char *tmpstr)
 	return retval;
 }
 
-static bool is_result(const char *str)
-{
-	int diff;
-	static const char * const toclip[] = {
-		"OK\r\n",
-		"ERROR\r\n",
-		"+CME ERROR",
-		"+CMS ERROR"
-	};
-
-	for (size_t i = 0; i < ARRAY_SIZE(toclip); i++) {
-		diff = strncmp(str, toclip[i], strlen(toclip[i]));
-		if (!diff) {
-			return true;
-		}
-	}
-
-	return false;
-}
-
 static int at_parse_detect_type(const char **str, int index)
 {
 	const char *tmpstr = *str;
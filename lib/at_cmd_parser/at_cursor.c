@@ -0,0 +1,424 @@
+/*
+ * Copyright (c) 2024 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#include <errno.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <string.h>
+#include <zephyr/sys/util.h>
+
+#include <modem/at_cursor.h>
+#include "at_utils.h"
+
+enum at_cursor_state {
+	/* Before the prefix of a line. */
+	LINE_START,
+	/* Before the first parameter of a line, which may be absent. */
+	PARAM_FIRST,
+	/* After a separator, so there is one more, possibly empty, parameter. */
+	PARAM_NEXT,
+	/* After the last parameter of a line. */
+	LINE_END,
+};
+
+static bool is_param_end(char chr)
+{
+	return (chr == AT_PARAM_SEPARATOR) || is_lfcr(chr) || is_terminated(chr);
+}
+
+static const char *spaces_skip(const char *str)
+{
+	while (*str == ' ') {
+		str++;
+	}
+
+	return str;
+}
+
+static void token_set(struct at_cursor_token *token, enum at_cursor_token_type type,
+		      const char *start, const char *end)
+{
+	token->type = type;
+	token->start = start;
+	token->len = end - start;
+}
+
+static int prefix_next(struct at_cursor *cursor, struct at_cursor_token *token)
+{
+	const char *str = cursor->ptr;
+	const char *start = str;
+
+	if (is_terminated(*str) || is_result(str)) {
+		cursor->state = LINE_END;
+		return -ENODATA;
+	}
+
+	if (is_notification(*str)) {
+		str++;
+		while (is_valid_notification_char(*str)) {
+			str++;
+		}
+
+		token_set(token, AT_CURSOR_TOKEN_TYPE_PREFIX, start, str);
+
+		if (*str == AT_RSP_SEPARATOR) {
+			str++;
+		}
+	} else if ((toupper((int)*str) == 'A') && is_command(str)) {
+		str += sizeof("AT") - 1;
+		if (!is_lfcr(*str) && !is_terminated(*str)) {
+			str++;
+		}
+		while (is_valid_command_char(*str)) {
+			str++;
+		}
+
+		token_set(token, AT_CURSOR_TOKEN_TYPE_PREFIX, start, str);
+
+		/* Skip set, read and test special characters. */
+		if (*str == AT_CMD_SEPARATOR) {
+			str++;
+		}
+		if (*str == AT_CMD_READ_TEST_IDENTIFIER) {
+			str++;
+		}
+	} else {
+		/* A line without a prefix is a single string, like an SMS PDU or a version. */
+		while (!is_lfcr(*str) && !is_terminated(*str)) {
+			str++;
+		}
+
+		token_set(token, AT_CURSOR_TOKEN_TYPE_STRING, start, str);
+		cursor->ptr = str;
+		cursor->state = LINE_END;
+		return 0;
+	}
+
+	cursor->ptr = str;
+	cursor->state = PARAM_FIRST;
+	return 0;
+}
+
+static int param_next(struct at_cursor *cursor, struct at_cursor_token *token)
+{
+	const char *str = spaces_skip(cursor->ptr);
+	const char *start = str;
+
+	if (is_lfcr(*str) || is_terminated(*str)) {
+		cursor->ptr = str;
+
+		if (cursor->state == PARAM_FIRST) {
+			cursor->state = LINE_END;
+			return -ENODATA;
+		}
+
+		/* Trailing empty parameter */
+		token_set(token, AT_CURSOR_TOKEN_TYPE_EMPTY, str, str);
+		cursor->state = LINE_END;
+		return 0;
+	}
+
+	if (is_dblquote(*str)) {
+		start = ++str;
+		/* Quoted strings may span lines, like certificates do. */
+		while (!is_dblquote(*str) && !is_terminated(*str)) {
+			str++;
+		}
+		if (is_terminated(*str)) {
+			cursor->ptr = str;
+			cursor->state = LINE_END;
+			return -EBADMSG;
+		}
+
+		token_set(token, AT_CURSOR_TOKEN_TYPE_STRING, start, str++);
+	} else if (is_array_start(*str)) {
+		int depth = 1;
+		bool quoted = false;
+
+		start = ++str;
+		/* Arrays may contain quoted strings and other arrays, like in +CIND. */
+		while (!is_lfcr(*str) && !is_terminated(*str)) {
+			if (is_dblquote(*str)) {
+				quoted = !quoted;
+			} else if (!quoted && is_array_start(*str)) {
+				depth++;
+			} else if (!quoted && is_array_stop(*str) && --depth == 0) {
+				break;
+			}
+			str++;
+		}
+		if (!is_array_stop(*str)) {
+			cursor->ptr = str;
+			cursor->state = LINE_END;
+			return -EBADMSG;
+		}
+
+		token_set(token, AT_CURSOR_TOKEN_TYPE_ARRAY, start, str++);
+	} else if (*str == AT_PARAM_SEPARATOR) {
+		token_set(token, AT_CURSOR_TOKEN_TYPE_EMPTY, str, str);
+	} else {
+		const char *end;
+
+		while (!is_param_end(*str)) {
+			str++;
+		}
+
+		end = str;
+		while (*(end - 1) == ' ') {
+			end--;
+		}
+
+		token_set(token, is_number(*start) ? AT_CURSOR_TOKEN_TYPE_NUMBER :
+						     AT_CURSOR_TOKEN_TYPE_STRING,
+			  start, end);
+	}
+
+	/* Skip anything up to the next separator. */
+	while (!is_param_end(*str)) {
+		str++;
+	}
+
+	if (*str == AT_PARAM_SEPARATOR) {
+		str++;
+		cursor->state = PARAM_NEXT;
+	} else {
+		cursor->state = LINE_END;
+	}
+
+	cursor->ptr = str;
+	return 0;
+}
+
+int at_cursor_init(struct at_cursor *cursor, const char *str)
+{
+	if (cursor == NULL || str == NULL) {
+		return -EINVAL;
+	}
+
+	/* trim leading CRLF */
+	while (is_lfcr(*str)) {
+		str++;
+	}
+
+	cursor->ptr = str;
+	cursor->state = LINE_START;
+
+	return 0;
+}
+
+int at_cursor_next(struct at_cursor *cursor, struct at_cursor_token *token)
+{
+	if (cursor == NULL || token == NULL) {
+		return -EINVAL;
+	}
+
+	switch (cursor->state) {
+	case LINE_START:
+		return prefix_next(cursor, token);
+	case PARAM_FIRST:
+	case PARAM_NEXT:
+		return param_next(cursor, token);
+	default:
+		return -ENODATA;
+	}
+}
+
+int at_cursor_line_next(struct at_cursor *cursor)
+{
+	struct at_cursor_token token;
+	const char *str;
+	int err;
+
+	if (cursor == NULL) {
+		return -EINVAL;
+	}
+
+	/* Go through the rest of the line token by token, to skip quoted line breaks. */
+	do {
+		err = at_cursor_next(cursor, &token);
+	} while (err == 0);
+
+	str = cursor->ptr;
+	while (is_lfcr(*str)) {
+		str++;
+	}
+
+	cursor->ptr = str;
+
+	if (is_terminated(*str) || is_result(str)) {
+		return -ENODATA;
+	}
+
+	cursor->state = LINE_START;
+
+	return 0;
+}
+
+static int number_decode(const char *str, size_t len, int64_t min, int64_t max, int64_t *value)
+{
+	const char *end = str + len;
+	bool negative = false;
+	uint64_t magnitude = 0;
+
+	while (str < end && *str == ' ') {
+		str++;
+	}
+	while (end > str && *(end - 1) == ' ') {
+		end--;
+	}
+
+	if (str < end && (*str == '-' || *str == '+')) {
+		negative = (*str == '-');
+		str++;
+	}
+
+	if (str == end) {
+		return -EINVAL;
+	}
+
+	for (; str < end; str++) {
+		if (!isdigit((int)*str)) {
+			return -EINVAL;
+		}
+
+		if (magnitude > (UINT64_MAX - (*str - '0')) / 10) {
+			return -ERANGE;
+		}
+
+		magnitude = magnitude * 10 + (*str - '0');
+	}
+
+	if (negative) {
+		if (magnitude > (uint64_t)INT64_MAX + 1) {
+			return -ERANGE;
+		}
+		*value = (magnitude == (uint64_t)INT64_MAX + 1) ? INT64_MIN : -(int64_t)magnitude;
+	} else {
+		if (magnitude > (uint64_t)INT64_MAX) {
+			return -ERANGE;
+		}
+		*value = (int64_t)magnitude;
+	}
+
+	if (*value < min || *value > max) {
+		return -ERANGE;
+	}
+
+	return 0;
+}
+
+int at_cursor_token_int64_get(const struct at_cursor_token *token, int64_t *value)
+{
+	if (token == NULL || value == NULL) {
+		return -EINVAL;
+	}
+
+	return number_decode(token->start, token->len, INT64_MIN, INT64_MAX, value);
+}
+
+int at_cursor_token_int_get(const struct at_cursor_token *token, int32_t *value)
+{
+	int64_t tmp;
+	int err;
+
+	if (token == NULL || value == NULL) {
+		return -EINVAL;
+	}
+
+	err = number_decode(token->start, token->len, INT32_MIN, INT32_MAX, &tmp);
+	if (err) {
+		return err;
+	}
+
+	*value = (int32_t)tmp;
+	return 0;
+}
+
+int at_cursor_token_unsigned_int_get(const struct at_cursor_token *token, uint32_t *value)
+{
+	int64_t tmp;
+	int err;
+
+	if (token == NULL || value == NULL) {
+		return -EINVAL;
+	}
+
+	err = number_decode(token->start, token->len, 0, UINT32_MAX, &tmp);
+	if (err) {
+		return err;
+	}
+
+	*value = (uint32_t)tmp;
+	return 0;
+}
+
+int at_cursor_token_string_get(const struct at_cursor_token *token, char *str, size_t *len)
+{
+	if (token == NULL || str == NULL || len == NULL) {
+		return -EINVAL;
+	}
+
+	if (*len <= token->len) {
+		return -ENOMEM;
+	}
+
+	memcpy(str, token->start, token->len);
+	str[token->len] = '\0';
+	*len = token->len;
+
+	return 0;
+}
+
+int at_cursor_token_array_get(const struct at_cursor_token *token, uint32_t *array,
+			      size_t *len)
+{
+	const char *str;
+	const char *end;
+	size_t count = 0;
+	int64_t value;
+	int err;
+
+	if (token == NULL || array == NULL || len == NULL ||
+	    token->type != AT_CURSOR_TOKEN_TYPE_ARRAY) {
+		return -EINVAL;
+	}
+
+	str = token->start;
+	end = token->start + token->len;
+
+	while (str < end) {
+		const char *next = memchr(str, AT_PARAM_SEPARATOR, end - str);
+
+		if (next == NULL) {
+			next = end;
+		}
+
+		if (count == *len) {
+			return -ENOMEM;
+		}
+
+		err = number_decode(str, next - str, 0, UINT32_MAX, &value);
+		if (err) {
+			return err;
+		}
+
+		array[count++] = (uint32_t)value;
+		str = next + 1;
+	}
+
+	*len = count;
+
+	return 0;
+}
+
+bool at_cursor_token_equal(const struct at_cursor_token *token, const char *str)
+{
+	if (token == NULL || str == NULL) {
+		return false;
+	}
+
+	return (strlen(str) == token->len) && !memcmp(token->start, str, token->len);
+}
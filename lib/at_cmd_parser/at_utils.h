@@ -19,6 +19,8 @@
 #include <zephyr/types.h>
 #include <stddef.h>
 #include <ctype.h>
+#include <string.h>
+#include <zephyr/sys/util.h>
 
 #define AT_PARAM_SEPARATOR ','
 #define AT_RSP_SEPARATOR ':'
@@ -273,7 +275,7 @@ static inline bool is_command(const char *str)
  * @retval true  If the string is a CLAC response
  * @retval false Otherwise
  */
-static bool is_clac(const char *str)
+static inline bool is_clac(const char *str)
 {
 	/* skip leading <CR><LF>, if any, as check not from index 0 */
 	while (is_lfcr(*str)) {
@@ -301,6 +303,32 @@ static bool is_clac(const char *str)
 
 	return true;
 }
+
+/**
+ * @brief Check if a string is a beginning of a final result code
+ *
+ * @param[in] str String to examine
+ *
+ * @retval true  If the string is OK, ERROR, +CME ERROR or +CMS ERROR
+ * @retval false Otherwise
+ */
+static inline bool is_result(const char *str)
+{
+	static const char * const toclip[] = {
+		"OK\r\n",
+		"ERROR\r\n",
+		"+CME ERROR",
+		"+CMS ERROR"
+	};
+
+	for (size_t i = 0; i < ARRAY_SIZE(toclip); i++) {
+		if (!strncmp(str, toclip[i], strlen(toclip[i]))) {
+			return true;
+		}
+	}
+
+	return false;
+}
 /** @} */
 
 #endif /* AT_UTILS_H__ */
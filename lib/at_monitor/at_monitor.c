@@ -10,13 +10,31 @@
 #include <zephyr/device.h>
 #include <nrf_modem_at.h>
 #include <modem/at_monitor.h>
+#include <debug/perf_counter.h>
 #include <zephyr/toolchain.h>
 #include <zephyr/logging/log.h>
 
+#if defined(CONFIG_AT_MONITOR_MATCHER)
+#include "at_monitor_matcher.h"
+#endif
+
 LOG_MODULE_REGISTER(at_monitor, CONFIG_AT_MONITOR_LOG_LEVEL);
 
+PERF_COUNTER_DEFINE(at_monitor_notif, "notifs");
+PERF_COUNTER_DEFINE(at_monitor_heap_fail, "notifs");
+PERF_HISTOGRAM_DEFINE(at_monitor_dispatch_time, "us");
+PERF_HISTOGRAM_DEFINE(at_monitor_queue_time, "us");
+
 struct at_notif_fifo {
 	void *fifo_reserved;
+#if defined(CONFIG_PERF_COUNTER)
+	/* Cycle count when the notification was queued. */
+	uint32_t timestamp;
+#endif
+#if defined(CONFIG_AT_MONITOR_MATCHER)
+	/* Monitors matched when the notification was received, if the matcher is in use. */
+	struct at_monitor_match match;
+#endif
 	char data[]; /* Null-terminated AT notification string */
 };
 
@@ -26,6 +44,11 @@ static K_FIFO_DEFINE(at_monitor_fifo);
 static K_HEAP_DEFINE(at_monitor_heap, CONFIG_AT_MONITOR_HEAP_SIZE);
 static K_WORK_DEFINE(at_monitor_work, at_monitor_task);
 
+#if defined(CONFIG_AT_MONITOR_MATCHER)
+/* Set once the matcher is built, otherwise every filter is searched for separately. */
+static bool matcher_ready;
+#endif
+
 static bool is_paused(const struct at_monitor_entry *mon)
 {
 	return mon->flags.paused;
@@ -41,19 +64,13 @@ static bool has_match(const struct at_monitor_entry *mon, const char *notif)
 	return (mon->filter == ANY || strstr(notif, mon->filter));
 }
 
-/* Dispatch AT notifications immediately, or schedules a workqueue task to do that.
- * Keep this function public so that it can be called by tests.
- * This function is called from an ISR.
+/* Match the notification with every filter separately, dispatch it to the direct monitors and
+ * return true if it is to be dispatched to other monitors from the workqueue.
  */
-void at_monitor_dispatch(const char *notif)
+static bool filters_dispatch(const char *notif)
 {
-	bool monitored;
-	struct at_notif_fifo *at_notif;
-	size_t sz_needed;
+	bool monitored = false;
 
-	__ASSERT_NO_MSG(notif != NULL);
-
-	monitored = false;
 	STRUCT_SECTION_FOREACH(at_monitor_entry, e) {
 		if (!is_paused(e) && has_match(e, notif)) {
 			if (is_direct(e)) {
@@ -66,6 +83,79 @@ void at_monitor_dispatch(const char *notif)
 		}
 	}
 
+	return monitored;
+}
+
+#if defined(CONFIG_AT_MONITOR_MATCHER)
+/* Call the handler of every matched monitor that is not paused and is either direct or not,
+ * in the order of the monitor section. Returns true if any other monitor that is not paused
+ * was matched.
+ */
+static bool matched_dispatch(const char *notif, const struct at_monitor_match *match,
+			     bool direct)
+{
+	struct at_monitor_entry *e;
+	bool others = false;
+
+	for (size_t i = 0; i < ARRAY_SIZE(match->bits); i++) {
+		uint32_t bits = match->bits[i];
+
+		while (bits) {
+			size_t idx = i * 32 + find_lsb_set(bits) - 1;
+
+			bits &= bits - 1;
+
+			STRUCT_SECTION_GET(at_monitor_entry, idx, &e);
+			if (is_paused(e)) {
+				continue;
+			}
+
+			if (is_direct(e) == direct) {
+				LOG_DBG("Dispatching to %p%s", e->handler, direct ? " (ISR)" : "");
+				e->handler(notif);
+			} else {
+				others = true;
+			}
+		}
+	}
+
+	return others;
+}
+#endif /* CONFIG_AT_MONITOR_MATCHER */
+
+/* Dispatch AT notifications immediately, or schedules a workqueue task to do that.
+ * Keep this function public so that it can be called by tests.
+ * This function is called from an ISR.
+ */
+void at_monitor_dispatch(const char *notif)
+{
+	bool monitored;
+	struct at_notif_fifo *at_notif;
+	size_t sz_needed;
+#if defined(CONFIG_AT_MONITOR_MATCHER)
+	struct at_monitor_match match;
+#endif
+
+	__ASSERT_NO_MSG(notif != NULL);
+
+	uint32_t start = PERF_TIMESTAMP();
+
+	PERF_COUNTER_INC(at_monitor_notif);
+
+#if defined(CONFIG_AT_MONITOR_MATCHER)
+	if (matcher_ready) {
+		at_monitor_matcher_match(notif, &match);
+		/* Copy and schedule work-queue task if other monitors matched */
+		monitored = matched_dispatch(notif, &match, true);
+	} else {
+		monitored = filters_dispatch(notif);
+	}
+#else
+	monitored = filters_dispatch(notif);
+#endif
+
+	PERF_HISTOGRAM_RECORD_SINCE(at_monitor_dispatch_time, start);
+
 	if (!monitored) {
 		/* Only copy monitored notifications to save heap */
 		return;
@@ -75,12 +165,21 @@ void at_monitor_dispatch(const char *notif)
 
 	at_notif = k_heap_alloc(&at_monitor_heap, sz_needed, K_NO_WAIT);
 	if (!at_notif) {
+		PERF_COUNTER_INC(at_monitor_heap_fail);
 		LOG_WRN("No heap space for incoming notification: %s", notif);
 		__ASSERT(at_notif, "No heap space for incoming notification: %s", notif);
 		return;
 	}
 
 	strcpy(at_notif->data, notif);
+#if defined(CONFIG_PERF_COUNTER)
+	at_notif->timestamp = PERF_TIMESTAMP();
+#endif
+#if defined(CONFIG_AT_MONITOR_MATCHER)
+	if (matcher_ready) {
+		at_notif->match = match;
+	}
+#endif
 
 	k_fifo_put(&at_monitor_fifo, at_notif);
 	k_work_submit(&at_monitor_work);
@@ -91,8 +190,19 @@ static void at_monitor_task(struct k_work *work)
 	struct at_notif_fifo *at_notif;
 
 	while ((at_notif = k_fifo_get(&at_monitor_fifo, K_NO_WAIT))) {
+#if defined(CONFIG_PERF_COUNTER)
+		PERF_HISTOGRAM_RECORD_SINCE(at_monitor_queue_time, at_notif->timestamp);
+#endif
 		/* Match notification with all monitors */
 		LOG_DBG("AT notif: %.*s", strlen(at_notif->data) - strlen("\r\n"), at_notif->data);
+#if defined(CONFIG_AT_MONITOR_MATCHER)
+		if (matcher_ready) {
+			/* Already matched in the ISR */
+			(void)matched_dispatch(at_notif->data, &at_notif->match, false);
+			k_heap_free(&at_monitor_heap, at_notif);
+			continue;
+		}
+#endif
 		STRUCT_SECTION_FOREACH(at_monitor_entry, e) {
 			if (!is_paused(e) && !is_direct(e) && has_match(e, at_notif->data)) {
 				LOG_DBG("Dispatching to %p", e->handler);
@@ -107,6 +217,15 @@ static int at_monitor_sys_init(void)
 {
 	int err;
 
+#if defined(CONFIG_AT_MONITOR_MATCHER)
+	err = at_monitor_matcher_build();
+	if (err) {
+		LOG_WRN("Matcher not built, err %d, matching each filter separately", err);
+	} else {
+		matcher_ready = true;
+	}
+#endif
+
 	err = nrf_modem_at_notif_handler_set(at_monitor_dispatch);
 	if (err) {
 		LOG_ERR("Failed to hook the dispatch function, err %d", err);
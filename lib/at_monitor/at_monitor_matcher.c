@@ -0,0 +1,216 @@
+/*
+ * Copyright (c) 2024 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#include <errno.h>
+#include <string.h>
+#include <zephyr/kernel.h>
+#include <modem/at_monitor.h>
+#include <zephyr/logging/log.h>
+
+#include "at_monitor_matcher.h"
+
+LOG_MODULE_DECLARE(at_monitor, CONFIG_AT_MONITOR_LOG_LEVEL);
+
+#define ROOT 0
+#define NO_ENTRY (-1)
+
+/* Node of an Aho-Corasick automaton built over the monitor filters.
+ * The children of a node are kept in a sibling list, since AT notifications
+ * use few distinct characters at any given position.
+ */
+struct matcher_node {
+	/* First child, or ROOT if none. */
+	uint16_t child;
+	/* Next sibling, or ROOT if none. */
+	uint16_t sibling;
+	/* Node of the longest proper suffix of this node that is also in the trie. */
+	uint16_t fail;
+	/* This node or the closest node on the failure path that ends a filter, or ROOT. */
+	uint16_t output;
+	/* First monitor whose filter ends in this node, or NO_ENTRY. */
+	int16_t entry;
+	/* Character leading to this node. */
+	char ch;
+};
+
+static struct matcher_node nodes[CONFIG_AT_MONITOR_MATCHER_NODES];
+static uint16_t node_count;
+/* Next monitor with the same filter, or NO_ENTRY. */
+static int16_t entry_next[CONFIG_AT_MONITOR_MATCHER_MONITORS_MAX];
+/* Monitors that match any notification. */
+static struct at_monitor_match any_match;
+
+static uint16_t child_find(uint16_t node, char ch)
+{
+	for (uint16_t n = nodes[node].child; n != ROOT; n = nodes[n].sibling) {
+		if (nodes[n].ch == ch) {
+			return n;
+		}
+	}
+
+	return ROOT;
+}
+
+static int child_add(uint16_t node, char ch, uint16_t *child)
+{
+	uint16_t n = child_find(node, ch);
+
+	if (n != ROOT) {
+		*child = n;
+		return 0;
+	}
+
+	if (node_count == ARRAY_SIZE(nodes)) {
+		return -ENOMEM;
+	}
+
+	n = node_count++;
+	nodes[n] = (struct matcher_node){
+		.sibling = nodes[node].child,
+		.entry = NO_ENTRY,
+		.ch = ch,
+	};
+	nodes[node].child = n;
+
+	*child = n;
+	return 0;
+}
+
+static void match_set(struct at_monitor_match *match, size_t idx)
+{
+	match->bits[idx / 32] |= BIT(idx % 32);
+}
+
+/* Insert the filters one character position at a time, so that the nodes are
+ * numbered in breadth-first order and the failure links can be set in one pass.
+ */
+static int trie_build(void)
+{
+	size_t depth = 0;
+	bool longer;
+	int err;
+
+	do {
+		size_t idx = 0;
+
+		longer = false;
+
+		STRUCT_SECTION_FOREACH(at_monitor_entry, e) {
+			size_t len = (e->filter == ANY) ? 0 : strlen(e->filter);
+			uint16_t node = ROOT;
+
+			if (len <= depth) {
+				idx++;
+				continue;
+			}
+
+			/* The path to the previous position is already in the trie. */
+			for (size_t i = 0; i < depth; i++) {
+				node = child_find(node, e->filter[i]);
+			}
+
+			err = child_add(node, e->filter[depth], &node);
+			if (err) {
+				return err;
+			}
+
+			if (len == depth + 1) {
+				entry_next[idx] = nodes[node].entry;
+				nodes[node].entry = idx;
+			}
+
+			longer = longer || (len > depth + 1);
+			idx++;
+		}
+
+		depth++;
+	} while (longer);
+
+	return 0;
+}
+
+static void links_build(void)
+{
+	for (uint16_t node = ROOT; node < node_count; node++) {
+		for (uint16_t n = nodes[node].child; n != ROOT; n = nodes[n].sibling) {
+			uint16_t fail = ROOT;
+
+			if (node != ROOT) {
+				fail = nodes[node].fail;
+				while ((fail != ROOT) && (child_find(fail, nodes[n].ch) == ROOT)) {
+					fail = nodes[fail].fail;
+				}
+				fail = child_find(fail, nodes[n].ch);
+			}
+
+			/* The failure node is shallower, so its links are already set. */
+			nodes[n].fail = fail;
+			nodes[n].output = (nodes[n].entry != NO_ENTRY) ? n : nodes[fail].output;
+		}
+	}
+}
+
+int at_monitor_matcher_build(void)
+{
+	size_t count = 0;
+	int err;
+
+	STRUCT_SECTION_COUNT(at_monitor_entry, &count);
+	if (count > CONFIG_AT_MONITOR_MATCHER_MONITORS_MAX) {
+		LOG_ERR("Too many monitors for the matcher: %zu", count);
+		return -ENOMEM;
+	}
+
+	memset(&any_match, 0, sizeof(any_match));
+	node_count = 1;
+	nodes[ROOT] = (struct matcher_node){.entry = NO_ENTRY};
+
+	err = trie_build();
+	if (err) {
+		LOG_ERR("Too many filter characters for the matcher");
+		return err;
+	}
+
+	links_build();
+
+	count = 0;
+	STRUCT_SECTION_FOREACH(at_monitor_entry, e) {
+		/* An empty filter is found in any notification, like with strstr() */
+		if ((e->filter == ANY) || (e->filter[0] == '\0')) {
+			match_set(&any_match, count);
+		}
+		count++;
+	}
+
+	LOG_DBG("Matcher built, %d nodes", node_count);
+
+	return 0;
+}
+
+void at_monitor_matcher_match(const char *notif, struct at_monitor_match *match)
+{
+	uint16_t node = ROOT;
+
+	*match = any_match;
+
+	for (; *notif != '\0'; notif++) {
+		uint16_t next = child_find(node, *notif);
+
+		while ((next == ROOT) && (node != ROOT)) {
+			node = nodes[node].fail;
+			next = child_find(node, *notif);
+		}
+
+		node = next;
+
+		for (uint16_t out = nodes[node].output; out != ROOT;
+		     out = nodes[nodes[out].fail].output) {
+			for (int16_t idx = nodes[out].entry; idx != NO_ENTRY; idx = entry_next[idx]) {
+				match_set(match, idx);
+			}
+		}
+	}
+}
@@ -0,0 +1,30 @@
+/*
+ * Copyright (c) 2024 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#ifndef AT_MONITOR_MATCHER_H_
+#define AT_MONITOR_MATCHER_H_
+
+#include <stdint.h>
+#include <zephyr/sys/util.h>
+
+#define AT_MONITOR_MATCH_WORDS DIV_ROUND_UP(CONFIG_AT_MONITOR_MATCHER_MONITORS_MAX, 32)
+
+/* Set of monitors, indexed by their position in the monitor section. */
+struct at_monitor_match {
+	uint32_t bits[AT_MONITOR_MATCH_WORDS];
+};
+
+/* Build the automaton from the filters of all monitors.
+ * Returns 0 on success, or -ENOMEM if the monitors or filters do not fit in the tables.
+ */
+int at_monitor_matcher_build(void);
+
+/* Find all monitors whose filter is found in the notification, in a single pass.
+ * Monitors with the ANY filter always match. Can be called from an ISR.
+ */
+void at_monitor_matcher_match(const char *notif, struct at_monitor_match *match);
+
+#endif /* AT_MONITOR_MATCHER_H_ */
@@ -7,10 +7,15 @@
 #include "data_fifo.h"
 
 #include <zephyr/kernel.h>
+#include <debug/perf_counter.h>
 
 #include <zephyr/logging/log.h>
 LOG_MODULE_REGISTER(data_fifo, CONFIG_DATA_FIFO_LOG_LEVEL);
 
+PERF_COUNTER_DEFINE(data_fifo_alloc, "blocks");
+PERF_COUNTER_DEFINE(data_fifo_alloc_fail, "blocks");
+PERF_COUNTER_DEFINE(data_fifo_written, "B");
+
 static struct k_spinlock lock;
 
 /** @brief Checks that the elements in the msgq and slab are legal.
@@ -41,6 +46,224 @@ static int msgq_slab_legal_used_elements(struct data_fifo *data_fifo, uint32_t *
 	return 0;
 }
 
+#if defined(CONFIG_DATA_FIFO_SPSC)
+static inline uint32_t spsc_idx_next(struct data_fifo *data_fifo, uint32_t idx)
+{
+	idx++;
+
+	return (idx == 2 * data_fifo->elements_max) ? 0 : idx;
+}
+
+static inline uint32_t spsc_idx_prev(struct data_fifo *data_fifo, uint32_t idx)
+{
+	return (idx == 0) ? (2 * data_fifo->elements_max - 1) : (idx - 1);
+}
+
+/** @brief Number of ring positions from index @p from up to index @p to. */
+static inline uint32_t spsc_idx_dist(struct data_fifo *data_fifo, uint32_t from, uint32_t to)
+{
+	return (to + 2 * data_fifo->elements_max - from) % (2 * data_fifo->elements_max);
+}
+
+static inline void *spsc_block_get(struct data_fifo *data_fifo, uint32_t idx)
+{
+	return &data_fifo->slab_buffer[(idx % data_fifo->elements_max) * data_fifo->block_size_max];
+}
+
+static bool spsc_vacant(struct data_fifo *data_fifo)
+{
+	return spsc_idx_dist(data_fifo, atomic_get(&data_fifo->ring.free_idx),
+			     atomic_get(&data_fifo->ring.alloc_idx)) < data_fifo->elements_max;
+}
+
+static bool spsc_filled(struct data_fifo *data_fifo)
+{
+	return atomic_get(&data_fifo->ring.get_idx) != atomic_get(&data_fifo->ring.lock_idx);
+}
+
+/** @brief Wait until @p ready is true for the SPSC ring.
+ *
+ * The semaphore is only given by the other side when the waiting flag is set,
+ * so the fast path never enters the kernel. The flag is set before the ring
+ * is re-checked, hence an update published in between is never missed.
+ */
+static int spsc_wait(struct data_fifo *data_fifo, bool (*ready)(struct data_fifo *),
+		     struct k_sem *sem, atomic_t *waiting, int no_wait_err, k_timeout_t timeout)
+{
+	int ret;
+
+	if (ready(data_fifo)) {
+		return 0;
+	}
+
+	if (K_TIMEOUT_EQ(timeout, K_NO_WAIT)) {
+		return no_wait_err;
+	}
+
+	/* Drop any stale give from a previous wait */
+	k_sem_reset(sem);
+	atomic_set(waiting, 1);
+
+	while (!ready(data_fifo)) {
+		ret = k_sem_take(sem, timeout);
+		if (ret) {
+			atomic_set(waiting, 0);
+
+			/* The other side may have published just before the timeout */
+			return ready(data_fifo) ? 0 : -EAGAIN;
+		}
+	}
+
+	atomic_set(waiting, 0);
+
+	return 0;
+}
+
+static inline void spsc_notify(struct k_sem *sem, atomic_t *waiting)
+{
+	if (atomic_get(waiting)) {
+		k_sem_give(sem);
+	}
+}
+
+static int spsc_pointer_first_vacant_get(struct data_fifo *data_fifo, void **data,
+					 k_timeout_t timeout)
+{
+	struct data_fifo_spsc *ring = &data_fifo->ring;
+	uint32_t alloc_idx;
+	int ret;
+
+	ret = spsc_wait(data_fifo, spsc_vacant, &ring->vacant_sem, &ring->vacant_waiting, -ENOMEM,
+			timeout);
+	if (ret) {
+		return ret;
+	}
+
+	alloc_idx = atomic_get(&ring->alloc_idx);
+	*data = spsc_block_get(data_fifo, alloc_idx);
+	atomic_set(&ring->alloc_idx, spsc_idx_next(data_fifo, alloc_idx));
+
+	return 0;
+}
+
+static int spsc_block_lock(struct data_fifo *data_fifo, void **data, size_t size)
+{
+	struct data_fifo_spsc *ring = &data_fifo->ring;
+	uint32_t lock_idx = atomic_get(&ring->lock_idx);
+
+	if (lock_idx == atomic_get(&ring->alloc_idx) ||
+	    *data != spsc_block_get(data_fifo, lock_idx)) {
+		LOG_ERR("Block %p is not the oldest unlocked block", *data);
+		return -ESPIPE;
+	}
+
+	ring->sizes[lock_idx % data_fifo->elements_max] = size;
+
+	/* Publishing the index hands the block over to the consumer */
+	atomic_set(&ring->lock_idx, spsc_idx_next(data_fifo, lock_idx));
+	spsc_notify(&ring->filled_sem, &ring->filled_waiting);
+
+	return 0;
+}
+
+static int spsc_pointer_last_filled_get(struct data_fifo *data_fifo, void **data, size_t *size,
+					k_timeout_t timeout)
+{
+	struct data_fifo_spsc *ring = &data_fifo->ring;
+	uint32_t get_idx;
+	int ret;
+
+	ret = spsc_wait(data_fifo, spsc_filled, &ring->filled_sem, &ring->filled_waiting, -ENOMSG,
+			timeout);
+	if (ret) {
+		return ret;
+	}
+
+	get_idx = atomic_get(&ring->get_idx);
+	*data = spsc_block_get(data_fifo, get_idx);
+	*size = ring->sizes[get_idx % data_fifo->elements_max];
+	atomic_set(&ring->get_idx, spsc_idx_next(data_fifo, get_idx));
+
+	return 0;
+}
+
+static void spsc_block_free(struct data_fifo *data_fifo, void *data)
+{
+	struct data_fifo_spsc *ring = &data_fifo->ring;
+	uint32_t free_idx = atomic_get(&ring->free_idx);
+	uint32_t alloc_idx;
+
+	/* Consumer returning the oldest retrieved block */
+	if (free_idx != atomic_get(&ring->get_idx) && data == spsc_block_get(data_fifo, free_idx)) {
+		atomic_set(&ring->free_idx, spsc_idx_next(data_fifo, free_idx));
+		spsc_notify(&ring->vacant_sem, &ring->vacant_waiting);
+		return;
+	}
+
+	/* Producer dropping its latest allocation before locking it */
+	alloc_idx = atomic_get(&ring->alloc_idx);
+	if (alloc_idx != atomic_get(&ring->lock_idx) &&
+	    data == spsc_block_get(data_fifo, spsc_idx_prev(data_fifo, alloc_idx))) {
+		atomic_set(&ring->alloc_idx, spsc_idx_prev(data_fifo, alloc_idx));
+		return;
+	}
+
+	LOG_ERR("Block %p cannot be freed out of order", data);
+	__ASSERT(false, "Out of order free in SPSC data_fifo");
+}
+
+static int spsc_num_used_get(struct data_fifo *data_fifo, uint32_t *alloced_num,
+			     uint32_t *locked_num)
+{
+	struct data_fifo_spsc *ring = &data_fifo->ring;
+
+	/* Read order guarantees locked <= alloced even while both sides run */
+	uint32_t free_idx = atomic_get(&ring->free_idx);
+	uint32_t get_idx = atomic_get(&ring->get_idx);
+	uint32_t lock_idx = atomic_get(&ring->lock_idx);
+	uint32_t alloc_idx = atomic_get(&ring->alloc_idx);
+
+	*alloced_num = spsc_idx_dist(data_fifo, free_idx, alloc_idx);
+	*locked_num = spsc_idx_dist(data_fifo, get_idx, lock_idx);
+
+	return 0;
+}
+
+static void spsc_reset(struct data_fifo *data_fifo)
+{
+	struct data_fifo_spsc *ring = &data_fifo->ring;
+
+	atomic_set(&ring->alloc_idx, 0);
+	atomic_set(&ring->lock_idx, 0);
+	atomic_set(&ring->get_idx, 0);
+	atomic_set(&ring->free_idx, 0);
+	atomic_set(&ring->vacant_waiting, 0);
+	atomic_set(&ring->filled_waiting, 0);
+	k_sem_reset(&ring->vacant_sem);
+	k_sem_reset(&ring->filled_sem);
+}
+
+static void spsc_init(struct data_fifo *data_fifo)
+{
+	__ASSERT_NO_MSG(data_fifo->ring.sizes != NULL);
+
+	k_sem_init(&data_fifo->ring.vacant_sem, 0, 1);
+	k_sem_init(&data_fifo->ring.filled_sem, 0, 1);
+	spsc_reset(data_fifo);
+}
+
+#define IS_SPSC(data_fifo) ((data_fifo)->spsc)
+#else
+#define IS_SPSC(data_fifo) false
+#define spsc_pointer_first_vacant_get(...) (-ENOTSUP)
+#define spsc_block_lock(...)		  (-ENOTSUP)
+#define spsc_pointer_last_filled_get(...)  (-ENOTSUP)
+#define spsc_block_free(...)
+#define spsc_num_used_get(...)		  (-ENOTSUP)
+#define spsc_reset(...)
+#define spsc_init(...)
+#endif /* CONFIG_DATA_FIFO_SPSC */
+
 int data_fifo_pointer_first_vacant_get(struct data_fifo *data_fifo, void **data,
 				       k_timeout_t timeout)
 {
@@ -48,7 +271,18 @@ int data_fifo_pointer_first_vacant_get(struct data_fifo *data_fifo, void **data,
 	__ASSERT_NO_MSG(data_fifo->initialized);
 	int ret;
 
-	ret = k_mem_slab_alloc(&data_fifo->mem_slab, data, timeout);
+	if (IS_SPSC(data_fifo)) {
+		ret = spsc_pointer_first_vacant_get(data_fifo, data, timeout);
+	} else {
+		ret = k_mem_slab_alloc(&data_fifo->mem_slab, data, timeout);
+	}
+
+	if (ret) {
+		PERF_COUNTER_INC(data_fifo_alloc_fail);
+	} else {
+		PERF_COUNTER_INC(data_fifo_alloc);
+	}
+
 	return ret;
 }
 
@@ -66,6 +300,15 @@ int data_fifo_block_lock(struct data_fifo *data_fifo, void **data, size_t size)
 		return -EINVAL;
 	}
 
+	if (IS_SPSC(data_fifo)) {
+		ret = spsc_block_lock(data_fifo, data, size);
+		if (ret == 0) {
+			PERF_COUNTER_ADD(data_fifo_written, size);
+		}
+
+		return ret;
+	}
+
 	struct data_fifo_msgq msgq_tmp;
 
 	msgq_tmp.block_ptr = *data;
@@ -81,6 +324,8 @@ int data_fifo_block_lock(struct data_fifo *data_fifo, void **data, size_t size)
 		return -ESPIPE;
 	}
 
+	PERF_COUNTER_ADD(data_fifo_written, size);
+
 	return 0;
 }
 
@@ -91,6 +336,10 @@ int data_fifo_pointer_last_filled_get(struct data_fifo *data_fifo, void **data,
 	__ASSERT_NO_MSG(data_fifo->initialized);
 	int ret;
 
+	if (IS_SPSC(data_fifo)) {
+		return spsc_pointer_last_filled_get(data_fifo, data, size, timeout);
+	}
+
 	struct data_fifo_msgq msgq_tmp;
 
 	ret = k_msgq_get(&data_fifo->msgq, &msgq_tmp, timeout);
@@ -108,6 +357,11 @@ void data_fifo_block_free(struct data_fifo *data_fifo, void *data)
 	__ASSERT_NO_MSG(data_fifo != NULL);
 	__ASSERT_NO_MSG(data_fifo->initialized);
 
+	if (IS_SPSC(data_fifo)) {
+		spsc_block_free(data_fifo, data);
+		return;
+	}
+
 	k_mem_slab_free(&data_fifo->mem_slab, data);
 }
 
@@ -120,6 +374,10 @@ int data_fifo_num_used_get(struct data_fifo *data_fifo, uint32_t *alloced_num, u
 	uint32_t msgq_num_used = UINT32_MAX;
 	uint32_t slab_blocks_num_used = UINT32_MAX;
 
+	if (IS_SPSC(data_fifo)) {
+		return spsc_num_used_get(data_fifo, alloced_num, locked_num);
+	}
+
 	ret = msgq_slab_legal_used_elements(data_fifo, &msgq_num_used, &slab_blocks_num_used);
 	if (ret) {
 		return ret;
@@ -156,6 +414,12 @@ int data_fifo_empty(struct data_fifo *data_fifo)
 		data_fifo_block_free(data_fifo, old_data);
 	}
 
+	if (IS_SPSC(data_fifo)) {
+		/* Also reclaims blocks that were allocated but never locked */
+		spsc_reset(data_fifo);
+		return 0;
+	}
+
 	/* Re-init k_mem_slab to reset the number of alloced slabs */
 	ret = k_mem_slab_init(&data_fifo->mem_slab, data_fifo->slab_buffer,
 			      data_fifo->block_size_max, data_fifo->elements_max);
@@ -176,6 +440,12 @@ int data_fifo_init(struct data_fifo *data_fifo)
 	__ASSERT_NO_MSG((data_fifo->block_size_max % WB_UP(1)) == 0);
 	int ret;
 
+	if (IS_SPSC(data_fifo)) {
+		spsc_init(data_fifo);
+		data_fifo->initialized = true;
+		return 0;
+	}
+
 	k_msgq_init(&data_fifo->msgq, data_fifo->msgq_buffer, sizeof(struct data_fifo_msgq),
 		    data_fifo->elements_max);
 
@@ -7,6 +7,7 @@
 #include <sys/types.h>
 #include <zephyr/kernel.h>
 #include <zephyr/logging/log.h>
+#include <debug/perf_counter.h>
 #include <modem/nrf_modem_lib.h>
 #include <modem/nrf_modem_lib_trace.h>
 #include <modem/trace_backend.h>
@@ -16,6 +17,10 @@
 #include <nrf_modem_trace.h>
 #include <nrf_errno.h>
 
+#if CONFIG_NRF_MODEM_LIB_TRACE_COMPRESSION
+#include "trace_compress.h"
+#endif
+
 LOG_MODULE_REGISTER(nrf_modem_lib_trace, CONFIG_NRF_MODEM_LIB_LOG_LEVEL);
 
 K_SEM_DEFINE(trace_sem, 0, 1);
@@ -119,6 +124,9 @@ uint32_t nrf_modem_lib_trace_backend_bitrate_get(void)
 	return backend_bps_avg;
 }
 
+PERF_GAUGE_DEFINE(nrf_modem_lib_trace_backend_bitrate, "bps",
+		  nrf_modem_lib_trace_backend_bitrate_get);
+
 static void trace_backend_bitrate_perf_start(void)
 {
 	backend_measurement_start = k_uptime_ticks();
@@ -199,6 +207,14 @@ static void bps_log(struct k_work *item)
 	LOG_INF("Written: %d, read: %d", trace_bytes_received_total, trace_bytes_read_total);
 	LOG_INF("Trace bitrate (bps): %u", trace_data_bps_avg);
 
+#if CONFIG_NRF_MODEM_LIB_TRACE_COMPRESSION
+	size_t bytes_in;
+	size_t bytes_out;
+
+	nrf_modem_lib_trace_compression_stats_get(&bytes_in, &bytes_out);
+	LOG_INF("Compressed: %d, written: %d", bytes_in, bytes_out);
+#endif
+
 	k_work_schedule(&bps_log_work, BPS_LOG_PERIOD);
 }
 
@@ -231,16 +247,15 @@ int nrf_modem_lib_trace_processing_done_wait(k_timeout_t timeout)
 	return 0;
 }
 
-static int trace_fragment_write(struct nrf_modem_trace_data *frag)
+static int trace_buf_write(const void *data, size_t len)
 {
 	int ret;
-	size_t remaining = frag->len;
+	size_t remaining = len;
 
 	while (remaining) {
 		PERF_START();
 
-		ret = trace_backend.write((void *)((uint8_t *)frag->data + frag->len - remaining),
-					  remaining);
+		ret = trace_backend.write((const uint8_t *)data + len - remaining, remaining);
 
 		PERF_END(ret);
 
@@ -272,6 +287,73 @@ static int trace_fragment_write(struct nrf_modem_trace_data *frag)
 	return 0;
 }
 
+#if CONFIG_NRF_MODEM_LIB_TRACE_COMPRESSION
+static uint8_t compress_buf[TRACE_COMPRESS_OUT_SIZE];
+/* Number of bytes of the current fragment that have been compressed and written */
+static size_t compress_frag_offset;
+static size_t compress_bytes_in;
+static size_t compress_bytes_out;
+
+void nrf_modem_lib_trace_compression_stats_get(size_t *bytes_in, size_t *bytes_out)
+{
+	unsigned int key = irq_lock();
+
+	*bytes_in = compress_bytes_in;
+	*bytes_out = compress_bytes_out;
+
+	irq_unlock(key);
+}
+
+/* The backends report the processed compressed data, which does not match the trace data
+ * given by the modem. Instead, the trace data is released once it has been compressed and
+ * written to the backend.
+ */
+static int compressed_data_processed(size_t len)
+{
+	return 0;
+}
+
+static int trace_fragment_write(struct nrf_modem_trace_data *frag)
+{
+	int err;
+	unsigned int key;
+
+	while (compress_frag_offset < frag->len) {
+		size_t raw_len = MIN(frag->len - compress_frag_offset,
+				     CONFIG_NRF_MODEM_LIB_TRACE_COMPRESSION_BLOCK_SIZE);
+		size_t out_len = trace_compress_block(
+			(const uint8_t *)frag->data + compress_frag_offset, raw_len, compress_buf);
+
+		/* If this fails, the block is compressed and written again on retry */
+		err = trace_buf_write(compress_buf, out_len);
+		if (err) {
+			return err;
+		}
+
+		err = nrf_modem_trace_processed(raw_len);
+		if (err) {
+			LOG_ERR("nrf_modem_trace_processed failed with err: %d", err);
+		}
+
+		compress_frag_offset += raw_len;
+
+		key = irq_lock();
+		compress_bytes_in += raw_len;
+		compress_bytes_out += out_len;
+		irq_unlock(key);
+	}
+
+	compress_frag_offset = 0;
+
+	return 0;
+}
+#else
+static int trace_fragment_write(struct nrf_modem_trace_data *frag)
+{
+	return trace_buf_write(frag->data, frag->len);
+}
+#endif /* CONFIG_NRF_MODEM_LIB_TRACE_COMPRESSION */
+
 void trace_thread_handler(void)
 {
 	int err;
@@ -358,7 +440,11 @@ static int trace_init(void)
 
 	k_sem_take(&trace_done_sem, K_FOREVER);
 
+#if CONFIG_NRF_MODEM_LIB_TRACE_COMPRESSION
+	err = trace_backend.init(compressed_data_processed);
+#else
 	err = trace_backend.init(nrf_modem_trace_processed);
+#endif
 	if (err) {
 		LOG_ERR("trace_backend: init failed with err: %d", err);
 		return err;
@@ -413,6 +499,9 @@ static int trace_deinit(void)
 		return err;
 	}
 
+#if CONFIG_NRF_MODEM_LIB_TRACE_COMPRESSION
+	compress_frag_offset = 0;
+#endif
 
 #if CONFIG_NRF_MODEM_LIB_TRACE_BACKEND_BITRATE
 	k_work_cancel(&backend_bps_avg_update_work);
@@ -0,0 +1,178 @@
+/*
+ * Copyright (c) 2024 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#include <string.h>
+#include <zephyr/kernel.h>
+#include <zephyr/sys/byteorder.h>
+#include <zephyr/sys/crc.h>
+#include "trace_compress.h"
+
+BUILD_ASSERT(CONFIG_NRF_MODEM_LIB_TRACE_COMPRESSION_BLOCK_SIZE <= UINT16_MAX,
+	     "Match offsets and block lengths are 16-bit");
+
+/* Parameters of the LZ4 block format */
+#define MIN_MATCH     4
+/* The last 5 bytes of a block are always literals */
+#define LAST_LITERALS 5
+/* The last match must start at least 12 bytes before the end of the block */
+#define MF_LIMIT      12
+#define RUN_MASK      15
+
+#define HASH_BITS CONFIG_NRF_MODEM_LIB_TRACE_COMPRESSION_HASH_BITS
+
+/* Position in the block of the last sequence seen with each hash */
+static uint16_t hash_table[1 << HASH_BITS];
+
+static uint32_t read32(const uint8_t *p)
+{
+	uint32_t val;
+
+	memcpy(&val, p, sizeof(val));
+	return val;
+}
+
+static uint32_t hash(uint32_t seq)
+{
+	/* Knuth's multiplicative hash */
+	return (seq * 2654435761U) >> (32 - HASH_BITS);
+}
+
+static uint8_t *length_write(uint8_t *op, size_t len)
+{
+	while (len >= 255) {
+		*op++ = 255;
+		len -= 255;
+	}
+	*op++ = len;
+
+	return op;
+}
+
+/* Worst case size of a sequence */
+static size_t sequence_size(size_t literals, size_t match_len)
+{
+	return 1 + (literals / 255 + 1) + literals + 2 + (match_len / 255 + 1);
+}
+
+static uint8_t *sequence_write(uint8_t *op, const uint8_t *literals, size_t literals_len,
+			       uint16_t offset, size_t match_len)
+{
+	uint8_t *token = op++;
+
+	*token = MIN(literals_len, RUN_MASK) << 4;
+	if (literals_len >= RUN_MASK) {
+		op = length_write(op, literals_len - RUN_MASK);
+	}
+
+	memcpy(op, literals, literals_len);
+	op += literals_len;
+
+	if (offset) {
+		*token |= MIN(match_len, RUN_MASK);
+		sys_put_le16(offset, op);
+		op += 2;
+		if (match_len >= RUN_MASK) {
+			op = length_write(op, match_len - RUN_MASK);
+		}
+	}
+
+	return op;
+}
+
+/* Returns the compressed length, or zero if it would exceed out_max. */
+static size_t lz4_compress(const uint8_t *in, size_t len, uint8_t *out, size_t out_max)
+{
+	const uint8_t *ip = in;
+	const uint8_t *anchor = in;
+	const uint8_t *const in_end = in + len;
+	const uint8_t *const match_end = in_end - LAST_LITERALS;
+	uint8_t *op = out;
+	uint8_t *const op_end = out + out_max;
+
+	memset(hash_table, 0, sizeof(hash_table));
+
+	while (len > MF_LIMIT && ip <= in_end - MF_LIMIT) {
+		uint32_t seq = read32(ip);
+		uint32_t h = hash(seq);
+		const uint8_t *ref = in + hash_table[h];
+		const uint8_t *mp;
+		const uint8_t *mr;
+		size_t match_len;
+
+		hash_table[h] = ip - in;
+
+		if (ref >= ip || read32(ref) != seq) {
+			ip++;
+			continue;
+		}
+
+		/* Extend the match backwards over the pending literals */
+		while (ip > anchor && ref > in && ip[-1] == ref[-1]) {
+			ip--;
+			ref--;
+		}
+
+		mp = ip + MIN_MATCH;
+		mr = ref + MIN_MATCH;
+		while (mp < match_end && *mp == *mr) {
+			mp++;
+			mr++;
+		}
+
+		match_len = mp - ip - MIN_MATCH;
+
+		if (op + sequence_size(ip - anchor, match_len) > op_end) {
+			return 0;
+		}
+
+		op = sequence_write(op, anchor, ip - anchor, ip - ref, match_len);
+
+		ip = mp;
+		anchor = ip;
+
+		/* Index a position inside the match to find overlapping repetitions */
+		hash_table[hash(read32(ip - 2))] = ip - 2 - in;
+	}
+
+	if (op + sequence_size(in_end - anchor, 0) - 3 > op_end) {
+		return 0;
+	}
+
+	op = sequence_write(op, anchor, in_end - anchor, 0, 0);
+
+	return op - out;
+}
+
+size_t trace_compress_block(const uint8_t *in, size_t len, uint8_t *out)
+{
+	uint8_t *payload = out + TRACE_COMPRESS_HDR_SIZE;
+	size_t payload_len;
+	uint16_t crc;
+
+	__ASSERT_NO_MSG(len <= CONFIG_NRF_MODEM_LIB_TRACE_COMPRESSION_BLOCK_SIZE);
+
+	out[0] = TRACE_COMPRESS_MAGIC_0;
+	out[1] = TRACE_COMPRESS_MAGIC_1;
+
+	/* Only keep the compressed block if it is smaller */
+	payload_len = len ? lz4_compress(in, len, payload, len - 1) : 0;
+	if (payload_len) {
+		out[2] = TRACE_COMPRESS_TYPE_LZ4;
+	} else {
+		out[2] = TRACE_COMPRESS_TYPE_RAW;
+		memcpy(payload, in, len);
+		payload_len = len;
+	}
+
+	sys_put_le16(len, &out[3]);
+	sys_put_le16(payload_len, &out[5]);
+
+	crc = crc16_ccitt(0xffff, out, 7);
+	crc = crc16_ccitt(crc, payload, payload_len);
+	sys_put_le16(crc, &out[7]);
+
+	return TRACE_COMPRESS_HDR_SIZE + payload_len;
+}
@@ -0,0 +1,57 @@
+/*
+ * Copyright (c) 2024 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#ifndef TRACE_COMPRESS_H__
+#define TRACE_COMPRESS_H__
+
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Every block starts with a header:
+ *
+ * | magic (2) | type (1) | raw_len (2) | len (2) | crc (2) |
+ *
+ * All fields are little endian. The CRC is a CRC-16/CCITT with seed 0xffff, computed over
+ * the header fields before it and the payload. The payload is @c len bytes long and gives
+ * @c raw_len bytes of trace data once decompressed.
+ */
+#define TRACE_COMPRESS_MAGIC_0 0x4d
+#define TRACE_COMPRESS_MAGIC_1 0x5a
+#define TRACE_COMPRESS_HDR_SIZE 9
+
+/** The payload is uncompressed trace data. */
+#define TRACE_COMPRESS_TYPE_RAW 0
+/** The payload is a block in the LZ4 block format. */
+#define TRACE_COMPRESS_TYPE_LZ4 1
+
+/** Size of the output buffer needed to compress a block of the maximum size. */
+#define TRACE_COMPRESS_OUT_SIZE \
+	(TRACE_COMPRESS_HDR_SIZE + CONFIG_NRF_MODEM_LIB_TRACE_COMPRESSION_BLOCK_SIZE)
+
+/**
+ * @brief Compress a block of trace data.
+ *
+ * The block is compressed independently of the previous ones. If the compressed block
+ * would not be smaller than the trace data, the trace data is copied as is.
+ *
+ * @param in  Trace data.
+ * @param len Length of the trace data, at most
+ *            @kconfig{CONFIG_NRF_MODEM_LIB_TRACE_COMPRESSION_BLOCK_SIZE} bytes.
+ * @param out Output buffer of @ref TRACE_COMPRESS_OUT_SIZE bytes.
+ *
+ * @return Number of bytes written to the output buffer, header included.
+ */
+size_t trace_compress_block(const uint8_t *in, size_t len, uint8_t *out);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* TRACE_COMPRESS_H__ */
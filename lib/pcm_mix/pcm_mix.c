@@ -7,94 +7,194 @@
 #include "pcm_mix.h"
 
 #include <zephyr/kernel.h>
+#include <zephyr/sys/util.h>
+#include <zephyr/toolchain.h>
+
+#if defined(__ARM_FEATURE_DSP) && __ARM_FEATURE_DSP
+#include <arm_acle.h>
+#define PCM_MIX_SIMD 1
+#else
+#define PCM_MIX_SIMD 0
+#endif
 
 #include <zephyr/logging/log.h>
 LOG_MODULE_REGISTER(pcm_mix, CONFIG_PCM_MIX_LOG_LEVEL);
 
-/* Clip signal if amplitude is outside legal range */
-static void hard_limiter(int32_t *const pcm)
+#define INT24_MAX ((1 << 23) - 1)
+#define INT24_MIN (-(1 << 23))
+
+/* Destination layout for the samples of buffer B */
+enum pcm_mix_dst {
+	/* A has the same layout as B */
+	DST_IDENTICAL,
+	/* Each B sample is added to both channels of a stereo A */
+	DST_STEREO_LR,
+	/* Each B sample is added to one channel of a stereo A */
+	DST_STEREO_ONE,
+};
+
+/* Saturate to the signed range of the given bit depth (16, 24 or 32) */
+static inline int32_t saturate(int64_t pcm, uint8_t pcm_bit_depth)
 {
-	if (*pcm < INT16_MIN) {
-		LOG_DBG("Clip");
-		*pcm = INT16_MIN;
-	} else if (*pcm > INT16_MAX) {
-		LOG_DBG("Clip");
-		*pcm = INT16_MAX;
+	switch (pcm_bit_depth) {
+	case 16:
+		return CLAMP(pcm, INT16_MIN, INT16_MAX);
+	case 24:
+		return CLAMP(pcm, INT24_MIN, INT24_MAX);
+	default:
+		return CLAMP(pcm, INT32_MIN, INT32_MAX);
 	}
 }
 
-/* Mix stereo-stereo or mono-mono. I.e. buffers are of equal size */
-static void pcm_mix_identical(void *const pcm_a, size_t size_a, void const *const pcm_b,
-			      size_t size_b)
+static inline int32_t gain_apply(int32_t pcm, uint16_t gain)
 {
-	int32_t res;
+	if (gain == PCM_MIX_GAIN_UNITY) {
+		return pcm;
+	}
 
-	for (uint32_t i = 0; i < size_b / 2; i++) {
-		res = ((int16_t *)pcm_a)[i] + ((int16_t *)pcm_b)[i];
+	return (int32_t)(((int64_t)pcm * gain) >> PCM_MIX_GAIN_SHIFT);
+}
 
-		hard_limiter(&res);
+#if PCM_MIX_SIMD
+/* Scale both halfwords of a packed sample pair, saturated to 16 bits */
+static inline int16x2_t gain_apply_s16x2(int16x2_t pair, uint16_t gain)
+{
+	int32_t lo = __ssat(gain_apply((int16_t)(pair & 0xFFFF), gain), 16);
+	int32_t hi = __ssat(gain_apply((int16_t)(pair >> 16), gain), 16);
 
-		((int16_t *)pcm_a)[i] = (int16_t)res;
-	}
+	return (int16x2_t)((lo & 0xFFFF) | ((uint32_t)hi << 16));
 }
 
-/* Mix mono into both channels of a stereo buffer */
-static void pcm_mix_b_mono_into_a_stereo_lr(void *const pcm_a, size_t size_a,
-					    void const *const pcm_b, size_t size_b)
+/* Mix 16-bit samples two at a time with a saturating halfword add.
+ * Returns the number of B samples that were processed.
+ */
+static size_t mix_s16_simd(int16_t *pcm_a, int16_t const *pcm_b, size_t samples_b,
+			   enum pcm_mix_dst dst, uint8_t channel, uint16_t gain)
 {
-	int32_t res;
+	int16x2_t a;
+	int16x2_t b;
+	size_t i = 0;
 
-	/* Use size_b as this is the length of the mono sample.
-	 * This must be *2 to traverse the stereo sample and /2 since
-	 * the sample is two bytes in size.
-	 */
-	for (uint32_t i = 0; i < size_b; i++) {
-		res = ((int16_t *)pcm_a)[i] + ((int16_t *)pcm_b)[i / 2];
+	switch (dst) {
+	case DST_IDENTICAL:
+		for (; i + 1 < samples_b; i += 2) {
+			a = UNALIGNED_GET((uint32_t *)&pcm_a[i]);
+			b = UNALIGNED_GET((uint32_t const *)&pcm_b[i]);
 
-		hard_limiter(&res);
+			if (gain != PCM_MIX_GAIN_UNITY) {
+				b = gain_apply_s16x2(b, gain);
+			}
 
-		((int16_t *)pcm_a)[i] = (int16_t)res;
+			UNALIGNED_PUT(__qadd16(a, b), (uint32_t *)&pcm_a[i]);
+		}
+		break;
+	case DST_STEREO_LR:
+	case DST_STEREO_ONE:
+		for (; i < samples_b; i++) {
+			uint16_t sample = (uint16_t)saturate(gain_apply(pcm_b[i], gain), 16);
+
+			if (dst == DST_STEREO_LR) {
+				b = (int16x2_t)(sample | ((uint32_t)sample << 16));
+			} else {
+				b = (int16x2_t)((uint32_t)sample << (16 * channel));
+			}
+
+			a = UNALIGNED_GET((uint32_t *)&pcm_a[i * 2]);
+			UNALIGNED_PUT(__qadd16(a, b), (uint32_t *)&pcm_a[i * 2]);
+		}
+		break;
 	}
+
+	return i;
 }
+#endif /* PCM_MIX_SIMD */
 
-/* Mix mono into left channel of a stereo buffer */
-static void pcm_mix_b_mono_into_a_stereo_l(void *const pcm_a, size_t size_a,
-					   void const *const pcm_b, size_t size_b)
+static void mix_s16(int16_t *pcm_a, int16_t const *pcm_b, size_t samples_b, enum pcm_mix_dst dst,
+		    uint8_t channel, uint16_t gain)
 {
-	int32_t res;
-
-	for (uint32_t i = 0; i < size_b / 2; i++) {
-		res = ((int16_t *)pcm_a)[i * 2] + ((int16_t *)pcm_b)[i];
-
-		hard_limiter(&res);
+	size_t i = 0;
+	int32_t b;
+
+#if PCM_MIX_SIMD
+	i = mix_s16_simd(pcm_a, pcm_b, samples_b, dst, channel, gain);
+#endif
+
+	for (; i < samples_b; i++) {
+		b = gain_apply(pcm_b[i], gain);
+
+		switch (dst) {
+		case DST_IDENTICAL:
+			pcm_a[i] = saturate((int64_t)pcm_a[i] + b, 16);
+			break;
+		case DST_STEREO_LR:
+			pcm_a[i * 2] = saturate((int64_t)pcm_a[i * 2] + b, 16);
+			pcm_a[i * 2 + 1] = saturate((int64_t)pcm_a[i * 2 + 1] + b, 16);
+			break;
+		case DST_STEREO_ONE:
+			pcm_a[i * 2 + channel] = saturate((int64_t)pcm_a[i * 2 + channel] + b, 16);
+			break;
+		}
+	}
+}
 
-		((int16_t *)pcm_a)[i * 2] = (int16_t)res;
+static inline int32_t add_s32(int32_t a, int32_t b, uint8_t pcm_bit_depth)
+{
+#if PCM_MIX_SIMD
+	if (pcm_bit_depth == 32) {
+		return __qadd(a, b);
 	}
+
+	/* Two legal 24-bit values cannot overflow the 32-bit carrier */
+	return __ssat(a + b, 24);
+#else
+	return saturate((int64_t)a + b, pcm_bit_depth);
+#endif
 }
 
-/* Mix mono into right channel of a stereo buffer */
-static void pcm_mix_b_mono_into_a_stereo_r(void *const pcm_a, size_t size_a,
-					   void const *const pcm_b, size_t size_b)
+static void mix_s32(int32_t *pcm_a, int32_t const *pcm_b, size_t samples_b, enum pcm_mix_dst dst,
+		    uint8_t channel, uint8_t pcm_bit_depth, uint16_t gain)
 {
-	int32_t res;
+	int32_t b;
 
-	for (uint32_t i = 0; i < size_b / 2; i++) {
-		res = ((int16_t *)pcm_a)[i * 2 + 1] + ((int16_t *)pcm_b)[i];
+	for (size_t i = 0; i < samples_b; i++) {
+		b = pcm_b[i];
 
-		hard_limiter(&res);
+		if (gain != PCM_MIX_GAIN_UNITY) {
+			b = saturate(((int64_t)b * gain) >> PCM_MIX_GAIN_SHIFT, pcm_bit_depth);
+		}
 
-		((int16_t *)pcm_a)[i * 2 + 1] = (int16_t)res;
+		switch (dst) {
+		case DST_IDENTICAL:
+			pcm_a[i] = add_s32(pcm_a[i], b, pcm_bit_depth);
+			break;
+		case DST_STEREO_LR:
+			pcm_a[i * 2] = add_s32(pcm_a[i * 2], b, pcm_bit_depth);
+			pcm_a[i * 2 + 1] = add_s32(pcm_a[i * 2 + 1], b, pcm_bit_depth);
+			break;
+		case DST_STEREO_ONE:
+			pcm_a[i * 2 + channel] = add_s32(pcm_a[i * 2 + channel], b, pcm_bit_depth);
+			break;
+		}
 	}
 }
 
-int pcm_mix(void *const pcm_a, size_t size_a, void const *const pcm_b, size_t size_b,
-	    enum pcm_mix_mode mix_mode)
+int pcm_mix_ext(void *const pcm_a, size_t size_a, void const *const pcm_b, size_t size_b,
+		uint8_t pcm_bit_depth, uint16_t gain_b, enum pcm_mix_mode mix_mode)
 {
+	enum pcm_mix_dst dst;
+	uint8_t channel = 0;
+	size_t samples_b;
+
 	if (pcm_a == NULL || size_a == 0) {
 		return -EINVAL;
 	}
 
-	if (pcm_b == NULL || size_b == 0) {
+	if (pcm_bit_depth != 16 && pcm_bit_depth != 24 && pcm_bit_depth != 32) {
+		LOG_ERR("Invalid bit depth: %d", pcm_bit_depth);
+		return -EINVAL;
+	}
+
+	if (pcm_b == NULL || size_b == 0 || gain_b == 0) {
 		/* Nothing to mix, returning */
 		return 0;
 	}
@@ -106,30 +206,46 @@ int pcm_mix(void *const pcm_a, size_t size_a, void const *const pcm_b, size_t si
 		if (size_b > size_a) {
 			return -EPERM;
 		}
-		pcm_mix_identical(pcm_a, size_a, pcm_b, size_b);
+		dst = DST_IDENTICAL;
 		break;
 	case B_MONO_INTO_A_STEREO_LR:
 		if (size_b > (size_a / 2)) {
 			return -EPERM;
 		}
-		pcm_mix_b_mono_into_a_stereo_lr(pcm_a, size_a, pcm_b, size_b);
+		dst = DST_STEREO_LR;
 		break;
 	case B_MONO_INTO_A_STEREO_L:
-		pcm_mix_b_mono_into_a_stereo_l(pcm_a, size_a, pcm_b, size_b);
 		if (size_b > (size_a / 2)) {
-			LOG_ERR("size a %d size b %d", size_a, size_b);
+			LOG_ERR("size a %zu size b %zu", size_a, size_b);
 			return -EPERM;
 		}
+		dst = DST_STEREO_ONE;
+		channel = 0;
 		break;
 	case B_MONO_INTO_A_STEREO_R:
-		pcm_mix_b_mono_into_a_stereo_r(pcm_a, size_a, pcm_b, size_b);
 		if (size_b > (size_a / 2)) {
 			return -EPERM;
 		}
+		dst = DST_STEREO_ONE;
+		channel = 1;
 		break;
 	default:
 		return -ESRCH;
 	};
 
+	if (pcm_bit_depth == 16) {
+		samples_b = size_b / sizeof(int16_t);
+		mix_s16(pcm_a, pcm_b, samples_b, dst, channel, gain_b);
+	} else {
+		samples_b = size_b / sizeof(int32_t);
+		mix_s32(pcm_a, pcm_b, samples_b, dst, channel, pcm_bit_depth, gain_b);
+	}
+
 	return 0;
 }
+
+int pcm_mix(void *const pcm_a, size_t size_a, void const *const pcm_b, size_t size_b,
+	    enum pcm_mix_mode mix_mode)
+{
+	return pcm_mix_ext(pcm_a, size_a, pcm_b, size_b, 16, PCM_MIX_GAIN_UNITY, mix_mode);
+}
@@ -6,6 +6,7 @@
 
 #include "sample_rate_converter.h"
 #include "sample_rate_converter_filter.h"
+#include "sample_rate_converter_polyphase.h"
 
 #include <errno.h>
 #include <stdbool.h>
@@ -102,6 +103,29 @@ static int sample_rate_converter_reconfigure(struct sample_rate_converter_ctx *c
 
 	__ASSERT(ctx != NULL, "Context cannot be NULL");
 
+	if (filter == SAMPLE_RATE_FILTER_POLYPHASE) {
+		if (!IS_ENABLED(CONFIG_SAMPLE_RATE_CONVERTER_POLYPHASE)) {
+			LOG_ERR("Polyphase filter not enabled");
+			return -EINVAL;
+		}
+
+#ifdef CONFIG_SAMPLE_RATE_CONVERTER_POLYPHASE
+		ret = sample_rate_converter_polyphase_init(&ctx->polyphase, sample_rate_input,
+							   sample_rate_output);
+		if (ret) {
+			LOG_ERR("Failed to initialize polyphase filter (%d)", ret);
+			return ret;
+		}
+#endif /* CONFIG_SAMPLE_RATE_CONVERTER_POLYPHASE */
+
+		ctx->sample_rate_input = sample_rate_input;
+		ctx->sample_rate_output = sample_rate_output;
+		ctx->conversion_ratio = 0;
+		ctx->filter_type = filter;
+
+		return 0;
+	}
+
 	ret = validate_sample_rates(sample_rate_input, sample_rate_output);
 	if (ret) {
 		LOG_ERR("Invalid sample rate given (%d)", ret);
@@ -199,54 +223,39 @@ int sample_rate_converter_open(struct sample_rate_converter_ctx *ctx)
 	return 0;
 }
 
-int sample_rate_converter_process(struct sample_rate_converter_ctx *ctx,
-				  enum sample_rate_converter_filter filter, void const *const input,
-				  size_t input_size, uint32_t sample_rate_input, void *const output,
-				  size_t output_size, size_t *output_written,
-				  uint32_t sample_rate_output)
+/**
+ * @brief Process a block with one of the integer ratio CMSIS DSP filters.
+ *
+ * @details Kept out of line so that the internal buffers only occupy stack for the integer ratio
+ *	    conversions.
+ *
+ * @param[in,out]	ctx			Pointer to the sample rate conversion context.
+ * @param[in]		input			Pointer to samples to process.
+ * @param[in]		input_size		Size of the input in bytes.
+ * @param[out]		output			Array that output will be written.
+ * @param[in]		output_size		Size of the output array in bytes.
+ * @param[out]		output_written		Number of bytes written to output.
+ * @param[in]		bytes_per_sample	Number of bytes per sample.
+ *
+ * @retval	0	On success.
+ * @retval	-EINVAL	Invalid parameters for sample rate conversion.
+ * @retval	-EFAULT	Output ring buffer has either not enough bytes to output, or not enough
+ *			space to store bytes.
+ */
+static __noinline int integer_ratio_process(struct sample_rate_converter_ctx *ctx,
+					    void const *const input, size_t input_size,
+					    void *const output, size_t output_size,
+					    size_t *output_written, size_t bytes_per_sample)
 {
 	int ret;
 	const uint8_t *read_ptr;
 	uint8_t *write_ptr;
 	size_t samples_to_process;
+	size_t samples_in = input_size / bytes_per_sample;
 
 	uint8_t internal_input_buf[SAMPLE_RATE_CONVERTER_INTERNAL_INPUT_BUF_SIZE];
 	uint8_t internal_output_buf[SAMPLE_RATE_CONVERTER_INTERNAL_OUTPUT_BUF_SIZE];
 
-#if CONFIG_SAMPLE_RATE_CONVERTER_BIT_DEPTH_16
-	size_t bytes_per_sample = sizeof(uint16_t);
-#elif CONFIG_SAMPLE_RATE_CONVERTER_BIT_DEPTH_32
-	size_t bytes_per_sample = sizeof(uint32_t);
-#endif
-
-	if (input_size % bytes_per_sample != 0) {
-		LOG_ERR("Size of input is not a byte multiple");
-		return -EINVAL;
-	}
-
-	size_t samples_in = input_size / bytes_per_sample;
-
-	if (samples_in > CONFIG_SAMPLE_RATE_CONVERTER_BLOCK_SIZE_MAX) {
-		LOG_ERR("Too many samples given as input");
-		return -EINVAL;
-	}
-
-	if ((ctx == NULL) || (input == NULL) || (output == NULL) || (output_written == NULL)) {
-		LOG_ERR("Null pointer received");
-		return -EINVAL;
-	}
-
-	if ((ctx->sample_rate_input != sample_rate_input) ||
-	    (ctx->sample_rate_output != sample_rate_output) || (ctx->filter_type != filter)) {
-		LOG_DBG("State has changed, re-initializing filter");
-		ret = sample_rate_converter_reconfigure(ctx, sample_rate_input, sample_rate_output,
-							filter);
-		if (ret) {
-			LOG_ERR("Failed to initialize converter (%d)", ret);
-			return ret;
-		}
-	}
-
 	if ((ctx->conversion_ratio < 0) && (samples_in < abs(ctx->conversion_ratio))) {
 		LOG_ERR("Number of samples in can not be less than the conversion ratio (%d) when "
 			"downsampling",
@@ -393,3 +402,69 @@ int sample_rate_converter_process(struct sample_rate_converter_ctx *ctx,
 
 	return 0;
 }
+
+int sample_rate_converter_process(struct sample_rate_converter_ctx *ctx,
+				  enum sample_rate_converter_filter filter, void const *const input,
+				  size_t input_size, uint32_t sample_rate_input, void *const output,
+				  size_t output_size, size_t *output_written,
+				  uint32_t sample_rate_output)
+{
+	int ret;
+
+#if CONFIG_SAMPLE_RATE_CONVERTER_BIT_DEPTH_16
+	size_t bytes_per_sample = sizeof(uint16_t);
+#elif CONFIG_SAMPLE_RATE_CONVERTER_BIT_DEPTH_32
+	size_t bytes_per_sample = sizeof(uint32_t);
+#endif
+
+	if (input_size % bytes_per_sample != 0) {
+		LOG_ERR("Size of input is not a byte multiple");
+		return -EINVAL;
+	}
+
+	size_t samples_in = input_size / bytes_per_sample;
+
+	if (samples_in > CONFIG_SAMPLE_RATE_CONVERTER_BLOCK_SIZE_MAX) {
+		LOG_ERR("Too many samples given as input");
+		return -EINVAL;
+	}
+
+	if ((ctx == NULL) || (input == NULL) || (output == NULL) || (output_written == NULL)) {
+		LOG_ERR("Null pointer received");
+		return -EINVAL;
+	}
+
+	if ((ctx->sample_rate_input != sample_rate_input) ||
+	    (ctx->sample_rate_output != sample_rate_output) || (ctx->filter_type != filter)) {
+		LOG_DBG("State has changed, re-initializing filter");
+		ret = sample_rate_converter_reconfigure(ctx, sample_rate_input, sample_rate_output,
+							filter);
+		if (ret) {
+			LOG_ERR("Failed to initialize converter (%d)", ret);
+			return ret;
+		}
+	}
+
+#ifdef CONFIG_SAMPLE_RATE_CONVERTER_POLYPHASE
+	if (ctx->filter_type == SAMPLE_RATE_FILTER_POLYPHASE) {
+		size_t samples_out =
+			sample_rate_converter_polyphase_samples_out_get(&ctx->polyphase, samples_in);
+
+		if (samples_out * bytes_per_sample > output_size) {
+			LOG_ERR("Conversion process will produce more bytes than the output buffer "
+				"can hold");
+			return -EINVAL;
+		}
+
+		/* Filter history is kept in the context, output is written directly */
+		samples_out = sample_rate_converter_polyphase_process(&ctx->polyphase, input,
+								      samples_in, output);
+		*output_written = samples_out * bytes_per_sample;
+
+		return 0;
+	}
+#endif /* CONFIG_SAMPLE_RATE_CONVERTER_POLYPHASE */
+
+	return integer_ratio_process(ctx, input, input_size, output, output_size, output_written,
+				     bytes_per_sample);
+}
@@ -0,0 +1,191 @@
+/*
+ * Copyright (c) 2024 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#include "sample_rate_converter.h"
+#include "sample_rate_converter_polyphase.h"
+
+#include <errno.h>
+#include <math.h>
+#include <string.h>
+#include <zephyr/sys/util.h>
+#include <dsp/basic_math_functions.h>
+
+#include <zephyr/logging/log.h>
+LOG_MODULE_REGISTER(sample_rate_converter_polyphase, CONFIG_SAMPLE_RATE_CONVERTER_LOG_LEVEL);
+
+#define TAPS CONFIG_SAMPLE_RATE_CONVERTER_POLYPHASE_TAPS
+
+/* Cut-off of the prototype low-pass filter relative to the lower of the two Nyquist
+ * frequencies. Leaves a transition band so that the short sub-filters still attenuate images.
+ */
+#define PROTOTYPE_CUTOFF 0.9f
+
+#ifdef CONFIG_SAMPLE_RATE_CONVERTER_BIT_DEPTH_16
+typedef q15_t sample_t;
+#define COEFFS(pp)     ((pp)->coeffs_15)
+#define DELAY_LINE(pp) ((pp)->delay_line_15)
+#define SAMPLE_MAX     INT16_MAX
+#define SAMPLE_MIN     INT16_MIN
+/* arm_dot_prod_q15 returns a 34.30 result */
+#define DOT_PROD_SHIFT 15
+#define DOT_PROD(a, b, len, res) arm_dot_prod_q15(a, b, len, res)
+#elif CONFIG_SAMPLE_RATE_CONVERTER_BIT_DEPTH_32
+typedef q31_t sample_t;
+#define COEFFS(pp)     ((pp)->coeffs_31)
+#define DELAY_LINE(pp) ((pp)->delay_line_31)
+#define SAMPLE_MAX     INT32_MAX
+#define SAMPLE_MIN     INT32_MIN
+/* arm_dot_prod_q31 returns a 16.48 result */
+#define DOT_PROD_SHIFT 17
+#define DOT_PROD(a, b, len, res) arm_dot_prod_q31(a, b, len, res)
+#endif
+
+static uint32_t gcd(uint32_t a, uint32_t b)
+{
+	while (b != 0) {
+		uint32_t tmp = a % b;
+
+		a = b;
+		b = tmp;
+	}
+
+	return a;
+}
+
+static sample_t coeff_quantize(float coeff)
+{
+	double scaled = round((double)coeff * ((double)SAMPLE_MAX + 1.0));
+
+	return (sample_t)CLAMP(scaled, (double)SAMPLE_MIN, (double)SAMPLE_MAX);
+}
+
+/**
+ * @brief Compute the phase table from a Blackman-windowed sinc prototype filter.
+ *
+ * @details The prototype runs at L times the input rate and has L * TAPS coefficients. Its
+ *	    coefficient n belongs to sub-filter n % L and multiplies the input sample n / L
+ *	    steps back in time. Each sub-filter is stored in reverse order so it can be applied
+ *	    as a dot product over the delay line, oldest sample first.
+ */
+static void phase_table_compute(struct sample_rate_converter_polyphase *pp)
+{
+	uint32_t interpolation = pp->interpolation;
+	uint32_t len = interpolation * TAPS;
+	float cutoff = PROTOTYPE_CUTOFF / (2.0f * MAX(pp->interpolation, pp->decimation));
+	float center = (len - 1) / 2.0f;
+	sample_t *coeffs = COEFFS(pp);
+
+	for (uint32_t n = 0; n < len; n++) {
+		float x = (float)n - center;
+		float window = 0.42f - 0.5f * cosf(2.0f * PI * n / (len - 1)) +
+			       0.08f * cosf(4.0f * PI * n / (len - 1));
+		float sinc;
+
+		if (x == 0.0f) {
+			sinc = 2.0f * cutoff;
+		} else {
+			sinc = sinf(2.0f * PI * cutoff * x) / (PI * x);
+		}
+
+		/* Scale by L to make up for the zeros inserted between input samples */
+		coeffs[(n % interpolation) * TAPS + (TAPS - 1 - n / interpolation)] =
+			coeff_quantize(sinc * window * interpolation);
+	}
+}
+
+int sample_rate_converter_polyphase_init(struct sample_rate_converter_polyphase *pp,
+					 uint32_t sample_rate_input, uint32_t sample_rate_output)
+{
+	uint32_t divisor;
+
+	__ASSERT(pp != NULL, "Polyphase state cannot be NULL");
+
+	if ((sample_rate_input == 0) || (sample_rate_output == 0)) {
+		LOG_ERR("Sample rates cannot be zero");
+		return -EINVAL;
+	}
+
+	if (sample_rate_input == sample_rate_output) {
+		LOG_ERR("Input and out sample rates are the same");
+		return -EINVAL;
+	}
+
+	divisor = gcd(sample_rate_input, sample_rate_output);
+
+	if ((sample_rate_output / divisor) > CONFIG_SAMPLE_RATE_CONVERTER_POLYPHASE_PHASES_MAX ||
+	    (sample_rate_input / divisor) > UINT16_MAX) {
+		LOG_ERR("Conversion ratio %u/%u not supported", sample_rate_output / divisor,
+			sample_rate_input / divisor);
+		return -EINVAL;
+	}
+
+	pp->interpolation = sample_rate_output / divisor;
+	pp->decimation = sample_rate_input / divisor;
+	pp->phase = 0;
+	pp->input_skip = 0;
+
+	phase_table_compute(pp);
+	memset(DELAY_LINE(pp), 0, sizeof(sample_t) * (TAPS - 1));
+
+	LOG_DBG("Polyphase conversion configured, L/M: %d/%d", pp->interpolation,
+		pp->decimation);
+
+	return 0;
+}
+
+size_t sample_rate_converter_polyphase_samples_out_get(
+	struct sample_rate_converter_polyphase const *pp, size_t samples_in)
+{
+	uint32_t span;
+
+	if (samples_in <= pp->input_skip) {
+		return 0;
+	}
+
+	/* Output samples are produced at phase + k * M for all k where the position, in units
+	 * of 1/L input samples, is still inside the block.
+	 */
+	span = (samples_in - pp->input_skip) * pp->interpolation - pp->phase;
+
+	return DIV_ROUND_UP(span, pp->decimation);
+}
+
+size_t sample_rate_converter_polyphase_process(struct sample_rate_converter_polyphase *pp,
+					       void const *input, size_t samples_in,
+					       void *output)
+{
+	sample_t *delay_line = DELAY_LINE(pp);
+	sample_t const *coeffs = COEFFS(pp);
+	sample_t *out = output;
+	uint32_t in_idx = pp->input_skip;
+	uint32_t phase = pp->phase;
+	size_t samples_out = 0;
+	q63_t acc;
+
+	__ASSERT(samples_in <= CONFIG_SAMPLE_RATE_CONVERTER_BLOCK_SIZE_MAX,
+		 "Too many input samples");
+
+	/* The history is already in the first TAPS - 1 positions */
+	memcpy(&delay_line[TAPS - 1], input, samples_in * sizeof(sample_t));
+
+	while (in_idx < samples_in) {
+		/* Window ending with input sample in_idx */
+		DOT_PROD(&delay_line[in_idx], &coeffs[phase * TAPS], TAPS, &acc);
+		out[samples_out++] = (sample_t)CLAMP(acc >> DOT_PROD_SHIFT, SAMPLE_MIN, SAMPLE_MAX);
+
+		phase += pp->decimation;
+		in_idx += phase / pp->interpolation;
+		phase %= pp->interpolation;
+	}
+
+	pp->phase = phase;
+	pp->input_skip = in_idx - samples_in;
+
+	/* Keep the newest TAPS - 1 samples as history for the next block */
+	memmove(delay_line, &delay_line[samples_in], sizeof(sample_t) * (TAPS - 1));
+
+	return samples_out;
+}
@@ -0,0 +1,57 @@
+/*
+ * Copyright (c) 2024 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#ifndef _SAMPLE_RATE_CONVERTER_POLYPHASE_H_
+#define _SAMPLE_RATE_CONVERTER_POLYPHASE_H_
+
+#include "sample_rate_converter.h"
+
+/**
+ * @brief Configure the polyphase state for a new conversion.
+ *
+ * @details Reduces the conversion ratio, computes the phase table and clears the filter history.
+ *
+ * @param[out]	pp			Pointer to the polyphase state.
+ * @param[in]	sample_rate_input	Sample rate of the input samples.
+ * @param[in]	sample_rate_output	Sample rate of the output samples.
+ *
+ * @retval	0	On success.
+ * @retval	-EINVAL	Sample rates are equal, zero, or the reduced interpolation factor is
+ *			larger than CONFIG_SAMPLE_RATE_CONVERTER_POLYPHASE_PHASES_MAX.
+ */
+int sample_rate_converter_polyphase_init(struct sample_rate_converter_polyphase *pp,
+					 uint32_t sample_rate_input, uint32_t sample_rate_output);
+
+/**
+ * @brief Get the number of output samples the next process call will produce.
+ *
+ * @param[in]	pp		Pointer to the polyphase state.
+ * @param[in]	samples_in	Number of input samples for the next call.
+ *
+ * @return	Number of output samples.
+ */
+size_t sample_rate_converter_polyphase_samples_out_get(
+	struct sample_rate_converter_polyphase const *pp, size_t samples_in);
+
+/**
+ * @brief Convert a block of samples.
+ *
+ * @details The output buffer must be able to hold the number of samples given by
+ *	    sample_rate_converter_polyphase_samples_out_get().
+ *
+ * @param[in,out]	pp		Pointer to the polyphase state.
+ * @param[in]		input		Input samples.
+ * @param[in]		samples_in	Number of input samples, at most
+ *					CONFIG_SAMPLE_RATE_CONVERTER_BLOCK_SIZE_MAX.
+ * @param[out]		output		Output samples.
+ *
+ * @return	Number of output samples written.
+ */
+size_t sample_rate_converter_polyphase_process(struct sample_rate_converter_polyphase *pp,
+					       void const *input, size_t samples_in,
+					       void *output);
+
+#endif /* _SAMPLE_RATE_CONVERTER_POLYPHASE_H_ */
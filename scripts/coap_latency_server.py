@@ -0,0 +1,231 @@
+#!/usr/bin/env python3
+
+# Copyright (c) 2024 Nordic Semiconductor ASA
+#
+# SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+
+"""
+CoAP file server with an injected latency, to measure block-wise download throughput.
+
+Every Block2 response is sent the given latency after its request was received, which
+simulates the round-trip time of a cellular link. A random jitter can be added to
+reorder the responses of parallel requests, and a share of the requests can be dropped
+to exercise retransmissions. Only confirmable GET requests are handled, and they are
+answered with piggybacked acknowledgments.
+"""
+
+import argparse
+import asyncio
+import logging
+import os
+import random
+import struct
+import time
+
+logging.basicConfig(level=logging.INFO, format="%(asctime)s %(message)s")
+logger = logging.getLogger(__name__)
+
+COAP_TYPE_CON = 0
+COAP_TYPE_ACK = 2
+COAP_GET = 0x01
+COAP_CONTENT = 0x45
+COAP_BAD_OPTION = 0x82
+COAP_NOT_FOUND = 0x84
+COAP_METHOD_NOT_ALLOWED = 0x85
+
+OPTION_URI_PATH = 11
+OPTION_BLOCK2 = 23
+OPTION_SIZE2 = 28
+
+MAX_SZX = 6
+
+
+def file_data_generate(size):
+    """Deterministic content, so the downloaded file can be verified."""
+    return bytes((i * 31 + (i >> 8)) & 0xFF for i in range(size))
+
+
+def uint_decode(value):
+    return int.from_bytes(value, "big") if value else 0
+
+
+def uint_encode(value):
+    return value.to_bytes((value.bit_length() + 7) // 8, "big")
+
+
+def option_ext(value):
+    if value < 13:
+        return value, b""
+    if value < 269:
+        return 13, bytes([value - 13])
+    return 14, struct.pack(">H", value - 269)
+
+
+def option_ext_read(nibble, data, pos):
+    if nibble == 13:
+        return data[pos] + 13, pos + 1
+    if nibble == 14:
+        return struct.unpack(">H", data[pos:pos + 2])[0] + 269, pos + 2
+    if nibble == 15:
+        raise ValueError("Invalid option")
+    return nibble, pos
+
+
+def message_parse(data):
+    """Return the type, code, message ID, token and options of a message."""
+    if len(data) < 4 or data[0] >> 6 != 1:
+        raise ValueError("Not a CoAP message")
+
+    mtype = (data[0] >> 4) & 0x3
+    tkl = data[0] & 0xF
+    code = data[1]
+    mid = struct.unpack(">H", data[2:4])[0]
+    token = data[4:4 + tkl]
+    pos = 4 + tkl
+    number = 0
+    options = []
+
+    while pos < len(data) and data[pos] != 0xFF:
+        header = data[pos]
+        delta, pos = option_ext_read(header >> 4, data, pos + 1)
+        length, pos = option_ext_read(header & 0xF, data, pos)
+        number += delta
+        options.append((number, data[pos:pos + length]))
+        pos += length
+
+    return mtype, code, mid, token, options
+
+
+def message_build(mtype, code, mid, token, options, payload=b""):
+    data = bytearray([0x40 | (mtype << 4) | len(token), code]) + struct.pack(">H", mid) + token
+    number = 0
+
+    for opt, value in sorted(options, key=lambda o: o[0]):
+        delta, delta_ext = option_ext(opt - number)
+        length, length_ext = option_ext(len(value))
+        data += bytes([(delta << 4) | length]) + delta_ext + length_ext + value
+        number = opt
+
+    if payload:
+        data += b"\xff" + payload
+
+    return bytes(data)
+
+
+class Server(asyncio.DatagramProtocol):
+    def __init__(self, args, data):
+        self.args = args
+        self.data = data
+        self.transport = None
+        self.requests = 0
+        self.dropped = 0
+        self.sent_bytes = 0
+        self.start = None
+
+    def connection_made(self, transport):
+        self.transport = transport
+
+    def response_build(self, code, mid, token, options):
+        if code != COAP_GET:
+            return message_build(COAP_TYPE_ACK, COAP_METHOD_NOT_ALLOWED, mid, token, [])
+
+        path = "/".join(v.decode() for n, v in options if n == OPTION_URI_PATH)
+        if path != self.args.path:
+            return message_build(COAP_TYPE_ACK, COAP_NOT_FOUND, mid, token, [])
+
+        num, szx = 0, MAX_SZX
+        for n, v in options:
+            if n == OPTION_BLOCK2:
+                block2 = uint_decode(v)
+                num, szx = block2 >> 4, min(block2 & 0x7, MAX_SZX)
+
+        size = 16 << szx
+        first = num * size
+        if first > len(self.data) or (first == len(self.data) and first):
+            return message_build(COAP_TYPE_ACK, COAP_BAD_OPTION, mid, token, [])
+
+        payload = self.data[first:first + size]
+        more = first + size < len(self.data)
+        resp_options = [(OPTION_BLOCK2, uint_encode((num << 4) | (more << 3) | szx)),
+                        (OPTION_SIZE2, uint_encode(len(self.data)))]
+
+        return message_build(COAP_TYPE_ACK, COAP_CONTENT, mid, token, resp_options, payload)
+
+    def datagram_received(self, data, addr):
+        try:
+            mtype, code, mid, token, options = message_parse(data)
+        except (ValueError, IndexError, UnicodeDecodeError) as e:
+            logger.warning("Invalid message from %s: %s", addr, e)
+            return
+
+        if mtype != COAP_TYPE_CON:
+            return
+
+        if self.start is None:
+            self.start = time.monotonic()
+            self.requests = self.dropped = self.sent_bytes = 0
+
+        self.requests += 1
+        if random.random() * 100 < self.args.loss:
+            self.dropped += 1
+            logger.debug("Dropped request %d", mid)
+            return
+
+        response = self.response_build(code, mid, token, options)
+        delay = (self.args.latency + random.uniform(0, self.args.jitter)) / 1000
+        asyncio.get_running_loop().call_later(delay, self.response_send, response, addr)
+
+    def response_send(self, response, addr):
+        self.transport.sendto(response, addr)
+        self.sent_bytes += len(response)
+
+        _, _, _, _, options = message_parse(response)
+        block2 = next((uint_decode(v) for n, v in options if n == OPTION_BLOCK2), None)
+        if block2 is not None and not block2 & 0x8:
+            elapsed = time.monotonic() - self.start
+            logger.info("Last block sent: %d requests, %d dropped, %d bytes in %.2f s "
+                        "(%.1f kB/s)", self.requests, self.dropped, self.sent_bytes,
+                        elapsed, self.sent_bytes / 1000 / elapsed if elapsed else 0)
+            self.start = None
+
+
+async def main():
+    parser = argparse.ArgumentParser(description=__doc__,
+                                     formatter_class=argparse.RawDescriptionHelpFormatter)
+    parser.add_argument("--host", default="0.0.0.0", help="Address to listen on")
+    parser.add_argument("--port", type=int, default=5683, help="Port to listen on")
+    parser.add_argument("--latency", type=int, default=400,
+                        help="Delay of every response, in milliseconds")
+    parser.add_argument("--jitter", type=int, default=0,
+                        help="Maximum random delay added to every response, in milliseconds")
+    parser.add_argument("--loss", type=float, default=0,
+                        help="Percentage of requests that are dropped")
+    parser.add_argument("--file", help="File to serve, generated if not given")
+    parser.add_argument("--size", type=int, default=64 * 1024,
+                        help="Size of the generated file, in bytes")
+    parser.add_argument("--path", default="file.bin", help="Path to serve the file at")
+    args = parser.parse_args()
+
+    if args.file:
+        with open(args.file, "rb") as f:
+            data = f.read()
+        args.path = args.path if args.path != "file.bin" else os.path.basename(args.file)
+    else:
+        data = file_data_generate(args.size)
+
+    loop = asyncio.get_running_loop()
+    transport, _ = await loop.create_datagram_endpoint(lambda: Server(args, data),
+                                                       local_addr=(args.host, args.port))
+    logger.info("Serving /%s (%d bytes) on %s:%d with %d ms latency",
+                args.path, len(data), args.host, args.port, args.latency)
+    try:
+        await asyncio.Event().wait()
+    finally:
+        transport.close()
+
+
+if __name__ == "__main__":
+    try:
+        asyncio.run(main())
+    except KeyboardInterrupt:
+        pass
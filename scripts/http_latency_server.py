@@ -0,0 +1,165 @@
+#!/usr/bin/env python3
+
+# Copyright (c) 2024 Nordic Semiconductor ASA
+#
+# SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+
+"""
+HTTP/1.1 file server with an injected latency, to measure download throughput.
+
+Every response is sent the given latency after its request was received, which
+simulates the round-trip time of a cellular link. Range requests, keep-alive and
+pipelining are supported: requests received back to back on one connection are
+answered in order, each one the latency after it was received.
+"""
+
+import argparse
+import asyncio
+import logging
+import os
+import re
+import time
+
+logging.basicConfig(level=logging.INFO, format="%(asctime)s %(message)s")
+logger = logging.getLogger(__name__)
+
+RANGE_RE = re.compile(rb"^bytes=(\d+)-(\d*)$")
+
+
+def file_data_generate(size):
+    """Deterministic content, so the downloaded file can be verified."""
+    return bytes((i * 31 + (i >> 8)) & 0xFF for i in range(size))
+
+
+class Connection:
+    def __init__(self, args, data, reader, writer):
+        self.args = args
+        self.data = data
+        self.reader = reader
+        self.writer = writer
+        self.responses = asyncio.Queue()
+        self.served = 0
+        self.start = time.monotonic()
+        self.sent_bytes = 0
+
+    def response_build(self, method, path, headers):
+        if method != b"GET":
+            return b"HTTP/1.1 405 Method Not Allowed\r\nContent-Length: 0\r\n\r\n", False
+
+        if path.lstrip(b"/") != self.args.path.encode():
+            return b"HTTP/1.1 404 Not Found\r\nContent-Length: 0\r\n\r\n", False
+
+        self.served += 1
+        close = self.args.close_after and self.served >= self.args.close_after
+        size = len(self.data)
+        status = b"200 OK"
+        first, last = 0, size - 1
+        extra = b""
+
+        match = RANGE_RE.match(headers.get(b"range", b""))
+        if match:
+            first = int(match.group(1))
+            last = min(int(match.group(2)), size - 1) if match.group(2) else size - 1
+            if first > last:
+                return (b"HTTP/1.1 416 Range Not Satisfiable\r\n"
+                        b"Content-Range: bytes */%d\r\nContent-Length: 0\r\n\r\n" % size,
+                        False)
+            status = b"206 Partial Content"
+            extra = b"Content-Range: bytes %d-%d/%d\r\n" % (first, last, size)
+
+        header = (b"HTTP/1.1 " + status + b"\r\n" +
+                  b"Content-Type: application/octet-stream\r\n" +
+                  b"Content-Length: %d\r\n" % (last - first + 1) + extra +
+                  (b"Connection: close\r\n" if close else b"Connection: keep-alive\r\n") +
+                  b"\r\n")
+
+        return header + self.data[first:last + 1], close
+
+    async def requests_read(self):
+        """Read requests as they arrive and schedule their responses."""
+        try:
+            while True:
+                head = await self.reader.readuntil(b"\r\n\r\n")
+                received = time.monotonic()
+                lines = head.split(b"\r\n")
+                method, path, _ = lines[0].split(b" ", 2)
+                headers = {}
+                for line in lines[1:]:
+                    if b":" in line:
+                        name, value = line.split(b":", 1)
+                        headers[name.strip().lower()] = value.strip()
+
+                logger.debug("%s %s %s", method, path, headers.get(b"range", b""))
+                response, close = self.response_build(method, path, headers)
+                await self.responses.put((received + self.args.latency / 1000, response, close))
+                if close:
+                    break
+        except (asyncio.IncompleteReadError, ConnectionError):
+            pass
+        finally:
+            await self.responses.put(None)
+
+    async def responses_send(self):
+        """Send the responses in order, each one when its latency has elapsed."""
+        while True:
+            item = await self.responses.get()
+            if item is None:
+                break
+
+            due, response, close = item
+            delay = due - time.monotonic()
+            if delay > 0:
+                await asyncio.sleep(delay)
+
+            self.writer.write(response)
+            await self.writer.drain()
+            self.sent_bytes += len(response)
+            if close:
+                break
+
+        elapsed = time.monotonic() - self.start
+        logger.info("Connection closed: %d requests, %d bytes in %.2f s (%.1f kB/s)",
+                    self.served, self.sent_bytes, elapsed,
+                    self.sent_bytes / 1000 / elapsed if elapsed else 0)
+        self.writer.close()
+
+
+async def main():
+    parser = argparse.ArgumentParser(description=__doc__,
+                                     formatter_class=argparse.RawDescriptionHelpFormatter)
+    parser.add_argument("--host", default="0.0.0.0", help="Address to listen on")
+    parser.add_argument("--port", type=int, default=8080, help="Port to listen on")
+    parser.add_argument("--latency", type=int, default=400,
+                        help="Delay of every response, in milliseconds")
+    parser.add_argument("--file", help="File to serve, generated if not given")
+    parser.add_argument("--size", type=int, default=256 * 1024,
+                        help="Size of the generated file, in bytes")
+    parser.add_argument("--path", default="file.bin", help="Path to serve the file at")
+    parser.add_argument("--close-after", type=int, default=0,
+                        help="Close the connection after this many responses, 0 to keep it open")
+    args = parser.parse_args()
+
+    if args.file:
+        with open(args.file, "rb") as f:
+            data = f.read()
+        args.path = args.path if args.path != "file.bin" else os.path.basename(args.file)
+    else:
+        data = file_data_generate(args.size)
+
+    async def connection_handle(reader, writer):
+        logger.info("Connection from %s", writer.get_extra_info("peername"))
+        conn = Connection(args, data, reader, writer)
+        await asyncio.gather(conn.requests_read(), conn.responses_send())
+
+    server = await asyncio.start_server(connection_handle, args.host, args.port)
+    logger.info("Serving /%s (%d bytes) on %s:%d with %d ms latency",
+                args.path, len(data), args.host, args.port, args.latency)
+    async with server:
+        await server.serve_forever()
+
+
+if __name__ == "__main__":
+    try:
+        asyncio.run(main())
+    except KeyboardInterrupt:
+        pass
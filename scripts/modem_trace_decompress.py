@@ -0,0 +1,171 @@
+#!/usr/bin/env python3
+
+# Copyright (c) 2024 Nordic Semiconductor ASA
+#
+# SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+
+"""
+Decompress modem traces captured with CONFIG_NRF_MODEM_LIB_TRACE_COMPRESSION.
+
+The output is the raw modem trace, which can be opened with the usual trace tools,
+like the Cellular Monitor app. Blocks that are incomplete or corrupted, for example
+because the trace backend dropped data, are skipped, and decompression resumes at
+the next valid block.
+"""
+
+import argparse
+import struct
+import sys
+
+MAGIC = b"\x4d\x5a"
+HDR_SIZE = 9
+TYPE_RAW = 0
+TYPE_LZ4 = 1
+
+MIN_MATCH = 4
+
+
+def crc16_ccitt(seed, data):
+    """CRC-16/CCITT, as computed by crc16_ccitt() in Zephyr."""
+    crc = seed
+    for byte in data:
+        e = (crc ^ byte) & 0xFF
+        f = (e ^ (e << 4)) & 0xFF
+        crc = ((crc >> 8) ^ (f << 8) ^ (f << 3) ^ (f >> 4)) & 0xFFFF
+    return crc
+
+
+def lz4_block_decompress(src, raw_len):
+    """Decompress a block in the LZ4 block format."""
+    dst = bytearray()
+    pos = 0
+
+    while pos < len(src):
+        token = src[pos]
+        pos += 1
+
+        literals = token >> 4
+        if literals == 15:
+            while True:
+                byte = src[pos]
+                pos += 1
+                literals += byte
+                if byte != 255:
+                    break
+
+        dst += src[pos:pos + literals]
+        pos += literals
+        if pos >= len(src):
+            break
+
+        offset = src[pos] | (src[pos + 1] << 8)
+        pos += 2
+        if offset == 0 or offset > len(dst):
+            raise ValueError("Invalid match offset")
+
+        match_len = token & 0xF
+        if match_len == 15:
+            while True:
+                byte = src[pos]
+                pos += 1
+                match_len += byte
+                if byte != 255:
+                    break
+        match_len += MIN_MATCH
+
+        # Matches can overlap the bytes they produce
+        start = len(dst) - offset
+        for i in range(match_len):
+            dst.append(dst[start + i])
+
+    if len(dst) != raw_len:
+        raise ValueError("Invalid block length")
+
+    return bytes(dst)
+
+
+def block_parse(data, pos):
+    """Return the decompressed block at the given position, and its size."""
+    if len(data) - pos < HDR_SIZE:
+        raise ValueError("Truncated header")
+
+    btype, raw_len, length, crc = struct.unpack_from("<BHHH", data, pos + 2)
+    payload = data[pos + HDR_SIZE:pos + HDR_SIZE + length]
+    if len(payload) != length:
+        raise ValueError("Truncated block")
+
+    if crc16_ccitt(crc16_ccitt(0xFFFF, data[pos:pos + 7]), payload) != crc:
+        raise ValueError("Invalid CRC")
+
+    if btype == TYPE_RAW:
+        if raw_len != length:
+            raise ValueError("Invalid block length")
+        return payload, HDR_SIZE + length
+    if btype == TYPE_LZ4:
+        return lz4_block_decompress(payload, raw_len), HDR_SIZE + length
+
+    raise ValueError("Unknown block type")
+
+
+def decompress(data):
+    """Decompress a trace, return the raw trace and statistics."""
+    out = bytearray()
+    pos = 0
+    blocks = 0
+    skipped = 0
+
+    while True:
+        start = data.find(MAGIC, pos)
+        if start < 0:
+            skipped += len(data) - pos
+            break
+
+        try:
+            raw, size = block_parse(data, start)
+        except (ValueError, IndexError):
+            # Not a valid block, look for the next one
+            skipped += start + 1 - pos
+            pos = start + 1
+            continue
+
+        skipped += start - pos
+        out += raw
+        blocks += 1
+        pos = start + size
+
+    return bytes(out), blocks, skipped
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__,
+                                     formatter_class=argparse.RawDescriptionHelpFormatter)
+    parser.add_argument("input", help="Compressed trace file, - for stdin")
+    parser.add_argument("output", help="Raw trace file, - for stdout")
+    args = parser.parse_args()
+
+    if args.input == "-":
+        data = sys.stdin.buffer.read()
+    else:
+        with open(args.input, "rb") as f:
+            data = f.read()
+
+    raw, blocks, skipped = decompress(data)
+
+    if args.output == "-":
+        sys.stdout.buffer.write(raw)
+    else:
+        with open(args.output, "wb") as f:
+            f.write(raw)
+
+    ratio = len(raw) / len(data) if data else 0
+    print(f"{blocks} blocks, {len(data)} bytes decompressed to {len(raw)} bytes "
+          f"(ratio {ratio:.2f})", file=sys.stderr)
+    if skipped:
+        print(f"Skipped {skipped} bytes of invalid data", file=sys.stderr)
+        return 1
+
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -5,23 +5,87 @@
  */
 
 #include <stdio.h>
+#include <string.h>
 #include <zephyr/kernel.h>
 #include <zephyr/spinlock.h>
 #include <zephyr/sys/slist.h>
 #include <app_event_manager.h>
+#include <debug/perf_counter.h>
 #include <zephyr/logging/log.h>
 #include <zephyr/sys/reboot.h>
 
 LOG_MODULE_REGISTER(app_event_manager, CONFIG_APP_EVENT_MANAGER_LOG_LEVEL);
 
+PERF_COUNTER_DEFINE(app_event_manager_submit, "events");
+PERF_HISTOGRAM_DEFINE(app_event_manager_process_time, "us");
+
 
 static void event_processor_fn(struct k_work *work);
 
 struct app_event_manager_event_display_bm _app_event_manager_event_display_bm;
 
-static K_WORK_DEFINE(event_processor, event_processor_fn);
-static sys_slist_t eventq = SYS_SLIST_STATIC_INIT(&eventq);
-static struct k_spinlock lock;
+#if IS_ENABLED(CONFIG_APP_EVENT_MANAGER_LOCKFREE_QUEUE)
+/* Intrusive multi-producer single-consumer queue.
+ *
+ * Producers only exchange the head pointer and then link the previous head to
+ * the new node. The event processor is the only consumer and owns the tail.
+ * The stub node keeps the queue non-empty so that producers never touch the tail.
+ */
+struct event_queue {
+	atomic_ptr_t head;
+	sys_snode_t *tail;
+	sys_snode_t stub;
+};
+
+#define EVENT_LANE_QUEUE_INIT(idx)						\
+	.queue = {								\
+		.head = ATOMIC_PTR_INIT(&lanes[idx].queue.stub),		\
+		.tail = &lanes[idx].queue.stub,					\
+	},
+#else
+#define EVENT_LANE_QUEUE_INIT(idx)						\
+	.queue = SYS_SLIST_STATIC_INIT(&lanes[idx].queue),
+#endif /* CONFIG_APP_EVENT_MANAGER_LOCKFREE_QUEUE */
+
+/* Every lane has its own event queue, processed by a work item submitted to
+ * the workqueue of the lane.
+ */
+struct event_lane {
+	struct k_work work;
+#if IS_ENABLED(CONFIG_APP_EVENT_MANAGER_LOCKFREE_QUEUE)
+	struct event_queue queue;
+#else
+	sys_slist_t queue;
+	struct k_spinlock lock;
+#endif
+};
+
+#define EVENT_LANE_INIT(idx, _)							\
+	{									\
+		.work = Z_WORK_INITIALIZER(event_processor_fn),			\
+		EVENT_LANE_QUEUE_INIT(idx)					\
+	}
+
+static struct event_lane lanes[CONFIG_APP_EVENT_MANAGER_LANES] = {
+	LISTIFY(CONFIG_APP_EVENT_MANAGER_LANES, EVENT_LANE_INIT, (,))
+};
+
+#if CONFIG_APP_EVENT_MANAGER_LANES > 1
+/* Lane 0 uses the system workqueue. */
+#define LANE_WORK_Q_CNT (CONFIG_APP_EVENT_MANAGER_LANES - 1)
+
+static K_THREAD_STACK_ARRAY_DEFINE(lane_stacks, LANE_WORK_Q_CNT,
+				   CONFIG_APP_EVENT_MANAGER_LANE_STACK_SIZE);
+static struct k_work_q lane_work_q[LANE_WORK_Q_CNT];
+#endif
+
+#if IS_ENABLED(CONFIG_APP_EVENT_MANAGER_LISTENER_STATS)
+static struct k_spinlock listener_stats_lock;
+#endif
+
+#if IS_ENABLED(CONFIG_APP_EVENT_MANAGER_EVENT_SLABS)
+struct app_event_manager_heap_stats _app_event_manager_heap_stats;
+#endif
 
 static bool log_is_event_displayed(const struct event_type *et)
 {
@@ -114,9 +178,86 @@ static void log_event_init(void)
 	}
 }
 
+#if IS_ENABLED(CONFIG_APP_EVENT_MANAGER_EVENT_SLABS)
+static bool slab_owns(const struct k_mem_slab *slab, const void *addr)
+{
+	const char *start = slab->buffer;
+	const char *end = start + slab->info.num_blocks * slab->info.block_size;
+
+	return ((const char *)addr >= start) && ((const char *)addr < end);
+}
+
+void *app_event_manager_slab_alloc(size_t size)
+{
+	struct k_mem_slab *best = NULL;
+	void *block;
+
+	STRUCT_SECTION_FOREACH(event_type, et) {
+		struct k_mem_slab *slab = et->slab;
+
+		if ((slab->info.block_size < size) || (k_mem_slab_num_free_get(slab) == 0)) {
+			continue;
+		}
+
+		if (!best || (slab->info.block_size < best->info.block_size)) {
+			best = slab;
+		}
+	}
+
+	/* The last block may be taken by another context in the meantime. */
+	if (best && !k_mem_slab_alloc(best, &block, K_NO_WAIT)) {
+		return block;
+	}
+
+	return NULL;
+}
+
+bool app_event_manager_slab_free(void *addr)
+{
+	const struct app_event_header *aeh = addr;
+
+	/* Events are usually allocated from the slab of their own type. */
+	if (slab_owns(aeh->type_id->slab, addr)) {
+		k_mem_slab_free(aeh->type_id->slab, addr);
+		return true;
+	}
+
+	STRUCT_SECTION_FOREACH(event_type, et) {
+		if (slab_owns(et->slab, addr)) {
+			k_mem_slab_free(et->slab, addr);
+			return true;
+		}
+	}
+
+	return false;
+}
+
+static void heap_stats_alloc(void)
+{
+	atomic_val_t used = atomic_inc(&_app_event_manager_heap_stats.used) + 1;
+	atomic_val_t max_used;
+
+	do {
+		max_used = atomic_get(&_app_event_manager_heap_stats.max_used);
+		if (used <= max_used) {
+			break;
+		}
+	} while (!atomic_cas(&_app_event_manager_heap_stats.max_used, max_used, used));
+}
+#endif /* CONFIG_APP_EVENT_MANAGER_EVENT_SLABS */
+
 void * __weak app_event_manager_alloc(size_t size)
 {
-	void *event = k_malloc(size);
+	void *event;
+
+#if IS_ENABLED(CONFIG_APP_EVENT_MANAGER_EVENT_SLABS)
+	event = app_event_manager_slab_alloc(size);
+	if (event) {
+		return event;
+	}
+#endif
+
+	event = k_malloc(size);
 
 	if (unlikely(!event)) {
 		LOG_ERR("Application Event Manager OOM error\n");
@@ -129,79 +270,212 @@ void * __weak app_event_manager_alloc(size_t size)
 		return NULL;
 	}
 
+#if IS_ENABLED(CONFIG_APP_EVENT_MANAGER_EVENT_SLABS)
+	heap_stats_alloc();
+#endif
+
 	return event;
 }
 
 void __weak app_event_manager_free(void *addr)
 {
+#if IS_ENABLED(CONFIG_APP_EVENT_MANAGER_EVENT_SLABS)
+	if (app_event_manager_slab_free(addr)) {
+		return;
+	}
+
+	atomic_dec(&_app_event_manager_heap_stats.used);
+#endif
+
 	k_free(addr);
 }
 
-static void event_processor_fn(struct k_work *work)
+#if IS_ENABLED(CONFIG_APP_EVENT_MANAGER_LOCKFREE_QUEUE)
+static inline sys_snode_t *event_queue_next_get(sys_snode_t *node)
 {
-	sys_slist_t events = SYS_SLIST_STATIC_INIT(&events);
+	return atomic_ptr_get((atomic_ptr_t *)&node->next);
+}
 
-	/* Make current event list local. */
-	k_spinlock_key_t key = k_spin_lock(&lock);
+static void event_queue_push(struct event_queue *q, sys_snode_t *node)
+{
+	sys_snode_t *prev;
 
-	if (sys_slist_is_empty(&eventq)) {
-		k_spin_unlock(&lock, key);
-		return;
+	node->next = NULL;
+	prev = atomic_ptr_set(&q->head, node);
+	/* Until the previous head is linked, the consumer sees the queue as ending at prev. */
+	atomic_ptr_set((atomic_ptr_t *)&prev->next, node);
+}
+
+static sys_snode_t *event_queue_pop(struct event_queue *q)
+{
+	sys_snode_t *tail = q->tail;
+	sys_snode_t *next = event_queue_next_get(tail);
+
+	if (tail == &q->stub) {
+		if (!next) {
+			return NULL;
+		}
+
+		q->tail = next;
+		tail = next;
+		next = event_queue_next_get(next);
 	}
 
-	sys_slist_merge_slist(&events, &eventq);
+	if (next) {
+		q->tail = next;
+		return tail;
+	}
 
-	k_spin_unlock(&lock, key);
+	/* A producer exchanged the head but did not link its node yet. It submits the
+	 * event processor after it is done, so the event is not lost.
+	 */
+	if (tail != atomic_ptr_get(&q->head)) {
+		return NULL;
+	}
 
-	/* Traverse the list of events. */
-	sys_snode_t *node;
-	while (NULL != (node = sys_slist_get(&events))) {
-		struct app_event_header *aeh = CONTAINER_OF(node,
-						       struct app_event_header,
-						       node);
+	/* The tail is the last node. Put the stub behind it so that it can be removed. */
+	event_queue_push(q, &q->stub);
+
+	next = event_queue_next_get(tail);
+	if (next) {
+		q->tail = next;
+		return tail;
+	}
 
-		APP_EVENT_ASSERT_ID(aeh->type_id);
+	return NULL;
+}
+#endif /* CONFIG_APP_EVENT_MANAGER_LOCKFREE_QUEUE */
 
-		const struct event_type *et = aeh->type_id;
+static bool listener_notify(const struct event_listener *el,
+			    const struct app_event_header *aeh)
+{
+#if IS_ENABLED(CONFIG_APP_EVENT_MANAGER_LISTENER_STATS)
+	uint32_t start = k_cycle_get_32();
+	bool consumed = el->notification(aeh);
+	uint32_t cycles = k_cycle_get_32() - start;
+	k_spinlock_key_t key = k_spin_lock(&listener_stats_lock);
+
+	el->stats->notified++;
+	el->stats->cycles += cycles;
+	if (consumed) {
+		el->stats->consumed++;
+	}
 
-		if (IS_ENABLED(CONFIG_APP_EVENT_MANAGER_PREPROCESS_HOOKS)) {
-			STRUCT_SECTION_FOREACH(event_preprocess_hook, h) {
-				h->hook(aeh);
-			}
+	k_spin_unlock(&listener_stats_lock, key);
+
+	return consumed;
+#else
+	return el->notification(aeh);
+#endif
+}
+
+static void event_process(struct app_event_header *aeh)
+{
+	APP_EVENT_ASSERT_ID(aeh->type_id);
+
+	const struct event_type *et = aeh->type_id;
+	uint32_t start = PERF_TIMESTAMP();
+
+	if (IS_ENABLED(CONFIG_APP_EVENT_MANAGER_PREPROCESS_HOOKS)) {
+		STRUCT_SECTION_FOREACH(event_preprocess_hook, h) {
+			h->hook(aeh);
 		}
+	}
 
-		log_event(aeh);
+	log_event(aeh);
 
-		bool consumed = false;
+	bool consumed = false;
 
-		for (const struct event_subscriber *es = et->subs_start;
-		     (es != et->subs_stop) && !consumed;
-		     es++) {
+	for (const struct event_subscriber *es = et->subs_start;
+	     (es != et->subs_stop) && !consumed;
+	     es++) {
 
-			__ASSERT_NO_MSG(es != NULL);
+		__ASSERT_NO_MSG(es != NULL);
 
-			const struct event_listener *el = es->listener;
+		const struct event_listener *el = es->listener;
 
-			__ASSERT_NO_MSG(el != NULL);
-			__ASSERT_NO_MSG(el->notification != NULL);
+		__ASSERT_NO_MSG(el != NULL);
+		__ASSERT_NO_MSG(el->notification != NULL);
 
-			log_event_progress(et, el);
+		log_event_progress(et, el);
 
-			consumed = el->notification(aeh);
+		consumed = listener_notify(el, aeh);
 
-			if (consumed) {
-				log_event_consumed(et);
-			}
+		if (consumed) {
+			log_event_consumed(et);
 		}
+	}
 
-		if (IS_ENABLED(CONFIG_APP_EVENT_MANAGER_POSTPROCESS_HOOKS)) {
-			STRUCT_SECTION_FOREACH(event_postprocess_hook, h) {
-				h->hook(aeh);
-			}
+	if (IS_ENABLED(CONFIG_APP_EVENT_MANAGER_POSTPROCESS_HOOKS)) {
+		STRUCT_SECTION_FOREACH(event_postprocess_hook, h) {
+			h->hook(aeh);
 		}
+	}
+
+	app_event_manager_free(aeh);
 
-		app_event_manager_free(aeh);
+	PERF_HISTOGRAM_RECORD_SINCE(app_event_manager_process_time, start);
+}
+
+static void lane_work_submit(size_t lane_idx)
+{
+#if CONFIG_APP_EVENT_MANAGER_LANES > 1
+	if (lane_idx > 0) {
+		/* Fails only before the lane workqueue is started. The work is then
+		 * submitted on initialization.
+		 */
+		(void)k_work_submit_to_queue(&lane_work_q[lane_idx - 1], &lanes[lane_idx].work);
+		return;
 	}
+#endif
+
+	k_work_submit(&lanes[lane_idx].work);
+}
+
+static void lane_yield(size_t lane_idx)
+{
+	/* Workqueue threads are usually cooperative and a lane with higher priority
+	 * can run only if the lane being processed yields.
+	 */
+	if (lane_idx < (CONFIG_APP_EVENT_MANAGER_LANES - 1)) {
+		k_yield();
+	}
+}
+
+static void event_processor_fn(struct k_work *work)
+{
+	struct event_lane *lane = CONTAINER_OF(work, struct event_lane, work);
+	size_t lane_idx = lane - lanes;
+
+#if IS_ENABLED(CONFIG_APP_EVENT_MANAGER_LOCKFREE_QUEUE)
+	sys_snode_t *node;
+
+	while (NULL != (node = event_queue_pop(&lane->queue))) {
+		event_process(CONTAINER_OF(node, struct app_event_header, node));
+		lane_yield(lane_idx);
+	}
+#else
+	sys_slist_t events = SYS_SLIST_STATIC_INIT(&events);
+
+	/* Make current event list local. */
+	k_spinlock_key_t key = k_spin_lock(&lane->lock);
+
+	if (sys_slist_is_empty(&lane->queue)) {
+		k_spin_unlock(&lane->lock, key);
+		return;
+	}
+
+	sys_slist_merge_slist(&events, &lane->queue);
+
+	k_spin_unlock(&lane->lock, key);
+
+	/* Traverse the list of events. */
+	sys_snode_t *node;
+	while (NULL != (node = sys_slist_get(&events))) {
+		event_process(CONTAINER_OF(node, struct app_event_header, node));
+		lane_yield(lane_idx);
+	}
+#endif /* CONFIG_APP_EVENT_MANAGER_LOCKFREE_QUEUE */
 }
 
 void _event_submit(struct app_event_header *aeh)
@@ -209,19 +483,58 @@ void _event_submit(struct app_event_header *aeh)
 	__ASSERT_NO_MSG(aeh);
 	APP_EVENT_ASSERT_ID(aeh->type_id);
 
-	k_spinlock_key_t key = k_spin_lock(&lock);
+	size_t lane_idx = aeh->type_id->lane;
+	struct event_lane *lane = &lanes[lane_idx];
+
+	__ASSERT_NO_MSG(lane_idx < CONFIG_APP_EVENT_MANAGER_LANES);
+
+#if IS_ENABLED(CONFIG_APP_EVENT_MANAGER_LOCKFREE_QUEUE)
+	if (IS_ENABLED(CONFIG_APP_EVENT_MANAGER_SUBMIT_HOOKS)) {
+		STRUCT_SECTION_FOREACH(event_submit_hook, h) {
+			h->hook(aeh);
+		}
+	}
+	event_queue_push(&lane->queue, &aeh->node);
+#else
+	k_spinlock_key_t key = k_spin_lock(&lane->lock);
 
 	if (IS_ENABLED(CONFIG_APP_EVENT_MANAGER_SUBMIT_HOOKS)) {
 		STRUCT_SECTION_FOREACH(event_submit_hook, h) {
 			h->hook(aeh);
 		}
 	}
-	sys_slist_append(&eventq, &aeh->node);
-	k_spin_unlock(&lock, key);
+	sys_slist_append(&lane->queue, &aeh->node);
+	k_spin_unlock(&lane->lock, key);
+#endif /* CONFIG_APP_EVENT_MANAGER_LOCKFREE_QUEUE */
+
+	PERF_COUNTER_INC(app_event_manager_submit);
+
+	lane_work_submit(lane_idx);
+}
 
-	k_work_submit(&event_processor);
+#if IS_ENABLED(CONFIG_APP_EVENT_MANAGER_LISTENER_STATS)
+void _app_event_manager_listener_stats_get(const struct event_listener *el,
+					   struct event_listener_stats *stats)
+{
+	k_spinlock_key_t key = k_spin_lock(&listener_stats_lock);
+
+	*stats = *el->stats;
+
+	k_spin_unlock(&listener_stats_lock, key);
 }
 
+void _app_event_manager_listener_stats_reset(void)
+{
+	k_spinlock_key_t key = k_spin_lock(&listener_stats_lock);
+
+	STRUCT_SECTION_FOREACH(event_listener, el) {
+		memset(el->stats, 0, sizeof(*el->stats));
+	}
+
+	k_spin_unlock(&listener_stats_lock, key);
+}
+#endif /* CONFIG_APP_EVENT_MANAGER_LISTENER_STATS */
+
 int app_event_manager_init(void)
 {
 	int ret = 0;
@@ -231,6 +544,22 @@ int app_event_manager_init(void)
 
 	log_event_init();
 
+#if CONFIG_APP_EVENT_MANAGER_LANES > 1
+	for (size_t i = 0; i < LANE_WORK_Q_CNT; i++) {
+		const struct k_work_queue_config cfg = {
+			.name = "app_event_lane",
+		};
+
+		/* The lane priority grows with the lane number. */
+		k_work_queue_start(&lane_work_q[i], lane_stacks[i],
+				   K_THREAD_STACK_SIZEOF(lane_stacks[i]),
+				   CONFIG_APP_EVENT_MANAGER_LANE_PRIORITY - i, &cfg);
+
+		/* Process events submitted before the initialization. */
+		lane_work_submit(i + 1);
+	}
+#endif
+
 	if (IS_ENABLED(CONFIG_APP_EVENT_MANAGER_POSTINIT_HOOK)) {
 		STRUCT_SECTION_FOREACH(app_event_manager_postinit_hook, h) {
 			ret = h->hook();
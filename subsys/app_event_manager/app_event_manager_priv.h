@@ -187,11 +187,26 @@ extern "C" {
 
 
 
+#if IS_ENABLED(CONFIG_APP_EVENT_MANAGER_LISTENER_STATS)
+#define _APP_EVENT_LISTENER_STATS_NAME(lname) _CONCAT(__event_listener_stats_, lname)
+
+#define _APP_EVENT_LISTENER_STATS_DEFINE(lname)						\
+	static struct event_listener_stats _APP_EVENT_LISTENER_STATS_NAME(lname);
+
+#define _APP_EVENT_LISTENER_DEFINE_STATS(lname)        \
+	.stats = &_APP_EVENT_LISTENER_STATS_NAME(lname),
+#else
+#define _APP_EVENT_LISTENER_STATS_DEFINE(lname)
+#define _APP_EVENT_LISTENER_DEFINE_STATS(lname)
+#endif
+
 /* Declarations and definitions - for more details refer to public API. */
 #define _APP_EVENT_LISTENER(lname, notification_fn)					\
+	_APP_EVENT_LISTENER_STATS_DEFINE(lname)						\
 	STRUCT_SECTION_ITERABLE(event_listener, _CONCAT(__event_listener_, lname)) = {	\
 		.name = STRINGIFY(lname),						\
 		.notification = (notification_fn),					\
+		_APP_EVENT_LISTENER_DEFINE_STATS(lname) /* No comma here intentionally */\
 	}
 
 
@@ -219,6 +234,29 @@ extern "C" {
 #define _APP_EVENT_TYPE_DEFINE_SIZES(ename)
 #endif
 
+#if IS_ENABLED(CONFIG_APP_EVENT_MANAGER_EVENT_SLABS)
+/* Slab blocks have the same alignment as k_malloc allocations. */
+#define _APP_EVENT_SLAB_ALIGN 8
+
+#define _APP_EVENT_SLAB_NAME(ename) _CONCAT(__event_slab_, ename)
+
+/* Expand the slab name before it is pasted by the kernel macro. */
+#define _APP_EVENT_SLAB_DEFINE(name, block_size)					\
+	K_MEM_SLAB_DEFINE_STATIC(name, block_size,					\
+				 CONFIG_APP_EVENT_MANAGER_EVENT_SLAB_BLOCKS,		\
+				 _APP_EVENT_SLAB_ALIGN)
+
+#define _APP_EVENT_TYPE_SLAB_DEFINE(ename)						\
+	_APP_EVENT_SLAB_DEFINE(_APP_EVENT_SLAB_NAME(ename),				\
+			       ROUND_UP(sizeof(struct ename), _APP_EVENT_SLAB_ALIGN));
+
+#define _APP_EVENT_TYPE_DEFINE_SLAB(ename)             \
+	.slab = &_APP_EVENT_SLAB_NAME(ename),
+#else
+#define _APP_EVENT_TYPE_SLAB_DEFINE(ename)
+#define _APP_EVENT_TYPE_DEFINE_SLAB(ename)
+#endif
+
 /** @brief Event header.
  *
  * When defining an event structure, the application event header
@@ -288,10 +326,18 @@ struct event_type {
 	/** Array of flags dedicated to event type. */
 	const uint8_t flags;
 
+	/** Lane in which the events of this type are processed. */
+	const uint8_t lane;
+
 #if IS_ENABLED(CONFIG_APP_EVENT_MANAGER_PROVIDE_EVENT_SIZE)
 	/** The size of the event structure */
 	uint16_t struct_size;
 #endif
+
+#if IS_ENABLED(CONFIG_APP_EVENT_MANAGER_EVENT_SLABS)
+	/** Memory slab with blocks sized for the event structure. */
+	struct k_mem_slab *slab;
+#endif
 };
 
 
@@ -299,11 +345,14 @@ extern struct event_type _event_type_list_start[];
 extern struct event_type _event_type_list_end[];
 
 
-#define _APP_EVENT_TYPE_DEFINE(ename, log_fn, trace_data_pointer, et_flags)		\
+#define _APP_EVENT_TYPE_DEFINE(ename, log_fn, trace_data_pointer, et_flags, et_lane)	\
 	BUILD_ASSERT(((et_flags) & ((BIT_MASK(APP_EVENT_TYPE_FLAGS_USER_SETTABLE_START-	\
 		APP_EVENT_TYPE_FLAGS_SYSTEM_START))<<					\
 		APP_EVENT_TYPE_FLAGS_SYSTEM_START)) == 0);				\
+	BUILD_ASSERT((et_lane) < CONFIG_APP_EVENT_MANAGER_LANES,			\
+		     "Event lane out of range");					\
 	_APP_EVENT_SUBSCRIBERS_ARRAY_TAGS(ename);					\
+	_APP_EVENT_TYPE_SLAB_DEFINE(ename)						\
 	STRUCT_SECTION_ITERABLE(event_type, _CONCAT(__event_type_, ename)) = {		\
 		.name            = STRINGIFY(ename),					\
 		.subs_start      = _APP_EVENT_SUBSCRIBERS_START_TAG(ename),		\
@@ -314,7 +363,9 @@ extern struct event_type _event_type_list_end[];
 		.flags = ((_CONCAT(ename, _HAS_DYNDATA)) ?				\
 				((et_flags) | BIT(APP_EVENT_TYPE_FLAGS_HAS_DYNDATA)) :	\
 				((et_flags) & (~BIT(APP_EVENT_TYPE_FLAGS_HAS_DYNDATA)))),\
+		.lane = (et_lane),							\
 		_APP_EVENT_TYPE_DEFINE_SIZES(ename) /* No comma here intentionally */	\
+		_APP_EVENT_TYPE_DEFINE_SLAB(ename) /* No comma here intentionally */	\
 	}
 
 /**
@@ -326,6 +377,33 @@ struct app_event_manager_event_display_bm {
 
 extern struct app_event_manager_event_display_bm _app_event_manager_event_display_bm;
 
+#if IS_ENABLED(CONFIG_APP_EVENT_MANAGER_EVENT_SLABS)
+/**
+ * @brief Usage of the heap by events that did not fit in any event slab.
+ */
+struct app_event_manager_heap_stats {
+	/** Number of events currently allocated from the heap. */
+	atomic_t used;
+
+	/** Highest number of events allocated from the heap at the same time. */
+	atomic_t max_used;
+};
+
+extern struct app_event_manager_heap_stats _app_event_manager_heap_stats;
+#endif
+
+#if IS_ENABLED(CONFIG_APP_EVENT_MANAGER_LISTENER_STATS)
+struct event_listener;
+struct event_listener_stats;
+
+/* Get a consistent copy of the statistics of the given listener. */
+void _app_event_manager_listener_stats_get(const struct event_listener *el,
+					   struct event_listener_stats *stats);
+
+/* Clear the statistics of all listeners. */
+void _app_event_manager_listener_stats_reset(void);
+#endif
+
 
 /* Event hooks subscribers */
 #define _APP_EVENT_HOOK_REGISTER(section, hook_fn, prio)           \
@@ -374,6 +452,19 @@ struct event_dyndata {
 };
 
 
+/** @brief Event listener statistics.
+ */
+struct event_listener_stats {
+	/** Number of events the listener was notified about. */
+	uint32_t notified;
+
+	/** Number of events consumed by the listener. */
+	uint32_t consumed;
+
+	/** Total time spent in the notification function, in cycles. */
+	uint64_t cycles;
+};
+
 /** @brief Event listener.
  *
  * All event listeners must be defined using @ref APP_EVENT_LISTENER.
@@ -387,6 +478,11 @@ struct event_listener {
 	 * not propagated to further listeners, or false, otherwise.
 	 */
 	bool (*notification)(const struct app_event_header *aeh);
+
+#if IS_ENABLED(CONFIG_APP_EVENT_MANAGER_LISTENER_STATS)
+	/** Statistics of the notifications of this listener. */
+	struct event_listener_stats *stats;
+#endif
 };
 
 
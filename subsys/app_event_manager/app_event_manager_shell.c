@@ -22,11 +22,17 @@ static int show_events(const struct shell *shell, size_t argc,
 
 		shell_fprintf(shell,
 			      SHELL_NORMAL,
-			      "%c %zu:\t%s\n",
+			      "%c %zu:\t%s",
 			      (atomic_test_bit(_app_event_manager_event_display_bm.flags, ev_id)) ?
 				'E' : 'D',
 			      ev_id,
 			      et->name);
+
+		if (CONFIG_APP_EVENT_MANAGER_LANES > 1) {
+			shell_fprintf(shell, SHELL_NORMAL, " (lane %u)", et->lane);
+		}
+
+		shell_fprintf(shell, SHELL_NORMAL, "\n");
 	}
 
 	return 0;
@@ -45,6 +51,40 @@ static int show_listeners(const struct shell *shell, size_t argc,
 	return 0;
 }
 
+#if IS_ENABLED(CONFIG_APP_EVENT_MANAGER_LISTENER_STATS)
+static int show_listener_stats(const struct shell *shell, size_t argc,
+		char **argv)
+{
+	shell_fprintf(shell, SHELL_NORMAL,
+		      "Listener statistics (notified, consumed, total us, average us):\n");
+
+	STRUCT_SECTION_FOREACH(event_listener, el) {
+		struct event_listener_stats stats;
+		uint64_t total_us;
+
+		_app_event_manager_listener_stats_get(el, &stats);
+		total_us = k_cyc_to_us_floor64(stats.cycles);
+
+		shell_fprintf(shell, SHELL_NORMAL, "|\t[L:%s] %u %u %llu %llu\n",
+			      el->name, stats.notified, stats.consumed,
+			      (unsigned long long)total_us,
+			      (unsigned long long)((stats.notified > 0) ?
+						   (total_us / stats.notified) : 0));
+	}
+
+	return 0;
+}
+
+static int reset_listener_stats(const struct shell *shell, size_t argc,
+		char **argv)
+{
+	_app_event_manager_listener_stats_reset();
+	shell_fprintf(shell, SHELL_NORMAL, "Listener statistics cleared\n");
+
+	return 0;
+}
+#endif /* CONFIG_APP_EVENT_MANAGER_LISTENER_STATS */
+
 static int show_subscribers(const struct shell *shell, size_t argc,
 		char **argv)
 {
@@ -81,6 +121,31 @@ static int show_subscribers(const struct shell *shell, size_t argc,
 	return 0;
 }
 
+#if IS_ENABLED(CONFIG_APP_EVENT_MANAGER_EVENT_SLABS)
+static int show_memory(const struct shell *shell, size_t argc,
+		char **argv)
+{
+	shell_fprintf(shell, SHELL_NORMAL,
+		      "Event slabs (block size, used, max used, blocks):\n");
+
+	STRUCT_SECTION_FOREACH(event_type, et) {
+		struct k_mem_slab *slab = et->slab;
+
+		shell_fprintf(shell, SHELL_NORMAL, "|\t[E:%s] %zu %u %u %u\n",
+			      et->name, slab->info.block_size,
+			      k_mem_slab_num_used_get(slab),
+			      k_mem_slab_max_used_get(slab),
+			      slab->info.num_blocks);
+	}
+
+	shell_fprintf(shell, SHELL_NORMAL, "Events on heap: used %ld, max used %ld\n",
+		      (long)atomic_get(&_app_event_manager_heap_stats.used),
+		      (long)atomic_get(&_app_event_manager_heap_stats.max_used));
+
+	return 0;
+}
+#endif /* CONFIG_APP_EVENT_MANAGER_EVENT_SLABS */
+
 static void set_event_displaying(const struct shell *shell, size_t argc,
 				 char **argv, bool enable)
 {
@@ -154,7 +219,17 @@ SHELL_STATIC_SUBCMD_SET_CREATE(sub_app_event_manager,
 		      show_listeners, 0, 0),
 	SHELL_CMD_ARG(show_subscribers, NULL, "Show subscribers",
 		      show_subscribers, 0, 0),
+#if IS_ENABLED(CONFIG_APP_EVENT_MANAGER_LISTENER_STATS)
+	SHELL_CMD_ARG(show_listener_stats, NULL, "Show listener statistics",
+		      show_listener_stats, 0, 0),
+	SHELL_CMD_ARG(reset_listener_stats, NULL, "Clear listener statistics",
+		      reset_listener_stats, 0, 0),
+#endif
 	SHELL_CMD_ARG(show_events, NULL, "Show events", show_events, 0, 0),
+#if IS_ENABLED(CONFIG_APP_EVENT_MANAGER_EVENT_SLABS)
+	SHELL_CMD_ARG(show_memory, NULL, "Show event memory usage",
+		      show_memory, 0, 0),
+#endif
 	SHELL_CMD_ARG(disable, NULL, "Disable displaying event with given ID",
 		      disable_event_displaying, 0,
 		      sizeof(_app_event_manager_event_display_bm) * 8 - 1),
@@ -127,6 +127,13 @@ static bool validate_parameters(struct audio_module_parameters const *const para
 		return false;
 	}
 
+#if defined(CONFIG_AUDIO_MODULE_GRAPH)
+	if (parameters->graph != NULL) {
+		/* The module is run by the graph's scheduler thread */
+		return true;
+	}
+#endif /* CONFIG_AUDIO_MODULE_GRAPH */
+
 	if (parameters->thread.stack == NULL || parameters->thread.stack_size == 0) {
 		return false;
 	}
@@ -155,7 +162,7 @@ static void audio_data_release_cb(struct audio_module_handle_private *handle,
 
 	if (k_sem_count_get(&hdl->sem) == 0) {
 		/* Audio data has been consumed by all modules so now can free the data memory. */
-		k_mem_slab_free(hdl->thread.data_slab, (void **)&audio_data->data);
+		k_mem_slab_free(hdl->thread.data_slab, audio_data->data);
 	}
 }
 
@@ -202,6 +209,13 @@ static int data_tx(struct audio_module_handle *tx_handle, struct audio_module_ha
 
 		LOG_DBG("Audio data sent to module %s", rx_handle->name);
 
+#if defined(CONFIG_AUDIO_MODULE_GRAPH)
+		if (rx_handle->graph != NULL) {
+			/* Wake the scheduler in case it was idle waiting for audio data. */
+			k_sem_give(&rx_handle->graph->wake_sem);
+		}
+#endif /* CONFIG_AUDIO_MODULE_GRAPH */
+
 	} else {
 		LOG_WRN("Receiving module %s is in an invalid state %d", rx_handle->name,
 			rx_handle->state);
@@ -214,13 +228,16 @@ static int data_tx(struct audio_module_handle *tx_handle, struct audio_module_ha
 /**
  * @brief Send audio data item to the module's TX FIFO.
  *
- * @param handle      [in/out]  The handle for this modules instance.
- * @param audio_data  [in]      A pointer to the audio data.
+ * @param handle       [in/out]  The handle for this modules instance.
+ * @param audio_data   [in]      A pointer to the audio data.
+ * @param response_cb  [in]      A pointer to a callback to run when the audio data has been
+ *                               retrieved from the TX FIFO.
  *
  * @return 0 if successful, error otherwise.
  */
 static int tx_fifo_put(struct audio_module_handle *handle,
-		       struct audio_data const *const audio_data)
+		       struct audio_data const *const audio_data,
+		       audio_module_response_cb response_cb)
 {
 	int ret;
 	struct audio_module_message *data_msg_tx;
@@ -236,7 +253,7 @@ static int tx_fifo_put(struct audio_module_handle *handle,
 	/* Configure audio data. */
 	memcpy(&data_msg_tx->audio_data, audio_data, sizeof(struct audio_data));
 	data_msg_tx->tx_handle = handle;
-	data_msg_tx->response_cb = audio_data_release_cb;
+	data_msg_tx->response_cb = response_cb;
 
 	/* Send audio data to modules output message queue. */
 	ret = data_fifo_block_lock(handle->thread.msg_tx, (void **)&data_msg_tx,
@@ -247,11 +264,6 @@ static int tx_fifo_put(struct audio_module_handle *handle,
 
 		data_fifo_block_free(handle->thread.msg_tx, (void **)&data_msg_tx);
 
-		ret = k_sem_take(&handle->sem, K_NO_WAIT);
-		if (ret) {
-			LOG_ERR("Failed to take semaphore for TX FIFO put");
-		}
-
 		return ret;
 	}
 
@@ -271,12 +283,15 @@ static int send_to_connected_modules(struct audio_module_handle *handle,
 {
 	int ret;
 	struct audio_module_handle *handle_to;
+	bool to_tx_queue = handle->use_tx_queue && handle->thread.msg_tx;
+	unsigned int consumers;
+	unsigned int sent = 0;
 
 	if (handle->dest_count == 0) {
 		LOG_WRN("Nowhere to send the audio data from module %s so releasing it",
 			handle->name);
 
-		k_mem_slab_free(handle->thread.data_slab, (void **)audio_data->data);
+		k_mem_slab_free(handle->thread.data_slab, audio_data->data);
 
 		return 0;
 	}
@@ -292,11 +307,14 @@ static int send_to_connected_modules(struct audio_module_handle *handle,
 	}
 
 	/* Here the semaphore is used as a count of the number of audio data items out in the
-	 * connected modules.
+	 * connected modules and in the TX FIFO.
 	 */
-	ret = k_sem_init(&handle->sem, handle->dest_count, handle->dest_count);
+	consumers = handle->dest_count + (to_tx_queue ? 1 : 0);
+
+	ret = k_sem_init(&handle->sem, consumers, consumers);
 	if (ret) {
 		LOG_ERR("Failed to initiate semaphore");
+		k_mutex_unlock(&handle->dest_mutex);
 		return ret;
 	}
 
@@ -307,8 +325,18 @@ static int send_to_connected_modules(struct audio_module_handle *handle,
 			LOG_ERR("Failed to send audio data to module %s from %s, ret %d",
 				handle_to->name, handle->name, ret);
 
+			/* Release the audio data for the consumers that did not get it */
+			for (; sent < consumers; sent++) {
+				audio_data_release_cb((struct audio_module_handle_private *)handle,
+						      audio_data);
+			}
+
+			k_mutex_unlock(&handle->dest_mutex);
+
 			return ret;
 		}
+
+		sent++;
 	}
 
 	ret = k_mutex_unlock(&handle->dest_mutex);
@@ -320,16 +348,15 @@ static int send_to_connected_modules(struct audio_module_handle *handle,
 	/* Send to this module's TX FIFO for extraction by an external
 	 * process with audio_module_rx().
 	 */
-	if (handle->use_tx_queue && handle->thread.msg_tx) {
-		ret = tx_fifo_put(handle, audio_data);
+	if (to_tx_queue) {
+		ret = tx_fifo_put(handle, audio_data, audio_data_release_cb);
 		if (ret) {
 			LOG_ERR("Failed to send audio data on module %s TX message queue",
 				handle->name);
 
-			ret = k_sem_take(&handle->sem, K_NO_WAIT);
-			if (ret) {
-				LOG_ERR("Failed to take semaphore");
-			}
+			/* Give back the release reserved for the TX FIFO */
+			audio_data_release_cb((struct audio_module_handle_private *)handle,
+					      audio_data);
 
 			return ret;
 		}
@@ -368,7 +395,7 @@ static void module_thread_input(struct audio_module_handle *handle, void *p2, vo
 		 * will control the data flow.
 		 */
 		ret = k_mem_slab_alloc(handle->thread.data_slab, (void **)&data, K_NO_WAIT);
-		__ASSERT(ret, "No free data for module %s, ret %d", handle->name, ret);
+		__ASSERT(ret == 0, "No free data for module %s, ret %d", handle->name, ret);
 
 		/* Configure new audio data. */
 		audio_data.data = data;
@@ -378,7 +405,7 @@ static void module_thread_input(struct audio_module_handle *handle, void *p2, vo
 		ret = handle->description->functions->data_process(
 			(struct audio_module_handle_private *)handle, NULL, &audio_data);
 		if (ret) {
-			k_mem_slab_free(handle->thread.data_slab, (void **)(&data));
+			k_mem_slab_free(handle->thread.data_slab, data);
 
 			LOG_ERR("Data process error in module %s, ret %d", handle->name, ret);
 			continue;
@@ -427,7 +454,7 @@ static void module_thread_output(struct audio_module_handle *handle, void *p2, v
 		 */
 		ret = data_fifo_pointer_last_filled_get(handle->thread.msg_rx, (void **)&msg_rx,
 							&size, K_FOREVER);
-		__ASSERT(ret, "Module %s error in getting last filled", handle->name);
+		__ASSERT(ret == 0, "Module %s error in getting last filled", handle->name);
 
 		LOG_DBG("Module %s new audio data received", handle->name);
 
@@ -490,13 +517,13 @@ static void module_thread_in_out(struct audio_module_handle *handle, void *p2, v
 		 */
 		ret = data_fifo_pointer_last_filled_get(handle->thread.msg_rx, (void **)&msg_rx,
 							&size, K_FOREVER);
-		__ASSERT(ret, "Module %s error in getting last filled", handle->name);
+		__ASSERT(ret == 0, "Module %s error in getting last filled", handle->name);
 
 		LOG_DBG("Module %s new audio data received", handle->name);
 
 		/* Get a new output buffer. */
 		ret = k_mem_slab_alloc(handle->thread.data_slab, (void **)&data, K_NO_WAIT);
-		__ASSERT(ret, "No free data buffer for module %s, dropping input, ret %d",
+		__ASSERT(ret == 0, "No free data buffer for module %s, dropping input, ret %d",
 			 handle->name, ret);
 
 		/* Configure new audio audio_data. */
@@ -516,7 +543,7 @@ static void module_thread_in_out(struct audio_module_handle *handle, void *p2, v
 
 			data_fifo_block_free(handle->thread.msg_rx, (void **)(&msg_rx));
 
-			k_mem_slab_free(handle->thread.data_slab, (void **)(&data));
+			k_mem_slab_free(handle->thread.data_slab, data);
 
 			LOG_ERR("Data process error in module %s, ret %d", handle->name, ret);
 			continue;
@@ -536,6 +563,356 @@ static void module_thread_in_out(struct audio_module_handle *handle, void *p2, v
 	CODE_UNREACHABLE;
 }
 
+#if defined(CONFIG_AUDIO_MODULE_GRAPH)
+/* Reference count kept in front of the audio data in each block of a graph's data slab */
+struct graph_block_header {
+	atomic_t ref_count;
+};
+
+BUILD_ASSERT(sizeof(struct graph_block_header) <= AUDIO_MODULE_GRAPH_BLOCK_HEADER_SIZE);
+
+static inline struct graph_block_header *graph_block_header_get(void const *data)
+{
+	return (struct graph_block_header *)((uint8_t *)data -
+					     AUDIO_MODULE_GRAPH_BLOCK_HEADER_SIZE);
+}
+
+/**
+ * @brief Drop a reference to a block of a graph's data slab, freeing it on the last one.
+ *
+ * @param graph  [in/out]  Pointer to the graph.
+ * @param data   [in]      Pointer to the audio data in the block.
+ */
+static void graph_block_release(struct audio_module_graph *graph, void const *data)
+{
+	struct graph_block_header *header = graph_block_header_get(data);
+
+	if (atomic_dec(&header->ref_count) == 1) {
+		k_mem_slab_free(graph->parameters.data_slab, header);
+	}
+}
+
+/**
+ * @brief Callback for releasing graph audio data retrieved from a module's TX FIFO.
+ *
+ * @param handle      [in/out]  The handle of the sending modules instance.
+ * @param audio_data  [in]      Pointer to the audio data to release.
+ */
+static void graph_audio_data_release_cb(struct audio_module_handle_private *handle,
+					struct audio_data const *const audio_data)
+{
+	struct audio_module_handle *hdl = (struct audio_module_handle *)handle;
+
+	graph_block_release(hdl->graph, audio_data->data);
+
+	/* The scheduler may be waiting for a free block for an input module. */
+	k_sem_give(&hdl->graph->wake_sem);
+}
+
+/**
+ * @brief Helper function to find a module in a graph.
+ *
+ * @param graph   [in]  Pointer to the graph.
+ * @param handle  [in]  The handle of the module to find.
+ *
+ * @return Index of the module in the graph, -ENOENT if not found.
+ */
+static int graph_module_index_get(struct audio_module_graph const *graph,
+				  struct audio_module_handle const *handle)
+{
+	for (int i = 0; i < graph->module_count; i++) {
+		if (graph->modules[i] == handle) {
+			return i;
+		}
+	}
+
+	return -ENOENT;
+}
+
+/**
+ * @brief Add a module to a graph.
+ *
+ * @param graph   [in/out]  Pointer to the graph.
+ * @param handle  [in/out]  The handle of the module to add.
+ *
+ * @return 0 if successful, error otherwise.
+ */
+static int graph_module_add(struct audio_module_graph *graph, struct audio_module_handle *handle)
+{
+	if (graph->running) {
+		LOG_ERR("Graph is running, cannot add module %s", handle->name);
+		return -EBUSY;
+	}
+
+	if (graph->module_count >= CONFIG_AUDIO_MODULE_GRAPH_MODULES_MAX) {
+		LOG_ERR("No room for module %s in the graph", handle->name);
+		return -ENOMEM;
+	}
+
+	graph->modules[graph->module_count++] = handle;
+	handle->graph = graph;
+
+	return 0;
+}
+
+/**
+ * @brief Remove a module from its graph.
+ *
+ * @param handle  [in/out]  The handle of the module to remove.
+ */
+static void graph_module_remove(struct audio_module_handle *handle)
+{
+	struct audio_module_graph *graph = handle->graph;
+	int idx = graph_module_index_get(graph, handle);
+
+	if (idx >= 0) {
+		graph->modules[idx] = graph->modules[--graph->module_count];
+	}
+
+	handle->graph = NULL;
+}
+
+/**
+ * @brief Sort the modules of a graph into topological order.
+ *
+ * @note Uses Kahn's algorithm, so each module is placed after the module it receives its audio
+ *       data from. The position of that upstream module is stored in each node.
+ *
+ * @param graph  [in/out]  Pointer to the graph.
+ *
+ * @return 0 if successful, error otherwise.
+ */
+static int graph_order_build(struct audio_module_graph *graph)
+{
+	int idx;
+	size_t head = 0;
+	size_t tail = 0;
+	uint8_t in_degree[CONFIG_AUDIO_MODULE_GRAPH_MODULES_MAX] = {0};
+	int8_t upstream[CONFIG_AUDIO_MODULE_GRAPH_MODULES_MAX];
+	uint8_t queue[CONFIG_AUDIO_MODULE_GRAPH_MODULES_MAX];
+	uint8_t position[CONFIG_AUDIO_MODULE_GRAPH_MODULES_MAX];
+	struct audio_module_handle *handle_to;
+
+	for (int i = 0; i < graph->module_count; i++) {
+		upstream[i] = -1;
+	}
+
+	for (int i = 0; i < graph->module_count; i++) {
+		struct audio_module_handle *handle = graph->modules[i];
+
+		SYS_SLIST_FOR_EACH_CONTAINER(&handle->handle_dest_list, handle_to, node) {
+			idx = graph_module_index_get(graph, handle_to);
+			if (idx < 0) {
+				LOG_ERR("Module %s is connected to %s outside the graph",
+					handle->name, handle_to->name);
+				return -EINVAL;
+			}
+
+			if (in_degree[idx]++ != 0) {
+				LOG_ERR("Module %s has more than one input", handle_to->name);
+				return -ENOTSUP;
+			}
+
+			upstream[idx] = i;
+		}
+	}
+
+	for (int i = 0; i < graph->module_count; i++) {
+		if (in_degree[i] == 0) {
+			queue[tail++] = i;
+		}
+	}
+
+	while (head < tail) {
+		SYS_SLIST_FOR_EACH_CONTAINER(&graph->modules[queue[head]]->handle_dest_list,
+					     handle_to, node) {
+			idx = graph_module_index_get(graph, handle_to);
+
+			if (--in_degree[idx] == 0) {
+				queue[tail++] = idx;
+			}
+		}
+
+		head++;
+	}
+
+	if (tail != graph->module_count) {
+		LOG_ERR("The module connections in the graph form a loop");
+		return -ELOOP;
+	}
+
+	for (int i = 0; i < graph->module_count; i++) {
+		position[queue[i]] = i;
+	}
+
+	for (int i = 0; i < graph->module_count; i++) {
+		graph->nodes[i].handle = graph->modules[queue[i]];
+		graph->nodes[i].upstream =
+			(upstream[queue[i]] < 0) ? -1 : position[upstream[queue[i]]];
+		graph->nodes[i].output_valid = false;
+	}
+
+	return 0;
+}
+
+/**
+ * @brief Drop the scheduler's references to the audio data of the current frame.
+ *
+ * @param graph  [in/out]  Pointer to the graph.
+ */
+static void graph_frame_release(struct audio_module_graph *graph)
+{
+	for (int i = 0; i < graph->module_count; i++) {
+		if (graph->nodes[i].output_valid) {
+			graph->nodes[i].output_valid = false;
+			graph_block_release(graph, graph->nodes[i].output.data);
+		}
+	}
+}
+
+/**
+ * @brief Run every module in a graph once, in topological order.
+ *
+ * @param graph  [in/out]  Pointer to the graph.
+ *
+ * @return Number of source modules that were run or took audio data from their RX FIFO.
+ */
+static int graph_frame_process(struct audio_module_graph *graph)
+{
+	int ret;
+	int sources = 0;
+	size_t size;
+	struct audio_module_graph_node *node;
+	struct audio_module_handle *handle;
+	struct audio_module_message *msg_rx;
+	struct audio_data const *audio_data_rx;
+	struct graph_block_header *header;
+
+	for (int i = 0; i < graph->module_count; i++) {
+		node = &graph->nodes[i];
+		handle = node->handle;
+		msg_rx = NULL;
+
+		if (!state_running(handle->state)) {
+			continue;
+		}
+
+		if (node->upstream >= 0) {
+			if (!graph->nodes[node->upstream].output_valid) {
+				/* No audio data from the upstream module in this frame. */
+				continue;
+			}
+
+			audio_data_rx = &graph->nodes[node->upstream].output;
+		} else if (handle->description->type == AUDIO_MODULE_TYPE_INPUT) {
+			audio_data_rx = NULL;
+		} else {
+			/* A source module fed through audio_module_data_tx(). The scheduler does
+			 * not wait for it, so an idle producer only skips this module and its
+			 * downstream modules in this frame.
+			 */
+			ret = data_fifo_pointer_last_filled_get(handle->thread.msg_rx,
+								(void **)&msg_rx, &size, K_NO_WAIT);
+			if (ret == -ENOMSG || ret == -EAGAIN) {
+				continue;
+			} else if (ret) {
+				LOG_ERR("Module %s error in getting last filled, ret %d",
+					handle->name, ret);
+				continue;
+			}
+
+			audio_data_rx = &msg_rx->audio_data;
+			sources++;
+		}
+
+		if (has_input_type(handle->description->type)) {
+			ret = k_mem_slab_alloc(graph->parameters.data_slab, (void **)&header,
+					       K_NO_WAIT);
+			if (ret) {
+				LOG_WRN("No free data buffer for module %s, dropping frame, ret %d",
+					handle->name, ret);
+			} else {
+				atomic_set(&header->ref_count, 1);
+
+				node->output.data =
+					(uint8_t *)header + AUDIO_MODULE_GRAPH_BLOCK_HEADER_SIZE;
+				node->output.data_size = handle->thread.data_size;
+				node->output_valid = true;
+			}
+		}
+
+		if (!has_input_type(handle->description->type) || node->output_valid) {
+			if (node->upstream < 0 && msg_rx == NULL) {
+				sources++;
+			}
+
+			ret = handle->description->functions->data_process(
+				(struct audio_module_handle_private *)handle, audio_data_rx,
+				node->output_valid ? &node->output : NULL);
+			if (ret == -ENODATA) {
+				/* An input module with no audio data for this frame */
+				LOG_DBG("No audio data from module %s", handle->name);
+			} else if (ret) {
+				LOG_ERR("Data process error in module %s, ret %d", handle->name,
+					ret);
+			}
+
+			if (ret && node->output_valid) {
+				node->output_valid = false;
+				graph_block_release(graph, node->output.data);
+			}
+		}
+
+		if (msg_rx != NULL) {
+			if (msg_rx->response_cb != NULL) {
+				msg_rx->response_cb(
+					(struct audio_module_handle_private *)msg_rx->tx_handle,
+					&msg_rx->audio_data);
+			}
+
+			data_fifo_block_free(handle->thread.msg_rx, (void **)&msg_rx);
+		}
+
+		if (node->output_valid && handle->use_tx_queue && handle->thread.msg_tx != NULL) {
+			atomic_inc(&graph_block_header_get(node->output.data)->ref_count);
+
+			ret = tx_fifo_put(handle, &node->output, graph_audio_data_release_cb);
+			if (ret) {
+				LOG_ERR("Failed to send audio data on module %s TX message queue",
+					handle->name);
+				graph_block_release(graph, node->output.data);
+			}
+		}
+	}
+
+	/* All modules have consumed the frame. Audio data still on a TX FIFO keeps its block
+	 * until it is retrieved.
+	 */
+	graph_frame_release(graph);
+
+	return sources;
+}
+
+/**
+ * @brief The thread that runs all the modules of a graph.
+ *
+ * @param graph  [in/out]  Pointer to the graph.
+ */
+static void graph_thread(struct audio_module_graph *graph, void *p2, void *p3)
+{
+	__ASSERT(graph != NULL, "Graph thread has NULL graph");
+
+	while (graph->running) {
+		if (graph_frame_process(graph) == 0) {
+			/* Wait for a source module to be started or fed, a block to be freed or
+			 * the graph to be stopped.
+			 */
+			k_sem_take(&graph->wake_sem, K_FOREVER);
+		}
+	}
+}
+#endif /* CONFIG_AUDIO_MODULE_GRAPH */
+
 int audio_module_open(struct audio_module_parameters const *const parameters,
 		      struct audio_module_configuration const *const configuration,
 		      char const *const name, struct audio_module_context *context,
@@ -614,6 +991,23 @@ int audio_module_open(struct audio_module_parameters const *const parameters,
 	sys_slist_init(&handle->handle_dest_list);
 	k_mutex_init(&handle->dest_mutex);
 
+#if defined(CONFIG_AUDIO_MODULE_GRAPH)
+	if (parameters->graph != NULL) {
+		ret = graph_module_add(parameters->graph, handle);
+		if (ret) {
+			/* Clean up the handle. */
+			memset(handle, 0, sizeof(struct audio_module_handle));
+			return ret;
+		}
+
+		handle->state = AUDIO_MODULE_STATE_CONFIGURED;
+
+		LOG_DBG("Module %s added to graph", handle->name);
+
+		return 0;
+	}
+#endif /* CONFIG_AUDIO_MODULE_GRAPH */
+
 	handle->thread_id = k_thread_create(
 		&handle->thread_data, handle->thread.stack, handle->thread.stack_size, thread_entry,
 		(void *)handle, NULL, NULL, K_PRIO_PREEMPT(handle->thread.priority), 0, K_FOREVER);
@@ -651,6 +1045,13 @@ int audio_module_close(struct audio_module_handle *handle)
 		return -ECANCELED;
 	}
 
+#if defined(CONFIG_AUDIO_MODULE_GRAPH)
+	if (handle->graph != NULL && handle->graph->running) {
+		LOG_ERR("Module %s is in a running graph", handle->name);
+		return -EBUSY;
+	}
+#endif /* CONFIG_AUDIO_MODULE_GRAPH */
+
 	if (handle->description->functions->close != NULL) {
 		ret = handle->description->functions->close(
 			(struct audio_module_handle_private *)handle);
@@ -673,7 +1074,15 @@ int audio_module_close(struct audio_module_handle *handle)
 	 *       Test the semaphore and wait for it to be zero.
 	 */
 
+#if defined(CONFIG_AUDIO_MODULE_GRAPH)
+	if (handle->graph != NULL) {
+		graph_module_remove(handle);
+	} else {
+		k_thread_abort(handle->thread_id);
+	}
+#else
 	k_thread_abort(handle->thread_id);
+#endif /* CONFIG_AUDIO_MODULE_GRAPH */
 
 	LOG_DBG("Closed module %s", handle->name);
 
@@ -791,8 +1200,23 @@ int audio_module_connect(struct audio_module_handle *handle_from,
 			LOG_WRN("A module is in an invalid state for connecting");
 			return -ECANCELED;
 		}
+
+#if defined(CONFIG_AUDIO_MODULE_GRAPH)
+		if (handle_from->graph != handle_to->graph) {
+			LOG_ERR("Modules %s and %s are not in the same graph", handle_from->name,
+				handle_to->name);
+			return -EINVAL;
+		}
+#endif /* CONFIG_AUDIO_MODULE_GRAPH */
 	}
 
+#if defined(CONFIG_AUDIO_MODULE_GRAPH)
+	if (handle_from->graph != NULL && handle_from->graph->running) {
+		LOG_ERR("Module %s is in a running graph", handle_from->name);
+		return -EBUSY;
+	}
+#endif /* CONFIG_AUDIO_MODULE_GRAPH */
+
 	ret = k_mutex_lock(&handle_from->dest_mutex, LOCK_TIMEOUT_US);
 	if (ret) {
 		LOG_ERR("Failed to take MUTEX lock in time");
@@ -882,6 +1306,13 @@ int audio_module_disconnect(struct audio_module_handle *handle,
 		}
 	}
 
+#if defined(CONFIG_AUDIO_MODULE_GRAPH)
+	if (handle->graph != NULL && handle->graph->running) {
+		LOG_ERR("Module %s is in a running graph", handle->name);
+		return -EBUSY;
+	}
+#endif /* CONFIG_AUDIO_MODULE_GRAPH */
+
 	ret = k_mutex_lock(&handle->dest_mutex, LOCK_TIMEOUT_US);
 	if (ret) {
 		LOG_ERR("Failed to take MUTEX lock in time");
@@ -950,6 +1381,13 @@ int audio_module_start(struct audio_module_handle *handle)
 
 	handle->state = AUDIO_MODULE_STATE_RUNNING;
 
+#if defined(CONFIG_AUDIO_MODULE_GRAPH)
+	if (handle->graph != NULL) {
+		/* Wake the scheduler in case it was idle with no running source module. */
+		k_sem_give(&handle->graph->wake_sem);
+	}
+#endif /* CONFIG_AUDIO_MODULE_GRAPH */
+
 	return 0;
 }
 
@@ -1073,6 +1511,11 @@ int audio_module_data_rx(struct audio_module_handle *handle, struct audio_data *
 		       msg_tx->audio_data.data_size);
 	}
 
+	if (msg_tx->response_cb != NULL) {
+		msg_tx->response_cb((struct audio_module_handle_private *)msg_tx->tx_handle,
+				    &msg_tx->audio_data);
+	}
+
 	data_fifo_block_free(handle->thread.msg_tx, (void **)&msg_tx);
 
 	return ret;
@@ -1212,3 +1655,114 @@ int audio_module_number_channels_calculate(uint32_t locations, int8_t *number_ch
 
 	return 0;
 }
+
+#if defined(CONFIG_AUDIO_MODULE_GRAPH)
+int audio_module_graph_init(struct audio_module_graph *graph,
+			    struct audio_module_graph_parameters const *const parameters)
+{
+	if (graph == NULL || parameters == NULL) {
+		LOG_ERR("Parameter is NULL for graph init function");
+		return -EINVAL;
+	}
+
+	if (parameters->stack == NULL || parameters->stack_size == 0 ||
+	    parameters->data_slab == NULL) {
+		LOG_ERR("Invalid parameters for graph");
+		return -EINVAL;
+	}
+
+	memset(graph, 0, sizeof(struct audio_module_graph));
+	memcpy(&graph->parameters, parameters, sizeof(struct audio_module_graph_parameters));
+
+	k_sem_init(&graph->wake_sem, 0, 1);
+
+	return 0;
+}
+
+int audio_module_graph_start(struct audio_module_graph *graph)
+{
+	int ret;
+	size_t data_size_max;
+
+	if (graph == NULL) {
+		LOG_ERR("Graph is NULL");
+		return -EINVAL;
+	}
+
+	if (graph->parameters.data_slab == NULL) {
+		LOG_ERR("Graph has not been initialized");
+		return -ECANCELED;
+	}
+
+	if (graph->running) {
+		LOG_WRN("Graph already running");
+		return -EALREADY;
+	}
+
+	data_size_max =
+		graph->parameters.data_slab->info.block_size - AUDIO_MODULE_GRAPH_BLOCK_HEADER_SIZE;
+
+	for (int i = 0; i < graph->module_count; i++) {
+		if (graph->modules[i]->thread.data_size > data_size_max) {
+			LOG_ERR("Module %s data size %zu is larger than the graph blocks (%zu)",
+				graph->modules[i]->name, graph->modules[i]->thread.data_size,
+				data_size_max);
+			return -EINVAL;
+		}
+	}
+
+	ret = graph_order_build(graph);
+	if (ret) {
+		return ret;
+	}
+
+	graph->running = true;
+
+	graph->thread_id = k_thread_create(
+		&graph->thread_data, graph->parameters.stack, graph->parameters.stack_size,
+		(k_thread_entry_t)graph_thread, (void *)graph, NULL, NULL,
+		K_PRIO_PREEMPT(graph->parameters.priority), 0, K_FOREVER);
+
+	ret = k_thread_name_set(graph->thread_id, "audio_module_graph");
+	if (ret) {
+		LOG_DBG("Failed to name the graph thread, ret %d", ret);
+	}
+
+	k_thread_start(graph->thread_id);
+
+	LOG_DBG("Graph of %d modules started", graph->module_count);
+
+	return 0;
+}
+
+int audio_module_graph_stop(struct audio_module_graph *graph)
+{
+	int ret;
+
+	if (graph == NULL) {
+		LOG_ERR("Graph is NULL");
+		return -EINVAL;
+	}
+
+	if (!graph->running) {
+		LOG_WRN("Graph is not running");
+		return -EALREADY;
+	}
+
+	graph->running = false;
+	k_sem_give(&graph->wake_sem);
+
+	/* The scheduler does not block on the modules' audio data, so it exits once the
+	 * current frame is done.
+	 */
+	ret = k_thread_join(&graph->thread_data, K_FOREVER);
+	if (ret) {
+		LOG_ERR("Failed to join the graph scheduler thread, ret %d", ret);
+		return ret;
+	}
+
+	LOG_DBG("Graph stopped");
+
+	return 0;
+}
+#endif /* CONFIG_AUDIO_MODULE_GRAPH */
@@ -5,8 +5,12 @@
  */
 
 #include <inttypes.h>
+#include <zephyr/init.h>
 #include <zephyr/kernel.h>
 #include <zephyr/logging/log.h>
+#include <zephyr/settings/settings.h>
+#include <zephyr/sys/byteorder.h>
+#include <zephyr/bluetooth/conn.h>
 
 #include <bluetooth/gatt_dm.h>
 
@@ -18,6 +22,9 @@ LOG_MODULE_REGISTER(bt_gatt_dm, CONFIG_BT_GATT_DM_LOG_LEVEL);
 
 #define DATA_ALIGN 4U
 
+/* Length of the GATT Database Hash characteristic value */
+#define DB_HASH_LEN 16
+
 /* They are placed in data_chunk without padding, so they must be aligned */
 BUILD_ASSERT(sizeof(struct bt_gatt_service_val) % DATA_ALIGN == 0);
 BUILD_ASSERT(sizeof(struct bt_gatt_chrc) % DATA_ALIGN == 0);
@@ -71,6 +78,21 @@ struct bt_gatt_dm {
 
 	/* Indicates that services should be searched by the UUID. */
 	bool search_svc_by_uuid;
+
+#if CONFIG_BT_GATT_DM_CACHE
+	/* Settings key of the cached attributes of the current discovery */
+	char cache_key[SETTINGS_MAX_NAME_LEN + 1];
+	/* GATT Database Hash read from the peer */
+	uint8_t db_hash[DB_HASH_LEN];
+	/* Parameters used to read the GATT Database Hash */
+	struct bt_gatt_read_params hash_read_params;
+	/* Loads the cached attributes outside of the Bluetooth thread */
+	struct k_work cache_work;
+	/* The GATT Database Hash of the peer is known */
+	bool cache_enabled;
+	/* Store the discovered attributes when the discovery completes */
+	bool cache_store;
+#endif /* CONFIG_BT_GATT_DM_CACHE */
 };
 
 /* Currently only one instance is supported */
@@ -247,9 +269,297 @@ static struct bt_gatt_dm_attr *attr_find_by_handle(
 	return NULL;
 }
 
+#if CONFIG_BT_GATT_DM_CACHE
+
+/* A cache record is made of a header:
+ *
+ * | version (1) | GATT Database Hash (16) | attribute count (2) |
+ *
+ * followed by the attributes:
+ *
+ * | handle (2) | perm (1) | UUID | value |
+ *
+ * The value is the end handle (2) and the UUID of a service, the value handle (2),
+ * the properties (1) and the UUID of a characteristic, and is empty otherwise.
+ * UUIDs are stored as their type (1) followed by their value. All fields are little endian.
+ */
+#define CACHE_VERSION 1
+#define CACHE_HDR_SIZE (1 + DB_HASH_LEN + 2)
+#define CACHE_UUID_MAX_SIZE (1 + BT_UUID_SIZE_128)
+#define CACHE_ATTR_MAX_SIZE (2 + 1 + CACHE_UUID_MAX_SIZE + 2 + 1 + CACHE_UUID_MAX_SIZE)
+#define CACHE_RECORD_MAX_SIZE \
+	(CACHE_HDR_SIZE + CONFIG_BT_GATT_DM_MAX_ATTRS * CACHE_ATTR_MAX_SIZE)
+
+BUILD_ASSERT(CONFIG_BT_GATT_DM_MAX_ATTRS <= UINT16_MAX);
+
+union cache_uuid {
+	struct bt_uuid uuid;
+	struct bt_uuid_16 u16;
+	struct bt_uuid_32 u32;
+	struct bt_uuid_128 u128;
+};
+
+struct cache_reader {
+	const uint8_t *p;
+	const uint8_t *end;
+};
+
+/* Only one discovery runs at a time, so the record buffer can be shared */
+static uint8_t cache_buf[CACHE_RECORD_MAX_SIZE];
+
+static int cache_peer_key(char *key, size_t len, uint8_t id, const bt_addr_le_t *addr)
+{
+	int ret;
+
+	ret = snprintk(key, len, "bt_dm/%u/%02x%02x%02x%02x%02x%02x%u", id,
+		       addr->a.val[5], addr->a.val[4], addr->a.val[3],
+		       addr->a.val[2], addr->a.val[1], addr->a.val[0], addr->type);
+
+	return (ret < 0 || ret >= len) ? -ENOMEM : ret;
+}
+
+/* Builds the key of the discovery, which starts at the current start handle.
+ * Returns -ENOENT if the peer is not bonded, as its attributes cannot be cached then.
+ */
+static int cache_key_build(struct bt_gatt_dm *dm)
+{
+	struct bt_conn_info info;
+	char uuid_str[2 * BT_UUID_SIZE_128 + 1];
+	size_t key_len;
+	int ret;
+
+	ret = bt_conn_get_info(dm->conn, &info);
+	if (ret) {
+		return ret;
+	}
+
+	if (!bt_addr_le_is_bonded(info.id, info.le.dst)) {
+		return -ENOENT;
+	}
+
+	if (!dm->search_svc_by_uuid) {
+		strcpy(uuid_str, "any");
+	} else if (dm->svc_uuid.uuid.type == BT_UUID_TYPE_16) {
+		snprintk(uuid_str, sizeof(uuid_str), "%04x", dm->svc_uuid.u16.val);
+	} else if (dm->svc_uuid.uuid.type == BT_UUID_TYPE_32) {
+		snprintk(uuid_str, sizeof(uuid_str), "%08x", dm->svc_uuid.u32.val);
+	} else {
+		bin2hex(dm->svc_uuid.u128.val, sizeof(dm->svc_uuid.u128.val),
+			uuid_str, sizeof(uuid_str));
+	}
+
+	ret = cache_peer_key(dm->cache_key, sizeof(dm->cache_key), info.id, info.le.dst);
+	if (ret < 0) {
+		return ret;
+	}
+
+	key_len = ret;
+	ret = snprintk(&dm->cache_key[key_len], sizeof(dm->cache_key) - key_len, "/%04x/%s",
+		       dm->discover_params.start_handle, uuid_str);
+
+	return (ret < 0 || ret >= sizeof(dm->cache_key) - key_len) ? -ENOMEM : 0;
+}
+
+static uint8_t *cache_uuid_put(uint8_t *p, const struct bt_uuid *uuid)
+{
+	*p++ = uuid->type;
+
+	switch (uuid->type) {
+	case BT_UUID_TYPE_16:
+		sys_put_le16(BT_UUID_16(uuid)->val, p);
+		return p + BT_UUID_SIZE_16;
+	case BT_UUID_TYPE_32:
+		sys_put_le32(BT_UUID_32(uuid)->val, p);
+		return p + BT_UUID_SIZE_32;
+	default:
+		memcpy(p, BT_UUID_128(uuid)->val, BT_UUID_SIZE_128);
+		return p + BT_UUID_SIZE_128;
+	}
+}
+
+static const uint8_t *cache_pull(struct cache_reader *r, size_t len)
+{
+	const uint8_t *p = r->p;
+
+	if ((size_t)(r->end - r->p) < len) {
+		return NULL;
+	}
+
+	r->p += len;
+
+	return p;
+}
+
+static bool cache_uuid_pull(struct cache_reader *r, union cache_uuid *uuid)
+{
+	const uint8_t *type = cache_pull(r, 1);
+	const uint8_t *val;
+	size_t len;
+
+	if (!type) {
+		return false;
+	}
+
+	switch (*type) {
+	case BT_UUID_TYPE_16:
+		len = BT_UUID_SIZE_16;
+		break;
+	case BT_UUID_TYPE_32:
+		len = BT_UUID_SIZE_32;
+		break;
+	case BT_UUID_TYPE_128:
+		len = BT_UUID_SIZE_128;
+		break;
+	default:
+		return false;
+	}
+
+	val = cache_pull(r, len);
+
+	return val && bt_uuid_create(&uuid->uuid, val, len);
+}
+
+static void cache_save(struct bt_gatt_dm *dm)
+{
+	uint8_t *p = cache_buf;
+	int err;
+
+	if (!dm->cache_store) {
+		return;
+	}
+
+	dm->cache_store = false;
+
+	*p++ = CACHE_VERSION;
+	memcpy(p, dm->db_hash, DB_HASH_LEN);
+	p += DB_HASH_LEN;
+	sys_put_le16(dm->cur_attr_id, p);
+	p += 2;
+
+	for (size_t i = 0; i < dm->cur_attr_id; i++) {
+		const struct bt_gatt_dm_attr *attr = &dm->attrs[i];
+		const struct bt_gatt_service_val *service_val = bt_gatt_dm_attr_service_val(attr);
+		const struct bt_gatt_chrc *chrc = bt_gatt_dm_attr_chrc_val(attr);
+
+		sys_put_le16(attr->handle, p);
+		p += 2;
+		*p++ = attr->perm;
+		p = cache_uuid_put(p, attr->uuid);
+
+		if (service_val) {
+			sys_put_le16(service_val->end_handle, p);
+			p += 2;
+			p = cache_uuid_put(p, service_val->uuid);
+		} else if (chrc) {
+			sys_put_le16(chrc->value_handle, p);
+			p += 2;
+			*p++ = chrc->properties;
+			p = cache_uuid_put(p, chrc->uuid);
+		}
+	}
+
+	err = settings_save_one(dm->cache_key, cache_buf, p - cache_buf);
+	if (err) {
+		LOG_WRN("Failed to store attributes in the cache, error: %d.", err);
+	} else {
+		LOG_DBG("Stored %zu attributes in the cache", dm->cur_attr_id);
+	}
+}
+
+/* Stores the attributes of a cache record, as the discovery would have. */
+static int cache_replay(struct bt_gatt_dm *dm, const uint8_t *rec, size_t len)
+{
+	struct cache_reader r = {
+		.p = rec + CACHE_HDR_SIZE,
+		.end = rec + len,
+	};
+	size_t attr_cnt;
+
+	if (len < CACHE_HDR_SIZE || rec[0] != CACHE_VERSION) {
+		return -EINVAL;
+	}
+
+	if (memcmp(&rec[1], dm->db_hash, DB_HASH_LEN)) {
+		LOG_DBG("GATT Database Hash changed");
+		return -ESTALE;
+	}
+
+	attr_cnt = sys_get_le16(&rec[1 + DB_HASH_LEN]);
+
+	for (size_t i = 0; i < attr_cnt; i++) {
+		union cache_uuid uuid;
+		union cache_uuid val_uuid;
+		struct bt_gatt_attr attr = {
+			.uuid = &uuid.uuid,
+		};
+		struct bt_gatt_dm_attr *cur_attr;
+		struct bt_gatt_service_val *service_val;
+		struct bt_gatt_chrc *chrc;
+		const uint8_t *p;
+
+		p = cache_pull(&r, 3);
+		if (!p || !cache_uuid_pull(&r, &uuid)) {
+			return -EINVAL;
+		}
+
+		attr.handle = sys_get_le16(p);
+		attr.perm = p[2];
+
+		if (!bt_uuid_cmp(attr.uuid, BT_UUID_GATT_PRIMARY) ||
+		    !bt_uuid_cmp(attr.uuid, BT_UUID_GATT_SECONDARY)) {
+			p = cache_pull(&r, 2);
+			if (!p || !cache_uuid_pull(&r, &val_uuid)) {
+				return -EINVAL;
+			}
+
+			cur_attr = attr_store(dm, &attr, sizeof(*service_val));
+			if (!cur_attr) {
+				return -ENOMEM;
+			}
+
+			service_val = bt_gatt_dm_attr_service_val(cur_attr);
+			service_val->end_handle = sys_get_le16(p);
+			service_val->uuid = uuid_store(dm, &val_uuid.uuid);
+			if (!service_val->uuid) {
+				return -ENOMEM;
+			}
+		} else if (i == 0) {
+			/* The first attribute is always the service */
+			return -EINVAL;
+		} else if (!bt_uuid_cmp(attr.uuid, BT_UUID_GATT_CHRC)) {
+			p = cache_pull(&r, 3);
+			if (!p || !cache_uuid_pull(&r, &val_uuid)) {
+				return -EINVAL;
+			}
+
+			cur_attr = attr_store(dm, &attr, sizeof(*chrc));
+			if (!cur_attr) {
+				return -ENOMEM;
+			}
+
+			chrc = bt_gatt_dm_attr_chrc_val(cur_attr);
+			chrc->value_handle = sys_get_le16(p);
+			chrc->properties = p[2];
+			chrc->uuid = uuid_store(dm, &val_uuid.uuid);
+			if (!chrc->uuid) {
+				return -ENOMEM;
+			}
+		} else if (!attr_store(dm, &attr, 0)) {
+			return -ENOMEM;
+		}
+	}
+
+	return (r.p == r.end) ? 0 : -EINVAL;
+}
+
+#endif /* CONFIG_BT_GATT_DM_CACHE */
+
 static void discovery_complete(struct bt_gatt_dm *dm)
 {
 	LOG_DBG("Discovery complete.");
+#if CONFIG_BT_GATT_DM_CACHE
+	cache_save(dm);
+#endif /* CONFIG_BT_GATT_DM_CACHE */
 	atomic_set_bit(dm->state_flags, STATE_ATTRS_RELEASE_PENDING);
 	if (dm->callback->completed) {
 		dm->callback->completed(dm, dm->context);
@@ -260,6 +570,10 @@ static void discovery_complete_not_found(struct bt_gatt_dm *dm)
 {
 	LOG_DBG("Discover complete. No service found.");
 
+#if CONFIG_BT_GATT_DM_CACHE
+	/* Not finding the service is cached as well */
+	cache_save(dm);
+#endif /* CONFIG_BT_GATT_DM_CACHE */
 	svc_attr_memory_release(dm);
 	atomic_clear_bit(dm->state_flags, STATE_ATTRS_LOCKED);
 
@@ -277,6 +591,214 @@ static void discovery_complete_error(struct bt_gatt_dm *dm, int err)
 	}
 }
 
+#if CONFIG_BT_GATT_DM_CACHE
+
+struct cache_delete_ctx {
+	const char *subtree;
+	size_t cnt;
+	char keys[4][SETTINGS_MAX_NAME_LEN + 1];
+};
+
+static int cache_load_cb(const char *key, size_t len, settings_read_cb read_cb,
+			 void *cb_arg, void *param)
+{
+	size_t *rec_len = param;
+	ssize_t ret;
+
+	/* Only the exact key, not the ones below it */
+	if (key || len > sizeof(cache_buf)) {
+		return 0;
+	}
+
+	ret = read_cb(cb_arg, cache_buf, len);
+	if (ret < 0) {
+		return ret;
+	}
+
+	*rec_len = ret;
+
+	return 0;
+}
+
+static void cache_work_handler(struct k_work *work)
+{
+	struct bt_gatt_dm *dm = CONTAINER_OF(work, struct bt_gatt_dm, cache_work);
+	size_t rec_len = 0;
+	int err;
+
+	err = settings_load_subtree_direct(dm->cache_key, cache_load_cb, &rec_len);
+	if (!err && rec_len) {
+		err = cache_replay(dm, cache_buf, rec_len);
+		if (!err) {
+			LOG_DBG("Attributes loaded from the cache");
+
+			if (!dm->cur_attr_id) {
+				discovery_complete_not_found(dm);
+				return;
+			}
+
+			/* Allow to continue the discovery after the service */
+			dm->discover_params.uuid = NULL;
+			dm->discover_params.end_handle =
+				bt_gatt_dm_attr_service_val(&dm->attrs[0])->end_handle;
+			discovery_complete(dm);
+			return;
+		}
+
+		LOG_DBG("Cached attributes not used, error: %d.", err);
+		svc_attr_memory_release(dm);
+	}
+
+	dm->cache_store = true;
+
+	err = bt_gatt_discover(dm->conn, &dm->discover_params);
+	if (err) {
+		LOG_ERR("Discover failed, error: %d.", err);
+		discovery_complete_error(dm, err);
+	}
+}
+
+static uint8_t db_hash_read_cb(struct bt_conn *conn, uint8_t att_err,
+			       struct bt_gatt_read_params *params,
+			       const void *data, uint16_t length)
+{
+	struct bt_gatt_dm *dm = CONTAINER_OF(params, struct bt_gatt_dm, hash_read_params);
+	int err;
+
+	if (!att_err && data && length == DB_HASH_LEN) {
+		memcpy(dm->db_hash, data, DB_HASH_LEN);
+		dm->cache_enabled = true;
+		k_work_submit(&dm->cache_work);
+		return BT_GATT_ITER_STOP;
+	}
+
+	/* The peer does not support GATT caching, discover without the cache */
+	LOG_DBG("GATT Database Hash not available, ATT error: 0x%02x.", att_err);
+
+	err = bt_gatt_discover(conn, &dm->discover_params);
+	if (err) {
+		LOG_ERR("Discover failed, error: %d.", err);
+		discovery_complete_error(dm, err);
+	}
+
+	return BT_GATT_ITER_STOP;
+}
+
+/* Returns 0 if the discovery continues with the cache. */
+static int cache_discover_start(struct bt_gatt_dm *dm)
+{
+	int err;
+
+	dm->cache_enabled = false;
+	dm->cache_store = false;
+
+	err = cache_key_build(dm);
+	if (err) {
+		return err;
+	}
+
+	dm->hash_read_params.func = db_hash_read_cb;
+	dm->hash_read_params.handle_count = 0;
+	dm->hash_read_params.by_uuid.start_handle = 0x0001;
+	dm->hash_read_params.by_uuid.end_handle = 0xffff;
+	dm->hash_read_params.by_uuid.uuid = BT_UUID_GATT_DB_HASH;
+
+	err = bt_gatt_read(dm->conn, &dm->hash_read_params);
+	if (err) {
+		LOG_WRN("GATT Database Hash read failed, error: %d.", err);
+	}
+
+	return err;
+}
+
+/* Returns 0 if the discovery continues with the cache. */
+static int cache_discover_continue(struct bt_gatt_dm *dm)
+{
+	int err;
+
+	dm->cache_store = false;
+
+	if (!dm->cache_enabled) {
+		return -ENOENT;
+	}
+
+	/* The GATT Database Hash read when the discovery started is still valid */
+	err = cache_key_build(dm);
+	if (err) {
+		return err;
+	}
+
+	k_work_submit(&dm->cache_work);
+
+	return 0;
+}
+
+static int cache_delete_cb(const char *key, size_t len, settings_read_cb read_cb,
+			   void *cb_arg, void *param)
+{
+	struct cache_delete_ctx *ctx = param;
+	int ret;
+
+	/* Deleted entries may still be reported with no value */
+	if (!key || !len || ctx->cnt >= ARRAY_SIZE(ctx->keys)) {
+		return 0;
+	}
+
+	ret = snprintk(ctx->keys[ctx->cnt], sizeof(ctx->keys[0]), "%s/%s", ctx->subtree, key);
+	if (ret > 0 && ret < sizeof(ctx->keys[0])) {
+		ctx->cnt++;
+	}
+
+	return 0;
+}
+
+static void cache_bond_deleted(uint8_t id, const bt_addr_le_t *peer)
+{
+	static struct cache_delete_ctx ctx;
+	char subtree[SETTINGS_MAX_NAME_LEN + 1];
+	int err;
+
+	if (cache_peer_key(subtree, sizeof(subtree), id, peer) < 0) {
+		return;
+	}
+
+	ctx.subtree = subtree;
+
+	/* Collect the keys first, as they cannot be deleted while they are being loaded */
+	do {
+		ctx.cnt = 0;
+
+		err = settings_load_subtree_direct(subtree, cache_delete_cb, &ctx);
+		if (err) {
+			LOG_WRN("Failed to load the cache of the peer, error: %d.", err);
+			return;
+		}
+
+		for (size_t i = 0; i < ctx.cnt; i++) {
+			err = settings_delete(ctx.keys[i]);
+			if (err) {
+				LOG_WRN("Failed to delete %s, error: %d.", ctx.keys[i], err);
+				return;
+			}
+		}
+	} while (ctx.cnt == ARRAY_SIZE(ctx.keys));
+}
+
+static struct bt_conn_auth_info_cb cache_auth_info_cb = {
+	.bond_deleted = cache_bond_deleted,
+};
+
+static int cache_init(void)
+{
+	k_work_init(&bt_gatt_dm_inst.cache_work, cache_work_handler);
+
+	return bt_conn_auth_info_cb_register(&cache_auth_info_cb);
+}
+
+SYS_INIT(cache_init, APPLICATION, CONFIG_APPLICATION_INIT_PRIORITY);
+
+#endif /* CONFIG_BT_GATT_DM_CACHE */
+
 static uint8_t discovery_process_service(struct bt_gatt_dm *dm,
 				      const struct bt_gatt_attr *attr,
 				      struct bt_gatt_discover_params *params)
@@ -646,6 +1168,12 @@ int bt_gatt_dm_start(struct bt_conn *conn,
 	dm->discover_params.end_handle = 0xffff;
 	dm->discover_params.type = BT_GATT_DISCOVER_PRIMARY;
 
+#if CONFIG_BT_GATT_DM_CACHE
+	if (!cache_discover_start(dm)) {
+		return 0;
+	}
+#endif /* CONFIG_BT_GATT_DM_CACHE */
+
 	err = bt_gatt_discover(conn, &dm->discover_params);
 	if (err) {
 		LOG_ERR("Discover failed, error: %d.", err);
@@ -689,6 +1217,12 @@ int bt_gatt_dm_continue(struct bt_gatt_dm *dm, void *context)
 	dm->discover_params.type = BT_GATT_DISCOVER_PRIMARY;
 	dm->discover_params.uuid = dm->search_svc_by_uuid ? &dm->svc_uuid.uuid : NULL;
 
+#if CONFIG_BT_GATT_DM_CACHE
+	if (!cache_discover_continue(dm)) {
+		return 0;
+	}
+#endif /* CONFIG_BT_GATT_DM_CACHE */
+
 	err = bt_gatt_discover(dm->conn, &dm->discover_params);
 	if (err) {
 		LOG_ERR("Discover failed, error: %d.", err);
@@ -403,19 +403,12 @@ int sensor_column_encode(struct net_buf_simple *buf,
 	return sensor_column_value_encode(buf, srv, sensor, ctx, col_index);
 }
 
-int sensor_column_decode(
-	struct net_buf_simple *buf, const struct bt_mesh_sensor_type *type,
-	struct bt_mesh_sensor_column *col,
-	sensor_value_type value[CONFIG_BT_MESH_SENSOR_CHANNELS_MAX])
+static int column_decode(struct net_buf_simple *buf,
+			 const struct bt_mesh_sensor_format *col_format,
+			 struct bt_mesh_sensor_column *col)
 {
-	const struct bt_mesh_sensor_format *col_format;
 	int err;
 
-	col_format = bt_mesh_sensor_column_format_get(type);
-	if (!col_format) {
-		return -ENOTSUP;
-	}
-
 	err = sensor_ch_decode(buf, col_format, &col->start);
 	if (err) {
 		return err;
@@ -447,6 +440,27 @@ int sensor_column_decode(
 	}
 #endif
 
+	return 0;
+}
+
+int sensor_column_decode(
+	struct net_buf_simple *buf, const struct bt_mesh_sensor_type *type,
+	struct bt_mesh_sensor_column *col,
+	sensor_value_type value[CONFIG_BT_MESH_SENSOR_CHANNELS_MAX])
+{
+	const struct bt_mesh_sensor_format *col_format;
+	int err;
+
+	col_format = bt_mesh_sensor_column_format_get(type);
+	if (!col_format) {
+		return -ENOTSUP;
+	}
+
+	err = column_decode(buf, col_format, col);
+	if (err) {
+		return err;
+	}
+
 	return sensor_value_decode(buf, type, value);
 }
 
@@ -461,6 +475,72 @@ uint8_t sensor_value_len(const struct bt_mesh_sensor_type *type)
 	return sum;
 }
 
+void sensor_codec_init(struct sensor_codec *codec,
+		       const struct bt_mesh_sensor_type *type)
+{
+	codec->type = type;
+	codec->col_format = bt_mesh_sensor_column_format_get(type);
+	codec->value_len = sensor_value_len(type);
+	codec->entry_len = codec->value_len;
+
+	if (codec->col_format) {
+		codec->entry_len += 2 * codec->col_format->size;
+	}
+}
+
+int sensor_codec_value_decode(const struct sensor_codec *codec,
+			      struct net_buf_simple *buf,
+			      sensor_value_type *values)
+{
+	const struct bt_mesh_sensor_type *type = codec->type;
+
+	__ASSERT_NO_MSG(type->channel_count <= CONFIG_BT_MESH_SENSOR_CHANNELS_MAX);
+
+	if (buf->len < codec->value_len) {
+		return -EMSGSIZE;
+	}
+
+#ifdef CONFIG_BT_MESH_SENSOR_USE_LEGACY_SENSOR_VALUE
+	return sensor_value_decode(buf, type, values);
+#else
+	/* All channels are raw values, so the whole value can be pulled at
+	 * once and split between the channels.
+	 */
+	const uint8_t *raw = net_buf_simple_pull_mem(buf, codec->value_len);
+
+	for (uint32_t i = 0; i < type->channel_count; ++i) {
+		const struct bt_mesh_sensor_format *format =
+			type->channels[i].format;
+
+		values[i].format = format;
+		memcpy(values[i].raw, raw, format->size);
+		raw += format->size;
+	}
+
+	return 0;
+#endif
+}
+
+int sensor_codec_entry_decode(const struct sensor_codec *codec,
+			      struct net_buf_simple *buf,
+			      struct bt_mesh_sensor_series_entry *entry)
+{
+	int err;
+
+	if (!codec->col_format) {
+		/* Indexed column, decode only value */
+		memset(entry, 0, sizeof(*entry));
+		return sensor_codec_value_decode(codec, buf, entry->value);
+	}
+
+	err = column_decode(buf, codec->col_format, &entry->column);
+	if (err) {
+		return err;
+	}
+
+	return sensor_codec_value_decode(codec, buf, entry->value);
+}
+
 /* Several timer values in sensors are encoded in the following scheme:
  *
  *     time = pow(1.1 seconds, encoded - 64)
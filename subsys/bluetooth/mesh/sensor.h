@@ -227,6 +227,28 @@ int sensor_cadence_decode(struct net_buf_simple *buf,
 			  struct bt_mesh_sensor_threshold *threshold);
 uint8_t sensor_value_len(const struct bt_mesh_sensor_type *type);
 
+/** Sensor type formats, resolved once for decoding several values of the
+ *  same sensor type, like the entries of a series.
+ */
+struct sensor_codec {
+	const struct bt_mesh_sensor_type *type;
+	/** Format of the column, or NULL if the type has no columns. */
+	const struct bt_mesh_sensor_format *col_format;
+	/** Encoded length of a sensor value. */
+	uint8_t value_len;
+	/** Encoded length of a series entry, including the column. */
+	uint8_t entry_len;
+};
+
+void sensor_codec_init(struct sensor_codec *codec,
+		       const struct bt_mesh_sensor_type *type);
+int sensor_codec_value_decode(const struct sensor_codec *codec,
+			      struct net_buf_simple *buf,
+			      sensor_value_type *values);
+int sensor_codec_entry_decode(const struct sensor_codec *codec,
+			      struct net_buf_simple *buf,
+			      struct bt_mesh_sensor_series_entry *entry);
+
 uint8_t sensor_powtime_encode(uint64_t raw);
 uint64_t sensor_powtime_decode(uint8_t encoded);
 uint64_t sensor_powtime_decode_us(uint8_t val);
@@ -148,17 +148,19 @@ static int handle_status(const struct bt_mesh_model *model, struct bt_mesh_msg_c
 			continue;
 		}
 
-		uint8_t expected_len = sensor_value_len(type);
+		struct sensor_codec codec;
 
-		if (length != expected_len) {
+		sensor_codec_init(&codec, type);
+
+		if (length != codec.value_len) {
 			LOG_WRN("Invalid length for 0x%04x: %u (expected %u)",
-				id, length, expected_len);
+				id, length, codec.value_len);
 			return -EMSGSIZE;
 		}
 
 		sensor_value_type value[CONFIG_BT_MESH_SENSOR_CHANNELS_MAX];
 
-		err = sensor_value_decode(buf, type, value);
+		err = sensor_codec_value_decode(&codec, buf, value);
 		if (err) {
 			LOG_ERR("Invalid format, err=%d", err);
 			return err; /* Invalid format, should ignore message */
@@ -185,20 +187,6 @@ static int handle_status(const struct bt_mesh_model *model, struct bt_mesh_msg_c
 	return 0;
 }
 
-static int parse_series_entry(const struct bt_mesh_sensor_type *type,
-			      const struct bt_mesh_sensor_format *col_format,
-			      struct net_buf_simple *buf,
-			      struct bt_mesh_sensor_series_entry *entry)
-{
-	if (col_format == NULL) {
-		// Indexed column, decode only value
-		memset(entry, 0, sizeof(struct bt_mesh_sensor_series_entry));
-		return sensor_value_decode(buf, type, entry->value);
-	}
-
-	return sensor_column_decode(buf, type, &entry->column, entry->value);
-}
-
 static int handle_column_status(const struct bt_mesh_model *model, struct bt_mesh_msg_ctx *ctx,
 				struct net_buf_simple *buf)
 {
@@ -206,6 +194,7 @@ static int handle_column_status(const struct bt_mesh_model *model, struct bt_mes
 	struct series_data_rsp *rsp;
 	const struct bt_mesh_sensor_format *col_format;
 	const struct bt_mesh_sensor_type *type;
+	struct sensor_codec codec;
 	int err;
 
 	uint16_t id = net_buf_simple_pull_le16(buf);
@@ -218,9 +207,10 @@ static int handle_column_status(const struct bt_mesh_model *model, struct bt_mes
 
 	struct bt_mesh_sensor_series_entry entry;
 
-	col_format = bt_mesh_sensor_column_format_get(type);
+	sensor_codec_init(&codec, type);
+	col_format = codec.col_format;
 
-	err = parse_series_entry(type, col_format, buf, &entry);
+	err = sensor_codec_entry_decode(&codec, buf, &entry);
 	if (err == -ENOENT) {
 		/* The entry doesn't exist */
 		goto yield_ack;
@@ -264,9 +254,9 @@ static int handle_series_status(const struct bt_mesh_model *model, struct bt_mes
 				struct net_buf_simple *buf)
 {
 	struct bt_mesh_sensor_cli *cli = model->rt->user_data;
-	const struct bt_mesh_sensor_format *col_format;
 	const struct bt_mesh_sensor_type *type;
 	struct series_data_rsp *rsp = NULL;
+	struct sensor_codec codec;
 
 	uint16_t id = net_buf_simple_pull_le16(buf);
 
@@ -283,24 +273,19 @@ static int handle_series_status(const struct bt_mesh_model *model, struct bt_mes
 		}
 	}
 
-	size_t val_len = sensor_value_len(type);
-
-	col_format = bt_mesh_sensor_column_format_get(type);
-	if (col_format != NULL) {
-		val_len += (col_format->size * 2);
-	}
-
-	if (!val_len) {
+	/* The formats are the same for all entries in the series */
+	sensor_codec_init(&codec, type);
+	if (!codec.entry_len) {
 		return -ENOTSUP;
 	}
 
-	uint8_t count = buf->len / val_len;
+	uint8_t count = buf->len / codec.entry_len;
 
 	for (uint8_t i = 0; i < count; i++) {
 		struct bt_mesh_sensor_series_entry entry;
 		int err;
 
-		err = parse_series_entry(type, col_format, buf, &entry);
+		err = sensor_codec_entry_decode(&codec, buf, &entry);
 		if (err) {
 			LOG_ERR("Failed parsing column %u (err: %d)", i, err);
 			return err;
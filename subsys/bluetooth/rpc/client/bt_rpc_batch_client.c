@@ -0,0 +1,146 @@
+/*
+ * Copyright (c) 2024 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+/* Client side batching of fire-and-forget calls.
+ */
+
+#include <zephyr/kernel.h>
+
+#include <bt_rpc.h>
+
+#include "bt_rpc_common.h"
+#include "bt_rpc_batch.h"
+#include "serialize.h"
+#include <nrf_rpc_cbor.h>
+
+#include <zephyr/logging/log.h>
+
+LOG_MODULE_DECLARE(BT_RPC, CONFIG_BT_RPC_LOG_LEVEL);
+
+/* Maximum encoded size of the number of calls and of the byte string header. */
+#define BATCH_HEADER_SIZE_MAX 6
+
+/* Maximum encoded size of the command ID in front of each call. */
+#define CALL_HEADER_SIZE_MAX 2
+
+struct bt_rpc_batch_rpc_res {
+	uint32_t failed;
+	int32_t err;
+};
+
+static uint8_t batch_buf[CONFIG_BT_RPC_BATCH_BUF_SIZE];
+static size_t batch_len;
+static uint8_t batch_cnt;
+
+static K_MUTEX_DEFINE(batch_mutex);
+
+static void batch_flush_work_handler(struct k_work *work);
+
+static K_WORK_DELAYABLE_DEFINE(batch_flush_work, batch_flush_work_handler);
+
+static void bt_rpc_batch_rpc_rsp(const struct nrf_rpc_group *group,
+				 struct nrf_rpc_cbor_ctx *ctx, void *handler_data)
+{
+	struct bt_rpc_batch_rpc_res *res = (struct bt_rpc_batch_rpc_res *)handler_data;
+
+	res->failed = ser_decode_uint(ctx);
+	res->err = ser_decode_int(ctx);
+}
+
+/* Must be called with the batch mutex locked. */
+static int batch_send(void)
+{
+	struct nrf_rpc_cbor_ctx ctx;
+	struct bt_rpc_batch_rpc_res result;
+	uint8_t cnt = batch_cnt;
+
+	if (cnt == 0) {
+		return 0;
+	}
+
+	(void)k_work_cancel_delayable(&batch_flush_work);
+
+	NRF_RPC_CBOR_ALLOC(&bt_rpc_grp, ctx, BATCH_HEADER_SIZE_MAX + batch_len);
+	ser_encode_uint(&ctx, cnt);
+	ser_encode_buffer(&ctx, batch_buf, batch_len);
+
+	batch_len = 0;
+	batch_cnt = 0;
+
+	nrf_rpc_cbor_cmd_no_err(&bt_rpc_grp, BT_RPC_BATCH_RPC_CMD,
+				&ctx, bt_rpc_batch_rpc_rsp, &result);
+
+	if (result.failed) {
+		LOG_WRN("%u of %u batched calls failed, first error: %d",
+			result.failed, cnt, result.err);
+	}
+
+	return result.err;
+}
+
+static void batch_flush_work_handler(struct k_work *work)
+{
+	(void)bt_rpc_batch_flush();
+}
+
+int bt_rpc_batch_flush(void)
+{
+	int err;
+
+	k_mutex_lock(&batch_mutex, K_FOREVER);
+	err = batch_send();
+	k_mutex_unlock(&batch_mutex);
+
+	return err;
+}
+
+int bt_rpc_batch_alloc(struct nrf_rpc_cbor_ctx *ctx, uint8_t cmd, size_t len)
+{
+	len += CALL_HEADER_SIZE_MAX;
+
+	if (len > sizeof(batch_buf)) {
+		/* The call is sent on its own, so the queued calls must be sent before it */
+		(void)bt_rpc_batch_flush();
+		return -ENOMEM;
+	}
+
+	k_mutex_lock(&batch_mutex, K_FOREVER);
+
+	if (batch_len + len > sizeof(batch_buf)) {
+		(void)batch_send();
+	}
+
+	zcbor_new_encode_state(ctx->zs, ARRAY_SIZE(ctx->zs), &batch_buf[batch_len],
+			       sizeof(batch_buf) - batch_len, 0);
+	ser_encode_uint(ctx, cmd);
+
+	return 0;
+}
+
+int bt_rpc_batch_commit(struct nrf_rpc_cbor_ctx *ctx)
+{
+	int err = 0;
+
+	if (!zcbor_check_error(ctx->zs)) {
+		LOG_ERR("Failed to encode the batched call");
+		err = -EINVAL;
+		goto unlock;
+	}
+
+	batch_len = ctx->zs->payload_mut - batch_buf;
+	batch_cnt++;
+
+	if (batch_cnt >= CONFIG_BT_RPC_BATCH_MAX_CALLS) {
+		(void)batch_send();
+	} else if (batch_cnt == 1) {
+		(void)k_work_schedule(&batch_flush_work, K_MSEC(CONFIG_BT_RPC_BATCH_TIMEOUT_MS));
+	}
+
+unlock:
+	k_mutex_unlock(&batch_mutex);
+
+	return err;
+}
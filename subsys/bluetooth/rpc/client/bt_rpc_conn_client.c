@@ -8,6 +8,8 @@
 #include <zephyr/bluetooth/bluetooth.h>
 #include <zephyr/bluetooth/conn.h>
 
+#include <bt_rpc.h>
+
 #include "bt_rpc_common.h"
 #include "serialize.h"
 #include "cbkproxy.h"
@@ -508,6 +510,10 @@ int bt_conn_disconnect(struct bt_conn *conn, uint8_t reason)
 	int result;
 	size_t buffer_size_max = 5;
 
+	if (IS_ENABLED(CONFIG_BT_RPC_BATCH)) {
+		(void)bt_rpc_batch_flush();
+	}
+
 	NRF_RPC_CBOR_ALLOC(&bt_rpc_grp, ctx, buffer_size_max);
 
 	bt_rpc_encode_bt_conn(&ctx, conn);
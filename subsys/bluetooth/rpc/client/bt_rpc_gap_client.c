@@ -11,10 +11,13 @@
 
 #include <zephyr/settings/settings.h>
 
+#include <bt_rpc.h>
+
 
 #include "bt_rpc_gatt_client.h"
 #include "bt_rpc_conn_client.h"
 #include "bt_rpc_common.h"
+#include "bt_rpc_batch.h"
 #include "serialize.h"
 #include "cbkproxy.h"
 #include <nrf_rpc_cbor.h>
@@ -159,6 +162,10 @@ int bt_disable(void)
 	size_t buffer_size_max = 0;
 	int result;
 
+	if (IS_ENABLED(CONFIG_BT_RPC_BATCH)) {
+		(void)bt_rpc_batch_flush();
+	}
+
 	NRF_RPC_CBOR_ALLOC(&bt_rpc_grp, ctx, buffer_size_max);
 
 	nrf_rpc_cbor_cmd_no_err(&bt_rpc_grp, BT_DISABLE_RPC_CMD, &ctx, ser_rsp_decode_i32, &result);
@@ -478,6 +485,23 @@ void bt_data_enc(struct nrf_rpc_cbor_ctx *encoder, const struct bt_data *data)
 	ser_encode_buffer(encoder, data->data, sizeof(uint8_t) * data->data_len);
 }
 
+static void bt_data_lists_enc(struct nrf_rpc_cbor_ctx *encoder,
+			      const struct bt_data *ad, size_t ad_len,
+			      const struct bt_data *sd, size_t sd_len)
+{
+	ser_encode_uint(encoder, ad_len);
+
+	for (size_t i = 0; i < ad_len; i++) {
+		bt_data_enc(encoder, &ad[i]);
+	}
+
+	ser_encode_uint(encoder, sd_len);
+
+	for (size_t i = 0; i < sd_len; i++) {
+		bt_data_enc(encoder, &sd[i]);
+	}
+}
+
 void bt_le_scan_param_enc(struct nrf_rpc_cbor_ctx *encoder, const struct bt_le_scan_param *data)
 {
 	ser_encode_uint(encoder, data->type);
@@ -589,6 +613,10 @@ int bt_le_adv_start(const struct bt_le_adv_param *param,
 
 	scratchpad_size += bt_le_adv_param_sp_size(param);
 
+	if (IS_ENABLED(CONFIG_BT_RPC_BATCH)) {
+		(void)bt_rpc_batch_flush();
+	}
+
 	NRF_RPC_CBOR_ALLOC(&bt_rpc_grp, ctx, buffer_size_max);
 	ser_encode_uint(&ctx, scratchpad_size);
 
@@ -631,19 +659,18 @@ int bt_le_adv_update_data(const struct bt_data *ad, size_t ad_len,
 		scratchpad_size += bt_data_sp_size(&sd[i]);
 	}
 
-	NRF_RPC_CBOR_ALLOC(&bt_rpc_grp, ctx, buffer_size_max);
-	ser_encode_uint(&ctx, scratchpad_size);
-	ser_encode_uint(&ctx, ad_len);
+#if defined(CONFIG_BT_RPC_BATCH)
+	if (!bt_rpc_batch_alloc(&ctx, BT_LE_ADV_UPDATE_DATA_RPC_CMD, buffer_size_max)) {
+		ser_encode_uint(&ctx, scratchpad_size);
+		bt_data_lists_enc(&ctx, ad, ad_len, sd, sd_len);
 
-	for (size_t i = 0; i < ad_len; i++) {
-		bt_data_enc(&ctx, &ad[i]);
+		return bt_rpc_batch_commit(&ctx);
 	}
+#endif /* defined(CONFIG_BT_RPC_BATCH) */
 
-	ser_encode_uint(&ctx, sd_len);
-
-	for (size_t i = 0; i < sd_len; i++) {
-		bt_data_enc(&ctx, &sd[i]);
-	}
+	NRF_RPC_CBOR_ALLOC(&bt_rpc_grp, ctx, buffer_size_max);
+	ser_encode_uint(&ctx, scratchpad_size);
+	bt_data_lists_enc(&ctx, ad, ad_len, sd, sd_len);
 
 	nrf_rpc_cbor_cmd_no_err(&bt_rpc_grp, BT_LE_ADV_UPDATE_DATA_RPC_CMD,
 				&ctx, ser_rsp_decode_i32, &result);
@@ -657,6 +684,10 @@ int bt_le_adv_stop(void)
 	int result;
 	size_t buffer_size_max = 0;
 
+	if (IS_ENABLED(CONFIG_BT_RPC_BATCH)) {
+		(void)bt_rpc_batch_flush();
+	}
+
 	NRF_RPC_CBOR_ALLOC(&bt_rpc_grp, ctx, buffer_size_max);
 
 	nrf_rpc_cbor_cmd_no_err(&bt_rpc_grp, BT_LE_ADV_STOP_RPC_CMD,
@@ -856,6 +887,10 @@ int bt_le_ext_adv_start(struct bt_le_ext_adv *adv,
 	int result;
 	size_t buffer_size_max = 10;
 
+	if (IS_ENABLED(CONFIG_BT_RPC_BATCH)) {
+		(void)bt_rpc_batch_flush();
+	}
+
 	NRF_RPC_CBOR_ALLOC(&bt_rpc_grp, ctx, buffer_size_max);
 
 	ser_encode_uint(&ctx, (uintptr_t)adv);
@@ -874,6 +909,10 @@ int bt_le_ext_adv_stop(struct bt_le_ext_adv *adv)
 	int result;
 	size_t buffer_size_max = 5;
 
+	if (IS_ENABLED(CONFIG_BT_RPC_BATCH)) {
+		(void)bt_rpc_batch_flush();
+	}
+
 	NRF_RPC_CBOR_ALLOC(&bt_rpc_grp, ctx, buffer_size_max);
 
 	ser_encode_uint(&ctx, (uintptr_t)adv);
@@ -905,21 +944,21 @@ int bt_le_ext_adv_set_data(struct bt_le_ext_adv *adv,
 		scratchpad_size += bt_data_sp_size(&sd[i]);
 	}
 
-	NRF_RPC_CBOR_ALLOC(&bt_rpc_grp, ctx, buffer_size_max);
-	ser_encode_uint(&ctx, scratchpad_size);
-
-	ser_encode_uint(&ctx, (uintptr_t)adv);
-	ser_encode_uint(&ctx, ad_len);
+#if defined(CONFIG_BT_RPC_BATCH)
+	if (!bt_rpc_batch_alloc(&ctx, BT_LE_EXT_ADV_SET_DATA_RPC_CMD, buffer_size_max)) {
+		ser_encode_uint(&ctx, scratchpad_size);
+		ser_encode_uint(&ctx, (uintptr_t)adv);
+		bt_data_lists_enc(&ctx, ad, ad_len, sd, sd_len);
 
-	for (size_t i = 0; i < ad_len; i++) {
-		bt_data_enc(&ctx, &ad[i]);
+		return bt_rpc_batch_commit(&ctx);
 	}
+#endif /* defined(CONFIG_BT_RPC_BATCH) */
 
-	ser_encode_uint(&ctx, sd_len);
+	NRF_RPC_CBOR_ALLOC(&bt_rpc_grp, ctx, buffer_size_max);
+	ser_encode_uint(&ctx, scratchpad_size);
 
-	for (size_t i = 0; i < sd_len; i++) {
-		bt_data_enc(&ctx, &sd[i]);
-	}
+	ser_encode_uint(&ctx, (uintptr_t)adv);
+	bt_data_lists_enc(&ctx, ad, ad_len, sd, sd_len);
 
 	nrf_rpc_cbor_cmd_no_err(&bt_rpc_grp, BT_LE_EXT_ADV_SET_DATA_RPC_CMD,
 				&ctx, ser_rsp_decode_i32, &result);
@@ -939,6 +978,10 @@ int bt_le_ext_adv_update_param(struct bt_le_ext_adv *adv,
 
 	scratchpad_size += bt_le_adv_param_sp_size(param);
 
+	if (IS_ENABLED(CONFIG_BT_RPC_BATCH)) {
+		(void)bt_rpc_batch_flush();
+	}
+
 	NRF_RPC_CBOR_ALLOC(&bt_rpc_grp, ctx, buffer_size_max);
 	ser_encode_uint(&ctx, scratchpad_size);
 
@@ -957,6 +1000,11 @@ int bt_le_ext_adv_delete(struct bt_le_ext_adv *adv)
 	int result;
 	size_t buffer_size_max = 5;
 
+	/* Queued data updates of the set must reach the host before it is deleted */
+	if (IS_ENABLED(CONFIG_BT_RPC_BATCH)) {
+		(void)bt_rpc_batch_flush();
+	}
+
 	NRF_RPC_CBOR_ALLOC(&bt_rpc_grp, ctx, buffer_size_max);
 
 	ser_encode_uint(&ctx, (uintptr_t)adv);
@@ -997,6 +1045,10 @@ int bt_le_ext_adv_get_info(const struct bt_le_ext_adv *adv,
 	int result;
 	size_t buffer_size_max = 9;
 
+	if (IS_ENABLED(CONFIG_BT_RPC_BATCH)) {
+		(void)bt_rpc_batch_flush();
+	}
+
 	NRF_RPC_CBOR_ALLOC(&bt_rpc_grp, ctx, buffer_size_max);
 
 	ser_encode_uint(&ctx, (uintptr_t)adv);
@@ -1030,6 +1082,10 @@ int bt_le_ext_adv_oob_get_local(struct bt_le_ext_adv *adv,
 	struct bt_le_ext_adv_oob_get_local_rpc_res result;
 	size_t buffer_size_max = 5;
 
+	if (IS_ENABLED(CONFIG_BT_RPC_BATCH)) {
+		(void)bt_rpc_batch_flush();
+	}
+
 	NRF_RPC_CBOR_ALLOC(&bt_rpc_grp, ctx, buffer_size_max);
 
 	ser_encode_uint(&ctx, (uintptr_t)adv);
@@ -1060,6 +1116,10 @@ int bt_le_per_adv_set_param(struct bt_le_ext_adv *adv,
 	int result;
 	size_t buffer_size_max = 16;
 
+	if (IS_ENABLED(CONFIG_BT_RPC_BATCH)) {
+		(void)bt_rpc_batch_flush();
+	}
+
 	NRF_RPC_CBOR_ALLOC(&bt_rpc_grp, ctx, buffer_size_max);
 
 	ser_encode_uint(&ctx, (uintptr_t)adv);
@@ -1085,6 +1145,10 @@ int bt_le_per_adv_set_data(const struct bt_le_ext_adv *adv,
 		scratchpad_size += bt_data_sp_size(&ad[i]);
 	}
 
+	if (IS_ENABLED(CONFIG_BT_RPC_BATCH)) {
+		(void)bt_rpc_batch_flush();
+	}
+
 	NRF_RPC_CBOR_ALLOC(&bt_rpc_grp, ctx, buffer_size_max);
 	ser_encode_uint(&ctx, scratchpad_size);
 
@@ -1106,6 +1170,10 @@ int bt_le_per_adv_start(struct bt_le_ext_adv *adv)
 	int result;
 	size_t buffer_size_max = 5;
 
+	if (IS_ENABLED(CONFIG_BT_RPC_BATCH)) {
+		(void)bt_rpc_batch_flush();
+	}
+
 	NRF_RPC_CBOR_ALLOC(&bt_rpc_grp, ctx, buffer_size_max);
 
 	ser_encode_uint(&ctx, (uintptr_t)adv);
@@ -1122,6 +1190,10 @@ int bt_le_per_adv_stop(struct bt_le_ext_adv *adv)
 	int result;
 	size_t buffer_size_max = 5;
 
+	if (IS_ENABLED(CONFIG_BT_RPC_BATCH)) {
+		(void)bt_rpc_batch_flush();
+	}
+
 	NRF_RPC_CBOR_ALLOC(&bt_rpc_grp, ctx, buffer_size_max);
 
 	ser_encode_uint(&ctx, (uintptr_t)adv);
@@ -1141,6 +1213,10 @@ int bt_le_per_adv_set_info_transfer(const struct bt_le_ext_adv *adv,
 	int result;
 	size_t buffer_size_max = 11;
 
+	if (IS_ENABLED(CONFIG_BT_RPC_BATCH)) {
+		(void)bt_rpc_batch_flush();
+	}
+
 	NRF_RPC_CBOR_ALLOC(&bt_rpc_grp, ctx, buffer_size_max);
 
 	ser_encode_uint(&ctx, (uintptr_t)adv);
@@ -13,8 +13,11 @@
 #include <zephyr/bluetooth/att.h>
 #include <zephyr/bluetooth/gatt.h>
 
+#include <bt_rpc.h>
+
 #include "bt_rpc_common.h"
 #include "bt_rpc_gatt_common.h"
+#include "bt_rpc_batch.h"
 #include "serialize.h"
 #include "cbkproxy.h"
 #include "nrf_rpc_cbor.h"
@@ -696,6 +699,11 @@ int bt_gatt_service_unregister(struct bt_gatt_service *svc)
 	uint16_t svc_index;
 	int err;
 
+	/* Queued notifications may refer to the attributes of the service */
+	if (IS_ENABLED(CONFIG_BT_RPC_BATCH)) {
+		(void)bt_rpc_batch_flush();
+	}
+
 	NRF_RPC_CBOR_ALLOC(&bt_rpc_grp, ctx, buffer_size_max);
 
 	err = bt_rpc_gatt_service_to_index(svc, &svc_index);
@@ -766,6 +774,16 @@ int bt_gatt_notify_cb(struct bt_conn *conn,
 
 	scratchpad_size += bt_gatt_notify_params_sp_size(params);
 
+#if defined(CONFIG_BT_RPC_BATCH)
+	if (!bt_rpc_batch_alloc(&ctx, BT_GATT_NOTIFY_CB_RPC_CMD, buffer_size_max)) {
+		ser_encode_uint(&ctx, scratchpad_size);
+		bt_rpc_encode_bt_conn(&ctx, conn);
+		bt_gatt_notify_params_enc(&ctx, params);
+
+		return bt_rpc_batch_commit(&ctx);
+	}
+#endif /* defined(CONFIG_BT_RPC_BATCH) */
+
 	NRF_RPC_CBOR_ALLOC(&bt_rpc_grp, ctx, buffer_size_max);
 	ser_encode_uint(&ctx, scratchpad_size);
 
@@ -846,6 +864,10 @@ int bt_gatt_indicate(struct bt_conn *conn, struct bt_gatt_indicate_params *param
 	buffer_size_max += bt_gatt_indicate_params_buf_size(params);
 	scratchpad_size += bt_gatt_indicate_params_sp_size(params);
 
+	if (IS_ENABLED(CONFIG_BT_RPC_BATCH)) {
+		(void)bt_rpc_batch_flush();
+	}
+
 	NRF_RPC_CBOR_ALLOC(&bt_rpc_grp, ctx, buffer_size_max);
 	ser_encode_uint(&ctx, scratchpad_size);
 
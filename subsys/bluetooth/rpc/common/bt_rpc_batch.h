@@ -0,0 +1,83 @@
+/*
+ * Copyright (c) 2024 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+/**
+ * @file
+ * @defgroup bt_rpc_batch Bluetooth RPC call batching
+ * @{
+ * @brief Batching of fire-and-forget calls for the Bluetooth RPC.
+ *
+ * A batch is sent as one @ref BT_RPC_BATCH_RPC_CMD command. Its payload is the
+ * number of calls, followed by a byte string holding the CBOR encoded calls.
+ * Each call is encoded as its command ID, followed by the same arguments as
+ * the command sent on its own.
+ * The host responds with the number of failed calls and the first error.
+ */
+
+#ifndef BT_RPC_BATCH_H_
+#define BT_RPC_BATCH_H_
+
+#include <nrf_rpc_cbor.h>
+
+#if defined(CONFIG_BT_RPC_HOST)
+
+/** @brief Decode and execute a batched @ref BT_GATT_NOTIFY_CB_RPC_CMD call.
+ *
+ * @param[in,out] ctx CBOR decoding context.
+ *
+ * @retval Result of the call or -EBADMSG if the call could not be decoded.
+ */
+int bt_rpc_batch_gatt_notify_cb(struct nrf_rpc_cbor_ctx *ctx);
+
+/** @brief Decode and execute a batched @ref BT_LE_ADV_UPDATE_DATA_RPC_CMD call.
+ *
+ * @param[in,out] ctx CBOR decoding context.
+ *
+ * @retval Result of the call or -EBADMSG if the call could not be decoded.
+ */
+int bt_rpc_batch_le_adv_update_data(struct nrf_rpc_cbor_ctx *ctx);
+
+/** @brief Decode and execute a batched @ref BT_LE_EXT_ADV_SET_DATA_RPC_CMD call.
+ *
+ * @param[in,out] ctx CBOR decoding context.
+ *
+ * @retval Result of the call or -EBADMSG if the call could not be decoded.
+ */
+int bt_rpc_batch_le_ext_adv_set_data(struct nrf_rpc_cbor_ctx *ctx);
+
+#else
+
+/** @brief Start encoding a call into the batch.
+ *
+ * On success, the batch is locked until @ref bt_rpc_batch_commit is called.
+ * The pending batch is sent first if the call does not fit in it.
+ *
+ * @param[out] ctx CBOR encoding context for the call arguments.
+ * @param[in]  cmd Command ID of the call.
+ * @param[in]  len Maximum encoded size of the call arguments.
+ *
+ * @retval 0 on success.
+ * @retval -ENOMEM if the call does not fit in the empty batch. The pending
+ *         batch is sent, and the call must be sent on its own.
+ */
+int bt_rpc_batch_alloc(struct nrf_rpc_cbor_ctx *ctx, uint8_t cmd, size_t len);
+
+/** @brief Add the call encoded in @p ctx to the batch and unlock it.
+ *
+ * @param[in] ctx CBOR encoding context returned by @ref bt_rpc_batch_alloc.
+ *
+ * @retval 0 on success.
+ * @retval -EINVAL if the call arguments could not be encoded. The call is dropped.
+ */
+int bt_rpc_batch_commit(struct nrf_rpc_cbor_ctx *ctx);
+
+#endif /* defined(CONFIG_BT_RPC_HOST) */
+
+/**
+ * @}
+ */
+
+#endif /* BT_RPC_BATCH_H_ */
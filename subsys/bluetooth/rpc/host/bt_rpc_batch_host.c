@@ -0,0 +1,117 @@
+/*
+ * Copyright (c) 2024 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+/* Host side batching of fire-and-forget calls.
+ */
+
+#include <stdint.h>
+
+#include <zephyr/kernel.h>
+
+#include <nrf_rpc_cbor.h>
+
+#include "bt_rpc_common.h"
+#include "bt_rpc_batch.h"
+#include "serialize.h"
+
+#include <zephyr/logging/log.h>
+
+LOG_MODULE_DECLARE(BT_RPC, CONFIG_BT_RPC_LOG_LEVEL);
+
+typedef int (*bt_rpc_batch_call_t)(struct nrf_rpc_cbor_ctx *ctx);
+
+static void report_decoding_error(uint8_t cmd_evt_id, void *data)
+{
+	nrf_rpc_err(-EBADMSG, NRF_RPC_ERR_SRC_RECV, &bt_rpc_grp, cmd_evt_id,
+		    NRF_RPC_PACKET_TYPE_CMD);
+}
+
+static bt_rpc_batch_call_t batch_call_get(uint32_t cmd)
+{
+	switch (cmd) {
+#if defined(CONFIG_BT_CONN)
+	case BT_GATT_NOTIFY_CB_RPC_CMD:
+		return bt_rpc_batch_gatt_notify_cb;
+#endif /* defined(CONFIG_BT_CONN) */
+#if defined(CONFIG_BT_BROADCASTER)
+	case BT_LE_ADV_UPDATE_DATA_RPC_CMD:
+		return bt_rpc_batch_le_adv_update_data;
+#endif /* defined(CONFIG_BT_BROADCASTER) */
+#if defined(CONFIG_BT_EXT_ADV)
+	case BT_LE_EXT_ADV_SET_DATA_RPC_CMD:
+		return bt_rpc_batch_le_ext_adv_set_data;
+#endif /* defined(CONFIG_BT_EXT_ADV) */
+	default:
+		return NULL;
+	}
+}
+
+static void bt_rpc_batch_rpc_handler(const struct nrf_rpc_group *group,
+				     struct nrf_rpc_cbor_ctx *ctx, void *handler_data)
+{
+	struct nrf_rpc_cbor_ctx calls_ctx;
+	struct nrf_rpc_cbor_ctx rsp_ctx;
+	struct zcbor_string calls;
+	bt_rpc_batch_call_t call;
+	uint32_t cnt;
+	uint32_t failed = 0;
+	int first_err = 0;
+	size_t buffer_size_max = 10;
+	int err;
+
+	cnt = ser_decode_uint(ctx);
+
+	if (!zcbor_bstr_decode(ctx->zs, &calls)) {
+		goto decoding_error;
+	}
+
+	zcbor_new_decode_state(calls_ctx.zs, ARRAY_SIZE(calls_ctx.zs), calls.value, calls.len,
+			       SIZE_MAX);
+
+	/* The calls are executed in order, before the packet is released, as their
+	 * arguments are decoded from it.
+	 */
+	for (uint32_t i = 0; i < cnt; i++) {
+		uint32_t cmd = ser_decode_uint(&calls_ctx);
+
+		call = batch_call_get(cmd);
+		if (!call || !ser_decode_valid(&calls_ctx)) {
+			LOG_ERR("Unsupported batched call: %u", cmd);
+			goto decoding_error;
+		}
+
+		err = call(&calls_ctx);
+		if (!ser_decode_valid(&calls_ctx)) {
+			goto decoding_error;
+		}
+
+		if (err) {
+			if (!failed) {
+				first_err = err;
+			}
+
+			failed++;
+		}
+	}
+
+	if (!ser_decoding_done_and_check(group, ctx)) {
+		goto decoding_error;
+	}
+
+	NRF_RPC_CBOR_ALLOC(group, rsp_ctx, buffer_size_max);
+
+	ser_encode_uint(&rsp_ctx, failed);
+	ser_encode_int(&rsp_ctx, first_err);
+
+	nrf_rpc_cbor_rsp_no_err(group, &rsp_ctx);
+
+	return;
+decoding_error:
+	report_decoding_error(BT_RPC_BATCH_RPC_CMD, handler_data);
+}
+
+NRF_RPC_CBOR_CMD_DECODER(bt_rpc_grp, bt_rpc_batch, BT_RPC_BATCH_RPC_CMD,
+			 bt_rpc_batch_rpc_handler, NULL);
@@ -11,6 +11,7 @@
 #include <nrf_rpc_cbor.h>
 
 #include "bt_rpc_common.h"
+#include "bt_rpc_batch.h"
 #include "serialize.h"
 #include "cbkproxy.h"
 #include <zephyr/settings/settings.h>
@@ -621,6 +622,47 @@ decoding_error:
 NRF_RPC_CBOR_CMD_DECODER(bt_rpc_grp, bt_le_adv_update_data, BT_LE_ADV_UPDATE_DATA_RPC_CMD,
 			 bt_le_adv_update_data_rpc_handler, NULL);
 
+#if defined(CONFIG_BT_RPC_BATCH)
+int bt_rpc_batch_le_adv_update_data(struct nrf_rpc_cbor_ctx *ctx)
+{
+	size_t ad_len;
+	struct bt_data *ad;
+	size_t sd_len;
+	struct bt_data *sd;
+	struct ser_scratchpad scratchpad;
+
+	SER_SCRATCHPAD_DECLARE(&scratchpad, ctx);
+
+	ad_len = ser_decode_uint(ctx);
+	ad = ser_scratchpad_add(&scratchpad, ad_len * sizeof(struct bt_data));
+	if (ad == NULL) {
+		ser_decoder_invalid(ctx, ZCBOR_ERR_UNKNOWN);
+		return -EBADMSG;
+	}
+
+	for (size_t i = 0; i < ad_len; i++) {
+		bt_data_dec(&scratchpad, &ad[i]);
+	}
+
+	sd_len = ser_decode_uint(ctx);
+	sd = ser_scratchpad_add(&scratchpad, sd_len * sizeof(struct bt_data));
+	if (sd == NULL) {
+		ser_decoder_invalid(ctx, ZCBOR_ERR_UNKNOWN);
+		return -EBADMSG;
+	}
+
+	for (size_t i = 0; i < sd_len; i++) {
+		bt_data_dec(&scratchpad, &sd[i]);
+	}
+
+	if (!ser_decode_valid(ctx)) {
+		return -EBADMSG;
+	}
+
+	return bt_le_adv_update_data(ad, ad_len, sd, sd_len);
+}
+#endif /* defined(CONFIG_BT_RPC_BATCH) */
+
 static void bt_le_adv_stop_rpc_handler(const struct nrf_rpc_group *group,
 				       struct nrf_rpc_cbor_ctx *ctx, void *handler_data)
 {
@@ -952,6 +994,49 @@ decoding_error:
 NRF_RPC_CBOR_CMD_DECODER(bt_rpc_grp, bt_le_ext_adv_set_data, BT_LE_EXT_ADV_SET_DATA_RPC_CMD,
 			 bt_le_ext_adv_set_data_rpc_handler, NULL);
 
+#if defined(CONFIG_BT_RPC_BATCH)
+int bt_rpc_batch_le_ext_adv_set_data(struct nrf_rpc_cbor_ctx *ctx)
+{
+	struct bt_le_ext_adv *adv;
+	size_t ad_len;
+	struct bt_data *ad;
+	size_t sd_len;
+	struct bt_data *sd;
+	struct ser_scratchpad scratchpad;
+
+	SER_SCRATCHPAD_DECLARE(&scratchpad, ctx);
+
+	adv = (struct bt_le_ext_adv *)ser_decode_uint(ctx);
+	ad_len = ser_decode_uint(ctx);
+	ad = ser_scratchpad_add(&scratchpad, ad_len * sizeof(struct bt_data));
+	if (ad == NULL) {
+		ser_decoder_invalid(ctx, ZCBOR_ERR_UNKNOWN);
+		return -EBADMSG;
+	}
+
+	for (size_t i = 0; i < ad_len; i++) {
+		bt_data_dec(&scratchpad, &ad[i]);
+	}
+
+	sd_len = ser_decode_uint(ctx);
+	sd = ser_scratchpad_add(&scratchpad, sd_len * sizeof(struct bt_data));
+	if (sd == NULL) {
+		ser_decoder_invalid(ctx, ZCBOR_ERR_UNKNOWN);
+		return -EBADMSG;
+	}
+
+	for (size_t i = 0; i < sd_len; i++) {
+		bt_data_dec(&scratchpad, &sd[i]);
+	}
+
+	if (!ser_decode_valid(ctx)) {
+		return -EBADMSG;
+	}
+
+	return bt_le_ext_adv_set_data(adv, ad, ad_len, sd, sd_len);
+}
+#endif /* defined(CONFIG_BT_RPC_BATCH) */
+
 static void bt_le_ext_adv_update_param_rpc_handler(const struct nrf_rpc_group *group,
 						   struct nrf_rpc_cbor_ctx *ctx, void *handler_data)
 {
@@ -15,6 +15,7 @@
 
 #include "bt_rpc_gatt_common.h"
 #include "bt_rpc_common.h"
+#include "bt_rpc_batch.h"
 #include "serialize.h"
 #include "cbkproxy.h"
 
@@ -828,6 +829,26 @@ decoding_error:
 NRF_RPC_CBOR_CMD_DECODER(bt_rpc_grp, bt_gatt_notify_cb, BT_GATT_NOTIFY_CB_RPC_CMD,
 	bt_gatt_notify_cb_rpc_handler, NULL);
 
+#if defined(CONFIG_BT_RPC_BATCH)
+int bt_rpc_batch_gatt_notify_cb(struct nrf_rpc_cbor_ctx *ctx)
+{
+	struct bt_conn *conn;
+	struct bt_gatt_notify_params params;
+	struct ser_scratchpad scratchpad;
+
+	SER_SCRATCHPAD_DECLARE(&scratchpad, ctx);
+
+	conn = bt_rpc_decode_bt_conn(ctx);
+	bt_gatt_notify_params_dec(&scratchpad, &params);
+
+	if (!ser_decode_valid(ctx)) {
+		return -EBADMSG;
+	}
+
+	return bt_gatt_notify_cb(conn, &params);
+}
+#endif /* defined(CONFIG_BT_RPC_BATCH) */
+
 void bt_gatt_indicate_params_dec(struct ser_scratchpad *scratchpad,
 				 struct bt_gatt_indicate_params *data)
 {
@@ -58,6 +58,17 @@ int bt_rpc_gatt_subscribe_flag_clear(struct bt_gatt_subscribe_params *params, ui
  */
 int bt_rpc_gatt_subscribe_flag_get(struct bt_gatt_subscribe_params *params, uint32_t flags_bit);
 
+/** @brief Send the pending batched calls and wait for the host to execute them.
+ *
+ * Available if @kconfig{CONFIG_BT_RPC_BATCH} is enabled on the client. Fire-and-forget calls,
+ * such as @ref bt_gatt_notify_cb and @ref bt_le_adv_update_data, are batched and return 0
+ * once queued. Call this function before a call that depends on them.
+ *
+ * @return 0 if all calls succeeded or if no call was pending, otherwise the error returned
+ * by the first call that failed.
+ */
+int bt_rpc_batch_flush(void);
+
 #ifdef __cplusplus
 }
 #endif
@@ -18,6 +18,29 @@ LOG_MODULE_REGISTER(nrf_bt_scan, CONFIG_BT_SCAN_LOG_LEVEL);
 	BT_SCAN_SHORT_NAME_FILTER | BT_SCAN_APPEARANCE_FILTER | \
 	BT_SCAN_UUID_FILTER | BT_SCAN_MANUFACTURER_DATA_FILTER)
 
+#if CONFIG_BT_SCAN_FILTER_COMPILED
+/* The address and UUID filters are also indexed in open addressing hash tables.
+ * A slot holds the index of a filter plus one, or zero if it is empty. With more
+ * slots than filters, a lookup always ends on an empty slot.
+ */
+#define ADDR_SET_SIZE (2 * CONFIG_BT_SCAN_ADDRESS_CNT + 1)
+#define UUID_SET_SIZE (2 * CONFIG_BT_SCAN_UUID_CNT + 1)
+
+BUILD_ASSERT(CONFIG_BT_SCAN_ADDRESS_CNT < UINT8_MAX);
+BUILD_ASSERT(CONFIG_BT_SCAN_UUID_CNT < UINT8_MAX);
+
+/* UUID in the form used for the lookups. UUIDs derived from the Bluetooth Base UUID
+ * are compared by their 32-bit value, whatever their size in the advertising data.
+ */
+struct bt_scan_uuid_key {
+	/* 32-bit value of the UUID. */
+	uint32_t val;
+
+	/* Value of a UUID that is not derived from the Base UUID, NULL otherwise. */
+	const uint8_t *val_128;
+};
+#endif /* CONFIG_BT_SCAN_FILTER_COMPILED */
+
 /* Scan filter mutex. */
 K_MUTEX_DEFINE(scan_mutex);
 
@@ -45,6 +68,14 @@ struct bt_scan_control {
 
 	/* Scan filter status. */
 	struct bt_scan_filter_match filter_status;
+
+#if CONFIG_BT_SCAN_FILTER_COMPILED
+	/* UUID filters found in the advertising data. */
+	bool uuid_found[CONFIG_BT_SCAN_UUID_CNT];
+
+	/* Number of UUID filters found in the advertising data. */
+	uint8_t uuid_found_cnt;
+#endif /* CONFIG_BT_SCAN_FILTER_COMPILED */
 };
 
 /* Name filter structure.
@@ -89,6 +120,11 @@ struct bt_scan_addr_filter {
 	/* Addresses advertised by the peripherals. */
 	bt_addr_le_t target_addr[CONFIG_BT_SCAN_ADDRESS_CNT];
 
+#if CONFIG_BT_SCAN_FILTER_COMPILED
+	/* Hash table of the addresses. */
+	uint8_t set[ADDR_SET_SIZE];
+#endif /* CONFIG_BT_SCAN_FILTER_COMPILED */
+
 	/* Address filter counter. */
 	uint8_t cnt;
 
@@ -120,6 +156,14 @@ struct bt_scan_uuid_filter {
 	 */
 	struct bt_scan_uuid uuid[CONFIG_BT_SCAN_UUID_CNT];
 
+#if CONFIG_BT_SCAN_FILTER_COMPILED
+	/* Lookup keys of the UUIDs. */
+	struct bt_scan_uuid_key key[CONFIG_BT_SCAN_UUID_CNT];
+
+	/* Hash table of the UUIDs. */
+	uint8_t set[UUID_SET_SIZE];
+#endif /* CONFIG_BT_SCAN_FILTER_COMPILED */
+
 	/* UUID filter counter. */
 	uint8_t cnt;
 
@@ -506,9 +550,59 @@ static void scan_connect_with_target(struct bt_scan_control *control,
 }
 #endif /* CONFIG_BT_CENTRAL */
 
+#if CONFIG_BT_SCAN_FILTER_COMPILED
+static size_t set_hash(uint32_t val, size_t set_size)
+{
+	/* Knuth's multiplicative hash */
+	return ((val * 2654435761U) >> 16) % set_size;
+}
+
+static size_t addr_hash(const bt_addr_le_t *addr)
+{
+	return set_hash(sys_get_le32(&addr->a.val[0]) ^
+			(sys_get_le16(&addr->a.val[4]) | (addr->type << 16)),
+			ADDR_SET_SIZE);
+}
+
+static void addr_set_insert(uint8_t idx)
+{
+	uint8_t *set = bt_scan.scan_filters.addr.set;
+	size_t i = addr_hash(&bt_scan.scan_filters.addr.target_addr[idx]);
+
+	while (set[i]) {
+		i = (i + 1) % ADDR_SET_SIZE;
+	}
+
+	set[i] = idx + 1;
+}
+
+static const bt_addr_le_t *addr_set_find(const bt_addr_le_t *addr)
+{
+	const struct bt_scan_addr_filter *addr_filter = &bt_scan.scan_filters.addr;
+	size_t i = addr_hash(addr);
+
+	while (addr_filter->set[i]) {
+		const bt_addr_le_t *target = &addr_filter->target_addr[addr_filter->set[i] - 1];
+
+		if (bt_addr_le_cmp(addr, target) == 0) {
+			return target;
+		}
+
+		i = (i + 1) % ADDR_SET_SIZE;
+	}
+
+	return NULL;
+}
+#endif /* CONFIG_BT_SCAN_FILTER_COMPILED */
+
 static bool adv_addr_compare(const bt_addr_le_t *target_addr,
 			     struct bt_scan_control *control)
 {
+#if CONFIG_BT_SCAN_FILTER_COMPILED
+	control->filter_status.addr.addr = addr_set_find(target_addr);
+
+	return control->filter_status.addr.addr != NULL;
+#else
 	const bt_addr_le_t *addr =
 			bt_scan.scan_filters.addr.target_addr;
 	uint8_t counter = bt_scan.scan_filters.addr.cnt;
@@ -522,6 +616,7 @@ static bool adv_addr_compare(const bt_addr_le_t *target_addr,
 	}
 
 	return false;
+#endif /* CONFIG_BT_SCAN_FILTER_COMPILED */
 }
 
 static bool is_addr_filter_enabled(void)
@@ -565,6 +660,10 @@ static int scan_addr_filter_add(const bt_addr_le_t *target_addr)
 	/* Add target address to filter. */
 	bt_addr_le_copy(&addr_filter[counter], target_addr);
 
+#if CONFIG_BT_SCAN_FILTER_COMPILED
+	addr_set_insert(counter);
+#endif /* CONFIG_BT_SCAN_FILTER_COMPILED */
+
 	LOG_DBG("Filter set on address type %i",
 		addr_filter[counter].type);
 
@@ -764,6 +863,128 @@ static int scan_short_name_filter_add(const struct bt_scan_short_name *short_nam
 	return 0;
 }
 
+#if CONFIG_BT_SCAN_FILTER_COMPILED
+/* Bluetooth Base UUID in little endian, without the 32-bit value in its last 4 bytes */
+static const uint8_t base_uuid[] = {
+	0xfb, 0x34, 0x9b, 0x5f, 0x80, 0x00, 0x00, 0x80, 0x00, 0x10, 0x00, 0x00
+};
+
+static void uuid_key_get(const uint8_t *data, uint8_t uuid_len,
+			 struct bt_scan_uuid_key *key)
+{
+	key->val_128 = NULL;
+
+	switch (uuid_len) {
+	case sizeof(uint16_t):
+		key->val = sys_get_le16(data);
+		break;
+
+	case sizeof(uint32_t):
+		key->val = sys_get_le32(data);
+		break;
+
+	default:
+		key->val = sys_get_le32(&data[sizeof(base_uuid)]);
+		if (memcmp(data, base_uuid, sizeof(base_uuid)) != 0) {
+			key->val_128 = data;
+		}
+		break;
+	}
+}
+
+static bool uuid_key_cmp(const struct bt_scan_uuid_key *key1,
+			 const struct bt_scan_uuid_key *key2)
+{
+	if ((key1->val != key2->val) || (!key1->val_128 != !key2->val_128)) {
+		return false;
+	}
+
+	return !key1->val_128 ||
+	       (memcmp(key1->val_128, key2->val_128, BT_SCAN_UUID_128_SIZE) == 0);
+}
+
+static void uuid_set_insert(uint8_t idx)
+{
+	struct bt_scan_uuid_filter *uuid_filter = &bt_scan.scan_filters.uuid;
+	struct bt_scan_uuid_key *key = &uuid_filter->key[idx];
+	const struct bt_uuid *uuid = uuid_filter->uuid[idx].uuid;
+	size_t i;
+
+	switch (uuid->type) {
+	case BT_UUID_TYPE_16:
+		key->val = BT_UUID_16(uuid)->val;
+		key->val_128 = NULL;
+		break;
+
+	case BT_UUID_TYPE_32:
+		key->val = BT_UUID_32(uuid)->val;
+		key->val_128 = NULL;
+		break;
+
+	default:
+		uuid_key_get(BT_UUID_128(uuid)->val, BT_SCAN_UUID_128_SIZE, key);
+		break;
+	}
+
+	i = set_hash(key->val, UUID_SET_SIZE);
+	while (uuid_filter->set[i]) {
+		i = (i + 1) % UUID_SET_SIZE;
+	}
+
+	uuid_filter->set[i] = idx + 1;
+}
+
+static int uuid_set_find(const struct bt_scan_uuid_key *key)
+{
+	const struct bt_scan_uuid_filter *uuid_filter = &bt_scan.scan_filters.uuid;
+	size_t i = set_hash(key->val, UUID_SET_SIZE);
+
+	while (uuid_filter->set[i]) {
+		uint8_t idx = uuid_filter->set[i] - 1;
+
+		if (uuid_key_cmp(key, &uuid_filter->key[idx])) {
+			return idx;
+		}
+
+		i = (i + 1) % UUID_SET_SIZE;
+	}
+
+	return -ENOENT;
+}
+
+static void uuid_set_check(struct bt_scan_control *control,
+			   const struct bt_data *data,
+			   uint8_t uuid_type)
+{
+	struct bt_scan_uuid_key key;
+	uint8_t uuid_len;
+	int idx;
+
+	switch (uuid_type) {
+	case BT_UUID_TYPE_16:
+		uuid_len = sizeof(uint16_t);
+		break;
+
+	case BT_UUID_TYPE_32:
+		uuid_len = sizeof(uint32_t);
+		break;
+
+	default:
+		uuid_len = BT_SCAN_UUID_128_SIZE;
+		break;
+	}
+
+	for (size_t i = 0; i + uuid_len <= data->data_len; i += uuid_len) {
+		uuid_key_get(&data->data[i], uuid_len, &key);
+
+		idx = uuid_set_find(&key);
+		if ((idx >= 0) && !control->uuid_found[idx]) {
+			control->uuid_found[idx] = true;
+			control->uuid_found_cnt++;
+		}
+	}
+}
+#else
 static bool find_uuid(const uint8_t *data,
 		      uint8_t data_len,
 		      uint8_t uuid_type,
@@ -846,6 +1067,7 @@ static bool adv_uuid_compare(const struct bt_data *data, uint8_t uuid_type,
 
 	return false;
 }
+#endif /* CONFIG_BT_SCAN_FILTER_COMPILED */
 
 static bool is_uuid_filter_enabled(void)
 {
@@ -857,6 +1079,9 @@ static void uuid_check(struct bt_scan_control *control,
 		       uint8_t type)
 {
 	if (is_uuid_filter_enabled()) {
+#if CONFIG_BT_SCAN_FILTER_COMPILED
+		uuid_set_check(control, data, type);
+#else
 		if (adv_uuid_compare(data, type, control)) {
 			control->filter_match_cnt++;
 
@@ -864,8 +1089,46 @@ static void uuid_check(struct bt_scan_control *control,
 			control->filter_status.uuid.match = true;
 			control->filter_match = true;
 		}
+#endif /* CONFIG_BT_SCAN_FILTER_COMPILED */
+	}
+}
+
+#if CONFIG_BT_SCAN_FILTER_COMPILED
+/* Called once all the advertising data is parsed, as the UUIDs may be spread
+ * over several AD structures.
+ */
+static void uuid_set_result(struct bt_scan_control *control)
+{
+	const struct bt_scan_uuid_filter *uuid_filter =
+			&bt_scan.scan_filters.uuid;
+	struct bt_scan_uuid_filter_status *status =
+			&control->filter_status.uuid;
+
+	if (!is_uuid_filter_enabled() || (control->uuid_found_cnt == 0)) {
+		return;
+	}
+
+	/* In the multifilter mode, all UUIDs must be found in
+	 * the advertisement packets.
+	 */
+	if (control->all_mode &&
+	    (control->uuid_found_cnt < uuid_filter->cnt)) {
+		return;
+	}
+
+	for (size_t i = 0; i < uuid_filter->cnt; i++) {
+		if (control->uuid_found[i]) {
+			status->uuid[status->count++] = uuid_filter->uuid[i].uuid;
+		}
 	}
+
+	control->filter_match_cnt++;
+
+	/* Information about the filters matched. */
+	status->match = true;
+	control->filter_match = true;
 }
+#endif /* CONFIG_BT_SCAN_FILTER_COMPILED */
 
 static int scan_uuid_filter_add(struct bt_uuid *uuid)
 {
@@ -917,6 +1180,10 @@ static int scan_uuid_filter_add(struct bt_uuid *uuid)
 		return -EINVAL;
 	}
 
+#if CONFIG_BT_SCAN_FILTER_COMPILED
+	uuid_set_insert(counter);
+#endif /* CONFIG_BT_SCAN_FILTER_COMPILED */
+
 	bt_scan.scan_filters.uuid.cnt++;
 	LOG_DBG("Added filter on UUID type %x", uuid->type);
 
@@ -1234,6 +1501,11 @@ void bt_scan_filter_remove_all(void)
 			&bt_scan.scan_filters.uuid;
 	uuid_filter->cnt = 0;
 
+#if CONFIG_BT_SCAN_FILTER_COMPILED
+	memset(addr_filter->set, 0, sizeof(addr_filter->set));
+	memset(uuid_filter->set, 0, sizeof(uuid_filter->set));
+#endif /* CONFIG_BT_SCAN_FILTER_COMPILED */
+
 	struct bt_scan_appearance_filter *appearance_filter =
 			&bt_scan.scan_filters.appearance;
 	appearance_filter->cnt = 0;
@@ -1458,6 +1730,28 @@ static bool adv_data_found(struct bt_data *data, void *user_data)
 	return true;
 }
 
+static bool adv_data_check_needed(const struct bt_scan_control *control)
+{
+#if CONFIG_BT_SCAN_FILTER_COMPILED
+	const bool addr_filter = is_addr_filter_enabled();
+
+	/* No filter looks at the advertising data. */
+	if (control->filter_cnt == (addr_filter ? 1 : 0)) {
+		return false;
+	}
+
+	/* In the multifilter mode, the result is already known
+	 * if the address does not match.
+	 */
+	if (control->all_mode && addr_filter &&
+	    !control->filter_status.addr.match) {
+		return false;
+	}
+#endif /* CONFIG_BT_SCAN_FILTER_COMPILED */
+
+	return true;
+}
+
 static void filter_state_check(struct bt_scan_control *control,
 			       const bt_addr_le_t *addr)
 {
@@ -1510,12 +1804,18 @@ static void scan_recv(const struct bt_le_scan_recv_info *info,
 	/* Check the address filter. */
 	check_addr(&scan_control, info->addr);
 
-	/* Save advertising buffer state to transfer it
-	 * data to application if futher processing is needed.
-	 */
-	net_buf_simple_save(ad, &state);
-	bt_data_parse(ad, adv_data_found, (void *)&scan_control);
-	net_buf_simple_restore(ad, &state);
+	if (adv_data_check_needed(&scan_control)) {
+		/* Save advertising buffer state to transfer it
+		 * data to application if futher processing is needed.
+		 */
+		net_buf_simple_save(ad, &state);
+		bt_data_parse(ad, adv_data_found, (void *)&scan_control);
+		net_buf_simple_restore(ad, &state);
+
+#if CONFIG_BT_SCAN_FILTER_COMPILED
+		uuid_set_result(&scan_control);
+#endif /* CONFIG_BT_SCAN_FILTER_COMPILED */
+	}
 
 	scan_control.device_info.recv_info = info;
 	scan_control.device_info.conn_param = &bt_scan.conn_param;
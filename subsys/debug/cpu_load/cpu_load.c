@@ -15,6 +15,7 @@
 #include <hal/nrf_rtc.h>
 #include <hal/nrf_power.h>
 #include <debug/ppi_trace.h>
+#include <debug/perf_counter.h>
 #include <zephyr/logging/log.h>
 
 LOG_MODULE_REGISTER(cpu_load, CONFIG_CPU_LOAD_LOG_LEVEL);
@@ -250,6 +251,15 @@ uint32_t cpu_load_get(void)
 	return (uint32_t)load;
 }
 
+#if defined(CONFIG_PERF_COUNTER)
+static uint32_t cpu_load_gauge_get(void)
+{
+	return ready ? cpu_load_get() : 0;
+}
+
+PERF_GAUGE_DEFINE(cpu_load_value, "0.001%", cpu_load_gauge_get);
+#endif
+
 static int cmd_cpu_load_get(const struct shell *shell, size_t argc, char **argv)
 {
 	uint32_t load;
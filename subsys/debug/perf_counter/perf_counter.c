@@ -0,0 +1,320 @@
+/*
+ * Copyright (c) 2024 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#include <string.h>
+#include <zephyr/kernel.h>
+#include <zephyr/init.h>
+#include <zephyr/shell/shell.h>
+#include <zephyr/sys/util.h>
+#include <zephyr/logging/log.h>
+#include <debug/perf_counter.h>
+#if defined(CONFIG_PERF_COUNTER_NRF_PROFILER)
+#include <nrf_profiler.h>
+#endif
+
+LOG_MODULE_REGISTER(perf_counter, CONFIG_PERF_COUNTER_LOG_LEVEL);
+
+#define BUCKET_CNT CONFIG_PERF_COUNTER_HISTOGRAM_BUCKETS
+
+static size_t bucket_idx(uint32_t val)
+{
+	/* Number of significant bits */
+	size_t idx = (val == 0) ? 0 : (32 - __builtin_clz(val));
+
+	return MIN(idx, BUCKET_CNT - 1);
+}
+
+static uint32_t bucket_upper_bound(size_t idx)
+{
+	if (idx == BUCKET_CNT - 1) {
+		return UINT32_MAX;
+	}
+
+	return (uint32_t)(BIT64(idx) - 1);
+}
+
+void perf_histogram_record(struct perf_counter *hist, uint32_t val)
+{
+	atomic_val_t max;
+
+	__ASSERT_NO_MSG(hist->type == PERF_COUNTER_TYPE_HISTOGRAM);
+
+	atomic_inc(&hist->count);
+	atomic_add(&hist->sum, (atomic_val_t)val);
+	atomic_inc(&hist->buckets[bucket_idx(val)]);
+
+	max = atomic_get(&hist->max);
+	while (((uint32_t)max < val) && !atomic_cas(&hist->max, max, (atomic_val_t)val)) {
+		max = atomic_get(&hist->max);
+	}
+}
+
+uint32_t perf_counter_value_get(struct perf_counter *counter)
+{
+	uint32_t count;
+
+	switch (counter->type) {
+	case PERF_COUNTER_TYPE_COUNTER:
+		return (uint32_t)atomic_get(&counter->sum);
+	case PERF_COUNTER_TYPE_HISTOGRAM:
+		count = (uint32_t)atomic_get(&counter->count);
+		return (count > 0) ? ((uint32_t)atomic_get(&counter->sum) / count) : 0;
+	case PERF_COUNTER_TYPE_GAUGE:
+		return counter->get();
+	default:
+		__ASSERT_NO_MSG(false);
+		return 0;
+	}
+}
+
+uint32_t perf_histogram_percentile_get(struct perf_counter *hist, uint8_t percent)
+{
+	uint32_t buckets[BUCKET_CNT];
+	uint64_t total = 0;
+	uint64_t target;
+	uint64_t cumulative = 0;
+	size_t idx;
+
+	__ASSERT_NO_MSG(hist->type == PERF_COUNTER_TYPE_HISTOGRAM);
+	__ASSERT_NO_MSG(percent <= 100);
+
+	/* Work on a snapshot, so that values recorded meanwhile are not counted twice */
+	for (idx = 0; idx < BUCKET_CNT; idx++) {
+		buckets[idx] = (uint32_t)atomic_get(&hist->buckets[idx]);
+		total += buckets[idx];
+	}
+
+	if (total == 0) {
+		return 0;
+	}
+
+	target = MAX(DIV_ROUND_UP(total * percent, 100), 1);
+
+	for (idx = 0; idx < BUCKET_CNT - 1; idx++) {
+		cumulative += buckets[idx];
+		if (cumulative >= target) {
+			break;
+		}
+	}
+
+	return MIN(bucket_upper_bound(idx), (uint32_t)atomic_get(&hist->max));
+}
+
+struct perf_counter *perf_counter_find(const char *name)
+{
+	STRUCT_SECTION_FOREACH(perf_counter, counter) {
+		if (strcmp(counter->name, name) == 0) {
+			return counter;
+		}
+	}
+
+	return NULL;
+}
+
+void perf_counter_reset(struct perf_counter *counter)
+{
+	atomic_clear(&counter->count);
+	atomic_clear(&counter->sum);
+	atomic_clear(&counter->max);
+
+	if (counter->buckets) {
+		for (size_t i = 0; i < BUCKET_CNT; i++) {
+			atomic_clear(&counter->buckets[i]);
+		}
+	}
+
+	counter->reset_time = k_uptime_get_32();
+}
+
+void perf_counter_reset_all(void)
+{
+	STRUCT_SECTION_FOREACH(perf_counter, counter) {
+		perf_counter_reset(counter);
+	}
+}
+
+#if defined(CONFIG_PERF_COUNTER_NRF_PROFILER)
+static const char * const counter_labels[] = {"count", "sum"};
+static const enum nrf_profiler_arg counter_types[] = {
+	NRF_PROFILER_ARG_U32, NRF_PROFILER_ARG_U32
+};
+
+static const char * const histogram_labels[] = {"count", "avg", "p99", "max"};
+static const enum nrf_profiler_arg histogram_types[] = {
+	NRF_PROFILER_ARG_U32, NRF_PROFILER_ARG_U32, NRF_PROFILER_ARG_U32, NRF_PROFILER_ARG_U32
+};
+
+static const char * const gauge_labels[] = {"value"};
+static const enum nrf_profiler_arg gauge_types[] = {NRF_PROFILER_ARG_U32};
+
+static struct k_work_delayable profiler_work;
+
+static void profiler_send(struct perf_counter *counter)
+{
+	struct log_event_buf buf;
+
+	if (!is_profiling_enabled(counter->profiler_id)) {
+		return;
+	}
+
+	nrf_profiler_log_start(&buf);
+
+	switch (counter->type) {
+	case PERF_COUNTER_TYPE_COUNTER:
+		nrf_profiler_log_encode_uint32(&buf, (uint32_t)atomic_get(&counter->count));
+		nrf_profiler_log_encode_uint32(&buf, (uint32_t)atomic_get(&counter->sum));
+		break;
+	case PERF_COUNTER_TYPE_HISTOGRAM:
+		nrf_profiler_log_encode_uint32(&buf, (uint32_t)atomic_get(&counter->count));
+		nrf_profiler_log_encode_uint32(&buf, perf_counter_value_get(counter));
+		nrf_profiler_log_encode_uint32(&buf, perf_histogram_percentile_get(counter, 99));
+		nrf_profiler_log_encode_uint32(&buf, (uint32_t)atomic_get(&counter->max));
+		break;
+	case PERF_COUNTER_TYPE_GAUGE:
+		nrf_profiler_log_encode_uint32(&buf, counter->get());
+		break;
+	}
+
+	nrf_profiler_log_send(&buf, counter->profiler_id);
+}
+
+static void profiler_work_fn(struct k_work *work)
+{
+	STRUCT_SECTION_FOREACH(perf_counter, counter) {
+		profiler_send(counter);
+	}
+
+	k_work_schedule(&profiler_work, K_MSEC(CONFIG_PERF_COUNTER_NRF_PROFILER_INTERVAL));
+}
+
+static int profiler_export_init(void)
+{
+	int err;
+
+	err = nrf_profiler_init();
+	if (err) {
+		LOG_ERR("nRF Profiler initialization failed (err:%d)", err);
+		return err;
+	}
+
+	STRUCT_SECTION_FOREACH(perf_counter, counter) {
+		switch (counter->type) {
+		case PERF_COUNTER_TYPE_COUNTER:
+			counter->profiler_id = nrf_profiler_register_event_type(
+				counter->name, counter_labels, counter_types,
+				ARRAY_SIZE(counter_types));
+			break;
+		case PERF_COUNTER_TYPE_HISTOGRAM:
+			counter->profiler_id = nrf_profiler_register_event_type(
+				counter->name, histogram_labels, histogram_types,
+				ARRAY_SIZE(histogram_types));
+			break;
+		case PERF_COUNTER_TYPE_GAUGE:
+			counter->profiler_id = nrf_profiler_register_event_type(
+				counter->name, gauge_labels, gauge_types,
+				ARRAY_SIZE(gauge_types));
+			break;
+		}
+	}
+
+	k_work_init_delayable(&profiler_work, profiler_work_fn);
+	k_work_schedule(&profiler_work, K_MSEC(CONFIG_PERF_COUNTER_NRF_PROFILER_INTERVAL));
+
+	return 0;
+}
+
+SYS_INIT(profiler_export_init, APPLICATION, CONFIG_APPLICATION_INIT_PRIORITY);
+#endif /* CONFIG_PERF_COUNTER_NRF_PROFILER */
+
+#if defined(CONFIG_PERF_COUNTER_CMDS)
+static void counter_print(const struct shell *shell, struct perf_counter *counter)
+{
+	uint32_t elapsed = MAX(k_uptime_get_32() - counter->reset_time, 1);
+	uint32_t count = (uint32_t)atomic_get(&counter->count);
+	uint32_t sum = (uint32_t)atomic_get(&counter->sum);
+
+	switch (counter->type) {
+	case PERF_COUNTER_TYPE_COUNTER:
+		shell_print(shell, "%-28s count:%u sum:%u %s rate:%llu %s/s", counter->name,
+			    count, sum, counter->unit, (uint64_t)sum * MSEC_PER_SEC / elapsed,
+			    counter->unit);
+		break;
+	case PERF_COUNTER_TYPE_HISTOGRAM:
+		shell_print(shell, "%-28s count:%u avg:%u p50:%u p99:%u max:%u %s",
+			    counter->name, count, perf_counter_value_get(counter),
+			    perf_histogram_percentile_get(counter, 50),
+			    perf_histogram_percentile_get(counter, 99),
+			    (uint32_t)atomic_get(&counter->max), counter->unit);
+		break;
+	case PERF_COUNTER_TYPE_GAUGE:
+		shell_print(shell, "%-28s value:%u %s", counter->name, counter->get(),
+			    counter->unit);
+		break;
+	}
+}
+
+static struct perf_counter *counter_arg_get(const struct shell *shell, const char *name)
+{
+	struct perf_counter *counter = perf_counter_find(name);
+
+	if (!counter) {
+		shell_error(shell, "No counter: %s", name);
+	}
+
+	return counter;
+}
+
+static int cmd_perf_counter_show(const struct shell *shell, size_t argc, char **argv)
+{
+	struct perf_counter *counter;
+
+	if (argc > 1) {
+		counter = counter_arg_get(shell, argv[1]);
+		if (!counter) {
+			return -ENOENT;
+		}
+
+		counter_print(shell, counter);
+		return 0;
+	}
+
+	STRUCT_SECTION_FOREACH(perf_counter, c) {
+		counter_print(shell, c);
+	}
+
+	return 0;
+}
+
+static int cmd_perf_counter_reset(const struct shell *shell, size_t argc, char **argv)
+{
+	struct perf_counter *counter;
+
+	if (argc > 1) {
+		counter = counter_arg_get(shell, argv[1]);
+		if (!counter) {
+			return -ENOENT;
+		}
+
+		perf_counter_reset(counter);
+		return 0;
+	}
+
+	perf_counter_reset_all();
+
+	return 0;
+}
+
+SHELL_STATIC_SUBCMD_SET_CREATE(sub_cmd_perf_counter,
+	SHELL_CMD_ARG(show, NULL, "Show all counters or the given one",
+		      cmd_perf_counter_show, 1, 1),
+	SHELL_CMD_ARG(reset, NULL, "Reset all counters or the given one",
+		      cmd_perf_counter_reset, 1, 1),
+	SHELL_SUBCMD_SET_END
+);
+
+SHELL_CMD_ARG_REGISTER(perf_counter, &sub_cmd_perf_counter, "Performance counters",
+		       cmd_perf_counter_show, 1, 1);
+#endif /* CONFIG_PERF_COUNTER_CMDS */
@@ -13,6 +13,7 @@
 
 #include <mpsl_timeslot.h>
 #include <mpsl.h>
+#include <hal/nrf_timer.h>
 
 #include <nrf_dm.h>
 #include "dm.h"
@@ -90,18 +91,33 @@ K_MSGQ_DEFINE(mpsl_api_msgq, sizeof(enum mpsl_timeslot_call), 8, 4);
 K_MSGQ_DEFINE(dm_api_msgq, sizeof(enum dm_call), 8, 4);
 
 struct {
-	nrf_dm_status_t nrf_dm_status;
 	struct dm_cb *cb;
 } static dm_context;
 
 struct {
-	struct timeslot_request curr_req;
+	struct timeslot_group curr;
+	nrf_dm_status_t status[CONFIG_DM_TIMESLOT_PACK_MAX];
+	uint8_t next;
 	atomic_val_t state;
 	uint32_t last_start;
 } static timeslot_ctx = {
 	.state = ATOMIC_INIT(TIMESLOT_STATE_INIT),
 };
 
+struct {
+	struct k_spinlock lock;
+	int64_t start;
+	uint32_t ranging_cnt;
+	uint32_t ranging_fail_cnt;
+	uint32_t missed_cnt;
+	uint32_t timeslot_cnt;
+	uint64_t ranging_us;
+	uint64_t timeslot_us;
+} static stats;
+
+/* Reports of the rangings in the current timeslot */
+static nrf_dm_report_t reports[CONFIG_DM_TIMESLOT_PACK_MAX];
+
 /* Timeslot request */
 static mpsl_timeslot_request_t timeslot_request_earliest = {
 	.request_type = MPSL_TIMESLOT_REQ_TYPE_EARLIEST,
@@ -155,13 +171,65 @@ static uint32_t dm_proc_execute_duration_us(struct dm_request *dm_req)
 	return time_us;
 }
 
+static nrf_dm_status_t ranging_execute(uint8_t idx)
+{
+	struct timeslot_request *req = &timeslot_ctx.curr.req[idx];
+	static nrf_dm_config_t dm_config;
+	nrf_dm_status_t nrf_dm_status;
+
+	if (idx > 0) {
+		/* The next ranging overwrites the report in the library */
+		if (timeslot_ctx.status[idx - 1] == NRF_DM_STATUS_SUCCESS) {
+			nrf_dm_populate_report(&reports[idx - 1]);
+		}
+	}
+
+	dm_config_get(&req->dm_req, &dm_config);
+	nrf_dm_status = nrf_dm_configure(&dm_config);
+
+	if (nrf_dm_status == NRF_DM_STATUS_SUCCESS) {
+		nrf_dm_status = nrf_dm_proc_execute(req->window_length_us);
+	}
+
+	return nrf_dm_status;
+}
+
+/* Execute the rangings of the current timeslot that are due. TIMER0 runs at 1 MHz from the
+ * start of the timeslot, which is the start time of the first ranging in it. Returns false
+ * if TIMER0 is set to signal the start of the next ranging.
+ */
+static bool rangings_execute(void)
+{
+	while (timeslot_ctx.next < timeslot_ctx.curr.count) {
+		uint8_t idx = timeslot_ctx.next;
+		uint32_t offset_us = TICKS_TO_US(time_distance_get(timeslot_ctx.curr.start_time,
+								   timeslot_ctx.curr.req[idx].start_time));
+
+		/* Set the compare before reading the timer, so that the start is not missed */
+		nrf_timer_event_clear(NRF_TIMER0, NRF_TIMER_EVENT_COMPARE0);
+		nrf_timer_cc_set(NRF_TIMER0, NRF_TIMER_CC_CHANNEL0, offset_us);
+		nrf_timer_int_enable(NRF_TIMER0, NRF_TIMER_INT_COMPARE0_MASK);
+		nrf_timer_task_trigger(NRF_TIMER0, NRF_TIMER_TASK_CAPTURE1);
+
+		if (nrf_timer_cc_get(NRF_TIMER0, NRF_TIMER_CC_CHANNEL1) < offset_us) {
+			return false;
+		}
+
+		nrf_timer_int_disable(NRF_TIMER0, NRF_TIMER_INT_COMPARE0_MASK);
+		nrf_timer_event_clear(NRF_TIMER0, NRF_TIMER_EVENT_COMPARE0);
+
+		timeslot_ctx.status[idx] = ranging_execute(idx);
+		timeslot_ctx.next++;
+	}
+
+	return true;
+}
+
 static mpsl_timeslot_signal_return_param_t *mpsl_timeslot_callback(
 				mpsl_timeslot_session_id_t session_id, uint32_t signal_type)
 {
 	ARG_UNUSED(session_id);
 	mpsl_timeslot_signal_return_param_t *p_ret_val = NULL;
-	nrf_dm_status_t nrf_dm_status;
-	static nrf_dm_config_t dm_config;
 	enum dm_call dm_api_call;
 
 	switch (signal_type) {
@@ -177,15 +245,29 @@ static mpsl_timeslot_signal_return_param_t *mpsl_timeslot_callback(
 			return p_ret_val;
 		}
 
-		dm_config_get(&timeslot_ctx.curr_req.dm_req, &dm_config);
-		nrf_dm_status = nrf_dm_configure(&dm_config);
-
-		if (nrf_dm_status == NRF_DM_STATUS_SUCCESS) {
-			nrf_dm_status = nrf_dm_proc_execute(timeslot_ctx.curr_req.window_length_us);
+		nrf_timer_bit_width_set(NRF_TIMER0, NRF_TIMER_BIT_WIDTH_32);
+		timeslot_ctx.next = 0;
+		if (!rangings_execute()) {
+			signal_callback_return_param.callback_action =
+				MPSL_TIMESLOT_SIGNAL_ACTION_NONE;
+			break;
 		}
 
-		dm_context.nrf_dm_status = nrf_dm_status;
+		dm_io_clear(DM_IO_RANGING);
+
+		break;
+	case MPSL_TIMESLOT_SIGNAL_TIMER0:
+		nrf_timer_int_disable(NRF_TIMER0, NRF_TIMER_INT_COMPARE0_MASK);
+		nrf_timer_event_clear(NRF_TIMER0, NRF_TIMER_EVENT_COMPARE0);
+
+		p_ret_val = &signal_callback_return_param;
+		if (!rangings_execute()) {
+			signal_callback_return_param.callback_action =
+				MPSL_TIMESLOT_SIGNAL_ACTION_NONE;
+			break;
+		}
 
+		signal_callback_return_param.callback_action = MPSL_TIMESLOT_SIGNAL_ACTION_END;
 		dm_io_clear(DM_IO_RANGING);
 
 		break;
@@ -256,14 +338,15 @@ static void mpsl_nonpreemptible_thread(void)
 	}
 }
 
-static void process_data(const nrf_dm_report_t *data, float high_precision_estimate)
+static void process_data(const struct dm_request *dm_req, nrf_dm_status_t status,
+			 const nrf_dm_report_t *data, float high_precision_estimate)
 {
 	if (!data) {
 		result.status = false;
 		return;
 	}
-	result.status = (dm_context.nrf_dm_status == NRF_DM_STATUS_SUCCESS);
-	bt_addr_le_copy(&result.bt_addr, &timeslot_ctx.curr_req.dm_req.bt_addr);
+	result.status = (status == NRF_DM_STATUS_SUCCESS);
+	bt_addr_le_copy(&result.bt_addr, &dm_req->bt_addr);
 
 	result.quality = DM_QUALITY_NONE;
 	if (data->quality == NRF_DM_QUALITY_OK) {
@@ -276,7 +359,7 @@ static void process_data(const nrf_dm_report_t *data, float high_precision_estim
 		result.quality = DM_QUALITY_CRC_FAIL;
 	}
 
-	result.ranging_mode = timeslot_ctx.curr_req.dm_req.ranging_mode;
+	result.ranging_mode = dm_req->ranging_mode;
 	if (result.ranging_mode == DM_RANGING_MODE_RTT) {
 		result.dist_estimates.rtt.rtt = data->distance_estimates.rtt.rtt;
 	} else {
@@ -310,7 +393,7 @@ static int timeslot_request(uint32_t distance_from_last)
 	enum mpsl_timeslot_call mpsl_api_call;
 
 	timeslot_request_normal.params.normal.distance_us = distance_from_last;
-	timeslot_request_normal.params.normal.length_us = timeslot_ctx.curr_req.timeslot_length_us;
+	timeslot_request_normal.params.normal.length_us = timeslot_ctx.curr.timeslot_length_us;
 	mpsl_api_call = MAKE_REQUEST_NORMAL;
 
 	err = k_msgq_put(&mpsl_api_msgq, &mpsl_api_call, K_FOREVER);
@@ -320,9 +403,36 @@ static int timeslot_request(uint32_t distance_from_last)
 	return err;
 }
 
+static void stats_missed_add(uint32_t cnt)
+{
+	k_spinlock_key_t key = k_spin_lock(&stats.lock);
+
+	stats.missed_cnt += cnt;
+	k_spin_unlock(&stats.lock, key);
+}
+
+static void stats_timeslot_end(void)
+{
+	k_spinlock_key_t key = k_spin_lock(&stats.lock);
+
+	stats.timeslot_cnt++;
+	stats.timeslot_us += timeslot_ctx.curr.timeslot_length_us;
+
+	for (uint8_t i = 0; i < timeslot_ctx.curr.count; i++) {
+		stats.ranging_us += timeslot_ctx.curr.req[i].window_length_us;
+
+		if (timeslot_ctx.status[i] == NRF_DM_STATUS_SUCCESS) {
+			stats.ranging_cnt++;
+		} else {
+			stats.ranging_fail_cnt++;
+		}
+	}
+
+	k_spin_unlock(&stats.lock, key);
+}
+
 static void dm_start_ranging(void)
 {
-	struct timeslot_request *req;
 	int err;
 
 	k_mutex_lock(&ranging_mtx, K_FOREVER);
@@ -342,15 +452,18 @@ static void dm_start_ranging(void)
 		goto out;
 	}
 
-	req = timeslot_queue_peek();
-	if (!req) {
-		goto out;
+	err = timeslot_queue_group_get(time_now(), &timeslot_ctx.curr);
+	if (timeslot_ctx.curr.missed) {
+		LOG_DBG("%u rangings missed their start time", timeslot_ctx.curr.missed);
+		stats_missed_add(timeslot_ctx.curr.missed);
 	}
 
-	memcpy(&timeslot_ctx.curr_req, req, sizeof(timeslot_ctx.curr_req));
-	timeslot_queue_remove_first();
+	if (err) {
+		goto out;
+	}
 
-	uint32_t distance = time_distance_get(timeslot_ctx.last_start, req->start_time);
+	uint32_t distance = time_distance_get(timeslot_ctx.last_start,
+					      timeslot_ctx.curr.start_time);
 
 	atomic_set(&timeslot_ctx.state, TIMESLOT_STATE_PENDING);
 	err = timeslot_request(TICKS_TO_US(distance));
@@ -369,12 +482,18 @@ static void dm_reschedule(void)
 	if (IS_ENABLED(CONFIG_DM_TIMESLOT_RESCHEDULE)) {
 		int err;
 
-		if (dm_context.nrf_dm_status == NRF_DM_STATUS_SUCCESS) {
-			window_len_us = timeslot_ctx.curr_req.window_length_us;
-			timeslot_len_us = timeslot_ctx.curr_req.timeslot_length_us;
+		for (uint8_t i = 0; i < timeslot_ctx.curr.count; i++) {
+			struct timeslot_request *req = &timeslot_ctx.curr.req[i];
 
-			err = timeslot_queue_append(&timeslot_ctx.curr_req.dm_req,
-					   time_now(), window_len_us, timeslot_len_us);
+			if (timeslot_ctx.status[i] != NRF_DM_STATUS_SUCCESS) {
+				continue;
+			}
+
+			window_len_us = req->window_length_us;
+			timeslot_len_us = req->timeslot_length_us;
+
+			err = timeslot_queue_append(&req->dm_req, time_now(), window_len_us,
+						    timeslot_len_us);
 			if (err) {
 				LOG_DBG("Timeslot allocator failed (err %d)", err);
 			}
@@ -383,30 +502,36 @@ static void dm_reschedule(void)
 	}
 }
 
-static void calculation(void)
+static void calculation(uint8_t idx)
 {
+	const struct dm_request *dm_req = &timeslot_ctx.curr.req[idx].dm_req;
+	nrf_dm_report_t *report = &reports[idx];
+
+	if (idx == timeslot_ctx.curr.count - 1) {
+		/* The report of the last ranging in the timeslot is still in the library */
+		nrf_dm_populate_report(report);
+	}
+
 	if (IS_ENABLED(CONFIG_DM_MODULE_RPC_HOST)) {
 		struct dm_rpc_process_data *data;
 
 		data = dm_rpc_get_buffer(sizeof(*data));
 		if (data) {
-			nrf_dm_populate_report(&data->report);
-			bt_addr_le_copy(&data->bt_addr, &timeslot_ctx.curr_req.dm_req.bt_addr);
+			memcpy(&data->report, report, sizeof(data->report));
+			bt_addr_le_copy(&data->bt_addr, &dm_req->bt_addr);
 			dm_rpc_calc_and_process(data, sizeof(*data));
 		}
 	} else {
-		static nrf_dm_report_t report;
 		float high_precision_estimate = 0;
 
-		nrf_dm_populate_report(&report);
-		nrf_dm_calc(&report);
+		nrf_dm_calc(report);
 
 #ifdef CONFIG_DM_HIGH_PRECISION_CALC
-		if (report.ranging_mode == NRF_DM_RANGING_MODE_MCPD) {
-			high_precision_estimate = nrf_dm_high_precision_calc(&report);
+		if (report->ranging_mode == NRF_DM_RANGING_MODE_MCPD) {
+			high_precision_estimate = nrf_dm_high_precision_calc(report);
 		}
 #endif
-		process_data(&report, high_precision_estimate);
+		process_data(dm_req, timeslot_ctx.status[idx], report, high_precision_estimate);
 		if (dm_context.cb->data_ready != NULL) {
 			dm_context.cb->data_ready(&result);
 		}
@@ -433,12 +558,15 @@ static void dm_thread(void)
 				dm_start_ranging();
 				break;
 			case TIMESLOT_NORMAL_END:
+				stats_timeslot_end();
 				dm_reschedule();
-				if (dm_context.nrf_dm_status == NRF_DM_STATUS_SUCCESS) {
-					calculation();
-				} else {
-					LOG_DBG("Ranging failed (nrf_dm status: %d)",
-									  dm_context.nrf_dm_status);
+				for (uint8_t i = 0; i < timeslot_ctx.curr.count; i++) {
+					if (timeslot_ctx.status[i] == NRF_DM_STATUS_SUCCESS) {
+						calculation(i);
+					} else {
+						LOG_DBG("Ranging failed (nrf_dm status: %d)",
+							timeslot_ctx.status[i]);
+					}
 				}
 
 				atomic_set(&timeslot_ctx.state, TIMESLOT_STATE_IDLE);
@@ -479,6 +607,42 @@ int dm_request_add(struct dm_request *req)
 	return err;
 }
 
+int dm_stats_get(struct dm_stats *dm_stats, bool reset)
+{
+	k_spinlock_key_t key;
+	int64_t now;
+
+	if (!dm_stats) {
+		return -EINVAL;
+	}
+
+	key = k_spin_lock(&stats.lock);
+	now = k_uptime_get();
+
+	dm_stats->period_ms = now - stats.start;
+	dm_stats->ranging_cnt = stats.ranging_cnt;
+	dm_stats->ranging_fail_cnt = stats.ranging_fail_cnt;
+	dm_stats->missed_cnt = stats.missed_cnt;
+	dm_stats->timeslot_cnt = stats.timeslot_cnt;
+	dm_stats->ranging_rate = dm_stats->period_ms ?
+		stats.ranging_cnt * 1000.0f / dm_stats->period_ms : 0.0f;
+	dm_stats->timeslot_utilization = stats.timeslot_us ?
+		stats.ranging_us * 100 / stats.timeslot_us : 0;
+
+	if (reset) {
+		stats.ranging_cnt = 0;
+		stats.ranging_fail_cnt = 0;
+		stats.missed_cnt = 0;
+		stats.timeslot_cnt = 0;
+		stats.ranging_us = 0;
+		stats.timeslot_us = 0;
+		stats.start = now;
+	}
+
+	k_spin_unlock(&stats.lock, key);
+
+	return 0;
+}
 
 int dm_init(struct dm_init_param *init_param)
 {
@@ -514,6 +678,7 @@ int dm_init(struct dm_init_param *init_param)
 	LOG_DBG("Initialized NRF_DM version %s", ver);
 
 	dm_context.cb = init_param->cb;
+	stats.start = k_uptime_get();
 
 	err = dm_io_init();
 	if (err) {
@@ -49,6 +49,15 @@ int dm_request_add(struct dm_request *req)
 	return res;
 }
 
+int dm_stats_get(struct dm_stats *stats, bool reset)
+{
+	ARG_UNUSED(stats);
+	ARG_UNUSED(reset);
+
+	/* The rangings are executed and counted on the other core */
+	return -ENOTSUP;
+}
+
 int dm_init(struct dm_init_param *init_param)
 {
 	int result;
@@ -21,3 +21,8 @@ uint32_t time_distance_get(uint32_t t1, uint32_t t2)
 
 	return t2 - t1;
 }
+
+bool time_before(uint32_t t1, uint32_t t2)
+{
+	return t1 != t2 && time_distance_get(t1, t2) < RTC_COUNTER_MAX / 2;
+}
@@ -7,6 +7,7 @@
 #ifndef _TIME_H_
 #define _TIME_H_
 
+#include <stdbool.h>
 #include <zephyr/types.h>
 #include "hal/nrf_rtc.h"
 
@@ -36,6 +37,18 @@ uint32_t time_now(void);
  */
 uint32_t time_distance_get(uint32_t t1, uint32_t t2);
 
+/** @brief Check if t1 is before t2.
+ *
+ *  The time ticks wrap around, so t1 is before t2 if t2 is less than half
+ *  the counter range after t1.
+ *
+ *  @param t1 First time.
+ *  @param t2 Second time.
+ *
+ *  @retval True if t1 is before t2, false otherwise.
+ */
+bool time_before(uint32_t t1, uint32_t t2);
+
 #ifdef __cplusplus
 }
 #endif
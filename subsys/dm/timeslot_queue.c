@@ -14,47 +14,48 @@
 #define MIN_TIME_BETWEEN_TIMESLOTS_US    CONFIG_DM_MIN_TIME_BETWEEN_TIMESLOTS_US
 #define RANGING_OFFSET_US                CONFIG_DM_RANGING_OFFSET_US
 
-static K_MUTEX_DEFINE(list_mtx);
-static sys_slist_t timeslot_list = SYS_SLIST_STATIC_INIT(&timeslot_list);
+#define PACK_MAX                         CONFIG_DM_TIMESLOT_PACK_MAX
+#if PACK_MAX > 1
+#define PACK_GUARD_US                    CONFIG_DM_TIMESLOT_PACK_GUARD_US
+#define PACK_LENGTH_MAX_US               CONFIG_DM_TIMESLOT_PACK_LENGTH_MAX_US
+#endif
+
+static K_MUTEX_DEFINE(queue_mtx);
 
 struct timeslot_entry {
 	struct timeslot_request timeslot_req;
-	sys_snode_t node;
+	bool used;
 };
 
-static K_HEAP_DEFINE(heap, TIMESLOT_QUEUE_LENGTH * sizeof(struct timeslot_entry));
+/* The requests are stored in a fixed pool. The queue order is kept in a separate
+ * array of pool indexes sorted by start time, so that adding a request in the
+ * middle of the queue only moves the indexes.
+ */
+static struct timeslot_entry pool[TIMESLOT_QUEUE_LENGTH];
+static uint8_t order[TIMESLOT_QUEUE_LENGTH];
+static size_t queue_len;
 
-static void list_lock(void)
+static void queue_lock(void)
 {
-	k_mutex_lock(&list_mtx, K_FOREVER);
+	k_mutex_lock(&queue_mtx, K_FOREVER);
 }
 
-static void list_unlock(void)
+static void queue_unlock(void)
 {
-	k_mutex_unlock(&list_mtx);
+	k_mutex_unlock(&queue_mtx);
 }
 
-static size_t get_list_size(void)
+static struct timeslot_request *queue_get(size_t pos)
 {
-	size_t ret = 0;
-	sys_snode_t *node, *tmp;
-
-	SYS_SLIST_FOR_EACH_NODE_SAFE(&timeslot_list, node, tmp) {
-		ret++;
-	}
-
-	return ret;
+	return &pool[order[pos]].timeslot_req;
 }
 
 static bool is_request_exist(struct dm_request *req)
 {
 	uint8_t cnt = 0;
-	sys_snode_t *node, *tmp;
-	struct timeslot_entry *item;
 
-	SYS_SLIST_FOR_EACH_NODE_SAFE(&timeslot_list, node, tmp) {
-		item = CONTAINER_OF(node, struct timeslot_entry, node);
-		if (bt_addr_le_cmp(&item->timeslot_req.dm_req.bt_addr, &req->bt_addr) == 0) {
+	for (size_t i = 0; i < queue_len; i++) {
+		if (bt_addr_le_cmp(&queue_get(i)->dm_req.bt_addr, &req->bt_addr) == 0) {
 			cnt++;
 		}
 	}
@@ -62,86 +63,212 @@ static bool is_request_exist(struct dm_request *req)
 	return cnt >= TIMESLOT_QUEUE_COUNT_SAME_PEER;
 }
 
+/* Time from the start of the timeslot to the end of the ranging, if it shares the
+ * timeslot starting at first.
+ */
+static uint32_t packed_length_us(const struct timeslot_request *first,
+				 const struct timeslot_request *req)
+{
+	return TICKS_TO_US(time_distance_get(first->start_time, req->start_time)) +
+	       req->timeslot_length_us;
+}
+
+static bool is_packable(const struct timeslot_request *first,
+			const struct timeslot_request *prev,
+			const struct timeslot_request *next)
+{
+#if PACK_MAX > 1
+	uint32_t distance = time_distance_get(prev->start_time, next->start_time);
+
+	return distance >= US_TO_RTC_TICKS(prev->window_length_us + PACK_GUARD_US) &&
+	       packed_length_us(first, next) <= PACK_LENGTH_MAX_US;
+#else
+	return false;
+#endif
+}
+
+static bool is_separate(const struct timeslot_request *first, uint32_t timeslot_length_us,
+			const struct timeslot_request *next)
+{
+	uint32_t distance = time_distance_get(first->start_time, next->start_time);
+
+	return distance >= US_TO_RTC_TICKS(timeslot_length_us + MIN_TIME_BETWEEN_TIMESLOTS_US);
+}
+
+/* Check that every ranging in the queue still gets a timeslot if new_req is added at
+ * pos. The rangings are put in timeslots the same way as by timeslot_queue_group_get().
+ */
+static bool is_schedulable(const struct timeslot_request *new_req, size_t pos)
+{
+	const struct timeslot_request *first = NULL;
+	const struct timeslot_request *last = NULL;
+	const struct timeslot_request *req;
+	uint8_t count = 0;
+
+	for (size_t i = 0; i <= queue_len; i++) {
+		if (i == pos) {
+			req = new_req;
+		} else {
+			req = queue_get(i < pos ? i : i - 1);
+		}
+
+		if (first && count < PACK_MAX && is_packable(first, last, req)) {
+			last = req;
+			count++;
+			continue;
+		}
+
+		if (first && !is_separate(first, packed_length_us(first, last), req)) {
+			return false;
+		}
+
+		first = req;
+		last = req;
+		count = 1;
+	}
+
+	return true;
+}
+
+static int free_entry_get(void)
+{
+	for (size_t i = 0; i < ARRAY_SIZE(pool); i++) {
+		if (!pool[i].used) {
+			return i;
+		}
+	}
+
+	return -ENOMEM;
+}
+
 int timeslot_queue_append(struct dm_request *req, uint32_t start_ref_tick,
 			  uint32_t window_len_us, uint32_t timeslot_len_us)
 {
-	uint32_t distance;
-	uint32_t start_time;
+	struct timeslot_request new_req;
 	uint32_t delay;
-	size_t list_size;
-	struct timeslot_entry *last, *item;
+	size_t pos;
+	int idx;
+	int err = 0;
 
 	delay = req->start_delay_us + RANGING_OFFSET_US;
-	start_time = (start_ref_tick + US_TO_RTC_TICKS(delay)) % RTC_COUNTER_MAX;
+	new_req.start_time = (start_ref_tick + US_TO_RTC_TICKS(delay)) % RTC_COUNTER_MAX;
+	new_req.timeslot_length_us = timeslot_len_us;
+	new_req.window_length_us = window_len_us;
 
-	list_size = get_list_size();
-	if (list_size >= TIMESLOT_QUEUE_LENGTH) {
-		return -ENOMEM;
-	}
+	queue_lock();
 
-	if (list_size != 0) {
-		if (is_request_exist(req)) {
-			return -EAGAIN;
-		}
+	if (queue_len >= TIMESLOT_QUEUE_LENGTH) {
+		err = -ENOMEM;
+		goto out;
+	}
 
-		list_lock();
-		last = SYS_SLIST_PEEK_TAIL_CONTAINER(&timeslot_list, last, node);
-		list_unlock();
+	if (is_request_exist(req)) {
+		err = -EAGAIN;
+		goto out;
+	}
 
-		distance = time_distance_get(last->timeslot_req.start_time, start_time);
-		if (distance < US_TO_RTC_TICKS(last->timeslot_req.timeslot_length_us +
-					       MIN_TIME_BETWEEN_TIMESLOTS_US)) {
-			return -EBUSY;
+	/* Requests mostly arrive in the order of their start time, search from the end. */
+	for (pos = queue_len; pos > 0; pos--) {
+		if (!time_before(new_req.start_time, queue_get(pos - 1)->start_time)) {
+			break;
 		}
 	}
 
-	item = k_heap_alloc(&heap, sizeof(struct timeslot_entry), K_NO_WAIT);
-	if (!item) {
-		return -ENOMEM;
+	if (!is_schedulable(&new_req, pos)) {
+		err = -EBUSY;
+		goto out;
+	}
+
+	idx = free_entry_get();
+	if (idx < 0) {
+		err = idx;
+		goto out;
 	}
 
-	item->timeslot_req.start_time = start_time;
-	item->timeslot_req.timeslot_length_us = timeslot_len_us;
-	item->timeslot_req.window_length_us = window_len_us;
 	req->rng_seed++;
+	memcpy(&new_req.dm_req, req, sizeof(new_req.dm_req));
 
-	memcpy(&item->timeslot_req.dm_req, req, sizeof(item->timeslot_req.dm_req));
+	pool[idx].timeslot_req = new_req;
+	pool[idx].used = true;
 
-	list_lock();
-	sys_slist_append(&timeslot_list, &item->node);
-	list_unlock();
+	memmove(&order[pos + 1], &order[pos], queue_len - pos);
+	order[pos] = idx;
+	queue_len++;
 
-	return 0;
+out:
+	queue_unlock();
+
+	return err;
 }
 
-struct timeslot_request *timeslot_queue_peek(void)
+static void queue_remove_first(size_t cnt)
 {
-	struct timeslot_entry *item;
+	for (size_t i = 0; i < cnt; i++) {
+		pool[order[i]].used = false;
+	}
+
+	queue_len -= cnt;
+	memmove(&order[0], &order[cnt], queue_len);
+}
 
-	list_lock();
-	item = SYS_SLIST_PEEK_HEAD_CONTAINER(&timeslot_list, item, node);
-	list_unlock();
+static size_t queue_count_before(uint32_t time)
+{
+	size_t cnt = 0;
 
-	if (!item) {
-		return NULL;
+	while (cnt < queue_len && !time_before(time, queue_get(cnt)->start_time)) {
+		cnt++;
 	}
 
-	return &item->timeslot_req;
+	return cnt;
 }
 
-void timeslot_queue_remove_first(void)
+int timeslot_queue_group_get(uint32_t now, struct timeslot_group *group)
 {
-	sys_snode_t *node;
-	struct timeslot_entry *item;
+	struct timeslot_request *first;
+	struct timeslot_request *last;
+	size_t missed;
+
+	queue_lock();
+
+	/* Rangings that should have started already have no peer to range with. */
+	missed = queue_count_before(now);
+	queue_remove_first(missed);
+
+	group->missed = missed;
+	group->count = 0;
 
-	list_lock();
-	node = sys_slist_get(&timeslot_list);
-	list_unlock();
+	if (queue_len == 0) {
+		queue_unlock();
+		return -ENOENT;
+	}
+
+	first = queue_get(0);
+	last = first;
+	group->req[group->count++] = *first;
 
-	if (!node) {
-		return;
+	while (group->count < ARRAY_SIZE(group->req) && group->count < queue_len &&
+	       is_packable(first, last, queue_get(group->count))) {
+		last = queue_get(group->count);
+		group->req[group->count++] = *last;
 	}
 
-	item = CONTAINER_OF(node, struct timeslot_entry, node);
-	k_heap_free(&heap, item);
+	group->start_time = first->start_time;
+	group->timeslot_length_us = packed_length_us(first, last);
+
+	queue_remove_first(group->count);
+
+	/* After dropping missed rangings, the following rangings may be put in
+	 * timeslots differently than when they were added. Rangings that neither fit in
+	 * this timeslot nor leave enough time after it can't be executed.
+	 */
+	missed = queue_count_before((group->start_time +
+				     US_TO_RTC_TICKS(group->timeslot_length_us +
+						     MIN_TIME_BETWEEN_TIMESLOTS_US)) %
+				    RTC_COUNTER_MAX);
+	queue_remove_first(missed);
+	group->missed += missed;
+
+	queue_unlock();
+
+	return 0;
 }
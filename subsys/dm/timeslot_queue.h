@@ -29,33 +29,55 @@ struct timeslot_request {
 	uint32_t window_length_us;
 };
 
-/** @brief Append an element to the end of a queue.
+/** @brief Rangings executed in a single timeslot */
+struct timeslot_group {
+	/* Rangings in the order of their start time */
+	struct timeslot_request req[CONFIG_DM_TIMESLOT_PACK_MAX];
+
+	/* Number of rangings */
+	uint8_t count;
+
+	/* Number of rangings dropped, because their start time passed */
+	uint8_t missed;
+
+	/* The desired start time of timeslot, the start time of the first ranging */
+	uint32_t start_time;
+
+	/* Timeslot length */
+	uint32_t timeslot_length_us;
+};
+
+/** @brief Add a ranging to the queue.
+ *
+ *  The queue is ordered by the start time of the rangings. A ranging is only added
+ *  if it leaves enough time to the neighboring rangings, either to have its own
+ *  timeslot, or to share a timeslot with them.
  *
  *  @param req Address of the structure with request parameters.
  *  @param start_ref_tick Reference start time tick.
  *  @param window_len Ranging window length.
  *  @param timeslot_len Timeslot length.
  *
- *  @retval -ENOMEM when the tiemslot queue is full or a memory allocation error.
+ *  @retval -ENOMEM when the timeslot queue is full.
  *  @retval -EAGAIN when a single peer has a maximum number of timeslots scheduled.
  *  @retval -EBUSY when the timeslot cannot be scheduled due to time restrictions.
  */
 int timeslot_queue_append(struct dm_request *req, uint32_t start_ref_tick,
 			  uint32_t window_len, uint32_t timeslot_len);
 
-/** @brief Peek element at the head of queue.
+/** @brief Remove the rangings of the next timeslot from the queue.
  *
- *  @param None
+ *  Takes the first ranging in the queue, and the rangings following it that fit
+ *  in the same timeslot. Rangings with a start time before @p now are dropped.
  *
- *  @retval Head element, or NULL if queue is empty.
- */
-struct timeslot_request *timeslot_queue_peek(void);
-
-/** @brief Remove the first item from the timeslot queue.
+ *  @param now Current time tick.
+ *  @param group Rangings of the timeslot.
  *
- *  @param None
+ *  @retval 0 if a timeslot is needed.
+ *  @retval -ENOENT when the queue is empty. The number of dropped rangings is
+ *          still reported in the group.
  */
-void timeslot_queue_remove_first(void);
+int timeslot_queue_group_get(uint32_t now, struct timeslot_group *group);
 
 #ifdef __cplusplus
 }
@@ -9,6 +9,8 @@
 #include <zephyr/kernel.h>
 #include <zephyr/storage/flash_map.h>
 #include <zephyr/drivers/flash.h>
+#include <zephyr/sys/crc.h>
+#include <debug/perf_counter.h>
 #include "emds_flash.h"
 
 #include <zephyr/logging/log.h>
@@ -67,6 +69,63 @@ static int emds_fs_init(void)
 }
 
 
+static bool entry_is_dirty(const struct emds_entry *entry)
+{
+#if defined(CONFIG_EMDS_INCREMENTAL_STORE)
+	return !entry->state->stored ||
+	       (entry->state->hash != crc32_ieee(entry->data, entry->len));
+#else
+	return true;
+#endif
+}
+
+static void entry_state_update(const struct emds_entry *entry)
+{
+#if defined(CONFIG_EMDS_INCREMENTAL_STORE)
+	/* Only the data that is already in flash can be skipped by the next store */
+	entry->state->stored = !emds_flash_cmp(&emds_flash, entry->id, entry->data, entry->len);
+	entry->state->hash = crc32_ieee(entry->data, entry->len);
+#endif
+}
+
+static void entry_store(const struct emds_entry *entry, const char *type)
+{
+	ssize_t len;
+
+	if (!entry_is_dirty(entry)) {
+		return;
+	}
+
+	len = emds_flash_write(&emds_flash, entry->id, entry->data, entry->len);
+	if (len < 0) {
+		LOG_ERR("Write %s entry: (%d) error (%d)", type, entry->id, len);
+	} else if (len != entry->len) {
+		LOG_ERR("Write %s entry: (%d) failed (%d:%d)", type, entry->id, entry->len, len);
+	}
+}
+
+static uint32_t entry_store_time_get(const struct emds_entry *entry, bool dirty)
+{
+	size_t block_size = emds_flash.flash_params->write_block_size;
+	uint32_t store_time_us = 0;
+
+#if defined(CONFIG_EMDS_INCREMENTAL_STORE)
+	/* The data is hashed to check whether it changed */
+	store_time_us += NRFX_CEIL_DIV(NRFX_CEIL_DIV(entry->len, 4) *
+				       CONFIG_EMDS_INCREMENTAL_STORE_HASH_ONE_WORD_NS, 1000);
+#endif
+
+	if (dirty) {
+		store_time_us += NRFX_CEIL_DIV(entry->len, block_size) *
+					CONFIG_EMDS_FLASH_TIME_WRITE_ONE_WORD_US
+			       + NRFX_CEIL_DIV(emds_flash.ate_size, block_size) *
+					CONFIG_EMDS_FLASH_TIME_WRITE_ONE_WORD_US
+			       + CONFIG_EMDS_FLASH_TIME_ENTRY_OVERHEAD_US;
+	}
+
+	return store_time_us;
+}
+
 static int emds_entries_size(uint32_t *size)
 {
 	size_t block_size = emds_flash.flash_params->write_block_size;
@@ -130,6 +189,11 @@ int emds_entry_add(struct emds_dynamic_entry *entry)
 		}
 	}
 
+#if defined(CONFIG_EMDS_INCREMENTAL_STORE)
+	entry->entry.state = &entry->state;
+	entry->state.stored = false;
+#endif
+
 	sys_slist_append(&emds_dynamic_entries, &entry->node);
 
 	emds_ready = false;
@@ -152,30 +216,13 @@ int emds_store(void)
 	LOG_DBG("Emergency Data Storeage released");
 
 	STRUCT_SECTION_FOREACH(emds_entry, ch) {
-		ssize_t len = emds_flash_write(&emds_flash,
-					       ch->id, ch->data, ch->len);
-		if (len < 0) {
-			LOG_ERR("Write static entry: (%d) error (%d)",
-				ch->id, len);
-		} else if (len != ch->len) {
-			LOG_ERR("Write static entry: (%d) failed (%d:%d)",
-				ch->id, ch->len, len);
-		}
+		entry_store(ch, "static");
 	}
 
 	struct emds_dynamic_entry *ch;
 
 	SYS_SLIST_FOR_EACH_CONTAINER(&emds_dynamic_entries, ch, node) {
-		ssize_t len = emds_flash_write(&emds_flash,
-					       ch->entry.id, ch->entry.data, ch->entry.len);
-		if (len < 0) {
-			LOG_ERR("Write dynamic entry: (%d) error (%d).",
-				ch->entry.id, len);
-		}
-		if (len != ch->entry.len) {
-			LOG_ERR("Write dynamic entry: (%d) failed (%d:%d).",
-				ch->entry.id, ch->entry.len, len);
-		}
+		entry_store(&ch->entry, "dynamic");
 	}
 
 	emds_ready = false;
@@ -252,43 +299,62 @@ int emds_prepare(void)
 
 	(void)emds_entries_size(&size);
 
-	rc = emds_flash_prepare(&emds_flash, size);
+	if (IS_ENABLED(CONFIG_EMDS_INCREMENTAL_STORE)) {
+		/* Make room for all entries, in case they all change before the store */
+		rc = emds_flash_incremental_prepare(&emds_flash, size);
+	} else {
+		rc = emds_flash_prepare(&emds_flash, size);
+	}
+
 	if (rc) {
 		return rc;
 	}
 
+	STRUCT_SECTION_FOREACH(emds_entry, ch) {
+		entry_state_update(ch);
+	}
+
+	struct emds_dynamic_entry *ch;
+
+	SYS_SLIST_FOR_EACH_CONTAINER(&emds_dynamic_entries, ch, node) {
+		entry_state_update(&ch->entry);
+	}
+
 	emds_ready = true;
 
 	return 0;
 }
 
-uint32_t emds_store_time_get(void)
+static uint32_t store_time_get(bool worst_case)
 {
-	size_t block_size = emds_flash.flash_params->write_block_size;
 	uint32_t store_time_us = CONFIG_EMDS_FLASH_TIME_BASE_OVERHEAD_US;
 
-
 	STRUCT_SECTION_FOREACH(emds_entry, ch) {
-		store_time_us += NRFX_CEIL_DIV(ch->len, block_size) *
-					CONFIG_EMDS_FLASH_TIME_WRITE_ONE_WORD_US
-			       + NRFX_CEIL_DIV(emds_flash.ate_size, block_size) *
-					CONFIG_EMDS_FLASH_TIME_WRITE_ONE_WORD_US
-			       + CONFIG_EMDS_FLASH_TIME_ENTRY_OVERHEAD_US;
+		store_time_us += entry_store_time_get(ch, worst_case || entry_is_dirty(ch));
 	}
 
 	struct emds_dynamic_entry *ch;
 
 	SYS_SLIST_FOR_EACH_CONTAINER(&emds_dynamic_entries, ch, node) {
-		store_time_us += NRFX_CEIL_DIV(ch->entry.len, block_size) *
-					CONFIG_EMDS_FLASH_TIME_WRITE_ONE_WORD_US
-			       + NRFX_CEIL_DIV(emds_flash.ate_size, block_size) *
-					CONFIG_EMDS_FLASH_TIME_WRITE_ONE_WORD_US
-			       + CONFIG_EMDS_FLASH_TIME_ENTRY_OVERHEAD_US;
+		store_time_us += entry_store_time_get(&ch->entry,
+						      worst_case || entry_is_dirty(&ch->entry));
 	}
 
 	return store_time_us;
 }
 
+uint32_t emds_store_time_get(void)
+{
+	return store_time_get(true);
+}
+
+PERF_GAUGE_DEFINE(emds_store_time, "us", emds_store_time_get);
+
+uint32_t emds_dirty_store_time_get(void)
+{
+	return store_time_get(false);
+}
+
 uint32_t emds_store_size_get(void)
 {
 	uint32_t store_size;
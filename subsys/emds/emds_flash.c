@@ -477,25 +477,19 @@ ssize_t emds_flash_write(struct emds_fs *fs, uint16_t id, const void *data, size
 	return len;
 }
 
-ssize_t emds_flash_read(struct emds_fs *fs, uint16_t id, void *data, size_t len)
+static int ate_latest_find(struct emds_fs *fs, uint16_t id, struct emds_ate *entry)
 {
-	if (!fs->is_initialized) {
-		LOG_ERR("EMDS flash not initialized");
-		return -EACCES;
-	}
-
 	int rc;
 	uint32_t wlk_addr = fs->ate_wra;
-	struct emds_ate wlk_ate;
 
 	while (true) {
-		rc = flash_read(fs->flash_dev, wlk_addr, &wlk_ate, sizeof(struct emds_ate));
+		rc = flash_read(fs->flash_dev, wlk_addr, entry, sizeof(struct emds_ate));
 		if (rc) {
 			return rc;
 		}
 
-		if ((wlk_ate.id == id) && (is_ate_valid(&wlk_ate))) {
-			break;
+		if ((entry->id == id) && (is_ate_valid(entry))) {
+			return 0;
 		}
 
 		wlk_addr += fs->ate_size;
@@ -503,6 +497,22 @@ ssize_t emds_flash_read(struct emds_fs *fs, uint16_t id, void *data, size_t len)
 			return -ENXIO;
 		}
 	}
+}
+
+ssize_t emds_flash_read(struct emds_fs *fs, uint16_t id, void *data, size_t len)
+{
+	if (!fs->is_initialized) {
+		LOG_ERR("EMDS flash not initialized");
+		return -EACCES;
+	}
+
+	int rc;
+	struct emds_ate wlk_ate;
+
+	rc = ate_latest_find(fs, id, &wlk_ate);
+	if (rc) {
+		return rc;
+	}
 
 	if (len < wlk_ate.len) {
 		return -ENOMEM;
@@ -520,7 +530,50 @@ ssize_t emds_flash_read(struct emds_fs *fs, uint16_t id, void *data, size_t len)
 	return wlk_ate.len;
 }
 
-int emds_flash_prepare(struct emds_fs *fs, int byte_size)
+int emds_flash_cmp(struct emds_fs *fs, uint16_t id, const void *data, size_t len)
+{
+	if (!fs->is_initialized) {
+		LOG_ERR("EMDS flash not initialized");
+		return -EACCES;
+	}
+
+	int rc;
+	struct emds_ate wlk_ate;
+	const uint8_t *data8 = (const uint8_t *)data;
+	uint8_t buf[8 * EMDS_FLASH_BLOCK_SIZE];
+	off_t offset;
+
+	rc = ate_latest_find(fs, id, &wlk_ate);
+	if (rc) {
+		return rc;
+	}
+
+	if (wlk_ate.len != len) {
+		return 1;
+	}
+
+	offset = fs->offset + wlk_ate.offset;
+	while (len) {
+		size_t chunk = MIN(len, sizeof(buf));
+
+		rc = flash_read(fs->flash_dev, offset, buf, chunk);
+		if (rc) {
+			return rc;
+		}
+
+		if (memcmp(buf, data8, chunk)) {
+			return 1;
+		}
+
+		offset += chunk;
+		data8 += chunk;
+		len -= chunk;
+	}
+
+	return 0;
+}
+
+static int prepare(struct emds_fs *fs, int byte_size, bool invalidate)
 {
 	if (!fs->is_initialized) {
 		LOG_ERR("EMDS flash not initialized");
@@ -531,10 +584,12 @@ int emds_flash_prepare(struct emds_fs *fs, int byte_size)
 		return -ENOMEM;
 	}
 
-	int rc = old_entries_invalidate(fs);
+	if (invalidate) {
+		int rc = old_entries_invalidate(fs);
 
-	if (rc) {
-		return rc;
+		if (rc) {
+			return rc;
+		}
 	}
 
 	if (fs->force_erase || (byte_size > emds_flash_free_space_get(fs))) {
@@ -546,6 +601,16 @@ int emds_flash_prepare(struct emds_fs *fs, int byte_size)
 	return 0;
 }
 
+int emds_flash_prepare(struct emds_fs *fs, int byte_size)
+{
+	return prepare(fs, byte_size, true);
+}
+
+int emds_flash_incremental_prepare(struct emds_fs *fs, int byte_size)
+{
+	return prepare(fs, byte_size, false);
+}
+
 ssize_t emds_flash_free_space_get(struct emds_fs *fs)
 {
 	ssize_t space = fs->ate_wra - (fs->data_wra_offset + fs->offset);
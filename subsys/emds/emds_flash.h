@@ -118,6 +118,36 @@ ssize_t emds_flash_read(struct emds_fs *fs, uint16_t id, void *data, size_t len)
  */
 int emds_flash_prepare(struct emds_fs *fs, int byte_size);
 
+/**
+ * @brief Prepare EMDS file system for next write events, keeping the prior entries.
+ *
+ * Same as @ref emds_flash_prepare, except that the prior entries are not invalidated,
+ * so that they can still be read until a newer entry with the same ID is written.
+ * If there is not enough free space for the next write events, the flash area is cleared,
+ * and the prior entries are lost.
+ *
+ * @param fs Pointer to file system
+ * @param byte_size Total number of bytes
+ *
+ * @retval 0 on success or negative error code
+ */
+int emds_flash_incremental_prepare(struct emds_fs *fs, int byte_size);
+
+/**
+ * @brief Compare the latest entry with an ID to a data buffer.
+ *
+ * @param fs Pointer to file system
+ * @param id Id of the entry to be compared
+ * @param data Pointer to data buffer
+ * @param len Number of bytes in data buffer
+ *
+ * @retval 0 if the entry has the same length and content as the data buffer
+ * @retval 1 if the entry differs from the data buffer
+ * @retval -ENXIO if there is no valid entry with the ID
+ * @retval Other negative error code on failure
+ */
+int emds_flash_cmp(struct emds_fs *fs, uint16_t id, const void *data, size_t len);
+
 /**
  * @brief Get remaining raw space on the flash device.
  *
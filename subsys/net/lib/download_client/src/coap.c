@@ -23,7 +23,21 @@ LOG_MODULE_DECLARE(download_client, CONFIG_DOWNLOAD_CLIENT_LOG_LEVEL);
 extern char *strtok_r(char *str, const char *sep, char **state);
 
 int url_parse_file(const char *url, char *file, size_t len);
-int socket_send(const struct download_client *client, size_t len, int timeout);
+int socket_send(const struct download_client *client, const char *buf, size_t len, int timeout);
+
+#if defined(CONFIG_DOWNLOAD_CLIENT_COAP_WINDOW_SIZE)
+#define WINDOW_SIZE CONFIG_DOWNLOAD_CLIENT_COAP_WINDOW_SIZE
+#else
+#define WINDOW_SIZE 1
+#endif
+
+#if WINDOW_SIZE > 1
+#define BLOCK_BYTES (1 << (CONFIG_DOWNLOAD_CLIENT_COAP_BLOCK_SIZE + 4))
+
+/* The consecutive blocks of the window are given to the application as one fragment */
+BUILD_ASSERT(CONFIG_DOWNLOAD_CLIENT_BUF_SIZE >= WINDOW_SIZE * BLOCK_BYTES,
+	     "CONFIG_DOWNLOAD_CLIENT_BUF_SIZE must fit CONFIG_DOWNLOAD_CLIENT_COAP_WINDOW_SIZE blocks");
+#endif
 
 static int coap_get_current_from_response_pkt(const struct coap_packet *cpkt)
 {
@@ -37,31 +51,52 @@ static int coap_get_current_from_response_pkt(const struct coap_packet *cpkt)
 	return GET_BLOCK_NUM(block) << (GET_BLOCK_SIZE(block) + 4);
 }
 
-static bool has_pending(struct download_client *client)
-{
-	return client->coap.pending.timeout > 0;
-}
-
 int coap_block_init(struct download_client *client, size_t from)
 {
 	coap_block_transfer_init(&client->coap.block_ctx,
 				 CONFIG_DOWNLOAD_CLIENT_COAP_BLOCK_SIZE, 0);
 	client->coap.block_ctx.current = from;
 	coap_pending_clear(&client->coap.pending);
+#if WINDOW_SIZE > 1
+	memset(client->coap.window, 0, sizeof(client->coap.window));
+	client->coap.next_block = from / BLOCK_BYTES;
+#endif
 	return 0;
 }
 
+static int pending_time_left(const struct coap_pending *pending)
+{
+	return pending->t0 + pending->timeout - k_uptime_get_32();
+}
+
 int coap_get_recv_timeout(struct download_client *dl)
 {
 	int timeout;
 
-	__ASSERT(has_pending(dl), "Must have coap pending");
+#if WINDOW_SIZE > 1
+	bool pending = false;
+
+	/* Wait until the first of the blocks in flight times out */
+	timeout = 0;
+	for (size_t i = 0; i < WINDOW_SIZE; i++) {
+		if (dl->coap.window[i].pending.timeout > 0) {
+			int left = pending_time_left(&dl->coap.window[i].pending);
+
+			timeout = pending ? MIN(timeout, left) : left;
+			pending = true;
+		}
+	}
+
+	__ASSERT(pending, "Must have coap pending");
+#else
+	__ASSERT(dl->coap.pending.timeout > 0, "Must have coap pending");
 
 	/* Retransmission is cycled in case recv() times out. In case sending request
 	 * blocks, the time that is used for sending request must be substracted next time
 	 * recv() is called.
 	 */
-	timeout = dl->coap.pending.t0 + dl->coap.pending.timeout - k_uptime_get_32();
+	timeout = pending_time_left(&dl->coap.pending);
+#endif
 	if (timeout < 0) {
 		/* All time is spent when sending request and time this
 		 * method is called, there is no time left for receiving;
@@ -76,6 +111,35 @@ int coap_get_recv_timeout(struct download_client *dl)
 
 int coap_initiate_retransmission(struct download_client *dl)
 {
+#if WINDOW_SIZE > 1
+	bool pending = false;
+
+	/* Only the blocks that timed out are requested again */
+	for (size_t i = 0; i < WINDOW_SIZE; i++) {
+		struct download_client_coap_block *block = &dl->coap.window[i];
+
+		if (block->pending.timeout == 0) {
+			continue;
+		}
+
+		pending = true;
+
+		if (pending_time_left(&block->pending) > 0) {
+			continue;
+		}
+
+		if (!coap_pending_cycle(&block->pending)) {
+			LOG_ERR("CoAP max-retransmissions exceeded");
+			return -1;
+		}
+
+		block->resend = true;
+	}
+
+	if (!pending) {
+		return -EINVAL;
+	}
+#else
 	if (dl->coap.pending.timeout == 0) {
 		return -EINVAL;
 	}
@@ -84,6 +148,7 @@ int coap_initiate_retransmission(struct download_client *dl)
 		LOG_ERR("CoAP max-retransmissions exceeded");
 		return -1;
 	}
+#endif
 
 	return 0;
 }
@@ -134,11 +199,168 @@ static int coap_block_update(struct download_client *client, struct coap_packet
 	return 0;
 }
 
+static int response_check(const struct coap_packet *response)
+{
+	uint8_t response_code;
+
+	if (coap_header_get_type(response) != COAP_TYPE_ACK) {
+		LOG_ERR("Response must be of coap type ACK");
+		return -EBADMSG;
+	}
+
+	response_code = coap_header_get_code(response);
+	if (response_code != COAP_RESPONSE_CODE_OK &&
+	    response_code != COAP_RESPONSE_CODE_CONTENT) {
+		LOG_ERR("Server responded with code 0x%x", response_code);
+		return -EBADMSG;
+	}
+
+	return 0;
+}
+
+#if WINDOW_SIZE > 1
+static size_t window_base(const struct download_client *client)
+{
+	return client->coap.block_ctx.current / BLOCK_BYTES;
+}
+
+static struct download_client_coap_block *window_block_get(struct download_client *client,
+							   size_t num)
+{
+	return &client->coap.window[num % WINDOW_SIZE];
+}
+
+static struct download_client_coap_block *window_block_find(struct download_client *client,
+							    const struct coap_packet *response)
+{
+	uint8_t token[COAP_TOKEN_MAX_LEN];
+	uint8_t token_len;
+	uint16_t id;
+
+	token_len = coap_header_get_token(response, token);
+	id = coap_header_get_id(response);
+
+	for (size_t i = 0; i < WINDOW_SIZE; i++) {
+		struct download_client_coap_block *block = &client->coap.window[i];
+
+		if (block->pending.timeout > 0 && block->pending.id == id &&
+		    token_len == sizeof(block->token) &&
+		    !memcmp(block->token, token, token_len)) {
+			return block;
+		}
+	}
+
+	return NULL;
+}
+
+static void window_block_deliver(struct download_client *client,
+				 struct download_client_coap_block *block, const uint8_t *payload)
+{
+	/* Skip the bytes of the block that were downloaded before a reconnection */
+	size_t blk_off = MIN(client->coap.block_ctx.current % BLOCK_BYTES, block->len);
+	size_t len = block->len - blk_off;
+
+	/* The payload of the first block may still be in the buffer, after the header */
+	memmove(client->buf + client->offset, payload + blk_off, len);
+
+	client->offset += len;
+	client->progress += len;
+	client->coap.block_ctx.current += len;
+	block->received = false;
+
+	if (block->last) {
+		/* Mark the end, in case we did not know the total size */
+		client->file_size = client->progress;
+	}
+}
+
+static int window_parse(struct download_client *client, const struct coap_packet *response)
+{
+	int err;
+	int block2;
+	int size2;
+	uint16_t payload_len;
+	const uint8_t *payload;
+	struct download_client_coap_block *block;
+
+	block = window_block_find(client, response);
+	if (!block) {
+		/* Late response to a request that was sent again */
+		LOG_DBG("Response is not pending, ignoring");
+		return 1;
+	}
+
+	coap_pending_clear(&block->pending);
+	block->resend = false;
+
+	err = response_check(response);
+	if (err) {
+		return err;
+	}
+
+	block2 = coap_get_option_int(response, COAP_OPTION_BLOCK2);
+	if (block2 < 0) {
+		LOG_ERR("Failed to get block from CoAP packet, err %d", block2);
+		return -EBADMSG;
+	}
+
+	if (GET_BLOCK_NUM(block2) != block->num ||
+	    GET_BLOCK_SIZE(block2) != client->coap.block_ctx.block_size) {
+		/* Blocks are requested in parallel, so the block size cannot be renegotiated */
+		LOG_ERR("Unexpected block %d of size %d, expected %d of size %d",
+			GET_BLOCK_NUM(block2), GET_BLOCK_SIZE(block2), block->num,
+			client->coap.block_ctx.block_size);
+		return -EBADMSG;
+	}
+
+	size2 = coap_get_option_int(response, COAP_OPTION_SIZE2);
+	if (client->file_size == 0 && size2 > 0) {
+		LOG_DBG("Total size: %d", size2);
+		client->file_size = size2;
+	}
+
+	payload = coap_packet_get_payload(response, &payload_len);
+	if (!payload) {
+		LOG_WRN("No CoAP payload!");
+		return -EBADMSG;
+	}
+
+	if (payload_len > sizeof(block->data)) {
+		LOG_ERR("Payload of %d bytes does not fit in a block", payload_len);
+		return -EBADMSG;
+	}
+
+	block->len = payload_len;
+	block->last = !GET_MORE(block2);
+	block->received = true;
+
+	if (block->num != window_base(client)) {
+		/* Keep the block until the blocks before it are received */
+		LOG_DBG("Block %d received before block %d", block->num, window_base(client));
+		memcpy(block->data, payload, payload_len);
+		return 1;
+	}
+
+	window_block_deliver(client, block, payload);
+
+	/* Give the blocks that were received out of order along with it */
+	while (!block->last) {
+		block = window_block_get(client, window_base(client));
+		if (!block->received || block->num != window_base(client)) {
+			break;
+		}
+
+		window_block_deliver(client, block, block->data);
+	}
+
+	return 0;
+}
+#endif /* WINDOW_SIZE > 1 */
+
 int coap_parse(struct download_client *client, size_t len)
 {
 	int err;
 	size_t blk_off;
-	uint8_t response_code;
 	uint16_t payload_len;
 	const uint8_t *payload;
 	struct coap_packet response;
@@ -154,6 +376,9 @@ int coap_parse(struct download_client *client, size_t len)
 		return -EBADMSG;
 	}
 
+#if WINDOW_SIZE > 1
+	return window_parse(client, &response);
+#endif
 
 	if (coap_header_get_id(&response) != client->coap.pending.id) {
 		LOG_ERR("Response is not pending");
@@ -162,16 +387,9 @@ int coap_parse(struct download_client *client, size_t len)
 
 	coap_pending_clear(&client->coap.pending);
 
-	if (coap_header_get_type(&response) != COAP_TYPE_ACK) {
-		LOG_ERR("Response must be of coap type ACK");
-		return -EBADMSG;
-	}
-
-	response_code = coap_header_get_code(&response);
-	if (response_code != COAP_RESPONSE_CODE_OK &&
-	    response_code != COAP_RESPONSE_CODE_CONTENT) {
-		LOG_ERR("Server responded with code 0x%x", response_code);
-		return -EBADMSG;
+	err = response_check(&response);
+	if (err) {
+		return err;
 	}
 
 	err = coap_block_update(client, &response, &blk_off, &more);
@@ -192,8 +410,8 @@ int coap_parse(struct download_client *client, size_t len)
 	 */
 	LOG_DBG("CoAP response: %d, copying %d bytes",
 		coap_header_get_code(&response), payload_len - blk_off);
-	memcpy(client->buf + client->offset, payload + blk_off,
-	       payload_len - blk_off);
+	memmove(client->buf + client->offset, payload + blk_off,
+		payload_len - blk_off);
 
 	client->offset += payload_len - blk_off;
 	client->progress += payload_len - blk_off;
@@ -206,7 +424,9 @@ int coap_parse(struct download_client *client, size_t len)
 	return 0;
 }
 
-int coap_request_send(struct download_client *client)
+static int block_request_send(struct download_client *client,
+			      struct coap_block_context *block_ctx, struct coap_pending *pending,
+			      const uint8_t *token)
 {
 	int err;
 	uint16_t id;
@@ -215,14 +435,14 @@ int coap_request_send(struct download_client *client)
 	char *path_elem_saveptr;
 	struct coap_packet request;
 
-	if (has_pending(client)) {
-		id = client->coap.pending.id;
+	if (pending->timeout > 0) {
+		id = pending->id;
 	} else {
 		id = coap_next_id();
 	}
 
 	err = coap_packet_init(&request, client->buf, CONFIG_DOWNLOAD_CLIENT_BUF_SIZE, COAP_VER,
-			       COAP_TYPE_CON, 8, coap_next_token(), COAP_METHOD_GET, id);
+			       COAP_TYPE_CON, COAP_TOKEN_MAX_LEN, token, COAP_METHOD_GET, id);
 	if (err) {
 		LOG_ERR("Failed to init CoAP message, err %d", err);
 		return err;
@@ -244,35 +464,34 @@ int coap_request_send(struct download_client *client)
 		}
 	} while ((path_elem = strtok_r(NULL, COAP_PATH_ELEM_DELIM, &path_elem_saveptr)));
 
-	err = coap_append_block2_option(&request, &client->coap.block_ctx);
+	err = coap_append_block2_option(&request, block_ctx);
 	if (err) {
 		LOG_ERR("Unable to add block2 option");
 		return err;
 	}
 
-	err = coap_append_size2_option(&request, &client->coap.block_ctx);
+	err = coap_append_size2_option(&request, block_ctx);
 	if (err) {
 		LOG_ERR("Unable to add size2 option");
 		return err;
 	}
 
-	if (!has_pending(client)) {
+	if (pending->timeout == 0) {
 		struct coap_transmission_parameters params = coap_get_transmission_parameters();
 
 		params.max_retransmission =
 			CONFIG_DOWNLOAD_CLIENT_COAP_MAX_RETRANSMIT_REQUEST_COUNT;
-		err = coap_pending_init(&client->coap.pending, &request, &client->remote_addr,
-					&params);
+		err = coap_pending_init(pending, &request, &client->remote_addr, &params);
 		if (err < 0) {
 			return -EINVAL;
 		}
 
-		coap_pending_cycle(&client->coap.pending);
+		coap_pending_cycle(pending);
 	}
 
-	LOG_DBG("CoAP next block: %d", client->coap.block_ctx.current);
+	LOG_DBG("CoAP next block: %d", block_ctx->current);
 
-	err = socket_send(client, request.offset, client->coap.pending.timeout);
+	err = socket_send(client, client->buf, request.offset, pending->timeout);
 	if (err) {
 		LOG_ERR("Failed to send CoAP request, errno %d", errno);
 		return err;
@@ -284,3 +503,64 @@ int coap_request_send(struct download_client *client)
 
 	return 0;
 }
+
+#if WINDOW_SIZE > 1
+static int window_block_request_send(struct download_client *client,
+				     struct download_client_coap_block *block)
+{
+	struct coap_block_context block_ctx = client->coap.block_ctx;
+
+	block_ctx.current = MAX(block->num * BLOCK_BYTES, client->coap.block_ctx.current);
+
+	return block_request_send(client, &block_ctx, &block->pending, block->token);
+}
+
+static int window_request_send(struct download_client *client)
+{
+	int err;
+	size_t base = window_base(client);
+	struct download_client_coap_block *block;
+
+	/* Send the requests that timed out again, with the same message ID and token */
+	for (size_t i = 0; i < WINDOW_SIZE; i++) {
+		block = &client->coap.window[i];
+		if (block->resend) {
+			block->resend = false;
+			err = window_block_request_send(client, block);
+			if (err) {
+				return err;
+			}
+		}
+	}
+
+	/* Fill the window, but request the first block alone to learn the size of the file */
+	while (client->coap.next_block < base + WINDOW_SIZE &&
+	       (client->file_size == 0 ? client->coap.next_block == base :
+		client->coap.next_block * BLOCK_BYTES < client->file_size)) {
+		block = window_block_get(client, client->coap.next_block);
+
+		memset(block, 0, offsetof(struct download_client_coap_block, data));
+		block->num = client->coap.next_block;
+		memcpy(block->token, coap_next_token(), sizeof(block->token));
+
+		err = window_block_request_send(client, block);
+		if (err) {
+			return err;
+		}
+
+		client->coap.next_block++;
+	}
+
+	return 0;
+}
+#endif /* WINDOW_SIZE > 1 */
+
+int coap_request_send(struct download_client *client)
+{
+#if WINDOW_SIZE > 1
+	return window_request_send(client);
+#else
+	return block_request_send(client, &client->coap.block_ctx, &client->coap.pending,
+				  coap_next_token());
+#endif
+}
@@ -21,10 +21,15 @@
 #include <zephyr/net/socket_ncs.h>
 #include <zephyr/net/tls_credentials.h>
 #include <net/download_client.h>
+#include <debug/perf_counter.h>
 #include <zephyr/logging/log.h>
 
 LOG_MODULE_REGISTER(download_client, CONFIG_DOWNLOAD_CLIENT_LOG_LEVEL);
 
+PERF_COUNTER_DEFINE(download_client_rx, "B");
+PERF_HISTOGRAM_DEFINE(download_client_recv_time, "us");
+PERF_HISTOGRAM_DEFINE(download_client_fragment_time, "us");
+
 #define SIN6(A) ((struct sockaddr_in6 *)(A))
 #define SIN(A) ((struct sockaddr_in *)(A))
 
@@ -457,6 +462,10 @@ static int client_connect(struct download_client *dl)
 	}
 
 cleanup:
+	/* Requests sent on a previous connection will not be answered */
+	dl->http.requested = 0;
+	dl->http.carry = 0;
+
 	if (err) {
 		error_evt_send(dl, -err);
 
@@ -467,7 +476,7 @@ cleanup:
 	return err;
 }
 
-int socket_send(const struct download_client *client, size_t len, int timeout)
+int socket_send(const struct download_client *client, const char *buf, size_t len, int timeout)
 {
 	int err;
 	int sent;
@@ -479,7 +488,7 @@ int socket_send(const struct download_client *client, size_t len, int timeout)
 	}
 
 	while (len) {
-		sent = send(client->fd, client->buf + off, len, 0);
+		sent = send(client->fd, buf + off, len, 0);
 		if (sent < 0) {
 			return -errno;
 		}
@@ -523,9 +532,15 @@ static int fragment_evt_send(struct download_client *client)
 		}
 	};
 
+	uint32_t start = PERF_TIMESTAMP();
+	int err;
+
 	client->offset = 0;
 
-	return client->callback(&evt);
+	err = client->callback(&evt);
+	PERF_HISTOGRAM_RECORD_SINCE(download_client_fragment_time, start);
+
+	return err;
 }
 
 static int error_evt_send(const struct download_client *dl, int error)
@@ -558,6 +573,23 @@ static int reconnect(struct download_client *dl)
 	return err;
 }
 
+/* Close the socket, the next download connects again */
+static void connection_drop(struct download_client *dl)
+{
+	int err;
+
+	if (dl->fd >= 0) {
+		err = close(dl->fd);
+		if (err) {
+			LOG_DBG("disconnect failed, %d", err);
+		}
+		dl->fd = -1;
+	}
+
+	dl->http.requested = 0;
+	dl->http.carry = 0;
+}
+
 static ssize_t socket_recv(struct download_client *dl)
 {
 	int err, timeout = 0;
@@ -587,7 +619,15 @@ static ssize_t socket_recv(struct download_client *dl)
 		return -1;
 	}
 
-	return recv(dl->fd, dl->buf + dl->offset, sizeof(dl->buf) - dl->offset, 0);
+	uint32_t start = PERF_TIMESTAMP();
+	ssize_t len = recv(dl->fd, dl->buf + dl->offset, sizeof(dl->buf) - dl->offset, 0);
+
+	PERF_HISTOGRAM_RECORD_SINCE(download_client_recv_time, start);
+	if (len > 0) {
+		PERF_COUNTER_ADD(download_client_rx, len);
+	}
+
+	return len;
 }
 
 static int request_resend(struct download_client *dl)
@@ -689,6 +729,7 @@ static int handle_socket_error(struct download_client *dl, ssize_t len)
 static int handle_received(struct download_client *dl, ssize_t len)
 {
 	int rc;
+	size_t frag_len;
 
 	LOG_DBG("Read %d bytes from socket", len);
 
@@ -732,12 +773,20 @@ static int handle_received(struct download_client *dl, ssize_t len)
 	/* Send fragment to application.
 	 * If the application callback returns non-zero, stop.
 	 */
+	frag_len = dl->offset;
 	if (fragment_evt_send(dl)) {
 		/* Restart and suspend */
 		LOG_INF("Fragment refused, download stopped.");
 		rc = -1;
 	}
 
+	if (dl->http.carry) {
+		/* Move the start of the next pipelined response to the beginning of the buffer,
+		 * it is parsed before anything else is received.
+		 */
+		memmove(dl->buf, dl->buf + frag_len, dl->http.carry);
+	}
+
 	if (dl->progress == dl->file_size) {
 		LOG_INF("Download complete");
 		const struct download_client_evt evt = {
@@ -864,7 +913,13 @@ void download_thread(void *client, void *a, void *b)
 			LOG_DBG("Receiving up to %d bytes at %p...", (sizeof(dl->buf) - dl->offset),
 				(void *)(dl->buf + dl->offset));
 
-			len = socket_recv(dl);
+			if (dl->http.carry) {
+				/* Already received with the previous response */
+				len = dl->http.carry;
+				dl->http.carry = 0;
+			} else {
+				len = socket_recv(dl);
+			}
 
 			if ((len == 0) || (len == -1)) {
 				/* We just had an unexpected socket error or closure */
@@ -890,6 +945,14 @@ void download_thread(void *client, void *a, void *b)
 			if (dl->close_when_done) {
 				set_state(dl, DOWNLOAD_CLIENT_CLOSING);
 			} else {
+				if (dl->http.requested > 0) {
+					/* Responses to pipelined requests are still on their way,
+					 * the next download must not receive them.
+					 */
+					LOG_DBG("Closing connection, %u requests pending",
+						dl->http.requested);
+					connection_drop(dl);
+				}
 				set_state(dl, DOWNLOAD_CLIENT_FINISHED);
 			}
 		}
@@ -1003,7 +1066,9 @@ int download_client_start(struct download_client *client, const char *file,
 	client->progress = from;
 	client->offset = 0;
 	client->http.has_header = false;
-	if (is_idle(client)) {
+	client->http.requested = 0;
+	client->http.carry = 0;
+	if (is_idle(client) || (client->fd < 0)) {
 		set_state(client, DOWNLOAD_CLIENT_CONNECTING);
 	} else {
 		set_state(client, DOWNLOAD_CLIENT_DOWNLOADING);
@@ -44,38 +44,34 @@ extern char *strnstr(const char *haystack, const char *needle, size_t haystack_s
 
 int url_parse_host(const char *url, char *host, size_t len);
 int url_parse_file(const char *url, char *file, size_t len);
-int socket_send(const struct download_client *client, size_t len, int timeout);
+int socket_send(const struct download_client *client, const char *buf, size_t len, int timeout);
 
-int http_get_request_send(struct download_client *client)
+#if defined(CONFIG_DOWNLOAD_CLIENT_HTTP_PIPELINE_DEPTH)
+#define PIPELINE_DEPTH CONFIG_DOWNLOAD_CLIENT_HTTP_PIPELINE_DEPTH
+#else
+#define PIPELINE_DEPTH 1
+#endif
+
+static size_t frag_size_get(const struct download_client *client)
+{
+	if (client->config.frag_size_override) {
+		return client->config.frag_size_override;
+	}
+
+	return CONFIG_DOWNLOAD_CLIENT_HTTP_FRAG_SIZE;
+}
+
+static int get_request_send(struct download_client *client, const char *host, const char *file)
 {
 	int err;
 	int len;
 	size_t off;
-	char host[HOSTNAME_SIZE];
-	char file[FILENAME_SIZE];
-
-	__ASSERT_NO_MSG(client->host);
-	__ASSERT_NO_MSG(client->file);
-
-	client->http.has_header = false;
-
-	err = url_parse_host(client->host, host, sizeof(host));
-	if (err) {
-		return err;
-	}
-
-	err = url_parse_file(client->file, file, sizeof(file));
-	if (err) {
-		return err;
-	}
+	/* Keep any bytes of the next response at the beginning of the buffer */
+	char *buf = client->buf + client->http.carry;
+	size_t buf_size = sizeof(client->buf) - client->http.carry;
 
 	/* Offset of last byte in range (Content-Range) */
-	if (client->config.frag_size_override) {
-		off = client->progress + client->config.frag_size_override - 1;
-	} else {
-		off = client->progress +
-			CONFIG_DOWNLOAD_CLIENT_HTTP_FRAG_SIZE - 1;
-	}
+	off = client->http.next_range + frag_size_get(client) - 1;
 
 	if (client->file_size != 0) {
 		/* Don't request bytes past the end of file */
@@ -84,37 +80,82 @@ int http_get_request_send(struct download_client *client)
 
 	if (client->proto == IPPROTO_TLS_1_2
 	   || IS_ENABLED(CONFIG_DOWNLOAD_CLIENT_RANGE_REQUESTS)) {
-		len = snprintf(client->buf,
-			CONFIG_DOWNLOAD_CLIENT_BUF_SIZE,
-			HTTP_GET_RANGE, file, host, client->progress, off);
+		len = snprintf(buf, buf_size,
+			HTTP_GET_RANGE, file, host, client->http.next_range, off);
 		client->http.ranged = true;
 	} else if (client->progress) {
-		len = snprintf(client->buf,
-			CONFIG_DOWNLOAD_CLIENT_BUF_SIZE,
+		len = snprintf(buf, buf_size,
 			HTTP_GET_OFFSET, file, host, client->progress);
 		client->http.ranged = false;
 	} else {
-		len = snprintf(client->buf,
-			CONFIG_DOWNLOAD_CLIENT_BUF_SIZE,
+		len = snprintf(buf, buf_size,
 			HTTP_GET, file, host);
 		client->http.ranged = false;
 	}
 
-	if (len < 0 || len > CONFIG_DOWNLOAD_CLIENT_BUF_SIZE) {
+	if (len < 0 || len >= buf_size) {
 		LOG_ERR("Cannot create GET request, buffer too small");
 		return -ENOMEM;
 	}
 
 	if (IS_ENABLED(CONFIG_DOWNLOAD_CLIENT_LOG_HEADERS)) {
-		LOG_HEXDUMP_DBG(client->buf, len, "HTTP request");
+		LOG_HEXDUMP_DBG(buf, len, "HTTP request");
 	}
 
-	err = socket_send(client, len, 0);
+	err = socket_send(client, buf, len, 0);
 	if (err) {
 		LOG_ERR("Failed to send HTTP request, errno %d", errno);
 		return err;
 	}
 
+	client->http.requested++;
+	client->http.next_range = off + 1;
+
+	return 0;
+}
+
+int http_get_request_send(struct download_client *client)
+{
+	int err;
+	char host[HOSTNAME_SIZE];
+	char file[FILENAME_SIZE];
+
+	__ASSERT_NO_MSG(client->host);
+	__ASSERT_NO_MSG(client->file);
+
+	if (client->http.requested == 0) {
+		/* No response is expected, start from the current progress */
+		client->http.has_header = false;
+		client->http.next_range = client->progress;
+	}
+
+	err = url_parse_host(client->host, host, sizeof(host));
+	if (err) {
+		return err;
+	}
+
+	err = url_parse_file(client->file, file, sizeof(file));
+	if (err) {
+		return err;
+	}
+
+	/* Every byte of the file may already be requested */
+	while ((client->file_size == 0) || (client->http.next_range < client->file_size)) {
+		err = get_request_send(client, host, file);
+		if (err) {
+			/* The pipeline is refilled when the next response is received */
+			return (client->http.requested > 0) ? 0 : err;
+		}
+
+		/* Pipeline range requests once the file size is known,
+		 * the server answers them in order.
+		 */
+		if (!client->http.ranged || (client->http.requested >= PIPELINE_DEPTH) ||
+		    (client->file_size == 0)) {
+			break;
+		}
+	}
+
 	return 0;
 }
 
@@ -243,6 +284,8 @@ int http_parse(struct download_client *client, size_t len)
 {
 	int rc;
 	size_t hdr_len;
+	size_t payload;
+	bool header_done = client->http.has_header;
 
 	/* Accumulate buffer offset */
 	client->offset += len;
@@ -277,28 +320,54 @@ int http_parse(struct download_client *client, size_t len)
 		}
 	}
 
-	/* Accumulate overall file progress.
+	/* Number of payload bytes received.
 	 * If the last recv() call read an HTTP header,
 	 * `offset` has been moved at the end of any trailing
 	 * payload bytes by http_header_parse(). In this case,
 	 * `offset` is less than `len` and it represents
 	 * the actual payload bytes.
 	 */
-	client->progress += MIN(client->offset, len);
+	payload = MIN(client->offset, len);
 
-	/* Have we received a whole fragment or the whole file? */
-	if (client->progress != client->file_size) {
-		if (client->http.ranged) {
-			if (client->offset < (client->config.frag_size_override != 0 ?
-						      client->config.frag_size_override :
-						      CONFIG_DOWNLOAD_CLIENT_HTTP_FRAG_SIZE)) {
-				/* Ranged query: read until a full fragment */
-				return 1;
-			}
-		} else {
-			/* Non-ranged query: just keep on reading, ignore fragment size */
+	if (client->http.ranged) {
+		if (!header_done) {
+			/* The response carries the requested range */
+			client->http.body_left = MIN(frag_size_get(client),
+						     client->file_size - client->progress);
+		}
+
+		if (payload > client->http.body_left) {
+			/* The rest belongs to the next pipelined response */
+			client->http.carry = payload - client->http.body_left;
+			client->offset -= client->http.carry;
+			payload = client->http.body_left;
+		}
+
+		/* Accumulate overall file progress */
+		client->progress += payload;
+		client->http.body_left -= payload;
+
+		if (client->http.body_left > 0) {
+			/* Ranged query: read until a full fragment */
 			return 1;
 		}
+
+		/* The response is complete, the next one starts with a header */
+		client->http.has_header = false;
+		if (client->http.requested > 0) {
+			client->http.requested--;
+		}
+
+		return 0;
+	}
+
+	/* Accumulate overall file progress */
+	client->progress += payload;
+
+	/* Have we received the whole file? */
+	if (client->progress != client->file_size) {
+		/* Non-ranged query: just keep on reading, ignore fragment size */
+		return 1;
 	}
 
 	/* Either we have a full file, or we need to request a next fragment */
@@ -45,6 +45,11 @@ MQTT_HELPER_STATIC K_SEM_DEFINE(connection_poll_sem, 0, 1);
 static struct mqtt_helper_cfg current_cfg;
 MQTT_HELPER_STATIC enum mqtt_state mqtt_state = MQTT_STATE_UNINIT;
 
+/* Message IDs of the QoS 1 publications waiting for a PUBACK, 0 if the slot is free. */
+#define PUBLISH_WINDOW CONFIG_MQTT_HELPER_PUBLISH_WINDOW
+MQTT_HELPER_STATIC uint16_t in_flight[MAX(PUBLISH_WINDOW, 1)];
+static K_MUTEX_DEFINE(in_flight_lock);
+
 static const char *state_name_get(enum mqtt_state state)
 {
 	switch (state) {
@@ -231,6 +236,92 @@ static int certificates_provision(void)
 }
 #endif /* CONFIG_MQTT_HELPER_PROVISION_CERTIFICATES */
 
+/* Must be called with in_flight_lock held. */
+static bool in_flight_has(uint16_t message_id)
+{
+	for (size_t i = 0; i < PUBLISH_WINDOW; i++) {
+		if (in_flight[i] == message_id) {
+			return true;
+		}
+	}
+
+	return false;
+}
+
+static int in_flight_add(uint16_t message_id)
+{
+	int err = -EAGAIN;
+
+	/* Message ID 0 is not valid for QoS 1, so it is not tracked. */
+	if ((PUBLISH_WINDOW == 0) || (message_id == 0)) {
+		return 0;
+	}
+
+	k_mutex_lock(&in_flight_lock, K_FOREVER);
+
+	if (in_flight_has(message_id)) {
+		err = -EALREADY;
+	} else {
+		for (size_t i = 0; i < PUBLISH_WINDOW; i++) {
+			if (in_flight[i] == 0) {
+				in_flight[i] = message_id;
+				err = 0;
+				break;
+			}
+		}
+	}
+
+	k_mutex_unlock(&in_flight_lock);
+
+	return err;
+}
+
+static bool in_flight_remove(uint16_t message_id)
+{
+	bool found = false;
+
+	if (message_id == 0) {
+		return false;
+	}
+
+	k_mutex_lock(&in_flight_lock, K_FOREVER);
+
+	for (size_t i = 0; i < PUBLISH_WINDOW; i++) {
+		if (in_flight[i] == message_id) {
+			in_flight[i] = 0;
+			found = true;
+			break;
+		}
+	}
+
+	k_mutex_unlock(&in_flight_lock);
+
+	return found;
+}
+
+/* Report the publications that will never be acknowledged, the session is not persistent. */
+static void in_flight_release_all(int result)
+{
+	uint16_t released[ARRAY_SIZE(in_flight)];
+
+	k_mutex_lock(&in_flight_lock, K_FOREVER);
+	memcpy(released, in_flight, sizeof(released));
+	memset(in_flight, 0, sizeof(in_flight));
+	k_mutex_unlock(&in_flight_lock);
+
+	for (size_t i = 0; i < PUBLISH_WINDOW; i++) {
+		if (released[i] == 0) {
+			continue;
+		}
+
+		LOG_DBG("Message ID %d not acknowledged", released[i]);
+
+		if (current_cfg.cb.on_puback) {
+			current_cfg.cb.on_puback(released[i], result);
+		}
+	}
+}
+
 static int publish_get_payload(struct mqtt_client *const mqtt_client, size_t length)
 {
 	if (length > sizeof(payload_buf)) {
@@ -257,6 +348,30 @@ static void send_ack(struct mqtt_client *const mqtt_client, uint16_t message_id)
 	LOG_DBG("PUBACK sent for message ID %d", message_id);
 }
 
+/* Read the payload in chunks of the payload buffer size, for payloads of any size. */
+static int publish_chunks_deliver(struct mqtt_helper_buf topic, size_t length)
+{
+	int err;
+	size_t offset = 0;
+	struct mqtt_helper_buf chunk = {
+		.ptr = payload_buf,
+	};
+
+	do {
+		chunk.size = MIN(length - offset, sizeof(payload_buf));
+
+		err = mqtt_readall_publish_payload(&mqtt_client, payload_buf, chunk.size);
+		if (err) {
+			return err;
+		}
+
+		current_cfg.cb.on_publish_chunk(topic, chunk, offset, length);
+		offset += chunk.size;
+	} while (offset < length);
+
+	return 0;
+}
+
 MQTT_HELPER_STATIC void on_publish(const struct mqtt_evt *mqtt_evt)
 {
 	int err;
@@ -269,6 +384,20 @@ MQTT_HELPER_STATIC void on_publish(const struct mqtt_evt *mqtt_evt)
 		.ptr = payload_buf,
 	};
 
+	if (current_cfg.cb.on_publish_chunk) {
+		err = publish_chunks_deliver(topic, p->message.payload.len);
+		if (err) {
+			LOG_ERR("publish_chunks_deliver, error: %d", err);
+			return;
+		}
+
+		if (p->message.topic.qos == MQTT_QOS_1_AT_LEAST_ONCE) {
+			send_ack(&mqtt_client, p->message_id);
+		}
+
+		return;
+	}
+
 	err = publish_get_payload(&mqtt_client, p->message.payload.len);
 	if (err) {
 		LOG_ERR("publish_get_payload, error: %d", err);
@@ -321,6 +450,7 @@ MQTT_HELPER_STATIC void mqtt_evt_handler(struct mqtt_client *const mqtt_client,
 		LOG_DBG("MQTT_EVT_DISCONNECT: result = %d", mqtt_evt->result);
 
 		mqtt_state_set(MQTT_STATE_DISCONNECTED);
+		in_flight_release_all(-ENOTCONN);
 
 		if (current_cfg.cb.on_disconnect) {
 			current_cfg.cb.on_disconnect(mqtt_evt->result);
@@ -337,6 +467,10 @@ MQTT_HELPER_STATIC void mqtt_evt_handler(struct mqtt_client *const mqtt_client,
 			mqtt_evt->param.puback.message_id,
 			mqtt_evt->result);
 
+		if (!in_flight_remove(mqtt_evt->param.puback.message_id)) {
+			LOG_DBG("PUBACK for a message that is not in flight");
+		}
+
 		if (current_cfg.cb.on_puback) {
 			current_cfg.cb.on_puback(mqtt_evt->param.puback.message_id,
 						 mqtt_evt->result);
@@ -616,6 +750,7 @@ int mqtt_helper_disconnect(void)
 		/* Treat the sitation as an ungraceful disconnect */
 		LOG_ERR("Failed to send disconnection request, treating as disconnected");
 		mqtt_state_set(MQTT_STATE_DISCONNECTED);
+		in_flight_release_all(-ENOTCONN);
 
 		if (current_cfg.cb.on_disconnect) {
 			current_cfg.cb.on_disconnect(err);
@@ -653,6 +788,9 @@ int mqtt_helper_subscribe(struct mqtt_subscription_list *sub_list)
 
 int mqtt_helper_publish(const struct mqtt_publish_param *param)
 {
+	int err;
+	bool qos1 = (param->message.topic.qos == MQTT_QOS_1_AT_LEAST_ONCE);
+
 	LOG_DBG("Publishing to topic: %.*s",
 		param->message.topic.topic.size,
 		(char *)param->message.topic.topic.utf8);
@@ -665,7 +803,39 @@ int mqtt_helper_publish(const struct mqtt_publish_param *param)
 		return -EOPNOTSUPP;
 	}
 
-	return mqtt_publish(&mqtt_client, param);
+	if (qos1) {
+		err = in_flight_add(param->message_id);
+		if (err) {
+			LOG_DBG("Message ID %d not published, error: %d", param->message_id, err);
+			return err;
+		}
+	}
+
+	/* The MQTT library sends the payload right after the header from the caller's buffer. */
+	err = mqtt_publish(&mqtt_client, param);
+	if (err && qos1) {
+		(void)in_flight_remove(param->message_id);
+	}
+
+	return err;
+}
+
+uint16_t mqtt_helper_msg_id_get(void)
+{
+	static uint16_t msg_id;
+	uint16_t id;
+
+	k_mutex_lock(&in_flight_lock, K_FOREVER);
+
+	do {
+		msg_id++;
+	} while ((msg_id == 0) || in_flight_has(msg_id));
+
+	id = msg_id;
+
+	k_mutex_unlock(&in_flight_lock);
+
+	return id;
 }
 
 int mqtt_helper_deinit(void)
@@ -680,6 +850,7 @@ int mqtt_helper_deinit(void)
 
 	memset(&current_cfg, 0, sizeof(current_cfg));
 	memset(&mqtt_client, 0, sizeof(mqtt_client));
+	memset(in_flight, 0, sizeof(in_flight));
 
 	mqtt_state_set(MQTT_STATE_UNINIT);
 
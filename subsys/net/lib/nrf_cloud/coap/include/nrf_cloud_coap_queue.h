@@ -0,0 +1,66 @@
+/*
+ * Copyright (c) 2024 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#ifndef NRF_CLOUD_COAP_QUEUE_H_
+#define NRF_CLOUD_COAP_QUEUE_H_
+
+/** @file nrf_cloud_coap_queue.h
+ * @brief Store-and-forward queue of JSON encoded device messages
+ */
+
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** Bytes of a batch that are not used by the messages: the brackets of the JSON array */
+#define NRF_CLOUD_COAP_QUEUE_ARRAY_OVERHEAD 2
+
+/**@brief Initialize the queue and count the messages stored before a reset.
+ *
+ * @retval 0 Success.
+ * @retval -ENODEV The queue partition is not available.
+ * @return A negative error number from the flash circular buffer otherwise.
+ */
+int nrf_cloud_coap_queue_init(void);
+
+/**@brief Store an encoded message in the queue.
+ *
+ * If the queue is full, the flash page with the oldest messages is erased.
+ * A flush is scheduled according to the configured policy.
+ *
+ * @param buf JSON encoded device message, without a terminating null character.
+ * @param len Length of the message.
+ *
+ * @retval 0 Success.
+ * @retval -EPERM The queue is not initialized.
+ * @retval -EMSGSIZE The message does not fit in a batch.
+ * @return A negative error number from flash otherwise.
+ */
+int nrf_cloud_coap_queue_append(const uint8_t *buf, size_t len);
+
+/**@brief Notify the queue that the connection to nRF Cloud is established,
+ * so that the messages stored while offline are sent.
+ */
+void nrf_cloud_coap_queue_connected(void);
+
+/**@brief Send a batch of messages to nRF Cloud.
+ *
+ * Implemented by the CoAP library. The batch is a JSON array of device messages, sent
+ * to the d2c/bulk resource.
+ *
+ * @return 0 if the request succeeded, a positive value indicating a CoAP result code,
+ * or a negative error number.
+ */
+int nrf_cloud_coap_queue_batch_send(const uint8_t *buf, size_t len);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* NRF_CLOUD_COAP_QUEUE_H_ */
@@ -20,6 +20,9 @@
 #include "nrf_cloud_codec_internal.h"
 #include "nrf_cloud_mem.h"
 #include "coap_codec.h"
+#if defined(CONFIG_NRF_CLOUD_COAP_QUEUE)
+#include "nrf_cloud_coap_queue.h"
+#endif
 
 #include <zephyr/logging/log.h>
 LOG_MODULE_REGISTER(nrf_cloud_coap, CONFIG_NRF_CLOUD_COAP_LOG_LEVEL);
@@ -405,6 +408,133 @@ int nrf_cloud_coap_location_send(const struct nrf_cloud_gnss_data *gnss, bool co
 	return err;
 }
 
+#if defined(CONFIG_NRF_CLOUD_COAP_QUEUE)
+static int queue_ts_get(int64_t ts_ms, int64_t *ts)
+{
+	int err;
+
+	if (ts_ms != NRF_CLOUD_NO_TIMESTAMP) {
+		*ts = ts_ms;
+		return 0;
+	}
+
+	/* The message is sent later, so the cloud cannot time stamp it on reception */
+	err = date_time_now(ts);
+	if (err) {
+		LOG_ERR("Time unknown, unable to queue the message: %d", err);
+	}
+	return err;
+}
+
+int nrf_cloud_coap_queue_batch_send(const uint8_t *buf, size_t len)
+{
+	const char *resource = get_d2c_resource(true);
+	int err;
+
+	if (!resource) {
+		return -EINVAL;
+	}
+	/* The bulk resource takes an array of JSON messages, like
+	 * nrf_cloud_coap_json_message_send() with bulk set.
+	 */
+	err = nrf_cloud_coap_post(resource, NULL, buf, len,
+				  COAP_CONTENT_FORMAT_APP_JSON, true, NULL, NULL);
+	if (err < 0) {
+		LOG_ERR("Failed to send POST request: %d", err);
+	} else if (err > 0) {
+		LOG_RESULT_CODE_ERR("Error from server:", err);
+	}
+	return err;
+}
+
+/* Encode the message in JSON and queue it. The object is freed. */
+static int queue_obj_append(struct nrf_cloud_obj *const msg_obj)
+{
+	int err;
+
+	err = nrf_cloud_obj_cloud_encode(msg_obj);
+	if (err) {
+		LOG_ERR("Unable to encode message: %d", err);
+	} else {
+		err = nrf_cloud_coap_queue_append(msg_obj->encoded_data.ptr,
+						  msg_obj->encoded_data.len);
+		(void)nrf_cloud_obj_cloud_encoded_free(msg_obj);
+	}
+
+	(void)nrf_cloud_obj_free(msg_obj);
+	return err;
+}
+
+static int queue_data_append(const char *app_id, double value, const char *str_val,
+			     int64_t ts_ms)
+{
+	NRF_CLOUD_OBJ_JSON_DEFINE(msg_obj);
+	int64_t ts;
+	int err;
+
+	err = queue_ts_get(ts_ms, &ts);
+	if (err) {
+		return err;
+	}
+
+	err = nrf_cloud_obj_msg_init(&msg_obj, app_id, NRF_CLOUD_JSON_MSG_TYPE_VAL_DATA);
+	err = err ? err : nrf_cloud_obj_ts_add(&msg_obj, ts);
+	if (str_val != NULL) {
+		err = err ? err : nrf_cloud_obj_str_add(&msg_obj, NRF_CLOUD_JSON_DATA_KEY,
+							str_val, false);
+	} else {
+		err = err ? err : nrf_cloud_obj_num_add(&msg_obj, NRF_CLOUD_JSON_DATA_KEY,
+							value, false);
+	}
+	if (err) {
+		LOG_ERR("Unable to create message: %d", err);
+		(void)nrf_cloud_obj_free(&msg_obj);
+		return err;
+	}
+
+	return queue_obj_append(&msg_obj);
+}
+
+int nrf_cloud_coap_sensor_queue(const char *app_id, double value, int64_t ts_ms)
+{
+	__ASSERT_NO_MSG(app_id != NULL);
+
+	return queue_data_append(app_id, value, NULL, ts_ms);
+}
+
+int nrf_cloud_coap_message_queue(const char *app_id, const char *message, int64_t ts_ms)
+{
+	__ASSERT_NO_MSG(app_id != NULL);
+	__ASSERT_NO_MSG(message != NULL);
+
+	return queue_data_append(app_id, 0, message, ts_ms);
+}
+
+int nrf_cloud_coap_location_queue(const struct nrf_cloud_gnss_data *gnss)
+{
+	__ASSERT_NO_MSG(gnss != NULL);
+	NRF_CLOUD_OBJ_JSON_DEFINE(msg_obj);
+	struct nrf_cloud_gnss_data gnss_ts = *gnss;
+	int err;
+
+	if (gnss->type != NRF_CLOUD_GNSS_TYPE_PVT) {
+		LOG_ERR("Only PVT format is supported");
+		return -ENOTSUP;
+	}
+	err = queue_ts_get(gnss->ts_ms, &gnss_ts.ts_ms);
+	if (err) {
+		return err;
+	}
+	err = nrf_cloud_obj_gnss_msg_create(&msg_obj, &gnss_ts);
+	if (err) {
+		LOG_ERR("Unable to create GNSS PVT message: %d", err);
+		(void)nrf_cloud_obj_free(&msg_obj);
+		return err;
+	}
+	return queue_obj_append(&msg_obj);
+}
+#endif /* CONFIG_NRF_CLOUD_COAP_QUEUE */
+
 static int loc_err;
 
 static void get_location_callback(int16_t result_code,
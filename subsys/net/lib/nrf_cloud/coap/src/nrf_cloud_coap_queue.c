@@ -0,0 +1,443 @@
+/*
+ * Copyright (c) 2024 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#include <string.h>
+#include <zephyr/kernel.h>
+#include <zephyr/fs/fcb.h>
+#include <zephyr/storage/flash_map.h>
+#include <zephyr/net/coap.h>
+#include <zephyr/sys/util.h>
+#include <net/nrf_cloud_coap.h>
+#if defined(CONFIG_NRF_CLOUD_COAP_QUEUE_FLUSH_ON_RRC_CONNECTED)
+#include <modem/lte_lc.h>
+#endif
+#include "nrf_cloud_coap_transport.h"
+#include "nrf_cloud_coap_queue.h"
+
+#include <zephyr/logging/log.h>
+LOG_MODULE_REGISTER(nrf_cloud_coap_queue, CONFIG_NRF_CLOUD_COAP_LOG_LEVEL);
+
+#if defined(CONFIG_PARTITION_MANAGER_ENABLED)
+#define QUEUE_PARTITION_ID FIXED_PARTITION_ID(nrf_cloud_coap_queue)
+#else
+#define QUEUE_PARTITION_ID FIXED_PARTITION_ID(nrf_cloud_coap_queue_partition)
+#endif
+#define QUEUE_MAGIC 0x4e435131
+
+/* A batch is sent in a single CoAP block */
+#define BATCH_SIZE (CONFIG_COAP_CLIENT_BLOCK_SIZE - CONFIG_COAP_CLIENT_MESSAGE_HEADER_SIZE)
+#define BATCH_DATA_SIZE (BATCH_SIZE - NRF_CLOUD_COAP_QUEUE_ARRAY_OVERHEAD)
+
+/* Largest flash write block size supported */
+#define WRITE_ALIGN_MAX 32
+
+static struct flash_sector queue_sectors[CONFIG_NRF_CLOUD_COAP_QUEUE_SECTORS];
+static struct fcb queue_fcb;
+
+/* The last sent message. It is kept in __noinit RAM, so that the messages sent before a
+ * warm reset are not sent again. After a cold boot, the messages of the oldest flash page
+ * that were already sent may be sent again.
+ */
+static __noinit uint32_t cursor_magic;
+static __noinit struct fcb_entry cursor;
+
+/* Protects the flash circular buffer, the cursor and the counters */
+static K_MUTEX_DEFINE(queue_lock);
+/* Serializes the flushes, which use the batch buffer */
+static K_MUTEX_DEFINE(flush_lock);
+
+static size_t queued_cnt;
+/* Incremented when a page with messages that are not sent is erased */
+static uint32_t drop_gen;
+static bool initialized;
+
+static uint8_t batch[BATCH_SIZE];
+static uint8_t append_buf[ROUND_UP(BATCH_DATA_SIZE, WRITE_ALIGN_MAX)];
+
+static K_THREAD_STACK_DEFINE(flush_stack, CONFIG_NRF_CLOUD_COAP_QUEUE_STACK_SIZE);
+static struct k_work_q flush_work_q;
+
+static void flush_work_fn(struct k_work *work);
+static K_WORK_DELAYABLE_DEFINE(flush_work, flush_work_fn);
+
+/* Must be called with queue_lock held */
+static size_t unsent_count(void)
+{
+	struct fcb_entry loc = cursor;
+	size_t cnt = 0;
+
+	while (!fcb_getnext(&queue_fcb, &loc)) {
+		cnt++;
+	}
+
+	return cnt;
+}
+
+static bool cursor_valid(void)
+{
+	return (cursor.fe_sector == NULL) ||
+	       ((cursor.fe_sector >= &queue_sectors[0]) &&
+		(cursor.fe_sector < &queue_sectors[queue_fcb.f_sector_cnt]));
+}
+
+static void cursor_reset(void)
+{
+	memset(&cursor, 0, sizeof(cursor));
+}
+
+/* Must be called with queue_lock held */
+static int oldest_drop(void)
+{
+	struct flash_sector *oldest = queue_fcb.f_oldest;
+	int err;
+
+	err = fcb_rotate(&queue_fcb);
+	if (err) {
+		LOG_ERR("Failed to erase the oldest messages: %d", err);
+		return err;
+	}
+
+	if (cursor.fe_sector == oldest) {
+		cursor_reset();
+	}
+
+	drop_gen++;
+	queued_cnt = unsent_count();
+
+	LOG_WRN("Queue full, oldest messages dropped, %zu left", queued_cnt);
+
+	return 0;
+}
+
+/* Must be called with queue_lock held */
+static int entry_write(const struct fcb_entry *loc, const uint8_t *buf, size_t len)
+{
+	uint8_t align = flash_area_align(queue_fcb.fap);
+
+	/* The flash may only accept writes of whole blocks. The space of the
+	 * entry is rounded up to the block size, so the padding fits in it.
+	 */
+	__ASSERT_NO_MSG(align <= WRITE_ALIGN_MAX);
+	memcpy(append_buf, buf, len);
+	memset(&append_buf[len], queue_fcb.f_erase_value, ROUND_UP(len, align) - len);
+
+	return flash_area_write(queue_fcb.fap, FCB_ENTRY_FA_DATA_OFF(*loc), append_buf,
+				ROUND_UP(len, align));
+}
+
+/* Must be called with queue_lock held */
+static void sent_sectors_erase(void)
+{
+	/* Erase the pages before the one of the cursor, all their messages are sent */
+	while (cursor.fe_sector && (queue_fcb.f_oldest != cursor.fe_sector)) {
+		if (fcb_rotate(&queue_fcb)) {
+			break;
+		}
+	}
+}
+
+static void flush_schedule(size_t cnt)
+{
+	if (CONFIG_NRF_CLOUD_COAP_QUEUE_FLUSH_COUNT &&
+	    (cnt >= CONFIG_NRF_CLOUD_COAP_QUEUE_FLUSH_COUNT)) {
+		(void)k_work_reschedule_for_queue(&flush_work_q, &flush_work, K_NO_WAIT);
+	} else if (CONFIG_NRF_CLOUD_COAP_QUEUE_FLUSH_AGE) {
+		/* Does not restart a pending timeout, so it expires at the age
+		 * of the oldest message.
+		 */
+		(void)k_work_schedule_for_queue(&flush_work_q, &flush_work,
+						K_SECONDS(CONFIG_NRF_CLOUD_COAP_QUEUE_FLUSH_AGE));
+	}
+}
+
+static void flush_now(void)
+{
+	if (nrf_cloud_coap_queue_count()) {
+		(void)k_work_reschedule_for_queue(&flush_work_q, &flush_work, K_NO_WAIT);
+	}
+}
+
+int nrf_cloud_coap_queue_append(const uint8_t *buf, size_t len)
+{
+	struct fcb_entry loc;
+	size_t cnt;
+	int err;
+
+	if (!initialized) {
+		return -EPERM;
+	}
+
+	if (len > BATCH_DATA_SIZE) {
+		return -EMSGSIZE;
+	}
+
+	k_mutex_lock(&queue_lock, K_FOREVER);
+
+	err = fcb_append(&queue_fcb, len, &loc);
+	if (err == -ENOSPC) {
+		err = oldest_drop();
+		if (!err) {
+			err = fcb_append(&queue_fcb, len, &loc);
+		}
+	}
+
+	if (!err) {
+		err = entry_write(&loc, buf, len);
+	}
+
+	if (!err) {
+		err = fcb_append_finish(&queue_fcb, &loc);
+	}
+
+	if (!err) {
+		queued_cnt++;
+	}
+
+	cnt = queued_cnt;
+
+	k_mutex_unlock(&queue_lock);
+
+	if (err) {
+		LOG_ERR("Failed to queue message: %d", err);
+		return err;
+	}
+
+	LOG_DBG("Queued %zu bytes, %zu messages queued", len, cnt);
+	flush_schedule(cnt);
+
+	return 0;
+}
+
+/* Read the oldest messages that are not sent and fit in a batch, as a JSON array.
+ * Must be called with queue_lock held.
+ */
+static uint16_t batch_read(struct fcb_entry *last, size_t *len)
+{
+	struct fcb_entry loc = cursor;
+	size_t pos = 1;
+	size_t sep;
+	uint16_t cnt = 0;
+
+	while ((cnt < UINT16_MAX) && !fcb_getnext(&queue_fcb, &loc)) {
+		/* The messages are separated by a comma, and the array is closed */
+		sep = cnt ? 1 : 0;
+		if ((pos + sep + loc.fe_data_len + 1) > sizeof(batch)) {
+			break;
+		}
+
+		if (flash_area_read(queue_fcb.fap, FCB_ENTRY_FA_DATA_OFF(loc), &batch[pos + sep],
+				    loc.fe_data_len)) {
+			break;
+		}
+
+		if (sep) {
+			batch[pos] = ',';
+		}
+
+		pos += sep + loc.fe_data_len;
+		*last = loc;
+		cnt++;
+	}
+
+	batch[0] = '[';
+	batch[pos++] = ']';
+	*len = pos;
+
+	return cnt;
+}
+
+/* The server rejected the batch, so sending it again would not help */
+static bool batch_rejected(int err)
+{
+	return (err >= COAP_RESPONSE_CODE_BAD_REQUEST) &&
+	       (err < COAP_RESPONSE_CODE_INTERNAL_ERROR) &&
+	       (err != COAP_RESPONSE_CODE_UNAUTHORIZED);
+}
+
+int nrf_cloud_coap_queue_flush(void)
+{
+	int err = 0;
+
+	if (!initialized) {
+		return -EPERM;
+	}
+
+	if (!nrf_cloud_coap_is_connected()) {
+		return -EACCES;
+	}
+
+	k_mutex_lock(&flush_lock, K_FOREVER);
+
+	while (true) {
+		struct fcb_entry last;
+		size_t len;
+		uint32_t gen;
+		uint16_t cnt;
+
+		k_mutex_lock(&queue_lock, K_FOREVER);
+		cnt = batch_read(&last, &len);
+		gen = drop_gen;
+		k_mutex_unlock(&queue_lock);
+
+		if (!cnt) {
+			break;
+		}
+
+		err = nrf_cloud_coap_queue_batch_send(batch, len);
+		if (batch_rejected(err)) {
+			LOG_ERR("Batch of %u messages rejected, dropped", cnt);
+		} else if (err) {
+			LOG_ERR("Failed to send batch of %u messages: %d", cnt, err);
+			break;
+		}
+
+		k_mutex_lock(&queue_lock, K_FOREVER);
+		/* If messages were dropped meanwhile, the batch may refer to an erased
+		 * page. Keep the cursor, the messages left are sent again.
+		 */
+		if (gen == drop_gen) {
+			cursor = last;
+			queued_cnt -= MIN(cnt, queued_cnt);
+			sent_sectors_erase();
+		}
+		k_mutex_unlock(&queue_lock);
+
+		LOG_DBG("Sent batch of %u messages, %zu bytes", cnt, len);
+		err = 0;
+	}
+
+	k_mutex_unlock(&flush_lock);
+
+	if (!err) {
+		/* Nothing is left, so do not wake up the radio at the timeout */
+		(void)k_work_cancel_delayable(&flush_work);
+	}
+
+	return err;
+}
+
+size_t nrf_cloud_coap_queue_count(void)
+{
+	size_t cnt;
+
+	k_mutex_lock(&queue_lock, K_FOREVER);
+	cnt = queued_cnt;
+	k_mutex_unlock(&queue_lock);
+
+	return cnt;
+}
+
+static void flush_work_fn(struct k_work *work)
+{
+	int err = nrf_cloud_coap_queue_flush();
+
+	if (err && (err != -EACCES)) {
+		/* Try again later; if offline, the connection triggers the flush */
+		flush_schedule(0);
+	}
+}
+
+void nrf_cloud_coap_queue_connected(void)
+{
+	if (initialized) {
+		flush_now();
+	}
+}
+
+#if defined(CONFIG_NRF_CLOUD_COAP_QUEUE_FLUSH_ON_RRC_CONNECTED)
+static void lte_handler(const struct lte_lc_evt *const evt)
+{
+	if ((evt->type == LTE_LC_EVT_RRC_UPDATE) &&
+	    (evt->rrc_mode == LTE_LC_RRC_MODE_CONNECTED)) {
+		/* The radio is awake anyway */
+		flush_now();
+	}
+}
+#endif
+
+static int fcb_setup(void)
+{
+	const struct flash_area *fa;
+	uint32_t sector_cnt = ARRAY_SIZE(queue_sectors);
+	int err;
+
+	err = flash_area_open(QUEUE_PARTITION_ID, &fa);
+	if (err) {
+		LOG_ERR("Failed to open the queue partition: %d", err);
+		return -ENODEV;
+	}
+
+	err = flash_area_get_sectors(QUEUE_PARTITION_ID, &sector_cnt, queue_sectors);
+	if (err) {
+		LOG_ERR("Failed to get the queue partition pages: %d", err);
+		flash_area_close(fa);
+		return err;
+	}
+
+	queue_fcb.f_magic = QUEUE_MAGIC;
+	queue_fcb.f_erase_value = flash_area_erased_val(fa);
+	queue_fcb.f_sector_cnt = sector_cnt;
+	queue_fcb.f_sectors = queue_sectors;
+
+	err = fcb_init(QUEUE_PARTITION_ID, &queue_fcb);
+	if (err) {
+		/* For example, the partition was used by another application */
+		LOG_WRN("Invalid queue contents, erasing: %d", err);
+		err = flash_area_erase(fa, 0, fa->fa_size);
+		if (!err) {
+			err = fcb_init(QUEUE_PARTITION_ID, &queue_fcb);
+		}
+		cursor_reset();
+	}
+
+	flash_area_close(fa);
+
+	return err;
+}
+
+int nrf_cloud_coap_queue_init(void)
+{
+	const struct k_work_queue_config cfg = {
+		.name = "nrf_cloud_coap_queue",
+	};
+	int err;
+
+	if (initialized) {
+		return 0;
+	}
+
+	err = fcb_setup();
+	if (err) {
+		LOG_ERR("Failed to initialize the queue: %d", err);
+		return err;
+	}
+
+	/* After a cold boot, the cursor contains random data */
+	if ((cursor_magic != QUEUE_MAGIC) || !cursor_valid()) {
+		cursor_reset();
+		cursor_magic = QUEUE_MAGIC;
+	}
+
+	k_mutex_lock(&queue_lock, K_FOREVER);
+	queued_cnt = unsent_count();
+	k_mutex_unlock(&queue_lock);
+
+	k_work_queue_start(&flush_work_q, flush_stack, K_THREAD_STACK_SIZEOF(flush_stack),
+			   CONFIG_NRF_CLOUD_COAP_QUEUE_THREAD_PRIO, &cfg);
+
+#if defined(CONFIG_NRF_CLOUD_COAP_QUEUE_FLUSH_ON_RRC_CONNECTED)
+	lte_lc_register_handler(lte_handler);
+#endif
+
+	initialized = true;
+
+	LOG_DBG("%zu messages queued", queued_cnt);
+	if (queued_cnt) {
+		flush_schedule(queued_cnt);
+	}
+
+	return 0;
+}
@@ -34,6 +34,9 @@
 #include "coap_codec.h"
 #include "nrf_cloud_coap_transport.h"
 #include "nrf_cloud_mem.h"
+#if defined(CONFIG_NRF_CLOUD_COAP_QUEUE)
+#include "nrf_cloud_coap_queue.h"
+#endif
 
 #include <zephyr/logging/log.h>
 LOG_MODULE_REGISTER(nrf_cloud_coap_transport, CONFIG_NRF_CLOUD_COAP_LOG_LEVEL);
@@ -168,6 +171,12 @@ int nrf_cloud_coap_init(void)
 		if (err) {
 			return err;
 		}
+#endif
+#if defined(CONFIG_NRF_CLOUD_COAP_QUEUE)
+		err = nrf_cloud_coap_queue_init();
+		if (err) {
+			return err;
+		}
 #endif
 		initialized = true;
 	}
@@ -309,6 +318,10 @@ int nrf_cloud_coap_connect(const char * const app_ver)
 	/* On initial connect, update the configured info sections in the shadow */
 	err = update_configured_info_sections(app_ver);
 	if (err != -EIO) {
+#if defined(CONFIG_NRF_CLOUD_COAP_QUEUE)
+		/* Send the messages queued while offline */
+		nrf_cloud_coap_queue_connected();
+#endif
 		return 0;
 	}
 
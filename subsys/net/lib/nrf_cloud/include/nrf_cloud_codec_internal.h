@@ -290,6 +290,19 @@ int nrf_cloud_obj_location_request_payload_add(struct nrf_cloud_obj *const obj,
 int nrf_cloud_wifi_req_json_encode(struct wifi_scan_info const *const wifi,
 				   cJSON *const req_obj_out);
 
+/** @brief Encode a location request without building a cJSON object.
+ * The output is the same as the one of nrf_cloud_obj_location_request_payload_add(),
+ * and it is freed with nrf_cloud_free().
+ *
+ * @retval 0 Success.
+ * @retval -EINVAL Invalid parameters.
+ * @retval -ENODATA Not enough cellular or Wi-Fi data for a request.
+ * @retval -ENOMEM Out of memory.
+ */
+int nrf_cloud_location_req_json_encode(struct lte_lc_cells_info const *const cells_inf,
+				       struct wifi_scan_info const *const wifi_inf,
+				       struct nrf_cloud_data *const output);
+
 /** @brief Get the required information from the modem for a single-cell location request. */
 int nrf_cloud_get_single_cell_modem_info(struct lte_lc_cell *const cell_inf);
 
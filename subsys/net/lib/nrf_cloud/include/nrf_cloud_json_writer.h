@@ -0,0 +1,156 @@
+/*
+ * Copyright (c) 2024 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#ifndef NRF_CLOUD_JSON_WRITER_H__
+#define NRF_CLOUD_JSON_WRITER_H__
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <net/nrf_cloud.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** Maximum nesting depth of objects and arrays */
+#define NRF_CLOUD_JSON_WRITER_DEPTH_MAX 31
+
+/** Maximum number of decimals of @ref nrf_cloud_json_decimal_add */
+#define NRF_CLOUD_JSON_WRITER_DECIMALS_MAX 9
+
+/** @brief Streaming JSON writer.
+ *
+ *  The writer appends unformatted JSON directly to a caller provided buffer,
+ *  without building a tree on the heap. The output is the same as the one of
+ *  cJSON_PrintUnformatted() for the same items added in the same order.
+ *
+ *  Errors are sticky, so the items can be added without checking each call;
+ *  the result is checked once with @ref nrf_cloud_json_writer_finish.
+ *
+ *  If the writer is initialized without a buffer, it only counts the length
+ *  of the output. This is used to allocate a buffer of the exact size.
+ */
+struct nrf_cloud_json_writer {
+	/** Output buffer, or NULL to only count the length */
+	char *buf;
+	/** Size of the output buffer */
+	size_t size;
+	/** Length of the output, also counted past the end of the buffer */
+	size_t len;
+	/** Current nesting depth */
+	uint8_t depth;
+	/** Bit per nesting depth, set once an item is added at that depth */
+	uint32_t has_items;
+	/** First error, or 0 */
+	int err;
+};
+
+/** @brief Function that adds the items of a message to a writer.
+ *
+ *  It is called twice by @ref nrf_cloud_json_encode_alloc, so it must add the
+ *  same items each time.
+ *
+ *  @return 0 on success, or a negative error code.
+ */
+typedef int (*nrf_cloud_json_encode_fn_t)(struct nrf_cloud_json_writer *w, const void *ctx);
+
+/** @brief Initialize a writer.
+ *
+ *  @param w Writer.
+ *  @param buf Output buffer, or NULL to only count the length of the output.
+ *  @param size Size of the output buffer, including the null terminator.
+ */
+void nrf_cloud_json_writer_init(struct nrf_cloud_json_writer *w, char *buf, size_t size);
+
+/** @brief Start an object.
+ *
+ *  @param w Writer.
+ *  @param key Key of the object, or NULL if it is an array element or the root.
+ */
+void nrf_cloud_json_obj_start(struct nrf_cloud_json_writer *w, const char *key);
+
+/** @brief End the current object. */
+void nrf_cloud_json_obj_end(struct nrf_cloud_json_writer *w);
+
+/** @brief Start an array.
+ *
+ *  @param w Writer.
+ *  @param key Key of the array, or NULL if it is an array element or the root.
+ */
+void nrf_cloud_json_arr_start(struct nrf_cloud_json_writer *w, const char *key);
+
+/** @brief End the current array. */
+void nrf_cloud_json_arr_end(struct nrf_cloud_json_writer *w);
+
+/** @brief Add a null terminated string. The string is escaped. */
+void nrf_cloud_json_str_add(struct nrf_cloud_json_writer *w, const char *key, const char *val);
+
+/** @brief Add a string of the given length. The string is escaped. */
+void nrf_cloud_json_strn_add(struct nrf_cloud_json_writer *w, const char *key, const char *val,
+			     size_t len);
+
+/** @brief Add an integer number.
+ *
+ *  Unlike cJSON, which stores numbers as double, all the digits of large
+ *  values are written.
+ */
+void nrf_cloud_json_int_add(struct nrf_cloud_json_writer *w, const char *key, int64_t val);
+
+/** @brief Add a fixed point number.
+ *
+ *  Trailing zeros of the fraction are not written, so that the output is the
+ *  same as the one of cJSON for values that it prints without an exponent.
+ *
+ *  @param w Writer.
+ *  @param key Key of the number, or NULL if it is an array element.
+ *  @param val Value multiplied by 10^decimals.
+ *  @param decimals Number of decimals in @p val, up to
+ *                  @ref NRF_CLOUD_JSON_WRITER_DECIMALS_MAX.
+ */
+void nrf_cloud_json_decimal_add(struct nrf_cloud_json_writer *w, const char *key, int64_t val,
+				uint8_t decimals);
+
+/** @brief Add a boolean. */
+void nrf_cloud_json_bool_add(struct nrf_cloud_json_writer *w, const char *key, bool val);
+
+/** @brief Add a null. */
+void nrf_cloud_json_null_add(struct nrf_cloud_json_writer *w, const char *key);
+
+/** @brief Finish the output.
+ *
+ *  The output is null terminated if it fits in the buffer.
+ *
+ *  @param w Writer.
+ *
+ *  @retval >=0 Length of the output, excluding the null terminator.
+ *  @retval -ENOMEM The output does not fit in the buffer.
+ *  @retval -EINVAL An object or array is not ended, or is nested too deep.
+ */
+int nrf_cloud_json_writer_finish(struct nrf_cloud_json_writer *w);
+
+/** @brief Encode a message into a buffer of the exact size.
+ *
+ *  The message is encoded twice: first to count its length, then into a
+ *  buffer allocated once with @p alloc_fn.
+ *
+ *  @param encode Function that adds the items of the message.
+ *  @param ctx Context passed to @p encode.
+ *  @param alloc_fn Function that allocates the output buffer.
+ *  @param free_fn Function that frees the output buffer on failure.
+ *  @param output Output. On success, the caller frees output->ptr.
+ *
+ *  @return 0 on success, or a negative error code.
+ */
+int nrf_cloud_json_encode_alloc(nrf_cloud_json_encode_fn_t encode, const void *ctx,
+				void *(*alloc_fn)(size_t), void (*free_fn)(void *),
+				struct nrf_cloud_data *output);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* NRF_CLOUD_JSON_WRITER_H__ */
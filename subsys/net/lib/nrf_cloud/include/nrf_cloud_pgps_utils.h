@@ -40,6 +40,16 @@ struct gps_location {
 	int64_t gps_sec;
 };
 
+/* Storage block of each prediction, in time order, so that the stored
+ * predictions do not need to be scanned after reset.
+ */
+struct npgps_saved_index {
+	uint16_t gps_day;
+	uint32_t gps_time_of_day;
+	uint16_t prediction_count;
+	int8_t blocks[NUM_PREDICTIONS];
+};
+
 struct nrf_cloud_pgps_header;
 
 typedef int (*npgps_buffer_handler_t)(uint8_t *buf, size_t len);
@@ -54,6 +64,8 @@ void npgps_download_unlock(void);
 int npgps_save_header(struct nrf_cloud_pgps_header *header);
 const struct nrf_cloud_pgps_header *npgps_get_saved_header(void);
 const struct gps_location *npgps_get_saved_location(void);
+int npgps_save_index(const struct npgps_saved_index *new_index);
+const struct npgps_saved_index *npgps_get_saved_index(void);
 int npgps_settings_init(void);
 
 /* time functions */
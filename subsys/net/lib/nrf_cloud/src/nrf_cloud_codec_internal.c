@@ -24,6 +24,9 @@
 #include <zephyr/logging/log.h>
 #include <modem/modem_info.h>
 #include "cJSON_os.h"
+#if defined(CONFIG_NRF_CLOUD_JSON_WRITER)
+#include "nrf_cloud_json_writer.h"
+#endif
 
 LOG_MODULE_REGISTER(nrf_cloud_codec_internal, CONFIG_NRF_CLOUD_LOG_LEVEL);
 
@@ -422,17 +425,39 @@ static bool compare(const char *s1, const char *s2)
 	return !strncmp(s1, s2, strlen(s2));
 }
 
+#if defined(CONFIG_NRF_CLOUD_JSON_WRITER)
+static int sensor_data_write(struct nrf_cloud_json_writer *w, const void *ctx)
+{
+	const struct nrf_cloud_sensor_data *sensor = ctx;
+
+	nrf_cloud_json_obj_start(w, NULL);
+	nrf_cloud_json_str_add(w, NRF_CLOUD_JSON_APPID_KEY, sensor_type_str[sensor->type]);
+	nrf_cloud_json_str_add(w, NRF_CLOUD_JSON_DATA_KEY, sensor->data.ptr);
+	nrf_cloud_json_str_add(w, NRF_CLOUD_JSON_MSG_TYPE_KEY, NRF_CLOUD_JSON_MSG_TYPE_VAL_DATA);
+	if (sensor->ts_ms != NRF_CLOUD_NO_TIMESTAMP) {
+		nrf_cloud_json_int_add(w, NRF_CLOUD_MSG_TIMESTAMP_KEY, sensor->ts_ms);
+	}
+	nrf_cloud_json_obj_end(w);
+
+	return 0;
+}
+#endif /* CONFIG_NRF_CLOUD_JSON_WRITER */
+
 int nrf_cloud_sensor_data_encode(const struct nrf_cloud_sensor_data *sensor,
 				 struct nrf_cloud_data *output)
 {
-	int ret;
-
 	__ASSERT_NO_MSG(sensor != NULL);
 	__ASSERT_NO_MSG(sensor->data.ptr != NULL);
 	__ASSERT_NO_MSG(sensor->data.len != 0);
 	__ASSERT_NO_MSG(output != NULL);
 	__ASSERT_NO_MSG(sensor->type < SENSOR_TYPE_ARRAY_SIZE);
 
+#if defined(CONFIG_NRF_CLOUD_JSON_WRITER)
+	/* The buffer is freed by the caller with nrf_cloud_free() */
+	return nrf_cloud_json_encode_alloc(sensor_data_write, sensor, nrf_cloud_malloc,
+					   nrf_cloud_free, output);
+#else
+	int ret;
 	cJSON *root_obj = cJSON_CreateObject();
 
 	if (root_obj == NULL) {
@@ -465,6 +490,7 @@ int nrf_cloud_sensor_data_encode(const struct nrf_cloud_sensor_data *sensor,
 	output->len = strlen(buffer);
 
 	return 0;
+#endif /* CONFIG_NRF_CLOUD_JSON_WRITER */
 }
 
 #ifdef CONFIG_NRF_CLOUD_GATEWAY
@@ -1760,6 +1786,149 @@ void nrf_cloud_device_status_free(struct nrf_cloud_data *status)
 	}
 }
 
+#if defined(CONFIG_NRF_CLOUD_JSON_WRITER)
+struct dev_status_write_ctx {
+	const struct nrf_cloud_device_status *ds;
+	bool include_state;
+	bool include_reported;
+};
+
+/* The modem information is read from the modem_info library into a cJSON object */
+static bool dev_status_modem_info_set(const struct nrf_cloud_device_status *const ds)
+{
+	return IS_ENABLED(CONFIG_MODEM_INFO) && ds->modem &&
+	       ((ds->modem->device == NRF_CLOUD_INFO_SET) ||
+		(ds->modem->network == NRF_CLOUD_INFO_SET) ||
+		(ds->modem->sim == NRF_CLOUD_INFO_SET));
+}
+
+static void svc_info_fota_write(struct nrf_cloud_json_writer *w,
+				const struct nrf_cloud_svc_info_fota *const fota)
+{
+	if (!fota) {
+		nrf_cloud_json_null_add(w, NRF_CLOUD_JSON_KEY_SRVC_INFO_FOTA);
+		return;
+	}
+
+	const struct {
+		bool enabled;
+		const char *type;
+	} items[] = {
+		{ fota->bootloader, NRF_CLOUD_FOTA_TYPE_BOOT },
+		{ fota->modem, NRF_CLOUD_FOTA_TYPE_MODEM_DELTA },
+		{ fota->application, NRF_CLOUD_FOTA_TYPE_APP },
+		{ fota->modem_full, NRF_CLOUD_FOTA_TYPE_MODEM_FULL },
+	};
+
+	nrf_cloud_json_arr_start(w, NRF_CLOUD_JSON_KEY_SRVC_INFO_FOTA);
+	for (size_t i = 0; i < ARRAY_SIZE(items); i++) {
+		if (items[i].enabled) {
+			nrf_cloud_json_str_add(w, NULL, items[i].type);
+		}
+	}
+	nrf_cloud_json_arr_end(w);
+}
+
+static void svc_info_ui_write(struct nrf_cloud_json_writer *w,
+			      const struct nrf_cloud_svc_info_ui *const ui)
+{
+	if (!ui) {
+		nrf_cloud_json_null_add(w, NRF_CLOUD_JSON_KEY_SRVC_INFO_UI);
+		return;
+	}
+
+	/* Same order as nrf_cloud_encode_service_info_ui() */
+	const struct {
+		bool enabled;
+		enum nrf_cloud_sensor type;
+	} items[] = {
+		{ ui->air_pressure, NRF_CLOUD_SENSOR_AIR_PRESS },
+		{ ui->air_quality, NRF_CLOUD_SENSOR_AIR_QUAL },
+		{ ui->gnss, NRF_CLOUD_SENSOR_GNSS },
+		{ ui->flip, NRF_CLOUD_SENSOR_FLIP },
+		{ ui->button, NRF_CLOUD_SENSOR_BUTTON },
+		{ ui->temperature, NRF_CLOUD_SENSOR_TEMP },
+		{ ui->humidity, NRF_CLOUD_SENSOR_HUMID },
+		{ ui->light_sensor, NRF_CLOUD_SENSOR_LIGHT },
+		{ ui->rsrp, NRF_CLOUD_LTE_LINK_RSRP },
+		{ ui->log, NRF_CLOUD_LOG },
+		{ ui->dictionary_log, NRF_CLOUD_DICTIONARY_LOG },
+	};
+
+	nrf_cloud_json_arr_start(w, NRF_CLOUD_JSON_KEY_SRVC_INFO_UI);
+	for (size_t i = 0; i < ARRAY_SIZE(items); i++) {
+		if (items[i].enabled) {
+			nrf_cloud_json_str_add(w, NULL, sensor_type_str[items[i].type]);
+		}
+	}
+	nrf_cloud_json_arr_end(w);
+}
+
+static void info_clear_write(struct nrf_cloud_json_writer *w,
+			     const enum nrf_cloud_shadow_info inf, const char *const inf_name)
+{
+	if (inf == NRF_CLOUD_INFO_CLEAR) {
+		nrf_cloud_json_null_add(w, inf_name);
+	}
+}
+
+/* Same output as info_encode(), except for the modem information that is set */
+static void info_write(struct nrf_cloud_json_writer *w,
+		       const struct nrf_cloud_device_status *const ds)
+{
+	if (IS_ENABLED(CONFIG_MODEM_INFO) && ds->modem) {
+		info_clear_write(w, ds->modem->device, NRF_CLOUD_DEVICE_JSON_KEY_DEV_INF);
+		info_clear_write(w, ds->modem->network, NRF_CLOUD_DEVICE_JSON_KEY_NET_INF);
+		info_clear_write(w, ds->modem->sim, NRF_CLOUD_DEVICE_JSON_KEY_SIM_INF);
+	}
+
+	if (ds->svc) {
+		nrf_cloud_json_obj_start(w, NRF_CLOUD_JSON_KEY_SRVC_INFO);
+		svc_info_fota_write(w, ds->svc->fota);
+		svc_info_ui_write(w, ds->svc->ui);
+		nrf_cloud_json_obj_end(w);
+	}
+
+	if (ds->conn_inf == NRF_CLOUD_INFO_SET) {
+		nrf_cloud_json_obj_start(w, NRF_CLOUD_JSON_KEY_CONN_INFO);
+		nrf_cloud_json_str_add(w, NRF_CLOUD_JSON_KEY_PROTOCOL,
+				       NRF_CLOUD_JSON_VAL_CFGD_PROTO_VAL);
+		nrf_cloud_json_str_add(w, NRF_CLOUD_JSON_KEY_METHOD,
+				       NRF_CLOUD_JSON_VAL_CFGD_METHOD_VAL);
+		nrf_cloud_json_obj_end(w);
+	} else {
+		info_clear_write(w, ds->conn_inf, NRF_CLOUD_JSON_KEY_CONN_INFO);
+	}
+}
+
+static int dev_status_write(struct nrf_cloud_json_writer *w, const void *ctx)
+{
+	const struct dev_status_write_ctx *dctx = ctx;
+
+	nrf_cloud_json_obj_start(w, NULL);
+	if (dctx->include_state) {
+		nrf_cloud_json_obj_start(w, NRF_CLOUD_JSON_KEY_STATE);
+	}
+	if (dctx->include_reported) {
+		nrf_cloud_json_obj_start(w, NRF_CLOUD_JSON_KEY_REP);
+	}
+
+	nrf_cloud_json_obj_start(w, NRF_CLOUD_JSON_KEY_DEVICE);
+	info_write(w, dctx->ds);
+	nrf_cloud_json_obj_end(w);
+
+	if (dctx->include_reported) {
+		nrf_cloud_json_obj_end(w);
+	}
+	if (dctx->include_state) {
+		nrf_cloud_json_obj_end(w);
+	}
+	nrf_cloud_json_obj_end(w);
+
+	return 0;
+}
+#endif /* CONFIG_NRF_CLOUD_JSON_WRITER */
+
 int nrf_cloud_shadow_dev_status_encode(const struct nrf_cloud_device_status *const dev_status,
 	struct nrf_cloud_data * const output, const bool include_state, const bool include_reported)
 {
@@ -1767,6 +1936,26 @@ int nrf_cloud_shadow_dev_status_encode(const struct nrf_cloud_device_status *con
 		return -EINVAL;
 	}
 
+#if defined(CONFIG_NRF_CLOUD_JSON_WRITER)
+	if (!dev_status_modem_info_set(dev_status)) {
+		const struct dev_status_write_ctx ctx = {
+			.ds = dev_status,
+			.include_state = include_state,
+			.include_reported = include_reported,
+		};
+		/* Freed with nrf_cloud_device_status_free(), like the cJSON output */
+		int ret = nrf_cloud_json_encode_alloc(dev_status_write, &ctx, cJSON_malloc,
+						      cJSON_free, output);
+
+		if (ret) {
+			output->ptr = NULL;
+			output->len = 0;
+		}
+
+		return ret;
+	}
+#endif
+
 	int err = 0;
 	cJSON *state_obj = NULL;
 	cJSON *parent_obj = NULL;
@@ -2790,6 +2979,221 @@ cleanup:
 	return err;
 }
 
+#if defined(CONFIG_NRF_CLOUD_JSON_WRITER)
+struct location_req_write_ctx {
+	struct lte_lc_cells_info const *cells;
+	struct wifi_scan_info const *wifi;
+};
+
+static void rsrq_write(struct nrf_cloud_json_writer *w, const int16_t rsrq)
+{
+	/* RSRQ is in steps of 0.5 dB, so one decimal is exact */
+	nrf_cloud_json_decimal_add(w, NRF_CLOUD_CELL_POS_JSON_KEY_RSRQ,
+				   (int64_t)(RSRQ_IDX_TO_DB(rsrq) * 10.0f), 1);
+}
+
+/* Same output as add_lte_inf() and add_ncells() */
+static void lte_inf_write(struct nrf_cloud_json_writer *w, struct lte_lc_cell const *const inf,
+			  const uint8_t ncells_count, const struct lte_lc_ncell *const ncells)
+{
+	nrf_cloud_json_obj_start(w, NULL);
+	nrf_cloud_json_int_add(w, NRF_CLOUD_CELL_POS_JSON_KEY_ECI, inf->id);
+	nrf_cloud_json_int_add(w, NRF_CLOUD_CELL_POS_JSON_KEY_MCC, inf->mcc);
+	nrf_cloud_json_int_add(w, NRF_CLOUD_CELL_POS_JSON_KEY_MNC, inf->mnc);
+	nrf_cloud_json_int_add(w, NRF_CLOUD_CELL_POS_JSON_KEY_TAC, inf->tac);
+
+	if (inf->earfcn != NRF_CLOUD_LOCATION_CELL_OMIT_EARFCN) {
+		nrf_cloud_json_int_add(w, NRF_CLOUD_CELL_POS_JSON_KEY_EARFCN, inf->earfcn);
+	}
+	if (inf->rsrp != NRF_CLOUD_LOCATION_CELL_OMIT_RSRP) {
+		nrf_cloud_json_int_add(w, NRF_CLOUD_CELL_POS_JSON_KEY_RSRP,
+				       RSRP_IDX_TO_DBM(inf->rsrp));
+	}
+	if (inf->rsrq != NRF_CLOUD_LOCATION_CELL_OMIT_RSRQ) {
+		rsrq_write(w, inf->rsrq);
+	}
+	if (inf->timing_advance != NRF_CLOUD_LOCATION_CELL_OMIT_TIME_ADV) {
+		nrf_cloud_json_int_add(w, NRF_CLOUD_CELL_POS_JSON_KEY_T_ADV,
+				       MIN(inf->timing_advance,
+					   NRF_CLOUD_LOCATION_CELL_TIME_ADV_MAX));
+	}
+
+	if (ncells_count && ncells) {
+		nrf_cloud_json_arr_start(w, NRF_CLOUD_CELL_POS_JSON_KEY_NBORS);
+		for (uint8_t i = 0; i < ncells_count; ++i) {
+			const struct lte_lc_ncell *ncell = ncells + i;
+
+			nrf_cloud_json_obj_start(w, NULL);
+			nrf_cloud_json_int_add(w, NRF_CLOUD_CELL_POS_JSON_KEY_EARFCN, ncell->earfcn);
+			nrf_cloud_json_int_add(w, NRF_CLOUD_CELL_POS_JSON_KEY_PCI,
+					       ncell->phys_cell_id);
+			if (ncell->rsrp != NRF_CLOUD_LOCATION_CELL_OMIT_RSRP) {
+				nrf_cloud_json_int_add(w, NRF_CLOUD_CELL_POS_JSON_KEY_RSRP,
+						       RSRP_IDX_TO_DBM(ncell->rsrp));
+			}
+			if (ncell->rsrq != NRF_CLOUD_LOCATION_CELL_OMIT_RSRQ) {
+				rsrq_write(w, ncell->rsrq);
+			}
+			if (ncell->time_diff != LTE_LC_CELL_TIME_DIFF_INVALID) {
+				nrf_cloud_json_int_add(w, NRF_CLOUD_CELL_POS_JSON_KEY_TDIFF,
+						       ncell->time_diff);
+			}
+			nrf_cloud_json_obj_end(w);
+		}
+		nrf_cloud_json_arr_end(w);
+	}
+
+	nrf_cloud_json_obj_end(w);
+}
+
+static void cells_write(struct nrf_cloud_json_writer *w, struct lte_lc_cells_info const *const inf)
+{
+	nrf_cloud_json_arr_start(w, NRF_CLOUD_CELL_POS_JSON_KEY_LTE);
+
+	if (inf->current_cell.id != LTE_LC_CELL_EUTRAN_ID_INVALID) {
+		lte_inf_write(w, &inf->current_cell, inf->ncells_count, inf->neighbor_cells);
+	}
+
+	if (inf->gci_cells) {
+		for (uint8_t i = 0; i < inf->gci_cells_count; ++i) {
+			lte_inf_write(w, inf->gci_cells + i, 0, NULL);
+		}
+	}
+
+	nrf_cloud_json_arr_end(w);
+}
+
+static int wifi_ap_count(struct wifi_scan_info const *const wifi)
+{
+	int cnt = 0;
+
+	for (uint8_t i = 0; i < wifi->cnt; ++i) {
+		if (!is_local_mac(wifi->ap_info[i].mac)) {
+			++cnt;
+		}
+	}
+
+	return cnt;
+}
+
+/* Same output as nrf_cloud_wifi_req_json_encode() */
+static void wifi_write(struct nrf_cloud_json_writer *w, struct wifi_scan_info const *const wifi)
+{
+	const bool add_all = IS_ENABLED(CONFIG_NRF_CLOUD_WIFI_LOCATION_ENCODE_OPT_ALL);
+	const bool add_rssi = (add_all ||
+			       IS_ENABLED(CONFIG_NRF_CLOUD_WIFI_LOCATION_ENCODE_OPT_MAC_RSSI));
+
+	nrf_cloud_json_obj_start(w, NRF_CLOUD_LOCATION_JSON_KEY_WIFI);
+	nrf_cloud_json_arr_start(w, NRF_CLOUD_LOCATION_JSON_KEY_APS);
+
+	for (uint8_t cnt = 0; cnt < wifi->cnt; ++cnt) {
+		char mac_str[WIFI_MAC_ADDR_STR_LEN + 1];
+		struct wifi_scan_result const *const ap = (wifi->ap_info + cnt);
+
+		if (is_local_mac(ap->mac)) {
+			continue;
+		}
+
+		(void)snprintk(mac_str, sizeof(mac_str), WIFI_MAC_ADDR_TEMPLATE,
+			       ap->mac[0], ap->mac[1], ap->mac[2],
+			       ap->mac[3], ap->mac[4], ap->mac[5]);
+
+		nrf_cloud_json_obj_start(w, NULL);
+		nrf_cloud_json_str_add(w, NRF_CLOUD_LOCATION_JSON_KEY_WIFI_MAC, mac_str);
+
+		if (add_rssi && (ap->rssi != NRF_CLOUD_LOCATION_WIFI_OMIT_RSSI)) {
+			nrf_cloud_json_int_add(w, NRF_CLOUD_LOCATION_JSON_KEY_WIFI_RSSI, ap->rssi);
+		}
+
+		if (add_all) {
+			size_t ssid_len = 0;
+
+			if ((ap->ssid_length > 0) && (ap->ssid_length <= WIFI_SSID_MAX_LEN)) {
+				ssid_len = strnlen((const char *)ap->ssid, ap->ssid_length);
+			}
+			if (ssid_len) {
+				nrf_cloud_json_strn_add(w, NRF_CLOUD_LOCATION_JSON_KEY_WIFI_SSID,
+							(const char *)ap->ssid, ssid_len);
+			}
+			if (ap->channel != NRF_CLOUD_LOCATION_WIFI_OMIT_CHAN) {
+				nrf_cloud_json_int_add(w, NRF_CLOUD_LOCATION_JSON_KEY_WIFI_CH,
+						       ap->channel);
+			}
+		}
+
+		nrf_cloud_json_obj_end(w);
+	}
+
+	nrf_cloud_json_arr_end(w);
+	nrf_cloud_json_obj_end(w);
+}
+
+static int location_req_write(struct nrf_cloud_json_writer *w, const void *ctx)
+{
+	const struct location_req_write_ctx *lctx = ctx;
+
+	nrf_cloud_json_obj_start(w, NULL);
+	if (lctx->cells) {
+		cells_write(w, lctx->cells);
+	}
+	if (lctx->wifi) {
+		wifi_write(w, lctx->wifi);
+	}
+	nrf_cloud_json_obj_end(w);
+
+	return 0;
+}
+
+int nrf_cloud_location_req_json_encode(struct lte_lc_cells_info const *const cells_inf,
+				       struct wifi_scan_info const *const wifi_inf,
+				       struct nrf_cloud_data *const output)
+{
+	if (!output || (!cells_inf && !wifi_inf)) {
+		return -EINVAL;
+	}
+
+	struct location_req_write_ctx ctx = {0};
+
+	/* Check the input first, so that the same items as in
+	 * nrf_cloud_obj_location_request_payload_add() are written.
+	 */
+	if (cells_inf) {
+		if ((cells_inf->current_cell.id != LTE_LC_CELL_EUTRAN_ID_INVALID) ||
+		    (cells_inf->gci_cells_count && cells_inf->gci_cells)) {
+			ctx.cells = cells_inf;
+		} else if (wifi_inf) {
+			LOG_WRN("No GCI cells, excluding cellular data from request");
+		} else {
+			LOG_ERR("Failed to add cell info to location request, error: %d", -ENODATA);
+			return -ENODATA;
+		}
+	}
+
+	if (wifi_inf) {
+		if (!wifi_inf->ap_info || !wifi_inf->cnt) {
+			return -EINVAL;
+		}
+
+		if (wifi_ap_count(wifi_inf) >= NRF_CLOUD_LOCATION_WIFI_AP_CNT_MIN) {
+			ctx.wifi = wifi_inf;
+		} else {
+			LOG_WRN("At least %d APs (with a non-local MAC address) are required",
+				NRF_CLOUD_LOCATION_WIFI_AP_CNT_MIN);
+
+			if (!ctx.cells) {
+				LOG_ERR("Wi-Fi request not created");
+				return -ENODATA;
+			}
+			LOG_WRN("Excluding Wi-Fi data, request is cellular only");
+		}
+	}
+
+	/* The buffer is freed by the caller with nrf_cloud_free() */
+	return nrf_cloud_json_encode_alloc(location_req_write, &ctx, nrf_cloud_malloc,
+					   nrf_cloud_free, output);
+}
+#endif /* CONFIG_NRF_CLOUD_JSON_WRITER */
+
 static bool json_item_string_exists(const cJSON *const obj, const char *const key,
 				    const char *const val)
 {
@@ -0,0 +1,311 @@
+/*
+ * Copyright (c) 2024 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#include <errno.h>
+#include <string.h>
+#include <zephyr/sys/util.h>
+#include <zephyr/sys/__assert.h>
+#include "nrf_cloud_json_writer.h"
+
+/* Longest int64_t in decimal, with the sign */
+#define INT64_STR_LEN 20
+
+static void put(struct nrf_cloud_json_writer *w, const char *s, size_t n)
+{
+	if (w->buf && !w->err) {
+		/* Keep room for the null terminator */
+		if ((w->size - w->len) <= n) {
+			w->err = -ENOMEM;
+		} else {
+			memcpy(&w->buf[w->len], s, n);
+		}
+	}
+
+	w->len += n;
+}
+
+static void put_char(struct nrf_cloud_json_writer *w, char c)
+{
+	put(w, &c, 1);
+}
+
+static void put_escaped(struct nrf_cloud_json_writer *w, const char *s, size_t n)
+{
+	static const char hex[] = "0123456789abcdef";
+	size_t start = 0;
+
+	put_char(w, '"');
+
+	for (size_t i = 0; i < n; i++) {
+		unsigned char c = s[i];
+		char esc[6] = {'\\'};
+		size_t esc_len = 2;
+
+		if ((c >= 0x20) && (c != '"') && (c != '\\')) {
+			continue;
+		}
+
+		/* Same escapes as cJSON */
+		switch (c) {
+		case '"':
+		case '\\':
+			esc[1] = c;
+			break;
+		case '\b':
+			esc[1] = 'b';
+			break;
+		case '\f':
+			esc[1] = 'f';
+			break;
+		case '\n':
+			esc[1] = 'n';
+			break;
+		case '\r':
+			esc[1] = 'r';
+			break;
+		case '\t':
+			esc[1] = 't';
+			break;
+		default:
+			esc[1] = 'u';
+			esc[2] = '0';
+			esc[3] = '0';
+			esc[4] = hex[c >> 4];
+			esc[5] = hex[c & 0xf];
+			esc_len = 6;
+			break;
+		}
+
+		/* Copy the run of plain characters at once */
+		put(w, &s[start], i - start);
+		put(w, esc, esc_len);
+		start = i + 1;
+	}
+
+	put(w, &s[start], n - start);
+	put_char(w, '"');
+}
+
+/* Add the separator and the key of the next item */
+static void item_start(struct nrf_cloud_json_writer *w, const char *key)
+{
+	uint32_t bit = BIT(w->depth);
+
+	if (w->has_items & bit) {
+		put_char(w, ',');
+	}
+	w->has_items |= bit;
+
+	if (key) {
+		put_escaped(w, key, strlen(key));
+		put_char(w, ':');
+	}
+}
+
+static void container_start(struct nrf_cloud_json_writer *w, const char *key, char open)
+{
+	item_start(w, key);
+	put_char(w, open);
+
+	if (w->depth >= NRF_CLOUD_JSON_WRITER_DEPTH_MAX) {
+		w->err = w->err ? w->err : -EINVAL;
+		return;
+	}
+
+	w->depth++;
+	w->has_items &= ~BIT(w->depth);
+}
+
+static void container_end(struct nrf_cloud_json_writer *w, char close)
+{
+	if (w->depth == 0) {
+		w->err = w->err ? w->err : -EINVAL;
+		return;
+	}
+
+	w->depth--;
+	put_char(w, close);
+}
+
+void nrf_cloud_json_writer_init(struct nrf_cloud_json_writer *w, char *buf, size_t size)
+{
+	__ASSERT_NO_MSG(w != NULL);
+	__ASSERT_NO_MSG((buf == NULL) || (size > 0));
+
+	*w = (struct nrf_cloud_json_writer) {
+		.buf = buf,
+		.size = size,
+	};
+}
+
+void nrf_cloud_json_obj_start(struct nrf_cloud_json_writer *w, const char *key)
+{
+	container_start(w, key, '{');
+}
+
+void nrf_cloud_json_obj_end(struct nrf_cloud_json_writer *w)
+{
+	container_end(w, '}');
+}
+
+void nrf_cloud_json_arr_start(struct nrf_cloud_json_writer *w, const char *key)
+{
+	container_start(w, key, '[');
+}
+
+void nrf_cloud_json_arr_end(struct nrf_cloud_json_writer *w)
+{
+	container_end(w, ']');
+}
+
+void nrf_cloud_json_str_add(struct nrf_cloud_json_writer *w, const char *key, const char *val)
+{
+	nrf_cloud_json_strn_add(w, key, val, strlen(val));
+}
+
+void nrf_cloud_json_strn_add(struct nrf_cloud_json_writer *w, const char *key, const char *val,
+			     size_t len)
+{
+	item_start(w, key);
+	put_escaped(w, val, len);
+}
+
+/* Write the digits of val at the end of str, return the index of the first one */
+static size_t u64_format(char *str, size_t pos, uint64_t val, size_t min_digits)
+{
+	size_t end = pos;
+
+	do {
+		str[--pos] = '0' + (val % 10);
+		val /= 10;
+	} while (val || ((end - pos) < min_digits));
+
+	return pos;
+}
+
+void nrf_cloud_json_int_add(struct nrf_cloud_json_writer *w, const char *key, int64_t val)
+{
+	nrf_cloud_json_decimal_add(w, key, val, 0);
+}
+
+void nrf_cloud_json_decimal_add(struct nrf_cloud_json_writer *w, const char *key, int64_t val,
+				uint8_t decimals)
+{
+	char str[INT64_STR_LEN + 1];
+	size_t pos = sizeof(str);
+	uint64_t scale = 1;
+	/* Negate as unsigned, so that INT64_MIN does not overflow */
+	uint64_t abs = (val < 0) ? (0 - (uint64_t)val) : (uint64_t)val;
+	uint64_t frac;
+
+	__ASSERT_NO_MSG(decimals <= NRF_CLOUD_JSON_WRITER_DECIMALS_MAX);
+
+	for (uint8_t i = 0; i < decimals; i++) {
+		scale *= 10;
+	}
+
+	frac = abs % scale;
+
+	/* Like the %g format used by cJSON, drop the trailing zeros of the fraction */
+	while (frac && !(frac % 10)) {
+		frac /= 10;
+		decimals--;
+	}
+
+	if (frac) {
+		pos = u64_format(str, pos, frac, decimals);
+		str[--pos] = '.';
+	}
+
+	pos = u64_format(str, pos, abs / scale, 1);
+
+	if (val < 0) {
+		str[--pos] = '-';
+	}
+
+	item_start(w, key);
+	put(w, &str[pos], sizeof(str) - pos);
+}
+
+void nrf_cloud_json_bool_add(struct nrf_cloud_json_writer *w, const char *key, bool val)
+{
+	item_start(w, key);
+	if (val) {
+		put(w, "true", 4);
+	} else {
+		put(w, "false", 5);
+	}
+}
+
+void nrf_cloud_json_null_add(struct nrf_cloud_json_writer *w, const char *key)
+{
+	item_start(w, key);
+	put(w, "null", 4);
+}
+
+int nrf_cloud_json_writer_finish(struct nrf_cloud_json_writer *w)
+{
+	if (!w->err && w->depth) {
+		w->err = -EINVAL;
+	}
+
+	if (w->err) {
+		return w->err;
+	}
+
+	if (w->buf) {
+		w->buf[w->len] = '\0';
+	}
+
+	return (int)w->len;
+}
+
+int nrf_cloud_json_encode_alloc(nrf_cloud_json_encode_fn_t encode, const void *ctx,
+				void *(*alloc_fn)(size_t), void (*free_fn)(void *),
+				struct nrf_cloud_data *output)
+{
+	struct nrf_cloud_json_writer w;
+	char *buf;
+	size_t size;
+	int ret;
+
+	__ASSERT_NO_MSG(encode != NULL);
+	__ASSERT_NO_MSG(output != NULL);
+
+	/* Count the length */
+	nrf_cloud_json_writer_init(&w, NULL, 0);
+	ret = encode(&w, ctx);
+	if (ret) {
+		return ret;
+	}
+
+	ret = nrf_cloud_json_writer_finish(&w);
+	if (ret < 0) {
+		return ret;
+	}
+
+	size = (size_t)ret + 1;
+	buf = alloc_fn(size);
+	if (!buf) {
+		return -ENOMEM;
+	}
+
+	nrf_cloud_json_writer_init(&w, buf, size);
+	ret = encode(&w, ctx);
+	if (!ret) {
+		ret = nrf_cloud_json_writer_finish(&w);
+	}
+
+	if (ret < 0) {
+		free_fn(buf);
+		return ret;
+	}
+
+	output->ptr = buf;
+	output->len = (size_t)ret;
+
+	return 0;
+}
@@ -88,6 +88,11 @@ struct pgps_index {
 	 * a pointer.
 	 */
 	struct nrf_cloud_pgps_prediction *predictions[NUM_PREDICTIONS];
+
+	/* Predictions which have been validated since they were stored or
+	 * restored from the persisted prediction index.
+	 */
+	ATOMIC_DEFINE(checked, NUM_PREDICTIONS);
 };
 
 static struct pgps_index index;
@@ -337,6 +342,7 @@ static int validate_stored_predictions(uint16_t *first_bad_day,
 	for (pnum = 0; pnum < count; pnum++) {
 		index.predictions[pnum] = NULL;
 	}
+	memset(index.checked, 0, sizeof(index.checked));
 
 	npgps_reset_block_pool();
 
@@ -394,6 +400,7 @@ static int validate_stored_predictions(uint16_t *first_bad_day,
 		LOG_DBG("Prediction num:%u, loc:%p, blk:%d", pnum, pred, i);
 		__ASSERT(i != NO_BLOCK, "unexpected pointer value %p", pred);
 		npgps_mark_block_used(i, true);
+		atomic_set_bit(index.checked, pnum);
 	}
 
 	/* find first free block in flash, if any, after chronologicaly
@@ -427,6 +434,136 @@ static void get_prediction_day_time(int pnum, int64_t *gps_sec, uint16_t *gps_da
 	}
 }
 
+static void save_prediction_index(int num_valid)
+{
+	if (!IS_ENABLED(CONFIG_NRF_CLOUD_PGPS_PREDICTION_INDEX)) {
+		return;
+	}
+
+	struct npgps_saved_index saved = {
+		.gps_day = index.header.gps_day,
+		.gps_time_of_day = index.header.gps_time_of_day,
+		.prediction_count = index.header.prediction_count,
+	};
+	bool present = true;
+	int err;
+
+	for (int pnum = 0; pnum < NUM_PREDICTIONS; pnum++) {
+		/* only the predictions up to the first missing one are kept */
+		present = present && (pnum < num_valid) && (index.predictions[pnum] != NULL);
+		saved.blocks[pnum] = present ? get_prediction_block(pnum) : NO_BLOCK;
+	}
+
+	err = npgps_save_index(&saved);
+	if (err) {
+		LOG_WRN("Error saving prediction index:%d", err);
+	}
+}
+
+static void invalidate_prediction_index(void)
+{
+	if (!IS_ENABLED(CONFIG_NRF_CLOUD_PGPS_PREDICTION_INDEX) ||
+	    (npgps_get_saved_index()->prediction_count == 0)) {
+		return;
+	}
+
+	struct npgps_saved_index saved = {
+		.prediction_count = 0,
+	};
+	int err;
+
+	err = npgps_save_index(&saved);
+	if (err) {
+		LOG_WRN("Error invalidating prediction index:%d", err);
+	}
+}
+
+/**
+ * @brief Restore the catalog of predictions from the persisted prediction index,
+ * instead of reading every stored prediction. The predictions themselves are validated
+ * by check_prediction() when they are first used.
+ *
+ * @return Number of consecutive predictions available, or -ENOENT if the persisted index
+ * does not describe the stored prediction set.
+ */
+static int load_prediction_index(void)
+{
+	const struct npgps_saved_index *saved = npgps_get_saved_index();
+	uint16_t count = index.header.prediction_count;
+	bool used[NUM_BLOCKS] = { false };
+	int last_block = NO_BLOCK;
+	int block;
+	int pnum;
+
+	if ((saved->prediction_count != count) ||
+	    (saved->gps_day != (uint16_t)index.header.gps_day) ||
+	    (saved->gps_time_of_day != (uint32_t)index.header.gps_time_of_day)) {
+		LOG_INF("Prediction index does not match stored P-GPS data");
+		return -ENOENT;
+	}
+
+	discard_prediction_buffer();
+	memset(index.predictions, 0, sizeof(index.predictions));
+	memset(index.checked, 0, sizeof(index.checked));
+	npgps_reset_block_pool();
+
+	for (pnum = 0; pnum < count; pnum++) {
+		block = saved->blocks[pnum];
+		if ((block < 0) || (block >= NUM_BLOCKS) || used[block]) {
+			LOG_WRN("Prediction num:%u missing from index", pnum);
+			break;
+		}
+
+		used[block] = true;
+		index.predictions[pnum] = npgps_block_to_pointer(block);
+		npgps_mark_block_used(block, true);
+		last_block = block;
+	}
+
+	/* new downloads begin after the chronologically last prediction,
+	 * same as after validate_stored_predictions()
+	 */
+	if (last_block != NO_BLOCK) {
+		(void)npgps_find_first_free(last_block);
+	}
+
+	LOG_INF("Restored %u predictions from index", pnum);
+	npgps_print_blocks();
+	return pnum;
+}
+
+/**
+ * @brief Validate a prediction the first time it is used, when it was not validated
+ * at initialization. A bad prediction is discarded, and the persisted prediction index
+ * is invalidated so all predictions are validated after the next reset.
+ */
+static int check_prediction(int pnum, const struct nrf_cloud_pgps_prediction *p)
+{
+	uint16_t gps_day;
+	uint32_t gps_time_of_day;
+	int err;
+
+	if (!IS_ENABLED(CONFIG_NRF_CLOUD_PGPS_PREDICTION_INDEX) ||
+	    atomic_test_bit(index.checked, pnum)) {
+		return 0;
+	}
+
+	get_prediction_day_time(pnum, NULL, &gps_day, &gps_time_of_day);
+	err = validate_prediction(p, gps_day, gps_time_of_day,
+				  index.header.prediction_period_min, true, false);
+	if (err) {
+		LOG_ERR("Prediction num:%d, gps_day:%u, gps_time_of_day:%u is bad:%d; "
+			"discarding", pnum, gps_day, gps_time_of_day, err);
+		npgps_free_block(get_prediction_block(pnum));
+		index.predictions[pnum] = NULL;
+		invalidate_prediction_index();
+		return err;
+	}
+
+	atomic_set_bit(index.checked, pnum);
+	return 0;
+}
+
 static void discard_oldest_predictions(int num)
 {
 	int i;
@@ -454,6 +591,7 @@ static void discard_oldest_predictions(int num)
 	for (i = last; i < index.header.prediction_count; i++) {
 		pnum = i - last;
 		index.predictions[pnum] = index.predictions[i];
+		atomic_set_bit_to(index.checked, pnum, atomic_test_bit(index.checked, i));
 	}
 
 	/* set prediction pointers for 'last' in the newly empty
@@ -462,6 +600,7 @@ static void discard_oldest_predictions(int num)
 	for (pnum = index.header.prediction_count - last; pnum <
 	      index.header.prediction_count; pnum++) {
 		index.predictions[pnum] = NULL;
+		atomic_clear_bit(index.checked, pnum);
 	}
 	npgps_print_blocks();
 
@@ -482,6 +621,12 @@ static void discard_oldest_predictions(int num)
 	LOG_DBG("updated index to gps_sec:%d, day:%u, time:%u",
 		(int32_t)index.start_sec, index.header.gps_day,
 		index.header.gps_time_of_day);
+
+	if (IS_ENABLED(CONFIG_NRF_CLOUD_PGPS_PREDICTION_INDEX)) {
+		/* the persisted index must describe the same prediction set as the header */
+		npgps_save_header(&index.header);
+		save_prediction_index(index.header.prediction_count - last);
+	}
 }
 
 int nrf_cloud_pgps_notify_prediction(void)
@@ -680,6 +825,11 @@ int nrf_cloud_pgps_find_prediction(struct nrf_cloud_pgps_prediction **prediction
 	index.cur_pnum = pnum;
 	*prediction = get_prediction(pnum);
 	if (*prediction) {
+		err = check_prediction(pnum, *prediction);
+		if (err) {
+			*prediction = NULL;
+			return err;
+		}
 		err = validate_prediction(*prediction,
 					  cur_gps_day, cur_gps_time_of_day,
 					  period_min, false, margin);
@@ -1526,6 +1676,7 @@ static int consume_pgps_data(uint8_t pnum, const char *buf, size_t buf_len)
 				}
 
 				LOG_INF("All P-GPS data received. Done.");
+				save_prediction_index(index.header.prediction_count);
 				state = PGPS_READY;
 				if (evt_handler) {
 					struct nrf_cloud_pgps_event evt = {
@@ -1600,12 +1751,18 @@ int nrf_cloud_pgps_begin_update(void)
 		index.period_sec =
 			index.header.prediction_period_min * SEC_PER_MIN;
 		memset(index.predictions, 0, sizeof(index.predictions));
+		memset(index.checked, 0, sizeof(index.checked));
 	} else {
 		for (uint8_t pnum = index.pnum_offset;
 		     pnum < index.expected_count + index.pnum_offset; pnum++) {
 			index.predictions[pnum] = NULL;
+			atomic_clear_bit(index.checked, pnum);
 		}
 	}
+	/* the stored predictions no longer match the persisted index
+	 * until the download completes
+	 */
+	invalidate_prediction_index();
 	index.loading_count = 0;
 	index.store_block = npgps_alloc_block();
 	if (index.store_block == NO_BLOCK) {
@@ -1736,12 +1893,13 @@ int nrf_cloud_pgps_init(struct nrf_cloud_pgps_init_param *param)
 
 	state = PGPS_INITIALIZING;
 
-	uint16_t num_valid = 0;
+	int num_valid = 0;
 	uint16_t count = 0;
 	uint16_t period_min  = 0;
 	uint16_t gps_day = 0;
 	uint32_t gps_time_of_day = 0;
 	const struct nrf_cloud_pgps_header *saved_header;
+	bool indexed = false;
 
 	saved_header = npgps_get_saved_header();
 	if (validate_pgps_header(saved_header)) {
@@ -1757,16 +1915,30 @@ int nrf_cloud_pgps_init(struct nrf_cloud_pgps_init_param *param)
 		 */
 		LOG_INF("Checking stored P-GPS data; count:%u, period_min:%u",
 			count, period_min);
-		num_valid = validate_stored_predictions(&gps_day, &gps_time_of_day);
+		num_valid = -ENOENT;
+		if (IS_ENABLED(CONFIG_NRF_CLOUD_PGPS_PREDICTION_INDEX)) {
+			num_valid = load_prediction_index();
+			indexed = (num_valid >= 0);
+		}
+		if (num_valid < 0) {
+			num_valid = validate_stored_predictions(&gps_day, &gps_time_of_day);
+			save_prediction_index(num_valid);
+		}
 	}
 
 	struct nrf_cloud_pgps_prediction *found_prediction = NULL;
 	int pnum = -1;
 
-	LOG_DBG("num_valid:%u, count:%u", num_valid, count);
+	LOG_DBG("num_valid:%d, count:%u", num_valid, count);
 	if (num_valid) {
 		LOG_INF("Checking if P-GPS data is expired...");
 		err = nrf_cloud_pgps_find_prediction(&found_prediction);
+		if (indexed && (err == -EINVAL)) {
+			LOG_WRN("Prediction index is stale; checking stored P-GPS data");
+			num_valid = validate_stored_predictions(&gps_day, &gps_time_of_day);
+			save_prediction_index(num_valid);
+			err = num_valid ? nrf_cloud_pgps_find_prediction(&found_prediction) : 0;
+		}
 		if (err == -ETIMEDOUT) {
 			LOG_WRN("Predictions expired. Requesting predictions...");
 			num_valid = 0;
@@ -511,7 +511,11 @@ int nrf_cloud_rest_location_get(struct nrf_cloud_rest_context *const rest_ctx,
 	char *auth_hdr = NULL;
 	struct rest_client_req_context req;
 	struct rest_client_resp_context resp;
+#if defined(CONFIG_NRF_CLOUD_JSON_WRITER)
+	struct nrf_cloud_data payload = {0};
+#else
 	NRF_CLOUD_OBJ_JSON_DEFINE(payload_obj);
+#endif
 
 	memset(&resp, 0, sizeof(resp));
 	init_rest_client_request(rest_ctx, &req, HTTP_POST);
@@ -544,6 +548,18 @@ int nrf_cloud_rest_location_get(struct nrf_cloud_rest_context *const rest_ctx,
 
 	req.header_fields = (const char **)headers;
 
+#if defined(CONFIG_NRF_CLOUD_JSON_WRITER)
+	/* Encode the payload directly, without building a cJSON object */
+	ret = nrf_cloud_location_req_json_encode(request->cell_info, request->wifi_info,
+						 &payload);
+	if (ret) {
+		LOG_ERR("Failed to create location request payload, err: %d", ret);
+		goto clean_up;
+	}
+
+	/* Add the encoded payload to the REST request */
+	req.body = payload.ptr;
+#else
 	/* Init the payload object */
 	ret = nrf_cloud_obj_init(&payload_obj);
 	if (ret) {
@@ -568,6 +584,7 @@ int nrf_cloud_rest_location_get(struct nrf_cloud_rest_context *const rest_ctx,
 
 	/* Add the encoded payload to the REST request */
 	req.body = payload_obj.encoded_data.ptr;
+#endif
 
 	/* Make REST call */
 	ret = do_rest_client_request(rest_ctx, &req, &resp, true, do_reply);
@@ -591,9 +608,13 @@ int nrf_cloud_rest_location_get(struct nrf_cloud_rest_context *const rest_ctx,
 
 clean_up:
 	nrf_cloud_free(auth_hdr);
+#if defined(CONFIG_NRF_CLOUD_JSON_WRITER)
+	nrf_cloud_free((void *)payload.ptr);
+#else
 	/* Free the object and the encoded data */
 	(void)nrf_cloud_obj_free(&payload_obj);
 	(void)nrf_cloud_obj_cloud_encoded_free(&payload_obj);
+#endif
 
 	if (result) {
 		/* Add the nRF Cloud error to the response */
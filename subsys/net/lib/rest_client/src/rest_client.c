@@ -15,6 +15,7 @@
 #include <zephyr/posix/unistd.h>
 #include <zephyr/posix/netdb.h>
 #include <zephyr/posix/sys/socket.h>
+#include <zephyr/posix/poll.h>
 #else
 #include <zephyr/net/socket.h>
 #endif
@@ -30,6 +31,25 @@ LOG_MODULE_REGISTER(rest_client, CONFIG_REST_CLIENT_LOG_LEVEL);
 
 #define HTTP_PROTOCOL "HTTP/1.1"
 
+#if defined(CONFIG_REST_CLIENT_CONN_CACHE)
+/* Connections to hosts with longer names are not cached */
+#define CONN_CACHE_HOST_LEN 64
+
+struct conn_cache_entry {
+	bool used;
+	int fd;
+	char host[CONN_CACHE_HOST_LEN];
+	uint16_t port;
+	int sec_tag;
+	int tls_peer_verify;
+	int64_t released_ms;
+};
+
+static struct conn_cache_entry conn_cache[CONFIG_REST_CLIENT_CONN_CACHE_SIZE];
+static struct rest_client_conn_cache_stats conn_cache_stats;
+static K_MUTEX_DEFINE(conn_cache_lock);
+#endif /* CONFIG_REST_CLIENT_CONN_CACHE */
+
 static void rest_client_http_response_cb(struct http_response *rsp,
 					  enum http_final_call final_data,
 					  void *user_data)
@@ -264,6 +284,177 @@ clean_up:
 	return ret;
 }
 
+#if defined(CONFIG_REST_CLIENT_CONN_CACHE)
+static void conn_cache_sckt_close(int fd)
+{
+	if (close(fd)) {
+		LOG_WRN("Failed to close socket, error: %d", errno);
+	} else {
+		LOG_DBG("Cached socket with id: %d was closed", fd);
+	}
+}
+
+static bool conn_cache_entry_matches(const struct conn_cache_entry *entry,
+				     const struct rest_client_req_context *req_ctx)
+{
+	return entry->used &&
+	       (entry->port == req_ctx->port) &&
+	       (entry->sec_tag == req_ctx->sec_tag) &&
+	       (entry->tls_peer_verify == req_ctx->tls_peer_verify) &&
+	       !strcmp(entry->host, req_ctx->host);
+}
+
+/* An idle connection has nothing to read. If it is readable, the server has closed it. */
+static bool conn_cache_sckt_is_stale(int fd)
+{
+	struct pollfd fds[1] = {
+		{
+			.fd = fd,
+			.events = POLLIN,
+		},
+	};
+
+	return poll(fds, ARRAY_SIZE(fds), 0) != 0;
+}
+
+/* Take a cached connection for the request, or return REST_CLIENT_SCKT_CONNECT. */
+static int conn_cache_take(const struct rest_client_req_context *const req_ctx)
+{
+	int fd = REST_CLIENT_SCKT_CONNECT;
+	int64_t now = k_uptime_get();
+
+	k_mutex_lock(&conn_cache_lock, K_FOREVER);
+
+	for (size_t i = 0; i < ARRAY_SIZE(conn_cache); i++) {
+		struct conn_cache_entry *entry = &conn_cache[i];
+
+		if (!entry->used) {
+			continue;
+		}
+
+		if ((now - entry->released_ms) >=
+		    (CONFIG_REST_CLIENT_CONN_CACHE_IDLE_TIMEOUT * MSEC_PER_SEC)) {
+			conn_cache_sckt_close(entry->fd);
+			entry->used = false;
+			conn_cache_stats.expired++;
+		} else if ((fd == REST_CLIENT_SCKT_CONNECT) &&
+			   conn_cache_entry_matches(entry, req_ctx)) {
+			fd = entry->fd;
+			entry->used = false;
+		}
+	}
+
+	if (fd != REST_CLIENT_SCKT_CONNECT) {
+		if (conn_cache_sckt_is_stale(fd)) {
+			conn_cache_sckt_close(fd);
+			fd = REST_CLIENT_SCKT_CONNECT;
+			conn_cache_stats.stale++;
+		} else {
+			conn_cache_stats.reused++;
+		}
+	}
+
+	if (fd == REST_CLIENT_SCKT_CONNECT) {
+		conn_cache_stats.connected++;
+	}
+
+	k_mutex_unlock(&conn_cache_lock);
+
+	return fd;
+}
+
+/* A reused connection turned out to be closed by the server. */
+static void conn_cache_lost(void)
+{
+	k_mutex_lock(&conn_cache_lock, K_FOREVER);
+	conn_cache_stats.reused--;
+	conn_cache_stats.stale++;
+	conn_cache_stats.connected++;
+	k_mutex_unlock(&conn_cache_lock);
+}
+
+/* A request that failed on a reused connection may have reached the server anyway,
+ * so it is only sent again if repeating it has no further effect.
+ */
+static bool conn_cache_retry_allowed(enum http_method method)
+{
+	switch (method) {
+	case HTTP_GET:
+	case HTTP_HEAD:
+	case HTTP_PUT:
+	case HTTP_DELETE:
+		return true;
+	default:
+		return false;
+	}
+}
+
+/* Keep the connection of the request for the next requests. */
+static void conn_cache_put(const struct rest_client_req_context *const req_ctx)
+{
+	struct conn_cache_entry *entry = NULL;
+
+	if (strlen(req_ctx->host) >= CONN_CACHE_HOST_LEN) {
+		conn_cache_sckt_close(req_ctx->connect_socket);
+		return;
+	}
+
+	k_mutex_lock(&conn_cache_lock, K_FOREVER);
+
+	/* Use a free entry, or the one idle for the longest time */
+	for (size_t i = 0; i < ARRAY_SIZE(conn_cache); i++) {
+		if (!conn_cache[i].used) {
+			entry = &conn_cache[i];
+			break;
+		}
+
+		if (!entry || (conn_cache[i].released_ms < entry->released_ms)) {
+			entry = &conn_cache[i];
+		}
+	}
+
+	if (entry->used) {
+		conn_cache_sckt_close(entry->fd);
+		conn_cache_stats.evicted++;
+	}
+
+	entry->used = true;
+	entry->fd = req_ctx->connect_socket;
+	strcpy(entry->host, req_ctx->host);
+	entry->port = req_ctx->port;
+	entry->sec_tag = req_ctx->sec_tag;
+	entry->tls_peer_verify = req_ctx->tls_peer_verify;
+	entry->released_ms = k_uptime_get();
+
+	k_mutex_unlock(&conn_cache_lock);
+
+	LOG_DBG("Socket with id: %d was cached", req_ctx->connect_socket);
+}
+
+void rest_client_conn_cache_flush(void)
+{
+	k_mutex_lock(&conn_cache_lock, K_FOREVER);
+
+	for (size_t i = 0; i < ARRAY_SIZE(conn_cache); i++) {
+		if (conn_cache[i].used) {
+			conn_cache_sckt_close(conn_cache[i].fd);
+			conn_cache[i].used = false;
+		}
+	}
+
+	k_mutex_unlock(&conn_cache_lock);
+}
+
+void rest_client_conn_cache_stats_get(struct rest_client_conn_cache_stats *stats)
+{
+	__ASSERT_NO_MSG(stats != NULL);
+
+	k_mutex_lock(&conn_cache_lock, K_FOREVER);
+	*stats = conn_cache_stats;
+	k_mutex_unlock(&conn_cache_lock);
+}
+#endif /* CONFIG_REST_CLIENT_CONN_CACHE */
+
 static void rest_client_close_connection(struct rest_client_req_context *const req_ctx,
 					 struct rest_client_resp_context *const resp_ctx)
 {
@@ -373,6 +564,12 @@ int rest_client_request(struct rest_client_req_context *req_ctx,
 
 	struct http_request http_req;
 	int ret;
+#if defined(CONFIG_REST_CLIENT_CONN_CACHE)
+	struct http_request http_req_retry;
+	bool reused = false;
+	bool cached = (req_ctx->connect_socket == REST_CLIENT_SCKT_CONNECT) &&
+		      !req_ctx->keep_alive;
+#endif
 
 	rest_client_init_request(req_ctx, &http_req);
 
@@ -395,7 +592,33 @@ int rest_client_request(struct rest_client_req_context *req_ctx,
 		}
 	}
 
+#if defined(CONFIG_REST_CLIENT_CONN_CACHE)
+	if (cached) {
+		req_ctx->connect_socket = conn_cache_take(req_ctx);
+		reused = (req_ctx->connect_socket != REST_CLIENT_SCKT_CONNECT);
+		if (reused) {
+			(void)rest_client_sckt_timeouts_set(req_ctx->connect_socket,
+							    req_ctx->timeout_ms);
+		}
+	}
+
+	http_req_retry = http_req;
+	ret = rest_client_do_api_call(&http_req, req_ctx, resp_ctx);
+	if (ret && reused && (resp_ctx->total_response_len == 0) &&
+	    conn_cache_retry_allowed(req_ctx->http_method)) {
+		/* The server may close an idle connection while the request is sent.
+		 * Nothing was received, so send it again on a new connection.
+		 */
+		LOG_DBG("Cached connection lost, error: %d, reconnecting", ret);
+		conn_cache_sckt_close(req_ctx->connect_socket);
+		conn_cache_lost();
+		req_ctx->connect_socket = REST_CLIENT_SCKT_CONNECT;
+		http_req = http_req_retry;
+		ret = rest_client_do_api_call(&http_req, req_ctx, resp_ctx);
+	}
+#else
 	ret = rest_client_do_api_call(&http_req, req_ctx, resp_ctx);
+#endif
 	if (ret) {
 		LOG_ERR("rest_client_do_api_call() failed, err %d", ret);
 		goto clean_up;
@@ -413,6 +636,14 @@ int rest_client_request(struct rest_client_req_context *req_ctx,
 	LOG_DBG("API call response len: http status: %d, %u bytes", resp_ctx->http_status_code,
 		resp_ctx->response_len);
 
+#if defined(CONFIG_REST_CLIENT_CONN_CACHE)
+	/* HTTP/1.1 connections persist, unless the server sent "Connection: close" */
+	if (cached && http_should_keep_alive(&http_req.internal.parser)) {
+		conn_cache_put(req_ctx);
+		req_ctx->connect_socket = REST_CLIENT_SCKT_CONNECT;
+	}
+#endif
+
 clean_up:
 	if (req_ctx->connect_socket != REST_CLIENT_SCKT_CONNECT) {
 		/* Socket was not closed yet: */
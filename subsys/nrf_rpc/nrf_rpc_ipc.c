@@ -74,6 +74,63 @@ static void ept_bound(void *priv)
 	k_event_set(&ipc_config->endpoint.ept_bond, 0x01);
 }
 
+#if defined(CONFIG_NRF_RPC_IPC_SERVICE_RX_HOLD)
+struct rx_msg {
+	const struct nrf_rpc_tr *transport;
+	const void *data;
+	size_t len;
+};
+
+K_MSGQ_DEFINE(rx_msgq, sizeof(struct rx_msg), CONFIG_NRF_RPC_IPC_SERVICE_RX_QUEUE_SIZE,
+	      sizeof(void *));
+
+static void rx_thread_entry(void *p1, void *p2, void *p3)
+{
+	struct rx_msg msg;
+	struct nrf_rpc_ipc *ipc_config;
+	int err;
+
+	while (true) {
+		k_msgq_get(&rx_msgq, &msg, K_FOREVER);
+
+		ipc_config = msg.transport->ctx;
+		ipc_config->receive_cb(msg.transport, msg.data, msg.len, ipc_config->context);
+
+		/* nRF RPC does not access the packet after the receive callback returned. */
+		err = ipc_service_release_rx_buffer(&ipc_config->endpoint.ept, (void *)msg.data);
+		if (err < 0) {
+			LOG_ERR("Failed to release Rx buffer: %d", err);
+		}
+	}
+}
+
+K_THREAD_DEFINE(nrf_rpc_ipc_rx_thread, CONFIG_NRF_RPC_IPC_SERVICE_RX_STACK_SIZE,
+		rx_thread_entry, NULL, NULL, NULL,
+		CONFIG_NRF_RPC_IPC_SERVICE_RX_THREAD_PRIORITY, 0, 0);
+
+/* Holds the buffer and queues it for the receive thread. Fails if the
+ * IPC Service backend does not support holding buffers.
+ */
+static int rx_hold(const struct nrf_rpc_tr *transport, const void *data, size_t len)
+{
+	struct nrf_rpc_ipc *ipc_config = transport->ctx;
+	struct rx_msg msg = {
+		.transport = transport,
+		.data = data,
+		.len = len,
+	};
+	int err;
+
+	err = ipc_service_hold_rx_buffer(&ipc_config->endpoint.ept, (void *)data);
+	if (err < 0) {
+		return err;
+	}
+
+	/* Waiting for space keeps the packets in order. */
+	return k_msgq_put(&rx_msgq, &msg, K_FOREVER);
+}
+#endif /* defined(CONFIG_NRF_RPC_IPC_SERVICE_RX_HOLD) */
+
 static void ept_received(const void *data, size_t len, void *priv)
 {
 	const struct nrf_rpc_tr *transport = priv;
@@ -84,6 +141,12 @@ static void ept_received(const void *data, size_t len, void *priv)
 
 	DUMP_LIMITED_DBG(data, len, "Received");
 
+#if defined(CONFIG_NRF_RPC_IPC_SERVICE_RX_HOLD)
+	if (rx_hold(transport, data, len) == 0) {
+		return;
+	}
+#endif /* defined(CONFIG_NRF_RPC_IPC_SERVICE_RX_HOLD) */
+
 	ipc_config->receive_cb(transport, data, len, ipc_config->context);
 }
 
@@ -12,13 +12,6 @@
 /* Maximum number of remote thread that this implementation allows. */
 #define MAX_REMOTE_THREADS 255
 
-/* Initial value contains ones (context free) on the
- * CONFIG_NRF_RPC_CMD_CTX_POOL_SIZE most significant bits.
- */
-#define CONTEXT_MASK_INIT_VALUE						       \
-	(~(((atomic_val_t)1 << (8 * sizeof(atomic_val_t) -		       \
-				CONFIG_NRF_RPC_CMD_CTX_POOL_SIZE)) - 1))
-
 struct pool_start_msg {
 	const uint8_t *data;
 	size_t len;
@@ -29,8 +22,10 @@ static nrf_rpc_os_work_t thread_pool_callback;
 static struct pool_start_msg pool_start_msg_buf[2];
 static struct k_msgq pool_start_msg;
 
-static struct k_sem context_reserved;
-static atomic_t context_mask;
+/* Numbers of the free command contexts. Reserving a context pops a number,
+ * waiting for one to be released if the pool is empty.
+ */
+K_STACK_DEFINE(nrf_rpc_os_ctx_pool, CONFIG_NRF_RPC_CMD_CTX_POOL_SIZE);
 
 static K_THREAD_STACK_ARRAY_DEFINE(pool_stacks,
 	CONFIG_NRF_RPC_THREAD_POOL_SIZE,
@@ -40,10 +35,6 @@ static struct k_thread pool_threads[CONFIG_NRF_RPC_THREAD_POOL_SIZE];
 
 BUILD_ASSERT(CONFIG_NRF_RPC_CMD_CTX_POOL_SIZE > 0,
 	     "CONFIG_NRF_RPC_CMD_CTX_POOL_SIZE must be greaten than zero");
-BUILD_ASSERT(CONFIG_NRF_RPC_CMD_CTX_POOL_SIZE <= 8 * sizeof(atomic_val_t),
-	     "CONFIG_NRF_RPC_CMD_CTX_POOL_SIZE too big");
-BUILD_ASSERT(sizeof(uint32_t) == sizeof(atomic_val_t),
-	     "Only atomic_val_t is implemented that is the same as uint32_t");
 
 static void thread_pool_entry(void *p1, void *p2, void *p3)
 {
@@ -64,14 +55,17 @@ int nrf_rpc_os_init(nrf_rpc_os_work_t callback)
 
 	thread_pool_callback = callback;
 
-	err = k_sem_init(&context_reserved, CONFIG_NRF_RPC_CMD_CTX_POOL_SIZE,
-			 CONFIG_NRF_RPC_CMD_CTX_POOL_SIZE);
-	if (err < 0) {
-		return err;
+	/* Pushed in reverse order, so that the first reservations after the initialization
+	 * get the lowest numbers. The stack is LIFO, so the most recently released context
+	 * is reserved next afterwards.
+	 */
+	for (i = CONFIG_NRF_RPC_CMD_CTX_POOL_SIZE - 1; i >= 0; i--) {
+		err = k_stack_push(&nrf_rpc_os_ctx_pool, i);
+		if (err < 0) {
+			return err;
+		}
 	}
 
-	atomic_set(&context_mask, CONTEXT_MASK_INIT_VALUE);
-
 	k_msgq_init(&pool_start_msg, (char *)pool_start_msg_buf,
 		    sizeof(struct pool_start_msg),
 		    ARRAY_SIZE(pool_start_msg_buf));
@@ -118,17 +112,9 @@ void nrf_rpc_os_msg_get(struct nrf_rpc_os_msg *msg, const uint8_t **data,
 
 uint32_t nrf_rpc_os_ctx_pool_reserve(void)
 {
-	uint32_t number;
-	atomic_val_t old_mask;
-	atomic_val_t new_mask;
-
-	k_sem_take(&context_reserved, K_FOREVER);
+	stack_data_t number;
 
-	do {
-		old_mask = atomic_get(&context_mask);
-		number = __CLZ(old_mask);
-		new_mask = old_mask & ~(0x80000000u >> number);
-	} while (!atomic_cas(&context_mask, old_mask, new_mask));
+	(void)k_stack_pop(&nrf_rpc_os_ctx_pool, &number, K_FOREVER);
 
 	return number;
 }
@@ -137,6 +123,5 @@ void nrf_rpc_os_ctx_pool_release(uint32_t number)
 {
 	__ASSERT_NO_MSG(number < CONFIG_NRF_RPC_CMD_CTX_POOL_SIZE);
 
-	atomic_or(&context_mask, 0x80000000u >> number);
-	k_sem_give(&context_reserved);
+	(void)k_stack_push(&nrf_rpc_os_ctx_pool, number);
 }
@@ -0,0 +1,119 @@
+/*
+ * Copyright (c) 2024 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#include <zephyr/ztest.h>
+#include <string.h>
+#include <zephyr/kernel.h>
+
+#include <modem/at_cmd_parser.h>
+#include <modem/at_params.h>
+#include <modem/at_cursor.h>
+
+#define BENCH_ITERATIONS (100)
+#define BENCH_PARAMS_MAX (32)
+
+/* Responses recorded from an nRF9160 modem */
+static const char * const responses[] = {
+	"%XMONITOR: 1,\"EDAV\",\"EDAV\",\"26295\",\"00B7\",7,4,\"00011B07\",7,2300,63,39,\"\","
+	"\"11100000\",\"11100000\",\"01001001\"\r\nOK\r\n",
+	"%NCELLMEAS: 0,\"0199F10A\",\"26295\",\"0107\",65535,5300,6,50,34,106,2300,7,63,31,"
+	"150344527,2300,8,60,29,0,2400,11,55,26,184\r\nOK\r\n",
+	"+CEREG: 5,\"0107\",\"0199F10A\",7,,,\"11100000\",\"11100000\"\r\nOK\r\n",
+};
+
+static struct at_param_list list;
+
+/* Read every parameter, decoding numbers, and return a checksum of the decoded values. */
+static int64_t params_read(const char *response)
+{
+	int64_t sum = 0;
+	int64_t value;
+	const char *str;
+	size_t len;
+	int err;
+
+	err = at_parser_max_params_from_str(response, NULL, &list, BENCH_PARAMS_MAX);
+	zassert_equal(err, 0, "Parsing failed, err %d", err);
+
+	for (size_t i = 0; i < BENCH_PARAMS_MAX; i++) {
+		if (at_params_type_get(&list, i) == AT_PARAM_TYPE_NUM_INT) {
+			at_params_int64_get(&list, i, &value);
+			sum += value;
+		} else if (at_params_type_get(&list, i) == AT_PARAM_TYPE_STRING) {
+			at_params_string_ptr_get(&list, i, &str, &len);
+			sum += len;
+		}
+	}
+
+	return sum;
+}
+
+static int64_t cursor_read(const char *response)
+{
+	struct at_cursor cursor;
+	struct at_cursor_token token;
+	int64_t sum = 0;
+	int64_t value;
+
+	at_cursor_init(&cursor, response);
+
+	while (at_cursor_next(&cursor, &token) == 0) {
+		if (token.type == AT_CURSOR_TOKEN_TYPE_NUMBER &&
+		    at_cursor_token_int64_get(&token, &value) == 0) {
+			sum += value;
+		} else if (token.type != AT_CURSOR_TOKEN_TYPE_EMPTY) {
+			sum += token.len;
+		}
+	}
+
+	return sum;
+}
+
+ZTEST(at_cursor_benchmark, test_benchmark_responses)
+{
+	uint32_t start;
+	uint32_t params_cycles;
+	uint32_t cursor_cycles;
+	int64_t params_sum;
+	int64_t cursor_sum;
+
+	for (size_t r = 0; r < ARRAY_SIZE(responses); r++) {
+		start = k_cycle_get_32();
+		for (int i = 0; i < BENCH_ITERATIONS; i++) {
+			params_sum = params_read(responses[r]);
+		}
+		params_cycles = (k_cycle_get_32() - start) / BENCH_ITERATIONS;
+
+		start = k_cycle_get_32();
+		for (int i = 0; i < BENCH_ITERATIONS; i++) {
+			cursor_sum = cursor_read(responses[r]);
+		}
+		cursor_cycles = (k_cycle_get_32() - start) / BENCH_ITERATIONS;
+
+		zassert_equal(params_sum, cursor_sum, "Parsers disagree on response %d", r);
+
+		TC_PRINT("%.*s: at_params %u cycles (%u us), at_cursor %u cycles (%u us)\n",
+			 (int)strcspn(responses[r], ":"), responses[r], params_cycles,
+			 k_cyc_to_us_floor32(params_cycles), cursor_cycles,
+			 k_cyc_to_us_floor32(cursor_cycles));
+	}
+}
+
+static void *benchmark_setup(void)
+{
+	zassert_equal(at_params_list_init(&list, BENCH_PARAMS_MAX), 0, "List init failed");
+
+	return NULL;
+}
+
+static void benchmark_teardown(void *fixture)
+{
+	ARG_UNUSED(fixture);
+
+	at_params_list_free(&list);
+}
+
+ZTEST_SUITE(at_cursor_benchmark, NULL, benchmark_setup, NULL, NULL, benchmark_teardown);
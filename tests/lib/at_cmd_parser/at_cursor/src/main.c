@@ -0,0 +1,269 @@
+/*
+ * Copyright (c) 2024 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#include <zephyr/ztest.h>
+#include <string.h>
+#include <zephyr/kernel.h>
+
+#include <modem/at_cursor.h>
+
+static struct at_cursor cursor;
+static struct at_cursor_token token;
+
+static void token_next_check(enum at_cursor_token_type type, const char *str)
+{
+	int err = at_cursor_next(&cursor, &token);
+
+	zassert_equal(err, 0, "Unexpected error %d before \"%s\"", err, str);
+	zassert_equal(token.type, type, "Wrong type %d of \"%.*s\"", token.type, token.len,
+		      token.start);
+	zassert_true(at_cursor_token_equal(&token, str), "Expected \"%s\", got \"%.*s\"", str,
+		     token.len, token.start);
+}
+
+static void line_end_check(void)
+{
+	zassert_equal(at_cursor_next(&cursor, &token), -ENODATA, "Line did not end");
+}
+
+ZTEST(at_cursor, test_cursor_fail_on_invalid_input)
+{
+	zassert_equal(at_cursor_init(NULL, "+CEREG: 1"), -EINVAL);
+	zassert_equal(at_cursor_init(&cursor, NULL), -EINVAL);
+
+	zassert_equal(at_cursor_init(&cursor, "+CEREG: 1"), 0);
+	zassert_equal(at_cursor_next(&cursor, NULL), -EINVAL);
+	zassert_equal(at_cursor_next(NULL, &token), -EINVAL);
+	zassert_equal(at_cursor_line_next(NULL), -EINVAL);
+}
+
+ZTEST(at_cursor, test_cursor_notification)
+{
+	int32_t value;
+
+	at_cursor_init(&cursor, "+CEREG: 2,\"76C1\",\"0102DA04\", 7\r\nOK\r\n");
+
+	token_next_check(AT_CURSOR_TOKEN_TYPE_PREFIX, "+CEREG");
+	token_next_check(AT_CURSOR_TOKEN_TYPE_NUMBER, "2");
+	zassert_equal(at_cursor_token_int_get(&token, &value), 0);
+	zassert_equal(value, 2);
+	token_next_check(AT_CURSOR_TOKEN_TYPE_STRING, "76C1");
+	token_next_check(AT_CURSOR_TOKEN_TYPE_STRING, "0102DA04");
+	token_next_check(AT_CURSOR_TOKEN_TYPE_NUMBER, "7");
+	zassert_equal(at_cursor_token_int_get(&token, &value), 0);
+	zassert_equal(value, 7);
+	line_end_check();
+	line_end_check();
+
+	zassert_equal(at_cursor_line_next(&cursor), -ENODATA, "Result code not detected");
+}
+
+ZTEST(at_cursor, test_cursor_empty_params)
+{
+	at_cursor_init(&cursor, "+CPSMS: 1,,,\"10101111\",\r\n");
+
+	token_next_check(AT_CURSOR_TOKEN_TYPE_PREFIX, "+CPSMS");
+	token_next_check(AT_CURSOR_TOKEN_TYPE_NUMBER, "1");
+	token_next_check(AT_CURSOR_TOKEN_TYPE_EMPTY, "");
+	token_next_check(AT_CURSOR_TOKEN_TYPE_EMPTY, "");
+	token_next_check(AT_CURSOR_TOKEN_TYPE_STRING, "10101111");
+	token_next_check(AT_CURSOR_TOKEN_TYPE_EMPTY, "");
+	line_end_check();
+
+	at_cursor_init(&cursor, "+CPSMS: \r\n");
+
+	token_next_check(AT_CURSOR_TOKEN_TYPE_PREFIX, "+CPSMS");
+	line_end_check();
+}
+
+ZTEST(at_cursor, test_cursor_multiline)
+{
+	int32_t value;
+	int lines = 0;
+
+	at_cursor_init(&cursor, "\r\n+CGEQOSRDP: 0,0,,\r\n"
+				"+CGEQOSRDP: 1,2,,\r\n"
+				"+CGEQOSRDP: 2,4,,,1,65280000\r\nOK\r\n");
+
+	do {
+		token_next_check(AT_CURSOR_TOKEN_TYPE_PREFIX, "+CGEQOSRDP");
+		zassert_equal(at_cursor_next(&cursor, &token), 0);
+		zassert_equal(at_cursor_token_int_get(&token, &value), 0);
+		zassert_equal(value, lines);
+		lines++;
+	} while (at_cursor_line_next(&cursor) == 0);
+
+	zassert_equal(lines, 3);
+}
+
+ZTEST(at_cursor, test_cursor_sms_pdu)
+{
+	at_cursor_init(&cursor, "+CMT: \"12345678\", 24\r\n"
+				"06917429000171040A91747966543100009160402143708006C8329BFD0601\r\n");
+
+	token_next_check(AT_CURSOR_TOKEN_TYPE_PREFIX, "+CMT");
+	token_next_check(AT_CURSOR_TOKEN_TYPE_STRING, "12345678");
+	token_next_check(AT_CURSOR_TOKEN_TYPE_NUMBER, "24");
+	line_end_check();
+
+	zassert_equal(at_cursor_line_next(&cursor), 0);
+	token_next_check(AT_CURSOR_TOKEN_TYPE_STRING,
+			 "06917429000171040A91747966543100009160402143708006C8329BFD0601");
+	line_end_check();
+
+	zassert_equal(at_cursor_line_next(&cursor), -ENODATA);
+}
+
+ZTEST(at_cursor, test_cursor_quoted_line_break)
+{
+	at_cursor_init(&cursor, "%CMNG: 12345678, 0, \"978C\","
+				"\"-----BEGIN CERTIFICATE-----\r\n"
+				"MIIBc464\r\n"
+				"-----END CERTIFICATE-----\"\r\n"
+				"%CMNG: 12345679, 0, \"978D\"\r\nERROR\r\n");
+
+	token_next_check(AT_CURSOR_TOKEN_TYPE_PREFIX, "%CMNG");
+	token_next_check(AT_CURSOR_TOKEN_TYPE_NUMBER, "12345678");
+
+	/* The rest of the line, including the certificate, is skipped */
+	zassert_equal(at_cursor_line_next(&cursor), 0);
+	token_next_check(AT_CURSOR_TOKEN_TYPE_PREFIX, "%CMNG");
+	token_next_check(AT_CURSOR_TOKEN_TYPE_NUMBER, "12345679");
+
+	zassert_equal(at_cursor_line_next(&cursor), -ENODATA);
+}
+
+ZTEST(at_cursor, test_cursor_unterminated)
+{
+	at_cursor_init(&cursor, "+CEREG: 2,\"76C1");
+
+	token_next_check(AT_CURSOR_TOKEN_TYPE_PREFIX, "+CEREG");
+	token_next_check(AT_CURSOR_TOKEN_TYPE_NUMBER, "2");
+	zassert_equal(at_cursor_next(&cursor, &token), -EBADMSG);
+	line_end_check();
+
+	at_cursor_init(&cursor, "+TEST: (1,2\r\n");
+
+	token_next_check(AT_CURSOR_TOKEN_TYPE_PREFIX, "+TEST");
+	zassert_equal(at_cursor_next(&cursor, &token), -EBADMSG);
+}
+
+ZTEST(at_cursor, test_cursor_forced_strings)
+{
+	at_cursor_init(&cursor, "+CGEV: ME PDN ACT 0\r\n");
+
+	token_next_check(AT_CURSOR_TOKEN_TYPE_PREFIX, "+CGEV");
+	token_next_check(AT_CURSOR_TOKEN_TYPE_STRING, "ME PDN ACT 0");
+
+	at_cursor_init(&cursor, "mfw_nrf9160_0.7.0-23.prealpha\r\nOK\r\n");
+
+	token_next_check(AT_CURSOR_TOKEN_TYPE_STRING, "mfw_nrf9160_0.7.0-23.prealpha");
+	line_end_check();
+}
+
+ZTEST(at_cursor, test_cursor_commands)
+{
+	at_cursor_init(&cursor, "AT+CFUN=1");
+
+	token_next_check(AT_CURSOR_TOKEN_TYPE_PREFIX, "AT+CFUN");
+	token_next_check(AT_CURSOR_TOKEN_TYPE_NUMBER, "1");
+	line_end_check();
+
+	at_cursor_init(&cursor, "AT%XSYSTEMMODE=?");
+
+	token_next_check(AT_CURSOR_TOKEN_TYPE_PREFIX, "AT%XSYSTEMMODE");
+	line_end_check();
+
+	at_cursor_init(&cursor, "AT+CEREG?");
+
+	token_next_check(AT_CURSOR_TOKEN_TYPE_PREFIX, "AT+CEREG");
+	line_end_check();
+}
+
+ZTEST(at_cursor, test_cursor_arrays)
+{
+	uint32_t array[3];
+	size_t len = ARRAY_SIZE(array);
+
+	at_cursor_init(&cursor, "+TEST: (1,2, 128),(3,4,5,6),(\"roam\",(0,1))\r\n");
+
+	token_next_check(AT_CURSOR_TOKEN_TYPE_PREFIX, "+TEST");
+	token_next_check(AT_CURSOR_TOKEN_TYPE_ARRAY, "1,2, 128");
+	zassert_equal(at_cursor_token_array_get(&token, array, &len), 0);
+	zassert_equal(len, 3);
+	zassert_equal(array[0], 1);
+	zassert_equal(array[1], 2);
+	zassert_equal(array[2], 128);
+
+	token_next_check(AT_CURSOR_TOKEN_TYPE_ARRAY, "3,4,5,6");
+	len = ARRAY_SIZE(array);
+	zassert_equal(at_cursor_token_array_get(&token, array, &len), -ENOMEM);
+
+	token_next_check(AT_CURSOR_TOKEN_TYPE_ARRAY, "\"roam\",(0,1)");
+	len = ARRAY_SIZE(array);
+	zassert_equal(at_cursor_token_array_get(&token, array, &len), -EINVAL);
+
+	line_end_check();
+}
+
+ZTEST(at_cursor, test_cursor_numbers)
+{
+	int64_t value64;
+	int32_t value;
+	uint32_t uvalue;
+
+	at_cursor_init(&cursor, "+TEST: -2147483648,4294967295,-9223372036854775808,"
+				"9223372036854775808,8901234567890123456F,-\r\n");
+
+	token_next_check(AT_CURSOR_TOKEN_TYPE_PREFIX, "+TEST");
+
+	token_next_check(AT_CURSOR_TOKEN_TYPE_NUMBER, "-2147483648");
+	zassert_equal(at_cursor_token_int_get(&token, &value), 0);
+	zassert_equal(value, INT32_MIN);
+	zassert_equal(at_cursor_token_unsigned_int_get(&token, &uvalue), -ERANGE);
+
+	token_next_check(AT_CURSOR_TOKEN_TYPE_NUMBER, "4294967295");
+	zassert_equal(at_cursor_token_int_get(&token, &value), -ERANGE);
+	zassert_equal(at_cursor_token_unsigned_int_get(&token, &uvalue), 0);
+	zassert_equal(uvalue, UINT32_MAX);
+
+	token_next_check(AT_CURSOR_TOKEN_TYPE_NUMBER, "-9223372036854775808");
+	zassert_equal(at_cursor_token_int64_get(&token, &value64), 0);
+	zassert_equal(value64, INT64_MIN);
+
+	token_next_check(AT_CURSOR_TOKEN_TYPE_NUMBER, "9223372036854775808");
+	zassert_equal(at_cursor_token_int64_get(&token, &value64), -ERANGE);
+
+	/* Decoded only on demand, so a number-like string can still be read as a string */
+	token_next_check(AT_CURSOR_TOKEN_TYPE_NUMBER, "8901234567890123456F");
+	zassert_equal(at_cursor_token_int64_get(&token, &value64), -EINVAL);
+
+	token_next_check(AT_CURSOR_TOKEN_TYPE_NUMBER, "-");
+	zassert_equal(at_cursor_token_int64_get(&token, &value64), -EINVAL);
+
+	line_end_check();
+}
+
+ZTEST(at_cursor, test_cursor_string_get)
+{
+	char buf[5];
+	size_t len = sizeof(buf);
+
+	at_cursor_init(&cursor, "+CEREG: 2,\"76C1\",\"0102DA04\"\r\n");
+
+	token_next_check(AT_CURSOR_TOKEN_TYPE_PREFIX, "+CEREG");
+	token_next_check(AT_CURSOR_TOKEN_TYPE_NUMBER, "2");
+	token_next_check(AT_CURSOR_TOKEN_TYPE_STRING, "76C1");
+	zassert_equal(at_cursor_token_string_get(&token, buf, &len), 0);
+	zassert_equal(len, 4);
+	zassert_mem_equal(buf, "76C1", 5);
+
+	token_next_check(AT_CURSOR_TOKEN_TYPE_STRING, "0102DA04");
+	len = sizeof(buf);
+	zassert_equal(at_cursor_token_string_get(&token, buf, &len), -ENOMEM);
+}
+
+ZTEST_SUITE(at_cursor, NULL, NULL, NULL, NULL, NULL);
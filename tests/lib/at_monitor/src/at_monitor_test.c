@@ -0,0 +1,215 @@
+/*
+ * Copyright (c) 2024 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+#include <unity.h>
+#include <string.h>
+#include <zephyr/kernel.h>
+#include <modem/at_monitor.h>
+#include <mock_nrf_modem_at.h>
+
+#include "cmock_nrf_modem_at.h"
+
+/* Time for the system workqueue to dispatch the notifications */
+#define DISPATCH_WAIT K_MSEC(10)
+
+/* at_monitor_dispatch() is implemented in at_monitor library and
+ * we'll call it directly to fake received AT notifications
+ */
+extern void at_monitor_dispatch(const char *at_notif);
+
+AT_MONITOR(mon_cereg, "+CEREG", cereg_handler);
+AT_MONITOR(mon_cereg_dup, "+CEREG", cereg_dup_handler);
+/* Overlaps with the end of "+CEREG" */
+AT_MONITOR(mon_reg, "REG:", reg_handler);
+AT_MONITOR(mon_cgev, "+CGEV: ME", cgev_handler);
+AT_MONITOR(mon_any, ANY, any_handler);
+AT_MONITOR(mon_paused, "+CEREG", paused_handler, PAUSED);
+AT_MONITOR_ISR(mon_isr, "+CSCON", isr_handler);
+
+static int cereg_count;
+static int cereg_dup_count;
+static int reg_count;
+static int cgev_count;
+static int any_count;
+static int paused_count;
+static int isr_count;
+
+static void cereg_handler(const char *notif)
+{
+	TEST_ASSERT_NOT_NULL(strstr(notif, "+CEREG"));
+	cereg_count++;
+}
+
+static void cereg_dup_handler(const char *notif)
+{
+	TEST_ASSERT_NOT_NULL(strstr(notif, "+CEREG"));
+	cereg_dup_count++;
+}
+
+static void reg_handler(const char *notif)
+{
+	TEST_ASSERT_NOT_NULL(strstr(notif, "REG:"));
+	reg_count++;
+}
+
+static void cgev_handler(const char *notif)
+{
+	TEST_ASSERT_NOT_NULL(strstr(notif, "+CGEV: ME"));
+	cgev_count++;
+}
+
+static void any_handler(const char *notif)
+{
+	any_count++;
+}
+
+static void paused_handler(const char *notif)
+{
+	paused_count++;
+}
+
+static void isr_handler(const char *notif)
+{
+	TEST_ASSERT_NOT_NULL(strstr(notif, "+CSCON"));
+	isr_count++;
+}
+
+void setUp(void)
+{
+	mock_nrf_modem_at_Init();
+
+	cereg_count = 0;
+	cereg_dup_count = 0;
+	reg_count = 0;
+	cgev_count = 0;
+	any_count = 0;
+	paused_count = 0;
+	isr_count = 0;
+}
+
+void tearDown(void)
+{
+	at_monitor_pause(&mon_paused);
+
+	mock_nrf_modem_at_Verify();
+}
+
+void test_at_monitor_dispatch_overlapping_filters(void)
+{
+	at_monitor_dispatch("+CEREG: 5,\"4400\",\"00C3A2\",7\r\n");
+	k_sleep(DISPATCH_WAIT);
+
+	TEST_ASSERT_EQUAL(1, cereg_count);
+	TEST_ASSERT_EQUAL(1, cereg_dup_count);
+	TEST_ASSERT_EQUAL(1, reg_count);
+	TEST_ASSERT_EQUAL(0, cgev_count);
+	TEST_ASSERT_EQUAL(1, any_count);
+	TEST_ASSERT_EQUAL(0, paused_count);
+	TEST_ASSERT_EQUAL(0, isr_count);
+}
+
+void test_at_monitor_dispatch_partial_filter(void)
+{
+	/* Shares the prefix of "+CEREG" and "+CGEV: ME" without matching either */
+	at_monitor_dispatch("+CGEV: IPV6 0\r\n");
+	k_sleep(DISPATCH_WAIT);
+
+	TEST_ASSERT_EQUAL(0, cereg_count);
+	TEST_ASSERT_EQUAL(0, reg_count);
+	TEST_ASSERT_EQUAL(0, cgev_count);
+	TEST_ASSERT_EQUAL(1, any_count);
+
+	at_monitor_dispatch("+CGEV: ME PDN ACT 0\r\n");
+	k_sleep(DISPATCH_WAIT);
+
+	TEST_ASSERT_EQUAL(1, cgev_count);
+	TEST_ASSERT_EQUAL(2, any_count);
+}
+
+void test_at_monitor_dispatch_isr(void)
+{
+	/* Keep the system workqueue from running, like in an ISR */
+	k_sched_lock();
+	at_monitor_dispatch("+CSCON: 1\r\n");
+
+	/* Dispatched directly */
+	TEST_ASSERT_EQUAL(1, isr_count);
+	TEST_ASSERT_EQUAL(0, any_count);
+
+	k_sched_unlock();
+	k_sleep(DISPATCH_WAIT);
+
+	TEST_ASSERT_EQUAL(1, isr_count);
+	TEST_ASSERT_EQUAL(1, any_count);
+	TEST_ASSERT_EQUAL(0, cereg_count);
+}
+
+void test_at_monitor_dispatch_multiple_filters_in_notif(void)
+{
+	at_monitor_dispatch("+CSCON: 0 +CEREG: 1\r\n");
+	k_sleep(DISPATCH_WAIT);
+
+	TEST_ASSERT_EQUAL(1, isr_count);
+	TEST_ASSERT_EQUAL(1, cereg_count);
+	TEST_ASSERT_EQUAL(1, cereg_dup_count);
+	TEST_ASSERT_EQUAL(1, reg_count);
+	TEST_ASSERT_EQUAL(1, any_count);
+}
+
+void test_at_monitor_pause_resume(void)
+{
+	at_monitor_resume(&mon_paused);
+
+	at_monitor_dispatch("+CEREG: 1\r\n");
+	k_sleep(DISPATCH_WAIT);
+
+	TEST_ASSERT_EQUAL(1, paused_count);
+	TEST_ASSERT_EQUAL(1, cereg_count);
+
+	at_monitor_pause(&mon_paused);
+
+	at_monitor_dispatch("+CEREG: 1\r\n");
+	k_sleep(DISPATCH_WAIT);
+
+	TEST_ASSERT_EQUAL(1, paused_count);
+	TEST_ASSERT_EQUAL(2, cereg_count);
+}
+
+void test_at_monitor_pause_before_workqueue(void)
+{
+	k_sched_lock();
+	at_monitor_dispatch("+CEREG: 1\r\n");
+	/* Paused after the notification is matched, but before it is dispatched */
+	at_monitor_pause(&mon_cereg);
+	k_sched_unlock();
+	k_sleep(DISPATCH_WAIT);
+	at_monitor_resume(&mon_cereg);
+
+	TEST_ASSERT_EQUAL(0, cereg_count);
+	TEST_ASSERT_EQUAL(1, cereg_dup_count);
+}
+
+/* This is needed because AT Monitor library is initialized in SYS_INIT. */
+static int at_monitor_test_sys_init(void)
+{
+	__cmock_nrf_modem_at_notif_handler_set_ExpectAnyArgsAndReturn(0);
+
+	return 0;
+}
+
+/* It is required to be added to each test. That is because unity's
+ * main may return nonzero, while zephyr's main currently must
+ * return 0 in all cases (other values are reserved).
+ */
+extern int unity_main(void);
+
+int main(void)
+{
+	(void)unity_main();
+
+	return 0;
+}
+
+SYS_INIT(at_monitor_test_sys_init, POST_KERNEL, 0);
@@ -0,0 +1,65 @@
+/*
+ * Copyright (c) 2024 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#include <zephyr/ztest.h>
+#include <zephyr/kernel.h>
+#include "data_fifo.h"
+
+#define BENCH_BLOCKS_NUM 8
+#define BENCH_BLOCK_SIZE 96
+#define BENCH_ITERATIONS 10000
+
+/* Push one block through the full producer/consumer cycle per iteration */
+static uint32_t cycles_per_block_get(struct data_fifo *data_fifo)
+{
+	int ret;
+	void *data_ptr;
+	size_t size;
+	uint32_t start;
+	uint32_t cycles;
+
+	start = k_cycle_get_32();
+
+	for (uint32_t i = 0; i < BENCH_ITERATIONS; i++) {
+		ret = data_fifo_pointer_first_vacant_get(data_fifo, &data_ptr, K_NO_WAIT);
+		zassert_equal(ret, 0, "first_vacant_get did not return 0");
+
+		ret = data_fifo_block_lock(data_fifo, &data_ptr, BENCH_BLOCK_SIZE);
+		zassert_equal(ret, 0, "block_lock did not return 0");
+
+		ret = data_fifo_pointer_last_filled_get(data_fifo, &data_ptr, &size, K_NO_WAIT);
+		zassert_equal(ret, 0, "last_filled_get did not return 0");
+
+		data_fifo_block_free(data_fifo, data_ptr);
+	}
+
+	cycles = k_cycle_get_32() - start;
+
+	return cycles / BENCH_ITERATIONS;
+}
+
+ZTEST(suite_data_fifo_benchmark, test_data_fifo_cycles_per_block)
+{
+	DATA_FIFO_DEFINE(data_fifo, BENCH_BLOCKS_NUM, BENCH_BLOCK_SIZE);
+
+	int ret;
+
+	ret = data_fifo_init(&data_fifo);
+	zassert_equal(ret, 0, "init did not return 0");
+
+	TC_PRINT("data_fifo msgq/slab: %u cycles per block\n", cycles_per_block_get(&data_fifo));
+
+#if defined(CONFIG_DATA_FIFO_SPSC)
+	DATA_FIFO_SPSC_DEFINE(data_fifo_spsc, BENCH_BLOCKS_NUM, BENCH_BLOCK_SIZE);
+
+	ret = data_fifo_init(&data_fifo_spsc);
+	zassert_equal(ret, 0, "init did not return 0");
+
+	TC_PRINT("data_fifo SPSC: %u cycles per block\n", cycles_per_block_get(&data_fifo_spsc));
+#endif /* CONFIG_DATA_FIFO_SPSC */
+}
+
+ZTEST_SUITE(suite_data_fifo_benchmark, NULL, NULL, NULL, NULL, NULL);
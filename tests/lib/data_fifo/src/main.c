@@ -189,4 +189,97 @@ ZTEST(suite_data_fifo, test_data_fifo_data_put_size_zero)
 	zassert_equal(ret, -EINVAL, "block_lock did not return -EINVAL");
 }
 
+#if defined(CONFIG_DATA_FIFO_SPSC)
+ZTEST(suite_data_fifo, test_data_fifo_spsc_put_get_ok)
+{
+	DATA_FIFO_SPSC_DEFINE(data_fifo, 3, 128);
+
+	int ret;
+	uint8_t *data_ptr;
+	size_t size;
+
+	ret = data_fifo_init(&data_fifo);
+	zassert_equal(ret, 0, "init did not return 0");
+
+	/* Run several laps so the ring indices wrap */
+	for (uint32_t lap = 0; lap < 5; lap++) {
+		for (uint32_t i = 0; i < 3; i++) {
+			ret = data_fifo_pointer_first_vacant_get(&data_fifo, (void **)&data_ptr,
+								 K_NO_WAIT);
+			zassert_equal(ret, 0, "first_vacant_get did not return 0");
+			data_ptr[0] = lap;
+			data_ptr[1] = i;
+
+			ret = data_fifo_block_lock(&data_fifo, (void **)&data_ptr, i + 2);
+			zassert_equal(ret, 0, "block_lock did not return 0");
+		}
+
+		internal_test_remaining_elements(&data_fifo, 3, 3, __LINE__);
+
+		ret = data_fifo_pointer_first_vacant_get(&data_fifo, (void **)&data_ptr,
+							 K_NO_WAIT);
+		zassert_equal(ret, -ENOMEM, "first_vacant_get did not ENOMEM");
+
+		for (uint32_t i = 0; i < 3; i++) {
+			ret = data_fifo_pointer_last_filled_get(&data_fifo, (void **)&data_ptr,
+								&size, K_NO_WAIT);
+			zassert_equal(ret, 0, "last_filled_get did not return 0");
+			zassert_equal(data_ptr[0], lap, "wrong block order");
+			zassert_equal(data_ptr[1], i, "wrong block order");
+			zassert_equal(size, i + 2, "wrong size");
+
+			data_fifo_block_free(&data_fifo, data_ptr);
+		}
+
+		internal_test_remaining_elements(&data_fifo, 0, 0, __LINE__);
+
+		ret = data_fifo_pointer_last_filled_get(&data_fifo, (void **)&data_ptr, &size,
+							K_NO_WAIT);
+		zassert_equal(ret, -ENOMSG, "last_filled_get did not return -ENOMSG");
+	}
+}
+
+ZTEST(suite_data_fifo, test_data_fifo_spsc_producer_free_unlocked)
+{
+	DATA_FIFO_SPSC_DEFINE(data_fifo, 4, 128);
+
+	int ret;
+	uint8_t *data_ptr;
+
+	ret = data_fifo_init(&data_fifo);
+	zassert_equal(ret, 0, "init did not return 0");
+
+	ret = data_fifo_pointer_first_vacant_get(&data_fifo, (void **)&data_ptr, K_NO_WAIT);
+	zassert_equal(ret, 0, "first_vacant_get did not return 0");
+	internal_test_remaining_elements(&data_fifo, 1, 0, __LINE__);
+
+	data_fifo_block_free(&data_fifo, data_ptr);
+	internal_test_remaining_elements(&data_fifo, 0, 0, __LINE__);
+}
+
+ZTEST(suite_data_fifo, test_data_fifo_spsc_lock_out_of_order)
+{
+	DATA_FIFO_SPSC_DEFINE(data_fifo, 4, 128);
+
+	int ret;
+	uint8_t *data_ptr_1;
+	uint8_t *data_ptr_2;
+
+	ret = data_fifo_init(&data_fifo);
+	zassert_equal(ret, 0, "init did not return 0");
+
+	ret = data_fifo_pointer_first_vacant_get(&data_fifo, (void **)&data_ptr_1, K_NO_WAIT);
+	zassert_equal(ret, 0, "first_vacant_get did not return 0");
+	ret = data_fifo_pointer_first_vacant_get(&data_fifo, (void **)&data_ptr_2, K_NO_WAIT);
+	zassert_equal(ret, 0, "first_vacant_get did not return 0");
+
+	ret = data_fifo_block_lock(&data_fifo, (void **)&data_ptr_2, 1);
+	zassert_equal(ret, -ESPIPE, "block_lock did not return -ESPIPE");
+
+	ret = data_fifo_empty(&data_fifo);
+	zassert_equal(ret, 0, "empty did not return 0");
+	internal_test_remaining_elements(&data_fifo, 0, 0, __LINE__);
+}
+#endif /* CONFIG_DATA_FIFO_SPSC */
+
 ZTEST_SUITE(suite_data_fifo, NULL, NULL, NULL, NULL, NULL);
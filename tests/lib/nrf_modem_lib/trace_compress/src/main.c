@@ -0,0 +1,236 @@
+/*
+ * Copyright (c) 2024 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#include <string.h>
+#include <unity.h>
+#include <zephyr/kernel.h>
+#include <zephyr/sys/byteorder.h>
+#include <zephyr/sys/crc.h>
+
+#include "trace_compress.h"
+
+#define BLOCK_SIZE CONFIG_NRF_MODEM_LIB_TRACE_COMPRESSION_BLOCK_SIZE
+
+static uint8_t in[BLOCK_SIZE];
+static uint8_t out[TRACE_COMPRESS_OUT_SIZE];
+static uint8_t decoded[BLOCK_SIZE];
+
+/* It is required to be added to each test. That is because unity's
+ * main may return nonzero, while zephyr's main currently must
+ * return 0 in all cases (other values are reserved).
+ */
+extern int unity_main(void);
+
+static size_t length_read(const uint8_t **ip, size_t len)
+{
+	uint8_t byte;
+
+	if (len != 15) {
+		return len;
+	}
+
+	do {
+		byte = *(*ip)++;
+		len += byte;
+	} while (byte == 255);
+
+	return len;
+}
+
+/* Reference decoder of the LZ4 block format, returns the decoded length or -1 on error. */
+static int lz4_decode(const uint8_t *src, size_t len, uint8_t *dst, size_t dst_max)
+{
+	const uint8_t *ip = src;
+	const uint8_t *const ip_end = src + len;
+	uint8_t *op = dst;
+
+	while (ip < ip_end) {
+		uint8_t token = *ip++;
+		size_t literals = length_read(&ip, token >> 4);
+		size_t match_len;
+		uint16_t offset;
+
+		if (op + literals > dst + dst_max || ip + literals > ip_end) {
+			return -1;
+		}
+
+		memcpy(op, ip, literals);
+		op += literals;
+		ip += literals;
+
+		if (ip == ip_end) {
+			break;
+		}
+
+		offset = sys_get_le16(ip);
+		ip += 2;
+		match_len = length_read(&ip, token & 0xf) + 4;
+
+		if (offset == 0 || offset > op - dst || op + match_len > dst + dst_max) {
+			return -1;
+		}
+
+		/* Byte by byte, as the match may overlap the output */
+		for (size_t i = 0; i < match_len; i++, op++) {
+			*op = *(op - offset);
+		}
+	}
+
+	return op - dst;
+}
+
+/* Check the header of the block in the output buffer, decode it and compare it to the input */
+static void block_verify(size_t in_len, size_t out_len)
+{
+	uint16_t raw_len = sys_get_le16(&out[3]);
+	uint16_t len = sys_get_le16(&out[5]);
+	uint16_t crc = crc16_ccitt(0xffff, out, 7);
+
+	TEST_ASSERT_EQUAL(TRACE_COMPRESS_MAGIC_0, out[0]);
+	TEST_ASSERT_EQUAL(TRACE_COMPRESS_MAGIC_1, out[1]);
+	TEST_ASSERT_EQUAL(in_len, raw_len);
+	TEST_ASSERT_EQUAL(out_len, TRACE_COMPRESS_HDR_SIZE + len);
+
+	crc = crc16_ccitt(crc, &out[TRACE_COMPRESS_HDR_SIZE], len);
+	TEST_ASSERT_EQUAL(crc, sys_get_le16(&out[7]));
+
+	if (out[2] == TRACE_COMPRESS_TYPE_RAW) {
+		TEST_ASSERT_EQUAL(in_len, len);
+		TEST_ASSERT_EQUAL_MEMORY(in, &out[TRACE_COMPRESS_HDR_SIZE], in_len);
+		return;
+	}
+
+	TEST_ASSERT_EQUAL(TRACE_COMPRESS_TYPE_LZ4, out[2]);
+	TEST_ASSERT_LESS_THAN(in_len, len);
+	TEST_ASSERT_EQUAL(in_len, lz4_decode(&out[TRACE_COMPRESS_HDR_SIZE], len, decoded,
+					     sizeof(decoded)));
+	TEST_ASSERT_EQUAL_MEMORY(in, decoded, in_len);
+}
+
+/* Fill the input with records that look like modem traces: a header, a counter and noise. */
+static void trace_like_fill(void)
+{
+	uint32_t seed = 1;
+
+	for (size_t i = 0; i < sizeof(in); i++) {
+		seed = seed * 1103515245 + 12345;
+
+		switch (i % 16) {
+		case 0:
+			in[i] = 0xaa;
+			break;
+		case 1:
+			in[i] = 0x55;
+			break;
+		case 2:
+			in[i] = i / 16;
+			break;
+		default:
+			in[i] = (seed >> 16) & 0x3;
+			break;
+		}
+	}
+}
+
+void setUp(void)
+{
+	memset(out, 0, sizeof(out));
+	memset(decoded, 0, sizeof(decoded));
+}
+
+void test_trace_compress_empty(void)
+{
+	size_t out_len = trace_compress_block(in, 0, out);
+
+	TEST_ASSERT_EQUAL(TRACE_COMPRESS_HDR_SIZE, out_len);
+	TEST_ASSERT_EQUAL(TRACE_COMPRESS_TYPE_RAW, out[2]);
+	block_verify(0, out_len);
+}
+
+void test_trace_compress_repeated(void)
+{
+	size_t out_len;
+
+	memset(in, 0x42, sizeof(in));
+
+	out_len = trace_compress_block(in, sizeof(in), out);
+
+	TEST_ASSERT_EQUAL(TRACE_COMPRESS_TYPE_LZ4, out[2]);
+	TEST_ASSERT_LESS_THAN(TRACE_COMPRESS_HDR_SIZE + 32, out_len);
+	block_verify(sizeof(in), out_len);
+}
+
+void test_trace_compress_trace_like(void)
+{
+	size_t out_len;
+
+	trace_like_fill();
+
+	out_len = trace_compress_block(in, sizeof(in), out);
+
+	TEST_ASSERT_EQUAL(TRACE_COMPRESS_TYPE_LZ4, out[2]);
+	block_verify(sizeof(in), out_len);
+}
+
+void test_trace_compress_incompressible(void)
+{
+	size_t out_len;
+	uint32_t seed = 42;
+
+	for (size_t i = 0; i < sizeof(in); i++) {
+		seed = seed * 1103515245 + 12345;
+		in[i] = seed >> 24;
+	}
+
+	out_len = trace_compress_block(in, sizeof(in), out);
+
+	TEST_ASSERT_EQUAL(TRACE_COMPRESS_TYPE_RAW, out[2]);
+	TEST_ASSERT_EQUAL(TRACE_COMPRESS_HDR_SIZE + sizeof(in), out_len);
+	block_verify(sizeof(in), out_len);
+}
+
+void test_trace_compress_all_lengths(void)
+{
+	size_t out_len;
+
+	trace_like_fill();
+
+	/* Short blocks only have literals, and the end of the block has specific rules */
+	for (size_t len = 1; len < 64; len++) {
+		out_len = trace_compress_block(in, len, out);
+		block_verify(len, out_len);
+	}
+
+	for (size_t len = sizeof(in) - 16; len <= sizeof(in); len++) {
+		out_len = trace_compress_block(in, len, out);
+		block_verify(len, out_len);
+	}
+}
+
+void test_trace_compress_independent_blocks(void)
+{
+	size_t out_len;
+	size_t out_len_again;
+	static uint8_t first[TRACE_COMPRESS_OUT_SIZE];
+
+	trace_like_fill();
+
+	out_len = trace_compress_block(in, sizeof(in), out);
+	memcpy(first, out, out_len);
+
+	/* A block does not reference the data of the previous ones */
+	out_len_again = trace_compress_block(in, sizeof(in), out);
+
+	TEST_ASSERT_EQUAL(out_len, out_len_again);
+	TEST_ASSERT_EQUAL_MEMORY(first, out, out_len);
+}
+
+int main(void)
+{
+	(void)unity_main();
+
+	return 0;
+}
@@ -0,0 +1,75 @@
+/*
+ * Copyright (c) 2024 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#include <zephyr/ztest.h>
+#include <zephyr/kernel.h>
+#include "pcm_mix.h"
+
+/* 10 ms of 48 kHz stereo audio in the largest carrier */
+#define BENCH_SAMPLES_MONO 480
+#define BENCH_ITERATIONS   100
+
+static int32_t bench_buf_a[BENCH_SAMPLES_MONO * 2];
+static int32_t bench_buf_b[BENCH_SAMPLES_MONO * 2];
+
+static const struct {
+	enum pcm_mix_mode mode;
+	const char *name;
+	bool b_stereo;
+} bench_modes[] = {
+	{ B_STEREO_INTO_A_STEREO, "B_STEREO_INTO_A_STEREO", true },
+	{ B_MONO_INTO_A_MONO, "B_MONO_INTO_A_MONO", false },
+	{ B_MONO_INTO_A_STEREO_LR, "B_MONO_INTO_A_STEREO_LR", false },
+	{ B_MONO_INTO_A_STEREO_L, "B_MONO_INTO_A_STEREO_L", false },
+	{ B_MONO_INTO_A_STEREO_R, "B_MONO_INTO_A_STEREO_R", false },
+};
+
+static void bench_run(enum pcm_mix_mode mode, const char *name, bool b_stereo,
+		      uint8_t pcm_bit_depth, uint16_t gain)
+{
+	int ret;
+	uint32_t start;
+	uint32_t cycles;
+	uint64_t samples;
+	uint32_t milli_samples_per_us;
+	size_t bytes_per_sample = (pcm_bit_depth == 16) ? sizeof(int16_t) : sizeof(int32_t);
+	size_t size_b = BENCH_SAMPLES_MONO * bytes_per_sample * (b_stereo ? 2 : 1);
+	size_t size_a = BENCH_SAMPLES_MONO * bytes_per_sample * 2;
+
+	start = k_cycle_get_32();
+
+	for (uint32_t i = 0; i < BENCH_ITERATIONS; i++) {
+		ret = pcm_mix_ext(bench_buf_a, size_a, bench_buf_b, size_b, pcm_bit_depth, gain,
+				  mode);
+		zassert_equal(ret, 0, "pcm_mix_ext failed %d", ret);
+	}
+
+	cycles = MAX(k_cycle_get_32() - start, 1);
+
+	/* Count the samples written to buffer A */
+	samples = (uint64_t)BENCH_ITERATIONS * (size_b / bytes_per_sample) *
+		  ((mode == B_MONO_INTO_A_STEREO_LR) ? 2 : 1);
+	milli_samples_per_us = (samples * sys_clock_hw_cycles_per_sec()) / cycles / 1000;
+
+	TC_PRINT("%-24s %2u-bit gain %3u: %u.%03u samples/us\n", name, pcm_bit_depth, gain,
+		 milli_samples_per_us / 1000, milli_samples_per_us % 1000);
+}
+
+ZTEST(suite_pcm_mix_benchmark, test_samples_per_us)
+{
+	static const uint8_t bit_depths[] = { 16, 24, 32 };
+
+	for (int i = 0; i < ARRAY_SIZE(bench_modes); i++) {
+		for (int j = 0; j < ARRAY_SIZE(bit_depths); j++) {
+			bench_run(bench_modes[i].mode, bench_modes[i].name, bench_modes[i].b_stereo,
+				  bit_depths[j], PCM_MIX_GAIN_UNITY);
+			bench_run(bench_modes[i].mode, bench_modes[i].name, bench_modes[i].b_stereo,
+				  bit_depths[j], PCM_MIX_GAIN_UNITY / 2);
+		}
+	}
+}
+
+ZTEST_SUITE(suite_pcm_mix_benchmark, NULL, NULL, NULL, NULL, NULL);
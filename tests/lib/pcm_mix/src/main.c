@@ -127,4 +127,87 @@ ZTEST(suite_pcm_mix, test_mono_into_stereo_r)
 	verify_array_eq(sample_a, sample_r, ARRAY_SIZE(sample_r));
 }
 
+ZTEST(suite_pcm_mix, test_odd_number_of_samples)
+{
+	int ret;
+	int16_t sample_a[] = { 1, 2, 3, INT16_MAX, INT16_MIN };
+	int16_t sample_b[] = { 1, 1, 1, 1, -1 };
+	int16_t sample_r[] = { 2, 3, 4, INT16_MAX, INT16_MIN };
+
+	ret = pcm_mix(sample_a, sizeof(sample_a), sample_b, sizeof(sample_b), B_MONO_INTO_A_MONO);
+	ZEQ(ret, 0);
+
+	verify_array_eq(sample_a, sample_r, ARRAY_SIZE(sample_r));
+}
+
+ZTEST(suite_pcm_mix, test_ext_gain_16)
+{
+	int ret;
+	int16_t sample_a[] = { 100, 100, INT16_MAX, INT16_MIN };
+	int16_t sample_b[] = { 100, -100, 1000, -1000 };
+	int16_t sample_r[] = { 150, 50, INT16_MAX, INT16_MIN };
+
+	ret = pcm_mix_ext(sample_a, sizeof(sample_a), sample_b, sizeof(sample_b), 16,
+			  PCM_MIX_GAIN_UNITY / 2, B_STEREO_INTO_A_STEREO);
+	ZEQ(ret, 0);
+
+	verify_array_eq(sample_a, sample_r, ARRAY_SIZE(sample_r));
+}
+
+ZTEST(suite_pcm_mix, test_ext_gain_boost_16)
+{
+	int ret;
+	int16_t sample_a[] = { 0, 0, 0, 0 };
+	int16_t sample_b[] = { 30000, -30000 };
+	int16_t sample_r[] = { INT16_MAX, INT16_MAX, INT16_MIN, INT16_MIN };
+
+	ret = pcm_mix_ext(sample_a, sizeof(sample_a), sample_b, sizeof(sample_b), 16,
+			  PCM_MIX_GAIN_UNITY * 2, B_MONO_INTO_A_STEREO_LR);
+	ZEQ(ret, 0);
+
+	verify_array_eq(sample_a, sample_r, ARRAY_SIZE(sample_r));
+}
+
+ZTEST(suite_pcm_mix, test_ext_24_in_32)
+{
+	int ret;
+	int32_t sample_a[] = { 10, 10, 0x7FFFF0, 10, -0x7FFFF0, 10 };
+	int32_t sample_b[] = { -5, 0x100, -0x100 };
+	int32_t sample_r[] = { 5, 10, 0x7FFFFF, 10, -0x800000, 10 };
+
+	ret = pcm_mix_ext(sample_a, sizeof(sample_a), sample_b, sizeof(sample_b), 24,
+			  PCM_MIX_GAIN_UNITY, B_MONO_INTO_A_STEREO_L);
+	ZEQ(ret, 0);
+
+	for (int i = 0; i < ARRAY_SIZE(sample_r); i++) {
+		ZEQ(sample_a[i], sample_r[i]);
+	}
+}
+
+ZTEST(suite_pcm_mix, test_ext_32)
+{
+	int ret;
+	int32_t sample_a[] = { 10, 10, INT32_MAX, 10, INT32_MIN, 10 };
+	int32_t sample_b[] = { -10, 20, -20 };
+	int32_t sample_r[] = { 10, 5, INT32_MAX, 20, INT32_MIN, 0 };
+
+	ret = pcm_mix_ext(sample_a, sizeof(sample_a), sample_b, sizeof(sample_b), 32,
+			  PCM_MIX_GAIN_UNITY / 2, B_MONO_INTO_A_STEREO_R);
+	ZEQ(ret, 0);
+
+	for (int i = 0; i < ARRAY_SIZE(sample_r); i++) {
+		ZEQ(sample_a[i], sample_r[i]);
+	}
+}
+
+ZTEST(suite_pcm_mix, test_ext_illegal_bit_depth)
+{
+	int ret;
+	int16_t sample_a[] = { 0, 1, 2 };
+
+	ret = pcm_mix_ext(sample_a, sizeof(sample_a), sample_a, sizeof(sample_a), 8,
+			  PCM_MIX_GAIN_UNITY, B_MONO_INTO_A_MONO);
+	ZEQ(ret, -EINVAL);
+}
+
 ZTEST_SUITE(suite_pcm_mix, NULL, NULL, NULL, NULL, NULL);
@@ -1117,4 +1117,125 @@ ZTEST(suite_sample_rate_converter, test_invalid_process_output_buf_too_small)
 		      "Sample rate conversion process did not fail when output buffer is to small");
 }
 
+#if defined(CONFIG_SAMPLE_RATE_CONVERTER_POLYPHASE) && defined(CONFIG_SAMPLE_RATE_CONVERTER_BIT_DEPTH_16)
+#define POLYPHASE_NUM_BLOCKS 10
+ZTEST(suite_sample_rate_converter, test_polyphase_44100_to_48000_16bit)
+{
+	int ret;
+
+	uint32_t input_sample_rate = 44100;
+	uint32_t output_sample_rate = 48000;
+
+	/* 10 ms blocks */
+	int16_t input_samples[441];
+	int16_t output_samples[480];
+	size_t total_output_samples = 0;
+	size_t output_written;
+
+	for (int i = 0; i < ARRAY_SIZE(input_samples); i++) {
+		input_samples[i] = 10000;
+	}
+
+	for (int block = 0; block < POLYPHASE_NUM_BLOCKS; block++) {
+		ret = sample_rate_converter_process(
+			&conv_ctx, SAMPLE_RATE_FILTER_POLYPHASE, input_samples,
+			sizeof(input_samples), input_sample_rate, output_samples,
+			sizeof(output_samples), &output_written, output_sample_rate);
+		zassert_equal(ret, 0, "Sample rate conversion process failed");
+
+		total_output_samples += output_written / sizeof(int16_t);
+	}
+
+	zassert_equal(conv_ctx.conversion_ratio, 0, "Conversion ratio not as expected");
+	zassert_equal(conv_ctx.polyphase.interpolation, 160, "Interpolation not as expected");
+	zassert_equal(conv_ctx.polyphase.decimation, 147, "Decimation not as expected");
+	zassert_equal(total_output_samples, POLYPHASE_NUM_BLOCKS * ARRAY_SIZE(output_samples),
+		      "Number of output samples not as expected (%d)", total_output_samples);
+
+	/* Once the filter history is filled, a constant input gives the same constant output */
+	for (int i = 0; i < output_written / sizeof(int16_t); i++) {
+		zassert_within(output_samples[i], 10000, 30, "Sample %d was %d", i,
+			       output_samples[i]);
+	}
+}
+
+ZTEST(suite_sample_rate_converter, test_polyphase_48000_to_44100_varying_block_16bit)
+{
+	int ret;
+
+	uint32_t input_sample_rate = 48000;
+	uint32_t output_sample_rate = 44100;
+
+	int16_t input_samples[CONFIG_SAMPLE_RATE_CONVERTER_BLOCK_SIZE_MAX] = {0};
+	int16_t output_samples[CONFIG_SAMPLE_RATE_CONVERTER_BLOCK_SIZE_MAX];
+	size_t total_input_samples = 0;
+	size_t total_output_samples = 0;
+	size_t output_written;
+
+	/* Block sizes that do not line up with the 147/160 ratio */
+	for (int block = 1; total_input_samples < 4800; block++) {
+		size_t samples_in = (block * 37) % ARRAY_SIZE(input_samples);
+
+		ret = sample_rate_converter_process(
+			&conv_ctx, SAMPLE_RATE_FILTER_POLYPHASE, input_samples,
+			samples_in * sizeof(int16_t), input_sample_rate, output_samples,
+			sizeof(output_samples), &output_written, output_sample_rate);
+		zassert_equal(ret, 0, "Sample rate conversion process failed");
+
+		total_input_samples += samples_in;
+		total_output_samples += output_written / sizeof(int16_t);
+	}
+
+	/* The stream position is kept across calls, so no samples are lost or duplicated */
+	zassert_equal(total_output_samples, DIV_ROUND_UP(total_input_samples * 147, 160),
+		      "Number of output samples not as expected (%d)", total_output_samples);
+}
+
+ZTEST(suite_sample_rate_converter, test_polyphase_16000_to_24000_16bit)
+{
+	int ret;
+
+	int16_t input_samples[160] = {0};
+	int16_t output_samples[240];
+	size_t output_written;
+
+	ret = sample_rate_converter_process(&conv_ctx, SAMPLE_RATE_FILTER_POLYPHASE, input_samples,
+					    sizeof(input_samples), 16000, output_samples,
+					    sizeof(output_samples), &output_written, 24000);
+	zassert_equal(ret, 0, "Sample rate conversion process failed");
+	zassert_equal(output_written, sizeof(output_samples), "Output size was not as expected");
+	zassert_equal(conv_ctx.polyphase.interpolation, 3, "Interpolation not as expected");
+	zassert_equal(conv_ctx.polyphase.decimation, 2, "Decimation not as expected");
+}
+
+ZTEST(suite_sample_rate_converter, test_polyphase_invalid_ratio)
+{
+	int ret;
+
+	int16_t input_samples[10] = {0};
+	int16_t output_samples[20];
+	size_t output_written;
+
+	/* Reduced ratio 44101/48000 needs more sub-filters than available */
+	ret = sample_rate_converter_process(&conv_ctx, SAMPLE_RATE_FILTER_POLYPHASE, input_samples,
+					    sizeof(input_samples), 48000, output_samples,
+					    sizeof(output_samples), &output_written, 44101);
+	zassert_equal(ret, -EINVAL, "Process did not fail with unsupported ratio");
+}
+
+ZTEST(suite_sample_rate_converter, test_polyphase_output_buf_too_small)
+{
+	int ret;
+
+	int16_t input_samples[441] = {0};
+	int16_t output_samples[479];
+	size_t output_written;
+
+	ret = sample_rate_converter_process(&conv_ctx, SAMPLE_RATE_FILTER_POLYPHASE, input_samples,
+					    sizeof(input_samples), 44100, output_samples,
+					    sizeof(output_samples), &output_written, 48000);
+	zassert_equal(ret, -EINVAL, "Process did not fail with too small output buffer");
+}
+#endif /* CONFIG_SAMPLE_RATE_CONVERTER_POLYPHASE && CONFIG_SAMPLE_RATE_CONVERTER_BIT_DEPTH_16 */
+
 ZTEST_SUITE(suite_sample_rate_converter, NULL, NULL, test_setup, NULL, NULL);
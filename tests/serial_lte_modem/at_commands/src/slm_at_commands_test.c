@@ -0,0 +1,396 @@
+/*
+ * Copyright (c) 2024 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+#include <unity.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <string.h>
+#include <zephyr/kernel.h>
+
+#include "slm_at_host.h"
+#include "stubs.h"
+
+#define RSP_OK		"\r\nOK\r\n"
+#define RSP_ERROR	"\r\nERROR\r\n"
+#define LINE_MAX	128
+#define CMD_LIST_MAX	64
+#define CMD_NAME_MAX	24
+
+/* It is required to be added to each test. That is because unity's
+ * main may return nonzero, while zephyr's main currently must
+ * return 0 in all cases (other values are reserved).
+ */
+extern int unity_main(void);
+
+/* Responses sent to the host */
+static char rsp[2048];
+static size_t rsp_len;
+
+/* String compares counted while enabled */
+static bool cmp_count_enabled;
+static unsigned int cmp_count;
+
+int __real_strncmp(const char *s1, const char *s2, size_t n);
+
+int __wrap_strncmp(const char *s1, const char *s2, size_t n)
+{
+	if (cmp_count_enabled) {
+		cmp_count++;
+	}
+
+	return __real_strncmp(s1, s2, n);
+}
+
+/* AT backend */
+static int backend_start(void)
+{
+	return 0;
+}
+
+static int backend_stop(void)
+{
+	return 0;
+}
+
+static int backend_send(const uint8_t *data, size_t len)
+{
+	TEST_ASSERT_TRUE_MESSAGE(rsp_len + len < sizeof(rsp), "Response buffer overflow");
+
+	memcpy(&rsp[rsp_len], data, len);
+	rsp_len += len;
+	rsp[rsp_len] = '\0';
+
+	return 0;
+}
+
+static void capture_reset(void)
+{
+	stubs_reset();
+
+	rsp_len = 0;
+	rsp[0] = '\0';
+}
+
+/* Sends a command line from the host, terminated as configured */
+static void line_send(const char *cmd)
+{
+	char line[LINE_MAX];
+	int len;
+
+	capture_reset();
+
+	len = snprintf(line, sizeof(line), "%s\r\n", cmd);
+	TEST_ASSERT_LESS_THAN(sizeof(line), len);
+
+	slm_at_receive((const uint8_t *)line, len);
+}
+
+static void handler_check(const char *cmd, const char *handler, enum at_cmd_type type)
+{
+	line_send(cmd);
+
+	TEST_ASSERT_EQUAL_MESSAGE(1, handler_call.count, cmd);
+	TEST_ASSERT_EQUAL_STRING_MESSAGE(handler, handler_call.handler, cmd);
+	TEST_ASSERT_EQUAL_MESSAGE(type, handler_call.type, cmd);
+	TEST_ASSERT_EQUAL_MESSAGE(0, modem_cmd_count, cmd);
+	TEST_ASSERT_EQUAL_STRING_MESSAGE(RSP_OK, rsp, cmd);
+}
+
+static void modem_check(const char *cmd, const char *forwarded)
+{
+	line_send(cmd);
+
+	TEST_ASSERT_EQUAL_MESSAGE(0, handler_call.count, cmd);
+	TEST_ASSERT_EQUAL_MESSAGE(1, modem_cmd_count, cmd);
+	TEST_ASSERT_EQUAL_STRING_MESSAGE(forwarded, modem_cmd, cmd);
+}
+
+static void error_check(const char *cmd)
+{
+	line_send(cmd);
+
+	TEST_ASSERT_EQUAL_MESSAGE(0, handler_call.count, cmd);
+	TEST_ASSERT_EQUAL_MESSAGE(0, modem_cmd_count, cmd);
+	TEST_ASSERT_EQUAL_STRING_MESSAGE(RSP_ERROR, rsp, cmd);
+}
+
+void setUp(void)
+{
+	static bool initialized;
+
+	if (!initialized) {
+		const struct slm_at_backend backend = {
+			.start = backend_start,
+			.send = backend_send,
+			.stop = backend_stop,
+		};
+
+		TEST_ASSERT_EQUAL(0, slm_at_set_backend(backend));
+		TEST_ASSERT_EQUAL(0, slm_at_host_init());
+		initialized = true;
+	}
+
+	capture_reset();
+}
+
+void tearDown(void)
+{
+}
+
+/* The test verifies that SLM commands run their handler with the command type. */
+void test_slm_cmd_dispatched(void)
+{
+	handler_check("AT#XSOCKET=1,1,0", "handle_at_socket", AT_CMD_TYPE_SET_COMMAND);
+	handler_check("AT#XSOCKET?", "handle_at_socket", AT_CMD_TYPE_READ_COMMAND);
+	handler_check("AT#XSOCKET=?", "handle_at_socket", AT_CMD_TYPE_TEST_COMMAND);
+	handler_check("AT#XPING=\"example.com\",45,5000", "handle_at_icmp_ping",
+		      AT_CMD_TYPE_SET_COMMAND);
+	handler_check("AT#XFOTA?", "handle_at_fota", AT_CMD_TYPE_READ_COMMAND);
+}
+
+/* The test verifies that SLM command names are matched in any case. */
+void test_slm_cmd_mixed_case(void)
+{
+	handler_check("at#xsocket=1,1,0", "handle_at_socket", AT_CMD_TYPE_SET_COMMAND);
+	handler_check("At#XsOcKeToPt?", "handle_at_socketopt", AT_CMD_TYPE_READ_COMMAND);
+	handler_check("aT#xTcPsVr=?", "handle_at_tcp_server", AT_CMD_TYPE_TEST_COMMAND);
+}
+
+/* The test verifies that SLM command names which are prefixes of each other are told apart. */
+void test_slm_cmd_prefix_names(void)
+{
+	static const struct {
+		const char *cmd;
+		const char *handler;
+	} cmds[] = {
+		{"AT#XSOCKET=1,1,0", "handle_at_socket"},
+		{"AT#XSOCKETOPT=1,20,30", "handle_at_socketopt"},
+		{"AT#XSOCKETSELECT=0", "handle_at_socket_select"},
+		{"AT#XSSOCKET=1,1,0,16842753", "handle_at_secure_socket"},
+		{"AT#XSSOCKETOPT=1,2,0", "handle_at_secure_socketopt"},
+		{"AT#XSEND=\"test\"", "handle_at_send"},
+		{"AT#XSENDTO=\"example.com\",7,\"test\"", "handle_at_sendto"},
+		{"AT#XRECV=10", "handle_at_recv"},
+		{"AT#XRECVFROM=10", "handle_at_recvfrom"},
+		{"AT#XTCPSEND=\"test\"", "handle_at_tcp_send"},
+	};
+
+	for (size_t i = 0; i < ARRAY_SIZE(cmds); i++) {
+		handler_check(cmds[i].cmd, cmds[i].handler, AT_CMD_TYPE_SET_COMMAND);
+	}
+}
+
+/* The test verifies that names which only share a prefix with SLM commands go to the modem. */
+void test_slm_cmd_prefix_forwarded(void)
+{
+	modem_check("AT#XSOCK=1", "AT#XSOCK=1");
+	modem_check("at#xsocketopts?", "AT#XSOCKETOPTS?");
+	modem_check("AT#XTCP=1", "AT#XTCP=1");
+	modem_check("AT#XSENDT", "AT#XSENDT");
+	modem_check("AT#XPINGS", "AT#XPINGS");
+}
+
+/* The test verifies the command forwarded to the modem and the response sent to the host. */
+void test_modem_cmd_forwarded(void)
+{
+	modem_rsp = "+CFUN: 1\r\nOK\r\n";
+	modem_check("AT+CFUN?", "AT+CFUN?");
+	TEST_ASSERT_EQUAL_STRING("\r\n+CFUN: 1\r\n\r\nOK\r\n", rsp);
+
+	/* Only the command name is converted to upper case */
+	modem_check("at%xsystemmode=1,0,1,0", "AT%XSYSTEMMODE=1,0,1,0");
+	TEST_ASSERT_EQUAL_STRING(RSP_OK, rsp);
+	modem_check("at+cgdcont=0,\"ip\",\"Internet\"", "AT+CGDCONT=0,\"ip\",\"Internet\"");
+
+	/* Characters before the command are dropped */
+	modem_check("xyAT+CGSN", "AT+CGSN");
+}
+
+/* The test verifies the responses to modem errors. */
+void test_modem_cmd_error(void)
+{
+	modem_ret = -EFAULT;
+	modem_check("AT+CFUN=1", "AT+CFUN=1");
+	TEST_ASSERT_EQUAL_STRING(RSP_ERROR, rsp);
+
+	modem_ret = 1;
+	modem_rsp = "+CME ERROR: 10\r\n";
+	modem_check("AT+CPIN?", "AT+CPIN?");
+	TEST_ASSERT_EQUAL_STRING("\r\n+CME ERROR: 10\r\n", rsp);
+}
+
+/* The test verifies that a failing SLM command handler gives an error response. */
+void test_slm_cmd_error(void)
+{
+	handler_ret = -EINVAL;
+	line_send("AT#XBIND=1234");
+
+	TEST_ASSERT_EQUAL(1, handler_call.count);
+	TEST_ASSERT_EQUAL_STRING("handle_at_bind", handler_call.handler);
+	TEST_ASSERT_EQUAL(0, modem_cmd_count);
+	TEST_ASSERT_EQUAL_STRING(RSP_ERROR, rsp);
+}
+
+/* The test verifies that bare commands, valid in the grammar, go to the modem. */
+void test_bare_cmd_forwarded(void)
+{
+	modem_check("AT", "AT");
+	modem_check("at", "AT");
+	modem_check("AT#X", "AT#X");
+	modem_check("AT#X?", "AT#X?");
+	modem_check("at+x=?", "AT+X=?");
+}
+
+/* The test verifies that commands with invalid grammar are neither run nor forwarded. */
+void test_invalid_cmd(void)
+{
+	error_check("A");
+	error_check("AT+");
+	error_check("AT#");
+	error_check("AT%=1");
+	error_check("AT#?");
+	error_check("ATI");
+	error_check("AT*X");
+	error_check("AT#X-SOCKET");
+	error_check("AT#XSOCKET?1");
+	error_check("AT#XSOCKET=?1");
+	error_check("AT+CFUN ?");
+	error_check("XYZ");
+}
+
+/* The test verifies that an empty line is ignored. */
+void test_empty_line(void)
+{
+	line_send("");
+
+	TEST_ASSERT_EQUAL(0, handler_call.count);
+	TEST_ASSERT_EQUAL(0, modem_cmd_count);
+	TEST_ASSERT_EQUAL(0, rsp_len);
+}
+
+/* Command names of the list, in the order of AT#XCLAC */
+static char cmd_list[CMD_LIST_MAX][CMD_NAME_MAX];
+static size_t cmd_list_len;
+
+static void cmd_list_get(void)
+{
+	const char *name = rsp;
+	const char *end;
+
+	line_send("AT#XCLAC");
+
+	cmd_list_len = 0;
+	while ((end = strstr(name, "\r\n")) != NULL) {
+		if (end - name > 2 && name[0] == 'A' && name[1] == 'T') {
+			TEST_ASSERT_LESS_THAN(CMD_LIST_MAX, cmd_list_len);
+			TEST_ASSERT_LESS_THAN(CMD_NAME_MAX, end - name);
+			memcpy(cmd_list[cmd_list_len], name, end - name);
+			cmd_list[cmd_list_len][end - name] = '\0';
+			cmd_list_len++;
+		}
+		name = end + 2;
+	}
+
+	TEST_ASSERT_GREATER_THAN(0, cmd_list_len);
+}
+
+/* The linear scan that slm_at_parse() did before the commands were indexed */
+static bool cmd_find_linear(const char *cmd_name, size_t cmd_name_len)
+{
+	for (size_t i = 0; i < cmd_list_len; i++) {
+		if (!strncmp(cmd_name, cmd_list[i], cmd_name_len) &&
+		    cmd_list[i][cmd_name_len] == '\0') {
+			return true;
+		}
+	}
+
+	return false;
+}
+
+/* The test replays a captured session and counts the string compares of the command lookup
+ * with the linear scan and with the binary search. Simulated time does not advance while the
+ * code runs, so compares are counted instead of timed.
+ */
+void test_cmd_lookup_compares(void)
+{
+	static const char *const session[] = {
+		"AT+CFUN=1",
+		"AT+CEREG=5",
+		"AT%XSYSTEMMODE?",
+		"AT+CGSN=1",
+		"AT+CGDCONT?",
+		"AT#XSOCKET=1,1,0",
+		"AT#XSOCKETOPT=1,20,30",
+		"AT#XCONNECT=\"example.com\",80",
+		"AT#XSEND=\"GET / HTTP/1.1\"",
+		"AT#XRECV=10",
+		"AT#XSOCKET=0",
+		"AT+CEREG?",
+		"AT%XMONITOR",
+		"AT+CFUN=4",
+	};
+	unsigned int linear = 0;
+	unsigned int indexed = 0;
+	unsigned int parsing = 0;
+	unsigned int max_steps = 0;
+	int ret;
+
+	cmd_list_get();
+
+	while ((1U << max_steps) <= cmd_list_len) {
+		max_steps++;
+	}
+
+	for (size_t i = 0; i < ARRAY_SIZE(session); i++) {
+		const char *const cmd = session[i];
+		const size_t name_len = strcspn(cmd, "=?");
+		bool found;
+
+		capture_reset();
+
+		cmp_count = 0;
+		cmp_count_enabled = true;
+		found = cmd_find_linear(cmd, name_len);
+		cmp_count_enabled = false;
+		linear += cmp_count;
+
+		cmp_count = 0;
+		cmp_count_enabled = true;
+		ret = slm_at_parse(cmd, name_len);
+		cmp_count_enabled = false;
+		indexed += cmp_count;
+
+		TEST_ASSERT_EQUAL_MESSAGE(found, handler_call.count, cmd);
+		if (!found) {
+			TEST_ASSERT_EQUAL_MESSAGE(UNKNOWN_AT_COMMAND_RET, ret, cmd);
+			continue;
+		}
+
+		/* Take out the parsing that both lookups are followed by */
+		cmp_count = 0;
+		cmp_count_enabled = true;
+		(void)at_parser_cmd_type_get(cmd);
+		at_params_list_clear(&slm_at_param_list);
+		(void)at_parser_params_from_str(cmd, NULL, &slm_at_param_list);
+		cmp_count_enabled = false;
+		parsing += cmp_count;
+	}
+
+	TEST_ASSERT_GREATER_OR_EQUAL(parsing, indexed);
+	indexed -= parsing;
+
+	printk("%u commands, %zu lines: %u compares with linear scan, %u with binary search\n",
+	       (unsigned int)cmd_list_len, ARRAY_SIZE(session), linear, indexed);
+
+	TEST_ASSERT_LESS_OR_EQUAL(max_steps * ARRAY_SIZE(session), indexed);
+	TEST_ASSERT_LESS_THAN(linear, indexed);
+}
+
+int main(void)
+{
+	(void)unity_main();
+
+	return 0;
+}
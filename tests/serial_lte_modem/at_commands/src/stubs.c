@@ -0,0 +1,227 @@
+/*
+ * Copyright (c) 2024 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#include <unity.h>
+#include <stdarg.h>
+#include <stdio.h>
+#include <string.h>
+#include <zephyr/kernel.h>
+#include <zephyr/sys/reboot.h>
+#include <modem/modem_jwt.h>
+#include <modem/nrf_modem_lib.h>
+#include <nrf_modem.h>
+#include <nrf_modem_at.h>
+
+#include "slm_at_host.h"
+#include "slm_at_fota.h"
+#include "slm_at_icmp.h"
+#include "slm_at_socket.h"
+#include "slm_at_tcp_proxy.h"
+#include "slm_at_udp_proxy.h"
+#include "slm_uart_handler.h"
+#include "slm_util.h"
+#include "stubs.h"
+
+struct handler_call handler_call;
+int handler_ret;
+
+char modem_cmd[256];
+unsigned int modem_cmd_count;
+const char *modem_rsp;
+int modem_ret;
+
+const struct device *const slm_uart_dev = NULL;
+uint32_t slm_uart_baudrate = 115200;
+uint8_t slm_fota_type;
+
+void stubs_reset(void)
+{
+	memset(&handler_call, 0, sizeof(handler_call));
+	handler_ret = 0;
+
+	memset(modem_cmd, 0, sizeof(modem_cmd));
+	modem_cmd_count = 0;
+	modem_rsp = "OK\r\n";
+	modem_ret = 0;
+}
+
+/* SLM command handlers, which record that they were run */
+#define HANDLER_STUB(_handler)                                                                     \
+	int _handler(enum at_cmd_type cmd_type)                                                    \
+	{                                                                                          \
+		handler_call.handler = #_handler;                                                  \
+		handler_call.type = cmd_type;                                                      \
+		handler_call.count++;                                                              \
+		return handler_ret;                                                                \
+	}
+
+HANDLER_STUB(handle_at_tcp_server)
+HANDLER_STUB(handle_at_tcp_client)
+HANDLER_STUB(handle_at_tcp_send)
+HANDLER_STUB(handle_at_tcp_hangup)
+HANDLER_STUB(handle_at_udp_server)
+HANDLER_STUB(handle_at_udp_client)
+HANDLER_STUB(handle_at_udp_send)
+HANDLER_STUB(handle_at_socket)
+HANDLER_STUB(handle_at_secure_socket)
+HANDLER_STUB(handle_at_socket_select)
+HANDLER_STUB(handle_at_socketopt)
+HANDLER_STUB(handle_at_secure_socketopt)
+HANDLER_STUB(handle_at_bind)
+HANDLER_STUB(handle_at_connect)
+HANDLER_STUB(handle_at_listen)
+HANDLER_STUB(handle_at_accept)
+HANDLER_STUB(handle_at_send)
+HANDLER_STUB(handle_at_recv)
+HANDLER_STUB(handle_at_sendto)
+HANDLER_STUB(handle_at_recvfrom)
+HANDLER_STUB(handle_at_poll)
+HANDLER_STUB(handle_at_getaddrinfo)
+HANDLER_STUB(handle_at_icmp_ping)
+HANDLER_STUB(handle_at_fota)
+
+/* Modem library */
+int nrf_modem_at_cmd(void *buf, size_t len, const char *fmt, ...)
+{
+	va_list args;
+
+	va_start(args, fmt);
+	vsnprintf(modem_cmd, sizeof(modem_cmd), fmt, args);
+	va_end(args);
+
+	modem_cmd_count++;
+	snprintf(buf, len, "%s", modem_rsp);
+
+	return modem_ret;
+}
+
+int nrf_modem_at_err_type(int error)
+{
+	return (error & 0xff0000) >> 16;
+}
+
+char *nrf_modem_build_version(void)
+{
+	return "stub";
+}
+
+int nrf_modem_lib_init(void)
+{
+	return 0;
+}
+
+int nrf_modem_lib_shutdown(void)
+{
+	return 0;
+}
+
+int modem_jwt_get_uuids(struct nrf_device_uuid *dev, struct nrf_modem_fw_uuid *mfw)
+{
+	ARG_UNUSED(dev);
+	ARG_UNUSED(mfw);
+
+	return -ENOTSUP;
+}
+
+/* Other SLM modules */
+int slm_at_tcp_proxy_init(void)
+{
+	return 0;
+}
+
+int slm_at_tcp_proxy_uninit(void)
+{
+	return 0;
+}
+
+int slm_at_udp_proxy_init(void)
+{
+	return 0;
+}
+
+int slm_at_udp_proxy_uninit(void)
+{
+	return 0;
+}
+
+int slm_at_socket_init(void)
+{
+	return 0;
+}
+
+int slm_at_socket_uninit(void)
+{
+	return 0;
+}
+
+int slm_at_icmp_init(void)
+{
+	return 0;
+}
+
+int slm_at_icmp_uninit(void)
+{
+	return 0;
+}
+
+int slm_at_fota_init(void)
+{
+	return 0;
+}
+
+int slm_at_fota_uninit(void)
+{
+	return 0;
+}
+
+void slm_fota_post_process(void)
+{
+}
+
+int slm_uart_handler_enable(void)
+{
+	return 0;
+}
+
+int slm_indicate(void)
+{
+	return 0;
+}
+
+int slm_util_at_printf(const char *fmt, ...)
+{
+	ARG_UNUSED(fmt);
+
+	return 0;
+}
+
+int slm_util_at_scanf(const char *cmd, const char *fmt, ...)
+{
+	ARG_UNUSED(cmd);
+	ARG_UNUSED(fmt);
+
+	return 0;
+}
+
+void enter_idle(void)
+{
+}
+
+void enter_sleep(void)
+{
+}
+
+void enter_shutdown(void)
+{
+}
+
+__weak FUNC_NORETURN void sys_reboot(int type)
+{
+	ARG_UNUSED(type);
+
+	TEST_FAIL_MESSAGE("Unexpected reboot");
+	CODE_UNREACHABLE;
+}
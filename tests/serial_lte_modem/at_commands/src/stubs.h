@@ -0,0 +1,34 @@
+/*
+ * Copyright (c) 2024 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#ifndef STUBS_H_
+#define STUBS_H_
+
+#include <modem/at_cmd_parser.h>
+
+/* Last SLM command handler that was run */
+struct handler_call {
+	const char *handler;
+	enum at_cmd_type type;
+	unsigned int count;
+};
+
+extern struct handler_call handler_call;
+
+/* Value returned by the SLM command handlers */
+extern int handler_ret;
+
+/* Last command forwarded to the modem */
+extern char modem_cmd[256];
+extern unsigned int modem_cmd_count;
+
+/* Response and return value of the modem */
+extern const char *modem_rsp;
+extern int modem_ret;
+
+void stubs_reset(void);
+
+#endif /* STUBS_H_ */
@@ -0,0 +1,13 @@
+/*
+ * Copyright (c) 2024 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#include "lane_event.h"
+
+APP_EVENT_TYPE_DEFINE_LANE(lane_event,
+		  NULL,
+		  NULL,
+		  APP_EVENT_FLAGS_CREATE(),
+		  CONFIG_APP_EVENT_MANAGER_LANES - 1);
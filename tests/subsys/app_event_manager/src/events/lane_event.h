@@ -0,0 +1,37 @@
+/*
+ * Copyright (c) 2024 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#ifndef _LANE_EVENT_H_
+#define _LANE_EVENT_H_
+
+/**
+ * @brief Lane Event
+ * @defgroup lane_event Event processed in the last lane
+ * @{
+ */
+
+#include <app_event_manager.h>
+#include <app_event_manager_profiler_tracer.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+struct lane_event {
+	struct app_event_header header;
+};
+
+APP_EVENT_TYPE_DECLARE(lane_event);
+
+#ifdef __cplusplus
+}
+#endif
+
+/**
+ * @}
+ */
+
+#endif /* _LANE_EVENT_H_ */
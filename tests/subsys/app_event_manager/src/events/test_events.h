@@ -29,6 +29,7 @@ enum test_id {
 	TEST_OOM,
 	TEST_MULTICONTEXT,
 	TEST_NAME_STYLE_SORTING,
+	TEST_LANES,
 
 	TEST_CNT
 };
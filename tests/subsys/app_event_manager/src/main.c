@@ -4,6 +4,7 @@
  * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
  */
 
+#include <string.h>
 #include <zephyr/ztest.h>
 #include <app_event_manager.h>
 
@@ -179,6 +180,61 @@ ZTEST(suite0, test_event_size_disabled)
 	app_event_manager_free(ev_s1);
 }
 
+ZTEST(suite0, test_lanes)
+{
+	test_start(TEST_LANES);
+
+#if IS_ENABLED(CONFIG_APP_EVENT_MANAGER_LISTENER_STATS)
+	bool found = false;
+
+	STRUCT_SECTION_FOREACH(event_listener, el) {
+		struct event_listener_stats stats;
+
+		if (strcmp(el->name, "test_lanes_late") == 0) {
+			_app_event_manager_listener_stats_get(el, &stats);
+			zassert_equal(0, stats.notified, "Consumed event propagated");
+		} else if (strcmp(el->name, "test_lanes") == 0) {
+			_app_event_manager_listener_stats_get(el, &stats);
+			zassert_true(stats.consumed > 0, "Consumed event not counted");
+			zassert_true(stats.notified > stats.consumed, "Notifications not counted");
+			found = true;
+		}
+	}
+
+	zassert_true(found, "Listener not found");
+#endif
+}
+
+ZTEST(suite0, test_event_slabs)
+{
+#if IS_ENABLED(CONFIG_APP_EVENT_MANAGER_EVENT_SLABS)
+	struct test_size_big_event *ev[CONFIG_APP_EVENT_MANAGER_EVENT_SLAB_BLOCKS + 1];
+	struct k_mem_slab *slab;
+
+	for (size_t i = 0; i < ARRAY_SIZE(ev); i++) {
+		ev[i] = new_test_size_big_event();
+		zassert_not_null(ev[i], "Event allocation failed");
+	}
+
+	/* No other event type fits in the slab, the last event is allocated from the heap. */
+	slab = ev[0]->header.type_id->slab;
+	zassert_equal(CONFIG_APP_EVENT_MANAGER_EVENT_SLAB_BLOCKS, k_mem_slab_num_used_get(slab),
+		"Event slab not used");
+	zassert_false(app_event_manager_slab_free(ev[ARRAY_SIZE(ev) - 1]),
+		"Event unexpectedly allocated from slab");
+
+	for (size_t i = 0; i < ARRAY_SIZE(ev); i++) {
+		app_event_manager_free(ev[i]);
+	}
+
+	zassert_equal(0, k_mem_slab_num_used_get(slab), "Event slab not freed");
+	zassert_equal(CONFIG_APP_EVENT_MANAGER_EVENT_SLAB_BLOCKS, k_mem_slab_max_used_get(slab),
+		"Unexpected event slab high-water mark");
+#else
+	ztest_test_skip();
+#endif
+}
+
 ZTEST(suite0, test_name_style_events_sorting)
 {
 	test_start(TEST_NAME_STYLE_SORTING);
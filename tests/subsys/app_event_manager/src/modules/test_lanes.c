@@ -0,0 +1,63 @@
+/*
+ * Copyright (c) 2024 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/ztest.h>
+
+#include "test_events.h"
+#include "lane_event.h"
+
+#define MODULE test_lanes
+#define MODULE_LATE test_lanes_late
+
+
+static bool app_event_handler(const struct app_event_header *aeh)
+{
+	if (is_test_start_event(aeh)) {
+		struct test_start_event *st = cast_test_start_event(aeh);
+
+		if (st->test_id == TEST_LANES) {
+			struct lane_event *event = new_lane_event();
+
+			APP_EVENT_SUBMIT(event);
+		}
+
+		return false;
+	}
+
+	if (is_lane_event(aeh)) {
+		if (CONFIG_APP_EVENT_MANAGER_LANES > 1) {
+			zassert_not_equal(k_current_get(), &k_sys_work_q.thread,
+					  "Lane event processed by system workqueue");
+		}
+
+		struct test_end_event *et = new_test_end_event();
+
+		et->test_id = TEST_LANES;
+		APP_EVENT_SUBMIT(et);
+
+		/* Consume the event. */
+		return true;
+	}
+
+	zassert_true(false, "Event unhandled");
+
+	return false;
+}
+
+static bool app_event_handler_late(const struct app_event_header *aeh)
+{
+	zassert_true(false, "Consumed event propagated");
+
+	return false;
+}
+
+APP_EVENT_LISTENER(MODULE, app_event_handler);
+APP_EVENT_SUBSCRIBE(MODULE, test_start_event);
+APP_EVENT_SUBSCRIBE_EARLY(MODULE, lane_event);
+
+APP_EVENT_LISTENER(MODULE_LATE, app_event_handler_late);
+APP_EVENT_SUBSCRIBE(MODULE_LATE, lane_event);
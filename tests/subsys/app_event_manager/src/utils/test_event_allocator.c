@@ -7,6 +7,8 @@
 #include <zephyr/ztest.h>
 #include <zephyr/kernel.h>
 
+#include <app_event_manager.h>
+
 #include "test_event_allocator.h"
 
 static bool oom_expected;
@@ -19,7 +21,16 @@ void test_event_allocator_oom_expect(bool expected)
 
 void *app_event_manager_alloc(size_t size)
 {
-	void *event = k_malloc(size);
+	void *event;
+
+#if IS_ENABLED(CONFIG_APP_EVENT_MANAGER_EVENT_SLABS)
+	event = app_event_manager_slab_alloc(size);
+	if (event) {
+		return event;
+	}
+#endif
+
+	event = k_malloc(size);
 
 	if (unlikely(!event)) {
 		zassert_true(oom_expected, "Unexpected OOM error");
@@ -30,5 +41,11 @@ void *app_event_manager_alloc(size_t size)
 
 void app_event_manager_free(void *addr)
 {
+#if IS_ENABLED(CONFIG_APP_EVENT_MANAGER_EVENT_SLABS)
+	if (app_event_manager_slab_free(addr)) {
+		return;
+	}
+#endif
+
 	k_free(addr);
 }
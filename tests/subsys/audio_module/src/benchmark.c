@@ -0,0 +1,287 @@
+/*
+ * Copyright (c) 2024 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#include <zephyr/ztest.h>
+#include <zephyr/kernel.h>
+
+#include "audio_module/audio_module.h"
+#include "data_fifo.h"
+
+/* Input, three in/out modules and an output */
+#define BENCH_MODULES_NUM   (5)
+#define BENCH_FRAMES_NUM    (200)
+/* 10 ms of 48 kHz 16-bit mono audio */
+#define BENCH_DATA_SIZE	    (960)
+#define BENCH_BLOCKS_NUM    (8)
+#define BENCH_FIFO_ELEMENTS (4)
+#define BENCH_STACK_SIZE    (2048)
+#define BENCH_PRIORITY	    (4)
+#define BENCH_TIMEOUT	    (K_MSEC(500))
+
+K_THREAD_STACK_ARRAY_DEFINE(bench_stacks, BENCH_MODULES_NUM, BENCH_STACK_SIZE);
+K_MEM_SLAB_DEFINE_STATIC(bench_slab, WB_UP(BENCH_DATA_SIZE), BENCH_BLOCKS_NUM * BENCH_MODULES_NUM,
+			 4);
+DATA_FIFO_DEFINE(bench_fifo_1, BENCH_FIFO_ELEMENTS, WB_UP(sizeof(struct audio_module_message)));
+DATA_FIFO_DEFINE(bench_fifo_2, BENCH_FIFO_ELEMENTS, WB_UP(sizeof(struct audio_module_message)));
+DATA_FIFO_DEFINE(bench_fifo_3, BENCH_FIFO_ELEMENTS, WB_UP(sizeof(struct audio_module_message)));
+DATA_FIFO_DEFINE(bench_fifo_4, BENCH_FIFO_ELEMENTS, WB_UP(sizeof(struct audio_module_message)));
+
+static struct data_fifo *const bench_fifos[BENCH_MODULES_NUM] = {
+	NULL, &bench_fifo_1, &bench_fifo_2, &bench_fifo_3, &bench_fifo_4};
+
+#if defined(CONFIG_AUDIO_MODULE_GRAPH)
+K_THREAD_STACK_DEFINE(bench_graph_stack, BENCH_STACK_SIZE);
+K_MEM_SLAB_DEFINE_STATIC(bench_graph_slab, AUDIO_MODULE_GRAPH_BLOCK_SIZE(BENCH_DATA_SIZE),
+			 BENCH_BLOCKS_NUM, 8);
+static struct audio_module_graph bench_graph;
+#endif /* CONFIG_AUDIO_MODULE_GRAPH */
+
+static K_SEM_DEFINE(frame_in_sem, 0, 1);
+static K_SEM_DEFINE(frame_out_sem, 0, 1);
+
+static struct audio_module_handle handles[BENCH_MODULES_NUM];
+static uint32_t bench_context[BENCH_MODULES_NUM];
+static uint32_t bench_config;
+
+/* Cycle count when the input module got the current frame */
+static uint32_t frame_start;
+static uint32_t latency_total;
+static uint32_t latency_max;
+
+static int bench_config_set(struct audio_module_handle_private *handle,
+			    struct audio_module_configuration const *const configuration)
+{
+	ARG_UNUSED(handle);
+	ARG_UNUSED(configuration);
+
+	return 0;
+}
+
+static int bench_config_get(struct audio_module_handle_private const *const handle,
+			    struct audio_module_configuration *configuration)
+{
+	ARG_UNUSED(handle);
+	ARG_UNUSED(configuration);
+
+	return 0;
+}
+
+static int bench_input_process(struct audio_module_handle_private *handle,
+			       struct audio_data const *const audio_data_rx,
+			       struct audio_data *audio_data_tx)
+{
+	ARG_UNUSED(handle);
+	ARG_UNUSED(audio_data_rx);
+
+	if (k_sem_take(&frame_in_sem, K_MSEC(10))) {
+		return -ENODATA;
+	}
+
+	frame_start = k_cycle_get_32();
+
+	memset(audio_data_tx->data, 0, audio_data_tx->data_size);
+
+	return 0;
+}
+
+static int bench_in_out_process(struct audio_module_handle_private *handle,
+				struct audio_data const *const audio_data_rx,
+				struct audio_data *audio_data_tx)
+{
+	int16_t const *pcm_rx = audio_data_rx->data;
+	int16_t *pcm_tx = audio_data_tx->data;
+
+	ARG_UNUSED(handle);
+
+	for (size_t i = 0; i < audio_data_rx->data_size / sizeof(int16_t); i++) {
+		pcm_tx[i] = pcm_rx[i] + 1;
+	}
+
+	audio_data_tx->data_size = audio_data_rx->data_size;
+
+	return 0;
+}
+
+static int bench_output_process(struct audio_module_handle_private *handle,
+				struct audio_data const *const audio_data_rx,
+				struct audio_data *audio_data_tx)
+{
+	uint32_t latency = k_cycle_get_32() - frame_start;
+
+	ARG_UNUSED(handle);
+	ARG_UNUSED(audio_data_rx);
+	ARG_UNUSED(audio_data_tx);
+
+	latency_total += latency;
+	latency_max = MAX(latency_max, latency);
+
+	k_sem_give(&frame_out_sem);
+
+	return 0;
+}
+
+static const struct audio_module_functions bench_input_ft = {
+	.configuration_set = bench_config_set,
+	.configuration_get = bench_config_get,
+	.data_process = bench_input_process};
+
+static const struct audio_module_functions bench_in_out_ft = {
+	.configuration_set = bench_config_set,
+	.configuration_get = bench_config_get,
+	.data_process = bench_in_out_process};
+
+static const struct audio_module_functions bench_output_ft = {
+	.configuration_set = bench_config_set,
+	.configuration_get = bench_config_get,
+	.data_process = bench_output_process};
+
+static struct audio_module_description bench_input_description = {
+	.name = "Bench input", .type = AUDIO_MODULE_TYPE_INPUT, .functions = &bench_input_ft};
+
+static struct audio_module_description bench_in_out_description = {
+	.name = "Bench in/out", .type = AUDIO_MODULE_TYPE_IN_OUT, .functions = &bench_in_out_ft};
+
+static struct audio_module_description bench_output_description = {
+	.name = "Bench output", .type = AUDIO_MODULE_TYPE_OUTPUT, .functions = &bench_output_ft};
+
+/**
+ * @brief Open and connect the chain of modules, either threaded or in a graph.
+ *
+ * @param graph  [in/out]  Pointer to the graph, NULL to give each module its own thread.
+ */
+static void bench_chain_open(struct audio_module_graph *graph)
+{
+	int ret;
+	struct audio_module_parameters parameters;
+
+	memset(handles, 0, sizeof(handles));
+
+	for (int i = 0; i < BENCH_MODULES_NUM; i++) {
+		memset(&parameters, 0, sizeof(parameters));
+
+		if (i == 0) {
+			parameters.description = &bench_input_description;
+		} else if (i == BENCH_MODULES_NUM - 1) {
+			parameters.description = &bench_output_description;
+		} else {
+			parameters.description = &bench_in_out_description;
+		}
+
+		parameters.thread.stack = bench_stacks[i];
+		parameters.thread.stack_size = K_THREAD_STACK_SIZEOF(bench_stacks[i]);
+		parameters.thread.priority = BENCH_PRIORITY;
+		parameters.thread.data_slab = &bench_slab;
+		parameters.thread.data_size = BENCH_DATA_SIZE;
+		parameters.thread.msg_rx = bench_fifos[i];
+
+		if (bench_fifos[i] != NULL && !bench_fifos[i]->initialized) {
+			ret = data_fifo_init(bench_fifos[i]);
+			zassert_equal(ret, 0, "Data FIFO init did not return successfully: ret %d",
+				      ret);
+		}
+
+#if defined(CONFIG_AUDIO_MODULE_GRAPH)
+		parameters.graph = graph;
+#endif
+
+		ret = audio_module_open(&parameters,
+					(struct audio_module_configuration *)&bench_config,
+					parameters.description->name,
+					(struct audio_module_context *)&bench_context[i],
+					&handles[i]);
+		zassert_equal(ret, 0, "Open did not return successfully: ret %d", ret);
+	}
+
+	for (int i = 0; i < BENCH_MODULES_NUM - 1; i++) {
+		ret = audio_module_connect(&handles[i], &handles[i + 1], false);
+		zassert_equal(ret, 0, "Connect did not return successfully: ret %d", ret);
+	}
+
+	for (int i = 0; i < BENCH_MODULES_NUM; i++) {
+		ret = audio_module_start(&handles[i]);
+		zassert_equal(ret, 0, "Start did not return successfully: ret %d", ret);
+	}
+}
+
+static void bench_chain_close(void)
+{
+	int ret;
+
+	for (int i = 0; i < BENCH_MODULES_NUM; i++) {
+		ret = audio_module_stop(&handles[i]);
+		zassert_equal(ret, 0, "Stop did not return successfully: ret %d", ret);
+
+		ret = audio_module_close(&handles[i]);
+		zassert_equal(ret, 0, "Close did not return successfully: ret %d", ret);
+	}
+}
+
+/**
+ * @brief Push frames through the chain one at a time and report the latency from the input
+ *        module to the output module.
+ *
+ * @note The test thread is idle while a frame is in the chain, so the latency is also the
+ *       CPU time spent on the frame by the modules and the framework.
+ *
+ * @param mode  [in]  Name of the execution mode to print.
+ */
+static void bench_frames_run(char const *mode)
+{
+	int ret;
+
+	latency_total = 0;
+	latency_max = 0;
+
+	for (int i = 0; i < BENCH_FRAMES_NUM; i++) {
+		k_sem_give(&frame_in_sem);
+
+		ret = k_sem_take(&frame_out_sem, BENCH_TIMEOUT);
+		zassert_equal(ret, 0, "Frame %d did not reach the output module", i);
+	}
+
+	TC_PRINT("%s: %d modules, latency per frame avg %u cycles (%u us), max %u cycles (%u us)\n",
+		 mode, BENCH_MODULES_NUM, latency_total / BENCH_FRAMES_NUM,
+		 k_cyc_to_us_floor32(latency_total / BENCH_FRAMES_NUM), latency_max,
+		 k_cyc_to_us_floor32(latency_max));
+}
+
+ZTEST(suite_audio_module_benchmark, test_threaded_latency)
+{
+	bench_chain_open(NULL);
+
+	bench_frames_run("Threaded");
+
+	bench_chain_close();
+}
+
+#if defined(CONFIG_AUDIO_MODULE_GRAPH)
+ZTEST(suite_audio_module_benchmark, test_graph_latency)
+{
+	int ret;
+	struct audio_module_graph_parameters parameters = {
+		.stack = bench_graph_stack,
+		.stack_size = K_THREAD_STACK_SIZEOF(bench_graph_stack),
+		.priority = BENCH_PRIORITY,
+		.data_slab = &bench_graph_slab};
+
+	ret = audio_module_graph_init(&bench_graph, &parameters);
+	zassert_equal(ret, 0, "Graph init did not return successfully: ret %d", ret);
+
+	bench_chain_open(&bench_graph);
+
+	ret = audio_module_graph_start(&bench_graph);
+	zassert_equal(ret, 0, "Graph start did not return successfully: ret %d", ret);
+
+	bench_frames_run("Graph");
+
+	ret = audio_module_graph_stop(&bench_graph);
+	zassert_equal(ret, 0, "Graph stop did not return successfully: ret %d", ret);
+
+	bench_chain_close();
+}
+#endif /* CONFIG_AUDIO_MODULE_GRAPH */
+
+ZTEST_SUITE(suite_audio_module_benchmark, NULL, NULL, NULL, NULL, NULL);
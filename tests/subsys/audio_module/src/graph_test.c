@@ -0,0 +1,431 @@
+/*
+ * Copyright (c) 2024 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#include <zephyr/ztest.h>
+#include <errno.h>
+
+#include "audio_module/audio_module.h"
+#include "audio_module_test_common.h"
+#include "fakes.h"
+
+#define TEST_GRAPH_FRAMES_NUM  (4)
+#define TEST_GRAPH_BLOCKS_NUM  (8)
+#define TEST_GRAPH_MODULES_NUM (4)
+#define TEST_GRAPH_TIMEOUT     (K_MSEC(100))
+
+struct graph_test_context {
+	/* Input audio data pointer in the last frame. */
+	void const *data_rx;
+
+	/* Output audio data pointer in the last frame. */
+	void const *data_tx;
+
+	/* First byte of the input audio data in the last frame. */
+	uint8_t value;
+
+	/* Number of frames processed. */
+	uint32_t frames;
+};
+
+K_THREAD_STACK_DEFINE(graph_stack, TEST_MOD_THREAD_STACK_SIZE);
+K_MEM_SLAB_DEFINE_STATIC(graph_slab, AUDIO_MODULE_GRAPH_BLOCK_SIZE(TEST_MOD_DATA_SIZE),
+			 TEST_GRAPH_BLOCKS_NUM, 8);
+static K_SEM_DEFINE(frame_in_sem, 0, TEST_GRAPH_FRAMES_NUM);
+static K_SEM_DEFINE(frame_out_sem, 0, TEST_GRAPH_FRAMES_NUM * TEST_GRAPH_MODULES_NUM);
+
+static struct audio_module_graph graph;
+static struct audio_module_handle handles[TEST_GRAPH_MODULES_NUM];
+static struct graph_test_context contexts[TEST_GRAPH_MODULES_NUM];
+static struct mod_config graph_config;
+
+static int graph_config_set(struct audio_module_handle_private *handle,
+			    struct audio_module_configuration const *const configuration)
+{
+	ARG_UNUSED(handle);
+	ARG_UNUSED(configuration);
+
+	return 0;
+}
+
+static int graph_config_get(struct audio_module_handle_private const *const handle,
+			    struct audio_module_configuration *configuration)
+{
+	ARG_UNUSED(handle);
+	ARG_UNUSED(configuration);
+
+	return 0;
+}
+
+/* Produce a frame filled with the frame number each time frame_in_sem is given. */
+static int graph_input_process(struct audio_module_handle_private *handle,
+			       struct audio_data const *const audio_data_rx,
+			       struct audio_data *audio_data_tx)
+{
+	struct audio_module_handle *hdl = (struct audio_module_handle *)handle;
+	struct graph_test_context *ctx = (struct graph_test_context *)hdl->context;
+
+	ARG_UNUSED(audio_data_rx);
+
+	if (k_sem_take(&frame_in_sem, K_MSEC(10))) {
+		return -ENODATA;
+	}
+
+	memset(audio_data_tx->data, ctx->frames, audio_data_tx->data_size);
+	ctx->data_tx = audio_data_tx->data;
+	ctx->frames++;
+
+	return 0;
+}
+
+/* Add one to every byte of the frame. */
+static int graph_in_out_process(struct audio_module_handle_private *handle,
+				struct audio_data const *const audio_data_rx,
+				struct audio_data *audio_data_tx)
+{
+	struct audio_module_handle *hdl = (struct audio_module_handle *)handle;
+	struct graph_test_context *ctx = (struct graph_test_context *)hdl->context;
+	uint8_t const *data_rx = audio_data_rx->data;
+	uint8_t *data_tx = audio_data_tx->data;
+
+	for (size_t i = 0; i < audio_data_rx->data_size; i++) {
+		data_tx[i] = data_rx[i] + 1;
+	}
+
+	audio_data_tx->data_size = audio_data_rx->data_size;
+
+	ctx->data_rx = audio_data_rx->data;
+	ctx->data_tx = audio_data_tx->data;
+	ctx->value = data_rx[0];
+	ctx->frames++;
+
+	return 0;
+}
+
+static int graph_output_process(struct audio_module_handle_private *handle,
+				struct audio_data const *const audio_data_rx,
+				struct audio_data *audio_data_tx)
+{
+	struct audio_module_handle *hdl = (struct audio_module_handle *)handle;
+	struct graph_test_context *ctx = (struct graph_test_context *)hdl->context;
+
+	ARG_UNUSED(audio_data_tx);
+
+	ctx->data_rx = audio_data_rx->data;
+	ctx->value = ((uint8_t const *)audio_data_rx->data)[0];
+	ctx->frames++;
+
+	k_sem_give(&frame_out_sem);
+
+	return 0;
+}
+
+static const struct audio_module_functions graph_input_ft = {
+	.configuration_set = graph_config_set,
+	.configuration_get = graph_config_get,
+	.data_process = graph_input_process};
+
+static const struct audio_module_functions graph_in_out_ft = {
+	.configuration_set = graph_config_set,
+	.configuration_get = graph_config_get,
+	.data_process = graph_in_out_process};
+
+static const struct audio_module_functions graph_output_ft = {
+	.configuration_set = graph_config_set,
+	.configuration_get = graph_config_get,
+	.data_process = graph_output_process};
+
+static struct audio_module_description graph_input_description = {
+	.name = "Graph input", .type = AUDIO_MODULE_TYPE_INPUT, .functions = &graph_input_ft};
+
+static struct audio_module_description graph_in_out_description = {
+	.name = "Graph in/out", .type = AUDIO_MODULE_TYPE_IN_OUT, .functions = &graph_in_out_ft};
+
+static struct audio_module_description graph_output_description = {
+	.name = "Graph output", .type = AUDIO_MODULE_TYPE_OUTPUT, .functions = &graph_output_ft};
+
+/**
+ * @brief Open a test module in a graph.
+ *
+ * @param test_graph   [in/out]  Pointer to the graph to open the module in.
+ * @param description  [in]      Pointer to the module's description.
+ * @param idx          [in]      Index of the module's handle and context.
+ */
+static void graph_module_open(struct audio_module_graph *test_graph,
+			      struct audio_module_description *description, int idx)
+{
+	int ret;
+	struct audio_module_parameters parameters = {0};
+
+	parameters.description = description;
+	parameters.thread.data_size = TEST_MOD_DATA_SIZE;
+	parameters.graph = test_graph;
+
+	ret = audio_module_open(&parameters, (struct audio_module_configuration *)&graph_config,
+				description->name,
+				(struct audio_module_context *)&contexts[idx], &handles[idx]);
+	zassert_equal(ret, 0, "Open function did not return successfully: ret %d", ret);
+	zassert_equal(handles[idx].graph, test_graph, "Module not added to the graph");
+	zassert_is_null(handles[idx].thread_id, "Module in a graph has its own thread");
+}
+
+/**
+ * @brief Stop the graph and check that every block has been returned to the slab.
+ */
+static void graph_stop_check(void)
+{
+	int ret;
+
+	ret = audio_module_graph_stop(&graph);
+	zassert_equal(ret, 0, "Graph stop did not return successfully: ret %d", ret);
+	zassert_equal(k_mem_slab_num_free_get(&graph_slab), TEST_GRAPH_BLOCKS_NUM,
+		      "Graph leaked %d blocks",
+		      TEST_GRAPH_BLOCKS_NUM - k_mem_slab_num_free_get(&graph_slab));
+}
+
+static void graph_before(void *fixture)
+{
+	int ret;
+	struct audio_module_graph_parameters parameters = {
+		.stack = graph_stack,
+		.stack_size = K_THREAD_STACK_SIZEOF(graph_stack),
+		.priority = TEST_MOD_THREAD_PRIORITY,
+		.data_slab = &graph_slab};
+
+	ARG_UNUSED(fixture);
+
+	memset(handles, 0, sizeof(handles));
+	memset(contexts, 0, sizeof(contexts));
+	k_sem_reset(&frame_in_sem);
+	k_sem_reset(&frame_out_sem);
+
+	ret = audio_module_graph_init(&graph, &parameters);
+	zassert_equal(ret, 0, "Graph init did not return successfully: ret %d", ret);
+}
+
+ZTEST_SUITE(suite_audio_module_graph, NULL, NULL, graph_before, NULL, NULL);
+
+ZTEST(suite_audio_module_graph, test_graph_chain_fnct)
+{
+	int ret;
+
+	/* Open in reverse order so the graph has to sort the modules. */
+	graph_module_open(&graph, &graph_output_description, 3);
+	graph_module_open(&graph, &graph_in_out_description, 2);
+	graph_module_open(&graph, &graph_in_out_description, 1);
+	graph_module_open(&graph, &graph_input_description, 0);
+
+	for (int i = 0; i < TEST_GRAPH_MODULES_NUM - 1; i++) {
+		ret = audio_module_connect(&handles[i], &handles[i + 1], false);
+		zassert_equal(ret, 0, "Connect did not return successfully: ret %d", ret);
+	}
+
+	for (int i = 0; i < TEST_GRAPH_MODULES_NUM; i++) {
+		ret = audio_module_start(&handles[i]);
+		zassert_equal(ret, 0, "Start did not return successfully: ret %d", ret);
+	}
+
+	ret = audio_module_graph_start(&graph);
+	zassert_equal(ret, 0, "Graph start did not return successfully: ret %d", ret);
+
+	for (int frame = 0; frame < TEST_GRAPH_FRAMES_NUM; frame++) {
+		k_sem_give(&frame_in_sem);
+
+		ret = k_sem_take(&frame_out_sem, TEST_GRAPH_TIMEOUT);
+		zassert_equal(ret, 0, "Frame %d did not reach the output module", frame);
+
+		zassert_equal(contexts[3].value, frame + 2, "Frame %d value %d, expected %d",
+			      frame, contexts[3].value, frame + 2);
+
+		/* The audio data is passed by reference along the chain */
+		zassert_equal_ptr(contexts[1].data_rx, contexts[0].data_tx,
+				  "In/out module 1 got a copy of the input audio data");
+		zassert_equal_ptr(contexts[2].data_rx, contexts[1].data_tx,
+				  "In/out module 2 got a copy of the input audio data");
+		zassert_equal_ptr(contexts[3].data_rx, contexts[2].data_tx,
+				  "Output module got a copy of the input audio data");
+	}
+
+	graph_stop_check();
+
+	for (int i = 0; i < TEST_GRAPH_MODULES_NUM; i++) {
+		zassert_equal(contexts[i].frames, TEST_GRAPH_FRAMES_NUM,
+			      "Module %d processed %d frames", i, contexts[i].frames);
+
+		ret = audio_module_stop(&handles[i]);
+		zassert_equal(ret, 0, "Stop did not return successfully: ret %d", ret);
+
+		ret = audio_module_close(&handles[i]);
+		zassert_equal(ret, 0, "Close did not return successfully: ret %d", ret);
+	}
+
+	zassert_equal(graph.module_count, 0, "Graph still has %d modules", graph.module_count);
+}
+
+ZTEST(suite_audio_module_graph, test_graph_fan_out_fnct)
+{
+	int ret;
+
+	graph_module_open(&graph, &graph_input_description, 0);
+	graph_module_open(&graph, &graph_output_description, 1);
+	graph_module_open(&graph, &graph_output_description, 2);
+
+	ret = audio_module_connect(&handles[0], &handles[1], false);
+	zassert_equal(ret, 0, "Connect did not return successfully: ret %d", ret);
+
+	ret = audio_module_connect(&handles[0], &handles[2], false);
+	zassert_equal(ret, 0, "Connect did not return successfully: ret %d", ret);
+
+	for (int i = 0; i < 3; i++) {
+		ret = audio_module_start(&handles[i]);
+		zassert_equal(ret, 0, "Start did not return successfully: ret %d", ret);
+	}
+
+	ret = audio_module_graph_start(&graph);
+	zassert_equal(ret, 0, "Graph start did not return successfully: ret %d", ret);
+
+	for (int frame = 0; frame < TEST_GRAPH_FRAMES_NUM; frame++) {
+		k_sem_give(&frame_in_sem);
+
+		for (int i = 0; i < 2; i++) {
+			ret = k_sem_take(&frame_out_sem, TEST_GRAPH_TIMEOUT);
+			zassert_equal(ret, 0, "Frame %d did not reach an output module", frame);
+		}
+
+		zassert_equal_ptr(contexts[1].data_rx, contexts[0].data_tx,
+				  "Output module 1 got a copy of the input audio data");
+		zassert_equal_ptr(contexts[2].data_rx, contexts[0].data_tx,
+				  "Output module 2 got a copy of the input audio data");
+		zassert_equal(contexts[2].value, frame, "Frame %d value %d", frame,
+			      contexts[2].value);
+	}
+
+	graph_stop_check();
+
+	/* A stopped module no longer gets audio data from the scheduler */
+	ret = audio_module_stop(&handles[2]);
+	zassert_equal(ret, 0, "Stop did not return successfully: ret %d", ret);
+
+	ret = audio_module_graph_start(&graph);
+	zassert_equal(ret, 0, "Graph start did not return successfully: ret %d", ret);
+
+	k_sem_give(&frame_in_sem);
+
+	ret = k_sem_take(&frame_out_sem, TEST_GRAPH_TIMEOUT);
+	zassert_equal(ret, 0, "Frame did not reach the running output module");
+
+	graph_stop_check();
+
+	zassert_equal(contexts[1].frames, TEST_GRAPH_FRAMES_NUM + 1,
+		      "Output module 1 processed %d frames", contexts[1].frames);
+	zassert_equal(contexts[2].frames, TEST_GRAPH_FRAMES_NUM,
+		      "Stopped output module processed %d frames", contexts[2].frames);
+}
+
+ZTEST(suite_audio_module_graph, test_graph_loop_fnct)
+{
+	int ret;
+
+	graph_module_open(&graph, &graph_in_out_description, 0);
+	graph_module_open(&graph, &graph_in_out_description, 1);
+
+	ret = audio_module_connect(&handles[0], &handles[1], false);
+	zassert_equal(ret, 0, "Connect did not return successfully: ret %d", ret);
+
+	ret = audio_module_connect(&handles[1], &handles[0], false);
+	zassert_equal(ret, 0, "Connect did not return successfully: ret %d", ret);
+
+	ret = audio_module_graph_start(&graph);
+	zassert_equal(ret, -ELOOP, "Graph start did not fail with -ELOOP: ret %d", ret);
+	zassert_false(graph.running, "Graph with a loop is running");
+}
+
+ZTEST(suite_audio_module_graph, test_graph_idle_source_fnct)
+{
+	int ret;
+
+	/* A source in/out module that is fed through its RX FIFO, which stays empty */
+	RESET_FAKE(data_fifo_pointer_last_filled_get);
+	data_fifo_pointer_last_filled_get_fake.return_val = -ENOMSG;
+
+	graph_module_open(&graph, &graph_in_out_description, 0);
+	graph_module_open(&graph, &graph_output_description, 1);
+
+	ret = audio_module_connect(&handles[0], &handles[1], false);
+	zassert_equal(ret, 0, "Connect did not return successfully: ret %d", ret);
+
+	for (int i = 0; i < 2; i++) {
+		ret = audio_module_start(&handles[i]);
+		zassert_equal(ret, 0, "Start did not return successfully: ret %d", ret);
+	}
+
+	ret = audio_module_graph_start(&graph);
+	zassert_equal(ret, 0, "Graph start did not return successfully: ret %d", ret);
+
+	ret = k_sem_take(&frame_out_sem, TEST_GRAPH_TIMEOUT);
+	zassert_equal(ret, -EAGAIN, "Output module processed a frame without audio data");
+
+	zassert_true(data_fifo_pointer_last_filled_get_fake.call_count > 0,
+		     "The scheduler did not poll the source module");
+	zassert_equal(contexts[0].frames, 0, "Idle source module processed %d frames",
+		      contexts[0].frames);
+
+	/* The scheduler is not blocked waiting for the idle source */
+	graph_stop_check();
+}
+
+ZTEST(suite_audio_module_graph, test_graph_bad_param)
+{
+	int ret;
+	struct audio_module_graph graph_other;
+	struct audio_module_graph_parameters parameters = {
+		.stack = graph_stack,
+		.stack_size = K_THREAD_STACK_SIZEOF(graph_stack),
+		.priority = TEST_MOD_THREAD_PRIORITY,
+		.data_slab = NULL};
+	struct audio_module_parameters module_parameters = {
+		.description = &graph_output_description,
+		.thread = {.data_size = TEST_MOD_DATA_SIZE},
+		.graph = &graph};
+
+	ret = audio_module_graph_init(NULL, &parameters);
+	zassert_equal(ret, -EINVAL, "Graph init did not fail with -EINVAL: ret %d", ret);
+
+	ret = audio_module_graph_init(&graph_other, &parameters);
+	zassert_equal(ret, -EINVAL, "Graph init without a slab did not fail: ret %d", ret);
+
+	parameters.data_slab = &graph_slab;
+
+	ret = audio_module_graph_init(&graph_other, &parameters);
+	zassert_equal(ret, 0, "Graph init did not return successfully: ret %d", ret);
+
+	ret = audio_module_graph_stop(&graph);
+	zassert_equal(ret, -EALREADY, "Graph stop did not fail with -EALREADY: ret %d", ret);
+
+	/* Modules in different graphs cannot be connected */
+	graph_module_open(&graph, &graph_input_description, 0);
+	graph_module_open(&graph_other, &graph_output_description, 1);
+
+	ret = audio_module_connect(&handles[0], &handles[1], false);
+	zassert_equal(ret, -EINVAL, "Connect across graphs did not fail: ret %d", ret);
+
+	/* No modules can be added to a running graph */
+	ret = audio_module_graph_start(&graph);
+	zassert_equal(ret, 0, "Graph start did not return successfully: ret %d", ret);
+
+	ret = audio_module_graph_start(&graph);
+	zassert_equal(ret, -EALREADY, "Graph start did not fail with -EALREADY: ret %d", ret);
+
+	ret = audio_module_open(&module_parameters,
+				(struct audio_module_configuration *)&graph_config, "Late module",
+				(struct audio_module_context *)&contexts[2], &handles[2]);
+	zassert_equal(ret, -EBUSY, "Open in a running graph did not fail: ret %d", ret);
+
+	ret = audio_module_close(&handles[0]);
+	zassert_equal(ret, -EBUSY, "Close in a running graph did not fail: ret %d", ret);
+
+	ret = audio_module_graph_stop(&graph);
+	zassert_equal(ret, 0, "Graph stop did not return successfully: ret %d", ret);
+}
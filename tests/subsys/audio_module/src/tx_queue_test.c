@@ -0,0 +1,246 @@
+/*
+ * Copyright (c) 2024 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#include <zephyr/ztest.h>
+#include <zephyr/kernel.h>
+
+#include "audio_module/audio_module.h"
+#include "data_fifo.h"
+
+#define TXQ_DATA_SIZE	  (64)
+#define TXQ_BLOCKS_NUM	  (4)
+#define TXQ_FIFO_ELEMENTS (2)
+#define TXQ_STACK_SIZE	  (2048)
+#define TXQ_PRIORITY	  (4)
+#define TXQ_TIMEOUT	  (K_MSEC(500))
+/* Time for the module threads to finish handling a frame */
+#define TXQ_SETTLE_TIME	  (K_MSEC(50))
+
+K_THREAD_STACK_DEFINE(txq_input_stack, TXQ_STACK_SIZE);
+K_THREAD_STACK_DEFINE(txq_output_stack, TXQ_STACK_SIZE);
+K_MEM_SLAB_DEFINE_STATIC(txq_slab, WB_UP(TXQ_DATA_SIZE), TXQ_BLOCKS_NUM, 4);
+DATA_FIFO_DEFINE(txq_fifo_tx, TXQ_FIFO_ELEMENTS, WB_UP(sizeof(struct audio_module_message)));
+DATA_FIFO_DEFINE(txq_fifo_rx, TXQ_FIFO_ELEMENTS, WB_UP(sizeof(struct audio_module_message)));
+
+static K_SEM_DEFINE(txq_frame_in_sem, 0, 1);
+static K_SEM_DEFINE(txq_frame_out_sem, 0, 1);
+static K_SEM_DEFINE(txq_release_sem, 0, 1);
+
+static struct audio_module_handle txq_input;
+static struct audio_module_handle txq_output;
+static uint32_t txq_context[2];
+static uint32_t txq_config;
+static uint8_t txq_frame_cnt;
+
+static int txq_config_set(struct audio_module_handle_private *handle,
+			  struct audio_module_configuration const *const configuration)
+{
+	ARG_UNUSED(handle);
+	ARG_UNUSED(configuration);
+
+	return 0;
+}
+
+static int txq_config_get(struct audio_module_handle_private const *const handle,
+			  struct audio_module_configuration *configuration)
+{
+	ARG_UNUSED(handle);
+	ARG_UNUSED(configuration);
+
+	return 0;
+}
+
+static int txq_input_process(struct audio_module_handle_private *handle,
+			     struct audio_data const *const audio_data_rx,
+			     struct audio_data *audio_data_tx)
+{
+	ARG_UNUSED(handle);
+	ARG_UNUSED(audio_data_rx);
+
+	/* Wait with the block of the next frame allocated, so the slab usage is stable.
+	 * The thread is aborted when the module is closed.
+	 */
+	k_sem_take(&txq_frame_in_sem, K_FOREVER);
+
+	memset(audio_data_tx->data, txq_frame_cnt, audio_data_tx->data_size);
+
+	return 0;
+}
+
+static int txq_output_process(struct audio_module_handle_private *handle,
+			      struct audio_data const *const audio_data_rx,
+			      struct audio_data *audio_data_tx)
+{
+	ARG_UNUSED(handle);
+	ARG_UNUSED(audio_data_rx);
+	ARG_UNUSED(audio_data_tx);
+
+	k_sem_give(&txq_frame_out_sem);
+
+	/* Hold the audio data until the test lets it go */
+	k_sem_take(&txq_release_sem, K_FOREVER);
+
+	return 0;
+}
+
+static const struct audio_module_functions txq_input_ft = {
+	.configuration_set = txq_config_set,
+	.configuration_get = txq_config_get,
+	.data_process = txq_input_process};
+
+static const struct audio_module_functions txq_output_ft = {
+	.configuration_set = txq_config_set,
+	.configuration_get = txq_config_get,
+	.data_process = txq_output_process};
+
+static struct audio_module_description txq_input_description = {
+	.name = "TX queue input", .type = AUDIO_MODULE_TYPE_INPUT, .functions = &txq_input_ft};
+
+static struct audio_module_description txq_output_description = {
+	.name = "TX queue output", .type = AUDIO_MODULE_TYPE_OUTPUT, .functions = &txq_output_ft};
+
+static void txq_module_open(struct audio_module_description *description,
+			    k_thread_stack_t *stack, size_t stack_size, struct data_fifo *msg_rx,
+			    struct data_fifo *msg_tx, uint32_t *context,
+			    struct audio_module_handle *handle)
+{
+	int ret;
+	struct audio_module_parameters parameters;
+
+	memset(&parameters, 0, sizeof(parameters));
+	parameters.description = description;
+	parameters.thread.stack = stack;
+	parameters.thread.stack_size = stack_size;
+	parameters.thread.priority = TXQ_PRIORITY;
+	parameters.thread.data_slab = &txq_slab;
+	parameters.thread.data_size = TXQ_DATA_SIZE;
+	parameters.thread.msg_rx = msg_rx;
+	parameters.thread.msg_tx = msg_tx;
+
+	ret = audio_module_open(&parameters, (struct audio_module_configuration *)&txq_config,
+				description->name, (struct audio_module_context *)context, handle);
+	zassert_equal(ret, 0, "Open did not return successfully: ret %d", ret);
+}
+
+/**
+ * @brief Send a frame from the input module, which is connected to an output module and to its
+ *        own TX FIFO, and wait for the output module to get it.
+ */
+static void txq_frame_send(void)
+{
+	int ret;
+
+	txq_frame_cnt++;
+	k_sem_give(&txq_frame_in_sem);
+
+	ret = k_sem_take(&txq_frame_out_sem, TXQ_TIMEOUT);
+	zassert_equal(ret, 0, "Frame %d did not reach the output module", txq_frame_cnt);
+}
+
+static void txq_frame_rx(void)
+{
+	int ret;
+	uint8_t data[TXQ_DATA_SIZE];
+	struct audio_data audio_data = {.data = data, .data_size = sizeof(data)};
+
+	ret = audio_module_data_rx(&txq_input, &audio_data, TXQ_TIMEOUT);
+	zassert_equal(ret, 0, "Data RX did not return successfully: ret %d", ret);
+
+	for (size_t i = 0; i < sizeof(data); i++) {
+		zassert_equal(data[i], txq_frame_cnt, "Frame %d corrupted at byte %zu",
+			      txq_frame_cnt, i);
+	}
+}
+
+static void txq_output_release(void)
+{
+	k_sem_give(&txq_release_sem);
+	k_sleep(TXQ_SETTLE_TIME);
+}
+
+static void *txq_setup(void)
+{
+	int ret;
+
+	ret = data_fifo_init(&txq_fifo_tx);
+	zassert_equal(ret, 0, "Data FIFO init did not return successfully: ret %d", ret);
+
+	ret = data_fifo_init(&txq_fifo_rx);
+	zassert_equal(ret, 0, "Data FIFO init did not return successfully: ret %d", ret);
+
+	return NULL;
+}
+
+/* The audio data sent to one module and to the TX FIFO is freed once both have released it */
+ZTEST(suite_audio_module_tx_queue, test_tx_queue_and_module_release)
+{
+	int ret;
+	uint32_t used_idle;
+
+	memset(&txq_input, 0, sizeof(txq_input));
+	memset(&txq_output, 0, sizeof(txq_output));
+
+	txq_module_open(&txq_input_description, txq_input_stack,
+			K_THREAD_STACK_SIZEOF(txq_input_stack), NULL, &txq_fifo_tx,
+			&txq_context[0], &txq_input);
+	txq_module_open(&txq_output_description, txq_output_stack,
+			K_THREAD_STACK_SIZEOF(txq_output_stack), &txq_fifo_rx, NULL,
+			&txq_context[1], &txq_output);
+
+	ret = audio_module_connect(&txq_input, &txq_output, false);
+	zassert_equal(ret, 0, "Connect did not return successfully: ret %d", ret);
+
+	ret = audio_module_connect(&txq_input, NULL, true);
+	zassert_equal(ret, 0, "Connect did not return successfully: ret %d", ret);
+
+	ret = audio_module_start(&txq_output);
+	zassert_equal(ret, 0, "Start did not return successfully: ret %d", ret);
+
+	ret = audio_module_start(&txq_input);
+	zassert_equal(ret, 0, "Start did not return successfully: ret %d", ret);
+
+	/* The input module holds the block for its next frame while waiting */
+	k_sleep(TXQ_SETTLE_TIME);
+	used_idle = k_mem_slab_num_used_get(&txq_slab);
+
+	/* The module releases the audio data first */
+	txq_frame_send();
+	zassert_equal(used_idle + 1, k_mem_slab_num_used_get(&txq_slab), "Block not in use");
+
+	txq_output_release();
+	zassert_equal(used_idle + 1, k_mem_slab_num_used_get(&txq_slab),
+		      "Block freed while still on the TX FIFO");
+
+	txq_frame_rx();
+	zassert_equal(used_idle, k_mem_slab_num_used_get(&txq_slab),
+		      "Block not freed exactly once");
+
+	/* The TX FIFO is read first */
+	txq_frame_send();
+	zassert_equal(used_idle + 1, k_mem_slab_num_used_get(&txq_slab), "Block not in use");
+
+	txq_frame_rx();
+	zassert_equal(used_idle + 1, k_mem_slab_num_used_get(&txq_slab),
+		      "Block freed while still in the output module");
+
+	txq_output_release();
+	zassert_equal(used_idle, k_mem_slab_num_used_get(&txq_slab),
+		      "Block not freed exactly once");
+
+	ret = audio_module_stop(&txq_input);
+	zassert_equal(ret, 0, "Stop did not return successfully: ret %d", ret);
+
+	ret = audio_module_stop(&txq_output);
+	zassert_equal(ret, 0, "Stop did not return successfully: ret %d", ret);
+
+	ret = audio_module_close(&txq_input);
+	zassert_equal(ret, 0, "Close did not return successfully: ret %d", ret);
+
+	ret = audio_module_close(&txq_output);
+	zassert_equal(ret, 0, "Close did not return successfully: ret %d", ret);
+}
+
+ZTEST_SUITE(suite_audio_module_tx_queue, NULL, txq_setup, NULL, NULL, NULL);
@@ -19,6 +19,7 @@ static struct bt_discover_mock {
 	struct bt_conn *conn;
 	struct bt_gatt_discover_params *params;
 	struct k_work_delayable work;
+	uint32_t call_cnt;
 } discover_mock_data;
 
 static void bt_gatt_discover_work(struct k_work *work);
@@ -28,6 +29,12 @@ void bt_gatt_discover_mock_setup(const struct bt_gatt_attr *attr, size_t len)
 	k_work_init_delayable(&discover_mock_data.work, bt_gatt_discover_work);
 	discover_mock_data.attr = attr;
 	discover_mock_data.len  = len;
+	discover_mock_data.call_cnt = 0;
+}
+
+uint32_t bt_gatt_discover_mock_call_cnt(void)
+{
+	return discover_mock_data.call_cnt;
 }
 
 static bool bt_gatt_primary_check(const struct bt_gatt_attr *attr_cur,
@@ -128,6 +135,7 @@ int bt_gatt_discover(struct bt_conn *conn,
 	printk("Running %s mock\n", __func__);
 	discover_mock_data.conn = conn;
 	discover_mock_data.params = params;
+	discover_mock_data.call_cnt++;
 
 	k_work_schedule(&discover_mock_data.work, K_MSEC(5));
 	return 0;
@@ -0,0 +1,213 @@
+/*
+ * Copyright (c) 2024 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+#include <string.h>
+#include <zephyr/kernel.h>
+#include <zephyr/bluetooth/bluetooth.h>
+#include <zephyr/bluetooth/conn.h>
+#include <zephyr/bluetooth/gatt.h>
+#include <zephyr/bluetooth/att.h>
+#include <zephyr/settings/settings.h>
+#include <zephyr/ztest.h>
+
+#include "gatt_dm_cache_mock.h"
+
+#define DB_HASH_LEN 16
+#define SETTINGS_MOCK_ENTRY_CNT 8
+#define SETTINGS_MOCK_VALUE_SIZE 1536
+
+/* Settings stored in RAM */
+struct settings_mock_entry {
+	char key[SETTINGS_MAX_NAME_LEN + 1];
+	uint8_t val[SETTINGS_MOCK_VALUE_SIZE];
+	size_t len;
+};
+
+const bt_addr_le_t gatt_dm_cache_mock_peer = {
+	.type = BT_ADDR_LE_PUBLIC,
+	.a.val = {0x01, 0x02, 0x03, 0x04, 0x05, 0x06},
+};
+
+static struct gatt_dm_cache_mock {
+	struct settings_mock_entry entries[SETTINGS_MOCK_ENTRY_CNT];
+	bool bonded;
+	uint8_t db_hash_seed;
+	struct bt_conn *conn;
+	struct bt_gatt_read_params *read_params;
+	struct k_work_delayable read_work;
+	struct bt_conn_auth_info_cb *auth_info_cb;
+} cache_mock;
+
+static void bt_gatt_read_work(struct k_work *work)
+{
+	uint8_t hash[DB_HASH_LEN];
+
+	if (!cache_mock.db_hash_seed) {
+		(void)cache_mock.read_params->func(cache_mock.conn,
+						   BT_ATT_ERR_ATTRIBUTE_NOT_FOUND,
+						   cache_mock.read_params, NULL, 0);
+		return;
+	}
+
+	memset(hash, cache_mock.db_hash_seed, sizeof(hash));
+	(void)cache_mock.read_params->func(cache_mock.conn, 0, cache_mock.read_params,
+					   hash, sizeof(hash));
+}
+
+void gatt_dm_cache_mock_reset(void)
+{
+	memset(cache_mock.entries, 0, sizeof(cache_mock.entries));
+	cache_mock.bonded = false;
+	cache_mock.db_hash_seed = 0x11;
+	k_work_init_delayable(&cache_mock.read_work, bt_gatt_read_work);
+}
+
+void gatt_dm_cache_mock_bonded_set(bool bonded)
+{
+	cache_mock.bonded = bonded;
+}
+
+void gatt_dm_cache_mock_db_hash_set(uint8_t seed)
+{
+	cache_mock.db_hash_seed = seed;
+}
+
+size_t gatt_dm_cache_mock_record_cnt(void)
+{
+	size_t cnt = 0;
+
+	for (size_t i = 0; i < ARRAY_SIZE(cache_mock.entries); i++) {
+		if (cache_mock.entries[i].key[0]) {
+			cnt++;
+		}
+	}
+
+	return cnt;
+}
+
+void gatt_dm_cache_mock_bond_delete(void)
+{
+	zassert_not_null(cache_mock.auth_info_cb, "No authentication info callback registered");
+	cache_mock.auth_info_cb->bond_deleted(BT_ID_DEFAULT, &gatt_dm_cache_mock_peer);
+}
+
+/* Mocked Bluetooth host functions */
+int bt_conn_get_info(const struct bt_conn *conn, struct bt_conn_info *info)
+{
+	memset(info, 0, sizeof(*info));
+	info->type = BT_CONN_TYPE_LE;
+	info->id = BT_ID_DEFAULT;
+	info->le.dst = &gatt_dm_cache_mock_peer;
+
+	return 0;
+}
+
+bool bt_addr_le_is_bonded(uint8_t id, const bt_addr_le_t *addr)
+{
+	return cache_mock.bonded && (id == BT_ID_DEFAULT) &&
+	       !bt_addr_le_cmp(addr, &gatt_dm_cache_mock_peer);
+}
+
+int bt_gatt_read(struct bt_conn *conn, struct bt_gatt_read_params *params)
+{
+	zassert_equal(0, params->handle_count, "Only the read by UUID is mocked");
+	zassert_equal(0, bt_uuid_cmp(params->by_uuid.uuid, BT_UUID_GATT_DB_HASH),
+		      "Unexpected UUID read");
+
+	cache_mock.conn = conn;
+	cache_mock.read_params = params;
+	k_work_schedule(&cache_mock.read_work, K_MSEC(5));
+
+	return 0;
+}
+
+int bt_conn_auth_info_cb_register(struct bt_conn_auth_info_cb *cb)
+{
+	cache_mock.auth_info_cb = cb;
+
+	return 0;
+}
+
+/* Mocked settings functions */
+static struct settings_mock_entry *settings_entry_find(const char *name)
+{
+	for (size_t i = 0; i < ARRAY_SIZE(cache_mock.entries); i++) {
+		if (!strcmp(cache_mock.entries[i].key, name)) {
+			return &cache_mock.entries[i];
+		}
+	}
+
+	return NULL;
+}
+
+int settings_save_one(const char *name, const void *value, size_t val_len)
+{
+	struct settings_mock_entry *entry = settings_entry_find(name);
+
+	zassert_true(val_len <= SETTINGS_MOCK_VALUE_SIZE, "Record of %zu bytes", val_len);
+
+	if (!entry) {
+		entry = settings_entry_find("");
+		zassert_not_null(entry, "Settings mock full");
+		strcpy(entry->key, name);
+	}
+
+	memcpy(entry->val, value, val_len);
+	entry->len = val_len;
+
+	return 0;
+}
+
+int settings_delete(const char *name)
+{
+	struct settings_mock_entry *entry = settings_entry_find(name);
+
+	if (entry) {
+		memset(entry, 0, sizeof(*entry));
+	}
+
+	return 0;
+}
+
+static ssize_t settings_mock_read(void *cb_arg, void *data, size_t len)
+{
+	struct settings_mock_entry *entry = cb_arg;
+
+	len = MIN(len, entry->len);
+	memcpy(data, entry->val, len);
+
+	return len;
+}
+
+int settings_load_subtree_direct(const char *subtree, settings_load_direct_cb cb, void *param)
+{
+	size_t subtree_len = strlen(subtree);
+
+	for (size_t i = 0; i < ARRAY_SIZE(cache_mock.entries); i++) {
+		struct settings_mock_entry *entry = &cache_mock.entries[i];
+		const char *next;
+		int err;
+
+		if (!entry->key[0] || strncmp(entry->key, subtree, subtree_len)) {
+			continue;
+		}
+
+		/* The key relative to the subtree, or NULL for the subtree itself */
+		if (entry->key[subtree_len] == '\0') {
+			next = NULL;
+		} else if (entry->key[subtree_len] == '/') {
+			next = &entry->key[subtree_len + 1];
+		} else {
+			continue;
+		}
+
+		err = cb(next, entry->len, settings_mock_read, entry, param);
+		if (err) {
+			return err;
+		}
+	}
+
+	return 0;
+}
@@ -0,0 +1,58 @@
+/*
+ * Copyright (c) 2024 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#ifndef BT_GATT_DM_CACHE_MOCK_H_
+#define BT_GATT_DM_CACHE_MOCK_H_
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <zephyr/bluetooth/addr.h>
+
+/**
+ * @file
+ * @defgroup bt_gatt_dm_cache_mock API
+ * @{
+ * @brief The API used to setup the mocks of the Bluetooth host and of the settings
+ *        used by the discovery cache
+ */
+
+/** @brief Address of the peer returned by the bt_conn_get_info mock. */
+extern const bt_addr_le_t gatt_dm_cache_mock_peer;
+
+/**
+ * @brief Reset the mocks
+ *
+ * The settings are erased, the peer is not bonded and it has a GATT Database Hash.
+ */
+void gatt_dm_cache_mock_reset(void);
+
+/**
+ * @brief Set whether the peer is bonded
+ *
+ * @param bonded True if the peer is bonded.
+ */
+void gatt_dm_cache_mock_bonded_set(bool bonded);
+
+/**
+ * @brief Set the GATT Database Hash of the peer
+ *
+ * @param seed Value of every byte of the hash, or 0 if the peer has no hash.
+ */
+void gatt_dm_cache_mock_db_hash_set(uint8_t seed);
+
+/**
+ * @brief Number of records stored in the settings
+ */
+size_t gatt_dm_cache_mock_record_cnt(void);
+
+/**
+ * @brief Report to the discovery manager that the bond with the peer is deleted
+ */
+void gatt_dm_cache_mock_bond_delete(void);
+
+/** @} */
+#endif /* BT_GATT_DM_CACHE_MOCK_H_ */
@@ -0,0 +1,228 @@
+/*
+ * Copyright (c) 2024 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+#include <zephyr/ztest.h>
+#include <zephyr/kernel.h>
+#include <zephyr/bluetooth/uuid.h>
+#include <bluetooth/gatt_dm.h>
+#include "../../mock/gatt_discover_mock.h"
+#include "../../mock/gatt_dm_cache_mock.h"
+
+/* Timeout for the discovery in ms */
+#define SERVICE_DISCOVERY_TIMEOUT 2000
+
+static char cache_conn;
+static K_SEM_DEFINE(cache_discovery_finished, 0, 1);
+
+static const struct bt_gatt_attr cache_discover_sim[] = {
+	/* HIDS */
+	BT_GATT_DISCOVER_MOCK_SERV(1, BT_UUID_HIDS, 6),
+	BT_GATT_DISCOVER_MOCK_CHRC(2, BT_UUID_HIDS_INFO, BT_GATT_CHRC_READ),
+	BT_GATT_DISCOVER_MOCK_DESC(3, BT_UUID_HIDS_INFO),
+
+	BT_GATT_DISCOVER_MOCK_CHRC(4, BT_UUID_HIDS_REPORT, BT_GATT_CHRC_READ | BT_GATT_CHRC_NOTIFY),
+	BT_GATT_DISCOVER_MOCK_DESC(5, BT_UUID_HIDS_REPORT),
+	BT_GATT_DISCOVER_MOCK_DESC(6, BT_UUID_GATT_CCC),
+
+	/* DIS */
+	BT_GATT_DISCOVER_MOCK_SERV(7, BT_UUID_DIS, 0xffff),
+	BT_GATT_DISCOVER_MOCK_CHRC(8, BT_UUID_DIS_MODEL_NUMBER, BT_GATT_CHRC_READ),
+	BT_GATT_DISCOVER_MOCK_DESC(9, BT_UUID_DIS_MODEL_NUMBER),
+};
+
+static void cache_cb_completed(struct bt_gatt_dm *dm, void *context)
+{
+	*(struct bt_gatt_dm **)context = dm;
+	k_sem_give(&cache_discovery_finished);
+}
+
+static void cache_cb_service_not_found(struct bt_conn *conn, void *context)
+{
+	*(struct bt_gatt_dm **)context = NULL;
+	k_sem_give(&cache_discovery_finished);
+}
+
+static void cache_cb_error_found(struct bt_conn *conn, int err, void *context)
+{
+	zassert_unreachable("Discovery error: %d", err);
+}
+
+static const struct bt_gatt_dm_cb cache_cb = {
+	.completed         = cache_cb_completed,
+	.service_not_found = cache_cb_service_not_found,
+	.error_found       = cache_cb_error_found
+};
+
+static struct bt_gatt_dm *cache_run_dm(const struct bt_uuid *svc_uuid)
+{
+	struct bt_gatt_dm *dm;
+	int err;
+
+	err = bt_gatt_dm_start((struct bt_conn *)&cache_conn, svc_uuid, &cache_cb, &dm);
+	zassert_false(err, "bt_gatt_dm_start finished with error: %d", err);
+
+	err = k_sem_take(&cache_discovery_finished, K_MSEC(SERVICE_DISCOVERY_TIMEOUT));
+	zassert_equal(0, err, "It seems that no callback function was called: %d", err);
+
+	return dm;
+}
+
+/* Check the HIDS attributes, whether they were discovered or loaded from the cache */
+static void cache_hids_check(struct bt_gatt_dm *dm)
+{
+	const struct bt_gatt_dm_attr *attr_chrc;
+	const struct bt_gatt_dm_attr *attr_desc;
+	const struct bt_gatt_service_val *serv_val;
+	const struct bt_gatt_chrc *chrc_val;
+
+	zassert_not_null(dm, "Device Manager pointer not set");
+	zassert_equal(6, bt_gatt_dm_attr_cnt(dm), "Unexpected number of attributes: %d",
+		      bt_gatt_dm_attr_cnt(dm));
+
+	serv_val = bt_gatt_dm_attr_service_val(bt_gatt_dm_service_get(dm));
+	zassert_not_null(serv_val, "No service value");
+	zassert_true(!bt_uuid_cmp(BT_UUID_HIDS, serv_val->uuid), "Invalid service detected");
+	zassert_equal(6, serv_val->end_handle, "Unexpected end handle: %d", serv_val->end_handle);
+
+	attr_chrc = bt_gatt_dm_char_by_uuid(dm, BT_UUID_HIDS_REPORT);
+	zassert_not_null(attr_chrc, "HIDS_REPORT not found");
+	zassert_equal(4, attr_chrc->handle, "Unexpected handle: %d", attr_chrc->handle);
+	chrc_val = bt_gatt_dm_attr_chrc_val(attr_chrc);
+	zassert_not_null(chrc_val, "No HIDS_REPORT value");
+	zassert_equal(BT_GATT_CHRC_READ | BT_GATT_CHRC_NOTIFY, chrc_val->properties,
+		      "Unexpected HIDS_REPORT properties");
+
+	attr_desc = bt_gatt_dm_desc_by_uuid(dm, attr_chrc, BT_UUID_GATT_CCC);
+	zassert_not_null(attr_desc, "CCC not found");
+	zassert_equal(6, attr_desc->handle, "Unexpected handle: %d", attr_desc->handle);
+}
+
+static void cache_before(void *fixture)
+{
+	ARG_UNUSED(fixture);
+
+	k_sem_reset(&cache_discovery_finished);
+	gatt_dm_cache_mock_reset();
+	bt_gatt_discover_mock_setup(cache_discover_sim, ARRAY_SIZE(cache_discover_sim));
+}
+
+static void cache_after(void *fixture)
+{
+	ARG_UNUSED(fixture);
+
+	/* The other tests run with a peer that is not bonded */
+	gatt_dm_cache_mock_reset();
+}
+
+ZTEST_SUITE(gatt_dm_cache_tests, NULL, NULL, cache_before, cache_after, NULL);
+
+/* The second discovery of a bonded peer is loaded from the cache */
+ZTEST(gatt_dm_cache_tests, test_cache_hit)
+{
+	struct bt_gatt_dm *dm;
+
+	gatt_dm_cache_mock_bonded_set(true);
+
+	dm = cache_run_dm(BT_UUID_HIDS);
+	cache_hids_check(dm);
+	zassert_true(bt_gatt_discover_mock_call_cnt() > 0, "Service not discovered");
+	zassert_equal(1, gatt_dm_cache_mock_record_cnt(), "Attributes not cached");
+	bt_gatt_dm_data_release(dm);
+
+	bt_gatt_discover_mock_setup(cache_discover_sim, ARRAY_SIZE(cache_discover_sim));
+
+	dm = cache_run_dm(BT_UUID_HIDS);
+	cache_hids_check(dm);
+	zassert_equal(0, bt_gatt_discover_mock_call_cnt(), "Discovered despite the cache");
+	bt_gatt_dm_data_release(dm);
+
+	/* Not finding a service is cached as well */
+	dm = cache_run_dm(BT_UUID_BAS);
+	zassert_is_null(dm, "Detected service that should be inviable");
+	zassert_equal(2, gatt_dm_cache_mock_record_cnt(), "Result not cached");
+
+	bt_gatt_discover_mock_setup(cache_discover_sim, ARRAY_SIZE(cache_discover_sim));
+
+	dm = cache_run_dm(BT_UUID_BAS);
+	zassert_is_null(dm, "Detected service that should be inviable");
+	zassert_equal(0, bt_gatt_discover_mock_call_cnt(), "Discovered despite the cache");
+}
+
+/* The cache is not used once the GATT Database Hash of the peer has changed */
+ZTEST(gatt_dm_cache_tests, test_cache_stale_db_hash)
+{
+	struct bt_gatt_dm *dm;
+
+	gatt_dm_cache_mock_bonded_set(true);
+
+	dm = cache_run_dm(BT_UUID_HIDS);
+	cache_hids_check(dm);
+	bt_gatt_dm_data_release(dm);
+
+	gatt_dm_cache_mock_db_hash_set(0x22);
+	bt_gatt_discover_mock_setup(cache_discover_sim, ARRAY_SIZE(cache_discover_sim));
+
+	dm = cache_run_dm(BT_UUID_HIDS);
+	cache_hids_check(dm);
+	zassert_true(bt_gatt_discover_mock_call_cnt() > 0, "Stale cache used");
+	zassert_equal(1, gatt_dm_cache_mock_record_cnt(), "Cached attributes not replaced");
+	bt_gatt_dm_data_release(dm);
+
+	/* The attributes are cached with the new hash */
+	bt_gatt_discover_mock_setup(cache_discover_sim, ARRAY_SIZE(cache_discover_sim));
+
+	dm = cache_run_dm(BT_UUID_HIDS);
+	cache_hids_check(dm);
+	zassert_equal(0, bt_gatt_discover_mock_call_cnt(), "Discovered despite the cache");
+	bt_gatt_dm_data_release(dm);
+}
+
+/* The attributes of a peer that is not bonded are never cached */
+ZTEST(gatt_dm_cache_tests, test_cache_unbonded_peer)
+{
+	struct bt_gatt_dm *dm;
+
+	for (int i = 0; i < 2; i++) {
+		bt_gatt_discover_mock_setup(cache_discover_sim, ARRAY_SIZE(cache_discover_sim));
+
+		dm = cache_run_dm(BT_UUID_HIDS);
+		cache_hids_check(dm);
+		zassert_true(bt_gatt_discover_mock_call_cnt() > 0, "Service not discovered");
+		zassert_equal(0, gatt_dm_cache_mock_record_cnt(), "Attributes cached");
+		bt_gatt_dm_data_release(dm);
+	}
+}
+
+/* A peer without the GATT Database Hash is always discovered */
+ZTEST(gatt_dm_cache_tests, test_cache_no_db_hash)
+{
+	struct bt_gatt_dm *dm;
+
+	gatt_dm_cache_mock_bonded_set(true);
+	gatt_dm_cache_mock_db_hash_set(0);
+
+	dm = cache_run_dm(BT_UUID_HIDS);
+	cache_hids_check(dm);
+	zassert_true(bt_gatt_discover_mock_call_cnt() > 0, "Service not discovered");
+	zassert_equal(0, gatt_dm_cache_mock_record_cnt(), "Attributes cached");
+	bt_gatt_dm_data_release(dm);
+}
+
+/* The cached attributes are deleted with the bond */
+ZTEST(gatt_dm_cache_tests, test_cache_bond_deleted)
+{
+	struct bt_gatt_dm *dm;
+
+	gatt_dm_cache_mock_bonded_set(true);
+
+	dm = cache_run_dm(BT_UUID_HIDS);
+	bt_gatt_dm_data_release(dm);
+	dm = cache_run_dm(BT_UUID_DIS);
+	bt_gatt_dm_data_release(dm);
+	zassert_equal(2, gatt_dm_cache_mock_record_cnt(), "Attributes not cached");
+
+	gatt_dm_cache_mock_bond_delete();
+	zassert_equal(0, gatt_dm_cache_mock_record_cnt(), "Cached attributes not deleted");
+}
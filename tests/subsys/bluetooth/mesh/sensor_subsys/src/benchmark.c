@@ -0,0 +1,110 @@
+/*
+ * Copyright (c) 2024 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#include <zephyr/ztest.h>
+#include <zephyr/kernel.h>
+#include <bluetooth/mesh/sensor_types.h>
+#include <sensor.h> // private header from the source folder
+
+#define BENCH_ROUNDS (64)
+
+/* Number of entries in a typical Sensor Series Status message */
+#define BENCH_SERIES_ENTRIES (8)
+
+static void bench_print(const char *name, uint32_t ops, uint32_t cycles)
+{
+	uint64_t rate;
+
+	cycles = MAX(cycles, 1);
+	rate = (uint64_t)ops * sys_clock_hw_cycles_per_sec() / cycles;
+
+	TC_PRINT("%s: %u cycles per operation, %llu operations/s\n", name,
+		 cycles / ops, (unsigned long long)rate);
+}
+
+static const struct bt_mesh_sensor_type *type_get_linear(uint16_t id)
+{
+	STRUCT_SECTION_FOREACH(bt_mesh_sensor_type, type) {
+		if (type->id == id) {
+			return type;
+		}
+	}
+
+	return NULL;
+}
+
+ZTEST(sensor_subsys_benchmark, test_benchmark_type_get)
+{
+	size_t type_cnt;
+	uint32_t start;
+	uint32_t linear;
+	uint32_t sorted;
+
+	STRUCT_SECTION_COUNT(bt_mesh_sensor_type, &type_cnt);
+
+	start = k_cycle_get_32();
+	for (int i = 0; i < BENCH_ROUNDS; i++) {
+		STRUCT_SECTION_FOREACH(bt_mesh_sensor_type, type) {
+			zassert_equal_ptr(type_get_linear(type->id), type);
+		}
+	}
+	linear = k_cycle_get_32() - start;
+
+	start = k_cycle_get_32();
+	for (int i = 0; i < BENCH_ROUNDS; i++) {
+		STRUCT_SECTION_FOREACH(bt_mesh_sensor_type, type) {
+			zassert_equal_ptr(bt_mesh_sensor_type_get(type->id), type);
+		}
+	}
+	sorted = k_cycle_get_32() - start;
+
+	TC_PRINT("%u sensor types\n", (uint32_t)type_cnt);
+	bench_print("Linear lookup", BENCH_ROUNDS * type_cnt, linear);
+	bench_print("Sorted lookup", BENCH_ROUNDS * type_cnt, sorted);
+}
+
+ZTEST(sensor_subsys_benchmark, test_benchmark_series_decode)
+{
+	const struct bt_mesh_sensor_type *type =
+		&bt_mesh_sensor_rel_dev_runtime_in_a_generic_level_range;
+	static uint8_t data[BENCH_SERIES_ENTRIES *
+			    (CONFIG_BT_MESH_SENSOR_CHANNELS_MAX + 2) *
+			    CONFIG_BT_MESH_SENSOR_CHANNEL_ENCODED_SIZE_MAX];
+	struct bt_mesh_sensor_series_entry entry;
+	struct sensor_codec codec;
+	struct net_buf_simple buf;
+	uint32_t per_entry = 0;
+	uint32_t codec_cycles = 0;
+	uint32_t start;
+
+	sensor_codec_init(&codec, type);
+
+	for (int i = 0; i < BENCH_ROUNDS; i++) {
+		net_buf_simple_init_with_data(&buf, data, BENCH_SERIES_ENTRIES * codec.entry_len);
+
+		/* Formats resolved for every entry */
+		start = k_cycle_get_32();
+		for (int j = 0; j < BENCH_SERIES_ENTRIES; j++) {
+			zassert_ok(sensor_column_decode(&buf, type, &entry.column, entry.value));
+		}
+		per_entry += k_cycle_get_32() - start;
+
+		net_buf_simple_init_with_data(&buf, data, BENCH_SERIES_ENTRIES * codec.entry_len);
+
+		/* Formats resolved once per message */
+		start = k_cycle_get_32();
+		sensor_codec_init(&codec, type);
+		for (int j = 0; j < BENCH_SERIES_ENTRIES; j++) {
+			zassert_ok(sensor_codec_entry_decode(&codec, &buf, &entry));
+		}
+		codec_cycles += k_cycle_get_32() - start;
+	}
+
+	bench_print("Per entry series decode", BENCH_ROUNDS * BENCH_SERIES_ENTRIES, per_entry);
+	bench_print("Codec series decode", BENCH_ROUNDS * BENCH_SERIES_ENTRIES, codec_cycles);
+}
+
+ZTEST_SUITE(sensor_subsys_benchmark, NULL, NULL, NULL, NULL, NULL);
@@ -0,0 +1,128 @@
+/*
+ * Copyright (c) 2024 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#include <string.h>
+#include <zephyr/ztest.h>
+#include <bluetooth/mesh/sensor_types.h>
+#include <sensor.h> // private header from the source folder
+
+ZTEST(sensor_codec_test, test_type_get)
+{
+	const struct bt_mesh_sensor_type *prev = NULL;
+
+	STRUCT_SECTION_FOREACH(bt_mesh_sensor_type, type) {
+		/* The section is sorted by ID for the lookup */
+		if (prev) {
+			zassert_true(prev->id < type->id, "0x%04x before 0x%04x",
+				     prev->id, type->id);
+		}
+
+		zassert_equal_ptr(bt_mesh_sensor_type_get(type->id), type,
+				  "Lookup of 0x%04x failed", type->id);
+		prev = type;
+	}
+
+	zassert_is_null(bt_mesh_sensor_type_get(0x0000));
+	zassert_is_null(bt_mesh_sensor_type_get(0xffff));
+}
+
+ZTEST(sensor_codec_test, test_codec_entry_decode)
+{
+	struct bt_mesh_sensor_series_entry expected;
+	struct bt_mesh_sensor_series_entry entry;
+	struct sensor_codec codec;
+	uint8_t data[2 * (CONFIG_BT_MESH_SENSOR_CHANNELS_MAX + 2) *
+		     CONFIG_BT_MESH_SENSOR_CHANNEL_ENCODED_SIZE_MAX];
+	struct net_buf_simple ref_buf;
+	struct net_buf_simple buf;
+	int ref_err;
+	int err;
+
+	for (size_t i = 0; i < sizeof(data); i++) {
+		data[i] = i * 7;
+	}
+
+	/* The codec decodes series entries like the per value decoding does */
+	STRUCT_SECTION_FOREACH(bt_mesh_sensor_type, type) {
+		sensor_codec_init(&codec, type);
+		zassert_equal(codec.value_len, sensor_value_len(type));
+		zassert_equal_ptr(codec.col_format,
+				  bt_mesh_sensor_column_format_get(type));
+
+		net_buf_simple_init_with_data(&buf, data, 2 * codec.entry_len);
+		net_buf_simple_init_with_data(&ref_buf, data, 2 * codec.entry_len);
+
+		for (int i = 0; i < 2; i++) {
+			memset(&expected, 0, sizeof(expected));
+			memset(&entry, 0, sizeof(entry));
+
+			if (codec.col_format) {
+				ref_err = sensor_column_decode(&ref_buf, type, &expected.column,
+							       expected.value);
+			} else {
+				ref_err = sensor_value_decode(&ref_buf, type, expected.value);
+			}
+
+			err = sensor_codec_entry_decode(&codec, &buf, &entry);
+			zassert_equal(err, ref_err, "0x%04x: %d != %d", type->id, err, ref_err);
+			zassert_mem_equal(&entry, &expected, sizeof(entry), "0x%04x", type->id);
+			zassert_equal(buf.len, ref_buf.len);
+		}
+	}
+}
+
+ZTEST(sensor_codec_test, test_codec_value_decode_short)
+{
+	const struct bt_mesh_sensor_type *type =
+		&bt_mesh_sensor_rel_dev_runtime_in_a_generic_level_range;
+	sensor_value_type values[CONFIG_BT_MESH_SENSOR_CHANNELS_MAX];
+	uint8_t data[CONFIG_BT_MESH_SENSOR_CHANNELS_MAX *
+		     CONFIG_BT_MESH_SENSOR_CHANNEL_ENCODED_SIZE_MAX] = {0};
+	struct sensor_codec codec;
+	struct net_buf_simple buf;
+
+	sensor_codec_init(&codec, type);
+
+	net_buf_simple_init_with_data(&buf, data, codec.value_len - 1);
+	zassert_equal(sensor_codec_value_decode(&codec, &buf, values), -EMSGSIZE);
+	zassert_equal(buf.len, codec.value_len - 1, "Buffer pulled on error");
+}
+
+#ifndef CONFIG_BT_MESH_SENSOR_USE_LEGACY_SENSOR_VALUE
+ZTEST(sensor_codec_test, test_codec_value_decode_raw)
+{
+	const struct bt_mesh_sensor_type *type =
+		&bt_mesh_sensor_rel_dev_runtime_in_a_generic_level_range;
+	sensor_value_type values[CONFIG_BT_MESH_SENSOR_CHANNELS_MAX];
+	uint8_t data[CONFIG_BT_MESH_SENSOR_CHANNELS_MAX *
+		     CONFIG_BT_MESH_SENSOR_CHANNEL_ENCODED_SIZE_MAX];
+	struct sensor_codec codec;
+	struct net_buf_simple buf;
+	const uint8_t *raw = data;
+
+	for (size_t i = 0; i < sizeof(data); i++) {
+		data[i] = 0x10 + i;
+	}
+
+	sensor_codec_init(&codec, type);
+	zassert_true(codec.value_len <= sizeof(data));
+
+	/* The value is pulled at once and split between the channels */
+	net_buf_simple_init_with_data(&buf, data, codec.value_len);
+	zassert_ok(sensor_codec_value_decode(&codec, &buf, values));
+	zassert_equal(buf.len, 0);
+
+	for (uint32_t i = 0; i < type->channel_count; i++) {
+		const struct bt_mesh_sensor_format *format = type->channels[i].format;
+
+		zassert_equal_ptr(values[i].format, format, "Channel %u format", i);
+		zassert_mem_equal(values[i].raw, raw, format->size, "Channel %u value", i);
+		raw += format->size;
+	}
+}
+#endif /* !CONFIG_BT_MESH_SENSOR_USE_LEGACY_SENSOR_VALUE */
+
+ZTEST_SUITE(sensor_codec_test, NULL, NULL, NULL, NULL, NULL);
@@ -0,0 +1,95 @@
+/*
+ * Copyright (c) 2024 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#ifndef NRF_RPC_CBOR_MOCK_H_
+#define NRF_RPC_CBOR_MOCK_H_
+
+/* Loopback replacement of the nRF RPC CBOR API. Commands are decoded and
+ * handled on the calling thread, as if the remote core received them.
+ */
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include <zcbor_common.h>
+#include <zcbor_decode.h>
+#include <zcbor_encode.h>
+
+#define NRF_RPC_ZCBOR_STATES 2
+
+#define NRF_RPC_ID_UNKNOWN 0xFF
+
+enum nrf_rpc_packet_type {
+	NRF_RPC_PACKET_TYPE_EVT = 0x00,
+	NRF_RPC_PACKET_TYPE_RSP = 0x01,
+	NRF_RPC_PACKET_TYPE_CMD = 0x04,
+};
+
+enum nrf_rpc_err_src {
+	NRF_RPC_ERR_SRC_RECV,
+	NRF_RPC_ERR_SRC_SEND,
+};
+
+struct nrf_rpc_group {
+	const char *strid;
+};
+
+struct nrf_rpc_cbor_ctx {
+	zcbor_state_t zs[NRF_RPC_ZCBOR_STATES];
+	union {
+		uint8_t *out_packet;
+		const uint8_t *in_packet;
+	};
+};
+
+typedef void (*nrf_rpc_cbor_handler_t)(const struct nrf_rpc_group *group,
+				       struct nrf_rpc_cbor_ctx *ctx, void *handler_data);
+
+struct nrf_rpc_mock_decoder {
+	uint8_t id;
+	nrf_rpc_cbor_handler_t handler;
+	void *handler_data;
+};
+
+#define NRF_RPC_GROUP_DECLARE(_name) extern const struct nrf_rpc_group _name
+
+#define NRF_RPC_CBOR_CMD_DECODER(_group, _name, _cmd, _handler, _data)	\
+	const struct nrf_rpc_mock_decoder nrf_rpc_mock_decoder_##_name = {	\
+		.id = _cmd,							\
+		.handler = _handler,						\
+		.handler_data = _data,						\
+	}
+
+#define NRF_RPC_CBOR_ALLOC(_group, _ctx, _len) nrf_rpc_mock_alloc(&(_ctx), (_len))
+
+void nrf_rpc_mock_alloc(struct nrf_rpc_cbor_ctx *ctx, size_t len);
+
+void nrf_rpc_cbor_cmd_no_err(const struct nrf_rpc_group *group, uint8_t cmd,
+			     struct nrf_rpc_cbor_ctx *ctx, nrf_rpc_cbor_handler_t handler,
+			     void *handler_data);
+
+void nrf_rpc_cbor_rsp_no_err(const struct nrf_rpc_group *group, struct nrf_rpc_cbor_ctx *ctx);
+
+void nrf_rpc_cbor_decoding_done(const struct nrf_rpc_group *group, struct nrf_rpc_cbor_ctx *ctx);
+
+void nrf_rpc_err(int code, enum nrf_rpc_err_src src, const struct nrf_rpc_group *group,
+		 uint8_t id, uint8_t packet_type);
+
+/**
+ * @brief Reset the loopback statistics and set the simulated transfer latency.
+ *
+ * @param latency_us Time spent in each command round trip, in microseconds.
+ */
+void nrf_rpc_mock_reset(uint32_t latency_us);
+
+/** @brief Number of commands sent since the last reset. */
+uint32_t nrf_rpc_mock_cmd_cnt(void);
+
+/** @brief Number of errors reported since the last reset. */
+uint32_t nrf_rpc_mock_err_cnt(void);
+
+#endif /* NRF_RPC_CBOR_MOCK_H_ */
@@ -0,0 +1,139 @@
+/*
+ * Copyright (c) 2024 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/logging/log.h>
+
+#include <nrf_rpc_cbor.h>
+#include <cbkproxy.h>
+
+LOG_MODULE_REGISTER(BT_RPC, CONFIG_BT_RPC_LOG_LEVEL);
+
+#define PACKET_SIZE 2048
+/* One command and its response may be in flight at the same time */
+#define PACKET_CNT  2
+
+const struct nrf_rpc_group bt_rpc_grp = {
+	.strid = "bt_rpc",
+};
+
+extern const struct nrf_rpc_mock_decoder nrf_rpc_mock_decoder_bt_rpc_batch;
+extern const struct nrf_rpc_mock_decoder nrf_rpc_mock_decoder_bt_gatt_notify_cb;
+extern const struct nrf_rpc_mock_decoder nrf_rpc_mock_decoder_bt_le_ext_adv_start;
+extern const struct nrf_rpc_mock_decoder nrf_rpc_mock_decoder_bt_le_ext_adv_delete;
+
+static const struct nrf_rpc_mock_decoder *const decoders[] = {
+	&nrf_rpc_mock_decoder_bt_rpc_batch,
+	&nrf_rpc_mock_decoder_bt_gatt_notify_cb,
+	&nrf_rpc_mock_decoder_bt_le_ext_adv_start,
+	&nrf_rpc_mock_decoder_bt_le_ext_adv_delete,
+};
+
+static uint8_t packets[PACKET_CNT][PACKET_SIZE];
+static size_t packet_used;
+static const uint8_t *rsp_packet;
+static size_t rsp_len;
+static uint32_t latency_us;
+static uint32_t cmd_cnt;
+static uint32_t err_cnt;
+
+void nrf_rpc_mock_alloc(struct nrf_rpc_cbor_ctx *ctx, size_t len)
+{
+	__ASSERT(packet_used < PACKET_CNT, "Too many packets allocated");
+	__ASSERT(len <= PACKET_SIZE, "Packet too large: %zu", len);
+
+	ctx->out_packet = packets[packet_used++];
+	zcbor_new_encode_state(ctx->zs, ARRAY_SIZE(ctx->zs), ctx->out_packet, len, 0);
+}
+
+static const struct nrf_rpc_mock_decoder *decoder_get(uint8_t cmd)
+{
+	for (size_t i = 0; i < ARRAY_SIZE(decoders); i++) {
+		if (decoders[i]->id == cmd) {
+			return decoders[i];
+		}
+	}
+
+	return NULL;
+}
+
+static void decode_state_init(struct nrf_rpc_cbor_ctx *ctx, const uint8_t *packet, size_t len)
+{
+	ctx->in_packet = packet;
+	zcbor_new_decode_state(ctx->zs, ARRAY_SIZE(ctx->zs), packet, len, SIZE_MAX);
+}
+
+void nrf_rpc_cbor_cmd_no_err(const struct nrf_rpc_group *group, uint8_t cmd,
+			     struct nrf_rpc_cbor_ctx *ctx, nrf_rpc_cbor_handler_t handler,
+			     void *handler_data)
+{
+	const struct nrf_rpc_mock_decoder *decoder = decoder_get(cmd);
+	struct nrf_rpc_cbor_ctx rx_ctx;
+
+	__ASSERT(decoder, "No decoder for command %u", cmd);
+
+	cmd_cnt++;
+	rsp_packet = NULL;
+
+	/* Simulated IPC round trip */
+	k_busy_wait(latency_us);
+
+	decode_state_init(&rx_ctx, ctx->out_packet, ctx->zs->payload_mut - ctx->out_packet);
+	decoder->handler(group, &rx_ctx, decoder->handler_data);
+
+	if (rsp_packet) {
+		decode_state_init(&rx_ctx, rsp_packet, rsp_len);
+		handler(group, &rx_ctx, handler_data);
+	}
+
+	packet_used = 0;
+}
+
+void nrf_rpc_cbor_rsp_no_err(const struct nrf_rpc_group *group, struct nrf_rpc_cbor_ctx *ctx)
+{
+	rsp_packet = ctx->out_packet;
+	rsp_len = ctx->zs->payload_mut - ctx->out_packet;
+}
+
+void nrf_rpc_cbor_decoding_done(const struct nrf_rpc_group *group, struct nrf_rpc_cbor_ctx *ctx)
+{
+	ARG_UNUSED(group);
+	ARG_UNUSED(ctx);
+}
+
+void nrf_rpc_err(int code, enum nrf_rpc_err_src src, const struct nrf_rpc_group *group,
+		 uint8_t id, uint8_t packet_type)
+{
+	err_cnt++;
+}
+
+void nrf_rpc_mock_reset(uint32_t latency)
+{
+	latency_us = latency;
+	cmd_cnt = 0;
+	err_cnt = 0;
+}
+
+uint32_t nrf_rpc_mock_cmd_cnt(void)
+{
+	return cmd_cnt;
+}
+
+uint32_t nrf_rpc_mock_err_cnt(void)
+{
+	return err_cnt;
+}
+
+/* No callbacks are passed in the test */
+void *cbkproxy_out_get(int index, void *handler)
+{
+	return NULL;
+}
+
+int cbkproxy_in_set(void *callback)
+{
+	return -1;
+}
@@ -0,0 +1,60 @@
+/*
+ * Copyright (c) 2024 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#include <zephyr/kernel.h>
+#include <bt_rpc.h>
+#include <nrf_rpc_cbor.h>
+
+#include "bt_rpc_common.h"
+#include "bt_rpc_batch.h"
+#include "serialize.h"
+#include "adv.h"
+
+/* Maximum encoded size of the set index and of the data header */
+#define ADV_HEADER_SIZE_MAX 5
+
+int adv_set_data(uint8_t adv, const uint8_t *data, size_t len)
+{
+	struct nrf_rpc_cbor_ctx ctx;
+	int err;
+
+	err = bt_rpc_batch_alloc(&ctx, BT_LE_EXT_ADV_SET_DATA_RPC_CMD, ADV_HEADER_SIZE_MAX + len);
+	if (err) {
+		return err;
+	}
+
+	ser_encode_uint(&ctx, adv);
+	ser_encode_buffer(&ctx, data, len);
+
+	return bt_rpc_batch_commit(&ctx);
+}
+
+static int adv_cmd(uint8_t cmd, uint8_t adv)
+{
+	struct nrf_rpc_cbor_ctx ctx;
+	int result;
+
+	if (IS_ENABLED(CONFIG_BT_RPC_BATCH)) {
+		(void)bt_rpc_batch_flush();
+	}
+
+	NRF_RPC_CBOR_ALLOC(&bt_rpc_grp, ctx, ADV_HEADER_SIZE_MAX);
+	ser_encode_uint(&ctx, adv);
+
+	nrf_rpc_cbor_cmd_no_err(&bt_rpc_grp, cmd, &ctx, ser_rsp_decode_i32, &result);
+
+	return result;
+}
+
+int adv_start(uint8_t adv)
+{
+	return adv_cmd(BT_LE_EXT_ADV_START_RPC_CMD, adv);
+}
+
+int adv_delete(uint8_t adv)
+{
+	return adv_cmd(BT_LE_EXT_ADV_DELETE_RPC_CMD, adv);
+}
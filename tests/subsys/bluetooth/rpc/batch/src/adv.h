@@ -0,0 +1,53 @@
+/*
+ * Copyright (c) 2024 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#ifndef TEST_ADV_H_
+#define TEST_ADV_H_
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+/* The advertising layer is not part of the test. An advertising set is identified
+ * by its index, and its data is encoded as a byte string. The client functions send
+ * the commands the same way as bt_le_ext_adv_set_data(), bt_le_ext_adv_start() and
+ * bt_le_ext_adv_delete().
+ */
+
+#define ADV_SET_CNT 4
+
+enum adv_host_op {
+	ADV_HOST_OP_SET_DATA,
+	ADV_HOST_OP_START,
+	ADV_HOST_OP_DELETE,
+};
+
+/** @brief Add an advertising data update to the batch. */
+int adv_set_data(uint8_t adv, const uint8_t *data, size_t len);
+
+/** @brief Start advertising with its own command and wait for the result. */
+int adv_start(uint8_t adv);
+
+/** @brief Delete the advertising set with its own command and wait for the result. */
+int adv_delete(uint8_t adv);
+
+/** @brief Reset the operations received by the host and create all advertising sets. */
+void adv_host_reset(void);
+
+/** @brief Number of operations received by the host. */
+uint32_t adv_host_op_cnt(void);
+
+/**
+ * @brief Operation received by the host.
+ *
+ * @param index Index of the operation, in the order of execution.
+ */
+enum adv_host_op adv_host_op_get(uint32_t index);
+
+/** @brief Whether the host applied data to the advertising set before it was started. */
+bool adv_host_data_applied(uint8_t adv);
+
+#endif /* TEST_ADV_H_ */
@@ -0,0 +1,143 @@
+/*
+ * Copyright (c) 2024 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#include <errno.h>
+#include <stdbool.h>
+
+#include <zephyr/kernel.h>
+#include <nrf_rpc_cbor.h>
+
+#include "bt_rpc_common.h"
+#include "bt_rpc_batch.h"
+#include "serialize.h"
+#include "adv.h"
+
+/* Host side of the loopback, built with CONFIG_BT_RPC_HOST */
+
+#define ADV_DATA_MAX 31
+#define ADV_OP_MAX   16
+
+static bool host_created[ADV_SET_CNT];
+static bool host_has_data[ADV_SET_CNT];
+static bool host_data_applied[ADV_SET_CNT];
+static enum adv_host_op host_ops[ADV_OP_MAX];
+static uint32_t host_op_cnt;
+
+static void host_op_add(enum adv_host_op op)
+{
+	if (host_op_cnt < ADV_OP_MAX) {
+		host_ops[host_op_cnt] = op;
+	}
+
+	host_op_cnt++;
+}
+
+/* Returns the advertising set, or NULL if it does not exist on the host. */
+static bool *host_set_get(struct nrf_rpc_cbor_ctx *ctx, uint8_t *adv)
+{
+	*adv = ser_decode_uint(ctx);
+
+	if (!ser_decode_valid(ctx) || *adv >= ADV_SET_CNT || !host_created[*adv]) {
+		return NULL;
+	}
+
+	return &host_created[*adv];
+}
+
+int bt_rpc_batch_le_ext_adv_set_data(struct nrf_rpc_cbor_ctx *ctx)
+{
+	uint8_t data[ADV_DATA_MAX];
+	uint8_t adv;
+	bool *set = host_set_get(ctx, &adv);
+
+	ser_decode_buffer(ctx, data, sizeof(data));
+
+	if (!ser_decode_valid(ctx)) {
+		return -EBADMSG;
+	}
+
+	host_op_add(ADV_HOST_OP_SET_DATA);
+
+	/* The set was deleted before its data was applied */
+	if (!set) {
+		return -EINVAL;
+	}
+
+	host_has_data[adv] = true;
+
+	return 0;
+}
+
+static void adv_cmd_handler(const struct nrf_rpc_group *group, struct nrf_rpc_cbor_ctx *ctx,
+			    enum adv_host_op op, uint8_t cmd)
+{
+	uint8_t adv;
+	bool *set = host_set_get(ctx, &adv);
+	int result = 0;
+
+	if (!ser_decoding_done_and_check(group, ctx)) {
+		nrf_rpc_err(-EBADMSG, NRF_RPC_ERR_SRC_RECV, group, cmd, NRF_RPC_PACKET_TYPE_CMD);
+		return;
+	}
+
+	host_op_add(op);
+
+	if (!set) {
+		result = -EINVAL;
+	} else if (op == ADV_HOST_OP_START) {
+		host_data_applied[adv] = host_has_data[adv];
+	} else {
+		*set = false;
+	}
+
+	ser_rsp_send_int(group, result);
+}
+
+static void bt_le_ext_adv_start_rpc_handler(const struct nrf_rpc_group *group,
+					    struct nrf_rpc_cbor_ctx *ctx, void *handler_data)
+{
+	adv_cmd_handler(group, ctx, ADV_HOST_OP_START, BT_LE_EXT_ADV_START_RPC_CMD);
+}
+
+NRF_RPC_CBOR_CMD_DECODER(bt_rpc_grp, bt_le_ext_adv_start, BT_LE_EXT_ADV_START_RPC_CMD,
+			 bt_le_ext_adv_start_rpc_handler, NULL);
+
+static void bt_le_ext_adv_delete_rpc_handler(const struct nrf_rpc_group *group,
+					     struct nrf_rpc_cbor_ctx *ctx, void *handler_data)
+{
+	adv_cmd_handler(group, ctx, ADV_HOST_OP_DELETE, BT_LE_EXT_ADV_DELETE_RPC_CMD);
+}
+
+NRF_RPC_CBOR_CMD_DECODER(bt_rpc_grp, bt_le_ext_adv_delete, BT_LE_EXT_ADV_DELETE_RPC_CMD,
+			 bt_le_ext_adv_delete_rpc_handler, NULL);
+
+void adv_host_reset(void)
+{
+	for (size_t i = 0; i < ADV_SET_CNT; i++) {
+		host_created[i] = true;
+		host_has_data[i] = false;
+		host_data_applied[i] = false;
+	}
+
+	host_op_cnt = 0;
+}
+
+uint32_t adv_host_op_cnt(void)
+{
+	return host_op_cnt;
+}
+
+enum adv_host_op adv_host_op_get(uint32_t index)
+{
+	__ASSERT_NO_MSG(index < MIN(host_op_cnt, ADV_OP_MAX));
+
+	return host_ops[index];
+}
+
+bool adv_host_data_applied(uint8_t adv)
+{
+	return host_data_applied[adv];
+}
@@ -0,0 +1,72 @@
+/*
+ * Copyright (c) 2024 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#include <zephyr/ztest.h>
+#include <zephyr/kernel.h>
+#include <bt_rpc.h>
+#include <nrf_rpc_cbor.h>
+#include "notify.h"
+
+#define BENCH_CALLS (1024)
+
+/* Round trip of a command over IPC between the nRF5340 cores, roughly */
+#define BENCH_IPC_LATENCY_US (40)
+
+/* Typical notification of a sensor */
+#define BENCH_VALUE_LEN (20)
+
+typedef int (*bench_notify_t)(uint16_t handle, const uint8_t *value, size_t len);
+
+static uint8_t bench_value[BENCH_VALUE_LEN];
+
+static void bench_run(const char *mode, bench_notify_t notify, uint32_t latency_us)
+{
+	uint32_t start;
+	uint32_t cycles;
+	uint64_t rate;
+
+	nrf_rpc_mock_reset(latency_us);
+	notify_host_reset(0);
+
+	start = k_cycle_get_32();
+	for (uint16_t handle = 1; handle <= BENCH_CALLS; handle++) {
+		zassert_ok(notify(handle, bench_value, sizeof(bench_value)));
+	}
+	zassert_ok(bt_rpc_batch_flush());
+	cycles = MAX(k_cycle_get_32() - start, 1);
+	rate = (uint64_t)BENCH_CALLS * sys_clock_hw_cycles_per_sec() / cycles;
+
+	zassert_equal(notify_host_cnt(), BENCH_CALLS);
+	zassert_true(notify_host_in_order());
+
+	TC_PRINT("%s, %u us latency: %u transfers, %u cycles per call, %llu calls/s\n", mode,
+		 latency_us, nrf_rpc_mock_cmd_cnt(), cycles / BENCH_CALLS,
+		 (unsigned long long)rate);
+}
+
+ZTEST(bt_rpc_batch_benchmark, test_benchmark_single)
+{
+	/* Cost of the serialization itself */
+	bench_run("single", notify_single, 0);
+	bench_run("single", notify_single, BENCH_IPC_LATENCY_US);
+}
+
+ZTEST(bt_rpc_batch_benchmark, test_benchmark_batched)
+{
+	bench_run("batched", notify_batched, 0);
+	bench_run("batched", notify_batched, BENCH_IPC_LATENCY_US);
+}
+
+static void *benchmark_setup(void)
+{
+	for (size_t i = 0; i < sizeof(bench_value); i++) {
+		bench_value[i] = i;
+	}
+
+	return NULL;
+}
+
+ZTEST_SUITE(bt_rpc_batch_benchmark, NULL, benchmark_setup, NULL, NULL, NULL);
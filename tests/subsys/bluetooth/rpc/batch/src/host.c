@@ -0,0 +1,93 @@
+/*
+ * Copyright (c) 2024 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#include <errno.h>
+#include <stdbool.h>
+
+#include <nrf_rpc_cbor.h>
+
+#include "bt_rpc_common.h"
+#include "bt_rpc_batch.h"
+#include "serialize.h"
+#include "notify.h"
+
+/* Host side of the loopback, built with CONFIG_BT_RPC_HOST */
+
+#define NOTIFY_VALUE_MAX 64
+
+static uint16_t host_fail_handle;
+static uint16_t host_last_handle;
+static uint32_t host_cnt;
+static bool host_in_order;
+
+static int host_notify(struct nrf_rpc_cbor_ctx *ctx)
+{
+	uint8_t value[NOTIFY_VALUE_MAX];
+	uint16_t handle;
+
+	handle = ser_decode_uint(ctx);
+	ser_decode_buffer(ctx, value, sizeof(value));
+
+	if (!ser_decode_valid(ctx)) {
+		return -EBADMSG;
+	}
+
+	if (handle <= host_last_handle) {
+		host_in_order = false;
+	}
+
+	host_last_handle = handle;
+	host_cnt++;
+
+	return (handle == host_fail_handle) ? -ENOTCONN : 0;
+}
+
+static void bt_gatt_notify_cb_rpc_handler(const struct nrf_rpc_group *group,
+					  struct nrf_rpc_cbor_ctx *ctx, void *handler_data)
+{
+	int result;
+
+	result = host_notify(ctx);
+
+	if (!ser_decoding_done_and_check(group, ctx)) {
+		nrf_rpc_err(-EBADMSG, NRF_RPC_ERR_SRC_RECV, group, BT_GATT_NOTIFY_CB_RPC_CMD,
+			    NRF_RPC_PACKET_TYPE_CMD);
+		return;
+	}
+
+	ser_rsp_send_int(group, result);
+}
+
+NRF_RPC_CBOR_CMD_DECODER(bt_rpc_grp, bt_gatt_notify_cb, BT_GATT_NOTIFY_CB_RPC_CMD,
+			 bt_gatt_notify_cb_rpc_handler, NULL);
+
+int bt_rpc_batch_gatt_notify_cb(struct nrf_rpc_cbor_ctx *ctx)
+{
+	return host_notify(ctx);
+}
+
+void notify_host_reset(uint16_t fail_handle)
+{
+	host_fail_handle = fail_handle;
+	host_last_handle = 0;
+	host_cnt = 0;
+	host_in_order = true;
+}
+
+uint32_t notify_host_cnt(void)
+{
+	return host_cnt;
+}
+
+uint16_t notify_host_last_handle(void)
+{
+	return host_last_handle;
+}
+
+bool notify_host_in_order(void)
+{
+	return host_in_order;
+}
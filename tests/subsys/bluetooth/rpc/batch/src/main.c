@@ -0,0 +1,163 @@
+/*
+ * Copyright (c) 2024 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#include <zephyr/ztest.h>
+#include <zephyr/kernel.h>
+#include <bt_rpc.h>
+#include <nrf_rpc_cbor.h>
+#include "notify.h"
+#include "adv.h"
+
+static const uint8_t value[20] = { 0xde, 0xad, 0xbe, 0xef };
+
+ZTEST(bt_rpc_batch, test_single)
+{
+	zassert_ok(notify_single(1, value, sizeof(value)));
+	zassert_equal(notify_single(2, value, sizeof(value)), -ENOTCONN);
+
+	zassert_equal(nrf_rpc_mock_cmd_cnt(), 2);
+	zassert_equal(notify_host_cnt(), 2);
+}
+
+ZTEST(bt_rpc_batch, test_flush)
+{
+	const uint16_t cnt = CONFIG_BT_RPC_BATCH_MAX_CALLS - 1;
+
+	for (uint16_t handle = 1; handle <= cnt; handle++) {
+		zassert_ok(notify_batched(handle, value, sizeof(value)));
+	}
+
+	zassert_equal(nrf_rpc_mock_cmd_cnt(), 0, "Batch sent before it is full");
+
+	zassert_ok(bt_rpc_batch_flush());
+	zassert_equal(nrf_rpc_mock_cmd_cnt(), 1);
+	zassert_equal(notify_host_cnt(), cnt);
+	zassert_true(notify_host_in_order());
+
+	/* Nothing left to send */
+	zassert_ok(bt_rpc_batch_flush());
+	zassert_equal(nrf_rpc_mock_cmd_cnt(), 1);
+}
+
+ZTEST(bt_rpc_batch, test_max_calls)
+{
+	const uint16_t cnt = 2 * CONFIG_BT_RPC_BATCH_MAX_CALLS;
+
+	for (uint16_t handle = 1; handle <= cnt; handle++) {
+		zassert_ok(notify_batched(handle, value, sizeof(value)));
+	}
+
+	zassert_equal(nrf_rpc_mock_cmd_cnt(), 2);
+	zassert_equal(notify_host_cnt(), cnt);
+	zassert_true(notify_host_in_order());
+}
+
+ZTEST(bt_rpc_batch, test_buf_full)
+{
+	static const uint8_t large_value[CONFIG_BT_RPC_BATCH_BUF_SIZE / 3];
+
+	zassert_ok(notify_batched(1, large_value, sizeof(large_value)));
+	zassert_ok(notify_batched(2, large_value, sizeof(large_value)));
+	zassert_equal(nrf_rpc_mock_cmd_cnt(), 0);
+
+	/* Does not fit next to the first two calls */
+	zassert_ok(notify_batched(3, large_value, sizeof(large_value)));
+	zassert_equal(nrf_rpc_mock_cmd_cnt(), 1);
+	zassert_equal(notify_host_cnt(), 2);
+
+	zassert_ok(bt_rpc_batch_flush());
+	zassert_equal(notify_host_cnt(), 3);
+	zassert_true(notify_host_in_order());
+}
+
+ZTEST(bt_rpc_batch, test_too_large)
+{
+	static const uint8_t large_value[CONFIG_BT_RPC_BATCH_BUF_SIZE];
+
+	zassert_equal(notify_batched(1, large_value, sizeof(large_value)), -ENOMEM);
+	zassert_equal(nrf_rpc_mock_cmd_cnt(), 0);
+
+	/* The pending batch is sent before the call that is sent on its own */
+	zassert_ok(notify_batched(1, value, sizeof(value)));
+	zassert_equal(notify_batched(2, large_value, sizeof(large_value)), -ENOMEM);
+	zassert_equal(nrf_rpc_mock_cmd_cnt(), 1);
+	zassert_equal(notify_host_cnt(), 1);
+}
+
+ZTEST(bt_rpc_batch, test_adv_set_data_then_delete)
+{
+	static const uint8_t data[] = { 0x02, 0x01, 0x06 };
+
+	zassert_ok(adv_set_data(0, data, sizeof(data)));
+	zassert_ok(adv_set_data(1, data, sizeof(data)));
+	zassert_equal(nrf_rpc_mock_cmd_cnt(), 0);
+
+	/* The queued data updates reach the host before the set is deleted */
+	zassert_ok(adv_delete(1));
+	zassert_equal(nrf_rpc_mock_cmd_cnt(), 2);
+	zassert_equal(adv_host_op_cnt(), 3);
+	zassert_equal(adv_host_op_get(0), ADV_HOST_OP_SET_DATA);
+	zassert_equal(adv_host_op_get(1), ADV_HOST_OP_SET_DATA);
+	zassert_equal(adv_host_op_get(2), ADV_HOST_OP_DELETE);
+
+	zassert_ok(bt_rpc_batch_flush());
+	zassert_equal(nrf_rpc_mock_err_cnt(), 0);
+}
+
+ZTEST(bt_rpc_batch, test_adv_set_data_then_start)
+{
+	static const uint8_t data[] = { 0x02, 0x01, 0x06 };
+
+	zassert_ok(adv_set_data(2, data, sizeof(data)));
+	zassert_ok(notify_batched(1, value, sizeof(value)));
+
+	/* Advertising starts with its data applied */
+	zassert_ok(adv_start(2));
+	zassert_true(adv_host_data_applied(2));
+	zassert_equal(adv_host_op_cnt(), 2);
+	zassert_equal(adv_host_op_get(0), ADV_HOST_OP_SET_DATA);
+	zassert_equal(adv_host_op_get(1), ADV_HOST_OP_START);
+
+	/* The queued notification did not get overtaken either */
+	zassert_equal(notify_host_cnt(), 1);
+}
+
+ZTEST(bt_rpc_batch, test_timeout)
+{
+	zassert_ok(notify_batched(1, value, sizeof(value)));
+	zassert_equal(nrf_rpc_mock_cmd_cnt(), 0);
+
+	k_sleep(K_MSEC(2 * CONFIG_BT_RPC_BATCH_TIMEOUT_MS));
+
+	zassert_equal(nrf_rpc_mock_cmd_cnt(), 1);
+	zassert_equal(notify_host_cnt(), 1);
+}
+
+ZTEST(bt_rpc_batch, test_error)
+{
+	for (uint16_t handle = 1; handle <= 4; handle++) {
+		zassert_ok(notify_batched(handle, value, sizeof(value)));
+	}
+
+	/* The calls following the failed one are still executed */
+	zassert_equal(bt_rpc_batch_flush(), -ENOTCONN);
+	zassert_equal(notify_host_cnt(), 4);
+	zassert_equal(notify_host_last_handle(), 4);
+	zassert_equal(nrf_rpc_mock_err_cnt(), 0);
+}
+
+static void batch_before(void *fixture)
+{
+	ARG_UNUSED(fixture);
+
+	(void)bt_rpc_batch_flush();
+
+	nrf_rpc_mock_reset(0);
+	notify_host_reset(2);
+	adv_host_reset();
+}
+
+ZTEST_SUITE(bt_rpc_batch, NULL, NULL, batch_before, NULL, NULL);
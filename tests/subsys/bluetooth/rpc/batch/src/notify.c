@@ -0,0 +1,46 @@
+/*
+ * Copyright (c) 2024 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#include <nrf_rpc_cbor.h>
+
+#include "bt_rpc_common.h"
+#include "bt_rpc_batch.h"
+#include "serialize.h"
+#include "notify.h"
+
+/* Maximum encoded size of the handle and of the value header */
+#define NOTIFY_HEADER_SIZE_MAX 5
+
+int notify_single(uint16_t handle, const uint8_t *value, size_t len)
+{
+	struct nrf_rpc_cbor_ctx ctx;
+	int result;
+
+	NRF_RPC_CBOR_ALLOC(&bt_rpc_grp, ctx, NOTIFY_HEADER_SIZE_MAX + len);
+	ser_encode_uint(&ctx, handle);
+	ser_encode_buffer(&ctx, value, len);
+
+	nrf_rpc_cbor_cmd_no_err(&bt_rpc_grp, BT_GATT_NOTIFY_CB_RPC_CMD,
+				&ctx, ser_rsp_decode_i32, &result);
+
+	return result;
+}
+
+int notify_batched(uint16_t handle, const uint8_t *value, size_t len)
+{
+	struct nrf_rpc_cbor_ctx ctx;
+	int err;
+
+	err = bt_rpc_batch_alloc(&ctx, BT_GATT_NOTIFY_CB_RPC_CMD, NOTIFY_HEADER_SIZE_MAX + len);
+	if (err) {
+		return err;
+	}
+
+	ser_encode_uint(&ctx, handle);
+	ser_encode_buffer(&ctx, value, len);
+
+	return bt_rpc_batch_commit(&ctx);
+}
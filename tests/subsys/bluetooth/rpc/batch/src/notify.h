@@ -0,0 +1,40 @@
+/*
+ * Copyright (c) 2024 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#ifndef TEST_NOTIFY_H_
+#define TEST_NOTIFY_H_
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+/* The GATT layer is not part of the test. A notification is encoded as
+ * its attribute handle, followed by its value.
+ */
+
+/** @brief Send a notification with its own command and wait for the result. */
+int notify_single(uint16_t handle, const uint8_t *value, size_t len);
+
+/** @brief Add a notification to the batch. */
+int notify_batched(uint16_t handle, const uint8_t *value, size_t len);
+
+/**
+ * @brief Reset the notifications received by the host.
+ *
+ * @param fail_handle Handle of the notifications that the host fails, or 0.
+ */
+void notify_host_reset(uint16_t fail_handle);
+
+/** @brief Number of notifications received by the host. */
+uint32_t notify_host_cnt(void);
+
+/** @brief Handle of the last notification received by the host. */
+uint16_t notify_host_last_handle(void);
+
+/** @brief Whether the host received the notifications in increasing handle order. */
+bool notify_host_in_order(void);
+
+#endif /* TEST_NOTIFY_H_ */
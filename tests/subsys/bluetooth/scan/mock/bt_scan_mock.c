@@ -0,0 +1,73 @@
+/*
+ * Copyright (c) 2024 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#include <zephyr/ztest.h>
+#include <zephyr/bluetooth/bluetooth.h>
+#include "bt_scan_mock.h"
+
+static struct bt_le_scan_cb *scan_cb;
+
+void bt_le_scan_cb_register(struct bt_le_scan_cb *cb)
+{
+	scan_cb = cb;
+}
+
+int bt_le_scan_start(const struct bt_le_scan_param *param, bt_le_scan_cb_t cb)
+{
+	return 0;
+}
+
+int bt_le_scan_stop(void)
+{
+	return 0;
+}
+
+/* Same parser as the one of the host */
+void bt_data_parse(struct net_buf_simple *ad,
+		   bool (*func)(struct bt_data *data, void *user_data),
+		   void *user_data)
+{
+	while (ad->len > 1) {
+		struct bt_data data;
+		uint8_t len;
+
+		len = net_buf_simple_pull_u8(ad);
+		if (len == 0U) {
+			/* Early termination */
+			return;
+		}
+
+		if (len > ad->len) {
+			return;
+		}
+
+		data.type = net_buf_simple_pull_u8(ad);
+		data.data_len = len - 1;
+		data.data = ad->data;
+
+		if (!func(&data, user_data)) {
+			return;
+		}
+
+		net_buf_simple_pull(ad, len - 1);
+	}
+}
+
+void bt_scan_mock_report(const bt_addr_le_t *addr, const uint8_t *ad, size_t ad_len)
+{
+	struct bt_le_scan_recv_info info = {
+		.addr = addr,
+		.adv_type = BT_GAP_ADV_TYPE_ADV_IND,
+		.adv_props = BT_GAP_ADV_PROP_CONNECTABLE | BT_GAP_ADV_PROP_SCANNABLE,
+		.rssi = -60,
+	};
+	struct net_buf_simple buf;
+
+	zassert_not_null(scan_cb, "The scanning module is not initialized");
+
+	net_buf_simple_init_with_data(&buf, (void *)ad, ad_len);
+	scan_cb->recv(&info, &buf);
+}
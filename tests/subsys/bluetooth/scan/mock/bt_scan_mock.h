@@ -0,0 +1,24 @@
+/*
+ * Copyright (c) 2024 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#ifndef BT_SCAN_MOCK_H_
+#define BT_SCAN_MOCK_H_
+
+#include <zephyr/bluetooth/bluetooth.h>
+
+/**
+ * @brief Pass an advertising report to the scanning module.
+ *
+ * The report is given to the callback the scanning module registered
+ * with @em bt_le_scan_cb_register, as if the host received it.
+ *
+ * @param addr    Advertiser address.
+ * @param ad      Advertising data.
+ * @param ad_len  Length of the advertising data.
+ */
+void bt_scan_mock_report(const bt_addr_le_t *addr, const uint8_t *ad, size_t ad_len);
+
+#endif /* BT_SCAN_MOCK_H_ */
@@ -0,0 +1,217 @@
+/*
+ * Copyright (c) 2024 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#include <zephyr/ztest.h>
+#include <zephyr/kernel.h>
+#include <zephyr/sys/byteorder.h>
+#include <zephyr/bluetooth/bluetooth.h>
+#include <zephyr/bluetooth/uuid.h>
+#include <bluetooth/scan.h>
+#include "../mock/bt_scan_mock.h"
+
+#define BENCH_REPORTS      (2048)
+#define BENCH_REPORT_TYPES (64)
+#define BENCH_ADDR_FILTERS (32)
+#define BENCH_UUID_FILTERS (8)
+
+/* Filtered UUIDs are taken from the range of 16-bit UUIDs for members */
+#define BENCH_UUID_FILTER_BASE 0xfe00
+
+BUILD_ASSERT(BENCH_REPORTS % BENCH_REPORT_TYPES == 0);
+
+struct bench_report {
+	bt_addr_le_t addr;
+	uint8_t ad[BT_GAP_ADV_MAX_ADV_DATA_LEN];
+	uint8_t ad_len;
+};
+
+static struct bench_report reports[BENCH_REPORT_TYPES];
+static bt_addr_le_t filter_addrs[BENCH_ADDR_FILTERS];
+static struct bt_uuid_16 filter_uuids[BENCH_UUID_FILTERS];
+static uint32_t rand_state;
+static int bench_match_cnt;
+
+static void bench_filter_match(struct bt_scan_device_info *device_info,
+			       struct bt_scan_filter_match *filter_match,
+			       bool connectable)
+{
+	bench_match_cnt++;
+}
+
+BT_SCAN_CB_INIT(bench_cb, bench_filter_match, NULL, NULL, NULL);
+
+static uint32_t bench_rand(void)
+{
+	/* xorshift32 */
+	rand_state ^= rand_state << 13;
+	rand_state ^= rand_state >> 17;
+	rand_state ^= rand_state << 5;
+
+	return rand_state;
+}
+
+static void bench_addr_make(bt_addr_le_t *addr)
+{
+	addr->type = BT_ADDR_LE_RANDOM;
+	sys_put_le32(bench_rand(), &addr->a.val[0]);
+	sys_put_le16(bench_rand(), &addr->a.val[4]);
+	addr->a.val[5] |= 0xc0;
+}
+
+static uint8_t *ad_put(uint8_t *p, uint8_t type, const void *data, uint8_t len)
+{
+	*p++ = len + 1;
+	*p++ = type;
+	memcpy(p, data, len);
+
+	return p + len;
+}
+
+/* Synthetic advertising reports, as sent by a crowd of sensors. Every 8th report comes
+ * from a filtered address, and every 16th one, offset by 4, advertises a filtered UUID.
+ * Every 16th report matches both the address and the UUID filters.
+ */
+static void reports_generate(void)
+{
+	for (size_t i = 0; i < ARRAY_SIZE(reports); i++) {
+		struct bench_report *report = &reports[i];
+		uint8_t flags = BT_LE_AD_GENERAL | BT_LE_AD_NO_BREDR;
+		uint8_t uuids[2 * sizeof(uint16_t)];
+		uint8_t manuf[6];
+		char name[12];
+		uint8_t *p = report->ad;
+
+		if (i % 8 == 0) {
+			bt_addr_le_copy(&report->addr, &filter_addrs[(i / 8) % BENCH_ADDR_FILTERS]);
+		} else {
+			bench_addr_make(&report->addr);
+		}
+
+		/* Two SIG assigned service UUIDs, none of them filtered */
+		sys_put_le16(0x1800 + bench_rand() % 0x40, &uuids[0]);
+		sys_put_le16(0x1800 + bench_rand() % 0x40, &uuids[2]);
+
+		if ((i % 16 == 0) || (i % 16 == 4)) {
+			sys_put_le16(filter_uuids[(i / 16) % BENCH_UUID_FILTERS].val, &uuids[2]);
+		}
+
+		snprintk(name, sizeof(name), "Sensor-%04x", (uint16_t)bench_rand());
+
+		sys_put_le16(0x0059, &manuf[0]);
+		sys_put_le32(bench_rand(), &manuf[2]);
+
+		p = ad_put(p, BT_DATA_FLAGS, &flags, sizeof(flags));
+		p = ad_put(p, BT_DATA_UUID16_SOME, uuids, sizeof(uuids));
+		p = ad_put(p, BT_DATA_NAME_COMPLETE, name, strlen(name));
+		p = ad_put(p, BT_DATA_MANUFACTURER_DATA, manuf, sizeof(manuf));
+
+		report->ad_len = p - report->ad;
+		__ASSERT_NO_MSG(report->ad_len <= sizeof(report->ad));
+	}
+}
+
+static void filters_add(uint8_t mode, bool match_all)
+{
+	for (size_t i = 0; i < ARRAY_SIZE(filter_addrs); i++) {
+		zassert_ok(bt_scan_filter_add(BT_SCAN_FILTER_TYPE_ADDR, &filter_addrs[i]));
+	}
+
+	for (size_t i = 0; i < ARRAY_SIZE(filter_uuids); i++) {
+		zassert_ok(bt_scan_filter_add(BT_SCAN_FILTER_TYPE_UUID, &filter_uuids[i]));
+	}
+
+	zassert_ok(bt_scan_filter_enable(mode, match_all));
+}
+
+static void bench_run(const char *scenario, int expected_match_cnt)
+{
+	uint32_t start;
+	uint32_t cycles;
+	uint64_t rate;
+
+	bench_match_cnt = 0;
+
+	start = k_cycle_get_32();
+	for (size_t i = 0; i < BENCH_REPORTS; i++) {
+		const struct bench_report *report = &reports[i % ARRAY_SIZE(reports)];
+
+		bt_scan_mock_report(&report->addr, report->ad, report->ad_len);
+	}
+	cycles = MAX(k_cycle_get_32() - start, 1);
+	rate = (uint64_t)BENCH_REPORTS * sys_clock_hw_cycles_per_sec() / cycles;
+
+	zassert_equal(bench_match_cnt, expected_match_cnt, "%s: %d matches, expected %d",
+		      scenario, bench_match_cnt, expected_match_cnt);
+
+	TC_PRINT("%s: %u cycles (%u us) per report, %llu reports/s\n", scenario,
+		 cycles / BENCH_REPORTS, k_cyc_to_us_floor32(cycles / BENCH_REPORTS),
+		 (unsigned long long)rate);
+}
+
+ZTEST(bt_scan_benchmark, test_benchmark_no_filter)
+{
+	/* Cost of the report processing itself */
+	bench_run("no filter", 0);
+}
+
+ZTEST(bt_scan_benchmark, test_benchmark_addr)
+{
+	filters_add(BT_SCAN_ADDR_FILTER, false);
+	bench_run("address", BENCH_REPORTS / 8);
+}
+
+ZTEST(bt_scan_benchmark, test_benchmark_uuid)
+{
+	filters_add(BT_SCAN_UUID_FILTER, false);
+	bench_run("UUID", BENCH_REPORTS / 8);
+}
+
+ZTEST(bt_scan_benchmark, test_benchmark_addr_or_uuid)
+{
+	filters_add(BT_SCAN_ADDR_FILTER | BT_SCAN_UUID_FILTER, false);
+	bench_run("address or UUID", BENCH_REPORTS / 8 + BENCH_REPORTS / 16);
+}
+
+ZTEST(bt_scan_benchmark, test_benchmark_addr_and_uuid)
+{
+	/* In the multifilter mode, all filtered UUIDs must be advertised,
+	 * so use a single filter of each type.
+	 */
+	zassert_ok(bt_scan_filter_add(BT_SCAN_FILTER_TYPE_ADDR, &filter_addrs[0]));
+	zassert_ok(bt_scan_filter_add(BT_SCAN_FILTER_TYPE_UUID, &filter_uuids[0]));
+	zassert_ok(bt_scan_filter_enable(BT_SCAN_ADDR_FILTER | BT_SCAN_UUID_FILTER, true));
+
+	bench_run("address and UUID", BENCH_REPORTS / BENCH_REPORT_TYPES);
+}
+
+static void *benchmark_setup(void)
+{
+	rand_state = 0x2545f491;
+
+	for (size_t i = 0; i < ARRAY_SIZE(filter_addrs); i++) {
+		bench_addr_make(&filter_addrs[i]);
+	}
+
+	for (size_t i = 0; i < ARRAY_SIZE(filter_uuids); i++) {
+		filter_uuids[i] = (struct bt_uuid_16)BT_UUID_INIT_16(BENCH_UUID_FILTER_BASE + i);
+	}
+
+	reports_generate();
+
+	bt_scan_cb_register(&bench_cb);
+
+	return NULL;
+}
+
+static void benchmark_before(void *fixture)
+{
+	ARG_UNUSED(fixture);
+
+	/* Remove the filters and reset their mode */
+	bt_scan_init(NULL);
+}
+
+ZTEST_SUITE(bt_scan_benchmark, NULL, benchmark_setup, benchmark_before, NULL, NULL);
@@ -0,0 +1,221 @@
+/*
+ * Copyright (c) 2024 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#include <zephyr/ztest.h>
+#include <zephyr/kernel.h>
+#include <zephyr/bluetooth/bluetooth.h>
+#include <zephyr/bluetooth/uuid.h>
+#include <bluetooth/scan.h>
+#include "../mock/bt_scan_mock.h"
+
+#define ADDR_FILTERS 64
+
+#define UUID_CUSTOM_VAL \
+	BT_UUID_128_ENCODE(0x6e400001, 0xb5a3, 0xf393, 0xe0a9, 0xe50e24dcca9e)
+#define UUID_OTHER_VAL \
+	BT_UUID_128_ENCODE(0x6e400002, 0xb5a3, 0xf393, 0xe0a9, 0xe50e24dcca9e)
+/* Same 32-bit value as the custom UUID, but derived from the Bluetooth Base UUID */
+#define UUID_BASE_VAL \
+	BT_UUID_128_ENCODE(0x6e400001, 0x0000, 0x1000, 0x8000, 0x00805f9b34fb)
+/* Heart Rate Service, in its 128-bit form */
+#define UUID_HRS_128_VAL \
+	BT_UUID_128_ENCODE(0x0000180d, 0x0000, 0x1000, 0x8000, 0x00805f9b34fb)
+
+static struct bt_scan_filter_match last_match;
+static int match_cnt;
+static int no_match_cnt;
+
+static bt_addr_le_t addrs[ADDR_FILTERS];
+
+static void scan_filter_match(struct bt_scan_device_info *device_info,
+			      struct bt_scan_filter_match *filter_match,
+			      bool connectable)
+{
+	last_match = *filter_match;
+	match_cnt++;
+}
+
+static void scan_filter_no_match(struct bt_scan_device_info *device_info,
+				 bool connectable)
+{
+	no_match_cnt++;
+}
+
+BT_SCAN_CB_INIT(scan_cb, scan_filter_match, scan_filter_no_match, NULL, NULL);
+
+static void addr_make(bt_addr_le_t *addr, uint32_t seed)
+{
+	addr->type = BT_ADDR_LE_RANDOM;
+	for (size_t i = 0; i < sizeof(addr->a.val); i++) {
+		seed = seed * 1103515245 + 12345;
+		addr->a.val[i] = seed >> 16;
+	}
+
+	/* Random static address */
+	addr->a.val[5] |= 0xc0;
+}
+
+/* Send a report and return true if it matched the filters */
+static bool report(const bt_addr_le_t *addr, const uint8_t *ad, size_t ad_len)
+{
+	int prev_match_cnt = match_cnt;
+	int prev_no_match_cnt = no_match_cnt;
+
+	memset(&last_match, 0, sizeof(last_match));
+
+	bt_scan_mock_report(addr, ad, ad_len);
+
+	zassert_equal(match_cnt + no_match_cnt, prev_match_cnt + prev_no_match_cnt + 1,
+		      "One event expected for each report");
+
+	return match_cnt > prev_match_cnt;
+}
+
+ZTEST(bt_scan_filter, test_addr_filter)
+{
+	const uint8_t ad[] = { 2, BT_DATA_FLAGS, BT_LE_AD_GENERAL | BT_LE_AD_NO_BREDR };
+	bt_addr_le_t addr;
+
+	for (size_t i = 0; i < ADDR_FILTERS; i++) {
+		zassert_ok(bt_scan_filter_add(BT_SCAN_FILTER_TYPE_ADDR, &addrs[i]));
+	}
+
+	zassert_ok(bt_scan_filter_enable(BT_SCAN_ADDR_FILTER, false));
+
+	for (size_t i = 0; i < ADDR_FILTERS; i++) {
+		zassert_true(report(&addrs[i], ad, sizeof(ad)), "Address %d not matched", i);
+		zassert_true(last_match.addr.match);
+		zassert_ok(bt_addr_le_cmp(last_match.addr.addr, &addrs[i]));
+	}
+
+	addr_make(&addr, ADDR_FILTERS);
+	zassert_false(report(&addr, ad, sizeof(ad)));
+
+	/* Same address, other type */
+	bt_addr_le_copy(&addr, &addrs[0]);
+	addr.type = BT_ADDR_LE_PUBLIC;
+	zassert_false(report(&addr, ad, sizeof(ad)));
+
+	/* Too many filters */
+	addr_make(&addr, ADDR_FILTERS);
+	zassert_equal(bt_scan_filter_add(BT_SCAN_FILTER_TYPE_ADDR, &addr), -ENOMEM);
+}
+
+ZTEST(bt_scan_filter, test_uuid_filter)
+{
+	const uint8_t ad_16[] = { 5, BT_DATA_UUID16_SOME, BT_UUID_16_ENCODE(BT_UUID_BAS_VAL),
+				  BT_UUID_16_ENCODE(BT_UUID_HRS_VAL) };
+	const uint8_t ad_32[] = { 5, BT_DATA_UUID32_ALL, BT_UUID_32_ENCODE(BT_UUID_HRS_VAL) };
+	const uint8_t ad_128[] = { 17, BT_DATA_UUID128_ALL, UUID_HRS_128_VAL };
+	const uint8_t ad_other[] = { 3, BT_DATA_UUID16_ALL, BT_UUID_16_ENCODE(BT_UUID_BAS_VAL) };
+
+	zassert_ok(bt_scan_filter_add(BT_SCAN_FILTER_TYPE_UUID, BT_UUID_HRS));
+	zassert_ok(bt_scan_filter_enable(BT_SCAN_UUID_FILTER, false));
+
+	/* UUIDs derived from the Base UUID match in all their forms */
+	zassert_true(report(&addrs[0], ad_16, sizeof(ad_16)));
+	zassert_true(last_match.uuid.match);
+	zassert_ok(bt_uuid_cmp(last_match.uuid.uuid[0], BT_UUID_HRS));
+	zassert_true(report(&addrs[0], ad_32, sizeof(ad_32)));
+	zassert_true(report(&addrs[0], ad_128, sizeof(ad_128)));
+	zassert_false(report(&addrs[0], ad_other, sizeof(ad_other)));
+}
+
+ZTEST(bt_scan_filter, test_uuid_128_filter)
+{
+	const uint8_t ad_custom[] = { 33, BT_DATA_UUID128_SOME, UUID_OTHER_VAL, UUID_CUSTOM_VAL };
+	const uint8_t ad_other[] = { 17, BT_DATA_UUID128_ALL, UUID_OTHER_VAL };
+	const uint8_t ad_base[] = { 17, BT_DATA_UUID128_ALL, UUID_BASE_VAL };
+
+	zassert_ok(bt_scan_filter_add(BT_SCAN_FILTER_TYPE_UUID,
+				      BT_UUID_DECLARE_128(UUID_CUSTOM_VAL)));
+	zassert_ok(bt_scan_filter_enable(BT_SCAN_UUID_FILTER, false));
+
+	zassert_true(report(&addrs[0], ad_custom, sizeof(ad_custom)));
+	zassert_false(report(&addrs[0], ad_other, sizeof(ad_other)));
+	zassert_false(report(&addrs[0], ad_base, sizeof(ad_base)));
+}
+
+ZTEST(bt_scan_filter, test_uuid_filter_all_mode)
+{
+	const uint8_t ad_both[] = { 5, BT_DATA_UUID16_ALL, BT_UUID_16_ENCODE(BT_UUID_BAS_VAL),
+				    BT_UUID_16_ENCODE(BT_UUID_HRS_VAL) };
+	const uint8_t ad_one[] = { 3, BT_DATA_UUID16_ALL, BT_UUID_16_ENCODE(BT_UUID_HRS_VAL) };
+
+	zassert_ok(bt_scan_filter_add(BT_SCAN_FILTER_TYPE_UUID, BT_UUID_HRS));
+	zassert_ok(bt_scan_filter_add(BT_SCAN_FILTER_TYPE_UUID, BT_UUID_BAS));
+	zassert_ok(bt_scan_filter_enable(BT_SCAN_UUID_FILTER, true));
+
+	zassert_true(report(&addrs[0], ad_both, sizeof(ad_both)));
+	zassert_equal(last_match.uuid.count, 2);
+	zassert_false(report(&addrs[0], ad_one, sizeof(ad_one)));
+}
+
+ZTEST(bt_scan_filter, test_addr_and_name_all_mode)
+{
+	const uint8_t ad[] = { 2, BT_DATA_FLAGS, BT_LE_AD_GENERAL | BT_LE_AD_NO_BREDR,
+			       7, BT_DATA_NAME_COMPLETE, 'S', 'e', 'n', 's', 'o', 'r' };
+	const uint8_t ad_other[] = { 7, BT_DATA_NAME_COMPLETE, 'R', 'e', 'l', 'a', 'y', 's' };
+
+	zassert_ok(bt_scan_filter_add(BT_SCAN_FILTER_TYPE_ADDR, &addrs[1]));
+	zassert_ok(bt_scan_filter_add(BT_SCAN_FILTER_TYPE_NAME, "Sensor"));
+	zassert_ok(bt_scan_filter_enable(BT_SCAN_ADDR_FILTER | BT_SCAN_NAME_FILTER, true));
+
+	zassert_true(report(&addrs[1], ad, sizeof(ad)));
+	zassert_true(last_match.addr.match);
+	zassert_true(last_match.name.match);
+	zassert_false(report(&addrs[2], ad, sizeof(ad)));
+	zassert_false(report(&addrs[1], ad_other, sizeof(ad_other)));
+
+	/* In the normal mode, one of the filters is enough */
+	zassert_ok(bt_scan_filter_enable(BT_SCAN_ADDR_FILTER | BT_SCAN_NAME_FILTER, false));
+	zassert_true(report(&addrs[2], ad, sizeof(ad)));
+	zassert_true(report(&addrs[1], ad_other, sizeof(ad_other)));
+	zassert_false(report(&addrs[2], ad_other, sizeof(ad_other)));
+}
+
+ZTEST(bt_scan_filter, test_filter_remove_all)
+{
+	const uint8_t ad[] = { 3, BT_DATA_UUID16_ALL, BT_UUID_16_ENCODE(BT_UUID_HRS_VAL) };
+
+	zassert_ok(bt_scan_filter_add(BT_SCAN_FILTER_TYPE_ADDR, &addrs[0]));
+	zassert_ok(bt_scan_filter_add(BT_SCAN_FILTER_TYPE_UUID, BT_UUID_HRS));
+	zassert_ok(bt_scan_filter_enable(BT_SCAN_ADDR_FILTER | BT_SCAN_UUID_FILTER, false));
+
+	zassert_true(report(&addrs[0], ad, sizeof(ad)));
+
+	bt_scan_filter_remove_all();
+
+	zassert_false(report(&addrs[0], ad, sizeof(ad)));
+
+	zassert_ok(bt_scan_filter_add(BT_SCAN_FILTER_TYPE_ADDR, &addrs[1]));
+	zassert_ok(bt_scan_filter_add(BT_SCAN_FILTER_TYPE_UUID, BT_UUID_BAS));
+
+	zassert_false(report(&addrs[0], ad, sizeof(ad)));
+	zassert_true(report(&addrs[1], ad, sizeof(ad)));
+	zassert_ok(bt_addr_le_cmp(last_match.addr.addr, &addrs[1]));
+}
+
+static void *scan_filter_setup(void)
+{
+	for (size_t i = 0; i < ARRAY_SIZE(addrs); i++) {
+		addr_make(&addrs[i], i);
+	}
+
+	bt_scan_cb_register(&scan_cb);
+
+	return NULL;
+}
+
+static void scan_filter_before(void *fixture)
+{
+	ARG_UNUSED(fixture);
+
+	/* Remove the filters and reset their mode */
+	bt_scan_init(NULL);
+}
+
+ZTEST_SUITE(bt_scan_filter, NULL, scan_filter_setup, scan_filter_before, NULL, NULL);
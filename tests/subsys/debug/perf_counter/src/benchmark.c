@@ -0,0 +1,73 @@
+/*
+ * Copyright (c) 2024 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#include <zephyr/ztest.h>
+#include <zephyr/kernel.h>
+#include <zephyr/spinlock.h>
+#include <debug/perf_counter.h>
+
+#define BENCH_ITERATIONS 10000
+
+PERF_COUNTER_DEFINE(bench_counter, "B");
+PERF_HISTOGRAM_DEFINE(bench_histogram, "us");
+
+/* Ad hoc statistics as kept by the modules before, for reference */
+static struct k_spinlock bench_lock;
+static uint32_t bench_count;
+static uint32_t bench_sum;
+
+static void bench_print(const char *name, uint32_t cycles)
+{
+	TC_PRINT("%s: %u cycles per %u calls, %u.%02u cycles per call\n", name, cycles,
+		 BENCH_ITERATIONS, cycles / BENCH_ITERATIONS,
+		 (cycles % BENCH_ITERATIONS) / (BENCH_ITERATIONS / 100));
+}
+
+ZTEST(perf_counter_benchmark, test_benchmark_counter)
+{
+	uint32_t start;
+
+	start = k_cycle_get_32();
+	for (uint32_t i = 0; i < BENCH_ITERATIONS; i++) {
+		k_spinlock_key_t key = k_spin_lock(&bench_lock);
+
+		bench_count++;
+		bench_sum += i;
+		k_spin_unlock(&bench_lock, key);
+	}
+	bench_print("spinlock", k_cycle_get_32() - start);
+
+	start = k_cycle_get_32();
+	for (uint32_t i = 0; i < BENCH_ITERATIONS; i++) {
+		PERF_COUNTER_ADD(bench_counter, i);
+	}
+	bench_print("PERF_COUNTER_ADD", k_cycle_get_32() - start);
+
+	zassert_equal(perf_counter_value_get(&bench_counter), bench_sum);
+}
+
+ZTEST(perf_counter_benchmark, test_benchmark_histogram)
+{
+	uint32_t start;
+
+	start = k_cycle_get_32();
+	for (uint32_t i = 0; i < BENCH_ITERATIONS; i++) {
+		PERF_HISTOGRAM_RECORD(bench_histogram, i);
+	}
+	bench_print("PERF_HISTOGRAM_RECORD", k_cycle_get_32() - start);
+
+	start = k_cycle_get_32();
+	for (uint32_t i = 0; i < BENCH_ITERATIONS; i++) {
+		uint32_t t = PERF_TIMESTAMP();
+
+		PERF_HISTOGRAM_RECORD_SINCE(bench_histogram, t);
+	}
+	bench_print("PERF_HISTOGRAM_RECORD_SINCE", k_cycle_get_32() - start);
+
+	zassert_equal(atomic_get(&bench_histogram.count), 2 * BENCH_ITERATIONS);
+}
+
+ZTEST_SUITE(perf_counter_benchmark, NULL, NULL, NULL, NULL, NULL);
@@ -0,0 +1,149 @@
+/*
+ * Copyright (c) 2024 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#include <zephyr/ztest.h>
+#include <zephyr/kernel.h>
+#include <debug/perf_counter.h>
+
+#define THREAD_STACK_SIZE 1024
+#define THREAD_ADDS 10000
+
+static uint32_t gauge_value;
+
+static uint32_t gauge_get(void)
+{
+	return gauge_value;
+}
+
+PERF_COUNTER_DEFINE(test_counter, "B");
+PERF_HISTOGRAM_DEFINE(test_histogram, "us");
+PERF_GAUGE_DEFINE(test_gauge, "bps", gauge_get);
+
+ZTEST(perf_counter, test_counter_add)
+{
+	PERF_COUNTER_ADD(test_counter, 100);
+	PERF_COUNTER_ADD(test_counter, 20);
+	PERF_COUNTER_INC(test_counter);
+
+	zassert_equal(atomic_get(&test_counter.count), 3);
+	zassert_equal(perf_counter_value_get(&test_counter), 121);
+}
+
+ZTEST(perf_counter, test_histogram_buckets)
+{
+	PERF_HISTOGRAM_RECORD(test_histogram, 0);
+	PERF_HISTOGRAM_RECORD(test_histogram, 1);
+	PERF_HISTOGRAM_RECORD(test_histogram, 2);
+	PERF_HISTOGRAM_RECORD(test_histogram, 3);
+	PERF_HISTOGRAM_RECORD(test_histogram, 1000);
+	/* Saturates in the last bucket */
+	PERF_HISTOGRAM_RECORD(test_histogram, UINT32_MAX / 2);
+
+	zassert_equal(atomic_get(&test_histogram.buckets[0]), 1);
+	zassert_equal(atomic_get(&test_histogram.buckets[1]), 1);
+	zassert_equal(atomic_get(&test_histogram.buckets[2]), 2);
+	zassert_equal(atomic_get(&test_histogram.buckets[10]), 1);
+	zassert_equal(atomic_get(&test_histogram.buckets[CONFIG_PERF_COUNTER_HISTOGRAM_BUCKETS - 1]),
+		      1);
+	zassert_equal(atomic_get(&test_histogram.count), 6);
+	zassert_equal((uint32_t)atomic_get(&test_histogram.max), UINT32_MAX / 2);
+}
+
+ZTEST(perf_counter, test_histogram_percentile)
+{
+	zassert_equal(perf_histogram_percentile_get(&test_histogram, 50), 0);
+
+	for (uint32_t i = 0; i < 90; i++) {
+		PERF_HISTOGRAM_RECORD(test_histogram, 10);
+	}
+	for (uint32_t i = 0; i < 10; i++) {
+		PERF_HISTOGRAM_RECORD(test_histogram, 300);
+	}
+
+	zassert_equal(perf_counter_value_get(&test_histogram), (90 * 10 + 10 * 300) / 100);
+	/* Upper bound of the bucket of 8 to 15 */
+	zassert_equal(perf_histogram_percentile_get(&test_histogram, 50), 15);
+	zassert_equal(perf_histogram_percentile_get(&test_histogram, 90), 15);
+	/* Limited by the largest value */
+	zassert_equal(perf_histogram_percentile_get(&test_histogram, 99), 300);
+	zassert_equal(perf_histogram_percentile_get(&test_histogram, 100), 300);
+}
+
+ZTEST(perf_counter, test_record_since)
+{
+	uint32_t start = PERF_TIMESTAMP();
+
+	k_busy_wait(1000);
+	PERF_HISTOGRAM_RECORD_SINCE(test_histogram, start);
+
+	zassert_equal(atomic_get(&test_histogram.count), 1);
+	zassert_true(atomic_get(&test_histogram.max) >= 1000);
+}
+
+ZTEST(perf_counter, test_gauge)
+{
+	gauge_value = 1234;
+	zassert_equal(perf_counter_value_get(&test_gauge), 1234);
+}
+
+ZTEST(perf_counter, test_find_reset)
+{
+	zassert_equal_ptr(perf_counter_find("test_counter"), &test_counter);
+	zassert_equal_ptr(perf_counter_find("test_histogram"), &test_histogram);
+	zassert_is_null(perf_counter_find("test_none"));
+
+	PERF_COUNTER_ADD(test_counter, 5);
+	PERF_HISTOGRAM_RECORD(test_histogram, 5);
+
+	perf_counter_reset(&test_counter);
+	zassert_equal(perf_counter_value_get(&test_counter), 0);
+	zassert_equal(atomic_get(&test_histogram.count), 1);
+
+	perf_counter_reset_all();
+	zassert_equal(atomic_get(&test_histogram.count), 0);
+	zassert_equal(atomic_get(&test_histogram.max), 0);
+	zassert_equal(atomic_get(&test_histogram.buckets[3]), 0);
+}
+
+static void adder(void *p1, void *p2, void *p3)
+{
+	for (uint32_t i = 0; i < THREAD_ADDS; i++) {
+		PERF_COUNTER_ADD(test_counter, 2);
+		PERF_HISTOGRAM_RECORD(test_histogram, i);
+		if ((i % 64) == 0) {
+			k_yield();
+		}
+	}
+}
+
+K_THREAD_STACK_ARRAY_DEFINE(adder_stacks, 2, THREAD_STACK_SIZE);
+static struct k_thread adder_threads[2];
+
+ZTEST(perf_counter, test_concurrent)
+{
+	for (size_t i = 0; i < ARRAY_SIZE(adder_threads); i++) {
+		k_thread_create(&adder_threads[i], adder_stacks[i], THREAD_STACK_SIZE, adder,
+				NULL, NULL, NULL, K_PRIO_PREEMPT(1), 0, K_NO_WAIT);
+	}
+
+	for (size_t i = 0; i < ARRAY_SIZE(adder_threads); i++) {
+		k_thread_join(&adder_threads[i], K_FOREVER);
+	}
+
+	zassert_equal(atomic_get(&test_counter.count), 2 * THREAD_ADDS);
+	zassert_equal(perf_counter_value_get(&test_counter), 4 * THREAD_ADDS);
+	zassert_equal(atomic_get(&test_histogram.count), 2 * THREAD_ADDS);
+	zassert_equal(atomic_get(&test_histogram.max), THREAD_ADDS - 1);
+}
+
+static void perf_counter_before(void *fixture)
+{
+	ARG_UNUSED(fixture);
+
+	perf_counter_reset_all();
+}
+
+ZTEST_SUITE(perf_counter, NULL, NULL, perf_counter_before, NULL, NULL);
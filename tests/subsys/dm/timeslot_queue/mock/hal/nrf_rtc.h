@@ -0,0 +1,25 @@
+/*
+ * Copyright (c) 2024 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#ifndef MOCK_NRF_RTC_H_
+#define MOCK_NRF_RTC_H_
+
+#include <stdint.h>
+
+/* The queue only uses the RTC for its tick rate and range */
+#define NRF_RTC_INPUT_FREQ 32768
+#define NRF_RTC_COUNTER_MAX 0xFFFFFF
+
+#define NRF_RTC0 NULL
+
+static inline uint32_t nrf_rtc_counter_get(const void *p_reg)
+{
+	(void)p_reg;
+
+	return 0;
+}
+
+#endif /* MOCK_NRF_RTC_H_ */
@@ -0,0 +1,71 @@
+/*
+ * Copyright (c) 2024 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#include <zephyr/ztest.h>
+#include <zephyr/kernel.h>
+
+#include "timeslot_queue.h"
+#include "time.h"
+
+#define BENCH_ROUNDS (256)
+
+/* Tags answering a scan one after the other */
+#define BENCH_TAGS       CONFIG_DM_TIMESLOT_QUEUE_LENGTH
+#define BENCH_ARRIVAL_US (4000)
+#define BENCH_ROUND_US   (100000)
+
+#define BENCH_WINDOW_US   (3000)
+#define BENCH_TIMESLOT_US (3400)
+
+ZTEST(dm_timeslot_queue_benchmark, test_benchmark_tags)
+{
+	struct timeslot_group group;
+	struct dm_request req = {
+		.role = DM_ROLE_INITIATOR,
+		.bt_addr.type = BT_ADDR_LE_RANDOM,
+	};
+	uint32_t accepted = 0;
+	uint32_t rangings = 0;
+	uint32_t timeslots = 0;
+	uint64_t window_us = 0;
+	uint64_t timeslot_us = 0;
+	uint32_t cycles = 0;
+	uint32_t start;
+	uint32_t ref;
+
+	for (uint32_t round = 0; round < BENCH_ROUNDS; round++) {
+		ref = US_TO_RTC_TICKS((uint64_t)round * BENCH_ROUND_US) % RTC_COUNTER_MAX;
+
+		start = k_cycle_get_32();
+		for (uint8_t tag = 0; tag < BENCH_TAGS; tag++) {
+			req.bt_addr.a.val[0] = tag;
+
+			if (!timeslot_queue_append(&req, ref + US_TO_RTC_TICKS(tag * BENCH_ARRIVAL_US),
+						   BENCH_WINDOW_US, BENCH_TIMESLOT_US)) {
+				accepted++;
+			}
+		}
+
+		while (timeslot_queue_group_get(ref, &group) == 0) {
+			timeslots++;
+			rangings += group.count;
+			timeslot_us += group.timeslot_length_us;
+			window_us += group.count * BENCH_WINDOW_US;
+		}
+		cycles += k_cycle_get_32() - start;
+	}
+
+	zassert_equal(rangings, accepted, "Scheduled rangings were dropped");
+
+	TC_PRINT("Up to %u rangings per timeslot, %u of %u requests scheduled\n",
+		 CONFIG_DM_TIMESLOT_PACK_MAX, accepted, BENCH_ROUNDS * BENCH_TAGS);
+	TC_PRINT("%u rangings/s with a tag every %u us, %u%% timeslot utilization\n",
+		 (uint32_t)((uint64_t)rangings * 1000000 / ((uint64_t)BENCH_ROUNDS * BENCH_ROUND_US)),
+		 BENCH_ARRIVAL_US, (uint32_t)(window_us * 100 / timeslot_us));
+	TC_PRINT("%u cycles per request\n", cycles / (BENCH_ROUNDS * BENCH_TAGS));
+}
+
+ZTEST_SUITE(dm_timeslot_queue_benchmark, NULL, NULL, NULL, NULL, NULL);
@@ -0,0 +1,226 @@
+/*
+ * Copyright (c) 2024 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#include <zephyr/ztest.h>
+#include <zephyr/kernel.h>
+
+#include "timeslot_queue.h"
+#include "time.h"
+
+#define WINDOW_US   3000
+#define TIMESLOT_US 3400
+
+static uint32_t ref_tick;
+static struct timeslot_group group;
+
+static int request_add(uint8_t peer, uint32_t delay_us)
+{
+	struct dm_request req = {
+		.role = DM_ROLE_REFLECTOR,
+		.bt_addr = {
+			.type = BT_ADDR_LE_RANDOM,
+			.a.val = { peer },
+		},
+		.ranging_mode = DM_RANGING_MODE_MCPD,
+		.start_delay_us = delay_us,
+	};
+
+	return timeslot_queue_append(&req, ref_tick, WINDOW_US, TIMESLOT_US);
+}
+
+static uint32_t start_time(uint32_t delay_us)
+{
+	return (ref_tick + US_TO_RTC_TICKS(delay_us + CONFIG_DM_RANGING_OFFSET_US)) %
+	       RTC_COUNTER_MAX;
+}
+
+static void group_assert(uint8_t count, uint8_t peer, uint32_t delay_us)
+{
+	zassert_ok(timeslot_queue_group_get(ref_tick, &group));
+	zassert_equal(group.count, count);
+	zassert_equal(group.req[0].dm_req.bt_addr.a.val[0], peer);
+	zassert_equal(group.start_time, start_time(delay_us));
+}
+
+ZTEST(dm_timeslot_queue, test_order)
+{
+	zassert_ok(request_add(1, 100000));
+	zassert_ok(request_add(2, 50000));
+	zassert_ok(request_add(3, 200000));
+
+	group_assert(1, 2, 50000);
+	zassert_equal(group.timeslot_length_us, TIMESLOT_US);
+	group_assert(1, 1, 100000);
+	group_assert(1, 3, 200000);
+
+	zassert_equal(timeslot_queue_group_get(ref_tick, &group), -ENOENT);
+	zassert_equal(group.missed, 0);
+}
+
+ZTEST(dm_timeslot_queue, test_wrap)
+{
+	/* The start times wrap around the end of the RTC counter */
+	ref_tick = RTC_COUNTER_MAX - US_TO_RTC_TICKS(CONFIG_DM_RANGING_OFFSET_US) - 100;
+
+	zassert_ok(request_add(1, 0));
+	zassert_ok(request_add(2, 100000));
+	zassert_ok(request_add(3, 50000));
+
+	group_assert(1, 1, 0);
+	group_assert(1, 3, 50000);
+	group_assert(1, 2, 100000);
+}
+
+ZTEST(dm_timeslot_queue, test_overlap)
+{
+	zassert_ok(request_add(1, 10000));
+
+	/* Both after and before the scheduled ranging */
+	zassert_equal(request_add(2, 12000), -EBUSY);
+	zassert_equal(request_add(3, 8000), -EBUSY);
+	zassert_equal(request_add(4, 10000), -EBUSY);
+
+	/* Too far to share the timeslot */
+	zassert_ok(request_add(5, 10000 + CONFIG_DM_TIMESLOT_PACK_LENGTH_MAX_US));
+
+	group_assert(1, 1, 10000);
+	group_assert(1, 5, 10000 + CONFIG_DM_TIMESLOT_PACK_LENGTH_MAX_US);
+}
+
+ZTEST(dm_timeslot_queue, test_pack)
+{
+	const uint32_t delay_us = WINDOW_US + CONFIG_DM_TIMESLOT_PACK_GUARD_US + 100;
+
+	zassert_ok(request_add(1, 0));
+
+	if (CONFIG_DM_TIMESLOT_PACK_MAX == 1) {
+		/* Too close for a timeslot of its own */
+		zassert_equal(request_add(2, delay_us), -EBUSY);
+		return;
+	}
+
+	zassert_ok(request_add(2, delay_us));
+
+	group_assert(2, 1, 0);
+	zassert_equal(group.req[group.count - 1].dm_req.bt_addr.a.val[0], 2);
+	zassert_equal(group.timeslot_length_us,
+		      TICKS_TO_US(time_distance_get(start_time(0), start_time(delay_us))) +
+		      TIMESLOT_US);
+}
+
+ZTEST(dm_timeslot_queue, test_pack_full)
+{
+	const uint32_t delay_us = WINDOW_US + CONFIG_DM_TIMESLOT_PACK_GUARD_US + 100;
+	int i;
+
+	if (CONFIG_DM_TIMESLOT_PACK_MAX == 1) {
+		ztest_test_skip();
+	}
+
+	for (i = 0; i < CONFIG_DM_TIMESLOT_PACK_MAX; i++) {
+		zassert_ok(request_add(i, i * delay_us));
+	}
+
+	/* Neither fits in the full timeslot nor leaves enough time after it */
+	zassert_equal(request_add(i, i * delay_us), -EBUSY);
+
+	group_assert(CONFIG_DM_TIMESLOT_PACK_MAX, 0, 0);
+	zassert_equal(group.missed, 0);
+}
+
+ZTEST(dm_timeslot_queue, test_missed_regroup)
+{
+	const uint32_t delay_us = WINDOW_US + CONFIG_DM_TIMESLOT_PACK_GUARD_US + 100;
+	const uint32_t next_us = 2 * delay_us + TIMESLOT_US + CONFIG_DM_MIN_TIME_BETWEEN_TIMESLOTS_US;
+
+	if (CONFIG_DM_TIMESLOT_PACK_MAX != 2) {
+		ztest_test_skip();
+	}
+
+	/* Two full timeslots */
+	zassert_ok(request_add(1, 0));
+	zassert_ok(request_add(2, delay_us));
+	zassert_ok(request_add(3, next_us));
+	zassert_ok(request_add(4, next_us + delay_us));
+
+	/* Without the first ranging, the second and the third share a timeslot,
+	 * and the last one is too close to it.
+	 */
+	zassert_ok(timeslot_queue_group_get(start_time(0), &group));
+	zassert_equal(group.count, 2);
+	zassert_equal(group.req[0].dm_req.bt_addr.a.val[0], 2);
+	zassert_equal(group.missed, 2);
+
+	zassert_equal(timeslot_queue_group_get(start_time(0), &group), -ENOENT);
+}
+
+ZTEST(dm_timeslot_queue, test_same_peer)
+{
+	for (int i = 0; i < CONFIG_DM_TIMESLOT_QUEUE_COUNT_SAME_PEER; i++) {
+		zassert_ok(request_add(1, i * 100000));
+	}
+
+	zassert_equal(request_add(1, 1000000), -EAGAIN);
+	zassert_ok(request_add(2, 1000000));
+}
+
+ZTEST(dm_timeslot_queue, test_full)
+{
+	for (int i = 0; i < CONFIG_DM_TIMESLOT_QUEUE_LENGTH; i++) {
+		zassert_ok(request_add(i, i * 100000));
+	}
+
+	zassert_equal(request_add(100, 1000000), -ENOMEM);
+
+	/* Entries are reused */
+	group_assert(1, 0, 0);
+	zassert_ok(request_add(100, 1000000));
+}
+
+ZTEST(dm_timeslot_queue, test_missed)
+{
+	zassert_ok(request_add(1, 0));
+	zassert_ok(request_add(2, 100000));
+
+	/* The first ranging should have started already */
+	zassert_ok(timeslot_queue_group_get(start_time(0), &group));
+	zassert_equal(group.missed, 1);
+	zassert_equal(group.count, 1);
+	zassert_equal(group.req[0].dm_req.bt_addr.a.val[0], 2);
+}
+
+ZTEST(dm_timeslot_queue, test_rng_seed)
+{
+	struct dm_request req = {
+		.rng_seed = 10,
+	};
+
+	zassert_ok(timeslot_queue_append(&req, ref_tick, WINDOW_US, TIMESLOT_US));
+	zassert_equal(req.rng_seed, 11);
+
+	zassert_equal(timeslot_queue_append(&req, ref_tick, WINDOW_US, TIMESLOT_US), -EBUSY);
+	zassert_equal(req.rng_seed, 11);
+
+	group_assert(1, 0, 0);
+	zassert_equal(group.req[0].dm_req.rng_seed, 11);
+}
+
+static void queue_before(void *fixture)
+{
+	ARG_UNUSED(fixture);
+
+	ref_tick = 1000;
+}
+
+static void queue_after(void *fixture)
+{
+	ARG_UNUSED(fixture);
+
+	while (timeslot_queue_group_get(ref_tick, &group) == 0) {
+	}
+}
+
+ZTEST_SUITE(dm_timeslot_queue, NULL, NULL, queue_before, queue_after, NULL);
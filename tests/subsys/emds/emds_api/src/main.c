@@ -34,7 +34,12 @@ static enum test_states state[] = {
 	EMDS_TS_CLEAR_FLASH,
 	EMDS_TS_EMPTY_FLASH,
 	EMDS_TS_NO_STORE,
+#if defined(CONFIG_EMDS_INCREMENTAL_STORE)
+	/* The entries of the last store are kept when no new store is done */
+	EMDS_TS_STORE_DATA,
+#else
 	EMDS_TS_EMPTY_FLASH,
+#endif
 	EMDS_TS_CLEAR_FLASH,
 };
 
@@ -163,6 +168,34 @@ static void prepare(void)
 	zassert_true(emds_is_ready(), "EMDS should be ready");
 }
 
+static void load_prepared(void)
+{
+	/* Without incremental store, prepare invalidates the stored entries */
+	if (IS_ENABLED(CONFIG_EMDS_INCREMENTAL_STORE)) {
+		load_flash();
+	} else {
+		load_empty_flash();
+	}
+}
+
+static void dirty_check(void)
+{
+	uint32_t clean_time_us = emds_dirty_store_time_get();
+
+	if (!IS_ENABLED(CONFIG_EMDS_INCREMENTAL_STORE)) {
+		zassert_equal(clean_time_us, emds_store_time_get(), "All entries should be dirty");
+		return;
+	}
+
+	zassert_true(clean_time_us < emds_store_time_get(), "No entry should be dirty");
+
+	d_data[0][0]++;
+	zassert_true(emds_dirty_store_time_get() > clean_time_us, "Entry should be dirty");
+
+	d_data[0][0]--;
+	zassert_equal(emds_dirty_store_time_get(), clean_time_us, "Entry should be clean");
+}
+
 static void store(void)
 {
 	zassert_true(emds_is_ready(), "Store should be ready to execute");
@@ -170,6 +203,8 @@ static void store(void)
 	memcpy(d_data, expect_d_data, sizeof(expect_d_data));
 	memcpy(s_data, expect_s_data, sizeof(expect_s_data));
 
+	uint32_t estimate_dirty_time_us = emds_dirty_store_time_get();
+
 #if defined(CONFIG_BT) && !defined(CONFIG_BT_LL_SW_SPLIT)
 	/* Disable bluetooth and mpsl scheduler if bluetooth is enabled. */
 	(void) sdc_disable(); // Replace with bt_disable when added.
@@ -190,8 +225,9 @@ static void store(void)
 	uint32_t estimate_store_time_us = emds_store_time_get();
 
 	zassert_true((store_time_us < estimate_store_time_us), "Store takes to long time");
-	printf("Store time: Actual %lldus, Worst case:  %dus\n",
-	       store_time_us, estimate_store_time_us);
+	zassert_true((store_time_us < estimate_dirty_time_us), "Store takes to long time");
+	printf("Store time: Actual %lldus, Estimate: %dus, Worst case:  %dus\n",
+	       store_time_us, estimate_dirty_time_us, estimate_store_time_us);
 }
 
 static void clear(void)
@@ -286,6 +322,7 @@ ZTEST(store_data, test_store_data)
 {
 	load_flash();
 	prepare();
+	dirty_check();
 	store();
 	load_flash();
 }
@@ -303,18 +340,18 @@ ZTEST(no_store, test_no_store)
 {
 	load_flash();
 	prepare();
-	load_empty_flash();
+	load_prepared();
 }
 
 ZTEST(several_store, test_several_store)
 {
 	load_flash();
 	prepare();
-	load_empty_flash();
+	load_prepared();
 	store();
 	load_flash();
 	prepare();
-	load_empty_flash();
+	load_prepared();
 	store();
 	load_flash();
 }
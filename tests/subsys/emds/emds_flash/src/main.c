@@ -458,6 +458,54 @@ ZTEST(emds_flash_tests, test_invalidate_on_prepare)
 	zassert_false(ctx.force_erase, "Force erase should be false");
 }
 
+ZTEST(emds_flash_tests, test_incremental_prepare)
+{
+	char data_in1[8] = "Deadbee";
+	char data_in2[8] = "Beefdea";
+	char data_out[8] = {0};
+
+	flash_clear();
+	device_reset();
+
+	zassert_false(emds_flash_init(&ctx), "Error when initializing");
+	zassert_equal(emds_flash_cmp(&ctx, 1, data_in1, sizeof(data_in1)), -ENXIO,
+		      "Entry should not exist");
+	zassert_false(emds_flash_incremental_prepare(&ctx, 2 * (sizeof(data_in1) + ctx.ate_size)),
+		      "Prepare failed");
+	zassert_true(emds_flash_write(&ctx, 1, data_in1, sizeof(data_in1)) == sizeof(data_in1),
+		     "Should be able to write");
+	zassert_true(emds_flash_write(&ctx, 2, data_in1, sizeof(data_in1)) == sizeof(data_in1),
+		     "Should be able to write");
+
+	/* Entries must survive the prepare and a reset */
+	zassert_false(emds_flash_incremental_prepare(&ctx, 2 * (sizeof(data_in1) + ctx.ate_size)),
+		      "Prepare failed");
+	device_reset();
+	zassert_false(emds_flash_init(&ctx), "Error when initializing");
+	zassert_false(ctx.force_erase, "Force erase should be false");
+	zassert_equal(emds_flash_cmp(&ctx, 1, data_in1, sizeof(data_in1)), 0, "Not same data");
+	zassert_equal(emds_flash_cmp(&ctx, 2, data_in2, sizeof(data_in2)), 1, "Same data");
+	zassert_equal(emds_flash_cmp(&ctx, 2, data_in1, sizeof(data_in1) - 1), 1, "Same length");
+
+	/* A newer entry takes precedence over the kept one */
+	zassert_false(emds_flash_incremental_prepare(&ctx, 2 * (sizeof(data_in1) + ctx.ate_size)),
+		      "Prepare failed");
+	zassert_true(emds_flash_write(&ctx, 2, data_in2, sizeof(data_in2)) == sizeof(data_in2),
+		     "Should be able to write");
+	device_reset();
+	zassert_false(emds_flash_init(&ctx), "Error when initializing");
+	zassert_equal(emds_flash_cmp(&ctx, 2, data_in2, sizeof(data_in2)), 0, "Not same data");
+	zassert_true(emds_flash_read(&ctx, 1, data_out, sizeof(data_out)) == sizeof(data_out),
+		     "Should be able to read");
+	zassert_false(memcmp(data_out, data_in1, sizeof(data_out)), "Retrived wrong value");
+
+	/* The kept entries are lost when there is not enough space left */
+	zassert_false(emds_flash_incremental_prepare(&ctx, emds_flash_free_space_get(&ctx) + 1),
+		      "Prepare failed");
+	zassert_equal(emds_flash_cmp(&ctx, 1, data_in1, sizeof(data_in1)), -ENXIO,
+		      "Entry should not exist");
+}
+
 ZTEST(emds_flash_tests, test_clear_on_strange_flash)
 {
 	flash_clear();
@@ -20,7 +20,8 @@ void dl_coap_init(size_t file_size, size_t coap_request_send_len)
 	default_values.coap_request_send_timeout = 4000;
 }
 
-int socket_send(const struct download_client *client, size_t len, int timeout);
+int socket_send(const struct download_client *client, const char *buf, size_t len,
+		int timeout);
 
 int coap_block_init(struct download_client *client, size_t from)
 {
@@ -72,7 +73,7 @@ int coap_request_send(struct download_client *client)
 {
 	int err = 0;
 
-	err = socket_send(client, default_values.coap_request_send_len,
+	err = socket_send(client, client->buf, default_values.coap_request_send_len,
 			  default_values.coap_request_send_timeout);
 	if (err) {
 		return err;
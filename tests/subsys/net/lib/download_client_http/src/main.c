@@ -0,0 +1,207 @@
+/*
+ * Copyright (c) 2024 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#include <stdio.h>
+#include <string.h>
+#include <zephyr/kernel.h>
+#include <zephyr/logging/log.h>
+#include <zephyr/ztest.h>
+#include <download_client.h>
+
+LOG_MODULE_REGISTER(download_client, CONFIG_DOWNLOAD_CLIENT_LOG_LEVEL);
+
+#define FRAG_SIZE CONFIG_DOWNLOAD_CLIENT_HTTP_FRAG_SIZE
+#define PIPELINE_DEPTH CONFIG_DOWNLOAD_CLIENT_HTTP_PIPELINE_DEPTH
+#define REQUEST_MAX 32
+/* Number of bytes the server sends per recv() call */
+#define RECV_CHUNK 100
+
+int http_parse(struct download_client *client, size_t len);
+int http_get_request_send(struct download_client *client);
+
+static struct download_client client;
+
+/* Simulated server, which answers every range request as soon as it is sent */
+static struct {
+	size_t file_size;
+	struct {
+		size_t start;
+		size_t end;
+	} req[REQUEST_MAX];
+	size_t req_cnt;
+	/* Responses not received by the client yet */
+	uint8_t stream[2048];
+	size_t stream_len;
+	size_t stream_pos;
+} server;
+
+static uint8_t file_byte(size_t off)
+{
+	return (off * 7) % 251;
+}
+
+__weak char *strnstr(const char *haystack, const char *needle, size_t haystack_sz)
+{
+	size_t needle_len = strlen(needle);
+
+	for (size_t i = 0; (i + needle_len) <= haystack_sz && haystack[i] != '\0'; i++) {
+		if (!strncmp(&haystack[i], needle, needle_len)) {
+			return (char *)&haystack[i];
+		}
+	}
+
+	return NULL;
+}
+
+int socket_send(const struct download_client *dl, const char *buf, size_t len, int timeout)
+{
+	unsigned int start;
+	unsigned int end;
+	const char *range;
+	int hdr_len;
+
+	range = strstr(buf, "Range: bytes=");
+	zassert_not_null(range, "Not a range request");
+	zassert_equal(2, sscanf(range, "Range: bytes=%u-%u", &start, &end), "Malformed range");
+
+	/* A range past the end of the file is answered with 416 by a real server */
+	zassert_true(start <= end, "Empty range %u-%u requested", start, end);
+	zassert_true(end < server.file_size, "Range %u-%u past the end of file", start, end);
+	zassert_true(server.req_cnt < REQUEST_MAX, "Too many requests");
+
+	server.req[server.req_cnt].start = start;
+	server.req[server.req_cnt].end = end;
+	server.req_cnt++;
+
+	hdr_len = snprintf((char *)&server.stream[server.stream_len],
+			   sizeof(server.stream) - server.stream_len,
+			   "HTTP/1.1 206 Partial Content\r\n"
+			   "Content-Range: bytes %u-%u/%u\r\n"
+			   "\r\n", start, end, (unsigned int)server.file_size);
+	server.stream_len += hdr_len;
+
+	for (size_t off = start; off <= end; off++) {
+		server.stream[server.stream_len++] = file_byte(off);
+	}
+
+	zassert_true(server.stream_len < sizeof(server.stream), "Server stream overflow");
+
+	return 0;
+}
+
+/* Runs the request and receive loop of the download thread, returns the number of fragments */
+static size_t download(size_t file_size)
+{
+	size_t frag_cnt = 0;
+	size_t frag_start;
+	size_t frag_len;
+	size_t len;
+	int rc;
+
+	memset(&server, 0, sizeof(server));
+	server.file_size = file_size;
+
+	memset(&client, 0, sizeof(client));
+	client.host = "http://10.1.0.10";
+	client.file = "file.bin";
+	client.proto = IPPROTO_TCP;
+
+	rc = http_get_request_send(&client);
+	zassert_ok(rc, "First request failed: %d", rc);
+
+	while (client.progress < file_size) {
+		if (client.http.carry) {
+			len = client.http.carry;
+			client.http.carry = 0;
+		} else {
+			len = MIN(server.stream_len - server.stream_pos, RECV_CHUNK);
+			len = MIN(len, sizeof(client.buf) - client.offset);
+			zassert_true(len > 0, "No response to receive");
+			memcpy(&client.buf[client.offset], &server.stream[server.stream_pos], len);
+			server.stream_pos += len;
+		}
+
+		rc = http_parse(&client, len);
+		zassert_true(rc >= 0, "Parsing failed: %d", rc);
+		if (rc > 0) {
+			continue;
+		}
+
+		/* Fragment event */
+		frag_len = client.offset;
+		frag_start = client.progress - frag_len;
+		for (size_t i = 0; i < frag_len; i++) {
+			zassert_equal(file_byte(frag_start + i), (uint8_t)client.buf[i],
+				      "Wrong byte at %zu", frag_start + i);
+		}
+		frag_cnt++;
+
+		if (client.http.carry) {
+			memmove(client.buf, client.buf + frag_len, client.http.carry);
+		}
+
+		if (client.progress == file_size) {
+			break;
+		}
+
+		client.offset = 0;
+		rc = http_get_request_send(&client);
+		zassert_ok(rc, "Request failed: %d", rc);
+	}
+
+	zassert_equal(file_size, client.progress, "Download incomplete");
+	zassert_equal(server.stream_len, server.stream_pos, "Responses left on the connection");
+	zassert_equal(0, client.http.requested, "%u requests pending after the download",
+		      client.http.requested);
+
+	return frag_cnt;
+}
+
+static void requests_check(size_t file_size)
+{
+	size_t expected = DIV_ROUND_UP(file_size, FRAG_SIZE);
+
+	zassert_equal(expected, server.req_cnt, "%zu requests sent for %zu fragments",
+		      server.req_cnt, expected);
+
+	for (size_t i = 0; i < server.req_cnt; i++) {
+		zassert_equal(i * FRAG_SIZE, server.req[i].start, "Unexpected range start");
+		zassert_equal(MIN((i + 1) * FRAG_SIZE, file_size) - 1, server.req[i].end,
+			      "Unexpected range end");
+	}
+}
+
+ZTEST_SUITE(download_client_http, NULL, NULL, NULL, NULL, NULL);
+
+ZTEST(download_client_http, test_single_fragment)
+{
+	zassert_equal(1, download(FRAG_SIZE / 2));
+	requests_check(FRAG_SIZE / 2);
+}
+
+ZTEST(download_client_http, test_fragments_below_depth)
+{
+	size_t file_size = (PIPELINE_DEPTH - 1) * FRAG_SIZE;
+
+	zassert_equal(PIPELINE_DEPTH - 1, download(file_size));
+	requests_check(file_size);
+}
+
+ZTEST(download_client_http, test_fragments_above_depth)
+{
+	size_t file_size = (3 * PIPELINE_DEPTH) * FRAG_SIZE;
+
+	zassert_equal(3 * PIPELINE_DEPTH, download(file_size));
+	requests_check(file_size);
+}
+
+ZTEST(download_client_http, test_partial_last_fragment)
+{
+	size_t file_size = (2 * PIPELINE_DEPTH) * FRAG_SIZE + FRAG_SIZE / 3;
+
+	zassert_equal(2 * PIPELINE_DEPTH + 1, download(file_size));
+	requests_check(file_size);
+}
@@ -33,6 +33,9 @@
 #define TEST_PAYLOAD		"This is a test payload"
 #define TEST_PAYLOAD_LEN	(sizeof(TEST_PAYLOAD) - 1)
 
+/* Spans three chunks, the last one partial */
+#define TEST_CHUNKED_PAYLOAD_LEN	(2 * CONFIG_MQTT_HELPER_PAYLOAD_BUFFER_LEN + 10)
+
 /* Pull in variables and functions from the MQTT helper library. */
 extern struct mqtt_client mqtt_client;
 extern enum mqtt_state mqtt_state;
@@ -50,6 +53,7 @@ extern void mqtt_evt_handler(struct mqtt_client *const mqtt_client,
 extern void mqtt_helper_poll_loop(void);
 extern void on_publish(const struct mqtt_evt *mqtt_evt);
 extern char payload_buf[];
+extern uint16_t in_flight[];
 
 /* Semaphores used by tests to wait for a certain callbacks */
 static K_SEM_DEFINE(connack_success_sem, 0, 1);
@@ -60,6 +64,11 @@ static K_SEM_DEFINE(suback_sem, 0, 1);
 static K_SEM_DEFINE(publish_sem, 0, 1);
 static K_SEM_DEFINE(error_msg_size_sem, 0, 1);
 
+static int puback_result;
+static size_t chunk_read_offset;
+static size_t chunk_offset;
+static size_t chunk_count;
+
 void setUp(void)
 {
 	__cmock_mqtt_keepalive_time_left_IgnoreAndReturn(0);
@@ -69,6 +78,9 @@ void setUp(void)
 
 	/* Force all tests to start in uninitialized state. */
 	mqtt_state = MQTT_STATE_UNINIT;
+
+	/* No publications in flight. */
+	memset(in_flight, 0, CONFIG_MQTT_HELPER_PUBLISH_WINDOW * sizeof(in_flight[0]));
 }
 
 /* Stubs */
@@ -80,6 +92,19 @@ static int mqtt_readall_publish_payload_stub(struct mqtt_client *client, uint8_t
 	return 0;
 }
 
+/* Fill the payload with the low byte of each offset in the payload. */
+static int mqtt_readall_publish_payload_chunk_stub(struct mqtt_client *client, uint8_t *buffer,
+						   size_t length, int num_calls)
+{
+	for (size_t i = 0; i < length; i++) {
+		buffer[i] = (uint8_t)(chunk_read_offset + i);
+	}
+
+	chunk_read_offset += length;
+
+	return 0;
+}
+
 static int poll_stub_pollin(struct pollfd *fds, int nfds, int timeout, int num_calls)
 {
 	fds[0].revents = fds[0].events & POLLIN;
@@ -201,8 +226,28 @@ static void cb_on_disconnect(int result)
 	k_sem_give(&disconnect_sem);
 }
 
+static void cb_on_publish_chunk(struct mqtt_helper_buf topic, struct mqtt_helper_buf chunk,
+				size_t offset, size_t total_len)
+{
+	TEST_ASSERT_EQUAL(TEST_TOPIC_1_LEN, topic.size);
+	TEST_ASSERT_EQUAL_MEMORY(TEST_TOPIC_1, topic.ptr, TEST_TOPIC_1_LEN);
+	TEST_ASSERT_EQUAL(TEST_CHUNKED_PAYLOAD_LEN, total_len);
+	TEST_ASSERT_EQUAL(chunk_offset, offset);
+	TEST_ASSERT_EQUAL(MIN(total_len - offset, CONFIG_MQTT_HELPER_PAYLOAD_BUFFER_LEN),
+			  chunk.size);
+
+	for (size_t i = 0; i < chunk.size; i++) {
+		TEST_ASSERT_EQUAL_UINT8((uint8_t)(offset + i), chunk.ptr[i]);
+	}
+
+	chunk_offset += chunk.size;
+	chunk_count++;
+}
+
 static void cb_on_puback(uint16_t message_id, int result)
 {
+	puback_result = result;
+
 	if (message_id == TEST_MESSAGE_ID) {
 		k_sem_give(&puback_sem);
 	}
@@ -599,6 +644,174 @@ void test_mqtt_helper_poll_loop_pollerr(void)
 	mqtt_helper_poll_loop();
 }
 
+static void qos1_publish_param_init(struct mqtt_publish_param *param, uint16_t message_id)
+{
+	*param = (struct mqtt_publish_param) {
+		.message = {
+			.payload = {
+				.data = TEST_PAYLOAD,
+				.len = TEST_PAYLOAD_LEN,
+			},
+			.topic = {
+				.topic = {
+					.utf8 = TEST_TOPIC_1,
+					.size = TEST_TOPIC_1_LEN,
+				},
+				.qos = MQTT_QOS_1_AT_LEAST_ONCE,
+			},
+		},
+		.message_id = message_id,
+	};
+}
+
+/* The test verifies that QoS 1 publications are limited to the window until their PUBACK. */
+void test_mqtt_helper_publish_window_full(void)
+{
+	struct mqtt_publish_param param;
+
+	mqtt_state = MQTT_STATE_CONNECTED;
+
+	__cmock_mqtt_publish_ExpectAnyArgsAndReturn(0);
+	qos1_publish_param_init(&param, 1);
+	TEST_ASSERT_EQUAL(0, mqtt_helper_publish(&param));
+
+	__cmock_mqtt_publish_ExpectAnyArgsAndReturn(0);
+	qos1_publish_param_init(&param, 2);
+	TEST_ASSERT_EQUAL(0, mqtt_helper_publish(&param));
+
+	qos1_publish_param_init(&param, 3);
+	TEST_ASSERT_EQUAL(-EAGAIN, mqtt_helper_publish(&param));
+
+	send_mqtt_event(MQTT_EVT_PUBACK, 1);
+
+	__cmock_mqtt_publish_ExpectAnyArgsAndReturn(0);
+	TEST_ASSERT_EQUAL(0, mqtt_helper_publish(&param));
+}
+
+void test_mqtt_helper_publish_id_in_flight(void)
+{
+	struct mqtt_publish_param param;
+
+	mqtt_state = MQTT_STATE_CONNECTED;
+	qos1_publish_param_init(&param, 5);
+
+	__cmock_mqtt_publish_ExpectAnyArgsAndReturn(0);
+	TEST_ASSERT_EQUAL(0, mqtt_helper_publish(&param));
+	TEST_ASSERT_EQUAL(-EALREADY, mqtt_helper_publish(&param));
+}
+
+void test_mqtt_helper_publish_error_not_in_flight(void)
+{
+	struct mqtt_publish_param param;
+
+	mqtt_state = MQTT_STATE_CONNECTED;
+
+	for (int i = 0; i < CONFIG_MQTT_HELPER_PUBLISH_WINDOW + 1; i++) {
+		__cmock_mqtt_publish_ExpectAnyArgsAndReturn(-EIO);
+		qos1_publish_param_init(&param, 10 + i);
+		TEST_ASSERT_EQUAL(-EIO, mqtt_helper_publish(&param));
+	}
+
+	__cmock_mqtt_publish_ExpectAnyArgsAndReturn(0);
+	TEST_ASSERT_EQUAL(0, mqtt_helper_publish(&param));
+}
+
+void test_mqtt_helper_publish_qos0_not_in_flight(void)
+{
+	struct mqtt_publish_param param;
+
+	mqtt_state = MQTT_STATE_CONNECTED;
+	qos1_publish_param_init(&param, 20);
+	param.message.topic.qos = MQTT_QOS_0_AT_MOST_ONCE;
+
+	for (int i = 0; i < CONFIG_MQTT_HELPER_PUBLISH_WINDOW + 1; i++) {
+		__cmock_mqtt_publish_ExpectAnyArgsAndReturn(0);
+		TEST_ASSERT_EQUAL(0, mqtt_helper_publish(&param));
+	}
+}
+
+/* The test verifies that the publications in flight are reported when the connection is lost. */
+void test_on_disconnect_in_flight_released(void)
+{
+	struct mqtt_publish_param param;
+	struct mqtt_helper_cfg cfg = {
+		.cb = {
+			.on_disconnect = cb_on_disconnect,
+			.on_puback = cb_on_puback,
+		},
+	};
+
+	TEST_ASSERT_EQUAL(0, mqtt_helper_init(&cfg));
+	mqtt_state = MQTT_STATE_CONNECTED;
+	qos1_publish_param_init(&param, TEST_MESSAGE_ID);
+
+	__cmock_mqtt_publish_ExpectAnyArgsAndReturn(0);
+	TEST_ASSERT_EQUAL(0, mqtt_helper_publish(&param));
+
+	puback_result = 0;
+	send_mqtt_event(MQTT_EVT_DISCONNECT, 0);
+
+	TEST_ASSERT_EQUAL(0, k_sem_take(&puback_sem, K_SECONDS(1)));
+	TEST_ASSERT_EQUAL(-ENOTCONN, puback_result);
+	TEST_ASSERT_EQUAL(0, k_sem_take(&disconnect_sem, K_SECONDS(1)));
+	TEST_ASSERT_EQUAL(0, in_flight[0]);
+}
+
+void test_mqtt_helper_msg_id_get(void)
+{
+	uint16_t id = mqtt_helper_msg_id_get();
+
+	TEST_ASSERT_NOT_EQUAL(0, id);
+
+	/* IDs in flight are skipped. */
+	in_flight[0] = id + 1;
+	TEST_ASSERT_EQUAL(id + 2, mqtt_helper_msg_id_get());
+}
+
+/* The test verifies that a payload larger than the payload buffer is delivered in chunks,
+ * and acknowledged once.
+ */
+void test_on_publish_chunked(void)
+{
+	struct mqtt_helper_cfg cfg = {
+		.cb = {
+			.on_publish_chunk = cb_on_publish_chunk,
+		},
+	};
+	struct mqtt_evt evt = {
+		.type = MQTT_EVT_PUBLISH,
+		.param.publish = {
+			.message = {
+				.topic = {
+					.topic = {
+						.utf8 = TEST_TOPIC_1,
+						.size = TEST_TOPIC_1_LEN,
+					},
+					.qos = MQTT_QOS_1_AT_LEAST_ONCE,
+				},
+				.payload.len = TEST_CHUNKED_PAYLOAD_LEN,
+			},
+			.message_id = TEST_MESSAGE_ID,
+		},
+	};
+
+	TEST_ASSERT_EQUAL(0, mqtt_helper_init(&cfg));
+
+	chunk_read_offset = 0;
+	chunk_offset = 0;
+	chunk_count = 0;
+
+	__cmock_mqtt_readall_publish_payload_Stub(mqtt_readall_publish_payload_chunk_stub);
+	__cmock_mqtt_publish_qos1_ack_ExpectAnyArgsAndReturn(0);
+
+	mqtt_evt_handler(&mqtt_client, &evt);
+
+	TEST_ASSERT_EQUAL(3, chunk_count);
+	TEST_ASSERT_EQUAL(TEST_CHUNKED_PAYLOAD_LEN, chunk_offset);
+
+	TEST_ASSERT_EQUAL(0, mqtt_helper_deinit());
+}
+
 int main(void)
 {
 	(void)unity_main();
@@ -0,0 +1,15 @@
+/*
+ * Copyright (c) 2024 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#ifndef NRF_CLOUD_COAP_TRANSPORT_H_
+#define NRF_CLOUD_COAP_TRANSPORT_H_
+
+#include <stdbool.h>
+
+/* The queue only needs the connection state, which the test controls */
+bool nrf_cloud_coap_is_connected(void);
+
+#endif /* NRF_CLOUD_COAP_TRANSPORT_H_ */
@@ -0,0 +1,91 @@
+/*
+ * Copyright (c) 2024 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#include <stdlib.h>
+#include <string.h>
+#include <zephyr/ztest.h>
+
+#include "batch.h"
+#include "nrf_cloud_coap_queue.h"
+#include "nrf_cloud_coap_transport.h"
+
+struct batch_log batch_log;
+bool batch_connected;
+int batch_send_err;
+
+void batch_log_reset(void)
+{
+	memset(&batch_log, 0, sizeof(batch_log));
+}
+
+size_t batch_msg_encode(uint8_t *buf, size_t len, uint16_t seq)
+{
+	char hdr[BATCH_MSG_LEN_MIN];
+
+	__ASSERT_NO_MSG(len >= BATCH_MSG_LEN_MIN);
+
+	/* The data string is padded up to the message length */
+	snprintk(hdr, sizeof(hdr), "{\"seq\":%05u,\"data\":\"", seq);
+	memcpy(buf, hdr, BATCH_MSG_LEN_MIN - 2);
+	memset(&buf[BATCH_MSG_LEN_MIN - 2], 'a', len - BATCH_MSG_LEN_MIN);
+	memcpy(&buf[len - 2], "\"}", 2);
+
+	return len;
+}
+
+/* Decode the message at the start of buf and return its length */
+static size_t msg_decode(const uint8_t *buf, size_t len, uint16_t *seq)
+{
+	const uint8_t *end;
+
+	zassert_true(len >= BATCH_MSG_LEN_MIN);
+	zassert_mem_equal(buf, "{\"seq\":", 7);
+	*seq = strtoul((const char *)&buf[7], NULL, 10);
+
+	end = memchr(buf, '}', len);
+	zassert_not_null(end, "message not closed");
+
+	return end - buf + 1;
+}
+
+bool nrf_cloud_coap_is_connected(void)
+{
+	return batch_connected;
+}
+
+int nrf_cloud_coap_queue_batch_send(const uint8_t *buf, size_t len)
+{
+	size_t pos = 1;
+
+	if (batch_send_err) {
+		return batch_send_err;
+	}
+
+	/* The batch must be one JSON array of messages, as the bulk resource expects */
+	zassert_true(len >= 2 + BATCH_MSG_LEN_MIN);
+	zassert_equal(buf[0], '[', "not an array: %c", buf[0]);
+	zassert_equal(buf[len - 1], ']', "array not closed: %c", buf[len - 1]);
+
+	while (true) {
+		zassert_true(batch_log.msg_cnt < BATCH_SEQ_MAX);
+		pos += msg_decode(&buf[pos], len - 1 - pos, &batch_log.seq[batch_log.msg_cnt++]);
+
+		if (pos == len - 1) {
+			break;
+		}
+
+		zassert_equal(buf[pos], ',', "messages not separated at %zu", pos);
+		pos++;
+	}
+
+	zassert_true(len <= CONFIG_COAP_CLIENT_BLOCK_SIZE - CONFIG_COAP_CLIENT_MESSAGE_HEADER_SIZE);
+
+	batch_log.batch_cnt++;
+	batch_log.bytes += len;
+	batch_log.batch_len_max = MAX(batch_log.batch_len_max, len);
+
+	return 0;
+}
@@ -0,0 +1,38 @@
+/*
+ * Copyright (c) 2024 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#ifndef BATCH_H_
+#define BATCH_H_
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#define BATCH_SEQ_MAX 2048
+
+/* What the mocked CoAP library received */
+struct batch_log {
+	/* Sequence numbers of the messages, in the order they were received */
+	uint16_t seq[BATCH_SEQ_MAX];
+	size_t msg_cnt;
+	size_t batch_cnt;
+	size_t bytes;
+	size_t batch_len_max;
+};
+
+extern struct batch_log batch_log;
+extern bool batch_connected;
+extern int batch_send_err;
+
+void batch_log_reset(void);
+
+/* Shortest test message, {"seq":NNNNN,"data":""} */
+#define BATCH_MSG_LEN_MIN 24
+
+/* Encode a JSON message of len bytes with the sequence number */
+size_t batch_msg_encode(uint8_t *buf, size_t len, uint16_t seq);
+
+#endif /* BATCH_H_ */
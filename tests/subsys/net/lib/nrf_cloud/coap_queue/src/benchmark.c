@@ -0,0 +1,77 @@
+/*
+ * Copyright (c) 2024 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#include <zephyr/ztest.h>
+#include <zephyr/kernel.h>
+#include <net/nrf_cloud_coap.h>
+
+#include "batch.h"
+#include "nrf_cloud_coap_queue.h"
+
+#define BENCH_MSG_CNT 200
+/* Like a JSON sensor message:
+ * {"appId":"TEMP","messageType":"DATA","ts":1700000000000,"data":23.5}
+ */
+#define BENCH_MSG_LEN 68
+
+/* Estimated bytes sent per request, besides the payload: IPv4 and UDP headers (28),
+ * DTLS 1.2 record header with the AES-CCM-8 nonce and tag (29), and the CoAP header,
+ * token and options (about 20).
+ */
+#define REQUEST_OVERHEAD (28 + 29 + 20)
+
+ZTEST(nrf_cloud_coap_queue_benchmark, test_benchmark_batching)
+{
+	uint8_t msg[BENCH_MSG_LEN];
+	uint32_t append_cycles = 0;
+	uint32_t flush_cycles;
+	uint32_t start;
+	size_t single_bytes;
+	size_t batch_bytes;
+
+	batch_connected = true;
+	zassert_ok(nrf_cloud_coap_queue_flush());
+	batch_log_reset();
+
+	/* Offline, so that the count policy does not flush meanwhile */
+	batch_connected = false;
+	for (int i = 0; i < BENCH_MSG_CNT; i++) {
+		batch_msg_encode(msg, sizeof(msg), i);
+		start = k_cycle_get_32();
+		zassert_ok(nrf_cloud_coap_queue_append(msg, sizeof(msg)));
+		append_cycles += k_cycle_get_32() - start;
+	}
+
+	batch_connected = true;
+	start = k_cycle_get_32();
+	zassert_ok(nrf_cloud_coap_queue_flush());
+	flush_cycles = k_cycle_get_32() - start;
+	zassert_equal(batch_log.msg_cnt, BENCH_MSG_CNT);
+
+	single_bytes = BENCH_MSG_CNT * (BENCH_MSG_LEN + REQUEST_OVERHEAD);
+	batch_bytes = batch_log.bytes + (batch_log.batch_cnt * REQUEST_OVERHEAD);
+
+	/* Each request wakes up the radio, so the count matters most */
+	zassert_true(batch_log.batch_cnt * 10 <= BENCH_MSG_CNT);
+	zassert_true(batch_bytes < single_bytes);
+
+	TC_PRINT("%d messages of %d bytes: one by one %d requests, about %zu bytes; "
+		 "batched %zu requests, about %zu bytes\n",
+		 BENCH_MSG_CNT, BENCH_MSG_LEN, BENCH_MSG_CNT, single_bytes,
+		 batch_log.batch_cnt, batch_bytes);
+	TC_PRINT("Queueing %u us per message, flushing %u us per message\n",
+		 (uint32_t)k_cyc_to_us_floor64(append_cycles / BENCH_MSG_CNT),
+		 (uint32_t)k_cyc_to_us_floor64(flush_cycles / BENCH_MSG_CNT));
+}
+
+static void *benchmark_setup(void)
+{
+	zassert_ok(nrf_cloud_coap_queue_init());
+
+	return NULL;
+}
+
+ZTEST_SUITE(nrf_cloud_coap_queue_benchmark, NULL, benchmark_setup, NULL, NULL, NULL);
@@ -0,0 +1,183 @@
+/*
+ * Copyright (c) 2024 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#include <zephyr/ztest.h>
+#include <zephyr/net/coap.h>
+#include <net/nrf_cloud_coap.h>
+
+#include "batch.h"
+#include "nrf_cloud_coap_queue.h"
+
+#define BATCH_SIZE      (CONFIG_COAP_CLIENT_BLOCK_SIZE - CONFIG_COAP_CLIENT_MESSAGE_HEADER_SIZE)
+#define BATCH_DATA_SIZE (BATCH_SIZE - NRF_CLOUD_COAP_QUEUE_ARRAY_OVERHEAD)
+
+static uint16_t next_seq;
+
+static void msgs_queue(size_t cnt, size_t len)
+{
+	uint8_t msg[UINT8_MAX];
+
+	for (size_t i = 0; i < cnt; i++) {
+		zassert_ok(nrf_cloud_coap_queue_append(msg, batch_msg_encode(msg, len, next_seq)));
+		next_seq++;
+	}
+}
+
+/* The messages must be received once, in order */
+static void msgs_check(uint16_t first, size_t cnt)
+{
+	zassert_equal(batch_log.msg_cnt, cnt);
+	for (size_t i = 0; i < cnt; i++) {
+		zassert_equal(batch_log.seq[i], first + i, "message %zu", i);
+	}
+}
+
+ZTEST(nrf_cloud_coap_queue, test_batches_fit_block)
+{
+	/* Each message but the first is preceded by a comma */
+	const size_t per_batch = (BATCH_DATA_SIZE + 1) / (40 + 1);
+
+	batch_connected = false;
+	msgs_queue(100, 40);
+	zassert_equal(nrf_cloud_coap_queue_count(), 100);
+	zassert_equal(nrf_cloud_coap_queue_flush(), -EACCES);
+	zassert_equal(nrf_cloud_coap_queue_count(), 100);
+
+	batch_connected = true;
+	zassert_ok(nrf_cloud_coap_queue_flush());
+	zassert_equal(nrf_cloud_coap_queue_count(), 0);
+	zassert_equal(batch_log.batch_cnt, DIV_ROUND_UP(100, per_batch));
+	zassert_equal(batch_log.batch_len_max,
+		      NRF_CLOUD_COAP_QUEUE_ARRAY_OVERHEAD + (per_batch * (40 + 1)) - 1);
+	msgs_check(0, 100);
+}
+
+ZTEST(nrf_cloud_coap_queue, test_flush_on_count)
+{
+	msgs_queue(CONFIG_NRF_CLOUD_COAP_QUEUE_FLUSH_COUNT - 1, 32);
+	k_sleep(K_MSEC(100));
+	zassert_equal(batch_log.batch_cnt, 0);
+
+	msgs_queue(1, 32);
+	for (int i = 0; (i < 100) && nrf_cloud_coap_queue_count(); i++) {
+		k_sleep(K_MSEC(10));
+	}
+
+	zassert_equal(nrf_cloud_coap_queue_count(), 0);
+	zassert_equal(batch_log.batch_cnt, 1);
+	msgs_check(0, CONFIG_NRF_CLOUD_COAP_QUEUE_FLUSH_COUNT);
+}
+
+ZTEST(nrf_cloud_coap_queue, test_send_failure_keeps_messages)
+{
+	batch_connected = false;
+	msgs_queue(10, 40);
+	batch_connected = true;
+
+	batch_send_err = -EIO;
+	zassert_equal(nrf_cloud_coap_queue_flush(), -EIO);
+	zassert_equal(nrf_cloud_coap_queue_count(), 10);
+
+	/* Unauthorized may be temporary */
+	batch_send_err = COAP_RESPONSE_CODE_UNAUTHORIZED;
+	zassert_equal(nrf_cloud_coap_queue_flush(), COAP_RESPONSE_CODE_UNAUTHORIZED);
+	zassert_equal(nrf_cloud_coap_queue_count(), 10);
+
+	batch_send_err = 0;
+	zassert_ok(nrf_cloud_coap_queue_flush());
+	msgs_check(0, 10);
+}
+
+ZTEST(nrf_cloud_coap_queue, test_rejected_batch_dropped)
+{
+	batch_connected = false;
+	msgs_queue(5, 40);
+	batch_connected = true;
+
+	/* Sending it again would fail again, and block the queue */
+	batch_send_err = COAP_RESPONSE_CODE_BAD_REQUEST;
+	zassert_ok(nrf_cloud_coap_queue_flush());
+	zassert_equal(nrf_cloud_coap_queue_count(), 0);
+
+	batch_send_err = 0;
+	msgs_queue(3, 40);
+	zassert_ok(nrf_cloud_coap_queue_flush());
+	msgs_check(5, 3);
+}
+
+ZTEST(nrf_cloud_coap_queue, test_full_queue_drops_oldest)
+{
+	const size_t cnt = 600;
+	size_t queued;
+
+	batch_connected = false;
+	msgs_queue(cnt, 64);
+	queued = nrf_cloud_coap_queue_count();
+	zassert_true((queued > 0) && (queued < cnt), "%zu queued", queued);
+
+	batch_connected = true;
+	zassert_ok(nrf_cloud_coap_queue_flush());
+	msgs_check(cnt - queued, queued);
+}
+
+ZTEST(nrf_cloud_coap_queue, test_sent_pages_reused)
+{
+	/* Many times the capacity of the queue goes through it without loss */
+	for (int i = 0; i < 40; i++) {
+		batch_connected = false;
+		msgs_queue(50, 64);
+		batch_connected = true;
+		zassert_ok(nrf_cloud_coap_queue_flush());
+	}
+
+	msgs_check(0, 40 * 50);
+}
+
+ZTEST(nrf_cloud_coap_queue, test_largest_message)
+{
+	static uint8_t msg[BATCH_DATA_SIZE];
+
+	batch_connected = false;
+	zassert_ok(nrf_cloud_coap_queue_append(msg, batch_msg_encode(msg, sizeof(msg), 0)));
+	next_seq = 1;
+	msgs_queue(1, 40);
+	batch_connected = true;
+
+	/* Alone in its batch, the message fills the block with the array brackets */
+	zassert_ok(nrf_cloud_coap_queue_flush());
+	zassert_equal(batch_log.batch_cnt, 2);
+	zassert_equal(batch_log.batch_len_max, BATCH_SIZE);
+	msgs_check(0, 2);
+}
+
+ZTEST(nrf_cloud_coap_queue, test_message_too_big)
+{
+	static uint8_t msg[BATCH_DATA_SIZE + 1];
+
+	zassert_equal(nrf_cloud_coap_queue_append(msg, sizeof(msg)), -EMSGSIZE);
+	zassert_equal(nrf_cloud_coap_queue_count(), 0);
+}
+
+static void *queue_setup(void)
+{
+	zassert_ok(nrf_cloud_coap_queue_init());
+
+	return NULL;
+}
+
+static void queue_before(void *fixture)
+{
+	ARG_UNUSED(fixture);
+
+	/* Start empty */
+	batch_connected = true;
+	batch_send_err = 0;
+	zassert_ok(nrf_cloud_coap_queue_flush());
+	batch_log_reset();
+	next_seq = 0;
+}
+
+ZTEST_SUITE(nrf_cloud_coap_queue, NULL, queue_setup, queue_before, NULL, NULL);
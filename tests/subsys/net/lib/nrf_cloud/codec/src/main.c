@@ -0,0 +1,432 @@
+/*
+ * Copyright (c) 2024 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#include <stdlib.h>
+#include <string.h>
+#include <zephyr/ztest.h>
+#include <net/nrf_cloud.h>
+#include <net/nrf_cloud_os.h>
+#include <net/nrf_cloud_codec.h>
+#include <net/wifi_location_common.h>
+
+#include "nrf_cloud_codec_internal.h"
+#include "nrf_cloud_mem.h"
+
+/* The same messages are expected with and without CONFIG_NRF_CLOUD_JSON_WRITER */
+#define DEVICE_JSON								\
+	"\"device\":{\"serviceInfo\":{\"fota_v2\":[\"BOOT\",\"APP\",\"MDM_FULL\"],"	\
+	"\"ui\":[\"GNSS\",\"TEMP\",\"RSRP\",\"LOG\"]},"					\
+	"\"connectionInfo\":{\"protocol\":\"MQTT\",\"method\":\"LTE\"}}"
+
+#define LTE_JSON								\
+	"\"lte\":[{\"eci\":19088743,\"mcc\":242,\"mnc\":1,\"tac\":12345,"		\
+	"\"earfcn\":6300,\"rsrp\":-90,\"rsrq\":-9.5,\"adv\":80,"			\
+	"\"nmr\":[{\"earfcn\":6300,\"pci\":42,\"rsrp\":-100,\"rsrq\":-10,"		\
+	"\"timeDiff\":24},{\"earfcn\":1650,\"pci\":7}]},"				\
+	"{\"eci\":9029,\"mcc\":242,\"mnc\":2,\"tac\":7,\"rsrp\":-110,\"adv\":20512}]"
+
+#define WIFI_JSON								\
+	"\"wifi\":{\"accessPoints\":["							\
+	"{\"macAddress\":\"40:9b:cd:10:00:01\",\"signalStrength\":-45,"		\
+	"\"ssid\":\"home\",\"channel\":6},"						\
+	"{\"macAddress\":\"40:9b:cd:10:00:02\"},"					\
+	"{\"macAddress\":\"60:9b:cd:10:00:03\",\"signalStrength\":-70,"		\
+	"\"ssid\":\"office\",\"channel\":11}]}"
+
+/* Each allocation is prefixed with its size, to track the heap usage */
+struct alloc_hdr {
+	size_t size;
+} __aligned(8);
+
+static size_t heap_used;
+static size_t heap_peak;
+static uint32_t alloc_cnt;
+
+static void *tracking_malloc(size_t size)
+{
+	struct alloc_hdr *hdr = malloc(sizeof(*hdr) + size);
+
+	if (!hdr) {
+		return NULL;
+	}
+
+	hdr->size = size;
+	heap_used += size;
+	heap_peak = MAX(heap_peak, heap_used);
+	alloc_cnt++;
+
+	return hdr + 1;
+}
+
+static void *tracking_calloc(size_t count, size_t size)
+{
+	void *ptr = tracking_malloc(count * size);
+
+	if (ptr) {
+		memset(ptr, 0, count * size);
+	}
+
+	return ptr;
+}
+
+static void tracking_free(void *ptr)
+{
+	struct alloc_hdr *hdr;
+
+	if (!ptr) {
+		return;
+	}
+
+	hdr = (struct alloc_hdr *)ptr - 1;
+	heap_used -= hdr->size;
+	free(hdr);
+}
+
+/* Must only be called when all the tracked memory is freed */
+static void tracking_reset(void)
+{
+	zassert_equal(heap_used, 0, "%zu bytes leaked", heap_used);
+
+	heap_peak = 0;
+	alloc_cnt = 0;
+}
+
+static struct lte_lc_ncell ncells[] = {
+	{
+		.earfcn = 6300,
+		.phys_cell_id = 42,
+		.rsrp = 40,
+		.rsrq = 19,
+		.time_diff = 24,
+	},
+	{
+		.earfcn = 1650,
+		.phys_cell_id = 7,
+		.rsrp = NRF_CLOUD_LOCATION_CELL_OMIT_RSRP,
+		.rsrq = NRF_CLOUD_LOCATION_CELL_OMIT_RSRQ,
+		.time_diff = LTE_LC_CELL_TIME_DIFF_INVALID,
+	},
+};
+
+static struct lte_lc_cell gci_cells[] = {
+	{
+		.mcc = 242,
+		.mnc = 2,
+		.id = 9029,
+		.tac = 7,
+		.earfcn = NRF_CLOUD_LOCATION_CELL_OMIT_EARFCN,
+		.rsrp = 30,
+		.rsrq = NRF_CLOUD_LOCATION_CELL_OMIT_RSRQ,
+		/* Above the maximum, so it is capped */
+		.timing_advance = 30000,
+	},
+};
+
+static const struct lte_lc_cells_info cells = {
+	.current_cell = {
+		.mcc = 242,
+		.mnc = 1,
+		.id = 19088743,
+		.tac = 12345,
+		.earfcn = 6300,
+		.rsrp = 50,
+		.rsrq = 20,
+		.timing_advance = 80,
+	},
+	.ncells_count = ARRAY_SIZE(ncells),
+	.neighbor_cells = ncells,
+	.gci_cells_count = ARRAY_SIZE(gci_cells),
+	.gci_cells = gci_cells,
+};
+
+static struct wifi_scan_result aps[] = {
+	{
+		.mac = { 0x40, 0x9b, 0xcd, 0x10, 0x00, 0x01 },
+		.mac_length = WIFI_MAC_ADDR_LEN,
+		.rssi = -45,
+		.channel = 6,
+		.ssid = "home",
+		.ssid_length = 4,
+	},
+	/* Local MAC address, which is skipped */
+	{
+		.mac = { 0x02, 0x00, 0x00, 0x00, 0x00, 0x01 },
+		.mac_length = WIFI_MAC_ADDR_LEN,
+		.rssi = -30,
+		.channel = 1,
+	},
+	{
+		.mac = { 0x40, 0x9b, 0xcd, 0x10, 0x00, 0x02 },
+		.mac_length = WIFI_MAC_ADDR_LEN,
+		.rssi = NRF_CLOUD_LOCATION_WIFI_OMIT_RSSI,
+		.channel = NRF_CLOUD_LOCATION_WIFI_OMIT_CHAN,
+	},
+	{
+		.mac = { 0x60, 0x9b, 0xcd, 0x10, 0x00, 0x03 },
+		.mac_length = WIFI_MAC_ADDR_LEN,
+		.rssi = -70,
+		.channel = 11,
+		.ssid = "office",
+		.ssid_length = 6,
+	},
+};
+
+static const struct wifi_scan_info wifi = {
+	.ap_info = aps,
+	.cnt = ARRAY_SIZE(aps),
+};
+
+/* Only one access point with a non-local MAC address */
+static const struct wifi_scan_info wifi_too_few = {
+	.ap_info = aps,
+	.cnt = 2,
+};
+
+/* Checks an encoded message and the peak heap use of its encoding */
+static void encoded_check(const char *name, int ret, const struct nrf_cloud_data *out,
+			  const char *expected)
+{
+	zassert_ok(ret, "%s: encoding failed: %d", name, ret);
+	zassert_not_null(out->ptr, "%s: no output", name);
+	zassert_str_equal(out->ptr, expected);
+	zassert_equal(out->len, strlen(expected), "%s: wrong length", name);
+
+	TC_PRINT("%s (%zu bytes): %u allocations, %zu bytes peak heap\n", name, out->len,
+		 alloc_cnt, heap_peak);
+
+#if defined(CONFIG_NRF_CLOUD_JSON_WRITER)
+	/* The output buffer is the only allocation */
+	zassert_equal(alloc_cnt, 1, "%s: %u allocations", name, alloc_cnt);
+	zassert_equal(heap_peak, out->len + 1, "%s: %zu bytes peak heap", name, heap_peak);
+#else
+	/* The cJSON objects and the printed copies take more than the writer output buffer */
+	zassert_true(heap_peak > out->len + 1, "%s: %zu bytes peak heap", name, heap_peak);
+#endif
+}
+
+static void sensor_data_check(const char *name, const struct nrf_cloud_sensor_data *sensor,
+			      const char *expected)
+{
+	struct nrf_cloud_data out = {0};
+	int ret;
+
+	tracking_reset();
+	ret = nrf_cloud_sensor_data_encode(sensor, &out);
+	encoded_check(name, ret, &out, expected);
+	nrf_cloud_free((void *)out.ptr);
+}
+
+static void dev_status_check(const char *name, const struct nrf_cloud_device_status *ds,
+			     bool include_state, bool include_reported, const char *expected)
+{
+	struct nrf_cloud_data out = {0};
+	int ret;
+
+	tracking_reset();
+	ret = nrf_cloud_shadow_dev_status_encode(ds, &out, include_state, include_reported);
+	encoded_check(name, ret, &out, expected);
+	nrf_cloud_device_status_free(&out);
+}
+
+/* Location request encoded like nrf_cloud_rest_location_get() does without the JSON writer */
+static int location_obj_encode(struct lte_lc_cells_info const *const cells_inf,
+			       struct wifi_scan_info const *const wifi_inf,
+			       struct nrf_cloud_data *const out)
+{
+	NRF_CLOUD_OBJ_JSON_DEFINE(obj);
+	int ret;
+
+	ret = nrf_cloud_obj_init(&obj);
+	if (ret) {
+		return ret;
+	}
+
+	ret = nrf_cloud_obj_location_request_payload_add(&obj, cells_inf, wifi_inf);
+	if (!ret) {
+		ret = nrf_cloud_obj_cloud_encode(&obj);
+	}
+
+	(void)nrf_cloud_obj_free(&obj);
+
+	/* Freed with nrf_cloud_free(), which uses the same hooks as cJSON in this test */
+	if (!ret) {
+		*out = obj.encoded_data;
+	}
+
+	return ret;
+}
+
+static int location_encode(struct lte_lc_cells_info const *const cells_inf,
+			   struct wifi_scan_info const *const wifi_inf,
+			   struct nrf_cloud_data *const out)
+{
+#if defined(CONFIG_NRF_CLOUD_JSON_WRITER)
+	return nrf_cloud_location_req_json_encode(cells_inf, wifi_inf, out);
+#else
+	return location_obj_encode(cells_inf, wifi_inf, out);
+#endif
+}
+
+static void location_check(const char *name, struct lte_lc_cells_info const *const cells_inf,
+			   struct wifi_scan_info const *const wifi_inf, const char *expected)
+{
+	struct nrf_cloud_data out = {0};
+	int ret;
+
+	tracking_reset();
+	ret = location_encode(cells_inf, wifi_inf, &out);
+	encoded_check(name, ret, &out, expected);
+	nrf_cloud_free((void *)out.ptr);
+}
+
+ZTEST(nrf_cloud_codec, test_sensor_data_encode)
+{
+	const struct nrf_cloud_sensor_data temp = {
+		.type = NRF_CLOUD_SENSOR_TEMP,
+		.data = { .ptr = "24.5", .len = 4 },
+		.ts_ms = 1700000000123,
+	};
+	const struct nrf_cloud_sensor_data humid = {
+		.type = NRF_CLOUD_SENSOR_HUMID,
+		.data = { .ptr = "40", .len = 2 },
+		.ts_ms = NRF_CLOUD_NO_TIMESTAMP,
+	};
+
+	sensor_data_check("Sensor data", &temp,
+			  "{\"appId\":\"TEMP\",\"data\":\"24.5\",\"messageType\":\"DATA\","
+			  "\"ts\":1700000000123}");
+	sensor_data_check("Sensor data without timestamp", &humid,
+			  "{\"appId\":\"HUMID\",\"data\":\"40\",\"messageType\":\"DATA\"}");
+}
+
+ZTEST(nrf_cloud_codec, test_shadow_dev_status_encode)
+{
+	struct nrf_cloud_svc_info_fota fota = {
+		.bootloader = 1,
+		.application = 1,
+		.modem_full = 1,
+	};
+	struct nrf_cloud_svc_info_ui ui = {
+		.gnss = 1,
+		.temperature = 1,
+		.rsrp = 1,
+		.log = 1,
+	};
+	struct nrf_cloud_svc_info svc = {
+		.fota = &fota,
+		.ui = &ui,
+	};
+	const struct nrf_cloud_device_status ds = {
+		.svc = &svc,
+		.conn_inf = NRF_CLOUD_INFO_SET,
+	};
+
+	dev_status_check("Device status", &ds, false, false,
+			 "{" DEVICE_JSON "}");
+	dev_status_check("Device status, reported", &ds, false, true,
+			 "{\"reported\":{" DEVICE_JSON "}}");
+	dev_status_check("Device status, state and reported", &ds, true, true,
+			 "{\"state\":{\"reported\":{" DEVICE_JSON "}}}");
+}
+
+ZTEST(nrf_cloud_codec, test_shadow_dev_status_encode_clear)
+{
+	struct nrf_cloud_svc_info svc = {
+		.fota = NULL,
+		.ui = NULL,
+	};
+	const struct nrf_cloud_device_status ds = {
+		.svc = &svc,
+		.conn_inf = NRF_CLOUD_INFO_CLEAR,
+	};
+
+	dev_status_check("Device status, cleared", &ds, false, true,
+			 "{\"reported\":{\"device\":{\"serviceInfo\":{\"fota_v2\":null,"
+			 "\"ui\":null},\"connectionInfo\":null}}}");
+}
+
+ZTEST(nrf_cloud_codec, test_shadow_dev_status_encode_invalid)
+{
+	const struct nrf_cloud_device_status ds = {0};
+	struct nrf_cloud_data out = {0};
+
+	zassert_equal(nrf_cloud_shadow_dev_status_encode(&ds, &out, true, false), -EINVAL);
+	zassert_equal(nrf_cloud_shadow_dev_status_encode(NULL, &out, false, true), -EINVAL);
+	zassert_is_null(out.ptr);
+}
+
+ZTEST(nrf_cloud_codec, test_location_req_encode)
+{
+	location_check("Cellular location request", &cells, NULL,
+		       "{" LTE_JSON "}");
+	location_check("Wi-Fi location request", NULL, &wifi,
+		       "{" WIFI_JSON "}");
+	location_check("Cellular and Wi-Fi location request", &cells, &wifi,
+		       "{" LTE_JSON "," WIFI_JSON "}");
+	/* Not enough access points, so the request is cellular only */
+	location_check("Location request without Wi-Fi", &cells, &wifi_too_few,
+		       "{" LTE_JSON "}");
+}
+
+ZTEST(nrf_cloud_codec, test_location_req_encode_no_data)
+{
+	const struct lte_lc_cells_info no_cells = {
+		.current_cell.id = LTE_LC_CELL_EUTRAN_ID_INVALID,
+	};
+	struct nrf_cloud_data out = {0};
+
+	tracking_reset();
+	zassert_equal(location_encode(&no_cells, NULL, &out), -ENODATA);
+	zassert_equal(location_encode(NULL, &wifi_too_few, &out), -ENODATA);
+	zassert_equal(location_encode(NULL, NULL, &out), -EINVAL);
+	zassert_is_null(out.ptr);
+	zassert_equal(heap_used, 0, "%zu bytes leaked", heap_used);
+}
+
+#if defined(CONFIG_NRF_CLOUD_JSON_WRITER)
+/* Both location request encoders are built with the JSON writer, so compare them directly */
+ZTEST(nrf_cloud_codec, test_location_req_same_as_obj)
+{
+	struct nrf_cloud_data writer_out = {0};
+	struct nrf_cloud_data obj_out = {0};
+	size_t writer_peak;
+
+	tracking_reset();
+	zassert_ok(nrf_cloud_location_req_json_encode(&cells, &wifi, &writer_out));
+	writer_peak = heap_peak;
+	nrf_cloud_free((void *)writer_out.ptr);
+
+	tracking_reset();
+	zassert_ok(location_obj_encode(&cells, &wifi, &obj_out));
+
+	TC_PRINT("Location request (%zu bytes): writer %zu bytes, cJSON %zu bytes peak heap\n",
+		 obj_out.len, writer_peak, heap_peak);
+	zassert_true(writer_peak < heap_peak);
+	nrf_cloud_free((void *)obj_out.ptr);
+
+	zassert_ok(nrf_cloud_location_req_json_encode(&cells, &wifi, &writer_out));
+	zassert_ok(location_obj_encode(&cells, &wifi, &obj_out));
+	zassert_str_equal(writer_out.ptr, obj_out.ptr);
+	nrf_cloud_free((void *)writer_out.ptr);
+	nrf_cloud_free((void *)obj_out.ptr);
+}
+#endif /* CONFIG_NRF_CLOUD_JSON_WRITER */
+
+static void *codec_setup(void)
+{
+	struct nrf_cloud_os_mem_hooks hooks = {
+		.malloc_fn = tracking_malloc,
+		.calloc_fn = tracking_calloc,
+		.free_fn = tracking_free,
+	};
+
+	/* Also sets the cJSON hooks */
+	nrf_cloud_os_mem_hooks_init(&hooks);
+
+	return NULL;
+}
+
+ZTEST_SUITE(nrf_cloud_codec, NULL, codec_setup, NULL, NULL, NULL);
@@ -0,0 +1,52 @@
+/*
+ * Copyright (c) 2024 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#include <zephyr/kernel.h>
+#include <net/nrf_cloud_log.h>
+
+#include "nrf_cloud_fsm.h"
+#include "nrf_cloud_transport.h"
+
+/* Transport and state of the nRF Cloud library, which the tested encoders do not use */
+int nct_dc_send(const struct nct_dc_data *dc)
+{
+	ARG_UNUSED(dc);
+
+	return -ENOTSUP;
+}
+
+void nct_dc_endpoint_get(struct nrf_cloud_data *tx_endpoint,
+			 struct nrf_cloud_data *rx_endpoint,
+			 struct nrf_cloud_data *bulk_endpoint,
+			 struct nrf_cloud_data *bin_endpoint,
+			 struct nrf_cloud_data *m_endpoint)
+{
+	ARG_UNUSED(tx_endpoint);
+	ARG_UNUSED(rx_endpoint);
+	ARG_UNUSED(bulk_endpoint);
+	ARG_UNUSED(bin_endpoint);
+	ARG_UNUSED(m_endpoint);
+}
+
+void nct_set_topic_prefix(const char *topic_prefix)
+{
+	ARG_UNUSED(topic_prefix);
+}
+
+enum nfsm_state nfsm_get_current_state(void)
+{
+	return STATE_IDLE;
+}
+
+void nrf_cloud_log_control_set(int log_level)
+{
+	ARG_UNUSED(log_level);
+}
+
+int nrf_cloud_log_control_get(void)
+{
+	return 0;
+}
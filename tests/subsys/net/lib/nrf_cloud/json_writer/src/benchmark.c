@@ -0,0 +1,233 @@
+/*
+ * Copyright (c) 2024 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#include <stdlib.h>
+#include <string.h>
+#include <zephyr/ztest.h>
+#include <zephyr/kernel.h>
+#include <cJSON.h>
+
+#include "nrf_cloud_json_writer.h"
+
+#define BENCH_RUNS (16)
+#define BENCH_AP_CNT (20)
+
+/* Each allocation is prefixed with its size, to track the heap usage */
+struct alloc_hdr {
+	size_t size;
+} __aligned(8);
+
+static size_t heap_used;
+static size_t heap_peak;
+static uint32_t alloc_cnt;
+
+static void *tracking_malloc(size_t size)
+{
+	struct alloc_hdr *hdr = malloc(sizeof(*hdr) + size);
+
+	if (!hdr) {
+		return NULL;
+	}
+
+	hdr->size = size;
+	heap_used += size;
+	heap_peak = MAX(heap_peak, heap_used);
+	alloc_cnt++;
+
+	return hdr + 1;
+}
+
+static void tracking_free(void *ptr)
+{
+	struct alloc_hdr *hdr;
+
+	if (!ptr) {
+		return;
+	}
+
+	hdr = (struct alloc_hdr *)ptr - 1;
+	heap_used -= hdr->size;
+	free(hdr);
+}
+
+static void tracking_reset(void)
+{
+	heap_used = 0;
+	heap_peak = 0;
+	alloc_cnt = 0;
+}
+
+static void ap_mac_get(int i, char *mac_str, size_t size)
+{
+	(void)snprintk(mac_str, size, "%02x:%02x:%02x:%02x:%02x:%02x",
+		       0x40, 0x9b, 0xcd, 0x10, i, 0x10 + i);
+}
+
+/* Wi-Fi location request, built like nrf_cloud_wifi_req_json_encode() */
+static char *wifi_req_cjson(void)
+{
+	char mac_str[18];
+	char *out;
+	cJSON *root = cJSON_CreateObject();
+	cJSON *wifi = cJSON_AddObjectToObject(root, "wifi");
+	cJSON *aps = cJSON_AddArrayToObject(wifi, "accessPoints");
+
+	for (int i = 0; i < BENCH_AP_CNT; i++) {
+		cJSON *ap = cJSON_CreateObject();
+
+		cJSON_AddItemToArray(aps, ap);
+		ap_mac_get(i, mac_str, sizeof(mac_str));
+		cJSON_AddStringToObject(ap, "macAddress", mac_str);
+		cJSON_AddNumberToObject(ap, "signalStrength", -40 - i);
+		cJSON_AddNumberToObject(ap, "channel", 1 + (i % 13));
+	}
+
+	out = cJSON_PrintUnformatted(root);
+	cJSON_Delete(root);
+
+	return out;
+}
+
+static int wifi_req_write(struct nrf_cloud_json_writer *w, const void *ctx)
+{
+	char mac_str[18];
+
+	ARG_UNUSED(ctx);
+
+	nrf_cloud_json_obj_start(w, NULL);
+	nrf_cloud_json_obj_start(w, "wifi");
+	nrf_cloud_json_arr_start(w, "accessPoints");
+
+	for (int i = 0; i < BENCH_AP_CNT; i++) {
+		ap_mac_get(i, mac_str, sizeof(mac_str));
+		nrf_cloud_json_obj_start(w, NULL);
+		nrf_cloud_json_str_add(w, "macAddress", mac_str);
+		nrf_cloud_json_int_add(w, "signalStrength", -40 - i);
+		nrf_cloud_json_int_add(w, "channel", 1 + (i % 13));
+		nrf_cloud_json_obj_end(w);
+	}
+
+	nrf_cloud_json_arr_end(w);
+	nrf_cloud_json_obj_end(w);
+	nrf_cloud_json_obj_end(w);
+
+	return 0;
+}
+
+/* Sensor data message, built like nrf_cloud_sensor_data_encode() */
+static char *sensor_cjson(void)
+{
+	char *out;
+	cJSON *root = cJSON_CreateObject();
+
+	cJSON_AddStringToObject(root, "appId", "TEMP");
+	cJSON_AddStringToObject(root, "data", "24.5");
+	cJSON_AddStringToObject(root, "messageType", "DATA");
+	cJSON_AddNumberToObject(root, "ts", 1700000000123);
+
+	out = cJSON_PrintUnformatted(root);
+	cJSON_Delete(root);
+
+	return out;
+}
+
+static int sensor_write(struct nrf_cloud_json_writer *w, const void *ctx)
+{
+	ARG_UNUSED(ctx);
+
+	nrf_cloud_json_obj_start(w, NULL);
+	nrf_cloud_json_str_add(w, "appId", "TEMP");
+	nrf_cloud_json_str_add(w, "data", "24.5");
+	nrf_cloud_json_str_add(w, "messageType", "DATA");
+	nrf_cloud_json_int_add(w, "ts", 1700000000123);
+	nrf_cloud_json_obj_end(w);
+
+	return 0;
+}
+
+static void benchmark_run(const char *name, char *(*cjson_fn)(void),
+			  nrf_cloud_json_encode_fn_t write_fn)
+{
+	struct nrf_cloud_data out;
+	char *expected;
+	uint32_t cjson_cycles = 0;
+	uint32_t writer_cycles = 0;
+	size_t cjson_peak;
+	size_t writer_peak;
+	uint32_t cjson_allocs;
+	uint32_t start;
+
+	tracking_reset();
+	for (int i = 0; i < BENCH_RUNS; i++) {
+		start = k_cycle_get_32();
+		expected = cjson_fn();
+		cjson_cycles += k_cycle_get_32() - start;
+		zassert_not_null(expected);
+		tracking_free(expected);
+	}
+	cjson_peak = heap_peak;
+	cjson_allocs = alloc_cnt / BENCH_RUNS;
+
+	tracking_reset();
+	for (int i = 0; i < BENCH_RUNS; i++) {
+		start = k_cycle_get_32();
+		zassert_ok(nrf_cloud_json_encode_alloc(write_fn, NULL, tracking_malloc,
+						       tracking_free, &out));
+		writer_cycles += k_cycle_get_32() - start;
+		tracking_free((void *)out.ptr);
+	}
+
+	/* The output buffer is the only allocation */
+	zassert_equal(alloc_cnt, BENCH_RUNS);
+	zassert_true(heap_peak < cjson_peak);
+	writer_peak = heap_peak;
+
+	/* The output must be the same */
+	expected = cjson_fn();
+	zassert_ok(nrf_cloud_json_encode_alloc(write_fn, NULL, tracking_malloc, tracking_free,
+					       &out));
+	zassert_str_equal(out.ptr, expected);
+	tracking_free(expected);
+	tracking_free((void *)out.ptr);
+
+	TC_PRINT("%s (%zu bytes): cJSON %u us, %u allocations, %zu bytes peak heap; "
+		 "writer %u us, 1 allocation, %zu bytes peak heap\n",
+		 name, out.len, (uint32_t)k_cyc_to_us_floor64(cjson_cycles / BENCH_RUNS),
+		 cjson_allocs, cjson_peak,
+		 (uint32_t)k_cyc_to_us_floor64(writer_cycles / BENCH_RUNS), writer_peak);
+}
+
+ZTEST(nrf_cloud_json_writer_benchmark, test_benchmark_sensor_data)
+{
+	benchmark_run("Sensor data", sensor_cjson, sensor_write);
+}
+
+ZTEST(nrf_cloud_json_writer_benchmark, test_benchmark_wifi_request)
+{
+	benchmark_run("Wi-Fi request", wifi_req_cjson, wifi_req_write);
+}
+
+static void *benchmark_setup(void)
+{
+	cJSON_Hooks hooks = {
+		.malloc_fn = tracking_malloc,
+		.free_fn = tracking_free,
+	};
+
+	cJSON_InitHooks(&hooks);
+
+	return NULL;
+}
+
+static void benchmark_teardown(void *fixture)
+{
+	ARG_UNUSED(fixture);
+
+	cJSON_InitHooks(NULL);
+}
+
+ZTEST_SUITE(nrf_cloud_json_writer_benchmark, NULL, benchmark_setup, NULL, NULL,
+	    benchmark_teardown);
@@ -0,0 +1,229 @@
+/*
+ * Copyright (c) 2024 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#include <stdlib.h>
+#include <string.h>
+#include <zephyr/ztest.h>
+#include <cJSON.h>
+
+#include "nrf_cloud_json_writer.h"
+
+static char buf[512];
+
+static const char *write_done(struct nrf_cloud_json_writer *w)
+{
+	int len = nrf_cloud_json_writer_finish(w);
+
+	zassert_true(len >= 0, "finish failed: %d", len);
+	zassert_equal(len, strlen(buf));
+
+	return buf;
+}
+
+ZTEST(nrf_cloud_json_writer, test_empty)
+{
+	struct nrf_cloud_json_writer w;
+
+	nrf_cloud_json_writer_init(&w, buf, sizeof(buf));
+	nrf_cloud_json_obj_start(&w, NULL);
+	nrf_cloud_json_obj_end(&w);
+	zassert_str_equal(write_done(&w), "{}");
+
+	nrf_cloud_json_writer_init(&w, buf, sizeof(buf));
+	nrf_cloud_json_arr_start(&w, NULL);
+	nrf_cloud_json_arr_end(&w);
+	zassert_str_equal(write_done(&w), "[]");
+}
+
+ZTEST(nrf_cloud_json_writer, test_nesting)
+{
+	struct nrf_cloud_json_writer w;
+
+	nrf_cloud_json_writer_init(&w, buf, sizeof(buf));
+	nrf_cloud_json_obj_start(&w, NULL);
+	nrf_cloud_json_obj_start(&w, "a");
+	nrf_cloud_json_arr_start(&w, "b");
+	nrf_cloud_json_int_add(&w, NULL, 1);
+	nrf_cloud_json_obj_start(&w, NULL);
+	nrf_cloud_json_obj_end(&w);
+	nrf_cloud_json_arr_start(&w, NULL);
+	nrf_cloud_json_arr_end(&w);
+	nrf_cloud_json_arr_end(&w);
+	nrf_cloud_json_bool_add(&w, "c", true);
+	nrf_cloud_json_obj_end(&w);
+	nrf_cloud_json_bool_add(&w, "d", false);
+	nrf_cloud_json_null_add(&w, "e");
+	nrf_cloud_json_obj_end(&w);
+
+	zassert_str_equal(write_done(&w),
+			  "{\"a\":{\"b\":[1,{},[]],\"c\":true},\"d\":false,\"e\":null}");
+}
+
+ZTEST(nrf_cloud_json_writer, test_escape)
+{
+	struct nrf_cloud_json_writer w;
+
+	nrf_cloud_json_writer_init(&w, buf, sizeof(buf));
+	nrf_cloud_json_obj_start(&w, NULL);
+	nrf_cloud_json_str_add(&w, "k\"", "q\" b\\ \b\f\n\r\t \x01\x1f /");
+	nrf_cloud_json_strn_add(&w, "n", "abcdef", 3);
+	nrf_cloud_json_obj_end(&w);
+
+	zassert_str_equal(write_done(&w),
+			  "{\"k\\\"\":\"q\\\" b\\\\ \\b\\f\\n\\r\\t \\u0001\\u001f /\","
+			  "\"n\":\"abc\"}");
+}
+
+ZTEST(nrf_cloud_json_writer, test_numbers)
+{
+	struct nrf_cloud_json_writer w;
+
+	nrf_cloud_json_writer_init(&w, buf, sizeof(buf));
+	nrf_cloud_json_arr_start(&w, NULL);
+	nrf_cloud_json_int_add(&w, NULL, 0);
+	nrf_cloud_json_int_add(&w, NULL, -42);
+	nrf_cloud_json_int_add(&w, NULL, INT64_MAX);
+	nrf_cloud_json_int_add(&w, NULL, INT64_MIN);
+	nrf_cloud_json_decimal_add(&w, NULL, -195, 1);
+	nrf_cloud_json_decimal_add(&w, NULL, -5, 1);
+	nrf_cloud_json_decimal_add(&w, NULL, -30, 1);
+	nrf_cloud_json_decimal_add(&w, NULL, 1200, 3);
+	nrf_cloud_json_decimal_add(&w, NULL, 1005, 3);
+	nrf_cloud_json_arr_end(&w);
+
+	zassert_str_equal(write_done(&w),
+			  "[0,-42,9223372036854775807,-9223372036854775808,"
+			  "-19.5,-0.5,-3,1.2,1.005]");
+}
+
+ZTEST(nrf_cloud_json_writer, test_measure)
+{
+	struct nrf_cloud_json_writer w;
+
+	nrf_cloud_json_writer_init(&w, NULL, 0);
+	nrf_cloud_json_obj_start(&w, NULL);
+	nrf_cloud_json_str_add(&w, "key", "a\nb");
+	nrf_cloud_json_int_add(&w, "ts", 1700000000000);
+	nrf_cloud_json_obj_end(&w);
+
+	/* {"key":"a\nb","ts":1700000000000} */
+	zassert_equal(nrf_cloud_json_writer_finish(&w), 33);
+}
+
+ZTEST(nrf_cloud_json_writer, test_overflow)
+{
+	struct nrf_cloud_json_writer w;
+	char small[8];
+
+	/* The null terminator must fit too */
+	nrf_cloud_json_writer_init(&w, small, sizeof(small));
+	nrf_cloud_json_str_add(&w, NULL, "123456");
+	zassert_equal(nrf_cloud_json_writer_finish(&w), -ENOMEM);
+
+	nrf_cloud_json_writer_init(&w, small, sizeof(small));
+	nrf_cloud_json_str_add(&w, NULL, "12345");
+	zassert_equal(nrf_cloud_json_writer_finish(&w), 7);
+	zassert_str_equal(small, "\"12345\"");
+}
+
+ZTEST(nrf_cloud_json_writer, test_unbalanced)
+{
+	struct nrf_cloud_json_writer w;
+
+	nrf_cloud_json_writer_init(&w, buf, sizeof(buf));
+	nrf_cloud_json_obj_start(&w, NULL);
+	zassert_equal(nrf_cloud_json_writer_finish(&w), -EINVAL);
+
+	nrf_cloud_json_writer_init(&w, buf, sizeof(buf));
+	nrf_cloud_json_obj_end(&w);
+	zassert_equal(nrf_cloud_json_writer_finish(&w), -EINVAL);
+
+	nrf_cloud_json_writer_init(&w, NULL, 0);
+	for (int i = 0; i <= NRF_CLOUD_JSON_WRITER_DEPTH_MAX; i++) {
+		nrf_cloud_json_arr_start(&w, NULL);
+	}
+	zassert_equal(nrf_cloud_json_writer_finish(&w), -EINVAL);
+}
+
+static int sample_write(struct nrf_cloud_json_writer *w, const void *ctx)
+{
+	ARG_UNUSED(ctx);
+
+	nrf_cloud_json_obj_start(w, NULL);
+	nrf_cloud_json_str_add(w, "appId", "TEMP");
+	nrf_cloud_json_str_add(w, "data", "24.5 \"C\"");
+	nrf_cloud_json_str_add(w, "messageType", "DATA");
+	nrf_cloud_json_int_add(w, "ts", 1700000000123);
+	nrf_cloud_json_arr_start(w, "lte");
+	nrf_cloud_json_obj_start(w, NULL);
+	nrf_cloud_json_int_add(w, "eci", 21858829);
+	nrf_cloud_json_decimal_add(w, "rsrq", -105, 1);
+	nrf_cloud_json_obj_end(w);
+	nrf_cloud_json_arr_end(w);
+	nrf_cloud_json_null_add(w, "ui");
+	nrf_cloud_json_obj_end(w);
+
+	return 0;
+}
+
+ZTEST(nrf_cloud_json_writer, test_same_as_cjson)
+{
+	struct nrf_cloud_data out;
+	cJSON *root = cJSON_CreateObject();
+	cJSON *lte = cJSON_CreateArray();
+	cJSON *cell = cJSON_CreateObject();
+	char *expected;
+
+	cJSON_AddStringToObject(root, "appId", "TEMP");
+	cJSON_AddStringToObject(root, "data", "24.5 \"C\"");
+	cJSON_AddStringToObject(root, "messageType", "DATA");
+	cJSON_AddNumberToObject(root, "ts", 1700000000123);
+	cJSON_AddItemToObject(root, "lte", lte);
+	cJSON_AddItemToArray(lte, cell);
+	cJSON_AddNumberToObject(cell, "eci", 21858829);
+	cJSON_AddNumberToObject(cell, "rsrq", -10.5);
+	cJSON_AddNullToObject(root, "ui");
+
+	expected = cJSON_PrintUnformatted(root);
+	cJSON_Delete(root);
+	zassert_not_null(expected);
+
+	zassert_ok(nrf_cloud_json_encode_alloc(sample_write, NULL, malloc, free, &out));
+	zassert_str_equal(out.ptr, expected);
+	zassert_equal(out.len, strlen(expected));
+
+	free((void *)out.ptr);
+	cJSON_free(expected);
+}
+
+static int failing_write(struct nrf_cloud_json_writer *w, const void *ctx)
+{
+	ARG_UNUSED(ctx);
+
+	nrf_cloud_json_obj_start(w, NULL);
+
+	return -EBADMSG;
+}
+
+static void *no_alloc(size_t size)
+{
+	ARG_UNUSED(size);
+
+	return NULL;
+}
+
+ZTEST(nrf_cloud_json_writer, test_encode_alloc_errors)
+{
+	struct nrf_cloud_data out = {0};
+
+	zassert_equal(nrf_cloud_json_encode_alloc(failing_write, NULL, malloc, free, &out),
+		      -EBADMSG);
+	zassert_equal(nrf_cloud_json_encode_alloc(sample_write, NULL, no_alloc, free, &out),
+		      -ENOMEM);
+	zassert_is_null(out.ptr);
+}
+
+ZTEST_SUITE(nrf_cloud_json_writer, NULL, NULL, NULL, NULL, NULL);
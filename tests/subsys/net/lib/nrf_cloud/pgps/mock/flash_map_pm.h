@@ -0,0 +1,22 @@
+/*
+ * Copyright (c) 2024 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#ifndef FLASH_MAP_PM_H_
+#define FLASH_MAP_PM_H_
+
+#include <zephyr/storage/flash_map.h>
+
+/* Predictions are stored in a devicetree partition of the flash simulator,
+ * while the settings use the storage partition.
+ */
+#define PGPS_TEST_PARTITION slot1_partition
+
+#undef FLASH_AREA_ID
+#undef FLASH_AREA_DEVICE
+#define FLASH_AREA_ID(label) FIXED_PARTITION_ID(PGPS_TEST_PARTITION)
+#define FLASH_AREA_DEVICE(label) FIXED_PARTITION_DEVICE(PGPS_TEST_PARTITION)
+
+#endif /* FLASH_MAP_PM_H_ */
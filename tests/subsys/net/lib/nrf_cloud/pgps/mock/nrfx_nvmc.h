@@ -0,0 +1,18 @@
+/*
+ * Copyright (c) 2024 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#ifndef NRFX_NVMC_H__
+#define NRFX_NVMC_H__
+
+#include <stdint.h>
+
+/* Erase block size of the flash simulator */
+static inline uint32_t nrfx_nvmc_flash_page_size_get(void)
+{
+	return 4096;
+}
+
+#endif /* NRFX_NVMC_H__ */
@@ -0,0 +1,12 @@
+/*
+ * Copyright (c) 2024 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#ifndef PM_CONFIG_H__
+#define PM_CONFIG_H__
+
+/* The partition manager is not used; see flash_map_pm.h */
+
+#endif /* PM_CONFIG_H__ */
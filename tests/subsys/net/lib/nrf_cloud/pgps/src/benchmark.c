@@ -0,0 +1,72 @@
+/*
+ * Copyright (c) 2024 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#include <zephyr/ztest.h>
+#include <zephyr/kernel.h>
+#include <net/nrf_cloud_pgps.h>
+
+#include "pgps_data.h"
+
+#define BENCH_RUNS (8)
+
+/* Reading external flash over SPI at 8 MHz, roughly */
+#define BENCH_FLASH_READ_US_PER_KB (1024)
+
+static uint32_t cycles_to_us(uint32_t cycles)
+{
+	return (uint32_t)k_cyc_to_us_floor64(cycles);
+}
+
+ZTEST(nrf_cloud_pgps_benchmark, test_benchmark_init_find_inject)
+{
+	struct nrf_cloud_pgps_prediction *prediction;
+	uint32_t init_cycles = 0;
+	uint32_t find_cycles = 0;
+	uint32_t inject_cycles = 0;
+	uint32_t init_bytes = 0;
+	uint32_t find_bytes = 0;
+	uint32_t start;
+
+	pgps_data_flash_read_time_set(BENCH_FLASH_READ_US_PER_KB);
+	(void)pgps_data_flash_read_bytes();
+
+	for (int i = 0; i < BENCH_RUNS; i++) {
+		start = k_cycle_get_32();
+		pgps_data_init();
+		init_cycles += k_cycle_get_32() - start;
+		init_bytes += pgps_data_flash_read_bytes();
+		zassert_equal(pgps_data_last_evt(), PGPS_EVT_AVAILABLE);
+
+		start = k_cycle_get_32();
+		zassert_true(nrf_cloud_pgps_find_prediction(&prediction) >= 0);
+		find_cycles += k_cycle_get_32() - start;
+		find_bytes += pgps_data_flash_read_bytes();
+
+		start = k_cycle_get_32();
+		zassert_ok(nrf_cloud_pgps_inject(prediction, NULL));
+		inject_cycles += k_cycle_get_32() - start;
+	}
+
+	pgps_data_flash_read_time_set(0);
+
+	TC_PRINT("%s index: init %u us (%u bytes read), find %u us (%u bytes read), "
+		 "inject %u us\n",
+		 IS_ENABLED(CONFIG_NRF_CLOUD_PGPS_PREDICTION_INDEX) ? "with" : "without",
+		 cycles_to_us(init_cycles / BENCH_RUNS), init_bytes / BENCH_RUNS,
+		 cycles_to_us(find_cycles / BENCH_RUNS), find_bytes / BENCH_RUNS,
+		 cycles_to_us(inject_cycles / BENCH_RUNS));
+}
+
+static void *benchmark_setup(void)
+{
+	/* Start from a full set of predictions */
+	pgps_data_erase();
+	pgps_data_init();
+
+	return NULL;
+}
+
+ZTEST_SUITE(nrf_cloud_pgps_benchmark, NULL, benchmark_setup, NULL, NULL, NULL);
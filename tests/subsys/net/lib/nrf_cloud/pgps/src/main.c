@@ -0,0 +1,75 @@
+/*
+ * Copyright (c) 2024 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#include <zephyr/ztest.h>
+#include <net/nrf_cloud_pgps.h>
+
+#include "nrf_cloud_pgps_utils.h"
+#include "pgps_data.h"
+
+ZTEST(nrf_cloud_pgps, test_find)
+{
+	struct nrf_cloud_pgps_prediction *prediction;
+
+	zassert_equal(nrf_cloud_pgps_find_prediction(&prediction), 0);
+	zassert_not_null(prediction);
+	zassert_ok(nrf_cloud_pgps_inject(prediction, NULL));
+	zassert_true(pgps_data_injected_cnt() > 0);
+}
+
+ZTEST(nrf_cloud_pgps, test_reinit)
+{
+	struct nrf_cloud_pgps_prediction *prediction;
+
+	/* All predictions are still stored */
+	pgps_data_init();
+	zassert_equal(pgps_data_last_evt(), PGPS_EVT_AVAILABLE);
+
+	zassert_equal(nrf_cloud_pgps_find_prediction(&prediction), 0);
+	zassert_ok(nrf_cloud_pgps_inject(prediction, NULL));
+
+#if defined(CONFIG_NRF_CLOUD_PGPS_PREDICTION_INDEX)
+	const struct npgps_saved_index *saved = npgps_get_saved_index();
+
+	zassert_equal(saved->prediction_count, NUM_PREDICTIONS);
+	for (int pnum = 0; pnum < NUM_PREDICTIONS; pnum++) {
+		zassert_equal(saved->blocks[pnum], pnum);
+	}
+#endif
+}
+
+ZTEST(nrf_cloud_pgps, test_corrupted)
+{
+	struct nrf_cloud_pgps_prediction *prediction;
+
+	pgps_data_corrupt(0);
+
+	/* The bad prediction is found during initialization, either by
+	 * validating all predictions or by validating it when it is first used,
+	 * and the full set is requested and loaded again.
+	 */
+	pgps_data_init();
+	zassert_equal(pgps_data_last_evt(), PGPS_EVT_READY);
+
+	zassert_equal(nrf_cloud_pgps_find_prediction(&prediction), 0);
+	zassert_ok(nrf_cloud_pgps_inject(prediction, NULL));
+}
+
+static void pgps_before(void *fixture)
+{
+	ARG_UNUSED(fixture);
+
+	pgps_data_init();
+}
+
+static void *pgps_setup(void)
+{
+	pgps_data_erase();
+
+	return NULL;
+}
+
+ZTEST_SUITE(nrf_cloud_pgps, NULL, pgps_setup, pgps_before, NULL, NULL);
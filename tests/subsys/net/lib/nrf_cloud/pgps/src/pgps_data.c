@@ -0,0 +1,197 @@
+/*
+ * Copyright (c) 2024 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#include <zephyr/ztest.h>
+#include <zephyr/fff.h>
+#include <zephyr/storage/flash_map.h>
+#include <date_time.h>
+#include <net/nrf_cloud_agnss.h>
+#include <net/nrf_cloud_pgps.h>
+#include <flash_map_pm.h>
+#include <nrfx_nvmc.h>
+
+#include "nrf_cloud_pgps_schema_v1.h"
+#include "nrf_cloud_pgps_utils.h"
+#include "nrf_cloud_download.h"
+#include "pgps_data.h"
+
+DEFINE_FFF_GLOBALS;
+
+FAKE_VALUE_FUNC(int, date_time_now, int64_t *);
+FAKE_VALUE_FUNC(int, nrf_cloud_agnss_process, const char *, size_t);
+FAKE_VOID_FUNC(nrf_cloud_agnss_processed, struct nrf_modem_gnss_agnss_data_frame *);
+FAKE_VALUE_FUNC(int, download_client_init, struct download_client *,
+		download_client_callback_t);
+FAKE_VALUE_FUNC(int, download_client_disconnect, struct download_client *);
+FAKE_VALUE_FUNC(int, nrf_cloud_download_start, struct nrf_cloud_download_data *const);
+FAKE_VOID_FUNC(nrf_cloud_download_end);
+
+#define PERIOD_SEC (240 * SEC_PER_MIN)
+
+/* The library looks up predictions using the time shifted to the middle of a prediction */
+#define MIDPOINT_SHIFT_SEC (120 * SEC_PER_MIN)
+
+static uint8_t prediction_buf[PGPS_PREDICTION_DL_SIZE];
+static uint32_t flash_read_us_per_kb;
+static uint32_t flash_read_bytes;
+static enum nrf_cloud_pgps_event_type last_evt;
+static bool requested;
+
+int __real_flash_area_read(const struct flash_area *fa, off_t off, void *dst, size_t len);
+
+/* Linked in place of flash_area_read() */
+int __wrap_flash_area_read(const struct flash_area *fa, off_t off, void *dst, size_t len)
+{
+	flash_read_bytes += len;
+	k_busy_wait(((uint64_t)len * flash_read_us_per_kb) / 1024);
+
+	return __real_flash_area_read(fa, off, dst, len);
+}
+
+static int date_time_now_custom(int64_t *unix_time_ms)
+{
+	*unix_time_ms = PGPS_TEST_UNIX_TIME_MS;
+	return 0;
+}
+
+static void pgps_event_handler(struct nrf_cloud_pgps_event *event)
+{
+	last_evt = event->type;
+	if (event->type == PGPS_EVT_REQUEST) {
+		requested = true;
+	}
+}
+
+static const struct flash_area *pgps_data_area(void)
+{
+	const struct flash_area *fa;
+
+	zassert_ok(flash_area_open(FLASH_AREA_ID(pgps), &fa));
+	return fa;
+}
+
+void pgps_data_erase(void)
+{
+	const struct flash_area *fa = pgps_data_area();
+
+	zassert_ok(flash_area_erase(fa, 0, NUM_PREDICTIONS * PGPS_PREDICTION_STORAGE_SIZE));
+	flash_area_close(fa);
+}
+
+void pgps_data_corrupt(int pnum)
+{
+	const struct flash_area *fa = pgps_data_area();
+	uint32_t page_size = nrfx_nvmc_flash_page_size_get();
+	off_t off = ROUND_DOWN(pnum * PGPS_PREDICTION_STORAGE_SIZE, page_size);
+
+	zassert_ok(flash_area_erase(fa, off, page_size));
+	flash_area_close(fa);
+}
+
+void pgps_data_init(void)
+{
+	const struct flash_area *fa = pgps_data_area();
+	struct nrf_cloud_pgps_init_param param = {
+		.event_handler = pgps_event_handler,
+		.storage_base = fa->fa_off,
+		.storage_size = NUM_PREDICTIONS * PGPS_PREDICTION_STORAGE_SIZE,
+	};
+
+	flash_area_close(fa);
+
+	RESET_FAKE(date_time_now);
+	date_time_now_fake.custom_fake = date_time_now_custom;
+
+	requested = false;
+	zassert_ok(nrf_cloud_pgps_init(&param));
+	if (requested) {
+		pgps_data_load();
+	}
+}
+
+/* Predictions are downloaded without the schema version and the sentinel,
+ * which are added by the library when storing them.
+ */
+static void prediction_encode(int64_t gps_sec)
+{
+	struct nrf_cloud_pgps_prediction p = { 0 };
+	size_t schema_offset = offsetof(struct nrf_cloud_pgps_prediction, schema_version);
+	uint16_t gps_day;
+	uint32_t gps_time_of_day;
+
+	npgps_gps_sec_to_day_time(gps_sec, &gps_day, &gps_time_of_day);
+
+	p.time_type = NRF_CLOUD_AGNSS_GPS_SYSTEM_CLOCK;
+	p.time_count = 1;
+	p.time.date_day = gps_day;
+	p.time.time_full_s = gps_time_of_day;
+	p.ephemeris_type = NRF_CLOUD_AGNSS_GPS_EPHEMERIDES;
+	p.ephemeris_count = NRF_CLOUD_PGPS_NUM_SV;
+	for (int i = 0; i < NRF_CLOUD_PGPS_NUM_SV; i++) {
+		p.ephemerii[i].sv_id = i + 1;
+		p.ephemerii[i].iodc = gps_sec / PERIOD_SEC;
+		p.ephemerii[i].af0 = i;
+	}
+
+	memcpy(prediction_buf, &p, schema_offset);
+	memcpy(&prediction_buf[schema_offset], (uint8_t *)&p + schema_offset + PGPS_SCHEMA_SIZE,
+	       sizeof(prediction_buf) - schema_offset);
+}
+
+void pgps_data_load(void)
+{
+	int64_t gps_sec;
+	int64_t start_sec;
+	uint16_t gps_day;
+	uint32_t gps_time_of_day;
+	struct nrf_cloud_pgps_header header = {
+		.schema_version = NRF_CLOUD_PGPS_BIN_SCHEMA_VERSION,
+		.array_type = NRF_CLOUD_PGPS_PREDICTION_HEADER,
+		.num_items = 1,
+		.prediction_count = NUM_PREDICTIONS,
+		.prediction_size = PGPS_PREDICTION_DL_SIZE,
+		.prediction_period_min = PERIOD_SEC / SEC_PER_MIN,
+	};
+
+	zassert_ok(npgps_get_shifted_time(&gps_sec, NULL, NULL, MIDPOINT_SHIFT_SEC));
+	start_sec = gps_sec - (gps_sec % PERIOD_SEC);
+	npgps_gps_sec_to_day_time(start_sec, &gps_day, &gps_time_of_day);
+	header.gps_day = gps_day;
+	header.gps_time_of_day = gps_time_of_day;
+
+	zassert_ok(nrf_cloud_pgps_begin_update());
+	zassert_ok(nrf_cloud_pgps_process_update((uint8_t *)&header, sizeof(header)));
+	for (int pnum = 0; pnum < NUM_PREDICTIONS; pnum++) {
+		prediction_encode(start_sec + (int64_t)pnum * PERIOD_SEC);
+		zassert_ok(nrf_cloud_pgps_process_update(prediction_buf, sizeof(prediction_buf)));
+	}
+	zassert_ok(nrf_cloud_pgps_finish_update());
+
+	zassert_equal(last_evt, PGPS_EVT_READY);
+}
+
+void pgps_data_flash_read_time_set(uint32_t us_per_kb)
+{
+	flash_read_us_per_kb = us_per_kb;
+}
+
+uint32_t pgps_data_flash_read_bytes(void)
+{
+	uint32_t bytes = flash_read_bytes;
+
+	flash_read_bytes = 0;
+	return bytes;
+}
+
+enum nrf_cloud_pgps_event_type pgps_data_last_evt(void)
+{
+	return last_evt;
+}
+
+uint32_t pgps_data_injected_cnt(void)
+{
+	return nrf_cloud_agnss_process_fake.call_count;
+}
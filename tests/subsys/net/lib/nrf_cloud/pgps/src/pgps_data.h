@@ -0,0 +1,47 @@
+/*
+ * Copyright (c) 2024 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#ifndef TEST_PGPS_DATA_H_
+#define TEST_PGPS_DATA_H_
+
+#include <stdint.h>
+#include <net/nrf_cloud_pgps.h>
+
+/* Time of the test, within the prediction set which is loaded */
+#define PGPS_TEST_UNIX_TIME_MS (1700000000000LL)
+
+/** @brief Erase the flash partition used for the predictions. */
+void pgps_data_erase(void);
+
+/** @brief Erase the flash page holding the given prediction of a set loaded in order. */
+void pgps_data_corrupt(int pnum);
+
+/**
+ * @brief Initialize the P-GPS library, and load a full set of predictions
+ * if the library requests it.
+ */
+void pgps_data_init(void);
+
+/** @brief Load a full set of predictions covering the current time. */
+void pgps_data_load(void);
+
+/**
+ * @brief Simulate reading predictions from external flash.
+ *
+ * @param us_per_kb Time to read a kilobyte from flash.
+ */
+void pgps_data_flash_read_time_set(uint32_t us_per_kb);
+
+/** @brief Number of bytes read from flash, since the last call. */
+uint32_t pgps_data_flash_read_bytes(void);
+
+/** @brief Last event received from the P-GPS library. */
+enum nrf_cloud_pgps_event_type pgps_data_last_evt(void);
+
+/** @brief Number of A-GNSS elements passed to the modem. */
+uint32_t pgps_data_injected_cnt(void);
+
+#endif /* TEST_PGPS_DATA_H_ */
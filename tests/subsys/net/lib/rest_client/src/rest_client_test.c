@@ -0,0 +1,318 @@
+/*
+ * Copyright (c) 2024 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+#include <unity.h>
+#include <stdbool.h>
+#include <string.h>
+#include <zephyr/kernel.h>
+#include <net/rest_client.h>
+
+#include "zephyr/net/cmock_socket.h"
+#include "zephyr/net/http/cmock_client.h"
+#include "zephyr/net/http/cmock_parser.h"
+
+#define TEST_HOST_1		"api.test-host-1.com"
+#define TEST_HOST_2		"api.test-host-2.com"
+#define TEST_URL		"/v1/location"
+#define TEST_PORT		443
+#define TEST_SEC_TAG		42
+#define TEST_RESPONSE_LEN	20
+
+#define TEST_FD_1		10
+#define TEST_FD_2		11
+#define TEST_FD_3		12
+
+/* It is required to be added to each test. That is because unity's
+ * main may return nonzero, while zephyr's main currently must
+ * return 0 in all cases (other values are reserved).
+ */
+extern int unity_main(void);
+
+static struct sockaddr_in test_addr = {
+	.sin_family = AF_INET,
+};
+
+static struct zsock_addrinfo test_addr_info = {
+	.ai_family = AF_INET,
+	.ai_socktype = SOCK_STREAM,
+	.ai_addr = (struct sockaddr *)&test_addr,
+	.ai_addrlen = sizeof(test_addr),
+};
+
+static char resp_buff[128];
+static struct rest_client_req_context req_ctx;
+static struct rest_client_resp_context resp_ctx;
+static struct rest_client_conn_cache_stats stats_start;
+static int req_error_pending;
+/* Number of requests sent */
+static int req_cnt;
+
+/* Stubs */
+static int getaddrinfo_stub(const char *host, const char *service,
+			    const struct zsock_addrinfo *hints, struct zsock_addrinfo **res,
+			    int num_calls)
+{
+	*res = &test_addr_info;
+
+	return 0;
+}
+
+static int poll_stub_idle(struct pollfd *fds, int nfds, int timeout, int num_calls)
+{
+	fds[0].revents = 0;
+
+	return 0;
+}
+
+static int poll_stub_closed(struct pollfd *fds, int nfds, int timeout, int num_calls)
+{
+	fds[0].revents = POLLIN;
+
+	return 1;
+}
+
+static int http_client_req_stub_ok(int sock, struct http_request *req, int32_t timeout,
+				   void *user_data, int num_calls)
+{
+	struct http_response rsp = {
+		.http_status_code = REST_CLIENT_HTTP_STATUS_OK,
+		.data_len = TEST_RESPONSE_LEN,
+	};
+
+	req_cnt++;
+	strcpy(rsp.http_status, "OK");
+	req->response(&rsp, HTTP_DATA_FINAL, user_data);
+
+	return TEST_RESPONSE_LEN;
+}
+
+/* The first request fails with req_error_pending before anything is received,
+ * like on a connection that the server has just closed.
+ */
+static int http_client_req_stub_error(int sock, struct http_request *req, int32_t timeout,
+				      void *user_data, int num_calls)
+{
+	if (req_error_pending) {
+		int err = req_error_pending;
+
+		req_error_pending = 0;
+		req_cnt++;
+		return err;
+	}
+
+	return http_client_req_stub_ok(sock, req, timeout, user_data, num_calls);
+}
+
+/* Helper functions */
+static void request_init(const char *host, int sec_tag)
+{
+	rest_client_request_defaults_set(&req_ctx);
+	req_ctx.host = host;
+	req_ctx.port = TEST_PORT;
+	req_ctx.url = TEST_URL;
+	req_ctx.sec_tag = sec_tag;
+	req_ctx.resp_buff = resp_buff;
+	req_ctx.resp_buff_len = sizeof(resp_buff);
+}
+
+static void connect_expect(int fd, int sec_tag)
+{
+	int proto = (sec_tag == REST_CLIENT_SEC_TAG_NO_SEC) ? IPPROTO_TCP : IPPROTO_TLS_1_2;
+
+	__cmock_socket_ExpectAndReturn(AF_INET, SOCK_STREAM, proto, fd);
+	__cmock_connect_ExpectAnyArgsAndReturn(0);
+}
+
+static void stats_check(uint32_t reused, uint32_t connected, uint32_t stale,
+			uint32_t expired, uint32_t evicted)
+{
+	struct rest_client_conn_cache_stats stats;
+
+	rest_client_conn_cache_stats_get(&stats);
+
+	TEST_ASSERT_EQUAL(reused, stats.reused - stats_start.reused);
+	TEST_ASSERT_EQUAL(connected, stats.connected - stats_start.connected);
+	TEST_ASSERT_EQUAL(stale, stats.stale - stats_start.stale);
+	TEST_ASSERT_EQUAL(expired, stats.expired - stats_start.expired);
+	TEST_ASSERT_EQUAL(evicted, stats.evicted - stats_start.evicted);
+}
+
+void setUp(void)
+{
+	__cmock_getaddrinfo_Stub(getaddrinfo_stub);
+	__cmock_freeaddrinfo_Ignore();
+	__cmock_inet_ntop_IgnoreAndReturn(NULL);
+	__cmock_setsockopt_IgnoreAndReturn(0);
+	__cmock_poll_Stub(poll_stub_idle);
+	__cmock_http_client_req_Stub(http_client_req_stub_ok);
+	__cmock_http_should_keep_alive_IgnoreAndReturn(1);
+
+	rest_client_conn_cache_stats_get(&stats_start);
+}
+
+void tearDown(void)
+{
+	/* Start each test with an empty cache. */
+	__cmock_close_IgnoreAndReturn(0);
+	rest_client_conn_cache_flush();
+}
+
+/* Tests */
+
+/* The test verifies that a second request to the same host reuses the connection. */
+void test_rest_client_conn_reused(void)
+{
+	connect_expect(TEST_FD_1, TEST_SEC_TAG);
+
+	request_init(TEST_HOST_1, TEST_SEC_TAG);
+	TEST_ASSERT_EQUAL(0, rest_client_request(&req_ctx, &resp_ctx));
+	TEST_ASSERT_EQUAL(REST_CLIENT_HTTP_STATUS_OK, resp_ctx.http_status_code);
+	TEST_ASSERT_EQUAL(REST_CLIENT_SCKT_CONNECT, req_ctx.connect_socket);
+	TEST_ASSERT_FALSE(resp_ctx.used_socket_is_alive);
+
+	request_init(TEST_HOST_1, TEST_SEC_TAG);
+	TEST_ASSERT_EQUAL(0, rest_client_request(&req_ctx, &resp_ctx));
+	TEST_ASSERT_EQUAL(TEST_FD_1, resp_ctx.used_socket_id);
+
+	stats_check(1, 1, 0, 0, 0);
+}
+
+/* The test verifies that connections are only reused for the same host and security tag. */
+void test_rest_client_conn_key(void)
+{
+	connect_expect(TEST_FD_1, TEST_SEC_TAG);
+	connect_expect(TEST_FD_2, REST_CLIENT_SEC_TAG_NO_SEC);
+	connect_expect(TEST_FD_3, TEST_SEC_TAG);
+
+	request_init(TEST_HOST_1, TEST_SEC_TAG);
+	TEST_ASSERT_EQUAL(0, rest_client_request(&req_ctx, &resp_ctx));
+
+	request_init(TEST_HOST_1, REST_CLIENT_SEC_TAG_NO_SEC);
+	TEST_ASSERT_EQUAL(0, rest_client_request(&req_ctx, &resp_ctx));
+	TEST_ASSERT_EQUAL(TEST_FD_2, resp_ctx.used_socket_id);
+
+	/* Evicts the connection idle for the longest time, the first one. */
+	__cmock_close_ExpectAndReturn(TEST_FD_1, 0);
+	request_init(TEST_HOST_2, TEST_SEC_TAG);
+	TEST_ASSERT_EQUAL(0, rest_client_request(&req_ctx, &resp_ctx));
+	TEST_ASSERT_EQUAL(TEST_FD_3, resp_ctx.used_socket_id);
+
+	stats_check(0, 3, 0, 0, 1);
+}
+
+/* The test verifies that the connection is closed when the server does not keep it alive. */
+void test_rest_client_conn_close_requested(void)
+{
+	connect_expect(TEST_FD_1, TEST_SEC_TAG);
+	__cmock_http_should_keep_alive_IgnoreAndReturn(0);
+	__cmock_close_ExpectAndReturn(TEST_FD_1, 0);
+
+	request_init(TEST_HOST_1, TEST_SEC_TAG);
+	TEST_ASSERT_EQUAL(0, rest_client_request(&req_ctx, &resp_ctx));
+
+	stats_check(0, 1, 0, 0, 0);
+}
+
+/* The test verifies that a cached connection closed by the server is not used. */
+void test_rest_client_conn_stale(void)
+{
+	connect_expect(TEST_FD_1, TEST_SEC_TAG);
+	request_init(TEST_HOST_1, TEST_SEC_TAG);
+	TEST_ASSERT_EQUAL(0, rest_client_request(&req_ctx, &resp_ctx));
+
+	__cmock_poll_Stub(poll_stub_closed);
+	__cmock_close_ExpectAndReturn(TEST_FD_1, 0);
+	connect_expect(TEST_FD_2, TEST_SEC_TAG);
+
+	request_init(TEST_HOST_1, TEST_SEC_TAG);
+	TEST_ASSERT_EQUAL(0, rest_client_request(&req_ctx, &resp_ctx));
+	TEST_ASSERT_EQUAL(TEST_FD_2, resp_ctx.used_socket_id);
+
+	stats_check(0, 2, 1, 0, 0);
+}
+
+/* The test verifies that the request is sent again on a new connection
+ * if the cached one fails before a response.
+ */
+void test_rest_client_conn_lost_retry(void)
+{
+	connect_expect(TEST_FD_1, TEST_SEC_TAG);
+	request_init(TEST_HOST_1, TEST_SEC_TAG);
+	TEST_ASSERT_EQUAL(0, rest_client_request(&req_ctx, &resp_ctx));
+
+	req_error_pending = -ECONNRESET;
+	__cmock_http_client_req_Stub(http_client_req_stub_error);
+	__cmock_close_ExpectAndReturn(TEST_FD_1, 0);
+	connect_expect(TEST_FD_2, TEST_SEC_TAG);
+
+	request_init(TEST_HOST_1, TEST_SEC_TAG);
+	TEST_ASSERT_EQUAL(0, rest_client_request(&req_ctx, &resp_ctx));
+	TEST_ASSERT_EQUAL(TEST_FD_2, resp_ctx.used_socket_id);
+
+	stats_check(0, 2, 1, 0, 0);
+}
+
+/* The test verifies that a POST request is not sent again if the cached connection
+ * fails before a response, because the server may have processed it already.
+ */
+void test_rest_client_conn_lost_post_not_resent(void)
+{
+	connect_expect(TEST_FD_1, TEST_SEC_TAG);
+	request_init(TEST_HOST_1, TEST_SEC_TAG);
+	TEST_ASSERT_EQUAL(0, rest_client_request(&req_ctx, &resp_ctx));
+
+	req_error_pending = -ETIMEDOUT;
+	req_cnt = 0;
+	__cmock_http_client_req_Stub(http_client_req_stub_error);
+	__cmock_close_ExpectAndReturn(TEST_FD_1, 0);
+
+	request_init(TEST_HOST_1, TEST_SEC_TAG);
+	req_ctx.http_method = HTTP_POST;
+	req_ctx.body = "{}";
+	TEST_ASSERT_EQUAL(-ETIMEDOUT, rest_client_request(&req_ctx, &resp_ctx));
+	TEST_ASSERT_EQUAL(1, req_cnt);
+	TEST_ASSERT_EQUAL(REST_CLIENT_SCKT_CONNECT, req_ctx.connect_socket);
+
+	stats_check(1, 1, 0, 0, 0);
+}
+
+/* The test verifies that idle connections are closed after the timeout. */
+void test_rest_client_conn_expired(void)
+{
+	connect_expect(TEST_FD_1, TEST_SEC_TAG);
+	request_init(TEST_HOST_1, TEST_SEC_TAG);
+	TEST_ASSERT_EQUAL(0, rest_client_request(&req_ctx, &resp_ctx));
+
+	k_sleep(K_SECONDS(CONFIG_REST_CLIENT_CONN_CACHE_IDLE_TIMEOUT));
+
+	__cmock_close_ExpectAndReturn(TEST_FD_1, 0);
+	connect_expect(TEST_FD_2, TEST_SEC_TAG);
+
+	request_init(TEST_HOST_1, TEST_SEC_TAG);
+	TEST_ASSERT_EQUAL(0, rest_client_request(&req_ctx, &resp_ctx));
+
+	stats_check(0, 2, 0, 1, 0);
+}
+
+/* The test verifies that connections kept alive by the caller are not cached. */
+void test_rest_client_conn_keep_alive_not_cached(void)
+{
+	connect_expect(TEST_FD_1, TEST_SEC_TAG);
+
+	request_init(TEST_HOST_1, TEST_SEC_TAG);
+	req_ctx.keep_alive = true;
+	TEST_ASSERT_EQUAL(0, rest_client_request(&req_ctx, &resp_ctx));
+	TEST_ASSERT_EQUAL(TEST_FD_1, req_ctx.connect_socket);
+	TEST_ASSERT_TRUE(resp_ctx.used_socket_is_alive);
+
+	stats_check(0, 0, 0, 0, 0);
+}
+
+int main(void)
+{
+	(void)unity_main();
+
+	return 0;
+}